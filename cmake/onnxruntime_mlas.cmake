@@ -24,6 +24,33 @@ if(CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
   set(MLAS_AMX_SUPPORTED TRUE)
 endif()
 
+set(MLAS_AVX512FP16_SUPPORTED FALSE)
+
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND CMAKE_C_COMPILER_VERSION VERSION_GREATER_EQUAL 12)
+  # AVX512-FP16 instructions need the same assembler version as AMX
+  if(MLAS_AMX_SUPPORTED)
+    set(MLAS_AVX512FP16_SUPPORTED TRUE)
+  endif()
+endif()
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND NOT CMAKE_CXX_COMPILER_ID STREQUAL "AppleClang" AND CMAKE_CXX_COMPILER_VERSION VERSION_GREATER_EQUAL 14)
+  set(MLAS_AVX512FP16_SUPPORTED TRUE)
+endif()
+
+set(MLAS_AVXVNNI_SUPPORTED FALSE)
+
+if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND CMAKE_CXX_COMPILER_VERSION VERSION_GREATER_EQUAL 11)
+  set(MLAS_AVXVNNI_SUPPORTED TRUE)
+endif()
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND CMAKE_CXX_COMPILER_VERSION VERSION_GREATER_EQUAL 12)
+  set(MLAS_AVXVNNI_SUPPORTED TRUE)
+endif()
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "MSVC")
+  set(MLAS_AVXVNNI_SUPPORTED TRUE)
+endif()
+
 
 #
 # All hardware agnostic source files here
@@ -35,9 +62,14 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
   ${MLAS_SRC_DIR}/halfgemm.cpp
+  ${MLAS_SRC_DIR}/bf16gemm.cpp
+  ${MLAS_SRC_DIR}/q4_dq.cpp
+  ${MLAS_SRC_DIR}/q4gemm.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
+  ${MLAS_SRC_DIR}/winograd.cpp
+  ${MLAS_SRC_DIR}/convnhwc.cpp
   ${MLAS_SRC_DIR}/convsym.cpp
   ${MLAS_SRC_DIR}/pooling.cpp
   ${MLAS_SRC_DIR}/transpose.cpp
@@ -48,7 +80,15 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/tanh.cpp
   ${MLAS_SRC_DIR}/erf.cpp
   ${MLAS_SRC_DIR}/compute.cpp
+  ${MLAS_SRC_DIR}/reduce.cpp
+  ${MLAS_SRC_DIR}/layernorm.cpp
+  ${MLAS_SRC_DIR}/gelu.cpp
+  ${MLAS_SRC_DIR}/eltwise.cpp
+  ${MLAS_SRC_DIR}/transcendental.cpp
+  ${MLAS_SRC_DIR}/spgemm.cpp
+  ${MLAS_SRC_DIR}/cast.cpp
   ${MLAS_SRC_DIR}/quantize.cpp
+  ${MLAS_SRC_DIR}/dynamicquantize.cpp
   ${MLAS_SRC_DIR}/qgemm_kernel_default.cpp
   ${MLAS_SRC_DIR}/qladd.cpp
   ${MLAS_SRC_DIR}/qlmul.cpp
@@ -57,6 +97,10 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/qdwconv_kernelsize.cpp
 )
 
+if(MLAS_AVXVNNI_SUPPORTED)
+  target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AVXVNNI_SUPPORTED)
+endif()
+
 if(MLAS_AMX_SUPPORTED)
   target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AMX_SUPPORTED)
 else()
@@ -164,16 +208,27 @@ function(setup_mlas_source_for_windows)
       "${MLAS_SRC_DIR}/intrinsics/avx2/*.cpp"
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+    set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "/arch:AVX2")
 
     target_sources(onnxruntime_mlas PRIVATE
       ${MLAS_SRC_DIR}/dgemm.cpp
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
+      ${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp
+      ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+      ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
+      ${MLAS_SRC_DIR}/convsym_kernel_amx.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse41.cpp
       ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/q4gemm_avx512.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/sgemm_smallm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/reduce_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/transcendental_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/qdwconv_avx512vnni.cpp
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAmx.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8U8KernelAvx2.asm
@@ -345,7 +400,9 @@ else()
           ${MLAS_SRC_DIR}/qgemm_kernel_neon.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_udot.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_sdot.cpp
+          ${MLAS_SRC_DIR}/qdwconv_kernel_sdot.cpp
         )
+        set_source_files_properties(${MLAS_SRC_DIR}/qdwconv_kernel_sdot.cpp PROPERTIES COMPILE_FLAGS " -march=armv8.2-a+dotprod ")
         if (NOT APPLE)
           set(mlas_platform_srcs
             ${mlas_platform_srcs}
@@ -516,6 +573,14 @@ else()
           ${MLAS_SRC_DIR}/x86_64/ErfKernelFma3.S
           ${MLAS_SRC_DIR}/intrinsics/avx2/qladd_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/q4gemm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/sgemm_smallm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/reduce_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/layernorm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/eltwise_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/transcendental_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/spgemm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/cast_avx2.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -526,6 +591,11 @@ else()
           ${MLAS_SRC_DIR}/x86_64/SpoolKernelAvx512F.S
           ${MLAS_SRC_DIR}/x86_64/TransKernelAvx512F.S
           ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/q4gemm_avx512.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/sgemm_smallm_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/reduce_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/transcendental_avx512f.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
@@ -537,10 +607,19 @@ else()
         )
         set_source_files_properties(${mlas_platform_srcs_avx512core} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl")
 
+        set(mlas_platform_srcs_avx512vnni
+          ${MLAS_SRC_DIR}/intrinsics/avx512/qdwconv_avx512vnni.cpp
+        )
+        set_source_files_properties(${mlas_platform_srcs_avx512vnni} PROPERTIES COMPILE_FLAGS "-mavx512f -mavx512bw -mavx512vl -mavx512vnni")
+
+        set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
+        set_source_files_properties(${MLAS_SRC_DIR}/intrinsics/avx2/cast_avx2.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
+
         set(mlas_platform_srcs
           ${MLAS_SRC_DIR}/activate_fp16.cpp
           ${MLAS_SRC_DIR}/dwconv.cpp
           ${MLAS_SRC_DIR}/dgemm.cpp
+          ${MLAS_SRC_DIR}/halfgemm_kernel_avx2.cpp
           ${MLAS_SRC_DIR}/pooling_fp16.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
           ${mlas_platform_srcs_sse2}
@@ -548,16 +627,40 @@ else()
           ${mlas_platform_srcs_avx2}
           ${mlas_platform_srcs_avx512f}
           ${mlas_platform_srcs_avx512core}
+          ${mlas_platform_srcs_avx512vnni}
         )
 
+        if(MLAS_AVXVNNI_SUPPORTED)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avxvnni.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avxvnni.cpp PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mavxvnni")
+        endif()
+
+        if(MLAS_AVX512FP16_SUPPORTED)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp
+          )
+          set_source_files_properties(${MLAS_SRC_DIR}/halfgemm_kernel_avx512fp16.cpp PROPERTIES COMPILE_FLAGS "-mavx512fp16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AVX512FP16_SUPPORTED)
+        endif()
+
         if(MLAS_AMX_SUPPORTED)
           set(mlas_platform_srcs
             ${mlas_platform_srcs}
             ${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp
             ${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S
+            ${MLAS_SRC_DIR}/convsym_kernel_amx.cpp
+            ${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp
+            ${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp
           )
           set_source_files_properties(${MLAS_SRC_DIR}/qgemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mamx-tile -mamx-int8 -mavx2 -mavx512bw -mavx512dq -mavx512vl")
           set_source_files_properties(${MLAS_SRC_DIR}/x86_64/QgemmU8S8KernelAmx.S PROPERTIES COMPILE_FLAGS "-mamx-tile -mamx-int8 -mavx2 -mavx512bw -mavx512dq -mavx512vl")
+          set_source_files_properties(${MLAS_SRC_DIR}/convsym_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mamx-tile -mamx-int8 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_avx512bf16.cpp PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
+          set_source_files_properties(${MLAS_SRC_DIR}/bf16gemm_kernel_amx.cpp PROPERTIES COMPILE_FLAGS "-mamx-tile -mamx-bf16 -mavx512bf16 -mavx512bw -mavx512dq -mavx512vl -mavx512f")
         endif()
 
         if(ONNXRUNTIME_MLAS_MULTI_ARCH)
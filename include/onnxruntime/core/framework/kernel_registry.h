@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string_view>
 
 #include "core/framework/op_kernel.h"
@@ -71,6 +72,14 @@ class KernelRegistry {
     return st.IsOK();
   }
 
+  // Returns the position of the kernel among the kernels registered for its op, domain and provider, which identifies
+  // the kernel across the processes that run the same build, or nullopt if the kernel is not in this registry.
+  std::optional<size_t> GetKernelOrdinal(const KernelCreateInfo& kernel_create_info) const;
+
+  // Returns the kernel at the position returned by GetKernelOrdinal(), or nullptr if there is none.
+  const KernelCreateInfo* GetKernelByOrdinal(std::string_view op_type, std::string_view domain,
+                                             std::string_view exec_provider, size_t ordinal) const;
+
   bool IsEmpty() const { return kernel_creator_fn_map_.empty(); }
 
   // This is used by the opkernel doc generator to enlist all registered operators for a given provider's opkernel
@@ -132,6 +132,35 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to restore the state that PrePack() sets for a constant tensor from the pre-packed
+  // buffers that PrePack() of an identical kernel produced for the same tensor in an earlier session, which are
+  // loaded from the pre-packed weights cache file (kOrtSessionOptionsConfigPrepackedWeightsCacheFile). Unlike
+  // UseSharedPrePackedBuffers(), PrePack() is not called first, so the kernel has to derive the metadata of the
+  // pre-packed weight from the tensor.
+  // @param tensor: The initialized constant tensor
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The pre-packed buffers in the order PrePack() stored them in the PrePackedWeights
+  //                           instance. The buffers are read-only and are not owned by the kernel.
+  // @param prepacked_buffer_sizes: The sizes in bytes of the pre-packed buffers.
+  // @param kernel_path: The value of GetKernelPath() after PrePack() packed the tensor.
+  // @param used_prepacked_buffers: Set to true if the kernel restored its state from the buffers. The tensor is
+  //                                packed by PrePack() otherwise.
+  virtual Status RestorePrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                         std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                         gsl::span<const size_t> /*prepacked_buffer_sizes*/,
+                                         const std::string& /*kernel_path*/,
+                                         /*out*/ bool& used_prepacked_buffers) {
+    used_prepacked_buffers = false;
+    return Status::OK();
+  }
+
+  // Override this function to describe the implementation this kernel selected for its inputs, e.g. the
+  // format of a pre-packed weight. A non-empty value is recorded as "kernel_path" in the profiler events of
+  // the node.
+  virtual std::string GetKernelPath() const {
+    return {};
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -667,6 +667,16 @@ typedef void (*OrtCustomJoinThreadFn)(OrtCustomThreadHandle ort_custom_thread_ha
 
 typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options, const OrtApiBase* api);
 
+/** \brief Callback function for OrtApi::RunAsync
+ *
+ * \param[in] user_data The user_data passed to OrtApi::RunAsync
+ * \param[in] outputs The output array passed to OrtApi::RunAsync, with the outputs of a successful run
+ * \param[in] num_outputs The number of outputs
+ * \param[in] status nullptr on success, else the error of the run. The callback owns the status and must release it
+ *                   with OrtApi::ReleaseStatus
+ */
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
+
 /** \brief The C API
  *
  * All C API functions are defined inside this structure as pointers to functions.
@@ -4193,6 +4203,44 @@ struct OrtApi {
    * \since Version 1.15.
    */
   ORT_API2_STATUS(KernelContext_GetAllocator, _In_ const OrtKernelContext* context, _In_ const OrtMemoryInfo* mem_info, _Outptr_ OrtAllocator** out);
+
+  /** \brief Run the model asynchronously
+   *
+   * Queues the run on threads owned by the session and returns without waiting for it. The threads are separate
+   * from the intra-op thread pool and their number is set by the "session.run_async_num_threads" session config
+   * entry. Any number of runs may be queued; the callback is invoked on one of the threads once the run completes.
+   *
+   * The input names, the output names and the inputs are copied or referenced before returning, so the caller may
+   * release them. The outputs are filled as by OrtApi::Run when the run completes, so the output array must stay
+   * valid until the callback is invoked. The session must not be released from the callback. Releasing the session
+   * waits for the queued runs to complete.
+   *
+   * \param[in] session
+   * \param[in] run_options If nullptr, will use a default ::OrtRunOptions. Must stay valid until the callback is
+   *                        invoked. Setting its terminate flag with OrtApi::RunOptionsSetTerminate cancels the run,
+   *                        including a run that is still queued, and the callback receives an error status.
+   * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+   * \param[in] input Array of ::OrtValue%s of the input values
+   * \param[in] input_len Number of elements in the input_names and inputs arrays
+   * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+   * \param[in] output_names_len Number of elements in the output_names and outputs array
+   * \param[out] output Array of ::OrtValue%s that the outputs are stored in. This can also be
+   *     an array of nullptr values, in this case ::OrtValue objects will be allocated and pointers
+   *     to them will be set into the `output` array before the callback is invoked.
+   * \param[in] run_async_callback Callback invoked with the outputs and the status of the run
+   * \param[in] user_data User data passed to the callback
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   * The callback is not invoked when an error is returned.
+   *
+   * \since Version 1.16.
+   */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
 };
 
 /*
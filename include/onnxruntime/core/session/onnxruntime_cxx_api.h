@@ -27,6 +27,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <array>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -779,6 +780,26 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model asynchronously on threads owned by the session
+   *
+   * Wraps OrtApi::RunAsync
+   *
+   * The run_options and the output_values array must stay valid until the callback is invoked.
+   * The callback owns the OrtStatus it receives, which can be wrapped in an Ort::Status.
+   */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback,
+                void* user_data);
+
+  /** \brief Run the model asynchronously returning a future of the outputs
+   *
+   * Same as RunAsync(const RunOptions&, const char* const*, const Value*, size_t, const char* const*, Value*, size_t, RunAsyncCallbackFn, void*)
+   * with outputs allocated by the run. The future holds the outputs in the order of output_names, or an Ort::Exception
+   * with the error of the run. The run_options must stay valid until the future is ready.
+   */
+  std::future<std::vector<Value>> RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                                           size_t input_count, const char* const* output_names, size_t output_count);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
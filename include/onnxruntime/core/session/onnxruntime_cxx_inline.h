@@ -914,6 +914,53 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                     const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback,
+                                     void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(this->p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                 ort_output_values, callback, user_data));
+}
+
+/// Owns the promise and the outputs of a RunAsync call until its callback completes the promise.
+struct RunAsyncPromise {
+  std::promise<std::vector<Value>> promise;
+  std::vector<OrtValue*> outputs;
+
+  static void ORT_API_CALL Callback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+    std::unique_ptr<RunAsyncPromise> state{static_cast<RunAsyncPromise*>(user_data)};
+    Status run_status{status};
+    if (!run_status.IsOK()) {
+      state->promise.set_exception(std::make_exception_ptr(Exception(run_status.GetErrorMessage(), run_status.GetErrorCode())));
+      return;
+    }
+
+    std::vector<Value> output_values;
+    output_values.reserve(num_outputs);
+    for (size_t i = 0; i < num_outputs; i++)
+      output_values.emplace_back(outputs[i]);
+    state->promise.set_value(std::move(output_values));
+  }
+};
+
+template <typename T>
+inline std::future<std::vector<Value>> SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values,
+                                                                size_t input_count, const char* const* output_names, size_t output_count) {
+  auto state = std::make_unique<RunAsyncPromise>();
+  state->outputs.resize(output_count, nullptr);
+  auto future = state->promise.get_future();
+
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  ThrowOnError(GetApi().RunAsync(this->p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                 state->outputs.data(), RunAsyncPromise::Callback, state.get()));
+
+  // the callback owns the state once the run is queued
+  state.release();
+  return future;
+}
+
 template <typename T>
 inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* allocator) {
   char* out = nullptr;
@@ -67,6 +67,12 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the conversion of fp32 Conv and FusedConv nodes to channels last (NHWC) convolutions by the
+// level 3 NHWC transformer. This removes the layout transposes around the convolutions of models that are fed
+// NHWC images, in place of the NCHWc layout transformer which is then not applied.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableNhwcFp32Conv = "optimization.enable_nhwc_fp32_conv";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
@@ -197,3 +203,102 @@ static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "sess
 //   3) after the L1 transformers are applied to the updated graph.
 // The model will be saved to filename post_layout_transform_step_<step_number>.onnx.
 static const char* const kDebugLayoutTransformation = "session.debug_layout_transformation";
+
+// Gemm fastmath mode provides bfloat16 accelerated fp32 matrix multiplication for the MatMul, Gemm and
+// FusedMatMul CPU kernels. The constant weights are rounded to bfloat16 and pre-packed, the activations are
+// rounded to bfloat16 and the products are accumulated in fp32, which trades precision for throughput.
+// It is only effective on x64 platforms with AVX512_BF16 or AMX-BF16 support.
+//
+// Option values:
+// - "0": Gemm fastmath mode is not enabled. [DEFAULT]
+// - "1": Gemm fastmath mode is enabled.
+static const char* const kOrtSessionOptionsMlasGemmFastMathBf16 = "mlas.enable_gemm_fastmath_bfloat16";
+
+// Sparsity threshold of the block sparse weight path of the fp32 MatMul and FusedMatMul CPU kernels. A constant
+// 2D weight matrix is pre-packed in a block sparse row format when at least this fraction of the multiply work
+// can be skipped as zero blocks, and then multiplied by a kernel that only visits the non-zero blocks.
+// Weights pruned to 1x4 or 4x4 blocks are the intended use case; unstructured sparsity rarely reaches the threshold.
+//
+// Option values:
+// - A fraction in [0, 1]. The default is "0.7", about where the sparse kernel overtakes the dense SGEMM.
+// - A value greater than 1 disables the block sparse path.
+static const char* const kOrtSessionOptionsMlasSparseGemmThreshold = "mlas.sparse_gemm_sparsity_threshold";
+
+// Number of threads of the executor that runs the RunAsync calls of the session. The executor is separate from the
+// intra-op and inter-op thread pools and is created by the first RunAsync call. Each thread executes one run at a
+// time, so this bounds the number of concurrent runs while any number of RunAsync calls may be queued.
+//
+// Option values:
+// - "0": One thread per physical core. [DEFAULT]
+// - A positive number of threads.
+static const char* const kOrtSessionOptionsConfigRunAsyncNumThreads = "session.run_async_num_threads";
+
+// Dynamic batching coalesces concurrent Run calls whose inputs have the same names, types and shapes except along the
+// batch dimension into a single run of the model, and splits the outputs back to the callers. The first call of a
+// batch waits until the batch reaches the maximum size or the maximum wait time elapses, so a call that is not joined
+// by others is delayed by up to the maximum wait time.
+// Only calls with CPU tensor inputs of numeric types and without pre-allocated outputs are batched. The model must
+// process the rows of the batch dimension independently and produce outputs that are batched along the same dimension.
+// Calls with a different run tag or log level are not batched together. If the model fails on a batch that it runs
+// fine call by call, later calls with the same inputs are run on their own without waiting.
+//
+// The maximum batch size, in rows of the batch dimension, of the coalesced run.
+// Option values:
+// - "0" or "1": Dynamic batching is disabled. [DEFAULT]
+// - A larger number of rows enables dynamic batching.
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize = "session.dynamic_batching_max_batch_size";
+
+// The maximum time in microseconds that the first call of a batch waits for more calls. The default is "1000".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs = "session.dynamic_batching_max_wait_us";
+
+// The dimension along which the inputs are concatenated and the outputs are split. The default is "0".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingBatchDim = "session.dynamic_batching_batch_dim";
+
+// Path of a file that persists the pre-packed weights of the CPU kernels of the model across sessions and processes.
+// A session memory maps the file and restores the pre-packed weights of the kernels that support it instead of
+// packing them again, so the processes that serve the same model share a single copy of the weights in the page cache
+// and start faster. The weights that are not in the file are packed as usual and the file is rewritten at the end of
+// session initialization. The file is replaced atomically, so concurrent sessions may use the same file.
+// The file is ignored and rewritten when it was written by a different ONNX Runtime version, CPU or session
+// configuration. Use a separate file per model, as each session only keeps the weights of its own model.
+// Shared initializers whose pre-packed weights are shared through a PrepackedWeightsContainer are not cached.
+//
+// Option values:
+// - "": The pre-packed weights are not persisted. [DEFAULT]
+// - A file path.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheFile = "session.prepacked_weights_cache_file";
+
+// Path of a file that persists the state of an initialized session of an ONNX model loaded from a file path, so
+// later sessions of the same model initialize faster. The first session writes the graph after optimization and
+// partitioning, the kernel selected for each node and the execution plan to the file at the end of initialization.
+// Later sessions memory map the file, load the optimized graph from it and restore the kernels and the plan instead
+// of optimizing the graph, searching the kernel registries and planning the allocations again.
+// The file is ignored and rewritten when it was written for a different model file, ONNX Runtime build, CPU, session
+// configuration or set of execution providers. The file is replaced atomically, so concurrent sessions may use the
+// same file. Use a separate file per model.
+// The snapshot is not used with models whose initializers have external data, with custom ops, with disabled
+// optimizers or custom graph transformers, or with execution providers that compile nodes.
+//
+// Option values:
+// - "": Session snapshots are not used. [DEFAULT]
+// - A file path.
+static const char* const kOrtSessionOptionsConfigSessionSnapshotFile = "session.snapshot_file";
+
+// Disables the parallel initialization of sessions.
+// By default the initializers placed on the CPU are deserialized, the kernels of the CPU EP are created and their
+// constant initializers are pre-packed concurrently on the intra-op thread pool while the session state is finalized.
+// The result does not depend on the number of threads.
+//
+// Option values:
+// - "0": Session initialization uses the intra-op thread pool. [DEFAULT]
+// - "1": Session initialization runs on the calling thread only.
+static const char* const kOrtSessionOptionsConfigDisableParallelInitialization = "session.disable_parallel_initialization";
+
+// Sets the size in bytes of the batches of CPU initializers that are deserialized concurrently while a session is
+// initialized. The initializers of a batch are saved to the session once the batch is deserialized, so a smaller size
+// bounds the memory held by both the serialized and the deserialized copies, and a larger one exposes more parallelism.
+//
+// Option values:
+// - A positive integer. The default is "268435456" (256MB).
+static const char* const kOrtSessionOptionsConfigInitializerDeserializationBatchSize =
+    "session.initializer_deserialization_batch_size";
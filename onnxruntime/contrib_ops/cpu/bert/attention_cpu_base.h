@@ -6,6 +6,9 @@
 #include "attention_base.h"
 #include "attention_helper.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
@@ -53,21 +56,6 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
-    // Compute the attention score.
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
-    bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
-
-    void* mask_data = nullptr;
-    if (mask_index != nullptr || has_unidirectional) {
-      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
-      mask_data = allocator->Alloc(mask_data_bytes);
-      memset(mask_data, 0, mask_data_bytes);
-    }
-    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
-
     const int32_t* mask_index_data = mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr;
     gsl::span<const int64_t> mask_index_dims = mask_index != nullptr
                                                    ? mask_index->Shape().GetDims()
@@ -84,6 +72,35 @@ class AttentionCPUBase : public AttentionBase {
       relative_position_bias_data = relative_position_bias->Data<T>();
     }
 
+    bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+
+    // The 4D mask is not supported by either path, so it is left to PrepareMask to report.
+    if constexpr (std::is_same<T, float>::value) {
+      if (mask_index_dims.size() != 4) {
+        ComputeAttentionTiled(output->MutableData<T>(), Q, K, V,
+                              mask_index_data, mask_index_dims, has_unidirectional,
+                              batch_size, sequence_length, kv_sequence_length, past_sequence_length,
+                              qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size,
+                              past_data, past_key_data, past_value_data,
+                              present_data, present_key_data, present_value_data,
+                              relative_position_bias_data, allocator, tp);
+        return Status::OK();
+      }
+    }
+
+    // Compute the attention score.
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
+    void* mask_data = nullptr;
+    if (mask_index != nullptr || has_unidirectional) {
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
+      mask_data = allocator->Alloc(mask_data_bytes);
+      memset(mask_data, 0, mask_data_bytes);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data), has_unidirectional,
                              batch_size, sequence_length, kv_sequence_length, past_sequence_length,
@@ -282,6 +299,250 @@ class AttentionCPUBase : public AttentionBase {
       }
     });
   }
+
+  // Helper function to compute the attention without materializing the attention probs:
+  //  output(B, S, N, H_v) = Softmax(1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) + mask) x V(B, N, T, H_v)
+  // Each task handles a block of query rows of one head. The keys and values are visited one tile at a time with
+  // an online softmax that keeps the running maximum and sum of each row, so the scratch space is a block of scores
+  // and an accumulator of the output rows per thread instead of BxNxSxT scores and a BxSxT mask. Tiles of keys that
+  // are hidden from every row of the block by the unidirectional mask are skipped once their weights vanish.
+  template <typename T>
+  void ComputeAttentionTiled(T* output,                                 // output with size BxSxNxH_v
+                             const T* Q,                                // Q data. Its size is BxNxSxH
+                             const T* K,                                // k data. Its size is BxNxLxH
+                             const T* V,                                // V value with size BxNxLxH_v
+                             const int32_t* mask_index,                 // mask index. nullptr if no mask.
+                             gsl::span<const int64_t> mask_index_dims,  // mask index shape
+                             bool has_unidirectional,                   // has unidirectional mask
+                             int batch_size,                            // batch size of self-attention
+                             int sequence_length,                       // sequence length of self-attention (S)
+                             int kv_sequence_length,                    // sequence length of cross-attention (L)
+                             int past_sequence_length,                  // sequence length of past state
+                             int head_size,                             // head size of Q or K (H)
+                             int v_head_size,                           // head size of V (H_v)
+                             int v_hidden_size,                         // hidden size of V (D_v)
+                             const T* past,                             // past state
+                             const T* past_key,                         // past key only (if not using past state)
+                             const T* past_value,                       // past value only (if not using past state)
+                             T* present,                                // present state
+                             T* present_key,                            // present key only (if not using present state)
+                             T* present_value,                          // present value only (if not using present state)
+                             const T* relative_position_bias_data,      // bias addition matrix with shape BxNxSxT
+                             const AllocatorPtr& allocator,             // allocator for the scratch space
+                             ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;                  // T = P + L
+    const size_t past_k_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;     // P x H
+    const size_t past_v_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;   // P x H_v
+    const size_t k_input_chunk_length = static_cast<size_t>(kv_sequence_length) * head_size;      // L x H
+    const size_t v_input_chunk_length = static_cast<size_t>(kv_sequence_length) * v_head_size;    // L x H_v
+    const size_t present_k_chunk_length = past_k_chunk_length + k_input_chunk_length;             // T x H
+    const size_t present_v_chunk_length = past_v_chunk_length + v_input_chunk_length;             // T x H_v
+    const int loop_len = batch_size * num_heads_;
+
+    // The past and present states hold all of K followed by all of V.
+    const T* past_v = past;
+    T* present_v = present;
+    if (nullptr != past) {
+      past_v += SafeInt<ptrdiff_t>(batch_size) * num_heads_ * past_sequence_length * v_head_size;
+    }
+    if (nullptr != present) {
+      present_v += SafeInt<ptrdiff_t>(batch_size) * num_heads_ * total_sequence_length * v_head_size;
+    }
+
+    // Concatenate past_K and K, and past_V and V, before the query blocks of a head read them.
+    if (nullptr != present || nullptr != present_key || nullptr != present_value) {
+      const double concat_cost = static_cast<double>(total_sequence_length) * (head_size + v_head_size);
+      ThreadPool::TryParallelFor(tp, loop_len, concat_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          if (nullptr != present) {
+            ConcatStateChunk(past, K + k_input_chunk_length * i, present,
+                             past_k_chunk_length, present_k_chunk_length, i);
+            ConcatStateChunk(past_v, V + v_input_chunk_length * i, present_v,
+                             past_v_chunk_length, present_v_chunk_length, i);
+          } else {
+            if (nullptr != present_key) {
+              ConcatStateChunk(past_key, K + k_input_chunk_length * i, present_key,
+                               past_k_chunk_length, present_k_chunk_length, i);
+            }
+            if (nullptr != present_value) {
+              ConcatStateChunk(past_value, V + v_input_chunk_length * i, present_value,
+                               past_v_chunk_length, present_v_chunk_length, i);
+            }
+          }
+        }
+      });
+    }
+
+    const T* k_data = K;
+    size_t k_chunk_length = k_input_chunk_length;
+    if (nullptr != present || nullptr != present_key) {
+      k_data = (nullptr != present) ? present : present_key;
+      k_chunk_length = present_k_chunk_length;
+    }
+
+    const T* v_data = V;
+    size_t v_chunk_length = v_input_chunk_length;
+    if (nullptr != present || nullptr != present_value) {
+      v_data = (nullptr != present) ? present_v : present_value;
+      v_chunk_length = present_v_chunk_length;
+    }
+
+    // The query block and the key tile are sized so that a tile of K and V and the scores of the block stay in a
+    // 256KB L2 cache.
+    constexpr int kQueryBlockSize = 64;
+    constexpr size_t kL2CacheBytes = 256 * 1024;
+    const int q_block_size = std::min(kQueryBlockSize, sequence_length);
+    int kv_block_size = static_cast<int>(kL2CacheBytes / (sizeof(T) * (head_size + v_head_size + q_block_size)));
+    kv_block_size = std::min(std::max(kv_block_size / 16 * 16, 16), total_sequence_length);
+
+    // A weight of exp(-88) or less is below the precision of a row sum that is at least 1.
+    constexpr float kNegligibleScoreDifference = -88.0f;
+
+    const int q_block_count = (sequence_length + q_block_size - 1) / q_block_size;
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    const bool can_skip_masked_tiles = relative_position_bias_data == nullptr && mask_filter_value_ < 0.0f;
+
+    const size_t scratch_length = SafeInt<size_t>(q_block_size) * (kv_block_size + v_head_size + 2) + kv_block_size;
+
+    // The cost of both Gemms of a query block
+    const double cost = static_cast<double>(q_block_size) * total_sequence_length * (head_size + v_head_size);
+
+    ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(loop_len) * q_block_count, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      auto scratch = IAllocator::MakeUniquePtr<T>(allocator, scratch_length);
+      T* scores = scratch.get();                                                    // q_block x kv_block
+      T* accumulator = scores + static_cast<size_t>(q_block_size) * kv_block_size;  // q_block x H_v
+      T* row_max = accumulator + static_cast<size_t>(q_block_size) * v_head_size;   // q_block
+      T* row_sum = row_max + q_block_size;                                          // q_block
+      T* mask_row = row_sum + q_block_size;                                         // kv_block
+
+      for (std::ptrdiff_t task = begin; task != end; ++task) {
+        const std::ptrdiff_t i = task / q_block_count;
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int q_start = static_cast<int>(task % q_block_count) * q_block_size;
+        const int q_count = std::min(q_block_size, sequence_length - q_start);
+
+        const T* q = Q + (static_cast<size_t>(i) * sequence_length + q_start) * head_size;
+        const T* k = k_data + k_chunk_length * i;
+        const T* v = v_data + v_chunk_length * i;
+
+        std::fill_n(accumulator, static_cast<size_t>(q_count) * v_head_size, static_cast<T>(0.0f));
+        std::fill_n(row_max, q_count, -std::numeric_limits<T>::infinity());
+        std::fill_n(row_sum, q_count, static_cast<T>(0.0f));
+
+        for (int kv_start = 0; kv_start < total_sequence_length; kv_start += kv_block_size) {
+          const int kv_count = std::min(kv_block_size, total_sequence_length - kv_start);
+
+          // Whether the unidirectional mask hides the whole tile from every row of the block.
+          const bool is_masked_tile = has_unidirectional && kv_start > past_sequence_length + q_start + q_count - 1;
+
+          if (is_masked_tile && can_skip_masked_tiles) {
+            // The scores of this tile and the following ones are at most mask_filter_value.
+            const T minimum_row_max = *std::min_element(row_max, row_max + q_count);
+            if (mask_filter_value_ - minimum_row_max < kNegligibleScoreDifference) {
+              break;
+            }
+          }
+
+          // Compute Q*K' of the tile. The scores of a masked tile are replaced by the mask below.
+          //                     original                 transposed             each iteration
+          // A: Q                (B x N x) S x H          (B x N x) S x H        q_block x H
+          // B: K'               (B x N x) T x H          (B x N x) H x T        H x kv_block
+          // C: scores                                                           q_block x kv_block
+          if (!is_masked_tile) {
+            math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, q_count, kv_count, head_size, alpha,
+                                      q, k + static_cast<size_t>(kv_start) * head_size, 0.0f,
+                                      scores, nullptr);
+          }
+
+          bool has_weights = false;
+
+          for (int r = 0; r < q_count; r++) {
+            const int s = q_start + r;
+            T* score = scores + static_cast<size_t>(r) * kv_count;
+
+            // Positions after past_sequence_length + s are hidden by the unidirectional mask, and their scores are
+            // replaced by the mask for parity with huggingface implementation.
+            int visible_count = kv_count;
+            if (has_unidirectional) {
+              visible_count = std::min(std::max(past_sequence_length + s + 1 - kv_start, 0), kv_count);
+            }
+
+            if (mask_index != nullptr) {
+              PrepareMaskRow(mask_index, mask_index_dims, mask_row, batch_index, batch_size, s, sequence_length,
+                             total_sequence_length, kv_start, kv_start + kv_count, mask_filter_value_);
+              for (int j = 0; j < visible_count; j++) {
+                score[j] += mask_row[j];
+              }
+              for (int j = visible_count; j < kv_count; j++) {
+                score[j] = mask_row[j] + static_cast<T>(mask_filter_value_);
+              }
+            } else {
+              for (int j = visible_count; j < kv_count; j++) {
+                score[j] = static_cast<T>(mask_filter_value_);
+              }
+            }
+
+            if (relative_position_bias_data != nullptr) {
+              const T* bias = relative_position_bias_data +
+                              (static_cast<size_t>(i) * sequence_length + s) * total_sequence_length + kv_start;
+              for (int j = 0; j < kv_count; j++) {
+                score[j] += bias[j];
+              }
+            }
+
+            // Update the running maximum and sum of the row, rescaling the output accumulated so far.
+            const T tile_max = *std::max_element(score, score + kv_count);
+            if (tile_max == -std::numeric_limits<T>::infinity() ||
+                tile_max - row_max[r] < kNegligibleScoreDifference) {
+              std::fill_n(score, kv_count, static_cast<T>(0.0f));
+              continue;
+            }
+
+            if (tile_max > row_max[r]) {
+              const T correction = std::exp(row_max[r] - tile_max);
+              T* accumulator_row = accumulator + static_cast<size_t>(r) * v_head_size;
+              for (int j = 0; j < v_head_size; j++) {
+                accumulator_row[j] *= correction;
+              }
+              row_sum[r] *= correction;
+              row_max[r] = tile_max;
+            }
+
+            for (int j = 0; j < kv_count; j++) {
+              score[j] -= row_max[r];
+            }
+            MlasComputeExp(score, score, static_cast<size_t>(kv_count));
+
+            T sum = 0.0f;
+            for (int j = 0; j < kv_count; j++) {
+              sum += score[j];
+            }
+            row_sum[r] += sum;
+            has_weights = true;
+          }
+
+          // accumulator(q_block, H_v) += exp(scores)(q_block, kv_block) x V(kv_block, H_v)
+          if (has_weights) {
+            math::Gemm<T, ThreadPool>(CblasNoTrans, CblasNoTrans, q_count, v_head_size, kv_count, 1.0f,
+                                      scores, v + static_cast<size_t>(kv_start) * v_head_size, 1.0f,
+                                      accumulator, nullptr);
+          }
+        }
+
+        // Normalize and transpose: accumulator(q_block, H_v) -> out(B, S, N, H_v)
+        for (int r = 0; r < q_count; r++) {
+          const T* src = accumulator + static_cast<size_t>(r) * v_head_size;
+          T* dest = output + (SafeInt<ptrdiff_t>(batch_index) * sequence_length + q_start + r) * v_hidden_size +
+                    static_cast<ptrdiff_t>(head_index) * v_head_size;
+          const T inverse_sum = row_sum[r] > 0.0f ? 1.0f / row_sum[r] : 0.0f;
+          for (int j = 0; j < v_head_size; j++) {
+            dest[j] = src[j] * inverse_sum;
+          }
+        }
+      }
+    });
+  }
 };
 
 }  // namespace contrib
@@ -151,6 +151,56 @@ void PrepareMask(const int32_t* mask_index,
   }
 }
 
+// Computes the mask of a single query row for the key positions [start, end), which is row sequence_index of
+// batch batch_index of the mask prepared by PrepareMask before the unidirectional mask is applied.
+template <typename T>
+void PrepareMaskRow(const int32_t* mask_index,
+                    gsl::span<const int64_t> mask_index_dims,
+                    T* mask_row,
+                    int batch_index,
+                    int batch_size,
+                    int sequence_index,
+                    int sequence_length,
+                    int all_sequence_length,
+                    int start,
+                    int end,
+                    float mask_filter_value) {
+  const int length = end - start;
+
+  // For 3D mask, convert values 0 to mask_filter_value, and 1 to 0.0.
+  if (mask_index_dims.size() == 3) {
+    const int32_t* mask = mask_index +
+                          (SafeInt<ptrdiff_t>(batch_index) * sequence_length + sequence_index) * all_sequence_length;
+    for (int m_i = start; m_i < end; m_i++) {
+      mask_row[m_i - start] = (mask[m_i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(mask_filter_value);
+    }
+    return;
+  }
+
+  // Raw attention mask has value 0 or 1. Here we convert 0 to mask_filter_value, and 1 to 0.0.
+  if (mask_index_dims.size() == 2) {
+    const int32_t* raw_mask = mask_index + SafeInt<ptrdiff_t>(batch_index) * all_sequence_length;
+    for (int m_i = start; m_i < end; m_i++) {
+      mask_row[m_i - start] = (raw_mask[m_i] > 0) ? static_cast<T>(0.0f) : static_cast<T>(mask_filter_value);
+    }
+    return;
+  }
+
+  // mask_index is 1D: (B) or (2B). Mask values at or after the end position, or before the start position
+  // if there is one, are mask_filter_value.
+  const int end_position = mask_index[batch_index];
+  int start_position = 0;
+  if (static_cast<int>(mask_index_dims[0]) == 2 * batch_size) {
+    start_position = std::min(mask_index[batch_index + batch_size], all_sequence_length);
+  }
+
+  for (int i = 0; i < length; i++) {
+    const int m_i = start + i;
+    mask_row[i] = (m_i >= end_position || m_i < start_position) ? static_cast<T>(mask_filter_value)
+                                                                : static_cast<T>(0.0f);
+  }
+}
+
 // Concatenate a past state chunk PxH with input state chunk LxH into present state chunk TxH
 // Returns a pointer to the start of present state chunk.
 template <typename T>
@@ -14,9 +14,6 @@ class BiasGelu : public OpKernel {
  public:
   BiasGelu(const OpKernelInfo& info) : OpKernel(info) {}
   Status Compute(OpKernelContext* context) const override;
-
- protected:
-  void AddBiasGelu(const T* input, const T* bias, T* temp, T* output, int64_t count) const;
 };
 
 }  // namespace contrib
@@ -2,11 +2,14 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/conv.h"
+#include "core/common/safeint.h"
 #include "contrib_ops/cpu/fused_activation.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+using ConvPadVector = ConvAttributes::ConvPadVector;
+
 class FusedConvFloat final : public Conv<float> {
  public:
   FusedConvFloat(const OpKernelInfo& info) : Conv<float>(info) {
@@ -22,5 +25,209 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     FusedConvFloat);
 
+/**
+ * @brief Convolution of channels last (NHWC) fp32 tensors with an optional fused activation and Add.
+ *
+ * The filter is in the same (M x C/group x kH x kW) layout as Conv and is packed by MLAS. The optional
+ * input Z is added BEFORE the activation, as done by FusedConv.
+ */
+class NhwcFusedConvFloat final : public OpKernel {
+ public:
+  NhwcFusedConvFloat(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  static size_t KernelSize(const TensorShape& W_shape) {
+    return static_cast<size_t>(W_shape.SizeFromDimension(2));
+  }
+
+  MLAS_ACTIVATION activation_;
+  ConvAttributes conv_attrs_;
+  TensorShape W_shape_;
+  BufferUniquePtr packed_W_buffer_;
+};
+
+Status NhwcFusedConvFloat::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                   /*out*/ bool& is_packed,
+                                   /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only pack the filter tensor
+  const auto& shape = tensor.Shape();
+  if (input_idx != 1 || shape.NumDimensions() < 3 || shape.NumDimensions() > 5 || shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t input_channels = static_cast<size_t>(shape[1]);
+  const size_t filter_count = static_cast<size_t>(shape[0]) / group_count;
+  const size_t kernel_size = KernelSize(shape);
+
+  const size_t packed_W_size = MlasConvNhwcPackFilterSize(group_count, input_channels, filter_count, kernel_size);
+  auto* packed_W = alloc->Alloc(packed_W_size);
+
+  // Initialize memory to 0 as there could be some padding associated with pre-packed
+  // buffer memory and we don not want it uninitialized and generate different hashes
+  // if and when we try to cache this pre-packed buffer for sharing between sessions.
+  memset(packed_W, 0, packed_W_size);
+
+  packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(std::move(alloc)));
+
+  MlasConvNhwcPackFilter(group_count, input_channels, filter_count, kernel_size, tensor.Data<float>(), packed_W);
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_W_size);
+  }
+
+  W_shape_ = shape;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                     int input_idx,
+                                                     /*out*/ bool& used_shared_buffers) {
+  if (input_idx != 1) {
+    return Status::OK();
+  }
+
+  used_shared_buffers = true;
+  packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  return Status::OK();
+}
+
+Status NhwcFusedConvFloat::Compute(OpKernelContext* context) const {
+  size_t num_inputs = OpKernel::Node().InputDefs().size();
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = packed_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const size_t kernel_rank = kernel_shape.size();
+  if (kernel_rank < 1 || kernel_rank > 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported convolution rank: ", kernel_rank);
+  }
+
+  ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1 + kernel_rank];
+  const int64_t M = W_shape[0];
+
+  TensorShapeVector Y_dims({N});
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t input_channels = static_cast<size_t>(C) / group_count;
+  const size_t filter_count = static_cast<size_t>(M) / group_count;
+  const size_t kernel_size = KernelSize(W_shape);
+
+  // Handle the case of a dynamic weight filter.
+  const void* packed_W = packed_W_buffer_.get();
+  BufferUniquePtr dynamic_W_buffer;
+  if (packed_W == nullptr) {
+    auto* dynamic_W = alloc->Alloc(MlasConvNhwcPackFilterSize(group_count, input_channels, filter_count, kernel_size));
+    dynamic_W_buffer = BufferUniquePtr(dynamic_W, BufferDeleter(alloc));
+    MlasConvNhwcPackFilter(group_count, input_channels, filter_count, kernel_size, W->Data<float>(), dynamic_W);
+    packed_W = dynamic_W;
+  }
+
+  auto* Ydata = Y->MutableData<float>();
+  // Check for the optional Conv/Sum fusion.
+  float Beta = 0.0f;
+  if (Sum != nullptr) {
+    const auto& sum_shape = Sum->Shape();
+    ORT_RETURN_IF_NOT(Y->Shape() == sum_shape, "output and sum shape must match");
+    // If the output was not allocated inplace with the sum tensor, then copy here.
+    const auto* sum_data = Sum->Data<float>();
+    if (Ydata != sum_data) {
+      memcpy(Ydata, sum_data, SafeInt<size_t>(sum_shape.Size()) * sizeof(float));
+    }
+    Beta = 1.0f;
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  MLAS_CONV_PARAMETERS Parameters;
+  size_t WorkingBufferSize;
+  MlasConvNhwcPrepare(&Parameters,
+                      kernel_rank,
+                      static_cast<size_t>(N),
+                      group_count,
+                      input_channels,
+                      input_shape.GetDims().data(),
+                      kernel_shape.data(),
+                      dilations.data(),
+                      pads.data(),
+                      strides.data(),
+                      output_shape.GetDims().data(),
+                      filter_count,
+                      &activation_,
+                      &WorkingBufferSize,
+                      Beta,
+                      thread_pool);
+
+  auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
+                                             : nullptr;
+  BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
+
+  MlasConvNhwc(&Parameters,
+               X->Data<float>(),
+               packed_W,
+               B != nullptr ? B->Data<float>() : nullptr,
+               static_cast<float*>(working_buffer.get()),
+               Ydata,
+               thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NhwcFusedConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcFusedConvFloat);
+
 }  // namespace contrib
 }  // namespace onnxruntime
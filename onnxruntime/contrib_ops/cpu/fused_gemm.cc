@@ -21,6 +21,23 @@ class FusedGemm final : public Gemm<T> {
       }
     }
     ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
+
+    // Activations that MLAS can apply to the output tiles as part of the SGEMM epilogue.
+    MLAS_ACTIVATION mlas_activation;
+    if (activation == "Relu") {
+      mlas_activation.ActivationKind = MlasReluActivation;
+    } else if (activation == "LeakyRelu") {
+      mlas_activation.ActivationKind = MlasLeakyReluActivation;
+      auto alpha = attrs.find("alpha");
+      mlas_activation.Parameters.LeakyRelu.alpha = alpha != attrs.end() ? alpha->second.f() : 0.01f;
+    } else if (activation == "Tanh") {
+      mlas_activation.ActivationKind = MlasTanhActivation;
+    } else if (activation == "Sigmoid") {
+      mlas_activation.ActivationKind = MlasLogisticActivation;
+    } else {
+      return;
+    }
+    this->mlas_activation_ = mlas_activation;
   }
 };
 
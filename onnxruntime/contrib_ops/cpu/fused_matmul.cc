@@ -23,5 +23,13 @@ ONNX_OPERATOR_KERNEL_EX(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
+ONNX_OPERATOR_KERNEL_EX(
+    FusedMatMulActivation,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MatMul<float>);
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//
+// MatMul with the right hand side matrix quantized to int4 blocks and packed
+// by MlasQ4GemmPackB. The weights are dequantized on the fly by the MLAS
+// kernel, which reduces the memory traffic for B by about 8x compared to a
+// fp32 MatMul. This helps memory bound workloads such as token generation
+// in large language models.
+//
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas_q4.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulFpQ4 final : public OpKernel {
+ public:
+  MatMulFpQ4(const OpKernelInfo& info) : OpKernel(info) {
+    const int64_t blk_quant_type = info.GetAttrOrDefault<int64_t>("blk_quant_type", static_cast<int64_t>(BlkQ4Zp8));
+    ORT_ENFORCE(blk_quant_type >= BlkQ4Sym && blk_quant_type <= BlkQ4Sym128,
+                "MatMulFpQ4: unsupported blk_quant_type ", blk_quant_type);
+    blk_quant_type_ = static_cast<MLAS_BLK_QUANT_TYPE>(blk_quant_type);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  MLAS_BLK_QUANT_TYPE blk_quant_type_{BlkQ4Zp8};
+};
+
+Status MatMulFpQ4::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* b_shape_tensor = ctx->Input<Tensor>(2);
+  const Tensor* bias = ctx->Input<Tensor>(3);
+
+  ORT_RETURN_IF_NOT(b_shape_tensor->Shape().NumDimensions() == 1 && b_shape_tensor->Shape().Size() == 2,
+                    "MatMulFpQ4: B_shape must be a 1-D tensor with 2 elements: [K, N]");
+  const auto b_dims = b_shape_tensor->DataAsSpan<int64_t>();
+  const TensorShape b_shape({b_dims[0], b_dims[1]});
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  const size_t packed_b_size = MlasQ4GemmPackBSize(blk_quant_type_, N, K);
+  ORT_RETURN_IF_NOT(packed_b_size != 0, "MatMulFpQ4: int4 block quantization is not supported on this platform");
+  ORT_RETURN_IF_NOT(b->Shape().NumDimensions() == 1 && narrow<size_t>(b->Shape().Size()) == packed_b_size,
+                    "MatMulFpQ4: B must be a 1-D blob of ", packed_b_size, " bytes for B_shape ", b_shape,
+                    ", got ", b->Shape());
+
+  const float* bias_data = nullptr;
+  if (bias != nullptr) {
+    ORT_RETURN_IF_NOT(bias->Shape().NumDimensions() == 1 && narrow<size_t>(bias->Shape().Size()) == N,
+                      "MatMulFpQ4: bias must be a 1-D tensor of size N");
+    bias_data = bias->Data<float>();
+  }
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const float* a_data = a->Data<float>();
+  const uint8_t* b_data = b->Data<uint8_t>();
+  float* y_data = y->MutableData<float>();
+
+  // B is a 2-D matrix, so every batch entry shares the same packed weights.
+  const size_t max_len = helper.OutputOffsets().size();
+  std::vector<MLAS_Q4_GEMM_DATA_PARAMS> gemm_params(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    gemm_params[i].A = a_data + helper.LeftOffsets()[i];
+    gemm_params[i].lda = K;
+    gemm_params[i].B = b_data;
+    gemm_params[i].Bias = bias_data;
+    gemm_params[i].C = y_data + helper.OutputOffsets()[i];
+    gemm_params[i].ldc = N;
+  }
+
+  MlasQ4GemmBatch(blk_quant_type_, M, N, K, max_len, gemm_params.data(), thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulFpQ4,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int64_t>()),
+    MatMulFpQ4);
+
+}  // namespace contrib
+}  // namespace onnxruntime
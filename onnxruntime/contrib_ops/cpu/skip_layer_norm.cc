@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -105,6 +106,21 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   // of the input and skip tensors
   T* skip_input_bias_add_output_data = skip_input_bias_add_output != nullptr ? skip_input_bias_add_output->MutableData<T>() : nullptr;
 
+  if constexpr (std::is_same<T, float>::value) {
+    MLAS_LAYER_NORM_PARAMS<float> params;
+    params.Input = input_data;
+    params.Skip = skip_data;
+    params.Bias = bias_data;
+    params.Gamma = gamma_data;
+    params.Beta = beta_data;
+    params.Output = output_data;
+    params.SkipOutput = skip_input_bias_add_output_data;
+    params.Epsilon = epsilon_;
+    MlasLayerNorm(params, static_cast<size_t>(task_count), static_cast<size_t>(hidden_size),
+                  p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
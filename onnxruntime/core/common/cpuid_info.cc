@@ -119,6 +119,14 @@ void CPUIDInfo::X86Init() {
       }
     }
   }
+
+  // The extended leaf 0x80000006 reports the per-core L2 size in KB on both
+  // Intel and AMD processors.
+  GetCPUID(0x80000000, data);
+  if (static_cast<uint32_t>(data[0]) >= 0x80000006) {
+    GetCPUID(0x80000006, data);
+    l2_cache_size_ = (static_cast<uint32_t>(data[2]) >> 16) * 1024;
+  }
 }
 
 #endif /* CPUIDINFO_ARCH_X86 */
@@ -163,6 +171,11 @@ void CPUIDInfo::ArmLinuxInit() {
         is_armv8_narrow_ld_[coreid] = true;
       }
     }
+
+    const struct cpuinfo_cache* l2 = cpuinfo_get_l2_cache(0);
+    if (l2 != nullptr && l2->processor_count != 0) {
+      l2_cache_size_ = l2->size / l2->processor_count;
+    }
   } else {
     has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
     has_fp16_ |= has_arm_neon_dot_;
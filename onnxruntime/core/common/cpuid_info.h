@@ -89,6 +89,14 @@ class CPUIDInfo {
     return has_fp16_;
   }
 
+  /**
+   * @return size in bytes of the L2 cache available to a single core, or 0
+   *         when it could not be determined
+   */
+  uint32_t GetL2CacheSize() const {
+    return l2_cache_size_;
+  }
+
  private:
   CPUIDInfo() {
 #ifdef CPUIDINFO_ARCH_X86
@@ -122,6 +130,8 @@ class CPUIDInfo {
   bool has_arm_neon_dot_{false};
   bool has_fp16_{false};
 
+  uint32_t l2_cache_size_{0};
+
 #ifdef CPUIDINFO_ARCH_X86
 
   void X86Init();
@@ -21,6 +21,10 @@ class BarrierStep : public SequentialExecutionPlan::ExecutionStep {
 
   std::string ToString() const override;
 
+  Kind GetKind() const override { return Kind::kBarrier; }
+
+  size_t GetId() const override { return barrier_id_; }
+
  private:
   size_t barrier_id_{0};
 };
@@ -53,6 +57,8 @@ class LaunchKernelStep : public SequentialExecutionPlan::ExecutionStep {
                  bool& continue_flag) override;
 
   std::string ToString() const override;
+
+  Kind GetKind() const override { return Kind::kLaunchKernel; }
 };
 
 class ActivateNotificationStep : public SequentialExecutionPlan::ExecutionStep {
@@ -67,6 +73,10 @@ class ActivateNotificationStep : public SequentialExecutionPlan::ExecutionStep {
 
   virtual std::string ToString() const override;
 
+  Kind GetKind() const override { return Kind::kActivateNotification; }
+
+  size_t GetId() const override { return notification_idx_; }
+
  private:
   NotificationIndex notification_idx_;
 };
@@ -82,6 +92,10 @@ class TriggerDownstreamStep : public SequentialExecutionPlan::ExecutionStep {
 
   virtual std::string ToString() const override;
 
+  Kind GetKind() const override { return Kind::kTriggerDownstream; }
+
+  size_t GetId() const override { return trigger_point_index_; }
+
  private:
   size_t trigger_point_index_;
 };
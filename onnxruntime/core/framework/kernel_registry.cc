@@ -295,6 +295,29 @@ Status KernelRegistry::TryFindKernel(ProviderType exec_provider,
   return Status(common::ONNXRUNTIME, common::FAIL, "Kernel not found");
 }
 
+std::optional<size_t> KernelRegistry::GetKernelOrdinal(const KernelCreateInfo& kernel_create_info) const {
+  const auto range = kernel_creator_fn_map_.equal_range(GetMapKey(*kernel_create_info.kernel_def));
+  size_t ordinal = 0;
+  for (auto i = range.first; i != range.second; ++i, ++ordinal) {
+    if (&i->second == &kernel_create_info) {
+      return ordinal;
+    }
+  }
+
+  return std::nullopt;
+}
+
+const KernelCreateInfo* KernelRegistry::GetKernelByOrdinal(std::string_view op_type, std::string_view domain,
+                                                           std::string_view exec_provider, size_t ordinal) const {
+  const auto range = kernel_creator_fn_map_.equal_range(GetMapKey(op_type, domain, exec_provider));
+  auto i = range.first;
+  for (size_t n = 0; n < ordinal && i != range.second; ++n) {
+    ++i;
+  }
+
+  return i != range.second ? &i->second : nullptr;
+}
+
 Status KernelRegistry::Register(KernelDefBuilder& kernel_builder,
                                 const KernelCreateFn& kernel_creator) {
   return Register(KernelCreateInfo(kernel_builder.Build(), kernel_creator));
@@ -65,6 +65,9 @@ class KernelRegistryManager {
     return result;
   }
 
+  // Whether kernels registered by the user, e.g. for custom ops, take precedence over the kernels of the providers.
+  bool HasCustomKernelRegistries() const { return !custom_kernel_registries_.empty(); }
+
   // This function assumes the node is already assigned to an execution provider
   // Don't call this function before graph partition is done
   Status SearchKernelRegistry(const Node& node,
@@ -88,6 +91,13 @@ class KernelRegistryManager {
     kernel_type_str_resolver_variant_ = std::move(kernel_type_str_resolver);
   }
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Restores the default resolver of a full build, which uses the op schemas of the nodes.
+  void ResetKernelTypeStrResolver() {
+    kernel_type_str_resolver_variant_.emplace<OpSchemaKernelTypeStrResolver>();
+  }
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
  private:
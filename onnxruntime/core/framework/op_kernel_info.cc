@@ -14,7 +14,8 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
                            const IExecutionProvider& execution_provider,
                            const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                            const OrtValueNameIdxMap& ort_value_name_idx_map,
-                           const DataTransferManager& data_transfer_mgr)
+                           const DataTransferManager& data_transfer_mgr,
+                           const ConfigOptions& config_options)
     : OpNodeProtoHelper(&proto_helper_context_),
       node_(node),
       kernel_def_(kernel_def),
@@ -22,11 +23,12 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
       constant_initialized_tensors_(constant_initialized_tensors),
       ort_value_name_idx_map_(ort_value_name_idx_map),
       data_transfer_mgr_(data_transfer_mgr),
+      config_options_(config_options),
       proto_helper_context_(node) {}
 
 OpKernelInfo::OpKernelInfo(const OpKernelInfo& other)
     : OpKernelInfo(other.node_, other.kernel_def_, *other.execution_provider_, other.constant_initialized_tensors_,
-                   other.ort_value_name_idx_map_, other.data_transfer_mgr_) {}
+                   other.ort_value_name_idx_map_, other.data_transfer_mgr_, other.config_options_) {}
 
 AllocatorPtr OpKernelInfo::GetAllocator(OrtMemType mem_type) const {
   return execution_provider_->GetAllocator(mem_type);
@@ -48,6 +50,10 @@ const DataTransferManager& OpKernelInfo::GetDataTransferManager() const noexcept
   return data_transfer_mgr_;
 }
 
+const ConfigOptions& OpKernelInfo::GetConfigOptions() const noexcept {
+  return config_options_;
+}
+
 const onnxruntime::Node& OpKernelInfo::node() const noexcept {
   return node_;
 }
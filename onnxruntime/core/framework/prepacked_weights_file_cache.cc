@@ -0,0 +1,368 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_file_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "core/common/path_string.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout, in native byte order:
+//   FileHeader
+//   the pre-packed buffers, each aligned to kBufferAlignment bytes from the start of the file
+//   the index, which holds for each weight:
+//     uint32 key length, key, uint32 kernel path length, kernel path, uint32 checksum length, checksum,
+//     uint32 number of buffers, then the uint64 offset and uint64 size of each buffer
+// The offset of a buffer that PrePack() left empty is 0. The checksum covers the content of the buffers of the weight.
+constexpr char kFileMagic[8] = {'O', 'R', 'T', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kFileVersion = 2;
+constexpr size_t kBufferAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t fingerprint;
+  uint64_t index_offset;
+  uint64_t index_size;
+};
+
+class IndexReader {
+ public:
+  IndexReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool Read(void* value, size_t size) {
+    if (size > size_ - offset_) {
+      return false;
+    }
+    memcpy(value, data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+  bool ReadString(std::string& value) {
+    uint32_t length = 0;
+    if (!Read(&length, sizeof(length)) || length > size_ - offset_) {
+      return false;
+    }
+    value.assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+  bool AtEnd() const { return offset_ == size_; }
+
+ private:
+  const char* const data_;
+  const size_t size_;
+  size_t offset_ = 0;
+};
+
+void WriteString(std::string& index, const std::string& value) {
+  const auto length = static_cast<uint32_t>(value.size());
+  index.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  index.append(value);
+}
+
+void WriteValue(std::string& index, uint64_t value) {
+  index.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Adds the data to the hash in chunks as MurmurHash3 takes the length as an int.
+void UpdateHash(const void* data, size_t size, uint32_t (&hash)[4]) {
+  constexpr size_t kChunkSize = size_t{1} << 30;
+
+  const auto* bytes = static_cast<const char*>(data);
+  do {
+    const size_t chunk_size = std::min(size, kChunkSize);
+    MurmurHash3::x86_128(bytes, static_cast<int>(chunk_size), hash[0], hash);
+    bytes += chunk_size;
+    size -= chunk_size;
+  } while (size > 0);
+}
+
+std::string HashToString(const uint32_t (&hash)[4]) {
+  std::ostringstream ss;
+  ss << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    ss << std::setw(8) << h;
+  }
+  return ss.str();
+}
+
+std::string HashTensorData(const Tensor& tensor) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  UpdateHash(tensor.DataRaw(), tensor.SizeInBytes(), hash);
+  return HashToString(hash);
+}
+
+// Hashes the attributes of the node in name order. Attributes such as transB of Gemm select the layout a kernel
+// packs a weight in, so a weight packed for other attribute values must not be restored.
+std::string HashNodeAttributes(const Node& node) {
+  const auto& attributes = node.GetAttributes();
+  std::vector<const std::string*> names;
+  names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    names.push_back(&attribute.first);
+  }
+  std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  for (const std::string* name : names) {
+    const std::string value = attributes.at(*name).SerializeAsString();
+    UpdateHash(name->data(), name->size(), hash);
+    UpdateHash(value.data(), value.size(), hash);
+  }
+  return HashToString(hash);
+}
+
+// Computes the checksum of the content of the buffers of a weight, skipping the buffers PrePack() left empty.
+std::string ChecksumBuffers(const std::vector<std::pair<const void*, size_t>>& buffers) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+  for (const auto& [buffer, size] : buffers) {
+    if (buffer != nullptr) {
+      UpdateHash(buffer, size, hash);
+    }
+  }
+  return HashToString(hash);
+}
+
+}  // namespace
+
+PrepackedWeightsFileCache::PrepackedWeightsFileCache(PathString file_path, uint64_t fingerprint,
+                                                     const logging::Logger& logger)
+    : file_path_(std::move(file_path)), fingerprint_(fingerprint), logger_(logger) {
+  const Status status = Load();
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << "Ignoring the pre-packed weights cache file " << PathToUTF8String(file_path_) << ": "
+                           << status.ErrorMessage();
+    mapped_entries_.clear();
+    mapped_file_.reset();
+    mapped_file_length_ = 0;
+  }
+}
+
+Status PrepackedWeightsFileCache::Load() {
+  const Env& env = Env::Default();
+
+  size_t file_length = 0;
+  if (!env.GetFileLength(file_path_.c_str(), file_length).IsOK()) {
+    LOGS(logger_, INFO) << "The pre-packed weights cache file " << PathToUTF8String(file_path_)
+                        << " does not exist yet. It will be created.";
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF(file_length < sizeof(FileHeader), "The file is too small.");
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(file_path_.c_str(), 0, file_length, mapped_file_));
+  mapped_file_length_ = file_length;
+
+  FileHeader header;
+  memcpy(&header, mapped_file_.get(), sizeof(header));
+  ORT_RETURN_IF(memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0, "The file is not a cache file.");
+  ORT_RETURN_IF(header.version != kFileVersion, "Unsupported version ", header.version);
+  if (header.fingerprint != fingerprint_) {
+    LOGS(logger_, INFO) << "The pre-packed weights cache file " << PathToUTF8String(file_path_)
+                        << " was written by a different build, platform or session configuration. It will be "
+                           "replaced.";
+    mapped_file_.reset();
+    mapped_file_length_ = 0;
+    return Status::OK();
+  }
+  ORT_RETURN_IF(header.index_offset > file_length || header.index_size > file_length - header.index_offset,
+                "The index is out of bounds.");
+
+  IndexReader reader(mapped_file_.get() + header.index_offset, static_cast<size_t>(header.index_size));
+  while (!reader.AtEnd()) {
+    std::string key;
+    MappedEntry entry;
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_NOT(reader.ReadString(key) && reader.ReadString(entry.kernel_path) &&
+                          reader.ReadString(entry.checksum) && reader.Read(&num_buffers, sizeof(num_buffers)),
+                      "The index is truncated.");
+    for (uint32_t i = 0; i < num_buffers; ++i) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_NOT(reader.Read(&offset, sizeof(offset)) && reader.Read(&size, sizeof(size)),
+                        "The index is truncated.");
+      ORT_RETURN_IF(offset > header.index_offset || size > header.index_offset - offset,
+                    "A buffer of ", key, " is out of bounds.");
+      entry.buffers.emplace_back(static_cast<size_t>(offset), static_cast<size_t>(size));
+    }
+    mapped_entries_[key] = std::move(entry);
+  }
+
+  LOGS(logger_, INFO) << "Mapped " << mapped_entries_.size() << " pre-packed weights from "
+                      << PathToUTF8String(file_path_);
+  return Status::OK();
+}
+
+std::string PrepackedWeightsFileCache::GetKey(const Node& node, int input_idx, const Tensor& tensor) {
+  if (tensor.IsDataTypeString()) {
+    return {};
+  }
+
+  std::ostringstream ss;
+  ss << node.Domain() << ':' << node.OpType() << ':' << node.SinceVersion() << ':' << node.Index() << ':'
+     << node.Name() << ':' << HashNodeAttributes(node) << ':' << input_idx << ':' << tensor.GetElementType() << ':'
+     << tensor.Shape().ToString() << ':' << HashTensorData(tensor);
+  return ss.str();
+}
+
+bool PrepackedWeightsFileCache::Find(const std::string& key, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                     std::vector<size_t>& prepacked_buffer_sizes, std::string& kernel_path) {
+  auto it = mapped_entries_.find(key);
+  if (it == mapped_entries_.end()) {
+    return false;
+  }
+
+  std::vector<std::pair<const void*, size_t>> buffers;
+  for (const auto& [offset, size] : it->second.buffers) {
+    buffers.emplace_back(offset == 0 ? nullptr : mapped_file_.get() + offset, size);
+  }
+
+  // the weight is packed again, and the entry dropped from the file, if the buffers were modified on disk
+  if (ChecksumBuffers(buffers) != it->second.checksum) {
+    LOGS(logger_, WARNING) << "The pre-packed weight " << key << " in " << PathToUTF8String(file_path_)
+                           << " does not match its checksum. It will be packed again.";
+    mapped_entries_.erase(it);
+    return false;
+  }
+
+  prepacked_buffers.clear();
+  prepacked_buffer_sizes.clear();
+  for (const auto& [buffer, size] : buffers) {
+    prepacked_buffers.emplace_back(const_cast<void*>(buffer), BufferDeleter(nullptr));
+    prepacked_buffer_sizes.push_back(size);
+  }
+  kernel_path = it->second.kernel_path;
+
+  used_mapped_keys_.insert(key);
+  return true;
+}
+
+const PrePackedWeights& PrepackedWeightsFileCache::Add(const std::string& key, PrePackedWeights&& weights,
+                                                       std::string kernel_path) {
+  // a weight that was in the file but could not be restored is replaced by the one packed in this session
+  used_mapped_keys_.erase(key);
+
+  auto& entry = added_entries_[key];
+  entry.kernel_path = std::move(kernel_path);
+  entry.weights = std::move(weights);
+  return entry.weights;
+}
+
+Status PrepackedWeightsFileCache::Save() {
+  if (added_entries_.empty()) {
+    return Status::OK();
+  }
+
+  struct EntryToWrite {
+    const std::string* key;
+    const std::string* kernel_path;
+    std::vector<std::pair<const void*, size_t>> buffers;
+    std::string checksum;
+  };
+
+  // only the weights used by this session are kept so that the file does not accumulate the weights of old models
+  std::vector<EntryToWrite> entries;
+  for (const auto& key : used_mapped_keys_) {
+    const auto& mapped_entry = mapped_entries_.at(key);
+    EntryToWrite& entry =
+        entries.emplace_back(EntryToWrite{&key, &mapped_entry.kernel_path, {}, mapped_entry.checksum});
+    for (const auto& [offset, size] : mapped_entry.buffers) {
+      entry.buffers.emplace_back(offset == 0 ? nullptr : mapped_file_.get() + offset, size);
+    }
+  }
+  for (const auto& [key, added_entry] : added_entries_) {
+    EntryToWrite& entry = entries.emplace_back(EntryToWrite{&key, &added_entry.kernel_path, {}, {}});
+    const auto& weights = added_entry.weights;
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      entry.buffers.emplace_back(weights.buffers_[i].get(), weights.buffers_[i] ? weights.buffer_sizes_[i] : 0);
+    }
+    entry.checksum = ChecksumBuffers(entry.buffers);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const EntryToWrite& a, const EntryToWrite& b) { return *a.key < *b.key; });
+
+  // write to a file private to this process and rename it over the cache file, which replaces the file atomically
+  // for the other processes that load or save the cache concurrently
+  const PathString temp_file_path = file_path_ + ToPathString(".tmp." + std::to_string(Env::Default().GetSelfPid()));
+  std::string index;
+  {
+    std::ofstream file(std::filesystem::path(temp_file_path), std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(file, "Failed to open ", PathToUTF8String(temp_file_path), " for writing.");
+
+    FileHeader header{};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    static const char padding[kBufferAlignment] = {};
+    uint64_t offset = sizeof(header);
+    for (const auto& entry : entries) {
+      WriteString(index, *entry.key);
+      WriteString(index, *entry.kernel_path);
+      WriteString(index, entry.checksum);
+      const auto num_buffers = static_cast<uint32_t>(entry.buffers.size());
+      index.append(reinterpret_cast<const char*>(&num_buffers), sizeof(num_buffers));
+
+      for (const auto& [buffer, size] : entry.buffers) {
+        if (buffer == nullptr) {
+          WriteValue(index, 0);
+          WriteValue(index, 0);
+          continue;
+        }
+        const size_t padding_size = static_cast<size_t>((kBufferAlignment - offset % kBufferAlignment) %
+                                                        kBufferAlignment);
+        file.write(padding, padding_size);
+        offset += padding_size;
+
+        WriteValue(index, offset);
+        WriteValue(index, size);
+        file.write(static_cast<const char*>(buffer), static_cast<std::streamsize>(size));
+        offset += size;
+      }
+    }
+
+    memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+    header.version = kFileVersion;
+    header.fingerprint = fingerprint_;
+    header.index_offset = offset;
+    header.index_size = index.size();
+    file.write(index.data(), static_cast<std::streamsize>(index.size()));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    if (!file) {
+      std::error_code ec;
+      std::filesystem::remove(std::filesystem::path(temp_file_path), ec);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write ", PathToUTF8String(temp_file_path));
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(std::filesystem::path(temp_file_path), std::filesystem::path(file_path_), ec);
+  if (ec) {
+    std::error_code remove_ec;
+    std::filesystem::remove(std::filesystem::path(temp_file_path), remove_ec);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", PathToUTF8String(file_path_), ": ", ec.message());
+  }
+
+  LOGS(logger_, INFO) << "Saved " << entries.size() << " pre-packed weights to " << PathToUTF8String(file_path_) << " ("
+                      << added_entries_.size() << " packed by this session)";
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+/**
+ * A file of pre-packed weights that persists the results of OpKernel::PrePack() across sessions and processes.
+ *
+ * The file is memory mapped read-only, so the sessions of all the processes that load the same model share a single
+ * copy of the pre-packed weights in the page cache, and kernels that implement OpKernel::RestorePrePackedBuffers()
+ * skip PrePack(). The weights that are not in the file are packed as usual and retained by the cache for the lifetime
+ * of the session. Save() then writes a new version of the file and atomically replaces the old one, so concurrent
+ * sessions that read or write the same file never observe a partially written file.
+ *
+ * A file is only used when it was written with the same fingerprint, which callers derive from everything that
+ * affects the pre-packed format: the ONNX Runtime version, the MLAS platform and the session options. Each weight is
+ * keyed by its node, including the node's attributes, and the content of the constant tensor, so a changed model does
+ * not restore stale weights. Stale or missing files are not an error; the cache starts empty and the file is
+ * rewritten. A file with a malformed header or index is ignored in the same way, and each weight is verified against
+ * a checksum of its content when it is looked up, so a weight that was modified on disk is packed again. Kernels
+ * still validate the restored buffers they index through, as the checksum does not protect against a deliberately
+ * crafted file.
+ */
+class PrepackedWeightsFileCache {
+ public:
+  /**
+   * Creates a cache backed by the given file and maps the file into memory if it exists and is valid.
+   * @param file_path The path of the cache file.
+   * @param fingerprint The fingerprint the file has to be written with to be used.
+   * @param logger The logger for the diagnostics of loading and saving the file.
+   */
+  PrepackedWeightsFileCache(PathString file_path, uint64_t fingerprint, const logging::Logger& logger);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsFileCache);
+
+  // Returns the key of the pre-packed weight of the input of the node, or an empty string if the tensor can not be
+  // cached.
+  static std::string GetKey(const Node& node, int input_idx, const Tensor& tensor);
+
+  /**
+   * Looks up a pre-packed weight in the mapped file and verifies the checksum of its content.
+   * @param prepacked_buffers Set to the pre-packed buffers, which point into the mapping and are not owned.
+   * @param prepacked_buffer_sizes Set to the sizes in bytes of the pre-packed buffers.
+   * @param kernel_path Set to the kernel path the kernel reported after packing the weight.
+   * @return true if the file contains the weight.
+   */
+  bool Find(const std::string& key, std::vector<BufferUniquePtr>& prepacked_buffers,
+            std::vector<size_t>& prepacked_buffer_sizes, std::string& kernel_path);
+
+  /**
+   * Takes ownership of a weight that was packed in this session so that Save() writes it to the file.
+   * @return The retained weight, which the kernel has to use in place of the buffers it was packed into.
+   */
+  const PrePackedWeights& Add(const std::string& key, PrePackedWeights&& weights, std::string kernel_path);
+
+  // Writes the weights found in or added to the cache to the file if any weight was added.
+  Status Save();
+
+  size_t GetNumberOfMappedWeights() const { return mapped_entries_.size(); }
+  size_t GetNumberOfAddedWeights() const { return added_entries_.size(); }
+
+ private:
+  struct MappedEntry {
+    std::string kernel_path;
+    std::string checksum;  // of the content of the buffers, verified by Find()
+    std::vector<std::pair<size_t, size_t>> buffers;  // offset and size in bytes of each buffer in the file
+  };
+
+  struct AddedEntry {
+    std::string kernel_path;
+    PrePackedWeights weights;
+  };
+
+  Status Load();
+
+  const PathString file_path_;
+  const uint64_t fingerprint_;
+  const logging::Logger& logger_;
+
+  Env::MappedMemoryPtr mapped_file_;
+  size_t mapped_file_length_ = 0;
+
+  std::unordered_map<std::string, MappedEntry> mapped_entries_;
+  std::unordered_set<std::string> used_mapped_keys_;
+  std::unordered_map<std::string, AddedEntry> added_entries_;
+};
+
+}  // namespace onnxruntime
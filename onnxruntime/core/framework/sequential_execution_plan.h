@@ -109,6 +109,16 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // 3. Wait on a notificaiton
   class ExecutionStep {
    public:
+    // The kind of a step, which together with its node index and id is enough to recreate it when the plan is
+    // restored from a session snapshot. Steps of kind kOther hold state that is not recorded.
+    enum class Kind : uint8_t {
+      kOther = 0,
+      kBarrier,
+      kLaunchKernel,
+      kActivateNotification,
+      kTriggerDownstream,
+    };
+
     ExecutionStep(NodeIndex node_index) : node_index_(node_index) {}
     virtual ~ExecutionStep() {}
     virtual Status Execute(StreamExecutionContext& ctx,
@@ -117,7 +127,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
                            const bool& terminate_flag,
                            bool& continue_flag) = 0;
     virtual std::string ToString() const = 0;
-    inline NodeIndex GetNodeIndex() { return node_index_; }
+    virtual Kind GetKind() const { return Kind::kOther; }
+    // The barrier, notification or trigger point index the step was created with, 0 if it has none.
+    virtual size_t GetId() const { return 0; }
+    inline NodeIndex GetNodeIndex() const { return node_index_; }
 
    protected:
     NodeIndex node_index_;
@@ -0,0 +1,782 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/session_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#include "core/common/path_string.h"
+#include "core/framework/data_types.h"
+#include "core/framework/execution_steps.h"
+#include "core/framework/kernel_registry.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// File layout, in native byte order:
+//   FileHeader
+//   the graph in ORT format, aligned to kSectionAlignment bytes
+//   the state section, aligned to kSectionAlignment bytes, which holds
+//     the execution provider types and the number of kernels in their registries
+//     the OrtValue names in index order
+//     the node index and kernel ordinal (see KernelRegistry::GetKernelOrdinal()) of each node
+//     the size of the serialized execution plan, followed by the plan. The size is 0 if the plan was not recorded.
+constexpr char kFileMagic[8] = {'O', 'R', 'T', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t kFileVersion = 1;
+constexpr size_t kSectionAlignment = 64;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t fingerprint;
+  uint64_t model_hash;
+  uint64_t model_offset;
+  uint64_t model_size;
+  uint64_t state_offset;
+  uint64_t state_size;
+};
+
+class SnapshotWriter {
+ public:
+  template <typename T>
+  void Write(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void WriteString(const std::string& value) {
+    Write<uint64_t>(value.size());
+    data_.append(value);
+  }
+
+  void WriteBytes(gsl::span<const char> bytes) {
+    data_.append(bytes.data(), bytes.size());
+  }
+
+  const std::string& Data() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+class SnapshotReader {
+ public:
+  explicit SnapshotReader(gsl::span<const uint8_t> data) : data_(data) {}
+
+  template <typename T>
+  Status Read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    ORT_RETURN_IF(sizeof(value) > data_.size() - offset_, "The snapshot is truncated.");
+    memcpy(&value, data_.data() + offset_, sizeof(value));
+    offset_ += sizeof(value);
+    return Status::OK();
+  }
+
+  // Reads the number of elements of a sequence whose elements take at least one byte each.
+  Status ReadCount(size_t& count) {
+    uint64_t value = 0;
+    ORT_RETURN_IF_ERROR(Read(value));
+    ORT_RETURN_IF(value > data_.size() - offset_, "The snapshot is truncated.");
+    count = static_cast<size_t>(value);
+    return Status::OK();
+  }
+
+  Status ReadString(std::string& value) {
+    size_t length = 0;
+    ORT_RETURN_IF_ERROR(ReadCount(length));
+    value.assign(reinterpret_cast<const char*>(data_.data()) + offset_, length);
+    offset_ += length;
+    return Status::OK();
+  }
+
+  Status ReadBytes(size_t size, gsl::span<const uint8_t>& bytes) {
+    ORT_RETURN_IF(size > data_.size() - offset_, "The snapshot is truncated.");
+    bytes = data_.subspan(offset_, size);
+    offset_ += size;
+    return Status::OK();
+  }
+
+  bool AtEnd() const { return offset_ == data_.size(); }
+
+ private:
+  const gsl::span<const uint8_t> data_;
+  size_t offset_ = 0;
+};
+
+void WriteDevice(SnapshotWriter& writer, const OrtDevice& device) {
+  writer.Write<OrtDevice::DeviceType>(device.Type());
+  writer.Write<OrtDevice::MemoryType>(device.MemType());
+  writer.Write<OrtDevice::DeviceId>(device.Id());
+}
+
+Status ReadDevice(SnapshotReader& reader, OrtDevice& device) {
+  OrtDevice::DeviceType type{};
+  OrtDevice::MemoryType mem_type{};
+  OrtDevice::DeviceId id{};
+  ORT_RETURN_IF_ERROR(reader.Read(type));
+  ORT_RETURN_IF_ERROR(reader.Read(mem_type));
+  ORT_RETURN_IF_ERROR(reader.Read(id));
+  device = OrtDevice(type, mem_type, id);
+  return Status::OK();
+}
+
+// Serializes the plan. Returns false if the plan has steps that can not be recreated from their description, i.e.
+// waits on other devices, whose wait functions are provided by the execution providers.
+bool WriteExecutionPlan(const SequentialExecutionPlan& plan, SnapshotWriter& writer) {
+  for (const auto& stream : plan.execution_plan) {
+    for (const auto& step : stream->steps_) {
+      if (step->GetKind() == SequentialExecutionPlan::ExecutionStep::Kind::kOther) {
+        return false;
+      }
+    }
+  }
+
+  writer.Write<uint64_t>(plan.allocation_plan.size());
+  for (const auto& value_plan : plan.allocation_plan) {
+    writer.Write<uint8_t>(static_cast<uint8_t>(value_plan.alloc_kind));
+    writer.WriteString(value_plan.value_type != nullptr ? DataTypeImpl::ToString(value_plan.value_type) : "");
+    WriteDevice(writer, value_plan.location);
+    writer.Write<int32_t>(value_plan.reused_buffer);
+#ifdef ENABLE_STRIDED_TENSORS
+    writer.Write<uint8_t>(value_plan.is_strided_tensor ? 1 : 0);
+#endif
+    const auto& starts = value_plan.program_counter.Starts();
+    const auto& ends = value_plan.program_counter.Ends();
+    writer.Write<uint64_t>(starts.size());
+    for (size_t i = 0; i < starts.size(); ++i) {
+      writer.Write<uint64_t>(starts[i]);
+      writer.Write<uint64_t>(i < ends.size() ? ends[i] : starts[i]);
+    }
+  }
+
+  for (const auto* order : {&plan.initializer_allocation_order, &plan.activation_allocation_order}) {
+    writer.Write<uint64_t>(order->size());
+    for (OrtValueIndex index : *order) {
+      writer.Write<int32_t>(index);
+    }
+  }
+
+  writer.Write<uint64_t>(plan.num_barriers);
+  writer.Write<uint64_t>(plan.notification_owners.size());
+  for (size_t owner : plan.notification_owners) {
+    writer.Write<uint64_t>(owner);
+  }
+
+  writer.Write<uint64_t>(plan.execution_plan.size());
+  for (const auto& stream : plan.execution_plan) {
+    WriteDevice(writer, stream->device_);
+    writer.Write<uint64_t>(stream->steps_.size());
+    for (const auto& step : stream->steps_) {
+      writer.Write<uint8_t>(static_cast<uint8_t>(step->GetKind()));
+      writer.Write<uint64_t>(step->GetNodeIndex());
+      writer.Write<uint64_t>(step->GetId());
+    }
+  }
+
+  writer.Write<uint64_t>(plan.value_to_stream_map.size());
+  for (const auto& [value_index, stream_index] : plan.value_to_stream_map) {
+    writer.Write<int32_t>(static_cast<int32_t>(value_index));
+    writer.Write<uint64_t>(stream_index);
+  }
+
+  writer.Write<uint64_t>(plan.release_actions.size());
+  for (const auto& release_action : plan.release_actions) {
+    writer.Write<int32_t>(static_cast<int32_t>(release_action.value_index));
+    writer.Write<uint64_t>(release_action.ref_count);
+  }
+
+  writer.Write<uint64_t>(plan.node_release_list.size());
+  for (const auto& release_list : plan.node_release_list) {
+    writer.Write<uint64_t>(release_list.size());
+    for (size_t release_action_index : release_list) {
+      writer.Write<uint64_t>(release_action_index);
+    }
+  }
+
+  writer.Write<uint64_t>(plan.downstream_map.size());
+  for (const auto& [trigger_point_index, downstreams] : plan.downstream_map) {
+    writer.Write<uint64_t>(trigger_point_index);
+    writer.Write<uint64_t>(downstreams.size());
+    for (const auto& [stream_index, step_index] : downstreams) {
+      writer.Write<uint64_t>(stream_index);
+      writer.Write<uint64_t>(step_index);
+    }
+  }
+
+#ifdef ENABLE_TRAINING
+  writer.Write<uint64_t>(plan.node_execution_order_in_training.size());
+  for (NodeIndex node_index : plan.node_execution_order_in_training) {
+    writer.Write<uint64_t>(node_index);
+  }
+
+  writer.Write<uint64_t>(plan.node_index_2_toposort_index.size());
+  for (const auto& [node_index, toposort_index] : plan.node_index_2_toposort_index) {
+    writer.Write<uint64_t>(node_index);
+    writer.Write<uint64_t>(toposort_index);
+  }
+#endif
+
+  return true;
+}
+
+Status WriteFile(const PathString& file_path, gsl::span<const char> header, gsl::span<const uint8_t> model,
+                 uint64_t model_offset, gsl::span<const char> state, uint64_t state_offset) {
+  static const char padding[kSectionAlignment] = {};
+
+  std::ofstream file(std::filesystem::path(file_path), std::ios::binary | std::ios::trunc);
+  ORT_RETURN_IF_NOT(file, "Failed to open ", PathToUTF8String(file_path), " for writing.");
+
+  file.write(header.data(), header.size());
+  file.write(padding, static_cast<std::streamsize>(model_offset - header.size()));
+  file.write(reinterpret_cast<const char*>(model.data()), static_cast<std::streamsize>(model.size()));
+  file.write(padding, static_cast<std::streamsize>(state_offset - model_offset - model.size()));
+  file.write(state.data(), static_cast<std::streamsize>(state.size()));
+  file.close();
+
+  ORT_RETURN_IF_NOT(file, "Failed to write ", PathToUTF8String(file_path));
+  return Status::OK();
+}
+
+uint64_t AlignOffset(uint64_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+}
+
+}  // namespace
+
+SessionSnapshot::SessionSnapshot(Env::MappedMemoryPtr mapped_file, const logging::Logger& logger)
+    : mapped_file_(std::move(mapped_file)), logger_(logger) {
+}
+
+SessionSnapshot::~SessionSnapshot() = default;
+
+std::unique_ptr<SessionSnapshot> SessionSnapshot::Load(const PathString& file_path, uint64_t fingerprint,
+                                                       uint64_t model_hash, const logging::Logger& logger) {
+  const Env& env = Env::Default();
+
+  size_t file_length = 0;
+  if (!env.GetFileLength(file_path.c_str(), file_length).IsOK()) {
+    LOGS(logger, INFO) << "The session snapshot " << PathToUTF8String(file_path)
+                       << " does not exist yet. It will be created.";
+    return nullptr;
+  }
+
+  Env::MappedMemoryPtr mapped_file;
+  Status status = file_length < sizeof(FileHeader)
+                      ? ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The file is too small.")
+                      : env.MapFileIntoMemory(file_path.c_str(), 0, file_length, mapped_file);
+
+  std::unique_ptr<SessionSnapshot> snapshot;
+  if (status.IsOK()) {
+    snapshot.reset(new SessionSnapshot(std::move(mapped_file), logger));
+    status = snapshot->Parse(fingerprint, model_hash, file_length);
+  }
+
+  if (!status.IsOK()) {
+    LOGS(logger, WARNING) << "Ignoring the session snapshot " << PathToUTF8String(file_path) << ": "
+                          << status.ErrorMessage();
+    return nullptr;
+  }
+
+  if (snapshot->ort_format_model_.empty()) {
+    LOGS(logger, INFO) << "The session snapshot " << PathToUTF8String(file_path)
+                       << " was created from a different model or by a different build, platform or session "
+                          "configuration. It will be replaced.";
+    return nullptr;
+  }
+
+  LOGS(logger, INFO) << "Loading the model from the session snapshot " << PathToUTF8String(file_path);
+  return snapshot;
+}
+
+Status SessionSnapshot::Parse(uint64_t fingerprint, uint64_t model_hash, size_t file_length) {
+  FileHeader header;
+  memcpy(&header, mapped_file_.get(), sizeof(header));
+  ORT_RETURN_IF(memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0, "The file is not a session snapshot.");
+  ORT_RETURN_IF(header.version != kFileVersion, "Unsupported version ", header.version);
+
+  // a stale snapshot is not an error. it is left without a model and replaced.
+  if (header.fingerprint != fingerprint || header.model_hash != model_hash) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF(header.model_offset > file_length || header.model_size > file_length - header.model_offset ||
+                    header.state_offset > file_length || header.state_size > file_length - header.state_offset,
+                "A section is out of bounds.");
+
+  const auto* data = reinterpret_cast<const uint8_t*>(mapped_file_.get());
+  SnapshotReader reader(gsl::make_span(data + header.state_offset, static_cast<size_t>(header.state_size)));
+
+  size_t num_providers = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_providers));
+  for (size_t i = 0; i < num_providers; ++i) {
+    uint64_t kernel_count = 0;
+    ORT_RETURN_IF_ERROR(reader.ReadString(provider_types_.emplace_back()));
+    ORT_RETURN_IF_ERROR(reader.Read(kernel_count));
+    provider_kernel_counts_.push_back(static_cast<size_t>(kernel_count));
+  }
+
+  size_t num_values = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_values));
+  value_names_.resize(num_values);
+  for (auto& value_name : value_names_) {
+    ORT_RETURN_IF_ERROR(reader.ReadString(value_name));
+  }
+
+  size_t num_kernels = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_kernels));
+  kernel_ordinals_.reserve(num_kernels);
+  for (size_t i = 0; i < num_kernels; ++i) {
+    uint64_t node_index = 0;
+    uint64_t ordinal = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(node_index));
+    ORT_RETURN_IF_ERROR(reader.Read(ordinal));
+    kernel_ordinals_[static_cast<NodeIndex>(node_index)] = static_cast<size_t>(ordinal);
+  }
+
+  size_t plan_size = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(plan_size));
+  ORT_RETURN_IF_ERROR(reader.ReadBytes(plan_size, execution_plan_));
+  ORT_RETURN_IF_NOT(reader.AtEnd(), "The state section has trailing data.");
+
+  ort_format_model_ = gsl::make_span(data + header.model_offset, static_cast<size_t>(header.model_size));
+  ORT_RETURN_IF(ort_format_model_.empty(), "The snapshot has no model.");
+  return Status::OK();
+}
+
+Status SessionSnapshot::Save(const PathString& file_path, uint64_t fingerprint, uint64_t model_hash,
+                             gsl::span<const uint8_t> ort_format_model, gsl::span<const std::string> provider_types,
+                             const KernelRegistryManager& kernel_registry_manager,
+                             const SessionState& session_state) {
+  const GraphViewer& graph_viewer = session_state.GetGraphViewer();
+  const OrtValueNameIdxMap& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const bool record_kernels = !kernel_registry_manager.HasCustomKernelRegistries();
+
+  SnapshotWriter state;
+  state.Write<uint64_t>(provider_types.size());
+  for (const auto& provider_type : provider_types) {
+    const auto registries = kernel_registry_manager.GetKernelRegistriesByProviderType(provider_type);
+    state.WriteString(provider_type);
+    state.Write<uint64_t>(registries.empty() ? 0 : registries.back()->GetKernelCreateMap().size());
+  }
+
+  std::vector<std::string> value_names(static_cast<size_t>(ort_value_name_idx_map.MaxIdx() + 1));
+  for (const auto& [name, index] : ort_value_name_idx_map) {
+    value_names[index] = name;
+  }
+  state.Write<uint64_t>(value_names.size());
+  for (const auto& value_name : value_names) {
+    state.WriteString(value_name);
+  }
+
+  std::vector<std::pair<NodeIndex, size_t>> kernel_ordinals;
+  if (record_kernels) {
+    for (const auto& [node_index, kernel_create_info] : session_state.GetKernelCreateInfoMap()) {
+      const Node* node = graph_viewer.GetNode(node_index);
+      const auto registries = kernel_registry_manager.GetKernelRegistriesByProviderType(
+          node->GetExecutionProviderType());
+      if (registries.size() == 1) {
+        if (const auto ordinal = registries[0]->GetKernelOrdinal(*kernel_create_info); ordinal.has_value()) {
+          kernel_ordinals.emplace_back(node_index, *ordinal);
+        }
+      }
+    }
+  }
+  state.Write<uint64_t>(kernel_ordinals.size());
+  for (const auto& [node_index, ordinal] : kernel_ordinals) {
+    state.Write<uint64_t>(node_index);
+    state.Write<uint64_t>(ordinal);
+  }
+
+  SnapshotWriter plan;
+  if (!WriteExecutionPlan(*session_state.GetExecutionPlan(), plan)) {
+    LOGS(session_state.Logger(), INFO) << "The execution plan waits on other devices and is not recorded in the "
+                                          "session snapshot. It will be recreated by the sessions that use it.";
+    plan = SnapshotWriter{};
+  }
+  state.Write<uint64_t>(plan.Data().size());
+  state.WriteBytes(plan.Data());
+
+  FileHeader header{};
+  memcpy(header.magic, kFileMagic, sizeof(kFileMagic));
+  header.version = kFileVersion;
+  header.fingerprint = fingerprint;
+  header.model_hash = model_hash;
+  header.model_offset = AlignOffset(sizeof(header));
+  header.model_size = ort_format_model.size();
+  header.state_offset = AlignOffset(header.model_offset + header.model_size);
+  header.state_size = state.Data().size();
+
+  // write to a file private to this process and rename it over the snapshot, which replaces the file atomically for
+  // the other processes that load or create the snapshot concurrently
+  const PathString temp_file_path = file_path + ToPathString(".tmp." + std::to_string(Env::Default().GetSelfPid()));
+  Status status = WriteFile(temp_file_path,
+                            gsl::make_span(reinterpret_cast<const char*>(&header), sizeof(header)),
+                            ort_format_model, header.model_offset, state.Data(), header.state_offset);
+  if (status.IsOK()) {
+    std::error_code ec;
+    std::filesystem::rename(std::filesystem::path(temp_file_path), std::filesystem::path(file_path), ec);
+    if (ec) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace ", PathToUTF8String(file_path), ": ",
+                               ec.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    std::error_code ec;
+    std::filesystem::remove(std::filesystem::path(temp_file_path), ec);
+    return status;
+  }
+
+  LOGS(session_state.Logger(), INFO) << "Saved the session snapshot " << PathToUTF8String(file_path) << " with "
+                                     << kernel_ordinals.size() << " kernels"
+                                     << (plan.Data().empty() ? "" : " and the execution plan");
+  return Status::OK();
+}
+
+Status SessionSnapshot::HashModelFile(const PathString& model_path, uint64_t& model_hash) {
+  constexpr size_t kChunkSize = size_t{1} << 30;
+
+  const Env& env = Env::Default();
+  size_t file_length = 0;
+  ORT_RETURN_IF_ERROR(env.GetFileLength(model_path.c_str(), file_length));
+
+  Env::MappedMemoryPtr mapped_file;
+  if (file_length > 0) {
+    ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(model_path.c_str(), 0, file_length, mapped_file));
+  }
+
+  // MurmurHash3 takes the length as an int, so large models are hashed in chunks
+  const char* data = mapped_file.get();
+  size_t remaining = file_length;
+  uint64_t hash[2] = {file_length, 0};
+  do {
+    const size_t chunk_size = std::min(remaining, kChunkSize);
+    MurmurHash3::x86_128(data, static_cast<int>(chunk_size), static_cast<uint32_t>(hash[0]), hash);
+    data += chunk_size;
+    remaining -= chunk_size;
+  } while (remaining > 0);
+
+  model_hash = hash[0];
+  return Status::OK();
+}
+
+bool SessionSnapshot::MatchesExecutionProviders(gsl::span<const std::string> provider_types) const {
+  return std::equal(provider_types.begin(), provider_types.end(), provider_types_.begin(), provider_types_.end());
+}
+
+const KernelCreateInfo* SessionSnapshot::GetKernelCreateInfo(
+    const Node& node, const KernelRegistryManager& kernel_registry_manager) const {
+  // kernels registered by the user take precedence over the kernels of the providers and are not recorded
+  if (kernel_registry_manager.HasCustomKernelRegistries()) {
+    return nullptr;
+  }
+
+  const auto ordinal = kernel_ordinals_.find(node.Index());
+  if (ordinal == kernel_ordinals_.end()) {
+    return nullptr;
+  }
+
+  const std::string& provider_type = node.GetExecutionProviderType();
+  const auto registries = kernel_registry_manager.GetKernelRegistriesByProviderType(provider_type);
+  const auto provider = std::find(provider_types_.begin(), provider_types_.end(), provider_type);
+  if (registries.size() != 1 || provider == provider_types_.end() ||
+      registries[0]->GetKernelCreateMap().size() !=
+          provider_kernel_counts_[std::distance(provider_types_.begin(), provider)]) {
+    return nullptr;
+  }
+
+  const KernelCreateInfo* kernel_create_info =
+      registries[0]->GetKernelByOrdinal(node.OpType(), node.Domain(), provider_type, ordinal->second);
+  if (kernel_create_info == nullptr) {
+    return nullptr;
+  }
+
+  int start_version = 0;
+  int end_version = 0;
+  kernel_create_info->kernel_def->SinceVersion(&start_version, &end_version);
+  return node.SinceVersion() >= start_version && node.SinceVersion() <= end_version ? kernel_create_info : nullptr;
+}
+
+Status SessionSnapshot::RestoreExecutionPlan(const GraphViewer& graph_viewer,
+                                             const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                             std::optional<SequentialExecutionPlan>& plan, bool& restored) const {
+  restored = false;
+
+#if defined(ORT_MEMORY_PROFILE)
+  // the life intervals of the values that the memory profiler uses are not recorded
+  ORT_UNUSED_PARAMETER(graph_viewer);
+  ORT_UNUSED_PARAMETER(ort_value_name_idx_map);
+  ORT_UNUSED_PARAMETER(plan);
+#else
+  if (execution_plan_.empty()) {
+    return Status::OK();
+  }
+
+  const Status status = ParseExecutionPlan(graph_viewer, ort_value_name_idx_map, plan);
+  if (!status.IsOK()) {
+    plan.reset();
+    LOGS(logger_, WARNING) << "The execution plan of the session snapshot does not match the graph and will be "
+                              "recreated: "
+                           << status.ErrorMessage();
+    return Status::OK();
+  }
+
+  restored = true;
+#endif
+
+  return Status::OK();
+}
+
+Status SessionSnapshot::ParseExecutionPlan(const GraphViewer& graph_viewer,
+                                           const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                           std::optional<SequentialExecutionPlan>& plan) const {
+  using ExecutionStep = SequentialExecutionPlan::ExecutionStep;
+
+  // the values are numbered differently in the graph loaded from the snapshot, so they are mapped by name
+  const size_t num_values = value_names_.size();
+  ORT_RETURN_IF(ort_value_name_idx_map.Size() != num_values ||
+                    static_cast<size_t>(ort_value_name_idx_map.MaxIdx() + 1) != num_values,
+                "The number of values differs.");
+  std::vector<OrtValueIndex> value_indices(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(value_names_[i], value_indices[i]));
+  }
+
+  SnapshotReader reader(execution_plan_);
+  const auto read_value_index = [&reader, &value_indices](OrtValueIndex& value_index) -> Status {
+    int32_t index = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(index));
+    ORT_RETURN_IF(index < 0 || static_cast<size_t>(index) >= value_indices.size(), "Invalid value index ", index);
+    value_index = value_indices[index];
+    return Status::OK();
+  };
+  const auto read_node_index = [&reader, &graph_viewer](NodeIndex& node_index) -> Status {
+    uint64_t index = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(index));
+    ORT_RETURN_IF(index >= graph_viewer.MaxNodeIndex() || graph_viewer.GetNode(static_cast<NodeIndex>(index)) == nullptr,
+                  "Invalid node index ", index);
+    node_index = static_cast<NodeIndex>(index);
+    return Status::OK();
+  };
+  const auto read_index = [&reader](size_t bound, size_t& index) -> Status {
+    uint64_t value = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(value));
+    ORT_RETURN_IF(value >= bound, "Index ", value, " is out of bounds.");
+    index = static_cast<size_t>(value);
+    return Status::OK();
+  };
+
+  plan.emplace();
+
+  size_t num_value_plans = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_value_plans));
+  ORT_RETURN_IF(num_value_plans != num_values, "The number of values of the plan differs.");
+  plan->allocation_plan.resize(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    AllocPlanPerValue& value_plan = plan->allocation_plan[value_indices[i]];
+
+    uint8_t alloc_kind = 0;
+    std::string value_type;
+    ORT_RETURN_IF_ERROR(reader.Read(alloc_kind));
+    ORT_RETURN_IF_ERROR(reader.ReadString(value_type));
+    ORT_RETURN_IF_ERROR(ReadDevice(reader, value_plan.location));
+    ORT_RETURN_IF_ERROR(read_value_index(value_plan.reused_buffer));
+    // the alloc kind is written as a byte, so kNotSet (-1) reads back as 0xff
+    const int alloc_kind_value = alloc_kind == 0xff ? static_cast<int>(AllocKind::kNotSet) : alloc_kind;
+    ORT_RETURN_IF(alloc_kind_value > static_cast<int>(AllocKind::kAllocatedExternally),
+                  "Invalid alloc kind ", alloc_kind_value);
+    value_plan.alloc_kind = static_cast<AllocKind>(alloc_kind_value);
+    if (!value_type.empty()) {
+      value_plan.value_type = DataTypeImpl::GetDataType(value_type);
+      ORT_RETURN_IF(value_plan.value_type == nullptr, "Unknown type ", value_type);
+    }
+#ifdef ENABLE_STRIDED_TENSORS
+    uint8_t is_strided_tensor = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(is_strided_tensor));
+    value_plan.is_strided_tensor = is_strided_tensor != 0;
+#endif
+
+    size_t num_intervals = 0;
+    ORT_RETURN_IF_ERROR(reader.ReadCount(num_intervals));
+    for (size_t j = 0; j < num_intervals; ++j) {
+      uint64_t start = 0;
+      uint64_t end = 0;
+      ORT_RETURN_IF_ERROR(reader.Read(start));
+      ORT_RETURN_IF_ERROR(reader.Read(end));
+      // the program counter enforces that the intervals are ordered
+      const auto& ends = value_plan.program_counter.Ends();
+      ORT_RETURN_IF(end < start || (!ends.empty() && start <= ends.back()), "Invalid program counter.");
+      value_plan.program_counter.AddStart(static_cast<size_t>(start));
+      value_plan.program_counter.AddEnd(static_cast<size_t>(end));
+    }
+  }
+
+  for (auto* order : {&plan->initializer_allocation_order, &plan->activation_allocation_order}) {
+    size_t size = 0;
+    ORT_RETURN_IF_ERROR(reader.ReadCount(size));
+    order->resize(size);
+    for (auto& value_index : *order) {
+      ORT_RETURN_IF_ERROR(read_value_index(value_index));
+    }
+  }
+
+  uint64_t num_barriers = 0;
+  ORT_RETURN_IF_ERROR(reader.Read(num_barriers));
+  plan->num_barriers = static_cast<size_t>(num_barriers);
+
+  size_t num_notifications = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_notifications));
+  plan->notification_owners.resize(num_notifications);
+  for (auto& owner : plan->notification_owners) {
+    uint64_t stream_index = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(stream_index));
+    owner = static_cast<size_t>(stream_index);
+  }
+
+  size_t num_streams = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_streams));
+  for (size_t i = 0; i < num_streams; ++i) {
+    OrtDevice device;
+    ORT_RETURN_IF_ERROR(ReadDevice(reader, device));
+    auto& stream = plan->execution_plan.emplace_back(std::make_unique<SequentialExecutionPlan::LogicStream>(device));
+
+    size_t num_steps = 0;
+    ORT_RETURN_IF_ERROR(reader.ReadCount(num_steps));
+    stream->steps_.reserve(num_steps);
+    for (size_t j = 0; j < num_steps; ++j) {
+      uint8_t kind = 0;
+      NodeIndex node_index = 0;
+      uint64_t id = 0;
+      ORT_RETURN_IF_ERROR(reader.Read(kind));
+      ORT_RETURN_IF_ERROR(read_node_index(node_index));
+      ORT_RETURN_IF_ERROR(reader.Read(id));
+
+      switch (static_cast<ExecutionStep::Kind>(kind)) {
+        case ExecutionStep::Kind::kBarrier:
+          ORT_RETURN_IF(id >= plan->num_barriers, "Invalid barrier ", id);
+          stream->steps_.emplace_back(std::make_unique<BarrierStep>(static_cast<size_t>(id), node_index));
+          break;
+        case ExecutionStep::Kind::kLaunchKernel:
+          stream->steps_.emplace_back(std::make_unique<LaunchKernelStep>(node_index));
+          break;
+        case ExecutionStep::Kind::kActivateNotification:
+          ORT_RETURN_IF(id >= num_notifications, "Invalid notification ", id);
+          stream->steps_.emplace_back(
+              std::make_unique<ActivateNotificationStep>(static_cast<NotificationIndex>(id), node_index));
+          break;
+        case ExecutionStep::Kind::kTriggerDownstream:
+          stream->steps_.emplace_back(std::make_unique<TriggerDownstreamStep>(static_cast<size_t>(id), node_index));
+          break;
+        default:
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid step kind ", static_cast<int>(kind));
+      }
+    }
+  }
+
+  for (size_t owner : plan->notification_owners) {
+    ORT_RETURN_IF(owner >= num_streams, "Invalid notification owner ", owner);
+  }
+
+  size_t num_value_streams = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_value_streams));
+  plan->value_to_stream_map.reserve(num_value_streams);
+  for (size_t i = 0; i < num_value_streams; ++i) {
+    OrtValueIndex value_index = 0;
+    size_t stream_index = 0;
+    ORT_RETURN_IF_ERROR(read_value_index(value_index));
+    ORT_RETURN_IF_ERROR(read_index(num_streams, stream_index));
+    plan->value_to_stream_map[static_cast<size_t>(value_index)] = stream_index;
+  }
+
+  size_t num_release_actions = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_release_actions));
+  plan->release_actions.resize(num_release_actions);
+  for (auto& release_action : plan->release_actions) {
+    OrtValueIndex value_index = 0;
+    uint64_t ref_count = 0;
+    ORT_RETURN_IF_ERROR(read_value_index(value_index));
+    ORT_RETURN_IF_ERROR(reader.Read(ref_count));
+    release_action.value_index = static_cast<size_t>(value_index);
+    release_action.ref_count = static_cast<size_t>(ref_count);
+  }
+
+  // the release lists are indexed by node index when the nodes are executed
+  size_t num_release_lists = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_release_lists));
+  ORT_RETURN_IF(num_release_lists < graph_viewer.MaxNodeIndex(), "The release lists do not cover every node.");
+  plan->node_release_list.resize(num_release_lists);
+  for (auto& release_list : plan->node_release_list) {
+    size_t size = 0;
+    ORT_RETURN_IF_ERROR(reader.ReadCount(size));
+    release_list.resize(size);
+    for (auto& release_action_index : release_list) {
+      ORT_RETURN_IF_ERROR(read_index(num_release_actions, release_action_index));
+    }
+  }
+
+  size_t num_trigger_points = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_trigger_points));
+  plan->downstream_map.reserve(num_trigger_points);
+  for (size_t i = 0; i < num_trigger_points; ++i) {
+    uint64_t trigger_point_index = 0;
+    size_t num_downstreams = 0;
+    ORT_RETURN_IF_ERROR(reader.Read(trigger_point_index));
+    ORT_RETURN_IF_ERROR(reader.ReadCount(num_downstreams));
+    auto& downstreams = plan->downstream_map[static_cast<NotificationIndex>(trigger_point_index)];
+    for (size_t j = 0; j < num_downstreams; ++j) {
+      size_t stream_index = 0;
+      size_t step_index = 0;
+      ORT_RETURN_IF_ERROR(read_index(num_streams, stream_index));
+      ORT_RETURN_IF_ERROR(read_index(plan->execution_plan[stream_index]->steps_.size(), step_index));
+      downstreams.emplace_back(stream_index, step_index);
+    }
+  }
+
+  for (const auto& stream : plan->execution_plan) {
+    for (const auto& step : stream->steps_) {
+      ORT_RETURN_IF(step->GetKind() == ExecutionStep::Kind::kTriggerDownstream &&
+                        plan->downstream_map.find(step->GetId()) == plan->downstream_map.end(),
+                    "Invalid trigger point ", step->GetId());
+    }
+  }
+
+#ifdef ENABLE_TRAINING
+  size_t num_training_nodes = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_training_nodes));
+  plan->node_execution_order_in_training.resize(num_training_nodes);
+  for (auto& node_index : plan->node_execution_order_in_training) {
+    ORT_RETURN_IF_ERROR(read_node_index(node_index));
+  }
+
+  size_t num_toposort_indices = 0;
+  ORT_RETURN_IF_ERROR(reader.ReadCount(num_toposort_indices));
+  plan->node_index_2_toposort_index.reserve(num_toposort_indices);
+  for (size_t i = 0; i < num_toposort_indices; ++i) {
+    NodeIndex node_index = 0;
+    uint64_t toposort_index = 0;
+    ORT_RETURN_IF_ERROR(read_node_index(node_index));
+    ORT_RETURN_IF_ERROR(reader.Read(toposort_index));
+    plan->node_index_2_toposort_index[node_index] = static_cast<size_t>(toposort_index);
+  }
+#endif
+
+  ORT_RETURN_IF_NOT(reader.AtEnd(), "The execution plan has trailing data.");
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/platform/env.h"
+#include "core/platform/path_lib.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class KernelRegistryManager;
+class Node;
+class OrtValueNameIdxMap;
+class SessionState;
+struct KernelCreateInfo;
+
+/**
+ * A snapshot of an initialized session that lets later sessions of the same model skip most of the work of
+ * InferenceSession::Initialize().
+ *
+ * The snapshot holds the main graph after optimization and partitioning in ORT format, the kernel selected for each
+ * node, the OrtValue names in index order and the sequential execution plan. A session that loads a model with a
+ * valid snapshot loads the graph from the snapshot instead, so graph transformations run only once, and SessionState
+ * takes the kernels and the plan from the snapshot instead of searching the kernel registries and running the
+ * allocation planner. Anything that can not be restored, e.g. the plan of a graph with a wait on another device, is
+ * recomputed as usual.
+ *
+ * A snapshot is only used with the fingerprint of the build, CPU and session options it was created with, the
+ * content hash of the model file it was created from, and the same execution providers.
+ */
+class SessionSnapshot {
+ public:
+  ~SessionSnapshot();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionSnapshot);
+
+  /**
+   * Maps the snapshot file into memory and validates it.
+   * @return The snapshot, or nullptr if the file does not exist or was created with a different fingerprint, from
+   *         a different model or is corrupt.
+   */
+  static std::unique_ptr<SessionSnapshot> Load(const PathString& file_path, uint64_t fingerprint, uint64_t model_hash,
+                                               const logging::Logger& logger);
+
+  /**
+   * Writes a snapshot of an initialized session to the file and atomically replaces any existing file.
+   * @param ort_format_model The graph of the session serialized in ORT format before the session state was finalized.
+   * @param provider_types The types of the execution providers of the session in priority order.
+   */
+  static Status Save(const PathString& file_path, uint64_t fingerprint, uint64_t model_hash,
+                     gsl::span<const uint8_t> ort_format_model, gsl::span<const std::string> provider_types,
+                     const KernelRegistryManager& kernel_registry_manager, const SessionState& session_state);
+
+  // Computes the hash of the content of a model file that a snapshot is bound to.
+  static Status HashModelFile(const PathString& model_path, uint64_t& model_hash);
+
+  // The graph of the session in ORT format. Points into the mapped file.
+  gsl::span<const uint8_t> GetOrtFormatModel() const { return ort_format_model_; }
+
+  // Whether the snapshot was created by a session with the same execution providers in the same priority order.
+  bool MatchesExecutionProviders(gsl::span<const std::string> provider_types) const;
+
+  /**
+   * Returns the kernel selected for the node of the main graph when the snapshot was created.
+   * @return The kernel, or nullptr if it has to be searched for, e.g. because the kernel registries changed.
+   */
+  const KernelCreateInfo* GetKernelCreateInfo(const Node& node,
+                                              const KernelRegistryManager& kernel_registry_manager) const;
+
+  /**
+   * Restores the sequential execution plan of the main graph.
+   * @param restored Set to false if the plan was not recorded or does not fit the graph, in which case the plan
+   *                 has to be created by the allocation planner.
+   */
+  Status RestoreExecutionPlan(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                              std::optional<SequentialExecutionPlan>& plan, bool& restored) const;
+
+ private:
+  SessionSnapshot(Env::MappedMemoryPtr mapped_file, const logging::Logger& logger);
+
+  Status Parse(uint64_t fingerprint, uint64_t model_hash, size_t file_length);
+
+  Status ParseExecutionPlan(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                            std::optional<SequentialExecutionPlan>& plan) const;
+
+  Env::MappedMemoryPtr mapped_file_;
+  const logging::Logger& logger_;
+
+  gsl::span<const uint8_t> ort_format_model_;
+  gsl::span<const uint8_t> execution_plan_;  // empty if the plan could not be recorded
+
+  std::vector<std::string> provider_types_;
+  std::vector<size_t> provider_kernel_counts_;
+  std::vector<std::string> value_names_;
+  InlinedHashMap<NodeIndex, size_t> kernel_ordinals_;
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
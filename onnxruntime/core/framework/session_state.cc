@@ -183,7 +183,13 @@ Status SessionState::PopulateKernelCreateInfo(const KernelRegistryManager& kerne
                                               bool saving_ort_format) {
   for (auto& node : graph_.Nodes()) {
     const KernelCreateInfo* kci = nullptr;
-    auto status = kernel_registry_manager.SearchKernelRegistry(node, &kci);
+#if !defined(ORT_MINIMAL_BUILD)
+    if (session_snapshot_ != nullptr) {
+      kci = session_snapshot_->GetKernelCreateInfo(node, kernel_registry_manager);
+      restored_kernel_create_info_counter_ += kci != nullptr ? 1 : 0;
+    }
+#endif
+    auto status = kci != nullptr ? Status::OK() : kernel_registry_manager.SearchKernelRegistry(node, &kci);
     if (!status.IsOK() && saving_ort_format) {
       // if we didn't find the kernel and are saving to ORT format an EP that compiles nodes is enabled.
       // in that case we assigned the node to that EP but do not compile it into a fused node.
@@ -220,7 +226,8 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   concurrency::ThreadPool* thread_pool) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -229,7 +236,23 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
+
+    // Kernels of the CPU EP are created concurrently. Other EPs, fused nodes and custom op kernels may rely on state
+    // that is not thread-safe (e.g. the FuncManager or the custom op library) so their kernels are created serially.
+    const bool create_cpu_kernels_in_parallel = thread_pool != nullptr &&
+                                                !kernel_registry_manager.HasCustomKernelRegistries();
+    InlinedVector<const Node*> nodes_to_create_in_parallel;
+    InlinedVector<const Node*> nodes_to_create_serially;
     for (const auto& node : nodes) {
+      if (create_cpu_kernels_in_parallel && node.GetExecutionProviderType() == kCpuExecutionProvider &&
+          node.NodeType() != Node::Type::Fused) {
+        nodes_to_create_in_parallel.push_back(&node);
+      } else {
+        nodes_to_create_serially.push_back(&node);
+      }
+    }
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -238,8 +261,18 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    for (const Node* node : nodes_to_create_serially) {
+      ORT_RETURN_IF_ERROR(create_kernel(*node));
     }
+
+    ORT_RETURN_IF_ERROR(session_state_utils::ParallelForWithStatus(
+        thread_pool, nodes_to_create_in_parallel.size(),
+        [&create_kernel, &nodes_to_create_in_parallel](size_t i) {
+          return create_kernel(*nodes_to_create_in_parallel[i]);
+        }));
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
   return Status::OK();
@@ -401,12 +434,83 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+// Restores the pre-packed weight of the kernel from the pre-packed weights file, or packs it and adds it to the file.
+static Status PrePackWithFileCache(PrepackedWeightsFileCache& file_cache, OpKernel& kernel, const Node& node,
+                                   int input_idx, const Tensor& tensor, /*out*/ bool& is_packed,
+                                   /*out*/ bool& is_restored) {
+  is_packed = false;
+  is_restored = false;
+
+  const std::string key = PrepackedWeightsFileCache::GetKey(node, input_idx, tensor);
+
+  std::vector<BufferUniquePtr> prepacked_buffers;
+  std::vector<size_t> prepacked_buffer_sizes;
+  std::string kernel_path;
+  if (!key.empty() && file_cache.Find(key, prepacked_buffers, prepacked_buffer_sizes, kernel_path)) {
+    ORT_RETURN_IF_ERROR(kernel.RestorePrePackedBuffers(tensor, input_idx, prepacked_buffers, prepacked_buffer_sizes,
+                                                       kernel_path, is_restored));
+    if (is_restored) {
+      is_packed = true;
+      return Status::OK();
+    }
+  }
+
+  PrePackedWeights weights_to_be_filled_in;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx,
+                                     kernel.Info().GetAllocator(OrtMemType::OrtMemTypeDefault),
+                                     is_packed,
+                                     &weights_to_be_filled_in));
+
+  // kernels that pack without filling in the weights keep their own buffers and are not cached
+  if (is_packed && !key.empty() && !weights_to_be_filled_in.buffers_.empty()) {
+    const PrePackedWeights& cached_weights = file_cache.Add(key, std::move(weights_to_be_filled_in),
+                                                            kernel.GetKernelPath());
+    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(kernel, input_idx, cached_weights, node.Name()));
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       concurrency::ThreadPool* thread_pool) {
+  // A constant initialized tensor consumed by a node, from the current or an outer graph.
+  struct ConstantInput {
+    const std::string* name;
+    SessionState* session_state;
+    int ort_value_idx;
+    int input_idx;
+    const Tensor* tensor;
+    bool is_packed;
+  };
+
+  // The constant inputs of a node, i.e. a range of ConstantInput instances in input order.
+  struct NodeToPrepack {
+    const Node* node;
+    OpKernel* kernel;
+    size_t inputs_begin;
+    size_t inputs_end;
+  };
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map, thread_pool](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    auto is_shared_initializer = [&initializers_to_share_map](const std::string& input_name) {
+      return initializers_to_share_map.find(input_name) != initializers_to_share_map.end();
+    };
+
+    // Collect the constant inputs of all the nodes first. A constant initialized tensor is only released once every
+    // node that uses it has pre-packed it, so the tensors collected for the remaining nodes stay valid.
+    std::vector<ConstantInput> constant_inputs;
+    InlinedVector<NodeToPrepack> nodes_to_prepack_serially;
+    InlinedVector<NodeToPrepack> nodes_to_prepack_in_parallel;
     for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
+      const bool is_cpu_node = node.GetExecutionProviderType() == kCpuExecutionProvider;
+      // The kernels of the CPU EP pack into their own buffers independently from each other, so different kernels can
+      // pre-pack concurrently. Pre-packing that goes through the shared container or the pre-packed weights file and
+      // kernels of other EPs stay serial. The inputs of one kernel are always pre-packed serially and in order.
+      bool prepack_in_parallel = thread_pool != nullptr && is_cpu_node && prepacked_weights_file_cache_ == nullptr;
+
+      NodeToPrepack node_to_prepack{&node, GetMutableKernel(node.Index()), constant_inputs.size(), 0};
       int input_idx = 0;
       for (auto& input_def : node.InputDefs()) {
         if (input_def->Exists()) {
@@ -417,88 +521,14 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
           do {
             int ort_value_idx;
             if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
-
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-                    }
-                  }
-
-                } else {  // caching of pre-packed weights' turned OFF
-                  AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(OrtMemType::OrtMemTypeDefault);
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
-                }
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
-                  }
+              const std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+              auto constant_initialized_tensor = constant_initialized_tensors.find(ort_value_idx);
+              if (constant_initialized_tensor != constant_initialized_tensors.end()) {
+                constant_inputs.push_back({&input_name, st, ort_value_idx, input_idx,
+                                           &constant_initialized_tensor->second.Get<Tensor>(), false});
+                if (should_cache_prepacked_weights_for_shared_initializers && is_shared_initializer(input_name)) {
+                  prepack_in_parallel = false;
                 }
               }
               // stop searching in 2 cases:
@@ -513,6 +543,143 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
         }
         input_idx++;
       }
+
+      node_to_prepack.inputs_end = constant_inputs.size();
+      if (node_to_prepack.inputs_begin != node_to_prepack.inputs_end) {
+        (prepack_in_parallel ? nodes_to_prepack_in_parallel : nodes_to_prepack_serially).push_back(node_to_prepack);
+      }
+    }
+
+    auto prepack_node = [this, &constant_inputs, &is_shared_initializer,
+                         should_cache_prepacked_weights_for_shared_initializers](
+                            const NodeToPrepack& node_to_prepack) -> Status {
+      const Node& node = *node_to_prepack.node;
+      OpKernel* kernel = node_to_prepack.kernel;
+      for (size_t i = node_to_prepack.inputs_begin; i < node_to_prepack.inputs_end; ++i) {
+        ConstantInput& constant_input = constant_inputs[i];
+        const std::string& input_name = *constant_input.name;
+        const int input_idx = constant_input.input_idx;
+        const Tensor& const_initialized_tensor = *constant_input.tensor;
+        bool& is_packed = constant_input.is_packed;
+
+        // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+        if (is_shared_initializer(input_name) && should_cache_prepacked_weights_for_shared_initializers &&
+            node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
+
+          AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+          ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+          PrePackedWeights weights_to_be_filled_in;
+          // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+          // cached by another instance of the same op_type (for the same constant initializer) is because
+          // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+          // weight with the pre-packed weight generated by this instance of the same op_type because other static
+          // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+          ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                              is_packed,
+                                              &weights_to_be_filled_in));
+
+          if (is_packed) {
+            // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+            ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                        " doesn't have an implementation that can cache computed pre-packed weights");
+
+            const auto& op_type = node.OpType();
+
+            // Sanity check
+            // TODO: Check if some version of the ONNX IR allows op_type to be empty
+            ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+            // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+            // that we just got by invoking PrePack() on this kernel.
+
+            const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                                   weights_to_be_filled_in);
+
+            bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+
+            if (container_contains_packed_weight) {
+              LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                                  << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+
+              ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                  prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                  node.Name()));
+
+              ++used_shared_pre_packed_weights_counter_;
+            } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+
+              if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
+                return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
+              }
+
+              ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                  prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                                  node.Name()));
+            }
+          }
+
+        } else if (prepacked_weights_file_cache_ != nullptr &&
+                   node.GetExecutionProviderType() == kCpuExecutionProvider) {  // pre-packed weights file
+          bool is_restored = false;
+          ORT_RETURN_IF_ERROR(PrePackWithFileCache(*prepacked_weights_file_cache_, *kernel, node, input_idx,
+                                                   const_initialized_tensor, is_packed, is_restored));
+          if (is_restored) {
+            ++restored_pre_packed_weights_counter_;
+          }
+        } else {  // caching of pre-packed weights' turned OFF
+          AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(OrtMemType::OrtMemTypeDefault);
+          ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
+                                              session_cpu_alloc,  // use allocator tied to this session
+                                              is_packed,
+                                              nullptr  // no caching required
+                                              ));
+        }
+      }
+
+      return Status::OK();
+    };
+
+    // Counts the pre-packed weights of a node and releases the constant initialized tensors no kernel needs anymore.
+    auto release_prepacked_inputs = [this, &constant_inputs, &constant_initializers_use_count](
+                                        const NodeToPrepack& node_to_prepack) {
+      for (size_t i = node_to_prepack.inputs_begin; i < node_to_prepack.inputs_end; ++i) {
+        const ConstantInput& constant_input = constant_inputs[i];
+        if (constant_input.is_packed) {
+          ++number_of_prepacks_counter_;
+
+          const std::string& input_name = *constant_input.name;
+          if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+            // release the constant initialized tensor
+            constant_input.session_state->initialized_tensors_.erase(constant_input.ort_value_idx);
+            constant_input.session_state->constant_initialized_tensors_.erase(constant_input.ort_value_idx);
+          }
+        }
+      }
+    };
+
+    for (const auto& node_to_prepack : nodes_to_prepack_serially) {
+      ORT_RETURN_IF_ERROR(prepack_node(node_to_prepack));
+      release_prepacked_inputs(node_to_prepack);
+    }
+
+    // The nodes are pre-packed in parallel in chunks of a few nodes per thread, and the tensors of a chunk are
+    // released in node order once the chunk completes, so the original and the pre-packed copies of the weights do
+    // not all coexist.
+    constexpr size_t kNodesPerThreadInChunk = 4;
+    const size_t chunk_size = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool)) *
+                              kNodesPerThreadInChunk;
+    for (size_t chunk_begin = 0; chunk_begin < nodes_to_prepack_in_parallel.size(); chunk_begin += chunk_size) {
+      const size_t chunk_end = std::min(chunk_begin + chunk_size, nodes_to_prepack_in_parallel.size());
+      ORT_RETURN_IF_ERROR(session_state_utils::ParallelForWithStatus(
+          thread_pool, chunk_end - chunk_begin,
+          [&prepack_node, &nodes_to_prepack_in_parallel, chunk_begin](size_t i) {
+            return prepack_node(nodes_to_prepack_in_parallel[chunk_begin + i]);
+          }));
+
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        release_prepacked_inputs(nodes_to_prepack_in_parallel[i]);
+      }
     }
 
     return Status::OK();
@@ -1397,18 +1564,56 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  // Record the time of each phase in the session creation profile.
+  TimePoint phase_start_time;
+  auto start_phase = [this, &phase_start_time]() {
+    if (profiler_.IsEnabled()) {
+      phase_start_time = profiler_.Start();
+    }
+  };
+  auto end_phase = [this, &phase_start_time, parent_node](const std::string& phase_name) {
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, phase_name, phase_start_time,
+                                      {{"subgraph", parent_node != nullptr ? parent_node->Name() : ""}});
+    }
+  };
+
+  // The intra-op thread pool is idle while the session is initialized, so use it to deserialize the initializers,
+  // create the kernels and pre-pack the weights unless parallel initialization is disabled.
+  concurrency::ThreadPool* init_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableParallelInitialization,
+                                                        "0") == "1"
+          ? nullptr
+          : thread_pool_;
+
+  start_phase();
+
+  bool restored_plan = false;
+#if !defined(ORT_MINIMAL_BUILD)
+  if (session_snapshot_ != nullptr && parent_node == nullptr) {
+    ORT_RETURN_IF_ERROR(session_snapshot_->RestoreExecutionPlan(*graph_viewer_, ort_value_name_idx_map_,
+                                                                p_seq_exec_plan_, restored_plan));
+  }
+#endif
+
+  execution_plan_restored_ = restored_plan;
+
+  if (!restored_plan) {
+    auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                                execution_providers_, kernel_create_info_map_,
+                                                subgraphs_kernel_create_info_maps,
+                                                outer_scope_node_arg_to_location_map,
+                                                ort_value_name_idx_map_, context,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                                GetStreamHandleRegistryInstance(),
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
-  ORT_RETURN_IF_ERROR(status);
+                                                partition_config_file,
+                                                Logger(),
+                                                p_seq_exec_plan_);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  end_phase("session_state_planning");
 
   // Record the allocation plan
 
@@ -1476,6 +1681,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  start_phase();
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
@@ -1489,7 +1696,9 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func, init_thread_pool));
+
+  end_phase("session_state_initializers");
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1503,11 +1712,16 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  start_phase();
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, init_thread_pool));
+  end_phase("session_state_create_kernels");
 
   if (!disable_prepacking) {
+    start_phase();
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          init_thread_pool));
+    end_phase("session_state_prepack");
   }
 
   ORT_RETURN_IF_ERROR(
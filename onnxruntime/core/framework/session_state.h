@@ -22,6 +22,8 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_file_cache.h"
+#include "core/framework/session_snapshot.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -319,6 +321,33 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetRestoredPrePackedWeightCounter() const {
+    return restored_pre_packed_weights_counter_;
+  }
+
+  size_t GetRestoredKernelCreateInfoCounter() const {
+    return restored_kernel_create_info_counter_;
+  }
+
+  // Whether the execution plan was restored from the session snapshot instead of created by the allocation planner
+  bool IsExecutionPlanRestored() const {
+    return execution_plan_restored_;
+  }
+
+  // Sets the file that the pre-packed weights of the main graph are restored from and added to.
+  // Must be called before FinalizeSessionState(). The cache has to outlive the kernels of the session.
+  void SetPrepackedWeightsFileCache(PrepackedWeightsFileCache* prepacked_weights_file_cache) {
+    prepacked_weights_file_cache_ = prepacked_weights_file_cache;
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Sets the snapshot that the kernels and the execution plan of the main graph are restored from.
+  // Must be called before FinalizeSessionState(). The snapshot has to outlive the call.
+  void SetSessionSnapshot(const SessionSnapshot* session_snapshot) {
+    session_snapshot_ = session_snapshot;
+  }
+#endif
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -358,8 +387,8 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo();
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_. CPU EP kernels are created on the thread pool if not null.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, concurrency::ThreadPool* thread_pool);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -368,9 +397,11 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * The kernels of different CPU EP nodes pre-pack concurrently on the thread pool if it is not null.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -520,6 +551,14 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // File of pre-packed weights persisted across sessions. Owned by the inference session. nullptr if not used.
+  PrepackedWeightsFileCache* prepacked_weights_file_cache_ = nullptr;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Snapshot of a previous session of the model. Owned by the inference session. nullptr if not used.
+  const SessionSnapshot* session_snapshot_ = nullptr;
+#endif
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -550,6 +589,15 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight was restored from the pre-packed weights file
+  size_t restored_pre_packed_weights_counter_ = 0;
+
+  // Counter for number of kernels restored from the session snapshot instead of searching the kernel registries
+  size_t restored_kernel_create_info_counter_ = 0;
+
+  // Whether the execution plan was restored from the session snapshot
+  bool execution_plan_restored_ = false;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <limits>
 #include <utility>
@@ -12,6 +14,7 @@
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
@@ -26,6 +29,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -187,6 +191,59 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   return common::Status::OK();
 }
 
+common::Status ParallelForWithStatus(concurrency::ThreadPool* thread_pool, size_t total,
+                                     const std::function<Status(size_t)>& fn) {
+  if (total == 0) {
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(total);
+#ifndef ORT_NO_EXCEPTIONS
+  std::vector<std::exception_ptr> exceptions(total);
+#endif
+
+  // the lowest index of a failed call so far. the calls after it are skipped as their results are not reported.
+  std::atomic<size_t> first_failed_index{total};
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(total), [&](std::ptrdiff_t i) {
+        const size_t index = static_cast<size_t>(i);
+        if (index > first_failed_index.load(std::memory_order_relaxed)) {
+          return;
+        }
+
+        bool failed = false;
+        ORT_TRY {
+          statuses[index] = fn(index);
+          failed = !statuses[index].IsOK();
+        }
+        ORT_CATCH(...) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            exceptions[index] = std::current_exception();
+            failed = true;
+          });
+        }
+
+        if (failed) {
+          size_t current = first_failed_index.load();
+          while (index < current && !first_failed_index.compare_exchange_weak(current, index)) {
+          }
+        }
+      });
+
+  const size_t failed_index = first_failed_index.load();
+  if (failed_index == total) {
+    return Status::OK();
+  }
+
+#ifndef ORT_NO_EXCEPTIONS
+  if (exceptions[failed_index]) {
+    std::rethrow_exception(exceptions[failed_index]);
+  }
+#endif
+  return statuses[failed_index];
+}
+
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_alloc,
@@ -197,7 +254,8 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -290,8 +348,88 @@ common::Status SaveInitializedTensors(
   }
 
   OrtCallback deleter{nullptr, nullptr};
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
 
   // 3. create weight tensors based on weights buffer
+  // The tensors planned on the CPU are deserialized in parallel, which covers unpacking the TensorProto data and
+  // reading external data. Tensors on other devices are copied serially as the copies are not known to be thread-safe.
+  // The tensors are saved in order after each batch, which bounds the memory held by both a TensorProto and its
+  // tensor, and keeps the session state independent of the scheduling.
+  const std::string batch_size_str = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsConfigInitializerDeserializationBatchSize, "268435456");
+  size_t deserialization_batch_size_in_bytes = 0;
+  if (!TryParseStringWithClassicLocale(batch_size_str, deserialization_batch_size_in_bytes) ||
+      deserialization_batch_size_in_bytes == 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                           kOrtSessionOptionsConfigInitializerDeserializationBatchSize, ": '", batch_size_str,
+                           "'. It must be a positive integer.");
+  }
+
+  struct InitializerToSave {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+  };
+
+  std::vector<InitializerToSave> batch;
+  std::vector<size_t> cpu_initializers;
+  std::vector<size_t> device_initializers;
+  size_t batch_size_in_bytes = 0;
+
+  auto deserialize = [&](InitializerToSave& initializer) -> Status {
+    const ONNX_NAMESPACE::TensorProto& tensor_proto = *initializer.tensor_proto;
+    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto,
+                                       (initializer.m.has_value()) ? &*initializer.m : nullptr, initializer.alloc,
+                                       default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                                       use_device_allocator_for_initializers);
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+
+    return Status::OK();
+  };
+
+  auto save_batch = [&]() -> Status {
+    ORT_RETURN_IF_ERROR(ParallelForWithStatus(thread_pool, cpu_initializers.size(), [&](size_t i) {
+      return deserialize(batch[cpu_initializers[i]]);
+    }));
+
+    for (size_t i : device_initializers) {
+      ORT_RETURN_IF_ERROR(deserialize(batch[i]));
+    }
+
+    for (auto& initializer : batch) {
+      const std::string& name = initializer.tensor_proto->name();
+
+      // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
+      // so we need to output this message prior to calling save_tensor_func
+      VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << initializer.ort_value_index;
+
+      // any outer scope value is shadowed by a local value and can't override it.
+      // due to that check_outer_scope is false
+      const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+#if !defined(DISABLE_SPARSE_TENSORS)
+      const bool sparse = graph.GetGraph().IsSparseInitializer(name);
+      ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter, constant,
+                                           sparse));
+#else
+      ORT_RETURN_IF_ERROR(save_tensor_func(name, initializer.ort_value_index, initializer.ort_value, deleter, constant,
+                                           false));
+#endif
+    }
+
+    batch.clear();
+    cpu_initializers.clear();
+    device_initializers.clear();
+    batch_size_in_bytes = 0;
+    return Status::OK();
+  };
+
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
     const std::string& name = entry.second->name();
@@ -301,46 +439,35 @@ common::Status SaveInitializedTensors(
       continue;
     }
 
-    OrtValue ort_value;
+    InitializerToSave& initializer = batch.emplace_back();
+    initializer.ort_value_index = ort_value_index;
+    initializer.tensor_proto = entry.second;
 
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
     } else {
-      const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::optional<MemBuffer> m;
-      AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m, initializer.alloc));
+      if (exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU) {
+        cpu_initializers.push_back(batch.size() - 1);
+      } else {
+        device_initializers.push_back(batch.size() - 1);
       }
-    }
 
-    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
-    // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+      size_t size_in_bytes = 0;
+      if (utils::GetSizeInBytesFromTensorProto<0>(*entry.second, &size_in_bytes).IsOK()) {
+        batch_size_in_bytes += size_in_bytes;
+      }
+    }
 
-    // any outer scope value is shadowed by a local value and can't override it.
-    // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-#if !defined(DISABLE_SPARSE_TENSORS)
-    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
-#else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
-#endif
+    if (batch_size_in_bytes >= deserialization_batch_size_in_bytes) {
+      ORT_RETURN_IF_ERROR(save_batch());
+    }
   }
 
+  ORT_RETURN_IF_ERROR(save_batch());
+
   LOGS(logger, INFO) << "Done saving initialized tensors";
   return common::Status::OK();
 }
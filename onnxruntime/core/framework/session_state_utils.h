@@ -13,6 +13,9 @@
 #include "core/platform/path_lib.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
 class Env;
 class KernelRegistryManager;
 class Node;
@@ -34,6 +37,19 @@ using SaveTensorFunction = std::function<Status(const std::string& name, int idx
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+/**
+ * Runs fn(i) for each i in [0, total) on the thread pool, or serially if thread_pool is nullptr, for the parallel phases
+ * of session initialization.
+ * @return The status of the failed call with the lowest i, so the error does not depend on the scheduling. The calls
+ *         with a higher i than a failed call may be skipped. An exception thrown by fn is rethrown on the calling thread.
+ */
+common::Status ParallelForWithStatus(concurrency::ThreadPool* thread_pool, size_t total,
+                                     const std::function<Status(size_t)>& fn);
+
+/**
+ * Deserializes the initializers of the graph and passes them to save_tensor_func in a deterministic order.
+ * The initializers that are planned on the CPU are deserialized on the thread pool if thread_pool is not nullptr.
+ */
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -44,7 +60,8 @@ common::Status SaveInitializedTensors(
     const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func);
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool);
 
 common::Status SaveInputOutputNamesToNodeMapping(const GraphViewer& graph,
                                                  SessionState& session_state,
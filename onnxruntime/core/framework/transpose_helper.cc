@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/transpose_helper.h"
+#include "core/common/narrow.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -231,9 +232,32 @@ void TransposeSingleAxisInwards(gsl::span<const size_t> permutations, const Tens
   }
 }
 
+//  `input_shape_override` overrides the shape of `input` for compute purposes.
+bool TryMlasTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  if (input.IsDataTypeString()) {
+    return false;
+  }
+
+  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
+  const auto input_dims = input_shape.GetDims();
+
+  InlinedVector<size_t> dims(input_dims.size());
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    dims[i] = narrow<size_t>(input_dims[i]);
+  }
+
+  return MlasTransposeNd(input.DataRaw(), output.MutableDataRaw(), input.DataType()->Size(), dims.size(),
+                         dims.data(), permutations.data(), tp);
+}
+
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 void SingleAxisTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output, size_t from,
-                         size_t to, const TensorShape* input_shape_override) {
+                         size_t to, const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
+  if (TryMlasTranspose(permutations, input, output, input_shape_override, tp)) {
+    return;
+  }
+
   if (from > to) {
     TransposeSingleAxisOutwards(permutations, input, output, from, to, input_shape_override);
   } else {
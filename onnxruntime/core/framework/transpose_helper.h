@@ -27,6 +27,9 @@ We use simple pointer arithmetic if the size of each read/write is a power of 2
 We use memcpy if the block size is larger.
 
 We fall back to the default implementation in all other cases, and if the input is std::string.
+
+Both are preceded by the MLAS N-D transpose, which handles any permutation of tensors with 1, 2, 4 or 8 byte elements
+by merging the axes that stay adjacent, and transposing the innermost input and output axes in cache sized tiles.
 */
 
 #include <sstream>
@@ -39,7 +42,17 @@ We fall back to the default implementation in all other cases, and if the input
 #include "core/common/gsl.h"
 
 namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}
+
 bool IsTransposeMovingSingleAxis(gsl::span<const size_t> permutations, size_t& from, size_t& to);
 void SingleAxisTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output, size_t from,
-                         size_t to, const TensorShape* input_shape_override = nullptr);
+                         size_t to, const TensorShape* input_shape_override = nullptr,
+                         concurrency::ThreadPool* tp = nullptr);
+
+// Transposes with MlasTransposeNd. Returns false without writing the output if the input is std::string or MLAS
+// does not support the shape.
+bool TryMlasTranspose(gsl::span<const size_t> permutations, const Tensor& input, Tensor& output,
+                      const TensorShape* input_shape_override = nullptr, concurrency::ThreadPool* tp = nullptr);
 }  // namespace onnxruntime
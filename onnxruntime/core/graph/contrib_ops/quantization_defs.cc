@@ -10,6 +10,7 @@
 #include "core/graph/contrib_ops/contrib_defs.h"
 #include "core/graph/contrib_ops/shape_inference_functions.h"
 #include "onnx/onnx-ml.pb.h" // ?
+#include "onnx/defs/tensor_proto_util.h"
 
 // Suppress a warning: global initializer calls a non-constexpr function 'symbol' which is from
 // ONNX_OPERATOR_SET_SCHEMA_EX macro and only happens in debug build
@@ -403,6 +404,56 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
         }));
 
+static const char* MatMulFpQ4_ver1_doc = R"DOC(
+Matrix product that behaves like numpy.matmul, with the right hand side matrix B quantized to int4 and packed
+into a 1-D data blob. Each column of B is divided into blocks of consecutive values along the K dimension, and
+each block is quantized into 4-bit integers with a fp32 scale and an optional zero point.
+The blob is produced by MlasQ4GemmPackB. The quantization type is one of:
+(0): block size 32, no zero point, (1): block size 32, with zero point, (2): block size 64, no zero point,
+(3): block size 128, no zero point.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MatMulFpQ4, 1,
+    OpSchema()
+        .SetDoc(MatMulFpQ4_ver1_doc)
+        .Attr("blk_quant_type", "Block quantization type of input 'B'.", AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "A", "N-dimensional matrix A", "T1")
+        .Input(1, "B", "1-dimensional data blob of the int4 quantized matrix B", "T2")
+        .Input(2, "B_shape", "Shape of the matrix B before quantization: [K, N]", "T3")
+        .Input(3, "bias", "1D input tensor, whose dimension is same as B's last dimension", "T1", OpSchema::Optional)
+        .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+        .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, bias and output Y data type as float tensor.")
+        .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain input B data type as data blob.")
+        .TypeConstraint("T3", {"tensor(int64)"}, "Constrain input B_shape data type as int64 tensor.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+          // Infer output shape if 'B_shape' is an initializer
+          const auto* b_shape_initializer = ctx.getInputData(2);
+          if (!hasInputShape(ctx, 0) || nullptr == b_shape_initializer) {
+            return;
+          }
+
+          const auto b_shape = ONNX_NAMESPACE::ParseData<int64_t>(b_shape_initializer);
+          if (b_shape.size() != 2) {
+            fail_shape_inference("B_shape must be a 1D tensor with 2 elements: [K, N]");
+          }
+
+          const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+          if (a_shape.dim_size() == 0) {
+            fail_shape_inference("Input tensors of wrong rank (0).");
+          }
+
+          // The output has the leading dimensions of A followed by N. A 1-D A yields a 1-D output.
+          ONNX_NAMESPACE::TensorShapeProto output_shape;
+          for (int i = 0; i < a_shape.dim_size() - 1; i++) {
+            *output_shape.add_dim() = a_shape.dim(i);
+          }
+          output_shape.add_dim()->set_dim_value(b_shape[1]);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     MatMulIntegerToFloat, 1,
     OpSchema()
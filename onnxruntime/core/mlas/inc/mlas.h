@@ -104,7 +104,8 @@ typedef enum { CblasLeft=141, CblasRight=142} CBLAS_SIDE;
 #endif
 
 //
-// Forward declare the thread pool implementation class and half precision floating point.
+// Forward declare the thread pool implementation class and half precision and
+// bfloat16 floating point.
 //
 // N.B. Avoid including ONNX Runtime headers here to keep the dependencies for
 // standalone MLAS test executables smaller.
@@ -115,6 +116,7 @@ namespace onnxruntime {
         class ThreadPool;
     };
     struct MLFloat16;
+    struct BFloat16;
 };  // namespace onnxruntime
 
 using MLAS_THREADPOOL = onnxruntime::concurrency::ThreadPool;
@@ -130,6 +132,20 @@ MlasGetPreferredBufferAlignment(
     void
     );
 
+//
+// Returns an identifier of the processor features that select the kernels of
+// the library. Packed buffers, such as those from MlasGemmPackB, have a layout
+// specific to the selected kernels, so packed buffers persisted by a process
+// are only valid in a process with the same build of the library and the same
+// identifier.
+//
+
+uint64_t
+MLASCALL
+MlasGetPlatformId(
+    void
+    );
+
 #ifdef MLAS_TARGET_AMD64_IX86
 
 /**
@@ -158,6 +174,9 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluErfActivation,
+    MlasGeluTanhActivation,
+    MlasQuickGeluActivation,
     MlasActivationKindCount,
 };
 
@@ -175,6 +194,9 @@ struct MLAS_ACTIVATION {
             float alpha;
             float beta;
         } HardSigmoid;
+        struct {
+            float alpha;
+        } QuickGelu;
         float Values[2];
     } Parameters;
 };
@@ -198,6 +220,11 @@ MlasActivation(
 
 /**
  * @brief Supply matrices data information to single precision gemm functions
+ *
+ * The optional epilogue is applied to each tile of matrix C as soon as the
+ * tile is complete, while it is still resident in the cache:
+ *
+ *     C := Activation(alpha * op(A) * op(B) + beta * C + Bias) + Residual
  */
 struct MLAS_SGEMM_DATA_PARAMS {
     const float* A = nullptr; /**< Supplies the address of matrix A */
@@ -209,6 +236,10 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const float* Bias = nullptr;                 /**< Supplies the optional bias vector of N elements added to each row of matrix C */
+    const MLAS_ACTIVATION* Activation = nullptr; /**< Supplies the optional activation applied after the bias */
+    const float* Residual = nullptr;             /**< Supplies the optional M x N matrix added after the activation, must not alias C */
+    size_t ldr = 0;                              /**< Supplies the first dimension of the residual matrix */
 };
 
 /**
@@ -751,6 +782,10 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
+    MlasConvAlgorithmNhwcGemmDirect,
+    MlasConvAlgorithmNhwcExpandThenGemm,
+    MlasConvAlgorithmNhwcDepthwise,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -781,8 +816,18 @@ struct MLAS_CONV_PARAMETERS {
             size_t ldb;
         } GemmDirect;
         struct {
+            size_t ThreadStrideM;
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t OutputTileSize;
+            size_t TileBlockSize;
+            size_t FilterBufferSize;
+            const float* PackedFilter;
+        } Winograd;
+        struct {
+            size_t BlockSize;
+        } Nhwc;
     } u;
 };
 
@@ -816,6 +861,114 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution routines for 3x3 convolutions with unit strides and
+// dilations.
+//
+// MlasConvWinogradPrepare updates the parameters computed by MlasConvPrepare
+// to use a Winograd algorithm when its estimated cost is lower than that of
+// the algorithm selected by MlasConvPrepare. The results differ from those of
+// the other algorithms by rounding. The filter may be transformed ahead of
+// time by MlasConvWinogradPackFilter, else the transform is computed by each
+// call to MlasConv.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+bool
+MLASCALL
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Single precision convolution routines for tensors in the channels last
+// (NHWC) format.
+//
+// The input tensor is [BatchCount][InputShape][GroupCount * InputChannels]
+// and the output tensor is [BatchCount][OutputShape][GroupCount * FilterCount].
+// The filter is packed ahead of time by MlasConvNhwcPackFilter from the
+// [GroupCount * FilterCount][InputChannels][KernelShape] layout used by
+// MlasConv to a buffer aligned to MlasGetPreferredBufferAlignment. When Beta is non-zero, the existing output is scaled and added
+// before the activation.
+//
+
+size_t
+MLASCALL
+MlasConvNhwcPackFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t KernelSize
+    );
+
+void
+MLASCALL
+MlasConvNhwcPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t KernelSize,
+    const float* Filter,
+    void* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvNhwcPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    float Beta,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasConvNhwc(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1021,6 +1174,252 @@ MlasComputeTanh(
     size_t N
     );
 
+enum MLAS_GELU_KIND {
+    MlasGeluErf,    /**< 0.5 * x * (1 + erf(x / sqrt(2))) */
+    MlasGeluTanh,   /**< 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))) */
+    MlasGeluQuick,  /**< x * sigmoid(alpha * x) */
+};
+
+/**
+ * @brief Computes the GELU activation of the input after optionally adding
+ *        a bias vector, in a single pass over the data.
+ *
+ * @param Kind        The GELU formulation to apply
+ * @param Input       Address of the N inputs
+ * @param Bias        Optional bias vector of BiasLength elements, repeated
+ *                    over the input. N must be a multiple of BiasLength
+ * @param BiasLength  Number of elements of the bias vector
+ * @param Output      Address of the N outputs, may alias Input
+ * @param N           Number of elements
+ * @param Alpha       Scale of the sigmoid argument for MlasGeluQuick
+ */
+void
+MLASCALL
+MlasComputeGelu(
+    MLAS_GELU_KIND Kind,
+    const float* Input,
+    const float* Bias,
+    size_t BiasLength,
+    float* Output,
+    size_t N,
+    float Alpha
+    );
+
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceMean,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+    MlasReduceLogSumExp,
+};
+
+/**
+ * @brief Reduces the innermost dimension of a [CountK, CountR] tensor,
+ *        producing CountK outputs. Input type is float or MLAS_FP16, the
+ *        accumulation is done in float.
+ *
+ * @param Kind        The reduction to apply
+ * @param Input       Address of the [CountK, CountR] input
+ * @param Output      Address of the CountK outputs
+ * @param CountK      Number of rows kept
+ * @param CountR      Number of elements reduced per row, must not be zero
+ * @param ThreadPool  Optional thread pool
+ */
+template <typename T>
+void
+MLASCALL
+MlasReduceKR(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t CountK,
+    size_t CountR,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief Reduces the middle dimension of a [CountK0, CountR, CountK1] tensor,
+ *        producing a [CountK0, CountK1] output. The RK case is CountK0 == 1.
+ *        Input type is float or MLAS_FP16, the accumulation is done in float.
+ *
+ * @param Kind        The reduction to apply
+ * @param Input       Address of the [CountK0, CountR, CountK1] input
+ * @param Output      Address of the [CountK0, CountK1] output
+ * @param CountK0     Number of outer slices kept
+ * @param CountR      Number of rows reduced per slice, must not be zero
+ * @param CountK1     Number of inner columns kept
+ * @param ThreadPool  Optional thread pool
+ */
+template <typename T>
+void
+MLASCALL
+MlasReduceKRK(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t CountK0,
+    size_t CountR,
+    size_t CountK1,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Layer normalization routines.
+//
+
+/**
+ * @brief Parameters of a layer normalization over the rows of a
+ *        [RowCount, RowSize] tensor. Each row is computed as
+ *
+ *     X := Input + Skip + Bias
+ *     Output := (X - Mean(X)) / Sqrt(Variance(X) + Epsilon) * Gamma + Beta
+ *
+ *        When Simplified is set, the mean is not subtracted and the root mean
+ *        square of X is used instead of the standard deviation.
+ */
+template <typename T>
+struct MLAS_LAYER_NORM_PARAMS {
+    const T* Input = nullptr;    /**< Supplies the address of the [RowCount, RowSize] input */
+    const T* Skip = nullptr;     /**< Supplies the optional [RowCount, RowSize] tensor added to the input */
+    const T* Bias = nullptr;     /**< Supplies the optional vector of RowSize elements added to the input */
+    const T* Gamma = nullptr;    /**< Supplies the vector of RowSize scale elements */
+    const T* Beta = nullptr;     /**< Supplies the optional vector of RowSize shift elements */
+    T* Output = nullptr;         /**< Supplies the address of the [RowCount, RowSize] output */
+    T* SkipOutput = nullptr;     /**< Supplies the optional address to store X before the normalization */
+    float* Mean = nullptr;       /**< Supplies the optional address to store the RowCount means */
+    float* InvStdDev = nullptr;  /**< Supplies the optional address to store the RowCount inverse deviations */
+    float Epsilon = 1e-5f;       /**< Supplies the value added to the variance */
+    bool Simplified = false;     /**< Whether to skip the mean subtraction (RMS normalization) */
+};
+
+/**
+ * @brief Computes the layer normalization of each row of a tensor. Input
+ *        type is float or MLAS_FP16, the computation is done in float.
+ *
+ * @param Params      The layer normalization parameters
+ * @param RowCount    Number of rows to normalize
+ * @param RowSize     Number of elements per row, must not be zero
+ * @param ThreadPool  Optional thread pool
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNorm(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Element-wise binary routines.
+//
+
+enum MLAS_ELTWISE_BINARY_OP {
+    MlasEltwiseAdd,
+    MlasEltwiseSub,
+    MlasEltwiseMul,
+    MlasEltwiseDiv,
+    MlasEltwiseMax,
+    MlasEltwiseMin,
+};
+
+/**
+ * @brief Shape of an input of MlasEltwiseBinary relative to the M x N output.
+ */
+enum MLAS_BROADCAST_SHAPE {
+    MlasBroadcastNone,    /**< M x N matrix, no broadcast */
+    MlasBroadcastScalar,  /**< single element broadcast to the output */
+    MlasBroadcastRow,     /**< row vector of N elements repeated over the M rows */
+    MlasBroadcastColumn,  /**< column vector of M elements repeated over the N columns */
+};
+
+/**
+ * @brief Computes Output := Op(InputA, InputB) over an M x N output after
+ *        broadcasting each input from its shape. Callers reduce a broadcast
+ *        of arbitrary rank to this form by coalescing adjacent dimensions.
+ *        Type is float, MLAS_FP16, int32_t or int64_t. MLAS_FP16 is computed
+ *        in float. MlasEltwiseMax and MlasEltwiseMin return NaN if either
+ *        input is NaN.
+ *
+ * @param Op          The binary operation
+ * @param InputA      Address of the first input
+ * @param ShapeA      Broadcast shape of the first input
+ * @param InputB      Address of the second input
+ * @param ShapeB      Broadcast shape of the second input
+ * @param Output      Address of the M x N output, may alias a non broadcast input
+ * @param M           Number of output rows
+ * @param N           Number of output columns
+ * @param ThreadPool  Optional thread pool
+ */
+template <typename T>
+void
+MLASCALL
+MlasEltwiseBinary(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const T* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const T* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    T* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Element-wise unary routines.
+//
+
+/**
+ * @brief Unary functions computed by MlasComputeUnary. The error bounds are
+ *        for float results and are measured against the correctly rounded
+ *        result, MLAS_FP16 results are within 1 ulp.
+ */
+enum MLAS_UNARY_FUNCTION {
+    MlasUnaryLog,         /**< natural logarithm, 1 ulp */
+    MlasUnarySqrt,        /**< square root, correctly rounded */
+    MlasUnaryReciprocal,  /**< 1 / x, correctly rounded */
+    MlasUnarySin,         /**< sine, 2.5 ulp */
+    MlasUnaryCos,         /**< cosine, 2.5 ulp */
+    MlasUnaryPow,         /**< x ^ Parameter, see MlasComputeUnary */
+};
+
+/**
+ * @brief Computes Output := Function(Input) element-wise. Type is float or
+ *        MLAS_FP16, MLAS_FP16 is computed in float.
+ *
+ *        MlasUnaryPow computes the exponents 0.5 and -0.5 as sqrt(x) and
+ *        1 / sqrt(x) within 0.5 and 1.5 ulp. Other integer exponents up to 16 in
+ *        magnitude are computed by repeated squaring within |Parameter| ulp,
+ *        or 1.5 |Parameter| ulp for a negative exponent, which makes 0, 1, 2
+ *        and -1 correctly rounded. The remaining exponents are computed as
+ *        exp(Parameter * log(x)) within (2 + 3 |Parameter * log(x)|) ulp.
+ *        Special values follow pow().
+ *
+ * @param Function    The unary function
+ * @param Input       Address of the input elements
+ * @param Output      Address of the output elements, may alias the input
+ * @param N           Number of elements
+ * @param Parameter   Exponent of MlasUnaryPow, ignored by other functions
+ * @param ThreadPool  Optional thread pool
+ */
+template <typename T>
+void
+MLASCALL
+MlasComputeUnary(
+    MLAS_UNARY_FUNCTION Function,
+    const T* Input,
+    T* Output,
+    size_t N,
+    float Parameter,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -1083,6 +1482,37 @@ MlasTranspose(
     size_t N
     );
 
+/**
+ * @brief Transposes a tensor of any rank by a permutation of its axes.
+ *
+ * Axes of size one are dropped and axes that stay adjacent in both tensors
+ * are merged. The innermost input axis and the innermost output axis are then
+ * transposed in cache sized tiles, or rows are copied if both are the same
+ * axis, and the work is split over the thread pool.
+ *
+ * @param Input        Supplies the input tensor.
+ * @param Output       Supplies the output tensor.
+ * @param ElementSize  Supplies the size of an element in bytes.
+ * @param Rank         Supplies the number of axes.
+ * @param InputShape   Supplies the input shape.
+ * @param Permutation  Supplies the input axis for each output axis.
+ * @param ThreadPool   Supplies the thread pool object to use, else nullptr if
+ *                     the base library threading support should be used.
+ * @return false if the rank is too large after merging axes, in which case
+ *         the output is not written.
+ */
+bool
+MLASCALL
+MlasTransposeNd(
+    const void* Input,
+    void* Output,
+    size_t ElementSize,
+    size_t Rank,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1219,6 +1649,39 @@ MlasQuantizeLinear(
     OutputType ZeroPoint
     );
 
+//
+// Dynamic linear quantization routines. The range of the input, widened to
+// include zero, is mapped onto the full range of the output type as defined
+// by the DynamicQuantizeLinear operator.
+//
+
+template<typename OutputType>
+void
+MLASCALL
+MlasDynamicQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    float* Scale,
+    OutputType* ZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template<typename OutputType>
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow(
+    const float* Input,
+    size_t InputLeadingDimension,
+    OutputType* Output,
+    size_t OutputLeadingDimension,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    OutputType* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 /**
  * @brief Requantize a block of the intermediate buffer to the output buffer,
  *        optionally adding the supplied bias
@@ -1409,6 +1872,14 @@ constexpr size_t FP16_SIZE = sizeof(uint16_t);
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether the half precision GEMM kernel of the current CPU accumulates
+ *        in single precision instead of rounding to half precision after each
+ *        multiply-add. The results of the two differ beyond rounding of the output.
+*/
+bool MLASCALL
+MlasHalfGemmFloatAccumulation();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -1689,3 +2160,290 @@ MlasNhwcAvgPool(
     );
 
 #endif
+
+//
+// BFloat16 routines
+//
+
+// Any type with size=2 should work
+using MLAS_BF16 = onnxruntime::BFloat16;
+
+/**
+ * @brief Whether current CPU supports bfloat16 matrix multiply acceleration,
+ *        i.e. AVX512_BF16 or AMX-BF16 on x64. The bfloat16 GEMM routines
+ *        below work on all platforms, but emulate the bfloat16 arithmetic
+ *        in software otherwise.
+*/
+bool MLASCALL
+MlasBf16AccelerationSupported();
+
+/**
+ * @brief Data parameters for bfloat16 GEMM routine
+ *        C = alpha * A * B + beta * C
+ *        Inputs are rounded to bfloat16, the products are accumulated in
+ *        single precision. All except C are [in] parameters
+*/
+struct MLAS_BF16_GEMM_DATA_PARAMS {
+    const void* A = nullptr;     /**< address of A, fp32 or bf16 */
+    size_t lda = 0;              /**< leading dimension of A */
+    const void* B = nullptr;     /**< address of B, fp32, bf16 or the packed buffer */
+    size_t ldb = 0;              /**< leading dimension of B, 0 when B is pre-packed */
+    float* C = nullptr;          /**< address of result matrix */
+    size_t ldc = 0;              /**< leading dimension of C */
+    float alpha = 1.0f;          /**< scalar alpha multiplier */
+    float beta = 0.0f;           /**< scalar beta multiplier */
+    bool AIsfp32 = false;        /**< matrix A is fp32, needs to be rounded to bf16 */
+    bool BIsfp32 = false;        /**< matrix B is fp32, needs to be rounded to bf16 */
+};
+
+/**
+ * @brief BFloat16 Batched GEMM:  C = alpha * A * B + beta * C
+ *        Either A or B can be fp32 or bf16, B can be pre-packed by
+ *        MlasBf16GemmPackB or MlasBf16GemmConvertPackB.
+ *
+ * Note:  We only support uniform batching, so shapes and types of the
+ *        input must be same across all parameter blocks.
+ *
+ * @param[in]  M       row size of matrix A and C
+ * @param[in]  N       column size of matrix B and C
+ * @param[in]  K       column size of matrix A and row size of matrix B
+ * @param[in]  BatchN  number of batches
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  ThreadPool
+ * @return
+*/
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
+
+/**
+ * @brief For bfloat16 GEMM, returns size of the
+ *        packing buffer needed for right hand side
+ * @param[in] N   Number of columns
+ * @param[in] K   Number of rows
+ * @return  size of the packing buffer
+*/
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For bfloat16 GEMM, pack the right hand
+ *        side matrix B
+ *
+ * @param[in]  TransB   Whether B is transposed, i.e. stored as N x K
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[out] PackedB  Address of the packed matrix
+*/
+void
+MLASCALL
+MlasBf16GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief For bfloat16 GEMM, round the float matrix B
+ *        to bfloat16 and pack it into a packing buffer
+ *
+ * @param[in]  TransB   Whether B is transposed, i.e. stored as N x K
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[out] PackedB  Address of the packed matrix
+*/
+void
+MLASCALL
+MlasBf16GemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Block sparse single precision GEMM routines.
+//
+// The right hand side matrix B (K x N) is split into blocks of BlockK rows by
+// MLAS_SPARSE_SGEMM_BLOCK_N columns and packed in the block compressed sparse
+// row (BSR) format, keeping only the blocks that hold a nonzero element. The
+// multiplication skips the zero blocks.
+//
+
+constexpr size_t MLAS_SPARSE_SGEMM_BLOCK_N = 4;
+
+/**
+ * @brief Data parameters for block sparse SGEMM routine
+ *        C = alpha * A * B + beta * C
+ *        where B is packed by MlasSparseGemmPackB.
+ *        All except C are [in] parameters
+*/
+struct MLAS_SPARSE_SGEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< address of A, M x K row major */
+    size_t lda = 0;                 /**< leading dimension of A */
+    const void* PackedB = nullptr;  /**< address of B packed by MlasSparseGemmPackB */
+    float* C = nullptr;             /**< address of result matrix */
+    size_t ldc = 0;                 /**< leading dimension of C */
+    float alpha = 1.0f;             /**< scalar alpha multiplier */
+    float beta = 0.0f;              /**< scalar beta multiplier */
+};
+
+/**
+ * @brief Counts the BlockK x MLAS_SPARSE_SGEMM_BLOCK_N blocks of matrix B
+ *        that hold a nonzero element. Blocks at the right and bottom edges
+ *        are padded with zeros.
+ *
+ * @param[in]  TransB   Whether B is transposed, i.e. stored as N x K
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[in]  BlockK   Number of rows of a block
+ * @return  number of nonzero blocks
+*/
+size_t
+MLASCALL
+MlasSparseGemmCountNonZeroBlocks(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t BlockK
+    );
+
+/**
+ * @brief For block sparse SGEMM, returns size of the
+ *        packing buffer needed for right hand side
+ *
+ * @param[in] N                  Number of columns
+ * @param[in] K                  Number of rows
+ * @param[in] BlockK             Number of rows of a block
+ * @param[in] NonZeroBlockCount  Number of nonzero blocks returned by
+ *                               MlasSparseGemmCountNonZeroBlocks
+ * @return  size of the packing buffer
+*/
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockK,
+    size_t NonZeroBlockCount
+    );
+
+/**
+ * @brief For block sparse SGEMM, pack the nonzero blocks of
+ *        the right hand side matrix B
+ *
+ * @param[in]  TransB   Whether B is transposed, i.e. stored as N x K
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[in]  BlockK   Number of rows of a block
+ * @param[out] PackedB  Address of the packed matrix, of the size returned by
+ *                      MlasSparseGemmPackBSize
+*/
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t BlockK,
+    void* PackedB
+    );
+
+/**
+ * @brief For block sparse SGEMM, checks that a buffer holds a matrix B of
+ *        N x K packed by MlasSparseGemmPackB, i.e. that the packed header
+ *        matches, the size is consistent and every block offset and block row
+ *        index is in range. Used for packed buffers that were not produced by
+ *        MlasSparseGemmPackB in this process.
+ *
+ * @param[in]  N            Number of columns
+ * @param[in]  K            Number of rows
+ * @param[in]  PackedB      Address of the packed matrix
+ * @param[in]  PackedBSize  Size in bytes of the packed matrix
+ * @return  true if the packed matrix can be passed to MlasSparseGemmBatch
+*/
+bool
+MLASCALL
+MlasSparseGemmIsValidPackedB(
+    size_t N,
+    size_t K,
+    const void* PackedB,
+    size_t PackedBSize
+    );
+
+/**
+ * @brief Batched block sparse SGEMM:  C = alpha * A * B + beta * C
+ *
+ * @param[in]  M       row size of matrix A and C
+ * @param[in]  N       column size of matrix B and C
+ * @param[in]  K       column size of matrix A and row size of matrix B
+ * @param[in]  BatchN  number of batches
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  ThreadPool
+*/
+void
+MLASCALL
+MlasSparseGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
+
+//
+// Element type conversion routines
+//
+
+/**
+ * @brief Converts Count elements from SrcType to DstType. The supported
+ *        conversions are:
+ *            float <-> MLAS_FP16, rounding to nearest even
+ *            float <-> MLAS_BF16, rounding to nearest even, NaN stays NaN
+ *            float -> int8_t, uint8_t, int32_t, truncating toward zero and
+ *                saturating to the range of DstType, NaN converts to zero
+ *            int8_t, uint8_t, int32_t -> float
+ *
+ * @param Source       Address of the input elements
+ * @param Destination  Address of the output elements
+ * @param Count        Number of elements
+ * @param ThreadPool   Optional thread pool
+ */
+template <typename SrcType, typename DstType>
+void
+MLASCALL
+MlasCast(
+    const SrcType* Source,
+    DstType* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -510,6 +510,31 @@ Return Value:
             break;
         }
 
+        case MlasGeluErfActivation:
+        case MlasGeluTanhActivation:
+        case MlasQuickGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            const MLAS_GELU_KIND GeluKind =
+                (Activation->ActivationKind == MlasGeluErfActivation) ? MlasGeluErf :
+                (Activation->ActivationKind == MlasGeluTanhActivation) ? MlasGeluTanh : MlasGeluQuick;
+            const float Alpha = Activation->Parameters.QuickGelu.alpha;
+
+            if (N == ldc) {
+                MlasComputeGelu(GeluKind, Buffer, nullptr, 0, Buffer, M * N, Alpha);
+            } else {
+                while (M-- > 0) {
+                    MlasComputeGelu(GeluKind, Buffer, nullptr, 0, Buffer, N, Alpha);
+                    Buffer += ldc;
+                }
+            }
+
+            break;
+        }
+
         case MlasActivationKindCount:
         {
             MLAS_THROW_EX(std::runtime_error, "bad mlas activation kind");
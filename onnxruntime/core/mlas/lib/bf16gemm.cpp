@@ -0,0 +1,404 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply operation,
+    with bfloat16 inputs and single precision accumulation.
+
+    The portable kernel emulates the bfloat16 dot product instructions in
+    software, so that the operation can be used and validated on machines
+    without AVX512_BF16 or AMX.
+
+--*/
+
+#include "bf16gemm.h"
+
+bool
+MLASCALL
+MlasBf16AccelerationSupported()
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().Bf16GemmDispatch != &MlasBf16GemmDispatchDefault;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Pack a block of matrix B into panels of 16 columns, with pairs of
+ *        rows interleaved. See bf16gemm.h for the packing format.
+ *
+ * @param D        Address of the packing buffer
+ * @param B        Address of matrix B, fp32 or bf16
+ * @param ldb      Leading dimension of B
+ * @param CountN   # of columns to pack
+ * @param CountK   # of rows to pack
+ * @param PaddedK  # of rows of a packed panel, multiple of MLAS_BF16GEMM_PACKED_K
+ * @param TransB   Whether B is stored as N x K
+ */
+template<typename SrcType>
+void
+MlasBf16GemmCopyPackB(
+    uint16_t* D,
+    const SrcType* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    size_t PaddedK,
+    bool TransB
+    )
+{
+    for (size_t n = 0; n < CountN; n += MLAS_BF16GEMM_PANEL_N) {
+
+        const size_t ColumnCount = std::min(CountN - n, MLAS_BF16GEMM_PANEL_N);
+
+        for (size_t k = 0; k < PaddedK; k += 2) {
+            for (size_t c = 0; c < MLAS_BF16GEMM_PANEL_N; c++) {
+                for (size_t kk = 0; kk < 2; kk++) {
+
+                    uint16_t Value = 0;
+
+                    if (c < ColumnCount && k + kk < CountK) {
+                        const size_t Offset = TransB ? (n + c) * ldb + (k + kk) : (k + kk) * ldb + (n + c);
+                        if constexpr (std::is_same<SrcType, float>::value) {
+                            Value = MlasFp32ToBf16(B[Offset]);
+                        } else {
+                            Value = B[Offset];
+                        }
+                    }
+
+                    *D++ = Value;
+                }
+            }
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    const size_t PaddedN = MlasDivRoundup(N, MLAS_BF16GEMM_PANEL_N) * MLAS_BF16GEMM_PANEL_N;
+    const size_t PaddedK = MlasDivRoundup(K, MLAS_BF16GEMM_PACKED_K) * MLAS_BF16GEMM_PACKED_K;
+
+    const size_t BytesRequired = PaddedN * PaddedK * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired =
+        (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasBf16GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t PaddedK = MlasDivRoundup(K, MLAS_BF16GEMM_PACKED_K) * MLAS_BF16GEMM_PACKED_K;
+
+    MlasBf16GemmCopyPackB(reinterpret_cast<uint16_t*>(PackedB), reinterpret_cast<const uint16_t*>(B),
+                          ldb, N, K, PaddedK, TransB == CblasTrans);
+}
+
+void
+MLASCALL
+MlasBf16GemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t PaddedK = MlasDivRoundup(K, MLAS_BF16GEMM_PACKED_K) * MLAS_BF16GEMM_PACKED_K;
+
+    MlasBf16GemmCopyPackB(reinterpret_cast<uint16_t*>(PackedB), B, ldb, N, K, PaddedK, TransB == CblasTrans);
+}
+
+/**
+ * @brief Compute a tile of matrix C of a single GEMM operation.
+ */
+void
+MlasBf16GemmOperation(
+    const MLAS_BF16GEMM_DISPATCH* Dispatch,
+    const size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t StrideM = Dispatch->StrideM;
+    const size_t StrideN = Dispatch->StrideN;
+    const size_t StrideK = Dispatch->StrideK;
+
+    const size_t lda = Data->lda;
+    const size_t ldb = Data->ldb;
+    const size_t ldc = Data->ldc;
+    const float alpha = Data->alpha;
+    const float beta = Data->beta;
+
+    const bool BIsPacked = (ldb == 0);
+
+    const size_t PackedASize = UpAlignSize(StrideM * StrideK * sizeof(uint16_t));
+    const size_t PackedBSize = BIsPacked ? 0 : UpAlignSize(StrideN * StrideK * sizeof(uint16_t));
+
+    MlasThreadedBufAlloc(PackedASize + PackedBSize);
+    uint16_t* PanelA = reinterpret_cast<uint16_t*>(ThreadedBufHolder.get());
+    uint16_t* PanelB = reinterpret_cast<uint16_t*>(ThreadedBufHolder.get() + PackedASize);
+
+    float* C = Data->C + RangeStartM * ldc + RangeStartN;
+
+    //
+    // Apply beta to the output before the products are accumulated into it.
+    //
+
+    if (beta != 0.0f && beta != 1.0f) {
+        for (size_t m = 0; m < RangeCountM; m++) {
+            for (size_t n = 0; n < RangeCountN; n++) {
+                C[m * ldc + n] *= beta;
+            }
+        }
+    }
+
+    const size_t PaddedKTotal = MlasDivRoundup(K, MLAS_BF16GEMM_PACKED_K) * MLAS_BF16GEMM_PACKED_K;
+
+    size_t CountK;
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, StrideK);
+        const size_t PaddedK = MlasDivRoundup(CountK, MLAS_BF16GEMM_PACKED_K) * MLAS_BF16GEMM_PACKED_K;
+        const bool ZeroMode = (k == 0) && (beta == 0.0f);
+
+        size_t CountN;
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+            CountN = std::min(RangeCountN - n, StrideN);
+
+            const uint16_t* b;
+            size_t PanelStride;
+
+            if (BIsPacked) {
+                PanelStride = PaddedKTotal * MLAS_BF16GEMM_PANEL_N;
+                b = reinterpret_cast<const uint16_t*>(Data->B) +
+                    ((RangeStartN + n) / MLAS_BF16GEMM_PANEL_N) * PanelStride + k * MLAS_BF16GEMM_PANEL_N;
+            } else {
+                PanelStride = PaddedK * MLAS_BF16GEMM_PANEL_N;
+                if (Data->BIsfp32) {
+                    MlasBf16GemmCopyPackB(PanelB, reinterpret_cast<const float*>(Data->B) + k * ldb + RangeStartN + n,
+                                          ldb, CountN, CountK, PaddedK, false);
+                } else {
+                    MlasBf16GemmCopyPackB(PanelB, reinterpret_cast<const uint16_t*>(Data->B) + k * ldb + RangeStartN + n,
+                                          ldb, CountN, CountK, PaddedK, false);
+                }
+                b = PanelB;
+            }
+
+            size_t CountM;
+            for (size_t m = 0; m < RangeCountM; m += CountM) {
+
+                CountM = std::min(RangeCountM - m, StrideM);
+
+                //
+                // Convert the block of matrix A to bfloat16, with the rows
+                // padded with zeros to the depth of the packed B.
+                //
+
+                for (size_t mm = 0; mm < CountM; mm++) {
+                    uint16_t* a = PanelA + mm * PaddedK;
+                    const size_t Offset = (RangeStartM + m + mm) * lda + k;
+                    if (Data->AIsfp32) {
+                        Dispatch->ConvertKernel(reinterpret_cast<const float*>(Data->A) + Offset, a, CountK);
+                    } else {
+                        std::copy_n(reinterpret_cast<const uint16_t*>(Data->A) + Offset, CountK, a);
+                    }
+                    std::fill_n(a + CountK, PaddedK - CountK, uint16_t(0));
+                }
+
+                Dispatch->Kernel(PanelA, b, C + m * ldc + n, CountM, CountN, PaddedK,
+                                 PaddedK, PanelStride, ldc, alpha, ZeroMode);
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_BF16GEMM_DISPATCH* dispatch = MlasBf16GemmGetDispatch();
+
+    if (K == 0) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            auto Data = &DataParams[gemm_i];
+            for (size_t m = 0; m < M; m++) {
+                for (size_t n = 0; n < N; n++) {
+                    float& c = Data->C[m * Data->ldc + n];
+                    c = (Data->beta == 0.0f) ? 0.0f : c * Data->beta;
+                }
+            }
+        }
+        return;
+    }
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            auto Data = &DataParams[gemm_i];
+            MlasBf16GemmOperation(dispatch, K, Data, 0, M, 0, N);
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the SGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    //
+    // Segment each operation into tiles of the output matrix using the cache
+    // aware partitioner, keeping the rows of a tile a multiple of the kernel
+    // stride. The N dimension is split on panel boundaries, so that a thread
+    // starts at the beginning of a panel of the packed B.
+    //
+
+    MLAS_GEMM_THREAD_PARTITION Partition;
+
+    MlasGemmPartitionThreads(M, N, K, dispatch->StrideM, MLAS_QGEMM_STRIDEN_THREAD_ALIGN,
+        sizeof(uint16_t), sizeof(uint16_t), ThreadsPerGemm, 0, &Partition);
+
+    ThreadsPerGemm = Partition.ThreadCount();
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+        auto Data = &DataParams[gemm_i];
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+        size_t RangeStartN;
+        size_t RangeCountN;
+        size_t RangeStartK;
+        size_t RangeCountK;
+
+        MlasGemmPartitionRange(Partition, blk_i, M, N, K, &RangeStartM, &RangeCountM,
+            &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
+
+        MlasBf16GemmOperation(dispatch, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
+
+//
+// Portable kernel, which emulates the VDPBF16PS instruction: the products of
+// the bfloat16 values are exact in single precision, and are accumulated a
+// pair of K at a time.
+//
+// N.B. GCC 12 at -O3 miscompiles this loop when the odd element of the pair
+// is accumulated first.
+//
+
+void
+MlasBf16GemmKernelDefault(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    for (size_t n = 0; n < CountN; n += MLAS_BF16GEMM_PANEL_N) {
+
+        const size_t ColumnCount = std::min(CountN - n, MLAS_BF16GEMM_PANEL_N);
+        const uint16_t* Panel = B + (n / MLAS_BF16GEMM_PANEL_N) * PanelStride;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            float Accumulators[MLAS_BF16GEMM_PANEL_N] = {};
+            const uint16_t* a = A + m * lda;
+
+            for (size_t k = 0; k < CountK; k += 2) {
+
+                const float a0 = MlasBf16ToFp32(a[k]);
+                const float a1 = MlasBf16ToFp32(a[k + 1]);
+                const uint16_t* b = Panel + k * MLAS_BF16GEMM_PANEL_N;
+
+                for (size_t c = 0; c < MLAS_BF16GEMM_PANEL_N; c++) {
+                    Accumulators[c] += a0 * MlasBf16ToFp32(b[c * 2]);
+                    Accumulators[c] += a1 * MlasBf16ToFp32(b[c * 2 + 1]);
+                }
+            }
+
+            float* c = C + m * ldc + n;
+
+            for (size_t cc = 0; cc < ColumnCount; cc++) {
+                const float Value = Accumulators[cc] * alpha;
+                c[cc] = ZeroMode ? Value : c[cc] + Value;
+            }
+        }
+    }
+}
+
+void
+MlasBf16ConvertKernelDefault(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFp32ToBf16(Source[i]);
+    }
+}
+
+const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchDefault = {
+    MlasBf16GemmKernelDefault,
+    MlasBf16ConvertKernelDefault,
+    16,
+    128,
+    256,
+};
@@ -0,0 +1,119 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.h
+
+Abstract:
+
+    This module defines the kernel interface and the packing format of the
+    bfloat16 matrix/matrix multiply operation.
+
+    Matrix B is packed into panels of 16 columns. Within a panel, each pair
+    of consecutive rows of B is interleaved, so that the two bfloat16 values
+    of a column can be multiplied with a pair of values of A by a single dot
+    product instruction (VDPBF16PS and TDPBF16PS):
+
+        Panel[k / 2][n][k % 2] = B[k][n]
+
+    The K dimension is padded with zeros to a multiple of 32 values, the
+    depth of an AMX tile, and the N dimension is padded with zeros to a
+    multiple of 16 columns.
+
+    A kernel computes a block of matrix C from a block of matrix A, which
+    the driver converts to bfloat16 with rows padded to the same depth, and
+    a block of packed matrix B.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <cstring>
+
+//
+// Packing granularity of the K and the N dimensions.
+//
+
+constexpr size_t MLAS_BF16GEMM_PACKED_K = 32;
+constexpr size_t MLAS_BF16GEMM_PANEL_N = 16;
+
+/**
+ * @brief Compute a block of matrix C:
+ *            C = alpha * A * B + (ZeroMode ? 0 : C)
+ *
+ * @param A            Address of the bfloat16 matrix A
+ * @param B            Address of the first panel of packed matrix B
+ * @param C            Address of matrix C
+ * @param CountM       # of rows of A and C
+ * @param CountN       # of columns of B and C
+ * @param CountK       # of columns of A and rows of B, multiple of
+ *                     MLAS_BF16GEMM_PACKED_K
+ * @param lda          Leading dimension of A
+ * @param PanelStride  # of elements between two panels of packed B
+ * @param ldc          Leading dimension of C
+ * @param alpha        Scalar multiplier of A * B
+ * @param ZeroMode     Whether to overwrite C instead of accumulating
+ */
+typedef
+void
+(MLAS_BF16GEMM_KERNEL)(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    );
+
+/**
+ * @brief Round a vector of single precision values to bfloat16.
+ */
+typedef
+void
+(MLAS_BF16GEMM_CONVERT_KERNEL)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+struct MLAS_BF16GEMM_DISPATCH {
+    MLAS_BF16GEMM_KERNEL* Kernel;
+    MLAS_BF16GEMM_CONVERT_KERNEL* ConvertKernel;
+    size_t StrideM;
+    size_t StrideN;
+    size_t StrideK;
+};
+
+#if defined(MLAS_TARGET_AMD64) && defined(MLAS_AMX_SUPPORTED)
+
+//
+// The AMX kernel processes tails of less than 16 rows with the AVX512_BF16
+// kernel.
+//
+
+MLAS_BF16GEMM_KERNEL MlasBf16GemmKernelAvx512Bf16;
+MLAS_BF16GEMM_CONVERT_KERNEL MlasBf16ConvertKernelAvx512Bf16;
+
+#endif
+
+MLAS_FORCEINLINE
+const MLAS_BF16GEMM_DISPATCH*
+MlasBf16GemmGetDispatch()
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().Bf16GemmDispatch;
+#else
+    return &MlasBf16GemmDispatchDefault;
+#endif
+}
@@ -0,0 +1,229 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel using
+    the AMX-BF16 tile instruction TDPBF16PS.
+
+    The packed B is laid out so that 32 rows of a panel of 16 columns form
+    a 16x64 byte B tile, and the rows of A converted by the driver form the
+    16x64 byte A tiles. Blocks of less than 16 rows are processed by the
+    AVX512_BF16 kernel.
+
+--*/
+
+#include "bf16gemm.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+constexpr size_t MLAS_BF16GEMM_AMX_TILE_M = 16;
+
+// Tile configure structure
+struct MLAS_BF16GEMM_AMX_TILECONFIG {
+    uint8_t palette_id = 0;
+    uint8_t start_row = 0;
+    uint8_t reserved1[14] = {0};
+    uint16_t colb[8] = {0};
+    uint8_t reserved2[16] = {0};
+    uint8_t rows[8] = {0};
+    uint8_t reserved3[8] = {0};
+};
+
+/**
+ * @brief Configure all the tiles as 16 rows of 64 bytes, the same
+ *        configuration used by the int8 AMX kernel.
+ */
+MLAS_FORCEINLINE
+void
+MlasBf16GemmAmxThreadInit()
+{
+    static thread_local MLAS_BF16GEMM_AMX_TILECONFIG tc;
+    MLAS_BF16GEMM_AMX_TILECONFIG current_tc;
+    _tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc.colb, &tc.colb, sizeof(tc.colb)) != 0 ||
+        std::memcmp(&current_tc.rows, &tc.rows, sizeof(tc.rows)) != 0) {
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = 16;
+            tc.colb[t] = 64;
+        }
+        _tile_loadconfig(&tc);
+    }
+}
+
+/**
+ * @brief Apply alpha to an accumulator tile spilled to memory and store
+ *        the valid columns to matrix C.
+ */
+MLAS_FORCEINLINE
+void
+MlasBf16GemmTileMove(
+    const float* Tile,
+    float* C,
+    size_t CountM,
+    __mmask16 Mask,
+    size_t ldc,
+    __m512 Alpha,
+    bool ZeroMode
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+        __m512 Result = _mm512_mul_ps(_mm512_loadu_ps(Tile + m * MLAS_BF16GEMM_PANEL_N), Alpha);
+        if (!ZeroMode) {
+            Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, C + m * ldc));
+        }
+        _mm512_mask_storeu_ps(C + m * ldc, Mask, Result);
+    }
+}
+
+void
+MlasBf16GemmKernelAmx(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    MlasBf16GemmAmxThreadInit();
+
+    const __m512 Alpha = _mm512_set1_ps(alpha);
+    const int StrideA = static_cast<int>(lda * sizeof(uint16_t));
+    const int StrideC = static_cast<int>(ldc * sizeof(float));
+    constexpr int StrideB = static_cast<int>(MLAS_BF16GEMM_PANEL_N * 2 * sizeof(uint16_t));
+    constexpr int StrideTile = static_cast<int>(MLAS_BF16GEMM_PANEL_N * sizeof(float));
+
+    MLAS_DECLSPEC_ALIGN(float Tile[4][MLAS_BF16GEMM_AMX_TILE_M * MLAS_BF16GEMM_PANEL_N], 64);
+
+    //
+    // All 8 tile registers are utilized in the main block. Tiles 4 - 7 are
+    // the accumulators of a 32x32 block of C, tiles 2, 3 load 32 rows of A
+    // and tiles 0, 1 load two panels of B:
+    //
+    //        B T0  B T1
+    //  A T2    T4    T6
+    //  A T3    T5    T7
+    //
+
+    while (CountM >= MLAS_BF16GEMM_AMX_TILE_M) {
+
+        const bool TwoRowTiles = (CountM >= 2 * MLAS_BF16GEMM_AMX_TILE_M);
+        const uint16_t* a0 = A;
+        const uint16_t* a1 = A + MLAS_BF16GEMM_AMX_TILE_M * lda;
+
+        for (size_t n = 0; n < CountN; n += 2 * MLAS_BF16GEMM_PANEL_N) {
+
+            const size_t ColumnCount = std::min(CountN - n, 2 * MLAS_BF16GEMM_PANEL_N);
+            const bool TwoColumnTiles = (ColumnCount > MLAS_BF16GEMM_PANEL_N);
+            const __mmask16 Mask0 = __mmask16((1u << std::min(ColumnCount, MLAS_BF16GEMM_PANEL_N)) - 1);
+            const __mmask16 Mask1 = TwoColumnTiles ? __mmask16((1u << (ColumnCount - MLAS_BF16GEMM_PANEL_N)) - 1) : 0;
+
+            //
+            // Full tiles without scaling are accumulated directly into C.
+            //
+
+            const bool Direct = (alpha == 1.0f) && (ColumnCount == 2 * MLAS_BF16GEMM_PANEL_N);
+
+            float* c0 = C + n;
+            float* c1 = C + MLAS_BF16GEMM_AMX_TILE_M * ldc + n;
+
+            if (Direct && !ZeroMode) {
+                _tile_loadd(TMM4, c0, StrideC);
+                _tile_loadd(TMM6, c0 + MLAS_BF16GEMM_PANEL_N, StrideC);
+                if (TwoRowTiles) {
+                    _tile_loadd(TMM5, c1, StrideC);
+                    _tile_loadd(TMM7, c1 + MLAS_BF16GEMM_PANEL_N, StrideC);
+                }
+            } else {
+                _tile_zero(TMM4);
+                _tile_zero(TMM6);
+                _tile_zero(TMM5);
+                _tile_zero(TMM7);
+            }
+
+            const uint16_t* b0 = B + (n / MLAS_BF16GEMM_PANEL_N) * PanelStride;
+            const uint16_t* b1 = b0 + PanelStride;
+
+            for (size_t k = 0; k < CountK; k += MLAS_BF16GEMM_PACKED_K) {
+                _tile_loadd(TMM0, b0 + k * MLAS_BF16GEMM_PANEL_N, StrideB);
+                _tile_loadd(TMM2, a0 + k, StrideA);
+                _tile_dpbf16ps(TMM4, TMM2, TMM0);
+                if (TwoColumnTiles) {
+                    _tile_loadd(TMM1, b1 + k * MLAS_BF16GEMM_PANEL_N, StrideB);
+                    _tile_dpbf16ps(TMM6, TMM2, TMM1);
+                }
+                if (TwoRowTiles) {
+                    _tile_loadd(TMM3, a1 + k, StrideA);
+                    _tile_dpbf16ps(TMM5, TMM3, TMM0);
+                    if (TwoColumnTiles) {
+                        _tile_dpbf16ps(TMM7, TMM3, TMM1);
+                    }
+                }
+            }
+
+            if (Direct) {
+                _tile_stored(TMM4, c0, StrideC);
+                _tile_stored(TMM6, c0 + MLAS_BF16GEMM_PANEL_N, StrideC);
+                if (TwoRowTiles) {
+                    _tile_stored(TMM5, c1, StrideC);
+                    _tile_stored(TMM7, c1 + MLAS_BF16GEMM_PANEL_N, StrideC);
+                }
+                continue;
+            }
+
+            _tile_stored(TMM4, Tile[0], StrideTile);
+            MlasBf16GemmTileMove(Tile[0], c0, MLAS_BF16GEMM_AMX_TILE_M, Mask0, ldc, Alpha, ZeroMode);
+            if (TwoColumnTiles) {
+                _tile_stored(TMM6, Tile[1], StrideTile);
+                MlasBf16GemmTileMove(Tile[1], c0 + MLAS_BF16GEMM_PANEL_N, MLAS_BF16GEMM_AMX_TILE_M, Mask1, ldc, Alpha, ZeroMode);
+            }
+            if (TwoRowTiles) {
+                _tile_stored(TMM5, Tile[2], StrideTile);
+                MlasBf16GemmTileMove(Tile[2], c1, MLAS_BF16GEMM_AMX_TILE_M, Mask0, ldc, Alpha, ZeroMode);
+                if (TwoColumnTiles) {
+                    _tile_stored(TMM7, Tile[3], StrideTile);
+                    MlasBf16GemmTileMove(Tile[3], c1 + MLAS_BF16GEMM_PANEL_N, MLAS_BF16GEMM_AMX_TILE_M, Mask1, ldc, Alpha, ZeroMode);
+                }
+            }
+        }
+
+        const size_t RowsHandled = TwoRowTiles ? 2 * MLAS_BF16GEMM_AMX_TILE_M : MLAS_BF16GEMM_AMX_TILE_M;
+        A += RowsHandled * lda;
+        C += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+
+    if (CountM > 0) {
+        MlasBf16GemmKernelAvx512Bf16(A, B, C, CountM, CountN, CountK, lda, PanelStride, ldc, alpha, ZeroMode);
+    }
+}
+
+const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchAmx = {
+    MlasBf16GemmKernelAmx,
+    MlasBf16ConvertKernelAvx512Bf16,
+    128,
+    256,
+    512,
+};
@@ -0,0 +1,227 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel using
+    the AVX512_BF16 dot product instruction VDPBF16PS.
+
+    A pair of values of a row of A is broadcast to all the lanes and
+    multiplied with the interleaved pairs of 16 columns of packed B, so a
+    single instruction accumulates two steps of K for 16 columns of C.
+
+--*/
+
+#include "bf16gemm.h"
+
+constexpr size_t MLAS_BF16GEMM_AVX512BF16_MAX_ROWS = 4;
+constexpr size_t MLAS_BF16GEMM_AVX512BF16_MAX_PANELS = 4;
+
+MLAS_FORCEINLINE
+__m512bh
+MlasCastToBf16x32Avx512(
+    __m512i Vector
+    )
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    return *reinterpret_cast<__m512bh*>(&Vector);
+#else
+    return (__m512bh)Vector;
+#endif
+}
+
+/**
+ * @brief Compute RowCount rows by PanelCount panels of 16 columns of C.
+ *
+ * @tparam RowCount    # of rows of A, 1 to MLAS_BF16GEMM_AVX512BF16_MAX_ROWS
+ * @tparam PanelCount  # of panels of B, 1 to MLAS_BF16GEMM_AVX512BF16_MAX_PANELS
+ * @param LastMask     Mask of the valid columns of the last panel
+ */
+template<size_t RowCount, size_t PanelCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmBlockAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    __m512 Alpha,
+    bool ZeroMode,
+    __mmask16 LastMask
+    )
+{
+    __m512 Accumulators[RowCount][PanelCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            Accumulators[r][p] = _mm512_setzero_ps();
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k += 2) {
+
+        __m512bh BElements[PanelCount];
+        for (size_t p = 0; p < PanelCount; p++) {
+            BElements[p] = MlasCastToBf16x32Avx512(
+                _mm512_loadu_si512(B + p * PanelStride + k * MLAS_BF16GEMM_PANEL_N));
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            int32_t Pair;
+            std::memcpy(&Pair, A + r * lda + k, sizeof(Pair));
+            const __m512bh AElements = MlasCastToBf16x32Avx512(_mm512_set1_epi32(Pair));
+            for (size_t p = 0; p < PanelCount; p++) {
+                Accumulators[r][p] = _mm512_dpbf16_ps(Accumulators[r][p], AElements, BElements[p]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t p = 0; p < PanelCount; p++) {
+            const __mmask16 Mask = (p == PanelCount - 1) ? LastMask : __mmask16(0xFFFF);
+            float* c = C + r * ldc + p * MLAS_BF16GEMM_PANEL_N;
+            __m512 Result = _mm512_mul_ps(Accumulators[r][p], Alpha);
+            if (!ZeroMode) {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+            }
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmRowsAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    __m512 Alpha,
+    bool ZeroMode
+    )
+{
+    constexpr size_t BlockN = MLAS_BF16GEMM_AVX512BF16_MAX_PANELS * MLAS_BF16GEMM_PANEL_N;
+
+    while (CountN >= BlockN) {
+        MlasBf16GemmBlockAvx512Bf16<RowCount, MLAS_BF16GEMM_AVX512BF16_MAX_PANELS>(
+            A, B, C, CountK, lda, PanelStride, ldc, Alpha, ZeroMode, __mmask16(0xFFFF));
+        B += MLAS_BF16GEMM_AVX512BF16_MAX_PANELS * PanelStride;
+        C += BlockN;
+        CountN -= BlockN;
+    }
+
+    if (CountN > 0) {
+
+        const size_t PanelCount = MlasDivRoundup(CountN, MLAS_BF16GEMM_PANEL_N);
+        const size_t LastCount = CountN - (PanelCount - 1) * MLAS_BF16GEMM_PANEL_N;
+        const __mmask16 LastMask = __mmask16((1u << LastCount) - 1);
+
+        switch (PanelCount) {
+            case 1:
+                MlasBf16GemmBlockAvx512Bf16<RowCount, 1>(A, B, C, CountK, lda, PanelStride, ldc, Alpha, ZeroMode, LastMask);
+                break;
+            case 2:
+                MlasBf16GemmBlockAvx512Bf16<RowCount, 2>(A, B, C, CountK, lda, PanelStride, ldc, Alpha, ZeroMode, LastMask);
+                break;
+            case 3:
+                MlasBf16GemmBlockAvx512Bf16<RowCount, 3>(A, B, C, CountK, lda, PanelStride, ldc, Alpha, ZeroMode, LastMask);
+                break;
+            default:
+                MlasBf16GemmBlockAvx512Bf16<RowCount, 4>(A, B, C, CountK, lda, PanelStride, ldc, Alpha, ZeroMode, LastMask);
+                break;
+        }
+    }
+}
+
+void
+MlasBf16GemmKernelAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t PanelStride,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+    )
+{
+    const __m512 Alpha = _mm512_set1_ps(alpha);
+
+    while (CountM > 0) {
+
+        size_t RowsHandled;
+
+        switch (std::min(CountM, MLAS_BF16GEMM_AVX512BF16_MAX_ROWS)) {
+            case 1:
+                MlasBf16GemmRowsAvx512Bf16<1>(A, B, C, CountN, CountK, lda, PanelStride, ldc, Alpha, ZeroMode);
+                RowsHandled = 1;
+                break;
+            case 2:
+                MlasBf16GemmRowsAvx512Bf16<2>(A, B, C, CountN, CountK, lda, PanelStride, ldc, Alpha, ZeroMode);
+                RowsHandled = 2;
+                break;
+            case 3:
+                MlasBf16GemmRowsAvx512Bf16<3>(A, B, C, CountN, CountK, lda, PanelStride, ldc, Alpha, ZeroMode);
+                RowsHandled = 3;
+                break;
+            default:
+                MlasBf16GemmRowsAvx512Bf16<4>(A, B, C, CountN, CountK, lda, PanelStride, ldc, Alpha, ZeroMode);
+                RowsHandled = 4;
+                break;
+        }
+
+        A += RowsHandled * lda;
+        C += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+}
+
+void
+MlasBf16ConvertKernelAvx512Bf16(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        const __m256bh Values = _mm512_cvtneps_pbh(_mm512_loadu_ps(Source));
+        std::memcpy(Destination, &Values, sizeof(Values));
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+        const __mmask16 Mask = __mmask16((1u << Count) - 1);
+        const __m256bh Values = _mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(Mask, Source));
+        __m256i Bits;
+        std::memcpy(&Bits, &Values, sizeof(Bits));
+        _mm256_mask_storeu_epi16(Destination, Mask, Bits);
+    }
+}
+
+const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16 = {
+    MlasBf16GemmKernelAvx512Bf16,
+    MlasBf16ConvertKernelAvx512Bf16,
+    64,
+    256,
+    256,
+};
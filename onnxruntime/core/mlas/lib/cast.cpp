@@ -0,0 +1,506 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the element type conversions between single
+    precision, half precision, bfloat16 and integer values.
+
+    Conversions from single precision to integers truncate toward zero and
+    saturate to the range of the integer type. A NaN converts to zero.
+
+--*/
+
+#include "mlasi.h"
+
+#include <limits>
+
+//
+// Minimum number of elements to convert per thread.
+//
+
+constexpr size_t MLAS_CAST_MINIMUM_ELEMENTS_PER_THREAD = 65536;
+
+template<typename T>
+MLAS_FORCEINLINE
+T
+MlasCastFloatToIntSaturate(
+    float Value
+    )
+{
+    constexpr T MinimumValue = std::numeric_limits<T>::lowest();
+    constexpr T MaximumValue = std::numeric_limits<T>::max();
+
+    //
+    // The maximum of int32_t is not exactly representable, so the comparison
+    // is against 2^31.
+    //
+
+    if (Value != Value) {
+        return 0;
+    }
+    if (Value <= float(MinimumValue)) {
+        return MinimumValue;
+    }
+    if (Value >= float(MaximumValue)) {
+        return MaximumValue;
+    }
+    return T(Value);
+}
+
+void
+MLASCALL
+MlasCastF16ToF32Kernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+#if defined(MLAS_NEON64_INTRINSICS) && ((!defined(_MSC_VER)) || (_MSC_VER >= 1930))
+
+    for (; n + 4 <= N; n += 4) {
+        vst1q_f32(Destination + n, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(Source + n))));
+    }
+
+#endif
+
+    for (; n < N; n++) {
+        Destination[n] = MLAS_Half2Float(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+#if defined(MLAS_NEON64_INTRINSICS) && ((!defined(_MSC_VER)) || (_MSC_VER >= 1930))
+
+    for (; n + 4 <= N; n += 4) {
+        vst1_u16(Destination + n, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(Source + n))));
+    }
+
+#endif
+
+    for (; n < N; n++) {
+        Destination[n] = MLAS_Float2Half(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastBf16ToF32Kernel(
+    const uint16_t* Source,
+    float* Destination,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasBf16ToFp32(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToBf16Kernel(
+    const float* Source,
+    uint16_t* Destination,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasFp32ToBf16(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToS32Kernel(
+    const float* Source,
+    int32_t* Destination,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasCastFloatToIntSaturate<int32_t>(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToS8Kernel(
+    const float* Source,
+    int8_t* Destination,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasCastFloatToIntSaturate<int8_t>(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToU8Kernel(
+    const float* Source,
+    uint8_t* Destination,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = MlasCastFloatToIntSaturate<uint8_t>(Source[n]);
+    }
+}
+
+//
+// Converts the block of N elements at index Start with the kernel for the
+// element types. The 16-bit types are converted through their bits, so the
+// pointer arithmetic is done after the cast.
+//
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    const uint16_t* Input = reinterpret_cast<const uint16_t*>(Source) + Start;
+
+    Destination += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF16ToF32Kernel(Input, Destination, N);
+#else
+    MlasCastF16ToF32Kernel(Input, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    uint16_t* Output = reinterpret_cast<uint16_t*>(Destination) + Start;
+
+    Source += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToF16Kernel(Source, Output, N);
+#else
+    MlasCastF32ToF16Kernel(Source, Output, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const MLAS_BF16* Source,
+    float* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    const uint16_t* Input = reinterpret_cast<const uint16_t*>(Source) + Start;
+
+    Destination += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastBf16ToF32Kernel(Input, Destination, N);
+#else
+    MlasCastBf16ToF32Kernel(Input, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const float* Source,
+    MLAS_BF16* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    uint16_t* Output = reinterpret_cast<uint16_t*>(Destination) + Start;
+
+    Source += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToBf16Kernel(Source, Output, N);
+#else
+    MlasCastF32ToBf16Kernel(Source, Output, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const float* Source,
+    int32_t* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    Source += Start;
+    Destination += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToS32Kernel(Source, Destination, N);
+#else
+    MlasCastF32ToS32Kernel(Source, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const float* Source,
+    int8_t* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    Source += Start;
+    Destination += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToS8Kernel(Source, Destination, N);
+#else
+    MlasCastF32ToS8Kernel(Source, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const float* Source,
+    uint8_t* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    Source += Start;
+    Destination += Start;
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().CastF32ToU8Kernel(Source, Destination, N);
+#else
+    MlasCastF32ToU8Kernel(Source, Destination, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const int32_t* Source,
+    float* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    Source += Start;
+    Destination += Start;
+
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        MlasStoreFloat32x4(Destination + n, MlasCastToFloat32x4(MlasLoadInt32x4(Source + n)));
+    }
+
+    for (; n < N; n++) {
+        Destination[n] = float(Source[n]);
+    }
+}
+
+template<typename SrcType>
+MLAS_FORCEINLINE
+void
+MlasCastBlock(
+    const SrcType* Source,
+    float* Destination,
+    size_t Start,
+    size_t N
+    )
+{
+    Source += Start;
+    Destination += Start;
+
+    //
+    // The 8-bit integer conversions are left to the compiler.
+    //
+
+    for (size_t n = 0; n < N; n++) {
+        Destination[n] = float(Source[n]);
+    }
+}
+
+template<typename SrcType, typename DstType>
+void
+MLASCALL
+MlasCast(
+    const SrcType* Source,
+    DstType* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of elements between element types.
+
+Arguments:
+
+    Source - Supplies the input elements.
+
+    Destination - Supplies the output elements.
+
+    Count - Supplies the number of elements to convert.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (Count / MLAS_CAST_MINIMUM_ELEMENTS_PER_THREAD) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t Start;
+        size_t CountN;
+
+        MlasPartitionWork(tid, ThreadCount, Count, &Start, &CountN);
+
+        MlasCastBlock(Source, Destination, Start, CountN);
+    });
+}
+
+template
+void
+MLASCALL
+MlasCast<float, MLAS_FP16>(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<MLAS_FP16, float>(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<float, MLAS_BF16>(
+    const float* Source,
+    MLAS_BF16* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<MLAS_BF16, float>(
+    const MLAS_BF16* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<float, int32_t>(
+    const float* Source,
+    int32_t* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<float, int8_t>(
+    const float* Source,
+    int8_t* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<float, uint8_t>(
+    const float* Source,
+    uint8_t* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<int32_t, float>(
+    const int32_t* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<int8_t, float>(
+    const int8_t* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasCast<uint8_t, float>(
+    const uint8_t* Source,
+    float* Destination,
+    size_t Count,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -0,0 +1,804 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convnhwc.cpp
+
+Abstract:
+
+    This module implements the single precision convolution operation for
+    tensors in the channels last (NHWC) format.
+
+    Pointwise convolutions with unit strides and no padding multiply the input
+    tensor directly by the packed filter. Other convolutions expand a block of
+    output pixels to a matrix of [KernelSize][InputChannels] rows and then
+    multiply by the packed filter. Depthwise convolutions are computed
+    directly, vectorized across the channels.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements of the expanded input per thread that should stay in the
+// cache.
+//
+
+constexpr size_t MLAS_CONV_NHWC_EXPAND_BUFFER_ELEMENTS = 32 * 1024;
+
+//
+// Range of the number of output pixels computed by each work item.
+//
+
+constexpr size_t MLAS_CONV_NHWC_MINIMUM_BLOCK_SIZE = 16;
+constexpr size_t MLAS_CONV_NHWC_MAXIMUM_BLOCK_SIZE = 256;
+
+//
+// Stores the convolution shapes promoted to three dimensions.
+//
+
+struct MLAS_CONV_NHWC_SHAPE {
+    size_t InputShape[3];
+    size_t OutputShape[3];
+    size_t KernelShape[3];
+    size_t DilationShape[3];
+    size_t Padding[3];
+    size_t StrideShape[3];
+};
+
+void
+MlasConvNhwcGetShape(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_NHWC_SHAPE* Shape
+    )
+{
+    const size_t Dimensions = Parameters->Dimensions;
+    const size_t Offset = 3 - Dimensions;
+
+    for (size_t dim = 0; dim < Offset; dim++) {
+        Shape->InputShape[dim] = 1;
+        Shape->OutputShape[dim] = 1;
+        Shape->KernelShape[dim] = 1;
+        Shape->DilationShape[dim] = 1;
+        Shape->Padding[dim] = 0;
+        Shape->StrideShape[dim] = 1;
+    }
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        Shape->InputShape[dim + Offset] = Parameters->InputShape[dim];
+        Shape->OutputShape[dim + Offset] = Parameters->OutputShape[dim];
+        Shape->KernelShape[dim + Offset] = Parameters->KernelShape[dim];
+        Shape->DilationShape[dim + Offset] = Parameters->DilationShape[dim];
+        Shape->Padding[dim + Offset] = Parameters->Padding[dim];
+        Shape->StrideShape[dim + Offset] = Parameters->StrideShape[dim];
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvNhwcKernelRange(
+    size_t OutputIndex,
+    size_t InputSize,
+    size_t KernelSize,
+    size_t Dilation,
+    size_t Padding,
+    size_t Stride,
+    size_t* KernelStart,
+    size_t* KernelEnd
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of kernel positions of one dimension that
+    map to elements inside the input tensor for an output index.
+
+--*/
+{
+    const ptrdiff_t Origin = ptrdiff_t(OutputIndex * Stride) - ptrdiff_t(Padding);
+    const ptrdiff_t Step = ptrdiff_t(Dilation);
+
+    ptrdiff_t Start = 0;
+    ptrdiff_t End = 0;
+
+    if (Origin < 0) {
+        Start = (-Origin + Step - 1) / Step;
+    }
+
+    if (ptrdiff_t(InputSize) > Origin) {
+        End = (ptrdiff_t(InputSize) - Origin + Step - 1) / Step;
+    }
+
+    End = std::min(End, ptrdiff_t(KernelSize));
+
+    *KernelStart = size_t(Start);
+    *KernelEnd = size_t(std::max(Start, End));
+}
+
+void
+MlasConvNhwcExpandBlock(
+    const MLAS_CONV_NHWC_SHAPE& Shape,
+    size_t InputChannels,
+    size_t InputStride,
+    const float* Input,
+    float* ExpandedInput,
+    size_t PixelStart,
+    size_t PixelCount
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a block of output pixels to rows of the input
+    elements covered by the kernel, ordered as [KernelSize][InputChannels].
+    Kernel positions outside the input tensor are zero filled.
+
+Arguments:
+
+    Shape - Supplies the convolution shapes promoted to three dimensions.
+
+    InputChannels - Supplies the number of input channels of the group.
+
+    InputStride - Supplies the number of channels of each input pixel.
+
+    Input - Supplies the first channel of the group of the input image.
+
+    ExpandedInput - Supplies the buffer to receive the expanded rows.
+
+    PixelStart - Supplies the index of the first output pixel.
+
+    PixelCount - Supplies the number of output pixels to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputHeight = Shape.OutputShape[1];
+    const size_t OutputWidth = Shape.OutputShape[2];
+    const size_t KernelWidth = Shape.KernelShape[2];
+    const size_t DilationWidth = Shape.DilationShape[2];
+
+    //
+    // The kernel positions along the width are contiguous in the input when
+    // the image has a single group and no dilation.
+    //
+
+    const bool ContiguousRow = (InputStride == InputChannels && DilationWidth == 1);
+
+    for (size_t p = PixelStart; p < PixelStart + PixelCount; p++) {
+
+        const size_t od = p / (OutputHeight * OutputWidth);
+        const size_t oh = (p / OutputWidth) % OutputHeight;
+        const size_t ow = p % OutputWidth;
+
+        size_t KernelStart;
+        size_t KernelEnd;
+
+        MlasConvNhwcKernelRange(ow, Shape.InputShape[2], KernelWidth, DilationWidth, Shape.Padding[2],
+            Shape.StrideShape[2], &KernelStart, &KernelEnd);
+
+        const size_t iw = ow * Shape.StrideShape[2] + KernelStart * DilationWidth - Shape.Padding[2];
+
+        for (size_t kd = 0; kd < Shape.KernelShape[0]; kd++) {
+
+            const size_t id = od * Shape.StrideShape[0] + kd * Shape.DilationShape[0] - Shape.Padding[0];
+
+            for (size_t kh = 0; kh < Shape.KernelShape[1]; kh++) {
+
+                const size_t ih = oh * Shape.StrideShape[1] + kh * Shape.DilationShape[1] - Shape.Padding[1];
+
+                //
+                // Rely on unsigned wraparound to detect padding on either
+                // side of each dimension.
+                //
+
+                if (id >= Shape.InputShape[0] || ih >= Shape.InputShape[1] || KernelStart == KernelEnd) {
+                    std::fill_n(ExpandedInput, KernelWidth * InputChannels, 0.0f);
+                    ExpandedInput += KernelWidth * InputChannels;
+                    continue;
+                }
+
+                std::fill_n(ExpandedInput, KernelStart * InputChannels, 0.0f);
+                ExpandedInput += KernelStart * InputChannels;
+
+                const float* input = Input + ((id * Shape.InputShape[1] + ih) * Shape.InputShape[2] + iw) * InputStride;
+
+                if (ContiguousRow) {
+                    std::copy_n(input, (KernelEnd - KernelStart) * InputChannels, ExpandedInput);
+                    ExpandedInput += (KernelEnd - KernelStart) * InputChannels;
+                } else {
+                    for (size_t kw = KernelStart; kw < KernelEnd; kw++) {
+                        std::copy_n(input, InputChannels, ExpandedInput);
+                        ExpandedInput += InputChannels;
+                        input += DilationWidth * InputStride;
+                    }
+                }
+
+                std::fill_n(ExpandedInput, (KernelWidth - KernelEnd) * InputChannels, 0.0f);
+                ExpandedInput += (KernelWidth - KernelEnd) * InputChannels;
+            }
+        }
+    }
+}
+
+void
+MlasConvNhwcDepthwiseBlock(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const MLAS_CONV_NHWC_SHAPE& Shape,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t PixelStart,
+    size_t PixelCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output pixels of a depthwise convolution.
+    The kernel positions inside the input tensor are accumulated in registers
+    for each slice of channels.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Shape - Supplies the convolution shapes promoted to three dimensions.
+
+    Input - Supplies the input image.
+
+    Filter - Supplies the packed filter ordered as [KernelSize][Channels].
+
+    Bias - Optionally supplies the bias vector.
+
+    Output - Supplies the output image.
+
+    PixelStart - Supplies the index of the first output pixel.
+
+    PixelCount - Supplies the number of output pixels to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Channels = Parameters->GroupCount;
+    const float Beta = Parameters->Beta;
+
+    const size_t OutputHeight = Shape.OutputShape[1];
+    const size_t OutputWidth = Shape.OutputShape[2];
+
+    float* output = Output + PixelStart * Channels;
+
+    for (size_t p = PixelStart; p < PixelStart + PixelCount; p++) {
+
+        size_t OutputIndex[3];
+
+        OutputIndex[0] = p / (OutputHeight * OutputWidth);
+        OutputIndex[1] = (p / OutputWidth) % OutputHeight;
+        OutputIndex[2] = p % OutputWidth;
+
+        size_t KernelStart[3];
+        size_t KernelEnd[3];
+        size_t InputOrigin[3];
+
+        for (size_t dim = 0; dim < 3; dim++) {
+            MlasConvNhwcKernelRange(OutputIndex[dim], Shape.InputShape[dim], Shape.KernelShape[dim],
+                Shape.DilationShape[dim], Shape.Padding[dim], Shape.StrideShape[dim],
+                &KernelStart[dim], &KernelEnd[dim]);
+            InputOrigin[dim] = OutputIndex[dim] * Shape.StrideShape[dim] +
+                KernelStart[dim] * Shape.DilationShape[dim] - Shape.Padding[dim];
+        }
+
+        const float* input = Input + ((InputOrigin[0] * Shape.InputShape[1] + InputOrigin[1]) *
+            Shape.InputShape[2] + InputOrigin[2]) * Channels;
+        const float* filter = Filter + ((KernelStart[0] * Shape.KernelShape[1] + KernelStart[1]) *
+            Shape.KernelShape[2] + KernelStart[2]) * Channels;
+
+        const size_t InputStrideD = Shape.DilationShape[0] * Shape.InputShape[1] * Shape.InputShape[2] * Channels;
+        const size_t InputStrideH = Shape.DilationShape[1] * Shape.InputShape[2] * Channels;
+        const size_t InputStrideW = Shape.DilationShape[2] * Channels;
+        const size_t FilterStrideD = Shape.KernelShape[1] * Shape.KernelShape[2] * Channels;
+        const size_t FilterStrideH = Shape.KernelShape[2] * Channels;
+
+        const MLAS_FLOAT32X4 BetaBroadcast = MlasBroadcastFloat32x4(Beta);
+
+        size_t c = 0;
+
+        for (; c + 8 <= Channels; c += 8) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(Bias + c);
+                Accumulator1 = MlasLoadFloat32x4(Bias + c + 4);
+            }
+
+            if (Beta != 0.0f) {
+                Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(output + c), BetaBroadcast, Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(output + c + 4), BetaBroadcast, Accumulator1);
+            }
+
+            for (size_t kd = KernelStart[0]; kd < KernelEnd[0]; kd++) {
+
+                const size_t Depth = kd - KernelStart[0];
+
+                for (size_t kh = KernelStart[1]; kh < KernelEnd[1]; kh++) {
+
+                    const size_t Row = kh - KernelStart[1];
+                    const float* input_row = input + Depth * InputStrideD + Row * InputStrideH + c;
+                    const float* filter_row = filter + Depth * FilterStrideD + Row * FilterStrideH + c;
+
+                    for (size_t kw = KernelStart[2]; kw < KernelEnd[2]; kw++) {
+
+                        Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input_row),
+                            MlasLoadFloat32x4(filter_row), Accumulator0);
+                        Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(input_row + 4),
+                            MlasLoadFloat32x4(filter_row + 4), Accumulator1);
+
+                        input_row += InputStrideW;
+                        filter_row += Channels;
+                    }
+                }
+            }
+
+            MlasStoreFloat32x4(output + c, Accumulator0);
+            MlasStoreFloat32x4(output + c + 4, Accumulator1);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = (Bias != nullptr) ? Bias[c] : 0.0f;
+
+            if (Beta != 0.0f) {
+                Accumulator += Beta * output[c];
+            }
+
+            for (size_t kd = KernelStart[0]; kd < KernelEnd[0]; kd++) {
+
+                const size_t Depth = kd - KernelStart[0];
+
+                for (size_t kh = KernelStart[1]; kh < KernelEnd[1]; kh++) {
+
+                    const size_t Row = kh - KernelStart[1];
+                    const float* input_row = input + Depth * InputStrideD + Row * InputStrideH + c;
+                    const float* filter_row = filter + Depth * FilterStrideD + Row * FilterStrideH + c;
+
+                    for (size_t kw = KernelStart[2]; kw < KernelEnd[2]; kw++) {
+
+                        Accumulator += input_row[0] * filter_row[0];
+
+                        input_row += InputStrideW;
+                        filter_row += Channels;
+                    }
+                }
+            }
+
+            output[c] = Accumulator;
+        }
+
+        output += Channels;
+    }
+
+    if (Parameters->Activation != nullptr) {
+        MlasActivation(Parameters->Activation, Output + PixelStart * Channels, nullptr,
+            PixelCount, Channels, Channels);
+    }
+}
+
+void
+MLASCALL
+MlasConvNhwc(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const void* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation for tensors in the
+    channels last format.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters computed by MlasConvNhwcPrepare.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter packed by MlasConvNhwcPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvNhwcPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_NHWC_SHAPE Shape;
+
+    MlasConvNhwcGetShape(Parameters, &Shape);
+
+    const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+    const size_t BlockSize = Parameters->u.Nhwc.BlockSize;
+    const ptrdiff_t ThreadCount = Parameters->ThreadCount;
+
+    const size_t InputStride = GroupCount * InputChannels;
+    const size_t OutputStride = GroupCount * FilterCount;
+    const size_t BlocksPerImage = (OutputSize + BlockSize - 1) / BlockSize;
+    const size_t TotalBlocks = Parameters->BatchCount * BlocksPerImage;
+
+    //
+    // The identity activation is skipped by the matrix multiply epilogue.
+    //
+
+    const MLAS_ACTIVATION* Activation = Parameters->Activation;
+
+    if (Activation != nullptr && Activation->ActivationKind == MlasIdentityActivation) {
+        Activation = nullptr;
+    }
+
+    const size_t AlignedN =
+        (FilterCount + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+    const size_t PackedFilterGroupSize = MlasGemmPackBSize(FilterCount, K);
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t BlockStart;
+        size_t BlockRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, TotalBlocks, &BlockStart, &BlockRemaining);
+
+        float* ExpandedInput = WorkingBuffer + tid * BlockSize * K;
+
+        for (size_t block = BlockStart; block < BlockStart + BlockRemaining; block++) {
+
+            const size_t b = block / BlocksPerImage;
+            const size_t PixelStart = (block % BlocksPerImage) * BlockSize;
+            const size_t PixelCount = std::min(BlockSize, OutputSize - PixelStart);
+
+            const float* input = Input + b * InputSize * InputStride;
+            float* output = Output + b * OutputSize * OutputStride;
+
+            if (Algorithm == MlasConvAlgorithmNhwcDepthwise) {
+                MlasConvNhwcDepthwiseBlock(Parameters, Shape, input,
+                    static_cast<const float*>(PackedFilter), Bias, output, PixelStart, PixelCount);
+                continue;
+            }
+
+            for (size_t g = 0; g < GroupCount; g++) {
+
+                const float* A;
+                size_t lda;
+
+                if (Algorithm == MlasConvAlgorithmNhwcGemmDirect) {
+                    A = input + PixelStart * InputStride + g * InputChannels;
+                    lda = InputStride;
+                } else {
+                    MlasConvNhwcExpandBlock(Shape, InputChannels, InputStride,
+                        input + g * InputChannels, ExpandedInput, PixelStart, PixelCount);
+                    A = ExpandedInput;
+                    lda = K;
+                }
+
+                MLAS_SGEMM_EPILOGUE Epilogue;
+                const MLAS_SGEMM_EPILOGUE* GroupEpilogue = nullptr;
+
+                if (Bias != nullptr || Activation != nullptr) {
+                    Epilogue.Bias = (Bias != nullptr) ? Bias + g * FilterCount : nullptr;
+                    Epilogue.Activation = Activation;
+                    Epilogue.Residual = nullptr;
+                    Epilogue.ldr = 0;
+                    GroupEpilogue = &Epilogue;
+                }
+
+                MlasSgemmPackedOperation(CblasNoTrans, PixelCount, 0, FilterCount, K, 1.0f, A, lda,
+                    static_cast<const uint8_t*>(PackedFilter) + g * PackedFilterGroupSize, AlignedN,
+                    Parameters->Beta, output + PixelStart * OutputStride + g * FilterCount,
+                    OutputStride, GroupEpilogue);
+            }
+        }
+    });
+}
+
+size_t
+MLASCALL
+MlasConvNhwcPackFilterSize(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of bytes of the packed filter for a
+    channels last convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+Return Value:
+
+    Returns the number of bytes of the packed filter.
+
+--*/
+{
+    if (InputChannels == 1 && FilterCount == 1) {
+        return GroupCount * KernelSize * sizeof(float);
+    }
+
+    return GroupCount * MlasGemmPackBSize(FilterCount, KernelSize * InputChannels);
+}
+
+void
+MLASCALL
+MlasConvNhwcPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t KernelSize,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the filter for a channels last convolution.
+
+    Depthwise filters are reordered to [KernelSize][GroupCount]. Otherwise,
+    the filter of each group is reordered to [FilterCount][KernelSize]
+    [InputChannels] and then packed for the matrix multiply.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    KernelSize - Supplies the number of elements of the kernel.
+
+    Filter - Supplies the filter tensor ordered as [GroupCount * FilterCount]
+        [InputChannels][KernelSize].
+
+    PackedFilter - Supplies the buffer to receive the packed filter, sized by
+        MlasConvNhwcPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (InputChannels == 1 && FilterCount == 1) {
+
+        float* packed = static_cast<float*>(PackedFilter);
+
+        for (size_t g = 0; g < GroupCount; g++) {
+            for (size_t k = 0; k < KernelSize; k++) {
+                packed[k * GroupCount + g] = Filter[g * KernelSize + k];
+            }
+        }
+
+        return;
+    }
+
+    const size_t K = KernelSize * InputChannels;
+    const size_t PackedFilterGroupSize = MlasGemmPackBSize(FilterCount, K);
+
+    std::vector<float> ReorderedFilter(FilterCount * K);
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+            for (size_t c = 0; c < InputChannels; c++) {
+                for (size_t k = 0; k < KernelSize; k++) {
+                    ReorderedFilter[(f * KernelSize + k) * InputChannels + c] = *Filter++;
+                }
+            }
+        }
+
+        MlasGemmPackB(CblasTrans, FilterCount, K, ReorderedFilter.data(), K,
+            static_cast<uint8_t*>(PackedFilter) + g * PackedFilterGroupSize);
+    }
+}
+
+void
+MLASCALL
+MlasConvNhwcPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t Dimensions,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t FilterCount,
+    const MLAS_ACTIVATION* Activation,
+    size_t* WorkingBufferSize,
+    float Beta,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a channels last convolution operation by
+    computing required parameters including the required working buffer size
+    for intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    Dimensions - Supplies the number of dimensions (must be between 1 and 3).
+
+    BatchCount - Supplies the number of batches to the processed.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the spatial shape of the input tensor.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of zero padding elements at the edge of the
+        input tensor.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the spatial shape of the output tensor.
+
+    FilterCount - Supplies the number of filters per group.
+
+    Activation - Supplies the parameters for the activation to apply to the
+        convolution output.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+    Beta - Supplies the scalar multiplier of the existing output tensor,
+        which is added before the activation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute the shapes and sizes shared with the channels first layout.
+    //
+
+    MlasConvPrepare(Parameters, Dimensions, BatchCount, GroupCount, InputChannels, InputShape,
+        KernelShape, DilationShape, Padding, StrideShape, OutputShape, FilterCount, Activation,
+        WorkingBufferSize, Beta, ThreadPool);
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t K = Parameters->K;
+
+    bool AllStridesAreOne = true;
+    bool AllPaddingIsZero = true;
+
+    for (size_t dim = 0; dim < Parameters->Dimensions; dim++) {
+        AllStridesAreOne &= (Parameters->StrideShape[dim] == 1);
+        AllPaddingIsZero &= (Parameters->Padding[dim] == 0 &&
+            Parameters->Padding[dim + Parameters->Dimensions] == 0);
+    }
+
+    size_t BlockSize;
+
+    if (InputChannels == 1 && FilterCount == 1) {
+        Parameters->Algorithm = MlasConvAlgorithmNhwcDepthwise;
+        BlockSize = MLAS_CONV_NHWC_MAXIMUM_BLOCK_SIZE;
+    } else if (K == InputChannels && AllStridesAreOne && AllPaddingIsZero) {
+        Parameters->Algorithm = MlasConvAlgorithmNhwcGemmDirect;
+        BlockSize = MLAS_CONV_NHWC_MAXIMUM_BLOCK_SIZE;
+    } else {
+        Parameters->Algorithm = MlasConvAlgorithmNhwcExpandThenGemm;
+        BlockSize = std::min(std::max(MLAS_CONV_NHWC_EXPAND_BUFFER_ELEMENTS / K,
+            MLAS_CONV_NHWC_MINIMUM_BLOCK_SIZE), MLAS_CONV_NHWC_MAXIMUM_BLOCK_SIZE);
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution operation. Small requests should run using the single
+    // threaded path.
+    //
+
+    ptrdiff_t TargetThreadCount;
+    const double Complexity = double(BatchCount) * double(GroupCount) * double(FilterCount) *
+        double(OutputSize) * double(K);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Shrink the blocks of output pixels so that each thread has work.
+    //
+
+    const size_t BlocksPerBatch = (size_t(TargetThreadCount) + BatchCount - 1) / BatchCount;
+
+    if (BlocksPerBatch > 1) {
+        BlockSize = std::min(BlockSize, std::max((OutputSize + BlocksPerBatch - 1) / BlocksPerBatch,
+            MLAS_CONV_NHWC_MINIMUM_BLOCK_SIZE));
+    }
+
+    BlockSize = std::max(std::min(BlockSize, OutputSize), size_t(1));
+
+    const size_t TotalBlocks = BatchCount * ((OutputSize + BlockSize - 1) / BlockSize);
+
+    if (size_t(TargetThreadCount) > TotalBlocks) {
+        TargetThreadCount = ptrdiff_t(TotalBlocks);
+    }
+
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Nhwc.BlockSize = BlockSize;
+
+    if (Parameters->Algorithm == MlasConvAlgorithmNhwcExpandThenGemm) {
+        *WorkingBufferSize = size_t(TargetThreadCount) * BlockSize * K;
+    } else {
+        *WorkingBufferSize = 0;
+    }
+}
@@ -35,10 +35,6 @@ struct MLAS_CONV_WORK_BLOCK {
     const float* Bias;
     float* WorkingBuffer;
     float* Output;
-    struct SEGMENT {
-        size_t StartN;
-        size_t CountN;
-    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
     ptrdiff_t TargetThreadCount;
 };
 
@@ -489,6 +485,8 @@ MlasConvOperation(
     const float* Bias,
     float* ColumnBuffer,
     float* Output,
+    size_t SegmentStartM,
+    size_t SegmentCountM,
     size_t SegmentStartN,
     size_t SegmentCountN
     )
@@ -513,6 +511,10 @@ Arguments:
 
     Output - Supplies the output tensor.
 
+    SegmentStartM - Supplies the first filter of the segment.
+
+    SegmentCountM - Supplies the count of filters of the segment.
+
     SegmentStartN - Supplies the N to begin sampling the convolution patches.
 
     SegmentCountN - Supplies the count of N to sample for the convolution
@@ -524,10 +526,16 @@ Return Value:
 
 --*/
 {
-    const size_t FilterCount = Parameters->FilterCount;
     const size_t OutputSize = Parameters->OutputSize;
     const size_t K = Parameters->K;
 
+    Filter += SegmentStartM * K;
+    Output += SegmentStartM * OutputSize;
+
+    if (Bias != nullptr) {
+        Bias += SegmentStartM;
+    }
+
     //
     // Compute the strides to step through slices of the local segment.
     //
@@ -590,7 +598,7 @@ Return Value:
                     SegmentStartN + n, CountN);
             }
 
-            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountN,
+            MlasSgemmOperation(CblasNoTrans, CblasNoTrans, SegmentCountM, CountN,
                 CountK, 1.0f, Filter + k, K, ColumnBuffer, CountN, beta,
                 SegmentOutput, OutputSize);
 
@@ -601,7 +609,7 @@ Return Value:
         // Apply the activation with optional bias.
         //
 
-        MlasActivation(Parameters->Activation, SegmentOutput, Bias, FilterCount,
+        MlasActivation(Parameters->Activation, SegmentOutput, Bias, SegmentCountM,
             CountN, OutputSize);
     }
 }
@@ -632,14 +640,30 @@ Return Value:
 {
     MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
 
-    MLAS_CONV_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t ThreadStrideM = Parameters->u.ExpandThenGemmSegmented.ThreadStrideM;
+    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
+
+    //
+    // Compute the tile of the output owned by this thread.
+    //
+
+    const size_t ThreadCountN = MlasDivRoundup(OutputSize, ThreadStrideN);
+
+    const size_t SegmentStartM = (size_t(Index) / ThreadCountN) * ThreadStrideM;
+    const size_t SegmentCountM = std::min(FilterCount - SegmentStartM, ThreadStrideM);
+    const size_t SegmentStartN = (size_t(Index) % ThreadCountN) * ThreadStrideN;
+    const size_t SegmentCountN = std::min(OutputSize - SegmentStartN, ThreadStrideN);
 
     float* ColumnBuffer =
         WorkBlock->WorkingBuffer + Index * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
 
-    MlasConvOperation(WorkBlock->Parameters, WorkBlock->Input, WorkBlock->Filter,
-        WorkBlock->Bias, ColumnBuffer, WorkBlock->Output, Segment->StartN,
-        Segment->CountN);
+    MlasConvOperation(Parameters, WorkBlock->Input, WorkBlock->Filter, WorkBlock->Bias,
+        ColumnBuffer, WorkBlock->Output, SegmentStartM, SegmentCountM, SegmentStartN,
+        SegmentCountN);
 }
 
 void
@@ -775,10 +799,7 @@ Return Value:
 {
     MLAS_CONV_WORK_BLOCK WorkBlock;
 
-    const size_t OutputSize = Parameters->OutputSize;
-    const size_t ThreadStrideN = Parameters->u.ExpandThenGemmSegmented.ThreadStrideN;
-
-    if (ThreadStrideN >= OutputSize) {
+    if (Parameters->ThreadCount <= 1) {
         return false;
     }
 
@@ -794,27 +815,11 @@ Return Value:
     WorkBlock.Output = Output;
 
     //
-    // Segment the operation across multiple threads.
+    // Segment the operation across multiple threads. Each thread computes one
+    // tile of the output selected by MlasConvPrepare.
     //
 
-    int32_t Index = 0;
-    size_t SegmentCountN;
-
-    for (size_t SegmentStartN = 0; SegmentStartN < OutputSize; SegmentStartN += SegmentCountN) {
-
-        SegmentCountN = OutputSize - SegmentStartN;
-
-        if (SegmentCountN > ThreadStrideN) {
-            SegmentCountN = ThreadStrideN;
-        }
-
-        WorkBlock.Segments[Index].StartN = SegmentStartN;
-        WorkBlock.Segments[Index].CountN = SegmentCountN;
-
-        Index++;
-    }
-
-    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Index, ThreadPool);
+    MlasExecuteThreaded(MlasConvOperationThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
 
     return true;
 }
@@ -903,6 +908,13 @@ Return Value:
         return;
     }
 
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        MlasConvWinograd(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+
+        return;
+    }
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
@@ -997,11 +1009,33 @@ Return Value:
                     if (!MlasConvTryMultithread(Parameters, Input, filter, bias, WorkingBuffer,
                         Output, ThreadPool)) {
                         MlasConvOperation(Parameters, Input, filter, bias, WorkingBuffer,
-                            Output, 0, OutputSize);
+                            Output, 0, FilterCount, 0, OutputSize);
                     }
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // The Winograd algorithm handles all batches and groups
+                    // above.
+                    //
+
+                    break;
+                }
+
+                case MlasConvAlgorithmNhwcGemmDirect:
+                case MlasConvAlgorithmNhwcExpandThenGemm:
+                case MlasConvAlgorithmNhwcDepthwise:
+                {
+                    //
+                    // The channels last algorithms are only selected by
+                    // MlasConvNhwcPrepare for use by MlasConvNhwc.
+                    //
+
+                    break;
+                }
             }
 
             //
@@ -1245,8 +1279,9 @@ Return Value:
 #endif
 
         //
-        // Segment the operation across multiple threads by slicing the N
-        // dimension (see MlasSgemmTryMultithread).
+        // Segment the operation across multiple threads by tiling the filter
+        // (M) and output (N) dimensions with the cache aware partitioner (see
+        // MlasGemmBatch).
         //
         // Compute the number of target threads given the complexity of the
         // convolution operation. Small requests should run using the single
@@ -1256,10 +1291,10 @@ Return Value:
         ptrdiff_t TargetThreadCount;
         double Complexity = double(FilterCount) * double(OutputSize) * double(K);
 
-        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
             TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
         } else {
-            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+            TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
         }
 
         ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
@@ -1268,31 +1303,18 @@ Return Value:
             TargetThreadCount = MaximumThreadCount;
         }
 
-        //
-        // Compute the thread stride for slicing the N dimension.
-        //
+        MLAS_GEMM_THREAD_PARTITION Partition;
 
-        size_t StrideN = OutputSize / TargetThreadCount;
+        MlasGemmPartitionThreads(FilterCount, OutputSize, K, 1, MLAS_SGEMM_STRIDEN_THREAD_ALIGN,
+            sizeof(float), sizeof(float), TargetThreadCount, 0, &Partition);
 
-        if ((StrideN * TargetThreadCount) != OutputSize) {
-            StrideN++;
-        }
-
-        if (TargetThreadCount > 1) {
-
-            StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
-
-            if (StrideN >= OutputSize) {
-                TargetThreadCount = 1;
-            } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
-                TargetThreadCount--;
-            }
-        }
+        TargetThreadCount = Partition.ThreadCount();
 
         Parameters->ThreadCount = TargetThreadCount;
 
         Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
-        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+        Parameters->u.ExpandThenGemmSegmented.ThreadStrideM = Partition.StrideM;
+        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = Partition.StrideN;
 
         *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
     }
@@ -78,6 +78,12 @@ extern "C" {
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Core;
     MLAS_CONV_SYM_KERNEL MlasConvSymKernelAvx512Vnni;
     MLAS_CONV_SYM_DEPTHWISE_KERNEL MlasConvSymDepthwiseKernelAvx512Vnni;
+    MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC MlasConvSymDepthwiseKernelSize9AvxVnni;
+    MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC MlasConvSymDepthwiseKernelSize25AvxVnni;
+    MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC MlasConvSymDepthwiseKernelSize9Avx512Vnni;
+    MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC MlasConvSymDepthwiseKernelSize25Avx512Vnni;
+    MLAS_CONV_SYM_KERNEL MlasConvSymKernelAmx;
+    MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelAmx;
 #elif defined(MLAS_TARGET_ARM64)
     MLAS_CONV_SYM_KERNEL MlasConvSymS8KernelNeon;
     MLAS_CONV_SYM_KERNEL MlasConvSymU8KernelNeon;
@@ -152,12 +158,14 @@ struct MLAS_CONV_SYM_DISPATCH {
     MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC* Depthwise5x5Proc;
     uint8_t FilterInputChannelPackCount;
     uint8_t FilterOutputChannelPackCount;
+    uint8_t FilterKernelDimAlignment;
     uint8_t KernelChannelCount;
     uint8_t KernelOutputCount;
     uint8_t KernelInputChannelAlignment;
     uint8_t KernelOutputChannelAlignment;
     uint8_t KernelDepthwiseChannelCount;
     uint8_t KernelDepthwiseOutputCount;
+    uint8_t DepthwiseFixFilterPackCount;
     bool FixupInputZeroPoint;
 };
 
@@ -170,28 +178,37 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx2 = {
     nullptr,
     4,                                      // FilterInputChannelPackCount
     16,                                     // FilterOutputChannelPackCount
+    1,                                      // FilterKernelDimAlignment
     16,                                     // KernelChannelCount
     4,                                      // KernelOutputCount
     4,                                      // KernelInputChannelAlignment
     8,                                      // KernelOutputChannelAlignment
     16,                                     // KernelDepthwiseChannelCount
     4,                                      // KernelDepthwiseOutputCount
+    1,                                      // DepthwiseFixFilterPackCount
     false,                                  // FixupInputZeroPoint
 };
 
 const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvxVnni = {
     MlasConvSymKernelAvxVnni,
     MlasConvSymDepthwiseKernelAvxVnni,
+#if defined(MLAS_AVXVNNI_SUPPORTED)
+    MlasConvSymDepthwiseKernelSize9AvxVnni,
+    MlasConvSymDepthwiseKernelSize25AvxVnni,
+#else
     nullptr,
     nullptr,
+#endif
     4,                                      // FilterInputChannelPackCount
     16,                                     // FilterOutputChannelPackCount
+    1,                                      // FilterKernelDimAlignment
     16,                                     // KernelChannelCount
     6,                                      // KernelOutputCount
     4,                                      // KernelInputChannelAlignment
     8,                                      // KernelOutputChannelAlignment
     16,                                     // KernelDepthwiseChannelCount
     4,                                      // KernelDepthwiseOutputCount
+    4,                                      // DepthwiseFixFilterPackCount
     false,                                  // FixupInputZeroPoint
 };
 
@@ -204,31 +221,82 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Core = {
     nullptr,
     4,                                      // FilterInputChannelPackCount
     16,                                     // FilterOutputChannelPackCount
+    1,                                      // FilterKernelDimAlignment
     64,                                     // KernelChannelCount
     6,                                      // KernelOutputCount
     4,                                      // KernelInputChannelAlignment
     4,                                      // KernelOutputChannelAlignment
     64,                                     // KernelDepthwiseChannelCount
     6,                                      // KernelDepthwiseOutputCount
+    1,                                      // DepthwiseFixFilterPackCount
     false,                                  // FixupInputZeroPoint
 };
 
 const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni = {
     MlasConvSymKernelAvx512Vnni,
     MlasConvSymDepthwiseKernelAvx512Vnni,
-    nullptr,
-    nullptr,
+    MlasConvSymDepthwiseKernelSize9Avx512Vnni,
+    MlasConvSymDepthwiseKernelSize25Avx512Vnni,
     4,                                      // FilterInputChannelPackCount
     16,                                     // FilterOutputChannelPackCount
+    1,                                      // FilterKernelDimAlignment
     64,                                     // KernelChannelCount
     6,                                      // KernelOutputCount
     4,                                      // KernelInputChannelAlignment
     4,                                      // KernelOutputChannelAlignment
     64,                                     // KernelDepthwiseChannelCount
     6,                                      // KernelDepthwiseOutputCount
+    4,                                      // DepthwiseFixFilterPackCount
+    false,                                  // FixupInputZeroPoint
+};
+
+#if defined(MLAS_AMX_SUPPORTED)
+
+//
+// The AMX kernels compute all of the output channels for up to 32 output
+// elements per call. The kernel dimension of the packed filter is padded to
+// the depth of a tile. The depthwise convolution is not a matrix multiply, so
+// the AVX512VNNI depthwise kernels are used.
+//
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx = {
+    MlasConvSymKernelAmx,
+    MlasConvSymDepthwiseKernelAvx512Vnni,
+    MlasConvSymDepthwiseKernelSize9Avx512Vnni,
+    MlasConvSymDepthwiseKernelSize25Avx512Vnni,
+    4,                                      // FilterInputChannelPackCount
+    16,                                     // FilterOutputChannelPackCount
+    64,                                     // FilterKernelDimAlignment
+    0,                                      // KernelChannelCount
+    32,                                     // KernelOutputCount
+    4,                                      // KernelInputChannelAlignment
+    1,                                      // KernelOutputChannelAlignment
+    64,                                     // KernelDepthwiseChannelCount
+    6,                                      // KernelDepthwiseOutputCount
+    4,                                      // DepthwiseFixFilterPackCount
+    false,                                  // FixupInputZeroPoint
+};
+
+const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchAmx = {
+    MlasConvSymS8KernelAmx,
+    nullptr,
+    nullptr,
+    nullptr,
+    4,                                      // FilterInputChannelPackCount
+    16,                                     // FilterOutputChannelPackCount
+    64,                                     // FilterKernelDimAlignment
+    0,                                      // KernelChannelCount
+    32,                                     // KernelOutputCount
+    4,                                      // KernelInputChannelAlignment
+    1,                                      // KernelOutputChannelAlignment
+    0,                                      // KernelDepthwiseChannelCount
+    0,                                      // KernelDepthwiseOutputCount
+    1,                                      // DepthwiseFixFilterPackCount
     false,                                  // FixupInputZeroPoint
 };
 
+#endif // MLAS_AMX_SUPPORTED
+
 #endif // ORT_MINIMAL_BUILD
 
 #elif defined(MLAS_TARGET_ARM64)
@@ -240,12 +308,14 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon = {
     MlasConvSymDepthwiseKernelSize25ArmU8S8,
     8,   // FilterInputChannelPackCount
     8,   // FilterOutputChannelPackCount
+    1,   // FilterKernelDimAlignment
     8,   // KernelChannelCount
     2,   // KernelOutputCount
     8,   // KernelInputChannelAlignment
     8,   // KernelOutputChannelAlignment
     16,  // KernelDepthwiseChannelCount
     4,   // KernelDepthwiseOutputCount
+    1,   // DepthwiseFixFilterPackCount
     true
 };
 
@@ -257,15 +327,23 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon = {
     MlasConvSymDepthwiseKernelSize25ArmS8S8,
     8,   // FilterInputChannelPackCount
     8,   // FilterOutputChannelPackCount
+    1,   // FilterKernelDimAlignment
     8,   // KernelChannelCount
     2,   // KernelOutputCount
     8,   // KernelInputChannelAlignment
     8,   // KernelOutputChannelAlignment
     16,  // KernelDepthwiseChannelCount
     4,   // KernelDepthwiseOutputCount
+    1,   // DepthwiseFixFilterPackCount
     false
 };
 
+//
+// The dot product depthwise kernels (qdwconv_kernel_sdot.cpp) are not selected
+// here until they have been validated against the MLAS conv tests on ARM
+// hardware; the Neon depthwise kernels are used instead.
+//
+
 const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot = {
     MlasConvSymU8KernelDot,
     MlasConvSymU8KernelDot,
@@ -274,12 +352,14 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot = {
     MlasConvSymDepthwiseKernelSize25ArmU8S8,
     4,   // FilterInputChannelPackCount
     16,  // FilterOutputChannelPackCount
+    1,   // FilterKernelDimAlignment
     0,   // KernelChannelCount
     4,   // KernelOutputCount
     4,   // KernelInputChannelAlignment
     16,  // KernelOutputChannelAlignment
     16,  // KernelDepthwiseChannelCount
     4,   // KernelDepthwiseOutputCount
+    1,   // DepthwiseFixFilterPackCount
     true
 };
 
@@ -291,12 +371,14 @@ const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot = {
     MlasConvSymDepthwiseKernelSize25ArmS8S8,
     4,   // FilterInputChannelPackCount
     16,  // FilterOutputChannelPackCount
+    1,   // FilterKernelDimAlignment
     0,   // KernelChannelCount
     4,   // KernelOutputCount
     4,   // KernelInputChannelAlignment
     16,  // KernelOutputChannelAlignment
     16,  // KernelDepthwiseChannelCount
     4,   // KernelDepthwiseOutputCount
+    1,   // DepthwiseFixFilterPackCount
     false
 };
 #endif // MLAS_TARGET_AMD64
@@ -325,6 +407,52 @@ GetConvSymDispatch(bool InputIsSigned){
     return InputIsSigned ? GetMlasPlatform().ConvSymS8S8Dispatch : GetMlasPlatform().ConvSymU8S8Dispatch;
 }
 
+MLAS_FORCEINLINE
+size_t
+MlasConvSymAlignedKernelDim(
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch,
+    size_t InputChannels,
+    size_t KernelSize
+    )
+{
+    //
+    // Each block of packed output channels holds the kernel dimension padded
+    // with zero filter values to the alignment required by the kernel.
+    //
+
+    const size_t Alignment = ConvSymDispatch->FilterKernelDimAlignment;
+
+    return (InputChannels * KernelSize + Alignment - 1) / Alignment * Alignment;
+}
+
+MLAS_FORCEINLINE
+MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC*
+GetConvSymDepthwiseFixFilterProc(
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch,
+    size_t Channels,
+    size_t KernelSize
+    )
+{
+    //
+    // The kernels specialized for 3x3 and 5x5 filters process blocks of 16
+    // channels.
+    //
+
+    if ((Channels & 15) != 0) {
+        return nullptr;
+    }
+
+    if (KernelSize == 9) {
+        return ConvSymDispatch->Depthwise3x3Proc;
+    }
+
+    if (KernelSize == 25) {
+        return ConvSymDispatch->Depthwise5x5Proc;
+    }
+
+    return nullptr;
+}
+
 size_t
 MlasConvSymPackWSize(
     size_t GroupCount,
@@ -355,7 +483,19 @@ MlasConvSymPackWSize(
                 return 0;
             }
 
-            return AlignedGroupCount * KernelSize;
+            //
+            // The dot product kernels specialized for a kernel size consume
+            // the kernel elements in packs, so the kernel size is padded with
+            // zero filter values.
+            //
+
+            size_t PackCount = 1;
+
+            if (GetConvSymDepthwiseFixFilterProc(ConvSymDispatch, GroupCount, KernelSize) != nullptr) {
+                PackCount = ConvSymDispatch->DepthwiseFixFilterPackCount;
+            }
+
+            return AlignedGroupCount * ((KernelSize + PackCount - 1) / PackCount * PackCount);
 
         } else {
             return 0;
@@ -388,7 +528,7 @@ MlasConvSymPackWSize(
         }
 
         size_t AlignedOutputChannels = (OutputChannels + OutputChannelPackCount - 1) / OutputChannelPackCount * OutputChannelPackCount;
-        return AlignedOutputChannels * InputChannels * KernelSize;
+        return AlignedOutputChannels * MlasConvSymAlignedKernelDim(ConvSymDispatch, InputChannels, KernelSize);
     }
 }
 
@@ -404,26 +544,59 @@ MlasConvSymPackW(
     bool InputIsSigned
     )
 {
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
+
     memset(PackedW, 0, PackedWSize);
 
     if (GroupCount > 1) {
 
-        for (size_t gc = 0; gc < GroupCount; gc++) {
+        const size_t PackCount = ConvSymDispatch->DepthwiseFixFilterPackCount;
+
+        if (GetConvSymDepthwiseFixFilterProc(ConvSymDispatch, GroupCount, KernelSize) != nullptr &&
+            PackCount > 1) {
+
+            //
+            // Pack the filter for the dot product kernels: PackCount adjacent
+            // kernel elements of a channel form one 32-bit lane and the lanes
+            // of each block of channels are interleaved as described by
+            // MlasConvSymDepthwiseDotBlockWidth.
+            //
+
+            for (size_t gc = 0; gc < GroupCount; gc++) {
+
+                const size_t BlockWidth = MlasConvSymDepthwiseDotBlockWidth(GroupCount, gc);
+                const size_t BlockStart = gc & ~(BlockWidth - 1);
+                const size_t BlockOffset = gc - BlockStart;
+                const size_t LaneIndex = BlockStart + ((BlockOffset % 16) / 4) * (BlockWidth / 4) +
+                    (BlockOffset / 16) * 4 + BlockOffset % 4;
+
+                for (size_t k = 0; k < KernelSize; k++) {
+
+                    PackedW[(k / PackCount) * GroupCount * PackCount + LaneIndex * PackCount + k % PackCount] =
+                        W[gc * KernelSize + k];
+
+                }
+            }
+
+        } else {
 
-            for (size_t k = 0; k < KernelSize; k++) {
+            for (size_t gc = 0; gc < GroupCount; gc++) {
 
-                PackedW[k * GroupCount + gc] = W[gc * KernelSize + k];
+                for (size_t k = 0; k < KernelSize; k++) {
 
+                    PackedW[k * GroupCount + gc] = W[gc * KernelSize + k];
+
+                }
             }
         }
 
     } else {
 
-        const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
         size_t InputChannelPackCount = ConvSymDispatch->FilterInputChannelPackCount;
         size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
 
         size_t kernel_dim = InputChannels * KernelSize;
+        size_t aligned_kernel_dim = MlasConvSymAlignedKernelDim(ConvSymDispatch, InputChannels, KernelSize);
 
         for (size_t oc = 0; oc < OutputChannels; oc += OutputChannelPackCount) {
 
@@ -451,6 +624,8 @@ MlasConvSymPackW(
 
                 }
             }
+
+            PackedW += (aligned_kernel_dim - kernel_dim) * OutputChannelPackCount;
         }
 
     }
@@ -529,6 +704,7 @@ MlasConvSym(
     const size_t KernelSize = Params.KernelSize;
     const size_t InputChannels = Params.InputChannels;
     const size_t OutputChannels = Params.OutputChannels;
+    const size_t AlignedKernelDim = MlasConvSymAlignedKernelDim(ConvSymDispatch, InputChannels, KernelSize);
 
     for (size_t oc_outside = 0; oc_outside < Params.OutputCount;) {
 
@@ -569,7 +745,7 @@ MlasConvSym(
             }
 
             co += ChannelCount;
-            pwb += ChannelCount * InputChannels * KernelSize;
+            pwb += ChannelCount * AlignedKernelDim;
         }
 
         oc_outside += oc_outside_block_size;
@@ -593,21 +769,16 @@ MlasConvSymDepthwise(
 
     MlasConvSymSetOutputZeroPoint(PostProcessParams, Params.OutputZeroPoint, Params.InputIsSigned);
 
-    if ((Params.OutputChannels & 15) == 0) {
+    MLAS_SYMM_QCONV_DEPTHWISE_FIXFILTER_PROC* FixFilterProc =
+        GetConvSymDepthwiseFixFilterProc(ConvSymDispatch, Params.OutputChannels, Params.KernelSize);
+
+    if (FixFilterProc != nullptr) {
         PostProcessParams.Bias = Params.Bias;
         PostProcessParams.Scale = Params.Scale;
-        if (ConvSymDispatch->Depthwise3x3Proc && Params.KernelSize == 9) {
-            ConvSymDispatch->Depthwise3x3Proc(Params.InputIndirection, (int8_t const*)Params.Filter,
-                                              Params.OutputChannels, Params.Output,
-                                              Params.OutputCount, &PostProcessParams, KernelFlags);
-            return;
-        }
-        if (ConvSymDispatch->Depthwise5x5Proc && Params.KernelSize == 25) {
-            ConvSymDispatch->Depthwise5x5Proc(Params.InputIndirection, (int8_t const*)Params.Filter,
-                                              Params.OutputChannels, Params.Output,
-                                              Params.OutputCount, &PostProcessParams, KernelFlags);
-            return;
-        }
+        FixFilterProc(Params.InputIndirection, (int8_t const*)Params.Filter,
+                      Params.OutputChannels, Params.Output,
+                      Params.OutputCount, &PostProcessParams, KernelFlags);
+        return;
     }
 
     const size_t KernelChannelCount = ConvSymDispatch->KernelDepthwiseChannelCount;
@@ -0,0 +1,393 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convsym_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer convolution kernels
+    using the AMX-INT8 tile instructions TDPBUSD and TDPBSSD.
+
+    The convolution is computed as a matrix multiply of the output elements by
+    the flattened kernel dimension (KernelSize x InputChannels). The filter is
+    packed by MlasConvSymPackW in blocks of 16 output channels with four
+    adjacent kernel dimension elements per 32-bit lane, so that 16 rows of a
+    block form a 16x64 byte B tile. The kernel dimension of each block is
+    padded with zeros to a multiple of the tile depth.
+
+    The kernel gathers the input rows of up to 32 output elements through the
+    indirection buffer once and then computes all of the output channels with
+    2x2 blocks of accumulator tiles.
+
+--*/
+
+#include "mlasi.h"
+
+#define TMM0 0
+#define TMM1 1
+#define TMM2 2
+#define TMM3 3
+#define TMM4 4
+#define TMM5 5
+#define TMM6 6
+#define TMM7 7
+
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_M = 16;
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_N = 16;
+constexpr size_t MLAS_CONV_SYM_AMX_TILE_K = 64;
+
+// Tile configure structure
+struct MLAS_CONV_SYM_AMX_TILECONFIG {
+    uint8_t palette_id = 0;
+    uint8_t start_row = 0;
+    uint8_t reserved1[14] = {0};
+    uint16_t colb[8] = {0};
+    uint8_t reserved2[16] = {0};
+    uint8_t rows[8] = {0};
+    uint8_t reserved3[8] = {0};
+};
+
+/**
+ * @brief Configure all the tiles as 16 rows of 64 bytes, the same
+ *        configuration used by the other AMX kernels.
+ */
+MLAS_FORCEINLINE
+void
+MlasConvSymAmxThreadInit()
+{
+    static thread_local MLAS_CONV_SYM_AMX_TILECONFIG tc;
+    MLAS_CONV_SYM_AMX_TILECONFIG current_tc;
+    _tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc.colb, &tc.colb, sizeof(tc.colb)) != 0 ||
+        std::memcmp(&current_tc.rows, &tc.rows, sizeof(tc.rows)) != 0) {
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = 16;
+            tc.colb[t] = 64;
+        }
+        _tile_loadconfig(&tc);
+    }
+}
+
+/**
+ * @brief Copy a row of bytes with masked loads and stores for the tail,
+ *        so that no bytes are read beyond the end of the source row.
+ */
+MLAS_FORCEINLINE
+void
+MlasConvSymAmxCopyRow(
+    uint8_t* D,
+    const uint8_t* S,
+    size_t Count
+    )
+{
+    while (Count >= 64) {
+        _mm512_storeu_si512(D, _mm512_loadu_si512(S));
+        D += 64;
+        S += 64;
+        Count -= 64;
+    }
+
+    if (Count > 0) {
+        const __mmask64 Mask = (uint64_t(1) << Count) - 1;
+        _mm512_mask_storeu_epi8(D, Mask, _mm512_maskz_loadu_epi8(Mask, S));
+    }
+}
+
+//
+// The tile instructions encode the tile registers as immediates, so the
+// signedness of the input selects the instruction through this macro.
+//
+
+#define MLAS_CONV_SYM_AMX_DOT(InputIsSigned, TileC, TileA, TileB) \
+    if constexpr (InputIsSigned) {                                  \
+        _tile_dpbssd(TileC, TileA, TileB);                          \
+    } else {                                                        \
+        _tile_dpbusd(TileC, TileA, TileB);                          \
+    }
+
+/**
+ * @brief Multiply a block of RowTiles x 16 gathered input rows by a block of
+ *        ColumnTiles x 16 packed output channels and spill the accumulator
+ *        tiles to the Accumulators buffer. Tile (r, c) is stored at offset
+ *        (r * 2 + c) * 256.
+ */
+template<bool InputIsSigned, size_t RowTiles, size_t ColumnTiles>
+MLAS_FORCEINLINE
+void
+MlasConvSymAmxComputeBlock(
+    const uint8_t* A,
+    size_t lda,
+    const int8_t* B,
+    size_t AlignedKernelDim,
+    int32_t* Accumulators
+    )
+{
+    constexpr size_t TileElements = MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_N;
+    constexpr size_t TileStride = MLAS_CONV_SYM_AMX_TILE_N * sizeof(int32_t);
+
+    const uint8_t* A1 = A + MLAS_CONV_SYM_AMX_TILE_M * lda;
+    const int8_t* B1 = B + MLAS_CONV_SYM_AMX_TILE_N * AlignedKernelDim;
+
+    _tile_zero(TMM0);
+    if constexpr (ColumnTiles > 1) {
+        _tile_zero(TMM1);
+    }
+    if constexpr (RowTiles > 1) {
+        _tile_zero(TMM2);
+        if constexpr (ColumnTiles > 1) {
+            _tile_zero(TMM3);
+        }
+    }
+
+    for (size_t k = 0; k < AlignedKernelDim; k += MLAS_CONV_SYM_AMX_TILE_K) {
+
+        _tile_loadd(TMM4, A + k, lda);
+        _tile_loadd(TMM6, B + k * MLAS_CONV_SYM_AMX_TILE_N, 64);
+        MLAS_CONV_SYM_AMX_DOT(InputIsSigned, TMM0, TMM4, TMM6);
+
+        if constexpr (ColumnTiles > 1) {
+            _tile_loadd(TMM7, B1 + k * MLAS_CONV_SYM_AMX_TILE_N, 64);
+            MLAS_CONV_SYM_AMX_DOT(InputIsSigned, TMM1, TMM4, TMM7);
+        }
+
+        if constexpr (RowTiles > 1) {
+            _tile_loadd(TMM5, A1 + k, lda);
+            MLAS_CONV_SYM_AMX_DOT(InputIsSigned, TMM2, TMM5, TMM6);
+            if constexpr (ColumnTiles > 1) {
+                MLAS_CONV_SYM_AMX_DOT(InputIsSigned, TMM3, TMM5, TMM7);
+            }
+        }
+    }
+
+    _tile_stored(TMM0, Accumulators, TileStride);
+    if constexpr (ColumnTiles > 1) {
+        _tile_stored(TMM1, Accumulators + TileElements, TileStride);
+    }
+    if constexpr (RowTiles > 1) {
+        _tile_stored(TMM2, Accumulators + 2 * TileElements, TileStride);
+        if constexpr (ColumnTiles > 1) {
+            _tile_stored(TMM3, Accumulators + 3 * TileElements, TileStride);
+        }
+    }
+}
+
+template<bool InputIsSigned>
+void
+MlasConvSymKernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 32 output elements of a symmetric quantized
+    convolution for all of the supplied output channels.
+
+Arguments:
+
+    Input - Supplies the indirection buffer with KernelSize input row pointers
+        for each output element, or the input rows if the flag
+        MLAS_CONV_SYM_FLAG_INPUT_DIRECT is set.
+
+    Filter - Supplies the filter buffer packed by MlasConvSymPackW.
+
+    Output - Supplies the output buffer.
+
+    KernelSize - Supplies the number of kernel elements.
+
+    InputChannels - Supplies the number of input channels.
+
+    OutputChannels - Supplies the number of output channels, which is the
+        number of elements per row of the output buffer.
+
+    ChannelCount - Supplies the number of output channels to compute.
+
+    OutputCount - Supplies the number of output elements to compute.
+
+    PostProcessParams - Supplies the bias, scale and zero point parameters.
+
+    KernelFlags - Supplies additional flags controlling the operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileElements = MLAS_CONV_SYM_AMX_TILE_M * MLAS_CONV_SYM_AMX_TILE_N;
+
+    MlasConvSymAmxThreadInit();
+
+    const size_t KernelDim = KernelSize * InputChannels;
+    const size_t AlignedKernelDim =
+        (KernelDim + MLAS_CONV_SYM_AMX_TILE_K - 1) & ~(MLAS_CONV_SYM_AMX_TILE_K - 1);
+    const size_t RowTiles = (OutputCount > MLAS_CONV_SYM_AMX_TILE_M) ? 2 : 1;
+    const size_t RowCount = RowTiles * MLAS_CONV_SYM_AMX_TILE_M;
+
+    //
+    // Form the A matrix of the output elements by the kernel dimension. Direct
+    // input rows that fill the tiles and the tile depth are used in place,
+    // else the input rows are gathered into the thread's buffer with the
+    // padding cleared.
+    //
+
+    const uint8_t* A;
+    size_t lda;
+
+    if ((KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0 && KernelDim == AlignedKernelDim &&
+        OutputCount == RowCount) {
+
+        A = static_cast<const uint8_t*>(Input);
+        lda = InputChannels;
+
+    } else {
+
+        MlasThreadedBufAlloc(RowCount * AlignedKernelDim);
+        uint8_t* a = ThreadedBufHolder.get();
+
+        for (size_t o = 0; o < OutputCount; o++) {
+
+            uint8_t* row = a + o * AlignedKernelDim;
+
+            if ((KernelFlags & MLAS_CONV_SYM_FLAG_INPUT_DIRECT) != 0) {
+                MlasConvSymAmxCopyRow(row, static_cast<const uint8_t*>(Input) + o * InputChannels,
+                    InputChannels);
+            } else {
+                const uint8_t* const* InputRows =
+                    static_cast<const uint8_t* const*>(Input) + o * KernelSize;
+                for (size_t k = 0; k < KernelSize; k++) {
+                    MlasConvSymAmxCopyRow(row + k * InputChannels, InputRows[k], InputChannels);
+                }
+            }
+
+            std::fill_n(row + KernelDim, AlignedKernelDim - KernelDim, uint8_t(0));
+        }
+
+        std::fill_n(a + OutputCount * AlignedKernelDim, (RowCount - OutputCount) * AlignedKernelDim,
+            uint8_t(0));
+
+        A = a;
+        lda = AlignedKernelDim;
+    }
+
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+
+    const __m512 MinimumValue = _mm512_set1_ps(PostProcessParams->MinimumValue);
+    const __m512 MaximumValue = _mm512_set1_ps(PostProcessParams->MaximumValue);
+    const __m512i OutputZeroPoint = _mm512_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    MLAS_DECLSPEC_ALIGN(int32_t Accumulators[4 * TileElements], 64);
+
+    const int8_t* filter = static_cast<const int8_t*>(Filter);
+
+    for (size_t n = 0; n < ChannelCount; n += 2 * MLAS_CONV_SYM_AMX_TILE_N) {
+
+        const size_t CountN = std::min<size_t>(ChannelCount - n, 2 * MLAS_CONV_SYM_AMX_TILE_N);
+        const int8_t* B = filter + n * AlignedKernelDim;
+
+        if (RowTiles > 1) {
+            if (CountN > MLAS_CONV_SYM_AMX_TILE_N) {
+                MlasConvSymAmxComputeBlock<InputIsSigned, 2, 2>(A, lda, B, AlignedKernelDim, Accumulators);
+            } else {
+                MlasConvSymAmxComputeBlock<InputIsSigned, 2, 1>(A, lda, B, AlignedKernelDim, Accumulators);
+            }
+        } else {
+            if (CountN > MLAS_CONV_SYM_AMX_TILE_N) {
+                MlasConvSymAmxComputeBlock<InputIsSigned, 1, 2>(A, lda, B, AlignedKernelDim, Accumulators);
+            } else {
+                MlasConvSymAmxComputeBlock<InputIsSigned, 1, 1>(A, lda, B, AlignedKernelDim, Accumulators);
+            }
+        }
+
+        //
+        // Add the bias, requantize and store the valid rows and columns.
+        //
+
+        for (size_t c = 0; c < CountN; c += MLAS_CONV_SYM_AMX_TILE_N) {
+
+            const size_t Channel = n + c;
+            const unsigned ValidCount = unsigned(std::min<size_t>(CountN - c, MLAS_CONV_SYM_AMX_TILE_N));
+            const __mmask16 Mask = __mmask16((1u << ValidCount) - 1);
+
+            const __m512i Bias = _mm512_maskz_loadu_epi32(Mask, PostProcessParams->Bias + Channel);
+            const __m512 Scale = PerChannelScale ?
+                _mm512_maskz_loadu_ps(Mask, PostProcessParams->Scale + Channel) :
+                _mm512_set1_ps(PostProcessParams->Scale[0]);
+
+            for (size_t o = 0; o < OutputCount; o++) {
+
+                const int32_t* Tile = Accumulators +
+                    ((o / MLAS_CONV_SYM_AMX_TILE_M) * 2 + c / MLAS_CONV_SYM_AMX_TILE_N) * TileElements;
+                const __m512i Accumulator = _mm512_add_epi32(
+                    _mm512_load_si512(Tile + (o % MLAS_CONV_SYM_AMX_TILE_M) * MLAS_CONV_SYM_AMX_TILE_N), Bias);
+
+                __m512 Value = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator), Scale);
+                Value = _mm512_min_ps(_mm512_max_ps(Value, MinimumValue), MaximumValue);
+
+                const __m512i Quantized = _mm512_add_epi32(_mm512_cvtps_epi32(Value), OutputZeroPoint);
+                const __m128i Packed = InputIsSigned ? _mm512_cvtsepi32_epi8(Quantized) :
+                    _mm512_cvtusepi32_epi8(Quantized);
+
+                _mm_mask_storeu_epi8(static_cast<uint8_t*>(Output) + o * OutputChannels + Channel, Mask, Packed);
+            }
+        }
+    }
+}
+
+extern "C" {
+
+void
+MLASCALL
+MlasConvSymKernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymKernelAmx<false>(Input, Filter, Output, KernelSize, InputChannels, OutputChannels,
+        ChannelCount, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymS8KernelAmx(
+    const void* Input,
+    const void* Filter,
+    void* Output,
+    size_t KernelSize,
+    size_t InputChannels,
+    size_t OutputChannels,
+    unsigned ChannelCount,
+    unsigned OutputCount,
+    const MLAS_CONV_SYM_POST_PROCESS_PARAMS* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymKernelAmx<true>(Input, Filter, Output, KernelSize, InputChannels, OutputChannels,
+        ChannelCount, OutputCount, PostProcessParams, KernelFlags);
+}
+
+}
@@ -0,0 +1,337 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    dynamicquantize.cpp
+
+Abstract:
+
+    This module implements routines that find the range of a single precision
+    buffer and quantize it with the derived asymmetric quantization parameters
+    in a single call.
+
+    The range of a whole tensor must be known before its first element can be
+    quantized, so the tensor is cut into contiguous per-thread ranges. Each
+    thread finds the range of its elements, the ranges are reduced, and each
+    thread then quantizes the same elements it just scanned, which are still
+    resident in its cache for typical activation sizes. Rows quantized with
+    their own parameters are handled in one pass per row.
+
+--*/
+
+#include "mlasi.h"
+
+#include <vector>
+
+//
+// Define the minimum number of elements handled by a thread. Smaller buffers
+// are not worth the cost of another thread.
+//
+
+#define MLAS_DYNAMIC_QUANTIZE_THREAD_ELEMENTS       (size_t(16) * size_t(1024))
+
+template<typename OutputType>
+void
+MlasDynamicQuantizeParameters(
+    float Minimum,
+    float Maximum,
+    float* Scale,
+    OutputType* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the asymmetric quantization parameters that map the
+    supplied range, widened to include zero, onto the full range of the output
+    type. This matches the definition of the DynamicQuantizeLinear operator.
+
+Arguments:
+
+    Minimum - Supplies the minimum value of the input.
+
+    Maximum - Supplies the maximum value of the input.
+
+    Scale - Returns the quantization scale.
+
+    ZeroPoint - Returns the quantization zero point.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr float MinimumValue = float(std::numeric_limits<OutputType>::lowest());
+    constexpr float MaximumValue = float(std::numeric_limits<OutputType>::max());
+
+    Minimum = std::min(Minimum, 0.0f);
+    Maximum = std::max(Maximum, 0.0f);
+
+    const float QuantScale = (Maximum == Minimum) ? 1.0f : (Maximum - Minimum) / (MaximumValue - MinimumValue);
+
+    const float InitialZeroPoint = MinimumValue - Minimum / QuantScale;
+
+    *Scale = QuantScale;
+    *ZeroPoint = OutputType(int32_t(std::nearbyintf(
+        std::max(MinimumValue, std::min(MaximumValue, InitialZeroPoint)))));
+}
+
+template<typename OutputType>
+void
+MLASCALL
+MlasDynamicQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    float* Scale,
+    OutputType* ZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the range of the input buffer, computes the asymmetric
+    quantization parameters for the range, and quantizes the input buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Returns the quantization scale.
+
+    ZeroPoint - Returns the quantization zero point.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Select the number of threads. Do not give a thread less than the
+    // minimum number of elements.
+    //
+
+    ptrdiff_t ThreadCount = ptrdiff_t(MlasDivRoundup(N, MLAS_DYNAMIC_QUANTIZE_THREAD_ELEMENTS));
+
+    ThreadCount = std::min(ThreadCount, MlasGetMaximumThreadCount(ThreadPool));
+
+    if (ThreadCount <= 1) {
+
+        float Minimum = 0.0f;
+        float Maximum = 0.0f;
+
+        if (N > 0) {
+            MlasFindMinMaxElement(Input, &Minimum, &Maximum, N);
+        }
+
+        MlasDynamicQuantizeParameters(Minimum, Maximum, Scale, ZeroPoint);
+        MlasQuantizeLinear(Input, Output, N, *Scale, *ZeroPoint);
+        return;
+    }
+
+    //
+    // Find the range of each thread's elements and then reduce the ranges.
+    //
+
+    std::vector<float> Ranges(size_t(ThreadCount) * 2);
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, N, &WorkIndex, &WorkRemaining);
+
+        float Minimum = 0.0f;
+        float Maximum = 0.0f;
+
+        if (WorkRemaining > 0) {
+            MlasFindMinMaxElement(Input + WorkIndex, &Minimum, &Maximum, WorkRemaining);
+        }
+
+        Ranges[size_t(tid) * 2 + 0] = Minimum;
+        Ranges[size_t(tid) * 2 + 1] = Maximum;
+    });
+
+    float Minimum = Ranges[0];
+    float Maximum = Ranges[1];
+
+    for (ptrdiff_t tid = 1; tid < ThreadCount; tid++) {
+        Minimum = std::min(Minimum, Ranges[size_t(tid) * 2 + 0]);
+        Maximum = std::max(Maximum, Ranges[size_t(tid) * 2 + 1]);
+    }
+
+    MlasDynamicQuantizeParameters(Minimum, Maximum, Scale, ZeroPoint);
+
+    //
+    // Quantize each thread's elements using the same partition as the range
+    // scan, so that the input is read back from the cache.
+    //
+
+    const float QuantScale = *Scale;
+    const OutputType QuantZeroPoint = *ZeroPoint;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, N, &WorkIndex, &WorkRemaining);
+
+        MlasQuantizeLinear(Input + WorkIndex, Output + WorkIndex, WorkRemaining,
+            QuantScale, QuantZeroPoint);
+    });
+}
+
+template<typename OutputType>
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow(
+    const float* Input,
+    size_t InputLeadingDimension,
+    OutputType* Output,
+    size_t OutputLeadingDimension,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    OutputType* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes each row of the input matrix with its own
+    asymmetric quantization parameters. The range of a row is found and the
+    row is quantized while it is still resident in the L1 cache.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    InputLeadingDimension - Supplies the number of elements per row of the
+        input matrix.
+
+    Output - Supplies the output matrix.
+
+    OutputLeadingDimension - Supplies the number of elements per row of the
+        output matrix.
+
+    Rows - Supplies the number of rows to process.
+
+    Columns - Supplies the number of columns to process.
+
+    Scales - Returns the quantization scale of each row.
+
+    ZeroPoints - Returns the quantization zero point of each row.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowsPerThread = MlasDivRoundup(MLAS_DYNAMIC_QUANTIZE_THREAD_ELEMENTS,
+        std::max(Columns, size_t(1)));
+
+    ptrdiff_t ThreadCount = ptrdiff_t(MlasDivRoundup(Rows, RowsPerThread));
+
+    ThreadCount = std::max(std::min(ThreadCount, MlasGetMaximumThreadCount(ThreadPool)),
+        ptrdiff_t(1));
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, Rows, &WorkIndex, &WorkRemaining);
+
+        for (size_t row = WorkIndex; row < WorkIndex + WorkRemaining; row++) {
+
+            const float* InputRow = Input + row * InputLeadingDimension;
+
+            float Minimum = 0.0f;
+            float Maximum = 0.0f;
+
+            if (Columns > 0) {
+                MlasFindMinMaxElement(InputRow, &Minimum, &Maximum, Columns);
+            }
+
+            MlasDynamicQuantizeParameters(Minimum, Maximum, &Scales[row], &ZeroPoints[row]);
+
+            MlasQuantizeLinear(InputRow, Output + row * OutputLeadingDimension, Columns,
+                Scales[row], ZeroPoints[row]);
+        }
+    });
+}
+
+template
+void
+MLASCALL
+MlasDynamicQuantizeLinear<int8_t>(
+    const float* Input,
+    int8_t* Output,
+    size_t N,
+    float* Scale,
+    int8_t* ZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasDynamicQuantizeLinear<uint8_t>(
+    const float* Input,
+    uint8_t* Output,
+    size_t N,
+    float* Scale,
+    uint8_t* ZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow<int8_t>(
+    const float* Input,
+    size_t InputLeadingDimension,
+    int8_t* Output,
+    size_t OutputLeadingDimension,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    int8_t* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasDynamicQuantizeLinearPerRow<uint8_t>(
+    const float* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    size_t Rows,
+    size_t Columns,
+    float* Scales,
+    uint8_t* ZeroPoints,
+    MLAS_THREADPOOL* ThreadPool
+    );
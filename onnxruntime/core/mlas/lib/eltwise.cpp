@@ -0,0 +1,641 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    eltwise.cpp
+
+Abstract:
+
+    This module implements the element-wise binary operations with the
+    broadcast of an input as a scalar, a row vector or a column vector.
+
+    The output is viewed as an M x N matrix. The work is split into ranges of
+    elements which are processed one row segment at a time, so a thread
+    handles a long contiguous run even when the rows are short. Within a row
+    segment, an input is either a vector or a scalar.
+
+    Half precision inputs are converted to float one block at a time and all
+    computation is done in float.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of half precision elements converted to float per block.
+//
+
+constexpr size_t MLAS_ELTWISE_BLOCK_ELEMENTS = 256;
+
+//
+// Minimum number of output elements to process per thread.
+//
+
+constexpr size_t MLAS_ELTWISE_MINIMUM_ELEMENTS_PER_THREAD = 16384;
+
+template<MLAS_ELTWISE_BINARY_OP Op, typename T>
+MLAS_FORCEINLINE
+T
+MlasEltwiseBinaryValue(
+    T ValueA,
+    T ValueB
+    )
+{
+    //
+    // The maximum and minimum return NaN if either value is NaN, which
+    // matches the vector kernels.
+    //
+
+    if constexpr (std::is_floating_point<T>::value) {
+        if (Op == MlasEltwiseMax || Op == MlasEltwiseMin) {
+            if (std::isnan(ValueA)) {
+                return ValueA;
+            }
+        }
+    }
+
+    switch (Op) {
+        case MlasEltwiseAdd:
+            return ValueA + ValueB;
+        case MlasEltwiseSub:
+            return ValueA - ValueB;
+        case MlasEltwiseMul:
+            return ValueA * ValueB;
+        case MlasEltwiseDiv:
+            return ValueA / ValueB;
+        case MlasEltwiseMax:
+            return (ValueA > ValueB) ? ValueA : ValueB;
+        case MlasEltwiseMin:
+        default:
+            return (ValueA < ValueB) ? ValueA : ValueB;
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasEltwiseBinaryFloat32x4(
+    MLAS_FLOAT32X4 VectorA,
+    MLAS_FLOAT32X4 VectorB
+    )
+{
+    switch (Op) {
+        case MlasEltwiseAdd:
+            return MlasAddFloat32x4(VectorA, VectorB);
+        case MlasEltwiseSub:
+            return MlasSubtractFloat32x4(VectorA, VectorB);
+        case MlasEltwiseMul:
+            return MlasMultiplyFloat32x4(VectorA, VectorB);
+        case MlasEltwiseDiv:
+            return MlasDivideFloat32x4(VectorA, VectorB);
+        //
+        // The maximum and minimum instructions return NaN if the second
+        // value is NaN on all platforms, but not always if the first value
+        // is NaN, so that case is selected explicitly.
+        //
+        case MlasEltwiseMax:
+            return MlasBlendFloat32x4(MlasMaximumFloat32x4(VectorA, VectorB), VectorA,
+                MlasIsNanFloat32x4(VectorA));
+        case MlasEltwiseMin:
+        default:
+            return MlasBlendFloat32x4(MlasMinimumFloat32x4(VectorA, VectorB), VectorA,
+                MlasIsNanFloat32x4(VectorA));
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op>
+MLAS_FORCEINLINE
+MLAS_INT32X4
+MlasEltwiseBinaryInt32x4(
+    MLAS_INT32X4 VectorA,
+    MLAS_INT32X4 VectorB
+    )
+{
+    switch (Op) {
+        case MlasEltwiseAdd:
+            return MlasAddInt32x4(VectorA, VectorB);
+        case MlasEltwiseSub:
+            return MlasSubtractInt32x4(VectorA, VectorB);
+        case MlasEltwiseMax:
+            return MlasMaximumInt32x4(VectorA, VectorB);
+        case MlasEltwiseMin:
+        default:
+            return MlasMinimumInt32x4(VectorA, VectorB);
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, bool ScalarA, bool ScalarB, typename T>
+void
+MlasEltwiseBinaryRowScalar(
+    const T* InputA,
+    const T* InputB,
+    T* Output,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Output[n] = MlasEltwiseBinaryValue<Op>(InputA[ScalarA ? 0 : n], InputB[ScalarB ? 0 : n]);
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, bool ScalarA, bool ScalarB>
+void
+MlasEltwiseBinaryRow(
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N
+    )
+{
+    const MLAS_FLOAT32X4 BroadcastA = MlasBroadcastFloat32x4(InputA);
+    const MLAS_FLOAT32X4 BroadcastB = MlasBroadcastFloat32x4(InputB);
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasEltwiseBinaryFloat32x4<Op>(
+            ScalarA ? BroadcastA : MlasLoadFloat32x4(InputA + n),
+            ScalarB ? BroadcastB : MlasLoadFloat32x4(InputB + n));
+        MLAS_FLOAT32X4 Vector1 = MlasEltwiseBinaryFloat32x4<Op>(
+            ScalarA ? BroadcastA : MlasLoadFloat32x4(InputA + n + 4),
+            ScalarB ? BroadcastB : MlasLoadFloat32x4(InputB + n + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasEltwiseBinaryFloat32x4<Op>(
+            ScalarA ? BroadcastA : MlasLoadFloat32x4(InputA + n + 8),
+            ScalarB ? BroadcastB : MlasLoadFloat32x4(InputB + n + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasEltwiseBinaryFloat32x4<Op>(
+            ScalarA ? BroadcastA : MlasLoadFloat32x4(InputA + n + 12),
+            ScalarB ? BroadcastB : MlasLoadFloat32x4(InputB + n + 12));
+
+        MlasStoreFloat32x4(Output + n, Vector0);
+        MlasStoreFloat32x4(Output + n + 4, Vector1);
+        MlasStoreFloat32x4(Output + n + 8, Vector2);
+        MlasStoreFloat32x4(Output + n + 12, Vector3);
+    }
+
+    for (; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasEltwiseBinaryFloat32x4<Op>(
+            ScalarA ? BroadcastA : MlasLoadFloat32x4(InputA + n),
+            ScalarB ? BroadcastB : MlasLoadFloat32x4(InputB + n));
+
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    MlasEltwiseBinaryRowScalar<Op, ScalarA, ScalarB>(ScalarA ? InputA : InputA + n,
+        ScalarB ? InputB : InputB + n, Output + n, N - n);
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, bool ScalarA, bool ScalarB>
+void
+MlasEltwiseBinaryRow(
+    const int32_t* InputA,
+    const int32_t* InputB,
+    int32_t* Output,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+    //
+    // There is no portable vector multiply or divide of 32-bit integers, so
+    // these are left to the compiler.
+    //
+
+    if (Op != MlasEltwiseMul && Op != MlasEltwiseDiv) {
+
+        const MLAS_INT32X4 BroadcastA = MlasBroadcastInt32x4(*InputA);
+        const MLAS_INT32X4 BroadcastB = MlasBroadcastInt32x4(*InputB);
+
+        for (; n + 8 <= N; n += 8) {
+
+            MLAS_INT32X4 Vector0 = MlasEltwiseBinaryInt32x4<Op>(
+                ScalarA ? BroadcastA : MlasLoadInt32x4(InputA + n),
+                ScalarB ? BroadcastB : MlasLoadInt32x4(InputB + n));
+            MLAS_INT32X4 Vector1 = MlasEltwiseBinaryInt32x4<Op>(
+                ScalarA ? BroadcastA : MlasLoadInt32x4(InputA + n + 4),
+                ScalarB ? BroadcastB : MlasLoadInt32x4(InputB + n + 4));
+
+            MlasStoreInt32x4(Output + n, Vector0);
+            MlasStoreInt32x4(Output + n + 4, Vector1);
+        }
+
+        for (; n + 4 <= N; n += 4) {
+
+            MLAS_INT32X4 Vector = MlasEltwiseBinaryInt32x4<Op>(
+                ScalarA ? BroadcastA : MlasLoadInt32x4(InputA + n),
+                ScalarB ? BroadcastB : MlasLoadInt32x4(InputB + n));
+
+            MlasStoreInt32x4(Output + n, Vector);
+        }
+    }
+
+    MlasEltwiseBinaryRowScalar<Op, ScalarA, ScalarB>(ScalarA ? InputA : InputA + n,
+        ScalarB ? InputB : InputB + n, Output + n, N - n);
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, bool ScalarA, bool ScalarB>
+void
+MlasEltwiseBinaryRow(
+    const int64_t* InputA,
+    const int64_t* InputB,
+    int64_t* Output,
+    size_t N
+    )
+{
+    MlasEltwiseBinaryRowScalar<Op, ScalarA, ScalarB>(InputA, InputB, Output, N);
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, typename T>
+void
+MlasEltwiseBinaryRow(
+    const T* InputA,
+    const T* InputB,
+    T* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+{
+    if (ScalarA) {
+        if (ScalarB) {
+            MlasEltwiseBinaryRow<Op, true, true>(InputA, InputB, Output, N);
+        } else {
+            MlasEltwiseBinaryRow<Op, true, false>(InputA, InputB, Output, N);
+        }
+    } else {
+        if (ScalarB) {
+            MlasEltwiseBinaryRow<Op, false, true>(InputA, InputB, Output, N);
+        } else {
+            MlasEltwiseBinaryRow<Op, false, false>(InputA, InputB, Output, N);
+        }
+    }
+}
+
+template<typename T>
+void
+MlasEltwiseBinaryRow(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const T* InputA,
+    const T* InputB,
+    T* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+{
+    switch (Op) {
+        case MlasEltwiseAdd:
+            MlasEltwiseBinaryRow<MlasEltwiseAdd>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseSub:
+            MlasEltwiseBinaryRow<MlasEltwiseSub>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMul:
+            MlasEltwiseBinaryRow<MlasEltwiseMul>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseDiv:
+            MlasEltwiseBinaryRow<MlasEltwiseDiv>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMax:
+            MlasEltwiseBinaryRow<MlasEltwiseMax>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMin:
+            MlasEltwiseBinaryRow<MlasEltwiseMin>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasEltwiseBinaryF32Kernel(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a binary operation over a row segment.
+
+Arguments:
+
+    Op - Supplies the binary operation.
+
+    InputA - Supplies the first input vector, or the first input value if
+        ScalarA is true.
+
+    InputB - Supplies the second input vector, or the second input value if
+        ScalarB is true.
+
+    Output - Supplies the output vector.
+
+    N - Supplies the number of elements to process.
+
+    ScalarA - Supplies true if the first input is broadcast.
+
+    ScalarB - Supplies true if the second input is broadcast.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasEltwiseBinaryRow(Op, InputA, InputB, Output, N, ScalarA, ScalarB);
+}
+
+MLAS_FORCEINLINE
+void
+MlasEltwiseBinarySegment(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().EltwiseBinaryF32Kernel(Op, InputA, InputB, Output, N, ScalarA, ScalarB);
+#else
+    MlasEltwiseBinaryF32Kernel(Op, InputA, InputB, Output, N, ScalarA, ScalarB);
+#endif
+}
+
+template<typename T>
+MLAS_FORCEINLINE
+void
+MlasEltwiseBinarySegment(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const T* InputA,
+    const T* InputB,
+    T* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+{
+    MlasEltwiseBinaryRow(Op, InputA, InputB, Output, N, ScalarA, ScalarB);
+}
+
+void
+MlasEltwiseBinarySegment(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const MLAS_FP16* InputA,
+    const MLAS_FP16* InputB,
+    MLAS_FP16* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a binary operation over a half precision row
+    segment by converting blocks of the inputs to float.
+
+--*/
+{
+    float BufferA[MLAS_ELTWISE_BLOCK_ELEMENTS];
+    float BufferB[MLAS_ELTWISE_BLOCK_ELEMENTS];
+    float BufferOutput[MLAS_ELTWISE_BLOCK_ELEMENTS];
+
+    if (ScalarA) {
+        BufferA[0] = InputA[0].ToFloat();
+    }
+
+    if (ScalarB) {
+        BufferB[0] = InputB[0].ToFloat();
+    }
+
+    for (size_t n = 0; n < N; n += MLAS_ELTWISE_BLOCK_ELEMENTS) {
+
+        const size_t CountN = std::min(N - n, MLAS_ELTWISE_BLOCK_ELEMENTS);
+
+        if (!ScalarA) {
+            for (size_t i = 0; i < CountN; i++) {
+                BufferA[i] = InputA[n + i].ToFloat();
+            }
+        }
+
+        if (!ScalarB) {
+            for (size_t i = 0; i < CountN; i++) {
+                BufferB[i] = InputB[n + i].ToFloat();
+            }
+        }
+
+        MlasEltwiseBinarySegment(Op, BufferA, BufferB, BufferOutput, CountN, ScalarA, ScalarB);
+
+        for (size_t i = 0; i < CountN; i++) {
+            Output[n + i] = MLAS_FP16(BufferOutput[i]);
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasEltwiseBinaryOffset(
+    MLAS_BROADCAST_SHAPE Shape,
+    size_t m,
+    size_t n,
+    size_t N
+    )
+{
+    switch (Shape) {
+        case MlasBroadcastScalar:
+            return 0;
+        case MlasBroadcastRow:
+            return n;
+        case MlasBroadcastColumn:
+            return m;
+        case MlasBroadcastNone:
+        default:
+            return m * N + n;
+    }
+}
+
+template<typename T>
+void
+MlasEltwiseBinaryRange(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const T* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const T* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    T* Output,
+    size_t N,
+    size_t Start,
+    size_t End
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output elements in the range [Start, End) one
+    row segment at a time.
+
+--*/
+{
+    const bool ScalarA = (ShapeA == MlasBroadcastScalar || ShapeA == MlasBroadcastColumn);
+    const bool ScalarB = (ShapeB == MlasBroadcastScalar || ShapeB == MlasBroadcastColumn);
+
+    size_t Index = Start;
+
+    while (Index < End) {
+
+        const size_t m = Index / N;
+        const size_t n = Index % N;
+        const size_t CountN = std::min(N - n, End - Index);
+
+        MlasEltwiseBinarySegment(Op, InputA + MlasEltwiseBinaryOffset(ShapeA, m, n, N),
+            InputB + MlasEltwiseBinaryOffset(ShapeB, m, n, N), Output + Index, CountN,
+            ScalarA, ScalarB);
+
+        Index += CountN;
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasEltwiseBinary(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const T* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const T* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    T* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a binary operation over an M x N output after
+    broadcasting each input from its shape.
+
+Arguments:
+
+    Op - Supplies the binary operation.
+
+    InputA - Supplies the first input.
+
+    ShapeA - Supplies the broadcast shape of the first input.
+
+    InputB - Supplies the second input.
+
+    ShapeB - Supplies the broadcast shape of the second input.
+
+    Output - Supplies the M x N output.
+
+    M - Supplies the number of output rows.
+
+    N - Supplies the number of output columns.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TotalElements = M * N;
+
+    if (TotalElements == 0) {
+        return;
+    }
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (TotalElements / MLAS_ELTWISE_MINIMUM_ELEMENTS_PER_THREAD) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t Start;
+        size_t Count;
+
+        MlasPartitionWork(tid, ThreadCount, TotalElements, &Start, &Count);
+
+        MlasEltwiseBinaryRange(Op, InputA, ShapeA, InputB, ShapeB, Output, N, Start, Start + Count);
+    });
+}
+
+template
+void
+MLASCALL
+MlasEltwiseBinary<float>(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const float* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const float* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    float* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasEltwiseBinary<MLAS_FP16>(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const MLAS_FP16* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const MLAS_FP16* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    MLAS_FP16* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasEltwiseBinary<int32_t>(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const int32_t* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const int32_t* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    int32_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasEltwiseBinary<int64_t>(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const int64_t* InputA,
+    MLAS_BROADCAST_SHAPE ShapeA,
+    const int64_t* InputB,
+    MLAS_BROADCAST_SHAPE ShapeB,
+    int64_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
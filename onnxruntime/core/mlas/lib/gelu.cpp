@@ -0,0 +1,302 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    gelu.cpp
+
+Abstract:
+
+    This module implements routines to compute the GELU activation and its
+    tanh and sigmoid approximations, with an optional bias add.
+
+    The input is processed in blocks that stay in the L1 cache: the biased
+    input and the argument of the transcendental function are formed in one
+    loop, the platform erf, tanh or logistic kernel is applied to the block
+    and the result is combined in a last loop. The data is read and written
+    once and no intermediate buffer is allocated.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements processed per block.
+//
+
+constexpr size_t MLAS_GELU_BLOCK_ELEMENTS = 256;
+
+static const struct {
+    float Half;
+    float One;
+    float ErfScale;
+    float TanhScale;
+    float TanhCubeScale;
+} MlasGeluConstants = {
+    0.5f,
+    1.0f,
+    0.70710678118654752f,   // sqrt(1 / 2)
+    0.79788456080286536f,   // sqrt(2 / pi)
+    0.03567740813630011f,   // 0.044715 * sqrt(2 / pi)
+};
+
+template<MLAS_GELU_KIND Kind>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasGeluArgument(
+    MLAS_FLOAT32X4 Value,
+    float Alpha
+    )
+{
+    if (Kind == MlasGeluErf) {
+        return MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(MlasGeluConstants.ErfScale));
+    } else if (Kind == MlasGeluTanh) {
+        MLAS_FLOAT32X4 Square = MlasMultiplyFloat32x4(Value, Value);
+        MLAS_FLOAT32X4 Scale = MlasMultiplyAddFloat32x4(Square, MlasBroadcastFloat32x4(MlasGeluConstants.TanhCubeScale),
+            MlasBroadcastFloat32x4(MlasGeluConstants.TanhScale));
+        return MlasMultiplyFloat32x4(Value, Scale);
+    } else {
+        return MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(Alpha));
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasGeluArgument(
+    float Value,
+    float Alpha
+    )
+{
+    if (Kind == MlasGeluErf) {
+        return Value * MlasGeluConstants.ErfScale;
+    } else if (Kind == MlasGeluTanh) {
+        return Value * (Value * Value * MlasGeluConstants.TanhCubeScale + MlasGeluConstants.TanhScale);
+    } else {
+        return Value * Alpha;
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasGeluCombine(
+    MLAS_FLOAT32X4 Value,
+    MLAS_FLOAT32X4 Function
+    )
+{
+    if (Kind == MlasGeluQuick) {
+        return MlasMultiplyFloat32x4(Value, Function);
+    } else {
+        MLAS_FLOAT32X4 HalfValue = MlasMultiplyFloat32x4(Value, MlasBroadcastFloat32x4(MlasGeluConstants.Half));
+        return MlasMultiplyAddFloat32x4(HalfValue, Function, HalfValue);
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasGeluCombine(
+    float Value,
+    float Function
+    )
+{
+    if (Kind == MlasGeluQuick) {
+        return Value * Function;
+    } else {
+        return MlasGeluConstants.Half * Value * (Function + MlasGeluConstants.One);
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+MLAS_FORCEINLINE
+void
+MlasGeluFunction(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+{
+    if (Kind == MlasGeluErf) {
+        MlasComputeErf(Input, Output, N);
+    } else if (Kind == MlasGeluTanh) {
+        MlasComputeTanh(Input, Output, N);
+    } else {
+        MlasComputeLogistic(Input, Output, N);
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+void
+MlasGeluBlock(
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the GELU activation of a block that fits in the
+    local buffers.
+
+Arguments:
+
+    Input - Supplies the input block.
+
+    Bias - Supplies the optional bias block.
+
+    Output - Supplies the output block.
+
+    N - Supplies the number of elements, up to MLAS_GELU_BLOCK_ELEMENTS.
+
+    Alpha - Supplies the scale of the sigmoid argument for MlasGeluQuick.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Value[MLAS_GELU_BLOCK_ELEMENTS], 64);
+    MLAS_DECLSPEC_ALIGN(float Function[MLAS_GELU_BLOCK_ELEMENTS], 64);
+
+    size_t n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+
+        if (Bias != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+        }
+
+        MlasStoreAlignedFloat32x4(Value + n, Vector);
+        MlasStoreFloat32x4(Output + n, MlasGeluArgument<Kind>(Vector, Alpha));
+    }
+
+    for (; n < N; n++) {
+
+        float Scalar = Input[n];
+
+        if (Bias != nullptr) {
+            Scalar += Bias[n];
+        }
+
+        Value[n] = Scalar;
+        Output[n] = MlasGeluArgument<Kind>(Scalar, Alpha);
+    }
+
+    //
+    // The argument is staged in the output block, which may alias the input
+    // block as each element is read before it is written. The transcendental
+    // function then only reads elements written above.
+    //
+
+    MlasGeluFunction<Kind>(Output, Function, N);
+
+    for (n = 0; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasGeluCombine<Kind>(MlasLoadFloat32x4(Value + n),
+            MlasLoadFloat32x4(Function + n));
+
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < N; n++) {
+        Output[n] = MlasGeluCombine<Kind>(Value[n], Function[n]);
+    }
+}
+
+template<MLAS_GELU_KIND Kind>
+void
+MlasGeluRows(
+    const float* Input,
+    const float* Bias,
+    size_t BiasLength,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+{
+    const size_t RowLength = (Bias != nullptr) ? BiasLength : N;
+
+    while (N > 0) {
+
+        const size_t CountRow = std::min(RowLength, N);
+
+        for (size_t n = 0; n < CountRow; n += MLAS_GELU_BLOCK_ELEMENTS) {
+
+            const size_t CountN = std::min(CountRow - n, MLAS_GELU_BLOCK_ELEMENTS);
+
+            MlasGeluBlock<Kind>(Input + n, (Bias != nullptr) ? Bias + n : nullptr, Output + n, CountN, Alpha);
+        }
+
+        Input += CountRow;
+        Output += CountRow;
+        N -= CountRow;
+    }
+}
+
+void
+MLASCALL
+MlasComputeGelu(
+    MLAS_GELU_KIND Kind,
+    const float* Input,
+    const float* Bias,
+    size_t BiasLength,
+    float* Output,
+    size_t N,
+    float Alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the GELU activation after optionally adding a bias
+    vector.
+
+Arguments:
+
+    Kind - Supplies the GELU formulation.
+
+    Input - Supplies the input buffer.
+
+    Bias - Supplies the optional bias vector, repeated over the input.
+
+    BiasLength - Supplies the number of elements of the bias vector. N must
+        be a multiple of this value.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Alpha - Supplies the scale of the sigmoid argument for MlasGeluQuick.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Bias != nullptr && BiasLength == 0) {
+        return;
+    }
+
+    switch (Kind) {
+        case MlasGeluErf:
+            MlasGeluRows<MlasGeluErf>(Input, Bias, BiasLength, Output, N, Alpha);
+            break;
+        case MlasGeluTanh:
+            MlasGeluRows<MlasGeluTanh>(Input, Bias, BiasLength, Output, N, Alpha);
+            break;
+        case MlasGeluQuick:
+            MlasGeluRows<MlasGeluQuick>(Input, Bias, BiasLength, Output, N, Alpha);
+            break;
+    }
+}
@@ -27,11 +27,19 @@ MlasFp16AccelerationSupported()
 {
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
     return MLAS_CPUIDINFO::GetCPUIDInfo().HasFp16VectorAcceleration();
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch != &MlasHalfGemmDispatchDefault;
 #else
     return false;
 #endif
 }
 
+bool MLASCALL
+MlasHalfGemmFloatAccumulation()
+{
+    return MlasHalfGemmGetDispatch()->FloatAccumulation;
+}
+
 
 void
 MLASCALL
@@ -75,38 +83,33 @@ MlasHalfGemmBatch(
         ThreadsPerGemm = 1;
     }
 
-    const size_t StrideM = dispatch->StrideM;
+    //
+    // Segment each operation into tiles of the output matrix using the cache
+    // aware partitioner, keeping the rows of a tile a multiple of the kernel
+    // stride.
+    //
 
-    size_t nc = N;
-    if ((size_t)MlasGetMaximumThreadCount(ThreadPool) > BatchN) {
-        // more than one thread per GEMM
+    MLAS_GEMM_THREAD_PARTITION Partition;
 
-        const size_t BlockedM = MlasDivRoundup(M, StrideM);
-        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
-        if (max_nc < nc) {
-            nc = std::min(nc, MlasDivRoundup(nc, max_nc * MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
-                                  MLAS_QGEMM_STRIDEN_THREAD_ALIGN);
-        }
-    }
-    const size_t StrideN = nc;
+    MlasGemmPartitionThreads(M, N, K, dispatch->StrideM, MLAS_QGEMM_STRIDEN_THREAD_ALIGN,
+        sizeof(MLAS_FP16), sizeof(MLAS_FP16), ThreadsPerGemm, 0, &Partition);
 
-    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
-    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
-    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+    ThreadsPerGemm = Partition.ThreadCount();
 
     MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
         const auto gemm_i = tid / ThreadsPerGemm;
         const auto blk_i = tid % ThreadsPerGemm;
         auto Data = &DataParams[gemm_i];
 
-        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
-        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
-
-        const size_t RangeStartM = ThreadIdM * StrideM;
-        const size_t RangeCountM = std::min(M - RangeStartM, (size_t)StrideM);
+        size_t RangeStartM;
+        size_t RangeCountM;
+        size_t RangeStartN;
+        size_t RangeCountN;
+        size_t RangeStartK;
+        size_t RangeCountK;
 
-        const size_t RangeStartN = ThreadIdN * StrideN;
-        const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
+        MlasGemmPartitionRange(Partition, blk_i, M, N, K, &RangeStartM, &RangeCountM,
+            &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
 
         operation(N, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
     });
@@ -331,5 +334,6 @@ const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault = {
     MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_DEFAULT>,
     MLAS_HALF_GEMM_KERNEL_DEFAULT::PackedK,
     MLAS_HALF_GEMM_KERNEL_DEFAULT::KernelMaxM,
-    0
+    0,
+    false
 };
@@ -212,60 +212,74 @@ MlasHalfGemmNoPackOperation(
     //
 
     const size_t lda = Data->lda;
-    size_t ldb = Data->ldb;  // 0 if prepacked
+    const size_t ldb = Data->ldb;  // 0 if prepacked
     const size_t ldc = Data->ldc;
 
-    const auto* pa = reinterpret_cast<const _mlas_fp16_*>(Data->A)
-        + RangeStartM * lda;
-    const _mlas_fp16_* pb;
-    if (ldb == 0) {
-        pb = MlasHalfGemmPackedBOffset<KernelType>(
-            reinterpret_cast<const _mlas_fp16_*>(Data->B),
-            N,
-            K,
-            RangeStartN,
-            0);
-        ldb = MlasHalfGemmPackedBLeadingDim<KernelType>(N, K);
-    } else {
-        pb = reinterpret_cast<const _mlas_fp16_*>(Data->B) + RangeStartN;
-    }
-
-    const _mlas_fp16_* Bias = (nullptr == Data->Bias)
-        ? nullptr
-        : reinterpret_cast<const _mlas_fp16_*>(Data->Bias) + RangeStartN;
-    _mlas_fp16_* c = reinterpret_cast<_mlas_fp16_*>(Data->C)
-        + RangeStartM * ldc + RangeStartN;
+    //
+    // Step through matrix B in panels along the N dimension, so that a panel
+    // stays in cache while all rows of matrix A are multiplied with it.
+    //
 
-    size_t RowsRemaining = RangeCountM;
-    while (RowsRemaining > 0) {
-        MlasHalfGemmKernel<KernelType>(
-            RowsRemaining,
-            RangeCountN,
-            K,
-            c,
-            ldc,
-            Bias,
-            pa,
-            lda,
-            pb,
-            ldb,
-            true);
-
-        size_t RowsHandled = std::min(RowsRemaining, KernelType::KernelMaxM);
-
-        if (Data->OutputProcessor != nullptr) {
-            Data->OutputProcessor->Process(
-                Data->C,
-                RangeStartM + RangeCountM - RowsRemaining,
-                RangeStartN,
-                RowsHandled,
-                RangeCountN,
-                Data->ldc);
+    constexpr size_t StrideN = KernelType::Strides.N;
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, StrideN);
+
+        const _mlas_fp16_* pb;
+        size_t ld_pb;
+        if (ldb == 0) {
+            pb = MlasHalfGemmPackedBOffset<KernelType>(
+                reinterpret_cast<const _mlas_fp16_*>(Data->B),
+                N,
+                K,
+                RangeStartN + n,
+                0);
+            ld_pb = MlasHalfGemmPackedBLeadingDim<KernelType>(N, K);
+        } else {
+            pb = reinterpret_cast<const _mlas_fp16_*>(Data->B) + RangeStartN + n;
+            ld_pb = ldb;
         }
 
-        c += ldc * RowsHandled;
-        pa += lda * RowsHandled;
-        RowsRemaining -= RowsHandled;
+        const auto* pa = reinterpret_cast<const _mlas_fp16_*>(Data->A)
+            + RangeStartM * lda;
+        const _mlas_fp16_* Bias = (nullptr == Data->Bias)
+            ? nullptr
+            : reinterpret_cast<const _mlas_fp16_*>(Data->Bias) + RangeStartN + n;
+        _mlas_fp16_* c = reinterpret_cast<_mlas_fp16_*>(Data->C)
+            + RangeStartM * ldc + RangeStartN + n;
+
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+            MlasHalfGemmKernel<KernelType>(
+                RowsRemaining,
+                CountN,
+                K,
+                c,
+                ldc,
+                Bias,
+                pa,
+                lda,
+                pb,
+                ld_pb,
+                true);
+
+            size_t RowsHandled = std::min(RowsRemaining, KernelType::KernelMaxM);
+
+            if (Data->OutputProcessor != nullptr) {
+                Data->OutputProcessor->Process(
+                    Data->C,
+                    RangeStartM + RangeCountM - RowsRemaining,
+                    RangeStartN + n,
+                    RowsHandled,
+                    CountN,
+                    Data->ldc);
+            }
+
+            c += ldc * RowsHandled;
+            pa += lda * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
     }
 }
 
@@ -495,6 +509,7 @@ struct MLAS_HALFGEMM_DISPATCH {
     size_t PackededK;
     size_t StrideM;
     size_t BufOverRead;
+    bool FloatAccumulation; /**< Kernel accumulates in single precision instead of rounding each multiply-add */
 };
 
 extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
@@ -509,6 +524,8 @@ MlasHalfGemmGetDispatch()
 {
 #if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
     return &MlasHalfGemmDispatchNeon;
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch;
 #else
     return &MlasHalfGemmDispatchDefault;
 #endif
@@ -0,0 +1,349 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 processors
+    without native fp16 arithmetic.
+
+    This implementation uses F16C instructions to convert fp16 elements of
+    the A and B matrices to fp32 and FMA3 instructions to accumulate in fp32.
+    The result is rounded back to fp16 when the tile is stored to matrix C.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+//
+// Helpers to load and store a vector of 8 fp16 elements. The partial variants
+// handle the tail of a row without touching memory beyond the row.
+//
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadHalf8Avx2(
+    const _mlas_fp16_* Buffer
+    )
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer)));
+}
+
+MLAS_FORCEINLINE
+__m256
+MlasLoadPartialHalf8Avx2(
+    const _mlas_fp16_* Buffer,
+    size_t Count
+    )
+{
+    __m128i Vector = _mm_setzero_si128();
+    std::memcpy(&Vector, Buffer, Count * sizeof(_mlas_fp16_));
+    return _mm256_cvtph_ps(Vector);
+}
+
+MLAS_FORCEINLINE
+void
+MlasStoreHalf8Avx2(
+    _mlas_fp16_* Buffer,
+    __m256 Vector
+    )
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(Buffer), _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT));
+}
+
+MLAS_FORCEINLINE
+void
+MlasStorePartialHalf8Avx2(
+    _mlas_fp16_* Buffer,
+    __m256 Vector,
+    size_t Count
+    )
+{
+    __m128i HalfVector = _mm256_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT);
+    std::memcpy(Buffer, &HalfVector, Count * sizeof(_mlas_fp16_));
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfAvx2(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+    )
+{
+    while (len >= 8) {
+        __m256 Vector = _mm256_loadu_ps(src);
+        MlasStoreHalf8Avx2(dest, Vector);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    if (len > 0) {
+        float buf[8] = {};
+        std::memcpy(buf, src, len * sizeof(float));
+        MlasStorePartialHalf8Avx2(dest, _mm256_loadu_ps(buf), len);
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx2(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2HalfAvx2(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfAvx2(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx2(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx2(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute a tile of RowCount rows by up to 16 columns of matrix C.
+ *
+ * Elements of A are converted to fp32 eight columns at a time into a small
+ * stack buffer so that the inner loop only needs broadcasts from memory.
+ *
+ * @tparam RowCount        Number of rows of the tile, 1 to KernelMaxM
+ * @tparam PartialColumns  Whether the tile has less than 16 columns
+ */
+template<size_t RowCount, bool PartialColumns>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx2Block(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    const size_t CountN0 = PartialColumns ? std::min(CountN, size_t(8)) : 8;
+    const size_t CountN1 = PartialColumns ? CountN - CountN0 : 8;
+
+    __m256 Accumulators[RowCount][2];
+
+    __m256 BiasVector0 = _mm256_setzero_ps();
+    __m256 BiasVector1 = _mm256_setzero_ps();
+
+    if (Bias != nullptr) {
+        if (PartialColumns) {
+            BiasVector0 = MlasLoadPartialHalf8Avx2(Bias, CountN0);
+            BiasVector1 = MlasLoadPartialHalf8Avx2(Bias + 8, CountN1);
+        } else {
+            BiasVector0 = MlasLoadHalf8Avx2(Bias);
+            BiasVector1 = MlasLoadHalf8Avx2(Bias + 8);
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = BiasVector0;
+        Accumulators[r][1] = BiasVector1;
+    }
+
+    MLAS_DECLSPEC_ALIGN(float ABuffer[RowCount][8], 32);
+
+    size_t k = 0;
+
+    while (k < CountK) {
+
+        const size_t CountKBlock = std::min(CountK - k, size_t(8));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            __m256 AVector = (CountKBlock == 8) ? MlasLoadHalf8Avx2(A + r * lda + k)
+                                                : MlasLoadPartialHalf8Avx2(A + r * lda + k, CountKBlock);
+            _mm256_store_ps(ABuffer[r], AVector);
+        }
+
+        const _mlas_fp16_* b = B + k * ldb;
+
+        for (size_t kk = 0; kk < CountKBlock; kk++) {
+
+            __m256 BElements0;
+            __m256 BElements1;
+
+            if (PartialColumns) {
+                BElements0 = MlasLoadPartialHalf8Avx2(b, CountN0);
+                BElements1 = MlasLoadPartialHalf8Avx2(b + 8, CountN1);
+            } else {
+                BElements0 = MlasLoadHalf8Avx2(b);
+                BElements1 = MlasLoadHalf8Avx2(b + 8);
+            }
+
+            for (size_t r = 0; r < RowCount; r++) {
+                __m256 ABroadcast = _mm256_broadcast_ss(&ABuffer[r][kk]);
+                Accumulators[r][0] = _mm256_fmadd_ps(ABroadcast, BElements0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(ABroadcast, BElements1, Accumulators[r][1]);
+            }
+
+            b += ldb;
+        }
+
+        k += CountKBlock;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        _mlas_fp16_* c = C + r * ldc;
+
+        if (PartialColumns) {
+            if (!ZeroMode) {
+                Accumulators[r][0] = _mm256_add_ps(Accumulators[r][0], MlasLoadPartialHalf8Avx2(c, CountN0));
+                Accumulators[r][1] = _mm256_add_ps(Accumulators[r][1], MlasLoadPartialHalf8Avx2(c + 8, CountN1));
+            }
+            MlasStorePartialHalf8Avx2(c, Accumulators[r][0], CountN0);
+            MlasStorePartialHalf8Avx2(c + 8, Accumulators[r][1], CountN1);
+        } else {
+            if (!ZeroMode) {
+                Accumulators[r][0] = _mm256_add_ps(Accumulators[r][0], MlasLoadHalf8Avx2(c));
+                Accumulators[r][1] = _mm256_add_ps(Accumulators[r][1], MlasLoadHalf8Avx2(c + 8));
+            }
+            MlasStoreHalf8Avx2(c, Accumulators[r][0]);
+            MlasStoreHalf8Avx2(c + 8, Accumulators[r][1]);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx2Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN >= 16) {
+        MlasHalfGemmKernelAvx2Block<RowCount, false>(
+            16, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+
+        C += 16;
+        B += 16;
+        if (Bias != nullptr) {
+            Bias += 16;
+        }
+        CountN -= 16;
+    }
+
+    if (CountN > 0) {
+        MlasHalfGemmKernelAvx2Block<RowCount, true>(
+            CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmKernelAvx2Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx2Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx2Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx2Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmKernelAvx2Rows<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx2Rows<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0,
+    true // F16C has no fp16 arithmetic, inputs are converted and accumulated in fp32
+};
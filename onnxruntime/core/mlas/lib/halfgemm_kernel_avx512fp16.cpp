@@ -0,0 +1,266 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for x64 processors
+    with native fp16 arithmetic.
+
+    This implementation uses AVX512-FP16 instructions. Like the NEON kernel,
+    products are accumulated in fp16.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+__mmask32
+MlasHalfGemmColumnMaskAvx512Fp16(
+    size_t Count
+    )
+{
+    return (Count >= 32) ? __mmask32(0xFFFFFFFF) : __mmask32((uint32_t(1) << Count) - 1);
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+    )
+{
+    while (len >= 16) {
+        __m256i Vector = _mm512_cvtps_ph(_mm512_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), Vector);
+        src += 16;
+        dest += 16;
+        len -= 16;
+    }
+
+    if (len > 0) {
+        const __mmask16 mask = __mmask16((1u << len) - 1);
+        __m256i Vector = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(mask, src), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_mask_storeu_epi16(dest, mask, Vector);
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2HalfAvx512Fp16(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfAvx512Fp16(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute a tile of RowCount rows by up to 64 columns of matrix C.
+ *
+ * @tparam RowCount  Number of rows of the tile, 1 to KernelMaxM
+ */
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512Fp16Block(
+    __mmask32 Mask0,
+    __mmask32 Mask1,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    __m512h Accumulators[RowCount][2];
+
+    __m512h BiasVector0 = _mm512_setzero_ph();
+    __m512h BiasVector1 = _mm512_setzero_ph();
+
+    if (Bias != nullptr) {
+        BiasVector0 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, Bias));
+        BiasVector1 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, Bias + 32));
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = BiasVector0;
+        Accumulators[r][1] = BiasVector1;
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        const __m512h BElements0 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, B));
+        const __m512h BElements1 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, B + 32));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512h ABroadcast = _mm512_set1_ph(*reinterpret_cast<const _Float16*>(&A[r * lda + k]));
+            Accumulators[r][0] = _mm512_fmadd_ph(ABroadcast, BElements0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm512_fmadd_ph(ABroadcast, BElements1, Accumulators[r][1]);
+        }
+
+        B += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        _mlas_fp16_* c = C + r * ldc;
+
+        if (!ZeroMode) {
+            Accumulators[r][0] = _mm512_add_ph(Accumulators[r][0],
+                _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, c)));
+            Accumulators[r][1] = _mm512_add_ph(Accumulators[r][1],
+                _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, c + 32)));
+        }
+
+        _mm512_mask_storeu_epi16(c, Mask0, _mm512_castph_si512(Accumulators[r][0]));
+        _mm512_mask_storeu_epi16(c + 32, Mask1, _mm512_castph_si512(Accumulators[r][1]));
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx512Fp16Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+
+        const size_t CountNBlock = std::min(CountN, size_t(64));
+        const __mmask32 Mask0 = MlasHalfGemmColumnMaskAvx512Fp16(CountNBlock);
+        const __mmask32 Mask1 = MlasHalfGemmColumnMaskAvx512Fp16(
+            CountNBlock > 32 ? CountNBlock - 32 : 0);
+
+        MlasHalfGemmKernelAvx512Fp16Block<RowCount>(
+            Mask0, Mask1, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+
+        C += CountNBlock;
+        B += CountNBlock;
+        if (Bias != nullptr) {
+            Bias += CountNBlock;
+        }
+        CountN -= CountNBlock;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmKernelAvx512Fp16Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx512Fp16Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx512Fp16Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 4:
+            MlasHalfGemmKernelAvx512Fp16Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 5:
+            MlasHalfGemmKernelAvx512Fp16Rows<5>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx512Fp16Rows<6>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0,
+    false
+};
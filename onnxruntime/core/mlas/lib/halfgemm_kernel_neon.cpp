@@ -183,5 +183,6 @@ const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchNeon = {
     MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_NEON>,
     MLAS_HALF_GEMM_KERNEL_NEON::PackedK,
     MLAS_HALF_GEMM_KERNEL_NEON::KernelMaxM,
-    32 // kernel may read beyond buffer end by 32 bytes
+    32, // kernel may read beyond buffer end by 32 bytes
+    false
 };
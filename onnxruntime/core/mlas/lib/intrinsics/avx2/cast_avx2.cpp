@@ -0,0 +1,280 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_avx2.cpp
+
+Abstract:
+
+    This module implements the element type conversion kernels using AVX2
+    and F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+#include <limits>
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const uint16_t* Source,
+    float* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        __m256 Vector0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(Source + n)));
+        __m256 Vector1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(Source + n + 8)));
+        _mm256_storeu_ps(Destination + n, Vector0);
+        _mm256_storeu_ps(Destination + n + 8, Vector1);
+    }
+
+    for (; n + 8 <= N; n += 8) {
+        _mm256_storeu_ps(Destination + n, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(Source + n))));
+    }
+
+    for (; n < N; n++) {
+        Destination[n] = MLAS_Half2Float(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    uint16_t* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        __m128i Vector0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + n), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Vector1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + n + 8), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(Destination + n), Vector0);
+        _mm_storeu_si128((__m128i*)(Destination + n + 8), Vector1);
+    }
+
+    for (; n + 8 <= N; n += 8) {
+        __m128i Vector = _mm256_cvtps_ph(_mm256_loadu_ps(Source + n), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)(Destination + n), Vector);
+    }
+
+    for (; n < N; n++) {
+        Destination[n] = MLAS_Float2Half(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastBf16ToF32KernelAvx2(
+    const uint16_t* Source,
+    float* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+        __m256i Vector = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(Source + n)));
+        _mm256_storeu_ps(Destination + n, _mm256_castsi256_ps(_mm256_slli_epi32(Vector, 16)));
+    }
+
+    for (; n < N; n++) {
+        Destination[n] = MlasBf16ToFp32(Source[n]);
+    }
+}
+
+//
+// Rounds 8 single precision values to bfloat16, nearest even, leaving the
+// results in the low 16 bits of each 32-bit lane. A NaN stays a quiet NaN.
+//
+
+MLAS_FORCEINLINE
+__m256i
+MlasCastF32ToBf16Avx2(
+    __m256 Vector
+    )
+{
+    const __m256i Bits = _mm256_castps_si256(Vector);
+    const __m256i HighBits = _mm256_srli_epi32(Bits, 16);
+
+    __m256i Rounded = _mm256_add_epi32(Bits, _mm256_set1_epi32(0x7FFF));
+    Rounded = _mm256_add_epi32(Rounded, _mm256_and_si256(HighBits, _mm256_set1_epi32(1)));
+    Rounded = _mm256_srli_epi32(Rounded, 16);
+
+    const __m256i QuietNaN = _mm256_or_si256(HighBits, _mm256_set1_epi32(0x0040));
+    const __m256 IsNaN = _mm256_cmp_ps(Vector, Vector, _CMP_UNORD_Q);
+
+    return _mm256_blendv_epi8(Rounded, QuietNaN, _mm256_castps_si256(IsNaN));
+}
+
+void
+MLASCALL
+MlasCastF32ToBf16KernelAvx2(
+    const float* Source,
+    uint16_t* Destination,
+    size_t N
+    )
+{
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+
+        __m256i Vector0 = MlasCastF32ToBf16Avx2(_mm256_loadu_ps(Source + n));
+        __m256i Vector1 = MlasCastF32ToBf16Avx2(_mm256_loadu_ps(Source + n + 8));
+
+        //
+        // The pack interleaves the 128-bit lanes of the two vectors.
+        //
+
+        __m256i Packed = _mm256_packus_epi32(Vector0, Vector1);
+        Packed = _mm256_permute4x64_epi64(Packed, 0xD8);
+
+        _mm256_storeu_si256((__m256i*)(Destination + n), Packed);
+    }
+
+    for (; n < N; n++) {
+        Destination[n] = MlasFp32ToBf16(Source[n]);
+    }
+}
+
+//
+// Converts 8 single precision values to 32-bit integers after replacing a NaN
+// with zero and clamping to [Minimum, Maximum].
+//
+
+MLAS_FORCEINLINE
+__m256i
+MlasCastF32ToS32ClampAvx2(
+    __m256 Vector,
+    __m256 Minimum,
+    __m256 Maximum
+    )
+{
+    Vector = _mm256_and_ps(Vector, _mm256_cmp_ps(Vector, Vector, _CMP_ORD_Q));
+    Vector = _mm256_min_ps(_mm256_max_ps(Vector, Minimum), Maximum);
+
+    return _mm256_cvttps_epi32(Vector);
+}
+
+void
+MLASCALL
+MlasCastF32ToS32KernelAvx2(
+    const float* Source,
+    int32_t* Destination,
+    size_t N
+    )
+{
+    //
+    // The truncating conversion returns INT32_MIN for any value out of range,
+    // which is the saturated value for negative values. Positive values at or
+    // above 2^31 are replaced with INT32_MAX.
+    //
+
+    const __m256 Overflow = _mm256_set1_ps(2147483648.0f);
+    const __m256i MaximumValue = _mm256_set1_epi32(std::numeric_limits<int32_t>::max());
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+
+        __m256 Vector = _mm256_loadu_ps(Source + n);
+        Vector = _mm256_and_ps(Vector, _mm256_cmp_ps(Vector, Vector, _CMP_ORD_Q));
+
+        __m256i IntegerVector = _mm256_cvttps_epi32(Vector);
+        __m256 IsOverflow = _mm256_cmp_ps(Vector, Overflow, _CMP_GE_OQ);
+        IntegerVector = _mm256_blendv_epi8(IntegerVector, MaximumValue, _mm256_castps_si256(IsOverflow));
+
+        _mm256_storeu_si256((__m256i*)(Destination + n), IntegerVector);
+    }
+
+    for (; n < N; n++) {
+        float Value = Source[n];
+        Destination[n] = (Value != Value) ? 0
+            : (Value >= 2147483648.0f) ? std::numeric_limits<int32_t>::max()
+            : (Value <= -2147483648.0f) ? std::numeric_limits<int32_t>::lowest()
+            : int32_t(Value);
+    }
+}
+
+template<typename T>
+void
+MlasCastF32ToInt8Avx2(
+    const float* Source,
+    T* Destination,
+    size_t N
+    )
+{
+    constexpr float MinimumValue = float(std::numeric_limits<T>::lowest());
+    constexpr float MaximumValue = float(std::numeric_limits<T>::max());
+
+    const __m256 Minimum = _mm256_set1_ps(MinimumValue);
+    const __m256 Maximum = _mm256_set1_ps(MaximumValue);
+
+    //
+    // The packs interleave the 128-bit lanes of the four vectors, so the
+    // 32-bit groups of four results are permuted back into order.
+    //
+
+    const __m256i PermuteIndices = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t n = 0;
+
+    for (; n + 32 <= N; n += 32) {
+
+        __m256i Vector0 = MlasCastF32ToS32ClampAvx2(_mm256_loadu_ps(Source + n), Minimum, Maximum);
+        __m256i Vector1 = MlasCastF32ToS32ClampAvx2(_mm256_loadu_ps(Source + n + 8), Minimum, Maximum);
+        __m256i Vector2 = MlasCastF32ToS32ClampAvx2(_mm256_loadu_ps(Source + n + 16), Minimum, Maximum);
+        __m256i Vector3 = MlasCastF32ToS32ClampAvx2(_mm256_loadu_ps(Source + n + 24), Minimum, Maximum);
+
+        __m256i Packed01 = _mm256_packs_epi32(Vector0, Vector1);
+        __m256i Packed23 = _mm256_packs_epi32(Vector2, Vector3);
+        __m256i Packed;
+
+        if (std::is_signed<T>::value) {
+            Packed = _mm256_packs_epi16(Packed01, Packed23);
+        } else {
+            Packed = _mm256_packus_epi16(Packed01, Packed23);
+        }
+
+        Packed = _mm256_permutevar8x32_epi32(Packed, PermuteIndices);
+
+        _mm256_storeu_si256((__m256i*)(Destination + n), Packed);
+    }
+
+    for (; n < N; n++) {
+        float Value = Source[n];
+        Value = (Value != Value) ? 0.0f : std::min(std::max(Value, MinimumValue), MaximumValue);
+        Destination[n] = T(Value);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToS8KernelAvx2(
+    const float* Source,
+    int8_t* Destination,
+    size_t N
+    )
+{
+    MlasCastF32ToInt8Avx2(Source, Destination, N);
+}
+
+void
+MLASCALL
+MlasCastF32ToU8KernelAvx2(
+    const float* Source,
+    uint8_t* Destination,
+    size_t N
+    )
+{
+    MlasCastF32ToInt8Avx2(Source, Destination, N);
+}
@@ -0,0 +1,198 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    eltwise_avx2.cpp
+
+Abstract:
+
+    This module implements the element-wise binary operation kernel using AVX2
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+static const int32_t MlasEltwiseMaskTableAvx2[16] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+template<MLAS_ELTWISE_BINARY_OP Op>
+MLAS_FORCEINLINE
+__m256
+MlasEltwiseBinaryAvx2(
+    __m256 VectorA,
+    __m256 VectorB
+    )
+{
+    switch (Op) {
+        case MlasEltwiseAdd:
+            return _mm256_add_ps(VectorA, VectorB);
+        case MlasEltwiseSub:
+            return _mm256_sub_ps(VectorA, VectorB);
+        case MlasEltwiseMul:
+            return _mm256_mul_ps(VectorA, VectorB);
+        case MlasEltwiseDiv:
+            return _mm256_div_ps(VectorA, VectorB);
+        //
+        // MAXPS and MINPS return the second value if either value is NaN, so
+        // a NaN in the first value is selected explicitly.
+        //
+        case MlasEltwiseMax:
+            return _mm256_blendv_ps(_mm256_max_ps(VectorA, VectorB), VectorA,
+                _mm256_cmp_ps(VectorA, VectorA, _CMP_UNORD_Q));
+        case MlasEltwiseMin:
+        default:
+            return _mm256_blendv_ps(_mm256_min_ps(VectorA, VectorB), VectorA,
+                _mm256_cmp_ps(VectorA, VectorA, _CMP_UNORD_Q));
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op, bool ScalarA, bool ScalarB>
+void
+MlasEltwiseBinaryRowAvx2(
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N
+    )
+{
+    const __m256 BroadcastA = _mm256_broadcast_ss(InputA);
+    const __m256 BroadcastB = _mm256_broadcast_ss(InputB);
+
+    size_t n = 0;
+
+    for (; n + 32 <= N; n += 32) {
+
+        __m256 Vector0 = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_loadu_ps(InputA + n),
+            ScalarB ? BroadcastB : _mm256_loadu_ps(InputB + n));
+        __m256 Vector1 = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_loadu_ps(InputA + n + 8),
+            ScalarB ? BroadcastB : _mm256_loadu_ps(InputB + n + 8));
+        __m256 Vector2 = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_loadu_ps(InputA + n + 16),
+            ScalarB ? BroadcastB : _mm256_loadu_ps(InputB + n + 16));
+        __m256 Vector3 = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_loadu_ps(InputA + n + 24),
+            ScalarB ? BroadcastB : _mm256_loadu_ps(InputB + n + 24));
+
+        _mm256_storeu_ps(Output + n, Vector0);
+        _mm256_storeu_ps(Output + n + 8, Vector1);
+        _mm256_storeu_ps(Output + n + 16, Vector2);
+        _mm256_storeu_ps(Output + n + 24, Vector3);
+    }
+
+    for (; n + 8 <= N; n += 8) {
+
+        __m256 Vector = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_loadu_ps(InputA + n),
+            ScalarB ? BroadcastB : _mm256_loadu_ps(InputB + n));
+
+        _mm256_storeu_ps(Output + n, Vector);
+    }
+
+    if (n < N) {
+
+        const __m256i Mask = _mm256_loadu_si256((const __m256i*)&MlasEltwiseMaskTableAvx2[8 - (N - n)]);
+
+        __m256 Vector = MlasEltwiseBinaryAvx2<Op>(
+            ScalarA ? BroadcastA : _mm256_maskload_ps(InputA + n, Mask),
+            ScalarB ? BroadcastB : _mm256_maskload_ps(InputB + n, Mask));
+
+        _mm256_maskstore_ps(Output + n, Mask, Vector);
+    }
+}
+
+template<MLAS_ELTWISE_BINARY_OP Op>
+void
+MlasEltwiseBinaryRowAvx2(
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+{
+    if (ScalarA) {
+        if (ScalarB) {
+            MlasEltwiseBinaryRowAvx2<Op, true, true>(InputA, InputB, Output, N);
+        } else {
+            MlasEltwiseBinaryRowAvx2<Op, true, false>(InputA, InputB, Output, N);
+        }
+    } else {
+        if (ScalarB) {
+            MlasEltwiseBinaryRowAvx2<Op, false, true>(InputA, InputB, Output, N);
+        } else {
+            MlasEltwiseBinaryRowAvx2<Op, false, false>(InputA, InputB, Output, N);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasEltwiseBinaryF32KernelAvx2(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a binary operation over a row segment.
+
+Arguments:
+
+    Op - Supplies the binary operation.
+
+    InputA - Supplies the first input vector, or the first input value if
+        ScalarA is true.
+
+    InputB - Supplies the second input vector, or the second input value if
+        ScalarB is true.
+
+    Output - Supplies the output vector.
+
+    N - Supplies the number of elements to process.
+
+    ScalarA - Supplies true if the first input is broadcast.
+
+    ScalarB - Supplies true if the second input is broadcast.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Op) {
+        case MlasEltwiseAdd:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseAdd>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseSub:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseSub>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMul:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseMul>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseDiv:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseDiv>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMax:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseMax>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+        case MlasEltwiseMin:
+            MlasEltwiseBinaryRowAvx2<MlasEltwiseMin>(InputA, InputB, Output, N, ScalarA, ScalarB);
+            break;
+    }
+}
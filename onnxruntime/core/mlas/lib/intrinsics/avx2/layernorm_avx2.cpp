@@ -0,0 +1,278 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel using AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+static const int32_t MlasLayerNormMaskTableAvx2[16] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+MLAS_FORCEINLINE
+float
+MlasLayerNormReduceAddAvx2(
+    __m256 Vector
+    )
+{
+    __m128 Vector128 = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Vector128 = _mm_add_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+    Vector128 = _mm_add_ss(Vector128, _mm_movehdup_ps(Vector128));
+
+    return _mm_cvtss_f32(Vector128);
+}
+
+//
+// Loads or stores the next block of up to 8 elements of a row. The main loop
+// passes a full mask which lets the compiler use plain loads and stores.
+//
+
+template<bool Masked>
+MLAS_FORCEINLINE
+__m256
+MlasLayerNormLoadAvx2(
+    const float* Buffer,
+    __m256i Mask
+    )
+{
+    return Masked ? _mm256_maskload_ps(Buffer, Mask) : _mm256_loadu_ps(Buffer);
+}
+
+template<bool Masked>
+MLAS_FORCEINLINE
+void
+MlasLayerNormStoreAvx2(
+    float* Buffer,
+    __m256i Mask,
+    __m256 Vector
+    )
+{
+    if (Masked) {
+        _mm256_maskstore_ps(Buffer, Mask, Vector);
+    } else {
+        _mm256_storeu_ps(Buffer, Vector);
+    }
+}
+
+template<bool Masked>
+MLAS_FORCEINLINE
+__m256
+MlasLayerNormSumBlockAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* RowSum,
+    __m256i Mask
+    )
+{
+    __m256 Vector = MlasLayerNormLoadAvx2<Masked>(Input, Mask);
+
+    if (Skip != nullptr) {
+        Vector = _mm256_add_ps(Vector, MlasLayerNormLoadAvx2<Masked>(Skip, Mask));
+    }
+
+    if (Bias != nullptr) {
+        Vector = _mm256_add_ps(Vector, MlasLayerNormLoadAvx2<Masked>(Bias, Mask));
+    }
+
+    if (RowSum != nullptr) {
+        MlasLayerNormStoreAvx2<Masked>(RowSum, Mask, Vector);
+    }
+
+    return Vector;
+}
+
+template<bool Masked>
+MLAS_FORCEINLINE
+void
+MlasLayerNormOutputBlockAvx2(
+    const float* Row,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    __m256 ShiftVector,
+    __m256 ScaleVector,
+    __m256i Mask
+    )
+{
+    __m256 Vector = _mm256_mul_ps(_mm256_sub_ps(MlasLayerNormLoadAvx2<Masked>(Row, Mask), ShiftVector), ScaleVector);
+
+    if (Beta != nullptr) {
+        Vector = _mm256_fmadd_ps(Vector, MlasLayerNormLoadAvx2<Masked>(Gamma, Mask),
+            MlasLayerNormLoadAvx2<Masked>(Beta, Mask));
+    } else {
+        Vector = _mm256_mul_ps(Vector, MlasLayerNormLoadAvx2<Masked>(Gamma, Mask));
+    }
+
+    MlasLayerNormStoreAvx2<Masked>(Output, Mask, Vector);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row.
+
+    See MlasLayerNormF32Kernel for the description of the arguments.
+
+--*/
+{
+    const __m256i FullMask = _mm256_set1_epi32(-1);
+    const size_t TailCount = N % 8;
+    const __m256i TailMask = _mm256_loadu_si256((const __m256i*)&MlasLayerNormMaskTableAvx2[8 - TailCount]);
+
+    //
+    // Form the sum in the skip output if requested, else in the output buffer
+    // which is overwritten by the last pass.
+    //
+
+    float* RowSum = nullptr;
+
+    if (Skip != nullptr || Bias != nullptr) {
+        RowSum = (SkipOutput != nullptr) ? SkipOutput : Output;
+    }
+
+    __m256 SumVector0 = _mm256_setzero_ps();
+    __m256 SumVector1 = _mm256_setzero_ps();
+    __m256 SumSquareVector0 = _mm256_setzero_ps();
+    __m256 SumSquareVector1 = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+
+        __m256 Vector0 = MlasLayerNormSumBlockAvx2<false>(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, FullMask);
+        __m256 Vector1 = MlasLayerNormSumBlockAvx2<false>(Input + n + 8,
+            (Skip != nullptr) ? Skip + n + 8 : nullptr, (Bias != nullptr) ? Bias + n + 8 : nullptr,
+            (RowSum != nullptr) ? RowSum + n + 8 : nullptr, FullMask);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm256_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm256_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+    }
+
+    if (n + 8 <= N) {
+
+        __m256 Vector = MlasLayerNormSumBlockAvx2<false>(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, FullMask);
+
+        SumVector0 = _mm256_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm256_fmadd_ps(Vector, Vector, SumSquareVector0);
+
+        n += 8;
+    }
+
+    if (TailCount > 0) {
+
+        //
+        // The masked load returns zero for the inactive lanes.
+        //
+
+        __m256 Vector = MlasLayerNormSumBlockAvx2<true>(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, TailMask);
+
+        SumVector1 = _mm256_add_ps(SumVector1, Vector);
+        SumSquareVector1 = _mm256_fmadd_ps(Vector, Vector, SumSquareVector1);
+    }
+
+    const float* Row = (RowSum != nullptr) ? RowSum : Input;
+
+    const float MeanValue = MlasLayerNormReduceAddAvx2(_mm256_add_ps(SumVector0, SumVector1)) / float(N);
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = MlasLayerNormReduceAddAvx2(_mm256_add_ps(SumSquareVector0, SumSquareVector1)) / float(N);
+
+    } else {
+
+        //
+        // Compute the variance around the mean from the cached row, which
+        // avoids the cancellation of the sum of squares formula.
+        //
+
+        const __m256 MeanVector = _mm256_set1_ps(MeanValue);
+
+        __m256 VarianceVector0 = _mm256_setzero_ps();
+        __m256 VarianceVector1 = _mm256_setzero_ps();
+
+        for (n = 0; n + 16 <= N; n += 16) {
+
+            __m256 Vector0 = _mm256_sub_ps(_mm256_loadu_ps(Row + n), MeanVector);
+            __m256 Vector1 = _mm256_sub_ps(_mm256_loadu_ps(Row + n + 8), MeanVector);
+
+            VarianceVector0 = _mm256_fmadd_ps(Vector0, Vector0, VarianceVector0);
+            VarianceVector1 = _mm256_fmadd_ps(Vector1, Vector1, VarianceVector1);
+        }
+
+        if (n + 8 <= N) {
+
+            __m256 Vector = _mm256_sub_ps(_mm256_loadu_ps(Row + n), MeanVector);
+
+            VarianceVector0 = _mm256_fmadd_ps(Vector, Vector, VarianceVector0);
+
+            n += 8;
+        }
+
+        if (TailCount > 0) {
+
+            __m256 Vector = _mm256_sub_ps(_mm256_maskload_ps(Row + n, TailMask), MeanVector);
+            Vector = _mm256_and_ps(Vector, _mm256_castsi256_ps(TailMask));
+
+            VarianceVector1 = _mm256_fmadd_ps(Vector, Vector, VarianceVector1);
+        }
+
+        Variance = MlasLayerNormReduceAddAvx2(_mm256_add_ps(VarianceVector0, VarianceVector1)) / float(N);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    const __m256 ShiftVector = _mm256_set1_ps(Simplified ? 0.0f : MeanValue);
+    const __m256 ScaleVector = _mm256_set1_ps(InvStdDevValue);
+
+    for (n = 0; n + 8 <= N; n += 8) {
+        MlasLayerNormOutputBlockAvx2<false>(Row + n, Gamma + n, (Beta != nullptr) ? Beta + n : nullptr,
+            Output + n, ShiftVector, ScaleVector, FullMask);
+    }
+
+    if (TailCount > 0) {
+        MlasLayerNormOutputBlockAvx2<true>(Row + n, Gamma + n, (Beta != nullptr) ? Beta + n : nullptr,
+            Output + n, ShiftVector, ScaleVector, TailMask);
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
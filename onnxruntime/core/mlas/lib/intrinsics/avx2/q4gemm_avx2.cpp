@@ -0,0 +1,301 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_avx2.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with an int4 block
+    quantized matrix B using avx2 intrinsics.
+
+    The int4 values of B are dequantized to fp32 in registers, 32 at a time,
+    and multiplied with up to 4 rows of matrix A, so the packed weights are
+    read from memory only once for every 4 rows of A.
+
+--*/
+
+#include "../../q4gemm.h"
+
+struct MLAS_FP_Q4_GEMM_KERNEL_AVX2 {
+    static constexpr size_t KernelMaxM = 4;
+    static constexpr size_t StrideN = 64;
+};
+
+MLAS_FORCEINLINE
+float
+MlasReduceAddFloat32x8Avx2(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+/**
+ * @brief Compute RowCount rows by ColCount columns of matrix C.
+ *
+ * Each group of 32 values of A is multiplied with the dequantized values of
+ * all the columns, so that A is streamed from the cache once for every
+ * ColCount columns of B.
+ *
+ * @tparam Q4Type    Block quantization type of B
+ * @tparam RowCount  # of rows of A, 1 to KernelMaxM
+ * @tparam ColCount  # of columns of B
+ */
+template<typename Q4Type, size_t RowCount, size_t ColCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmBlockAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+    const __m256i ColumnIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    __m256 Accumulators[RowCount][ColCount];
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t c = 0; c < ColCount; c++) {
+            Accumulators[r][c] = _mm256_setzero_ps();
+        }
+    }
+
+    const uint8_t* b = PackedB;
+
+    for (size_t k = 0; k < CountK; k += Q4Type::BlkLen) {
+
+        const size_t klen = std::min(Q4Type::BlkLen, CountK - k);
+
+        for (size_t kk = 0; kk < klen; kk += MLAS_Q4_GROUP_LEN) {
+
+            //
+            // For a partial group at the end of a row, the values of B beyond
+            // K are zero, but A must not be read out of bounds.
+            //
+
+            const size_t kklen = std::min(MLAS_Q4_GROUP_LEN, klen - kk);
+            const bool PartialGroup = (kklen < MLAS_Q4_GROUP_LEN);
+
+            const float* a = A + k + kk;
+
+            for (size_t c = 0; c < ColCount; c++) {
+
+                const uint8_t* blob = b + c * ldb;
+                const __m256 Scale = _mm256_set1_ps(MlasQ4BlkScale<Q4Type>(blob));
+                const __m128i ZeroPoint = _mm_set1_epi8(MlasQ4BlkZeroPoint<Q4Type>(blob));
+                const uint8_t* data = MlasQ4BlkData<Q4Type>(blob) + kk / 2;
+
+                //
+                // Unpack the nibbles and subtract the zero point in 128-bit
+                // registers, then widen the signed values to fp32.
+                //
+
+                const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+                const __m128i Low = _mm_sub_epi8(_mm_and_si128(Bytes, LowMask), ZeroPoint);
+                const __m128i High = _mm_sub_epi8(_mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask), ZeroPoint);
+
+                for (size_t j = 0; j < 4; j++) {
+
+                    const __m128i Values = (j == 0) ? Low : (j == 1) ? _mm_srli_si128(Low, 8)
+                                         : (j == 2) ? High : _mm_srli_si128(High, 8);
+                    const __m256 BElements = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(Values)), Scale);
+
+                    if (PartialGroup) {
+                        const __m256i Mask = _mm256_cmpgt_epi32(
+                            _mm256_set1_epi32(int(kklen) - int(j * 8)), ColumnIndex);
+                        for (size_t r = 0; r < RowCount; r++) {
+                            const __m256 AElements = _mm256_maskload_ps(a + r * lda + j * 8, Mask);
+                            Accumulators[r][c] = _mm256_fmadd_ps(AElements, BElements, Accumulators[r][c]);
+                        }
+                    } else {
+                        for (size_t r = 0; r < RowCount; r++) {
+                            const __m256 AElements = _mm256_loadu_ps(a + r * lda + j * 8);
+                            Accumulators[r][c] = _mm256_fmadd_ps(AElements, BElements, Accumulators[r][c]);
+                        }
+                    }
+                }
+            }
+        }
+
+        b += Q4Type::BlobSize;
+    }
+
+    for (size_t c = 0; c < ColCount; c++) {
+        const float BiasValue = (Bias != nullptr) ? Bias[c] : 0.0f;
+        for (size_t r = 0; r < RowCount; r++) {
+            C[r * ldc + c] = MlasReduceAddFloat32x8Avx2(Accumulators[r][c]) + BiasValue;
+        }
+    }
+}
+
+template<typename Q4Type, size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmRowsAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    //
+    // Keep the number of accumulators within the 16 ymm registers.
+    //
+
+    constexpr size_t ColCount = (RowCount <= 2) ? 4 : 2;
+
+    while (CountN >= ColCount) {
+        MlasQ4GemmBlockAvx2<Q4Type, RowCount, ColCount>(A, PackedB, C, CountK, lda, ldb, ldc, Bias);
+        PackedB += ColCount * ldb;
+        C += ColCount;
+        if (Bias != nullptr) {
+            Bias += ColCount;
+        }
+        CountN -= ColCount;
+    }
+
+    while (CountN > 0) {
+        MlasQ4GemmBlockAvx2<Q4Type, RowCount, 1>(A, PackedB, C, CountK, lda, ldb, ldc, Bias);
+        PackedB += ldb;
+        C += 1;
+        if (Bias != nullptr) {
+            Bias += 1;
+        }
+        CountN -= 1;
+    }
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernelAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    switch (std::min(CountM, MLAS_FP_Q4_GEMM_KERNEL_AVX2::KernelMaxM)) {
+        case 1:
+            MlasQ4GemmRowsAvx2<Q4Type, 1>(A, PackedB, C, CountN, CountK, lda, ldb, ldc, Bias);
+            return 1;
+        case 2:
+            MlasQ4GemmRowsAvx2<Q4Type, 2>(A, PackedB, C, CountN, CountK, lda, ldb, ldc, Bias);
+            return 2;
+        case 3:
+            MlasQ4GemmRowsAvx2<Q4Type, 3>(A, PackedB, C, CountN, CountK, lda, ldb, ldc, Bias);
+            return 3;
+        default:
+            MlasQ4GemmRowsAvx2<Q4Type, 4>(A, PackedB, C, CountN, CountK, lda, ldb, ldc, Bias);
+            return 4;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_AVX2>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelAvx2<MLAS_Q4TYPE_BLK0>(A, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_AVX2>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelAvx2<MLAS_Q4TYPE_BLK1>(A, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_AVX2>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelAvx2<MLAS_Q4TYPE_BLK2>(A, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_AVX2>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelAvx2<MLAS_Q4TYPE_BLK4>(A, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx2 = {
+    {
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_AVX2>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_AVX2>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_AVX2>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_AVX2>
+    }
+};
@@ -0,0 +1,228 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx2.cpp
+
+Abstract:
+
+    This module implements the sum, maximum and minimum reduction kernels
+    using AVX2 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+static const int32_t MlasReduceMaskTableAvx2[16] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+__m256
+MlasReduceCombineAvx2(
+    __m256 Vector1,
+    __m256 Vector2
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return _mm256_max_ps(Vector1, Vector2);
+    } else if (Kind == MlasReduceMinimum) {
+        return _mm256_min_ps(Vector1, Vector2);
+    } else {
+        return _mm256_add_ps(Vector1, Vector2);
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasReduceHorizontalAvx2(
+    __m256 Vector
+    )
+{
+    __m128 Vector128 = _mm256_castps256_ps128(Vector);
+    __m128 High128 = _mm256_extractf128_ps(Vector, 1);
+
+    if (Kind == MlasReduceMaximum) {
+        Vector128 = _mm_max_ps(Vector128, High128);
+        Vector128 = _mm_max_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+        Vector128 = _mm_max_ss(Vector128, _mm_movehdup_ps(Vector128));
+    } else if (Kind == MlasReduceMinimum) {
+        Vector128 = _mm_min_ps(Vector128, High128);
+        Vector128 = _mm_min_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+        Vector128 = _mm_min_ss(Vector128, _mm_movehdup_ps(Vector128));
+    } else {
+        Vector128 = _mm_add_ps(Vector128, High128);
+        Vector128 = _mm_add_ps(Vector128, _mm_movehl_ps(Vector128, Vector128));
+        Vector128 = _mm_add_ss(Vector128, _mm_movehdup_ps(Vector128));
+    }
+
+    return _mm_cvtss_f32(Vector128);
+}
+
+template<MLAS_REDUCE_KIND Kind>
+float
+MlasReduceVectorAvx2(
+    const float* Input,
+    size_t N
+    )
+{
+    const __m256 InitialVector = _mm256_set1_ps((Kind == MlasReduceSum) ? 0.0f : Input[0]);
+
+    __m256 Vector0 = InitialVector;
+    __m256 Vector1 = InitialVector;
+    __m256 Vector2 = InitialVector;
+    __m256 Vector3 = InitialVector;
+
+    while (N >= 32) {
+
+        Vector0 = MlasReduceCombineAvx2<Kind>(Vector0, _mm256_loadu_ps(Input));
+        Vector1 = MlasReduceCombineAvx2<Kind>(Vector1, _mm256_loadu_ps(Input + 8));
+        Vector2 = MlasReduceCombineAvx2<Kind>(Vector2, _mm256_loadu_ps(Input + 16));
+        Vector3 = MlasReduceCombineAvx2<Kind>(Vector3, _mm256_loadu_ps(Input + 24));
+
+        Input += 32;
+        N -= 32;
+    }
+
+    while (N >= 8) {
+
+        Vector0 = MlasReduceCombineAvx2<Kind>(Vector0, _mm256_loadu_ps(Input));
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N > 0) {
+
+        //
+        // Blend the remaining elements over the initial value so that the
+        // inactive lanes do not change the result.
+        //
+
+        const __m256i Mask = _mm256_loadu_si256((const __m256i*)&MlasReduceMaskTableAvx2[8 - N]);
+        __m256 Vector = _mm256_blendv_ps(InitialVector, _mm256_maskload_ps(Input, Mask), _mm256_castsi256_ps(Mask));
+
+        Vector1 = MlasReduceCombineAvx2<Kind>(Vector1, Vector);
+    }
+
+    Vector0 = MlasReduceCombineAvx2<Kind>(Vector0, Vector1);
+    Vector2 = MlasReduceCombineAvx2<Kind>(Vector2, Vector3);
+    Vector0 = MlasReduceCombineAvx2<Kind>(Vector0, Vector2);
+
+    return MlasReduceHorizontalAvx2<Kind>(Vector0);
+}
+
+template<MLAS_REDUCE_KIND Kind>
+void
+MlasReduceAccumulateAvx2(
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    //
+    // Keep a strip of accumulators in registers while the rows are streamed.
+    //
+
+    while (CountN >= 32) {
+
+        __m256 Vector0 = _mm256_loadu_ps(Accumulator);
+        __m256 Vector1 = _mm256_loadu_ps(Accumulator + 8);
+        __m256 Vector2 = _mm256_loadu_ps(Accumulator + 16);
+        __m256 Vector3 = _mm256_loadu_ps(Accumulator + 24);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Vector0 = MlasReduceCombineAvx2<Kind>(Vector0, _mm256_loadu_ps(Row));
+            Vector1 = MlasReduceCombineAvx2<Kind>(Vector1, _mm256_loadu_ps(Row + 8));
+            Vector2 = MlasReduceCombineAvx2<Kind>(Vector2, _mm256_loadu_ps(Row + 16));
+            Vector3 = MlasReduceCombineAvx2<Kind>(Vector3, _mm256_loadu_ps(Row + 24));
+
+            Row += ldInput;
+        }
+
+        _mm256_storeu_ps(Accumulator, Vector0);
+        _mm256_storeu_ps(Accumulator + 8, Vector1);
+        _mm256_storeu_ps(Accumulator + 16, Vector2);
+        _mm256_storeu_ps(Accumulator + 24, Vector3);
+
+        Accumulator += 32;
+        Input += 32;
+        CountN -= 32;
+    }
+
+    while (CountN > 0) {
+
+        const size_t CountVector = std::min(CountN, size_t(8));
+        const __m256i Mask = _mm256_loadu_si256((const __m256i*)&MlasReduceMaskTableAvx2[8 - CountVector]);
+
+        __m256 Vector = _mm256_maskload_ps(Accumulator, Mask);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Vector = MlasReduceCombineAvx2<Kind>(Vector, _mm256_maskload_ps(Row, Mask));
+
+            Row += ldInput;
+        }
+
+        _mm256_maskstore_ps(Accumulator, Mask, Vector);
+
+        Accumulator += CountVector;
+        Input += CountVector;
+        CountN -= CountVector;
+    }
+}
+
+float
+MLASCALL
+MlasReduceVectorF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    )
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            return MlasReduceVectorAvx2<MlasReduceMaximum>(Input, N);
+        case MlasReduceMinimum:
+            return MlasReduceVectorAvx2<MlasReduceMinimum>(Input, N);
+        default:
+            return MlasReduceVectorAvx2<MlasReduceSum>(Input, N);
+    }
+}
+
+void
+MLASCALL
+MlasReduceAccumulateF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            MlasReduceAccumulateAvx2<MlasReduceMaximum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceAccumulateAvx2<MlasReduceMinimum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        default:
+            MlasReduceAccumulateAvx2<MlasReduceSum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+    }
+}
@@ -0,0 +1,470 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_smallm_avx2.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for the special case of a small M (1 to 4 rows) using
+    AVX2 and FMA3 instructions.
+
+    These shapes are typical of autoregressive decoding. Matrix B is read
+    directly from the caller's buffer exactly once regardless of the number
+    of rows, so no packing buffer is used.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of columns of matrix C that are computed per pass over matrix B. The
+// sums for the slice (up to 4 rows of 1KB) stay resident in the L1 cache while
+// the rows of matrix B are streamed.
+//
+
+constexpr size_t MLAS_SGEMM_SMALLM_STRIDEN_AVX2 = 256;
+
+static const int32_t MlasSgemmSmallMMaskTableAvx2[16] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+MLAS_FORCEINLINE
+__m256i
+MlasSgemmSmallMTailMaskAvx2(
+    size_t Count
+    )
+{
+    return _mm256_loadu_si256((const __m256i*)&MlasSgemmSmallMMaskTableAvx2[8 - Count]);
+}
+
+MLAS_FORCEINLINE
+float
+MlasSgemmSmallMReduceAddAvx2(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMStoreOutputAvx2(
+    const float* Accumulators,
+    size_t lda,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine stores the accumulated sums to matrix C after applying the
+    alpha and beta multipliers. Matrix C is not read if beta is zero.
+
+--*/
+{
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+    const __m256 BetaBroadcast = _mm256_set1_ps(beta);
+
+    for (size_t r = 0; r < CountM; r++) {
+
+        const float* a = Accumulators + r * lda;
+        float* c = C + r * ldc;
+        size_t n = 0;
+
+        for (; n + 8 <= CountN; n += 8) {
+            __m256 Result = _mm256_mul_ps(_mm256_loadu_ps(a + n), AlphaBroadcast);
+            if (beta != 0.0f) {
+                Result = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c + n), BetaBroadcast), Result);
+            }
+            _mm256_storeu_ps(c + n, Result);
+        }
+
+        if (n < CountN) {
+            const __m256i TailMask = MlasSgemmSmallMTailMaskAvx2(CountN - n);
+            __m256 Result = _mm256_mul_ps(_mm256_maskload_ps(a + n, TailMask), AlphaBroadcast);
+            if (beta != 0.0f) {
+                Result = _mm256_add_ps(_mm256_mul_ps(_mm256_maskload_ps(c + n, TailMask), BetaBroadcast), Result);
+            }
+            _mm256_maskstore_ps(c + n, TailMask, Result);
+        }
+    }
+}
+
+template<size_t RowCount, size_t StepK>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMAccumulateAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the product of StepK columns of matrix A and
+    StepK rows of matrix B into a slice of matrix C.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the slice.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m256 ABroadcast[RowCount][StepK];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t k = 0; k < StepK; k++) {
+            ABroadcast[r][k] = _mm256_set1_ps(A[r * lda + k]);
+        }
+    }
+
+    size_t n = 0;
+
+    for (; n + 8 <= CountN; n += 8) {
+
+        __m256 BElements[StepK];
+
+        for (size_t k = 0; k < StepK; k++) {
+            BElements[k] = _mm256_loadu_ps(B + k * ldb + n);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m256 Accumulator = ZeroMode ? _mm256_setzero_ps() : _mm256_loadu_ps(c);
+            for (size_t k = 0; k < StepK; k++) {
+                Accumulator = _mm256_fmadd_ps(ABroadcast[r][k], BElements[k], Accumulator);
+            }
+            _mm256_storeu_ps(c, Accumulator);
+        }
+    }
+
+    if (n < CountN) {
+
+        const __m256i TailMask = MlasSgemmSmallMTailMaskAvx2(CountN - n);
+        __m256 BElements[StepK];
+
+        for (size_t k = 0; k < StepK; k++) {
+            BElements[k] = _mm256_maskload_ps(B + k * ldb + n, TailMask);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m256 Accumulator = ZeroMode ? _mm256_setzero_ps() : _mm256_maskload_ps(c, TailMask);
+            for (size_t k = 0; k < StepK; k++) {
+                Accumulator = _mm256_fmadd_ps(ABroadcast[r][k], BElements[k], Accumulator);
+            }
+            _mm256_maskstore_ps(c, TailMask, Accumulator);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallMRowsAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+{
+    //
+    // Bound the register pressure from the broadcasted elements of matrix A.
+    //
+
+    constexpr size_t StepK = (RowCount <= 2) ? 4 : 2;
+
+    MLAS_DECLSPEC_ALIGN(float Accumulators[RowCount * MLAS_SGEMM_SMALLM_STRIDEN_AVX2], 64);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SGEMM_SMALLM_STRIDEN_AVX2) {
+
+        const size_t CountNBlock = std::min(CountN - n, MLAS_SGEMM_SMALLM_STRIDEN_AVX2);
+
+        MlasSgemmSmallMAccumulateAvx2<RowCount, 1>(A, lda, B + n, ldb, Accumulators,
+            MLAS_SGEMM_SMALLM_STRIDEN_AVX2, CountNBlock, true);
+
+        size_t k = 1;
+
+        for (; k + StepK <= CountK; k += StepK) {
+            MlasSgemmSmallMAccumulateAvx2<RowCount, StepK>(A + k, lda, B + k * ldb + n, ldb,
+                Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX2, CountNBlock, false);
+        }
+
+        for (; k < CountK; k++) {
+            MlasSgemmSmallMAccumulateAvx2<RowCount, 1>(A + k, lda, B + k * ldb + n, ldb,
+                Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX2, CountNBlock, false);
+        }
+
+        MlasSgemmSmallMStoreOutputAvx2(Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX2, C + n,
+            RowCount, CountNBlock, ldc, alpha, beta);
+    }
+}
+
+template<size_t RowCount, size_t ColumnCount>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMDotAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount x ColumnCount elements of
+    matrix C as the dot products of the rows of matrix A and the rows of the
+    transposed matrix B.
+
+--*/
+{
+    __m256 Accumulators[RowCount][ColumnCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < ColumnCount; j++) {
+            Accumulators[r][j] = _mm256_setzero_ps();
+        }
+    }
+
+    size_t k = 0;
+
+    for (; k + 8 <= CountK; k += 8) {
+
+        __m256 BElements[ColumnCount];
+
+        for (size_t j = 0; j < ColumnCount; j++) {
+            BElements[j] = _mm256_loadu_ps(B + j * ldb + k);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 AElements = _mm256_loadu_ps(A + r * lda + k);
+            for (size_t j = 0; j < ColumnCount; j++) {
+                Accumulators[r][j] = _mm256_fmadd_ps(AElements, BElements[j], Accumulators[r][j]);
+            }
+        }
+    }
+
+    if (k < CountK) {
+
+        const __m256i TailMask = MlasSgemmSmallMTailMaskAvx2(CountK - k);
+        __m256 BElements[ColumnCount];
+
+        for (size_t j = 0; j < ColumnCount; j++) {
+            BElements[j] = _mm256_maskload_ps(B + j * ldb + k, TailMask);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 AElements = _mm256_maskload_ps(A + r * lda + k, TailMask);
+            for (size_t j = 0; j < ColumnCount; j++) {
+                Accumulators[r][j] = _mm256_fmadd_ps(AElements, BElements[j], Accumulators[r][j]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < ColumnCount; j++) {
+            float* c = C + r * ldc + j;
+            float Result = MlasSgemmSmallMReduceAddAvx2(Accumulators[r][j]) * alpha;
+            if (beta != 0.0f) {
+                Result = (*c * beta) + Result;
+            }
+            *c = Result;
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallMRowsTransposeBAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+{
+    constexpr size_t StepN = (RowCount <= 2) ? 4 : 2;
+
+    size_t n = 0;
+
+    for (; n + StepN <= CountN; n += StepN) {
+        MlasSgemmSmallMDotAvx2<RowCount, StepN>(A, lda, B + n * ldb, ldb, C + n, ldc, CountK, alpha, beta);
+    }
+
+    for (; n < CountN; n++) {
+        MlasSgemmSmallMDotAvx2<RowCount, 1>(A, lda, B + n * ldb, ldb, C + n, ldc, CountK, alpha, beta);
+    }
+}
+
+void
+MLASCALL
+MlasSgemmSmallMKernelAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes matrix C for a small M. The elements in matrix B are
+    not transposed.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of matrix A and matrix C. The value
+        must be in the range 1 to MLAS_SGEMM_SMALLM_MAXIMUM_ROWS.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of
+        rows of matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmSmallMRowsAvx2<1>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 2:
+            MlasSgemmSmallMRowsAvx2<2>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 3:
+            MlasSgemmSmallMRowsAvx2<3>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        default:
+            MlasSgemmSmallMRowsAvx2<4>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasSgemmSmallMKernelTransposeBAvx2(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes matrix C for a small M. The elements in matrix B are
+    transposed.
+
+Arguments:
+
+    See MlasSgemmSmallMKernelAvx2.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmSmallMRowsTransposeBAvx2<1>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 2:
+            MlasSgemmSmallMRowsTransposeBAvx2<2>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 3:
+            MlasSgemmSmallMRowsTransposeBAvx2<3>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        default:
+            MlasSgemmSmallMRowsTransposeBAvx2<4>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+    }
+}
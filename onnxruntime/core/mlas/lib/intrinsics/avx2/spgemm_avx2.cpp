@@ -0,0 +1,110 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    spgemm_avx2.cpp
+
+Abstract:
+
+    This module implements the block sparse SGEMM kernel using AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t BlockKConstant>
+MLAS_FORCEINLINE
+void
+MlasSparseGemmKernelAvx2BlockK(
+    const float* A,
+    const uint32_t* BlockRows,
+    const float* BlockValues,
+    size_t BlockCount,
+    size_t BlockK,
+    float* Output
+    )
+{
+    //
+    // A BlockKConstant of zero uses the runtime block size.
+    //
+
+    if (BlockKConstant != 0) {
+        BlockK = BlockKConstant;
+    }
+
+    __m256 Accumulator00 = _mm256_setzero_ps();
+    __m256 Accumulator01 = _mm256_setzero_ps();
+    __m256 Accumulator10 = _mm256_setzero_ps();
+    __m256 Accumulator11 = _mm256_setzero_ps();
+    __m256 Accumulator20 = _mm256_setzero_ps();
+    __m256 Accumulator21 = _mm256_setzero_ps();
+    __m256 Accumulator30 = _mm256_setzero_ps();
+    __m256 Accumulator31 = _mm256_setzero_ps();
+
+    const float* b = BlockValues;
+
+    for (size_t j = 0; j < BlockCount; j++) {
+
+        const float* a = A + size_t(BlockRows[j]) * BlockK * MLAS_SPARSE_SGEMM_TILE_M;
+
+        for (size_t kk = 0; kk < BlockK; kk++) {
+
+            __m256 A0 = _mm256_loadu_ps(a);
+            __m256 A1 = _mm256_loadu_ps(a + 8);
+
+            __m256 B0 = _mm256_broadcast_ss(b + 0);
+            Accumulator00 = _mm256_fmadd_ps(A0, B0, Accumulator00);
+            Accumulator01 = _mm256_fmadd_ps(A1, B0, Accumulator01);
+            __m256 B1 = _mm256_broadcast_ss(b + 1);
+            Accumulator10 = _mm256_fmadd_ps(A0, B1, Accumulator10);
+            Accumulator11 = _mm256_fmadd_ps(A1, B1, Accumulator11);
+            __m256 B2 = _mm256_broadcast_ss(b + 2);
+            Accumulator20 = _mm256_fmadd_ps(A0, B2, Accumulator20);
+            Accumulator21 = _mm256_fmadd_ps(A1, B2, Accumulator21);
+            __m256 B3 = _mm256_broadcast_ss(b + 3);
+            Accumulator30 = _mm256_fmadd_ps(A0, B3, Accumulator30);
+            Accumulator31 = _mm256_fmadd_ps(A1, B3, Accumulator31);
+
+            a += MLAS_SPARSE_SGEMM_TILE_M;
+            b += MLAS_SPARSE_SGEMM_BLOCK_N;
+        }
+    }
+
+    _mm256_storeu_ps(Output + 0 * MLAS_SPARSE_SGEMM_TILE_M, Accumulator00);
+    _mm256_storeu_ps(Output + 0 * MLAS_SPARSE_SGEMM_TILE_M + 8, Accumulator01);
+    _mm256_storeu_ps(Output + 1 * MLAS_SPARSE_SGEMM_TILE_M, Accumulator10);
+    _mm256_storeu_ps(Output + 1 * MLAS_SPARSE_SGEMM_TILE_M + 8, Accumulator11);
+    _mm256_storeu_ps(Output + 2 * MLAS_SPARSE_SGEMM_TILE_M, Accumulator20);
+    _mm256_storeu_ps(Output + 2 * MLAS_SPARSE_SGEMM_TILE_M + 8, Accumulator21);
+    _mm256_storeu_ps(Output + 3 * MLAS_SPARSE_SGEMM_TILE_M, Accumulator30);
+    _mm256_storeu_ps(Output + 3 * MLAS_SPARSE_SGEMM_TILE_M + 8, Accumulator31);
+}
+
+void
+MLASCALL
+MlasSparseGemmKernelAvx2(
+    const float* A,
+    const uint32_t* BlockRows,
+    const float* BlockValues,
+    size_t BlockCount,
+    size_t BlockK,
+    float* Output
+    )
+{
+    switch (BlockK) {
+        case 1:
+            MlasSparseGemmKernelAvx2BlockK<1>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+        case 4:
+            MlasSparseGemmKernelAvx2BlockK<4>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+        default:
+            MlasSparseGemmKernelAvx2BlockK<0>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+    }
+}
@@ -0,0 +1,73 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental_avx2.cpp
+
+Abstract:
+
+    This module implements the unary function kernel using AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "../../transcendental.h"
+
+struct MLAS_UNARY_AVX2 {
+
+    typedef __m256 FloatType;
+    typedef __m256i IntType;
+
+    static constexpr size_t VectorLength = 8;
+
+    static MLAS_FORCEINLINE FloatType Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, FloatType Vector) { _mm256_storeu_ps(Buffer, Vector); }
+    static MLAS_FORCEINLINE FloatType Broadcast(float Value) { return _mm256_set1_ps(Value); }
+    static MLAS_FORCEINLINE IntType BroadcastInt(int32_t Value) { return _mm256_set1_epi32(Value); }
+
+    static MLAS_FORCEINLINE FloatType Add(FloatType Vector1, FloatType Vector2) { return _mm256_add_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Subtract(FloatType Vector1, FloatType Vector2) { return _mm256_sub_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Multiply(FloatType Vector1, FloatType Vector2) { return _mm256_mul_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType MultiplyAdd(FloatType Vector1, FloatType Vector2, FloatType Vector3) { return _mm256_fmadd_ps(Vector1, Vector2, Vector3); }
+    static MLAS_FORCEINLINE FloatType Divide(FloatType Vector1, FloatType Vector2) { return _mm256_div_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Sqrt(FloatType Vector) { return _mm256_sqrt_ps(Vector); }
+    static MLAS_FORCEINLINE FloatType Maximum(FloatType Vector1, FloatType Vector2) { return _mm256_max_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Minimum(FloatType Vector1, FloatType Vector2) { return _mm256_min_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE FloatType GreaterThan(FloatType Vector1, FloatType Vector2) { return _mm256_cmp_ps(Vector1, Vector2, _CMP_GT_OQ); }
+    static MLAS_FORCEINLINE FloatType And(FloatType Vector1, FloatType Vector2) { return _mm256_and_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType AndNot(FloatType Vector1, FloatType Vector2) { return _mm256_andnot_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Or(FloatType Vector1, FloatType Vector2) { return _mm256_or_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Xor(FloatType Vector1, FloatType Vector2) { return _mm256_xor_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Blend(FloatType Vector1, FloatType Vector2, FloatType Selection) { return _mm256_blendv_ps(Vector1, Vector2, Selection); }
+    static MLAS_FORCEINLINE bool TestAny(FloatType Mask) { return _mm256_movemask_ps(Mask) != 0; }
+
+    static MLAS_FORCEINLINE IntType ReinterpretAsInt(FloatType Vector) { return _mm256_castps_si256(Vector); }
+    static MLAS_FORCEINLINE FloatType ReinterpretAsFloat(IntType Vector) { return _mm256_castsi256_ps(Vector); }
+    static MLAS_FORCEINLINE FloatType ConvertToFloat(IntType Vector) { return _mm256_cvtepi32_ps(Vector); }
+    static MLAS_FORCEINLINE IntType AddInt(IntType Vector1, IntType Vector2) { return _mm256_add_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType SubtractInt(IntType Vector1, IntType Vector2) { return _mm256_sub_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType AndInt(IntType Vector1, IntType Vector2) { return _mm256_and_si256(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MaximumInt(IntType Vector1, IntType Vector2) { return _mm256_max_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MinimumInt(IntType Vector1, IntType Vector2) { return _mm256_min_epi32(Vector1, Vector2); }
+
+    template<unsigned ShiftCount>
+    static MLAS_FORCEINLINE IntType ShiftLeftInt(IntType Vector) { return _mm256_slli_epi32(Vector, ShiftCount); }
+};
+
+void
+MLASCALL
+MlasUnaryFunctionF32KernelAvx2(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    )
+{
+    MlasUnaryFunctionKernel<MLAS_UNARY_AVX2>(Function, Input, Output, N, Parameter);
+}
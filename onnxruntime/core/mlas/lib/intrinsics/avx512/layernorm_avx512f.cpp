@@ -0,0 +1,225 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx512f.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel using AVX512F
+    instructions.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m512
+MlasLayerNormSumBlockAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* RowSum,
+    __mmask16 Mask
+    )
+{
+    __m512 Vector = _mm512_maskz_loadu_ps(Mask, Input);
+
+    if (Skip != nullptr) {
+        Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Skip));
+    }
+
+    if (Bias != nullptr) {
+        Vector = _mm512_add_ps(Vector, _mm512_maskz_loadu_ps(Mask, Bias));
+    }
+
+    if (RowSum != nullptr) {
+        _mm512_mask_storeu_ps(RowSum, Mask, Vector);
+    }
+
+    return Vector;
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormOutputBlockAvx512F(
+    const float* Row,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    __m512 ShiftVector,
+    __m512 ScaleVector,
+    __mmask16 Mask
+    )
+{
+    __m512 Vector = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(Mask, Row), ShiftVector), ScaleVector);
+
+    if (Beta != nullptr) {
+        Vector = _mm512_fmadd_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma), _mm512_maskz_loadu_ps(Mask, Beta));
+    } else {
+        Vector = _mm512_mul_ps(Vector, _mm512_maskz_loadu_ps(Mask, Gamma));
+    }
+
+    _mm512_mask_storeu_ps(Output, Mask, Vector);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row.
+
+    See MlasLayerNormF32Kernel for the description of the arguments.
+
+--*/
+{
+    const __mmask16 FullMask = __mmask16(0xFFFF);
+    const size_t TailCount = N % 16;
+    const __mmask16 TailMask = __mmask16((1u << TailCount) - 1);
+
+    //
+    // Form the sum in the skip output if requested, else in the output buffer
+    // which is overwritten by the last pass.
+    //
+
+    float* RowSum = nullptr;
+
+    if (Skip != nullptr || Bias != nullptr) {
+        RowSum = (SkipOutput != nullptr) ? SkipOutput : Output;
+    }
+
+    __m512 SumVector0 = _mm512_setzero_ps();
+    __m512 SumVector1 = _mm512_setzero_ps();
+    __m512 SumSquareVector0 = _mm512_setzero_ps();
+    __m512 SumSquareVector1 = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 32 <= N; n += 32) {
+
+        __m512 Vector0 = MlasLayerNormSumBlockAvx512F(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, FullMask);
+        __m512 Vector1 = MlasLayerNormSumBlockAvx512F(Input + n + 16,
+            (Skip != nullptr) ? Skip + n + 16 : nullptr, (Bias != nullptr) ? Bias + n + 16 : nullptr,
+            (RowSum != nullptr) ? RowSum + n + 16 : nullptr, FullMask);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector0);
+        SumVector1 = _mm512_add_ps(SumVector1, Vector1);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector0, Vector0, SumSquareVector0);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector1, Vector1, SumSquareVector1);
+    }
+
+    if (n + 16 <= N) {
+
+        __m512 Vector = MlasLayerNormSumBlockAvx512F(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, FullMask);
+
+        SumVector0 = _mm512_add_ps(SumVector0, Vector);
+        SumSquareVector0 = _mm512_fmadd_ps(Vector, Vector, SumSquareVector0);
+
+        n += 16;
+    }
+
+    if (TailCount > 0) {
+
+        //
+        // The masked load returns zero for the inactive lanes.
+        //
+
+        __m512 Vector = MlasLayerNormSumBlockAvx512F(Input + n,
+            (Skip != nullptr) ? Skip + n : nullptr, (Bias != nullptr) ? Bias + n : nullptr,
+            (RowSum != nullptr) ? RowSum + n : nullptr, TailMask);
+
+        SumVector1 = _mm512_add_ps(SumVector1, Vector);
+        SumSquareVector1 = _mm512_fmadd_ps(Vector, Vector, SumSquareVector1);
+    }
+
+    const float* Row = (RowSum != nullptr) ? RowSum : Input;
+
+    const float MeanValue = _mm512_reduce_add_ps(_mm512_add_ps(SumVector0, SumVector1)) / float(N);
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = _mm512_reduce_add_ps(_mm512_add_ps(SumSquareVector0, SumSquareVector1)) / float(N);
+
+    } else {
+
+        //
+        // Compute the variance around the mean from the cached row, which
+        // avoids the cancellation of the sum of squares formula.
+        //
+
+        const __m512 MeanVector = _mm512_set1_ps(MeanValue);
+
+        __m512 VarianceVector0 = _mm512_setzero_ps();
+        __m512 VarianceVector1 = _mm512_setzero_ps();
+
+        for (n = 0; n + 32 <= N; n += 32) {
+
+            __m512 Vector0 = _mm512_sub_ps(_mm512_loadu_ps(Row + n), MeanVector);
+            __m512 Vector1 = _mm512_sub_ps(_mm512_loadu_ps(Row + n + 16), MeanVector);
+
+            VarianceVector0 = _mm512_fmadd_ps(Vector0, Vector0, VarianceVector0);
+            VarianceVector1 = _mm512_fmadd_ps(Vector1, Vector1, VarianceVector1);
+        }
+
+        if (n + 16 <= N) {
+
+            __m512 Vector = _mm512_sub_ps(_mm512_loadu_ps(Row + n), MeanVector);
+
+            VarianceVector0 = _mm512_fmadd_ps(Vector, Vector, VarianceVector0);
+
+            n += 16;
+        }
+
+        if (TailCount > 0) {
+
+            __m512 Vector = _mm512_maskz_sub_ps(TailMask, _mm512_maskz_loadu_ps(TailMask, Row + n), MeanVector);
+
+            VarianceVector1 = _mm512_fmadd_ps(Vector, Vector, VarianceVector1);
+        }
+
+        Variance = _mm512_reduce_add_ps(_mm512_add_ps(VarianceVector0, VarianceVector1)) / float(N);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+
+    const __m512 ShiftVector = _mm512_set1_ps(Simplified ? 0.0f : MeanValue);
+    const __m512 ScaleVector = _mm512_set1_ps(InvStdDevValue);
+
+    for (n = 0; n + 16 <= N; n += 16) {
+        MlasLayerNormOutputBlockAvx512F(Row + n, Gamma + n, (Beta != nullptr) ? Beta + n : nullptr,
+            Output + n, ShiftVector, ScaleVector, FullMask);
+    }
+
+    if (TailCount > 0) {
+        MlasLayerNormOutputBlockAvx512F(Row + n, Gamma + n, (Beta != nullptr) ? Beta + n : nullptr,
+            Output + n, ShiftVector, ScaleVector, TailMask);
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
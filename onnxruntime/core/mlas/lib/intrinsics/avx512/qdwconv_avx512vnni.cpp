@@ -0,0 +1,97 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_avx512vnni.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer depthwise
+    convolution kernels for 3x3 and 5x5 filters.
+
+    This implementation uses AVX512-VNNI instructions.
+
+--*/
+
+#include "../../qdwconv_vnni.h"
+
+struct MLAS_CONV_SYM_DEPTHWISE_AVX512VNNI {
+
+    static constexpr bool Supports512Bit = true;
+
+    static
+    MLAS_FORCEINLINE
+    __m512i
+    DotProduct(
+        __m512i Accumulator,
+        __m512i Input,
+        __m512i Filter
+        )
+    {
+        return _mm512_dpbusd_epi32(Accumulator, Input, Filter);
+    }
+
+    static
+    MLAS_FORCEINLINE
+    __m256i
+    DotProduct(
+        __m256i Accumulator,
+        __m256i Input,
+        __m256i Filter
+        )
+    {
+        return _mm256_dpbusd_epi32(Accumulator, Input, Filter);
+    }
+
+    static
+    MLAS_FORCEINLINE
+    __m128i
+    DotProduct(
+        __m128i Accumulator,
+        __m128i Input,
+        __m128i Filter
+        )
+    {
+        return _mm_dpbusd_epi32(Accumulator, Input, Filter);
+    }
+};
+
+extern "C" {
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize9Avx512Vnni(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelVnni<9, MLAS_CONV_SYM_DEPTHWISE_AVX512VNNI>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize25Avx512Vnni(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelVnni<25, MLAS_CONV_SYM_DEPTHWISE_AVX512VNNI>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+}
@@ -0,0 +1,212 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_avx512f.cpp
+
+Abstract:
+
+    This module implements the sum, maximum and minimum reduction kernels
+    using AVX512F instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+__m512
+MlasReduceCombineAvx512F(
+    __m512 Vector1,
+    __m512 Vector2
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return _mm512_max_ps(Vector1, Vector2);
+    } else if (Kind == MlasReduceMinimum) {
+        return _mm512_min_ps(Vector1, Vector2);
+    } else {
+        return _mm512_add_ps(Vector1, Vector2);
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasReduceHorizontalAvx512F(
+    __m512 Vector
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return _mm512_reduce_max_ps(Vector);
+    } else if (Kind == MlasReduceMinimum) {
+        return _mm512_reduce_min_ps(Vector);
+    } else {
+        return _mm512_reduce_add_ps(Vector);
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+float
+MlasReduceVectorAvx512F(
+    const float* Input,
+    size_t N
+    )
+{
+    const __m512 InitialVector = _mm512_set1_ps((Kind == MlasReduceSum) ? 0.0f : Input[0]);
+
+    __m512 Vector0 = InitialVector;
+    __m512 Vector1 = InitialVector;
+    __m512 Vector2 = InitialVector;
+    __m512 Vector3 = InitialVector;
+
+    while (N >= 64) {
+
+        Vector0 = MlasReduceCombineAvx512F<Kind>(Vector0, _mm512_loadu_ps(Input));
+        Vector1 = MlasReduceCombineAvx512F<Kind>(Vector1, _mm512_loadu_ps(Input + 16));
+        Vector2 = MlasReduceCombineAvx512F<Kind>(Vector2, _mm512_loadu_ps(Input + 32));
+        Vector3 = MlasReduceCombineAvx512F<Kind>(Vector3, _mm512_loadu_ps(Input + 48));
+
+        Input += 64;
+        N -= 64;
+    }
+
+    while (N >= 16) {
+
+        Vector0 = MlasReduceCombineAvx512F<Kind>(Vector0, _mm512_loadu_ps(Input));
+
+        Input += 16;
+        N -= 16;
+    }
+
+    if (N > 0) {
+
+        //
+        // The inactive lanes keep the initial value so that they do not
+        // change the result.
+        //
+
+        const __mmask16 Mask = __mmask16((1u << N) - 1);
+
+        Vector1 = MlasReduceCombineAvx512F<Kind>(Vector1, _mm512_mask_loadu_ps(InitialVector, Mask, Input));
+    }
+
+    Vector0 = MlasReduceCombineAvx512F<Kind>(Vector0, Vector1);
+    Vector2 = MlasReduceCombineAvx512F<Kind>(Vector2, Vector3);
+    Vector0 = MlasReduceCombineAvx512F<Kind>(Vector0, Vector2);
+
+    return MlasReduceHorizontalAvx512F<Kind>(Vector0);
+}
+
+template<MLAS_REDUCE_KIND Kind>
+void
+MlasReduceAccumulateAvx512F(
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    //
+    // Keep a strip of accumulators in registers while the rows are streamed.
+    //
+
+    while (CountN >= 64) {
+
+        __m512 Vector0 = _mm512_loadu_ps(Accumulator);
+        __m512 Vector1 = _mm512_loadu_ps(Accumulator + 16);
+        __m512 Vector2 = _mm512_loadu_ps(Accumulator + 32);
+        __m512 Vector3 = _mm512_loadu_ps(Accumulator + 48);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Vector0 = MlasReduceCombineAvx512F<Kind>(Vector0, _mm512_loadu_ps(Row));
+            Vector1 = MlasReduceCombineAvx512F<Kind>(Vector1, _mm512_loadu_ps(Row + 16));
+            Vector2 = MlasReduceCombineAvx512F<Kind>(Vector2, _mm512_loadu_ps(Row + 32));
+            Vector3 = MlasReduceCombineAvx512F<Kind>(Vector3, _mm512_loadu_ps(Row + 48));
+
+            Row += ldInput;
+        }
+
+        _mm512_storeu_ps(Accumulator, Vector0);
+        _mm512_storeu_ps(Accumulator + 16, Vector1);
+        _mm512_storeu_ps(Accumulator + 32, Vector2);
+        _mm512_storeu_ps(Accumulator + 48, Vector3);
+
+        Accumulator += 64;
+        Input += 64;
+        CountN -= 64;
+    }
+
+    while (CountN > 0) {
+
+        const size_t CountVector = std::min(CountN, size_t(16));
+        const __mmask16 Mask = __mmask16(0xFFFF >> (16 - CountVector));
+
+        __m512 Vector = _mm512_maskz_loadu_ps(Mask, Accumulator);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Vector = MlasReduceCombineAvx512F<Kind>(Vector, _mm512_maskz_loadu_ps(Mask, Row));
+
+            Row += ldInput;
+        }
+
+        _mm512_mask_storeu_ps(Accumulator, Mask, Vector);
+
+        Accumulator += CountVector;
+        Input += CountVector;
+        CountN -= CountVector;
+    }
+}
+
+float
+MLASCALL
+MlasReduceVectorF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    )
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            return MlasReduceVectorAvx512F<MlasReduceMaximum>(Input, N);
+        case MlasReduceMinimum:
+            return MlasReduceVectorAvx512F<MlasReduceMinimum>(Input, N);
+        default:
+            return MlasReduceVectorAvx512F<MlasReduceSum>(Input, N);
+    }
+}
+
+void
+MLASCALL
+MlasReduceAccumulateF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            MlasReduceAccumulateAvx512F<MlasReduceMaximum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceAccumulateAvx512F<MlasReduceMinimum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        default:
+            MlasReduceAccumulateAvx512F<MlasReduceSum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+    }
+}
@@ -0,0 +1,450 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_smallm_avx512f.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for the special case of a small M (1 to 4 rows) using
+    AVX512F instructions.
+
+    These shapes are typical of autoregressive decoding. Matrix B is read
+    directly from the caller's buffer exactly once regardless of the number
+    of rows, so no packing buffer is used.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of columns of matrix C that are computed per pass over matrix B. The
+// sums for the slice (up to 4 rows of 1KB) stay resident in the L1 cache while
+// the rows of matrix B are streamed.
+//
+
+constexpr size_t MLAS_SGEMM_SMALLM_STRIDEN_AVX512F = 256;
+
+MLAS_FORCEINLINE
+__mmask16
+MlasSgemmSmallMTailMaskAvx512F(
+    size_t Count
+    )
+{
+    return __mmask16((1u << Count) - 1);
+}
+
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMStoreOutputAvx512F(
+    const float* Accumulators,
+    size_t lda,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine stores the accumulated sums to matrix C after applying the
+    alpha and beta multipliers. Matrix C is not read if beta is zero.
+
+--*/
+{
+    const __m512 AlphaBroadcast = _mm512_set1_ps(alpha);
+    const __m512 BetaBroadcast = _mm512_set1_ps(beta);
+
+    for (size_t r = 0; r < CountM; r++) {
+
+        const float* a = Accumulators + r * lda;
+        float* c = C + r * ldc;
+        size_t n = 0;
+
+        for (; n + 16 <= CountN; n += 16) {
+            __m512 Result = _mm512_mul_ps(_mm512_loadu_ps(a + n), AlphaBroadcast);
+            if (beta != 0.0f) {
+                Result = _mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(c + n), BetaBroadcast), Result);
+            }
+            _mm512_storeu_ps(c + n, Result);
+        }
+
+        if (n < CountN) {
+            const __mmask16 TailMask = MlasSgemmSmallMTailMaskAvx512F(CountN - n);
+            __m512 Result = _mm512_mul_ps(_mm512_maskz_loadu_ps(TailMask, a + n), AlphaBroadcast);
+            if (beta != 0.0f) {
+                Result = _mm512_add_ps(_mm512_mul_ps(_mm512_maskz_loadu_ps(TailMask, c + n), BetaBroadcast), Result);
+            }
+            _mm512_mask_storeu_ps(c + n, TailMask, Result);
+        }
+    }
+}
+
+template<size_t RowCount, size_t StepK>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMAccumulateAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the product of StepK columns of matrix A and
+    StepK rows of matrix B into a slice of matrix C.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the slice.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    __m512 ABroadcast[RowCount][StepK];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t k = 0; k < StepK; k++) {
+            ABroadcast[r][k] = _mm512_set1_ps(A[r * lda + k]);
+        }
+    }
+
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+
+        __m512 BElements[StepK];
+
+        for (size_t k = 0; k < StepK; k++) {
+            BElements[k] = _mm512_loadu_ps(B + k * ldb + n);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m512 Accumulator = ZeroMode ? _mm512_setzero_ps() : _mm512_loadu_ps(c);
+            for (size_t k = 0; k < StepK; k++) {
+                Accumulator = _mm512_fmadd_ps(ABroadcast[r][k], BElements[k], Accumulator);
+            }
+            _mm512_storeu_ps(c, Accumulator);
+        }
+    }
+
+    if (n < CountN) {
+
+        const __mmask16 TailMask = MlasSgemmSmallMTailMaskAvx512F(CountN - n);
+        __m512 BElements[StepK];
+
+        for (size_t k = 0; k < StepK; k++) {
+            BElements[k] = _mm512_maskz_loadu_ps(TailMask, B + k * ldb + n);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m512 Accumulator = ZeroMode ? _mm512_setzero_ps() : _mm512_maskz_loadu_ps(TailMask, c);
+            for (size_t k = 0; k < StepK; k++) {
+                Accumulator = _mm512_fmadd_ps(ABroadcast[r][k], BElements[k], Accumulator);
+            }
+            _mm512_mask_storeu_ps(c, TailMask, Accumulator);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallMRowsAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+{
+    constexpr size_t StepK = 4;
+
+    MLAS_DECLSPEC_ALIGN(float Accumulators[RowCount * MLAS_SGEMM_SMALLM_STRIDEN_AVX512F], 64);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SGEMM_SMALLM_STRIDEN_AVX512F) {
+
+        const size_t CountNBlock = std::min(CountN - n, MLAS_SGEMM_SMALLM_STRIDEN_AVX512F);
+
+        MlasSgemmSmallMAccumulateAvx512F<RowCount, 1>(A, lda, B + n, ldb, Accumulators,
+            MLAS_SGEMM_SMALLM_STRIDEN_AVX512F, CountNBlock, true);
+
+        size_t k = 1;
+
+        for (; k + StepK <= CountK; k += StepK) {
+            MlasSgemmSmallMAccumulateAvx512F<RowCount, StepK>(A + k, lda, B + k * ldb + n, ldb,
+                Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX512F, CountNBlock, false);
+        }
+
+        for (; k < CountK; k++) {
+            MlasSgemmSmallMAccumulateAvx512F<RowCount, 1>(A + k, lda, B + k * ldb + n, ldb,
+                Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX512F, CountNBlock, false);
+        }
+
+        MlasSgemmSmallMStoreOutputAvx512F(Accumulators, MLAS_SGEMM_SMALLM_STRIDEN_AVX512F, C + n,
+            RowCount, CountNBlock, ldc, alpha, beta);
+    }
+}
+
+template<size_t RowCount, size_t ColumnCount>
+MLAS_FORCEINLINE
+void
+MlasSgemmSmallMDotAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of RowCount x ColumnCount elements of
+    matrix C as the dot products of the rows of matrix A and the rows of the
+    transposed matrix B.
+
+--*/
+{
+    __m512 Accumulators[RowCount][ColumnCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < ColumnCount; j++) {
+            Accumulators[r][j] = _mm512_setzero_ps();
+        }
+    }
+
+    size_t k = 0;
+
+    for (; k + 16 <= CountK; k += 16) {
+
+        __m512 BElements[ColumnCount];
+
+        for (size_t j = 0; j < ColumnCount; j++) {
+            BElements[j] = _mm512_loadu_ps(B + j * ldb + k);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512 AElements = _mm512_loadu_ps(A + r * lda + k);
+            for (size_t j = 0; j < ColumnCount; j++) {
+                Accumulators[r][j] = _mm512_fmadd_ps(AElements, BElements[j], Accumulators[r][j]);
+            }
+        }
+    }
+
+    if (k < CountK) {
+
+        const __mmask16 TailMask = MlasSgemmSmallMTailMaskAvx512F(CountK - k);
+        __m512 BElements[ColumnCount];
+
+        for (size_t j = 0; j < ColumnCount; j++) {
+            BElements[j] = _mm512_maskz_loadu_ps(TailMask, B + j * ldb + k);
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512 AElements = _mm512_maskz_loadu_ps(TailMask, A + r * lda + k);
+            for (size_t j = 0; j < ColumnCount; j++) {
+                Accumulators[r][j] = _mm512_fmadd_ps(AElements, BElements[j], Accumulators[r][j]);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t j = 0; j < ColumnCount; j++) {
+            float* c = C + r * ldc + j;
+            float Result = _mm512_reduce_add_ps(Accumulators[r][j]) * alpha;
+            if (beta != 0.0f) {
+                Result = (*c * beta) + Result;
+            }
+            *c = Result;
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasSgemmSmallMRowsTransposeBAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+{
+    constexpr size_t StepN = 4;
+
+    size_t n = 0;
+
+    for (; n + StepN <= CountN; n += StepN) {
+        MlasSgemmSmallMDotAvx512F<RowCount, StepN>(A, lda, B + n * ldb, ldb, C + n, ldc, CountK, alpha, beta);
+    }
+
+    for (; n < CountN; n++) {
+        MlasSgemmSmallMDotAvx512F<RowCount, 1>(A, lda, B + n * ldb, ldb, C + n, ldc, CountK, alpha, beta);
+    }
+}
+
+void
+MLASCALL
+MlasSgemmSmallMKernelAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes matrix C for a small M. The elements in matrix B are
+    not transposed.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of matrix A and matrix C. The value
+        must be in the range 1 to MLAS_SGEMM_SMALLM_MAXIMUM_ROWS.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of
+        rows of matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmSmallMRowsAvx512F<1>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 2:
+            MlasSgemmSmallMRowsAvx512F<2>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 3:
+            MlasSgemmSmallMRowsAvx512F<3>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        default:
+            MlasSgemmSmallMRowsAvx512F<4>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasSgemmSmallMKernelTransposeBAvx512F(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes matrix C for a small M. The elements in matrix B are
+    transposed.
+
+Arguments:
+
+    See MlasSgemmSmallMKernelAvx512F.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (CountM) {
+        case 1:
+            MlasSgemmSmallMRowsTransposeBAvx512F<1>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 2:
+            MlasSgemmSmallMRowsTransposeBAvx512F<2>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        case 3:
+            MlasSgemmSmallMRowsTransposeBAvx512F<3>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+        default:
+            MlasSgemmSmallMRowsTransposeBAvx512F<4>(A, lda, B, ldb, C, ldc, CountN, CountK, alpha, beta);
+            break;
+    }
+}
@@ -0,0 +1,87 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental_avx512f.cpp
+
+Abstract:
+
+    This module implements the unary function kernel using AVX512F
+    instructions.
+
+    AVX512F compares produce mask registers, which are expanded to vectors
+    with all bits set in the selected elements to match the other vector
+    types. The bitwise operations on floats require AVX512DQ, so these use
+    the integer forms.
+
+--*/
+
+#include "../../transcendental.h"
+
+struct MLAS_UNARY_AVX512F {
+
+    typedef __m512 FloatType;
+    typedef __m512i IntType;
+
+    static constexpr size_t VectorLength = 16;
+
+    static MLAS_FORCEINLINE FloatType Load(const float* Buffer) { return _mm512_loadu_ps(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, FloatType Vector) { _mm512_storeu_ps(Buffer, Vector); }
+    static MLAS_FORCEINLINE FloatType Broadcast(float Value) { return _mm512_set1_ps(Value); }
+    static MLAS_FORCEINLINE IntType BroadcastInt(int32_t Value) { return _mm512_set1_epi32(Value); }
+
+    static MLAS_FORCEINLINE FloatType Add(FloatType Vector1, FloatType Vector2) { return _mm512_add_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Subtract(FloatType Vector1, FloatType Vector2) { return _mm512_sub_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Multiply(FloatType Vector1, FloatType Vector2) { return _mm512_mul_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType MultiplyAdd(FloatType Vector1, FloatType Vector2, FloatType Vector3) { return _mm512_fmadd_ps(Vector1, Vector2, Vector3); }
+    static MLAS_FORCEINLINE FloatType Divide(FloatType Vector1, FloatType Vector2) { return _mm512_div_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Sqrt(FloatType Vector) { return _mm512_sqrt_ps(Vector); }
+    static MLAS_FORCEINLINE FloatType Maximum(FloatType Vector1, FloatType Vector2) { return _mm512_max_ps(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Minimum(FloatType Vector1, FloatType Vector2) { return _mm512_min_ps(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE FloatType GreaterThan(FloatType Vector1, FloatType Vector2)
+    {
+        return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(Vector1, Vector2, _CMP_GT_OQ), -1));
+    }
+
+    static MLAS_FORCEINLINE FloatType And(FloatType Vector1, FloatType Vector2) { return ReinterpretAsFloat(_mm512_and_si512(ReinterpretAsInt(Vector1), ReinterpretAsInt(Vector2))); }
+    static MLAS_FORCEINLINE FloatType AndNot(FloatType Vector1, FloatType Vector2) { return ReinterpretAsFloat(_mm512_andnot_si512(ReinterpretAsInt(Vector1), ReinterpretAsInt(Vector2))); }
+    static MLAS_FORCEINLINE FloatType Or(FloatType Vector1, FloatType Vector2) { return ReinterpretAsFloat(_mm512_or_si512(ReinterpretAsInt(Vector1), ReinterpretAsInt(Vector2))); }
+    static MLAS_FORCEINLINE FloatType Xor(FloatType Vector1, FloatType Vector2) { return ReinterpretAsFloat(_mm512_xor_si512(ReinterpretAsInt(Vector1), ReinterpretAsInt(Vector2))); }
+
+    static MLAS_FORCEINLINE FloatType Blend(FloatType Vector1, FloatType Vector2, FloatType Selection)
+    {
+        return _mm512_mask_blend_ps(_mm512_test_epi32_mask(ReinterpretAsInt(Selection), ReinterpretAsInt(Selection)), Vector1, Vector2);
+    }
+
+    static MLAS_FORCEINLINE bool TestAny(FloatType Mask) { return _mm512_test_epi32_mask(ReinterpretAsInt(Mask), ReinterpretAsInt(Mask)) != 0; }
+
+    static MLAS_FORCEINLINE IntType ReinterpretAsInt(FloatType Vector) { return _mm512_castps_si512(Vector); }
+    static MLAS_FORCEINLINE FloatType ReinterpretAsFloat(IntType Vector) { return _mm512_castsi512_ps(Vector); }
+    static MLAS_FORCEINLINE FloatType ConvertToFloat(IntType Vector) { return _mm512_cvtepi32_ps(Vector); }
+    static MLAS_FORCEINLINE IntType AddInt(IntType Vector1, IntType Vector2) { return _mm512_add_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType SubtractInt(IntType Vector1, IntType Vector2) { return _mm512_sub_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType AndInt(IntType Vector1, IntType Vector2) { return _mm512_and_si512(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MaximumInt(IntType Vector1, IntType Vector2) { return _mm512_max_epi32(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MinimumInt(IntType Vector1, IntType Vector2) { return _mm512_min_epi32(Vector1, Vector2); }
+
+    template<unsigned ShiftCount>
+    static MLAS_FORCEINLINE IntType ShiftLeftInt(IntType Vector) { return _mm512_slli_epi32(Vector, ShiftCount); }
+};
+
+void
+MLASCALL
+MlasUnaryFunctionF32KernelAvx512F(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    )
+{
+    MlasUnaryFunctionKernel<MLAS_UNARY_AVX512F>(Function, Input, Output, N, Parameter);
+}
@@ -0,0 +1,510 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements the layer normalization and the skip layer
+    normalization of the rows of a tensor.
+
+    Each row is processed with the row resident in the L1 cache: the first
+    pass forms the sum of the input, skip and bias and computes the mean, the
+    second pass computes the variance around the mean and the third pass
+    applies the normalization, scale and shift.
+
+    Half precision inputs are converted to float one row at a time and all
+    computation is done in float.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Minimum number of input elements to process per thread.
+//
+
+constexpr size_t MLAS_LAYER_NORM_MINIMUM_ELEMENTS_PER_THREAD = 8192;
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a single row.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Supplies the optional row added to the input.
+
+    Bias - Supplies the optional vector added to the input.
+
+    Gamma - Supplies the scale vector.
+
+    Beta - Supplies the optional shift vector.
+
+    Output - Supplies the output row.
+
+    SkipOutput - Supplies the optional row to store the sum of the input, skip
+        and bias.
+
+    N - Supplies the number of elements in the row.
+
+    Epsilon - Supplies the value added to the variance.
+
+    Simplified - Supplies true to skip the mean subtraction.
+
+    Mean - Receives the mean of the row.
+
+    InvStdDev - Receives the inverse of the standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Row = Input;
+
+    MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 SumSquareVector = MlasZeroFloat32x4();
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    size_t n = 0;
+
+    if (Skip != nullptr || Bias != nullptr) {
+
+        //
+        // Form the sum in the skip output if requested, else in the output
+        // buffer which is overwritten by the last pass.
+        //
+
+        float* RowSum = (SkipOutput != nullptr) ? SkipOutput : Output;
+
+        for (; n + 4 <= N; n += 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+
+            if (Skip != nullptr) {
+                Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Skip + n));
+            }
+
+            if (Bias != nullptr) {
+                Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+            }
+
+            MlasStoreFloat32x4(RowSum + n, Vector);
+
+            SumVector = MlasAddFloat32x4(SumVector, Vector);
+            SumSquareVector = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector);
+        }
+
+        for (; n < N; n++) {
+
+            float Value = Input[n];
+
+            if (Skip != nullptr) {
+                Value += Skip[n];
+            }
+
+            if (Bias != nullptr) {
+                Value += Bias[n];
+            }
+
+            RowSum[n] = Value;
+
+            Sum += Value;
+            SumSquare += Value * Value;
+        }
+
+        Row = RowSum;
+
+    } else {
+
+        for (; n + 4 <= N; n += 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Input + n);
+
+            SumVector = MlasAddFloat32x4(SumVector, Vector);
+            SumSquareVector = MlasMultiplyAddFloat32x4(Vector, Vector, SumSquareVector);
+        }
+
+        for (; n < N; n++) {
+
+            Sum += Input[n];
+            SumSquare += Input[n] * Input[n];
+        }
+    }
+
+    Sum += MlasReduceAddFloat32x4(SumVector);
+    SumSquare += MlasReduceAddFloat32x4(SumSquareVector);
+
+    const float MeanValue = Sum / float(N);
+    float Variance;
+
+    if (Simplified) {
+
+        Variance = SumSquare / float(N);
+
+    } else {
+
+        //
+        // Compute the variance around the mean from the cached row, which
+        // avoids the cancellation of the sum of squares formula.
+        //
+
+        const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(MeanValue);
+        MLAS_FLOAT32X4 VarianceVector = MlasZeroFloat32x4();
+        Variance = 0.0f;
+
+        for (n = 0; n + 4 <= N; n += 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Row + n), MeanVector);
+
+            VarianceVector = MlasMultiplyAddFloat32x4(Vector, Vector, VarianceVector);
+        }
+
+        for (; n < N; n++) {
+
+            const float Value = Row[n] - MeanValue;
+
+            Variance += Value * Value;
+        }
+
+        Variance = (Variance + MlasReduceAddFloat32x4(VarianceVector)) / float(N);
+    }
+
+    const float InvStdDevValue = 1.0f / std::sqrt(Variance + Epsilon);
+    const float Shift = Simplified ? 0.0f : MeanValue;
+
+    const MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(InvStdDevValue);
+
+    for (n = 0; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Row + n), ShiftVector);
+
+        Vector = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Vector, ScaleVector), MlasLoadFloat32x4(Gamma + n));
+
+        if (Beta != nullptr) {
+            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Beta + n));
+        }
+
+        MlasStoreFloat32x4(Output + n, Vector);
+    }
+
+    for (; n < N; n++) {
+
+        float Value = (Row[n] - Shift) * InvStdDevValue * Gamma[n];
+
+        if (Beta != nullptr) {
+            Value += Beta[n];
+        }
+
+        Output[n] = Value;
+    }
+
+    *Mean = MeanValue;
+    *InvStdDev = InvStdDevValue;
+}
+
+MLAS_FORCEINLINE
+void
+MlasLayerNormRow(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().LayerNormF32Kernel(Input, Skip, Bias, Gamma, Beta, Output, SkipOutput,
+        N, Epsilon, Simplified, Mean, InvStdDev);
+#else
+    MlasLayerNormF32Kernel(Input, Skip, Bias, Gamma, Beta, Output, SkipOutput,
+        N, Epsilon, Simplified, Mean, InvStdDev);
+#endif
+}
+
+void
+MlasLayerNormRows(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    size_t RowStart,
+    size_t RowEnd,
+    size_t RowSize
+    )
+{
+    for (size_t r = RowStart; r < RowEnd; r++) {
+
+        const size_t Offset = r * RowSize;
+
+        float Mean;
+        float InvStdDev;
+
+        MlasLayerNormRow(Params.Input + Offset,
+            (Params.Skip != nullptr) ? Params.Skip + Offset : nullptr,
+            Params.Bias, Params.Gamma, Params.Beta, Params.Output + Offset,
+            (Params.SkipOutput != nullptr) ? Params.SkipOutput + Offset : nullptr,
+            RowSize, Params.Epsilon, Params.Simplified, &Mean, &InvStdDev);
+
+        if (Params.Mean != nullptr) {
+            Params.Mean[r] = Mean;
+        }
+
+        if (Params.InvStdDev != nullptr) {
+            Params.InvStdDev[r] = InvStdDev;
+        }
+    }
+}
+
+void
+MlasLayerNormRows(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    const MLAS_LAYER_NORM_PARAMS<float>& FloatParams,
+    size_t RowStart,
+    size_t RowEnd,
+    size_t RowSize
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a range of half precision rows by converting each
+    row to float. The shared vectors have already been converted and are
+    supplied through the float parameters.
+
+--*/
+{
+    std::vector<float> Buffer(RowSize * 3);
+
+    float* InputBuffer = Buffer.data();
+    float* SkipBuffer = InputBuffer + RowSize;
+    float* OutputBuffer = SkipBuffer + RowSize;
+
+    //
+    // The sum of the input, skip and bias is formed in place of the input.
+    //
+
+    const bool HasSkipOutput = (Params.SkipOutput != nullptr);
+
+    for (size_t r = RowStart; r < RowEnd; r++) {
+
+        const size_t Offset = r * RowSize;
+
+        for (size_t n = 0; n < RowSize; n++) {
+            InputBuffer[n] = Params.Input[Offset + n].ToFloat();
+        }
+
+        if (Params.Skip != nullptr) {
+            for (size_t n = 0; n < RowSize; n++) {
+                SkipBuffer[n] = Params.Skip[Offset + n].ToFloat();
+            }
+        }
+
+        float Mean;
+        float InvStdDev;
+
+        MlasLayerNormRow(InputBuffer, (Params.Skip != nullptr) ? SkipBuffer : nullptr,
+            FloatParams.Bias, FloatParams.Gamma, FloatParams.Beta, OutputBuffer,
+            HasSkipOutput ? InputBuffer : nullptr, RowSize, Params.Epsilon,
+            Params.Simplified, &Mean, &InvStdDev);
+
+        for (size_t n = 0; n < RowSize; n++) {
+            Params.Output[Offset + n] = MLAS_FP16(OutputBuffer[n]);
+        }
+
+        if (HasSkipOutput) {
+            for (size_t n = 0; n < RowSize; n++) {
+                Params.SkipOutput[Offset + n] = MLAS_FP16(InputBuffer[n]);
+            }
+        }
+
+        if (Params.Mean != nullptr) {
+            Params.Mean[r] = Mean;
+        }
+
+        if (Params.InvStdDev != nullptr) {
+            Params.InvStdDev[r] = InvStdDev;
+        }
+    }
+}
+
+ptrdiff_t
+MlasLayerNormGetThreadCount(
+    MLAS_THREADPOOL* ThreadPool,
+    size_t RowCount,
+    size_t RowSize
+    )
+{
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (RowCount * RowSize / MLAS_LAYER_NORM_MINIMUM_ELEMENTS_PER_THREAD) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    if (size_t(ThreadCount) > RowCount) {
+        ThreadCount = ptrdiff_t(RowCount);
+    }
+
+    return ThreadCount;
+}
+
+void
+MlasLayerNormThreaded(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const ptrdiff_t ThreadCount = MlasLayerNormGetThreadCount(ThreadPool, RowCount, RowSize);
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t RowStart;
+        size_t CountRows;
+
+        MlasPartitionWork(tid, ThreadCount, RowCount, &RowStart, &CountRows);
+
+        MlasLayerNormRows(Params, RowStart, RowStart + CountRows, RowSize);
+    });
+}
+
+void
+MlasLayerNormThreaded(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Convert the vectors shared by all rows once.
+    //
+
+    std::vector<float> Vectors(RowSize * 3);
+
+    MLAS_LAYER_NORM_PARAMS<float> FloatParams;
+
+    const MLAS_FP16* Sources[] = {Params.Gamma, Params.Beta, Params.Bias};
+    const float** Targets[] = {&FloatParams.Gamma, &FloatParams.Beta, &FloatParams.Bias};
+
+    for (size_t i = 0; i < 3; i++) {
+
+        if (Sources[i] == nullptr) {
+            continue;
+        }
+
+        float* Vector = Vectors.data() + i * RowSize;
+
+        for (size_t n = 0; n < RowSize; n++) {
+            Vector[n] = Sources[i][n].ToFloat();
+        }
+
+        *Targets[i] = Vector;
+    }
+
+    const ptrdiff_t ThreadCount = MlasLayerNormGetThreadCount(ThreadPool, RowCount, RowSize);
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t RowStart;
+        size_t CountRows;
+
+        MlasPartitionWork(tid, ThreadCount, RowCount, &RowStart, &CountRows);
+
+        MlasLayerNormRows(Params, FloatParams, RowStart, RowStart + CountRows, RowSize);
+    });
+}
+
+template<typename T>
+void
+MLASCALL
+MlasLayerNorm(
+    const MLAS_LAYER_NORM_PARAMS<T>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization of each row of a tensor.
+
+Arguments:
+
+    Params - Supplies the layer normalization parameters.
+
+    RowCount - Supplies the number of rows.
+
+    RowSize - Supplies the number of elements per row.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (RowCount == 0) {
+        return;
+    }
+
+    MlasLayerNormThreaded(Params, RowCount, RowSize, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasLayerNorm<float>(
+    const MLAS_LAYER_NORM_PARAMS<float>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasLayerNorm<MLAS_FP16>(
+    const MLAS_LAYER_NORM_PARAMS<MLAS_FP16>& Params,
+    size_t RowCount,
+    size_t RowSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -177,11 +177,14 @@ class MLASCPUIDInfo
 
     bool IsCurrentCoreArmv8NarrowLd() const { return false; }
 
+    uint32_t GetL2CacheSize() const { return l2_cache_size_; }
+
    private:
     MLASCPUIDInfo();
 
     bool has_arm_neon_dot_{false};
     bool has_fp16_{false};
+    uint32_t l2_cache_size_{0};
 };
 using MLAS_CPUIDINFO = MLASCPUIDInfo;
 
@@ -276,6 +279,13 @@ static_assert(sizeof(MLAS_FP16) == FP16_SIZE);
 
 #define MLAS_MAXIMUM_THREAD_COUNT                   16
 
+//
+// Define the per-core L2 cache size assumed by the thread partitioner when the
+// processor does not report one.
+//
+
+#define MLAS_DEFAULT_L2_CACHE_SIZE                  (1024 * 1024)
+
 //
 // Define the default strides to step through slices of the input matrices.
 //
@@ -287,6 +297,13 @@ static_assert(sizeof(MLAS_FP16) == FP16_SIZE);
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the maximum number of rows handled by the small M SGEMM kernels. These
+// kernels read matrix B directly instead of copying it to a packed buffer.
+//
+
+#define MLAS_SGEMM_SMALLM_MAXIMUM_ROWS              4
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -392,6 +409,22 @@ void
     float beta
     );
 
+typedef
+void
+(MLASCALL MLAS_SGEMM_KERNEL_SMALLM_ROUTINE)(
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    float beta
+    );
+
 typedef
 void
 (MLASCALL MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE)(
@@ -574,6 +607,128 @@ void
     size_t N
     );
 
+typedef
+float
+(MLASCALL MLAS_REDUCE_VECTOR_FLOAT_KERNEL)(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_REDUCE_ACCUMULATE_FLOAT_KERNEL)(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_FLOAT_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+    );
+
+typedef
+void
+(MLASCALL MLAS_ELTWISE_BINARY_FLOAT_KERNEL)(
+    MLAS_ELTWISE_BINARY_OP Op,
+    const float* InputA,
+    const float* InputB,
+    float* Output,
+    size_t N,
+    bool ScalarA,
+    bool ScalarB
+    );
+
+typedef
+void
+(MLASCALL MLAS_UNARY_FUNCTION_FLOAT_KERNEL)(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    );
+
+//
+// Number of rows of matrix A processed by the block sparse SGEMM kernel. The
+// kernel reads a K x MLAS_SPARSE_SGEMM_TILE_M tile of the transposed matrix A
+// and produces the MLAS_SPARSE_SGEMM_BLOCK_N x MLAS_SPARSE_SGEMM_TILE_M
+// transposed output tile of one column panel of B.
+//
+
+constexpr size_t MLAS_SPARSE_SGEMM_TILE_M = 16;
+
+typedef
+void
+(MLASCALL MLAS_SPARSE_SGEMM_KERNEL)(
+    const float* A,
+    const uint32_t* BlockRows,
+    const float* BlockValues,
+    size_t BlockCount,
+    size_t BlockK,
+    float* Output
+    );
+
+//
+// The half kernels convert the bits of either MLAS_FP16 or MLAS_BF16 elements.
+//
+
+typedef
+void
+(MLASCALL MLAS_CAST_HALF_TO_F32_KERNEL)(
+    const uint16_t* Source,
+    float* Destination,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_HALF_KERNEL)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_S32_KERNEL)(
+    const float* Source,
+    int32_t* Destination,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_S8_KERNEL)(
+    const float* Source,
+    int8_t* Destination,
+    size_t N
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_U8_KERNEL)(
+    const float* Source,
+    uint8_t* Destination,
+    size_t N
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -673,6 +828,10 @@ extern "C" {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1Avx;
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1TransposeBAvx;
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE MlasSgemmSmallMKernelAvx2;
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE MlasSgemmSmallMKernelTransposeBAvx2;
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE MlasSgemmSmallMKernelAvx512F;
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE MlasSgemmSmallMKernelTransposeBAvx512F;
 #elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_WASM)
     MLAS_GEMV_FLOAT_KERNEL MlasGemvFloatKernel;
 #endif
@@ -765,6 +924,54 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_REDUCE_VECTOR_FLOAT_KERNEL MlasReduceVectorF32Kernel;
+    MLAS_REDUCE_ACCUMULATE_FLOAT_KERNEL MlasReduceAccumulateF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_REDUCE_VECTOR_FLOAT_KERNEL MlasReduceVectorF32KernelAvx2;
+    MLAS_REDUCE_ACCUMULATE_FLOAT_KERNEL MlasReduceAccumulateF32KernelAvx2;
+    MLAS_REDUCE_VECTOR_FLOAT_KERNEL MlasReduceVectorF32KernelAvx512F;
+    MLAS_REDUCE_ACCUMULATE_FLOAT_KERNEL MlasReduceAccumulateF32KernelAvx512F;
+#endif
+
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx2;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+#endif
+
+    MLAS_ELTWISE_BINARY_FLOAT_KERNEL MlasEltwiseBinaryF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_ELTWISE_BINARY_FLOAT_KERNEL MlasEltwiseBinaryF32KernelAvx2;
+#endif
+
+    MLAS_UNARY_FUNCTION_FLOAT_KERNEL MlasUnaryFunctionF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_UNARY_FUNCTION_FLOAT_KERNEL MlasUnaryFunctionF32KernelAvx2;
+    MLAS_UNARY_FUNCTION_FLOAT_KERNEL MlasUnaryFunctionF32KernelAvx512F;
+#endif
+
+    MLAS_SPARSE_SGEMM_KERNEL MlasSparseGemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_SPARSE_SGEMM_KERNEL MlasSparseGemmKernelAvx2;
+#endif
+
+    MLAS_CAST_HALF_TO_F32_KERNEL MlasCastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_HALF_KERNEL MlasCastF32ToF16Kernel;
+    MLAS_CAST_HALF_TO_F32_KERNEL MlasCastBf16ToF32Kernel;
+    MLAS_CAST_F32_TO_HALF_KERNEL MlasCastF32ToBf16Kernel;
+    MLAS_CAST_F32_TO_S32_KERNEL MlasCastF32ToS32Kernel;
+    MLAS_CAST_F32_TO_S8_KERNEL MlasCastF32ToS8Kernel;
+    MLAS_CAST_F32_TO_U8_KERNEL MlasCastF32ToU8Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CAST_HALF_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_HALF_KERNEL MlasCastF32ToF16KernelAvx2;
+    MLAS_CAST_HALF_TO_F32_KERNEL MlasCastBf16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_HALF_KERNEL MlasCastF32ToBf16KernelAvx2;
+    MLAS_CAST_F32_TO_S32_KERNEL MlasCastF32ToS32KernelAvx2;
+    MLAS_CAST_F32_TO_S8_KERNEL MlasCastF32ToS8KernelAvx2;
+    MLAS_CAST_F32_TO_U8_KERNEL MlasCastF32ToU8KernelAvx2;
+#endif
+
 }
 
 //
@@ -793,10 +1000,31 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (size_t(64) * size_t(1024))
 #define MLAS_QGEMM_THREAD_COMPLEXITY                65536
 
+//
+// Define the bounds for splitting the K dimension of a SGEMM operation across
+// threads. The partial results of each K slice are held in a temporary buffer,
+// so the split is limited to small output matrices.
+//
+
+#define MLAS_SGEMM_SPLITK_MINIMUM_STRIDEK           256
+#define MLAS_SGEMM_SPLITK_MAXIMUM_ELEMENTS          (size_t(64) * size_t(1024))
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
 
+//
+// Epilogue for a slice of matrix C (see MLAS_SGEMM_DATA_PARAMS). The bias and
+// residual addresses are relative to the first element of the slice.
+//
+
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Bias;
+    const MLAS_ACTIVATION* Activation;
+    const float* Residual;
+    size_t ldr;
+};
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -811,7 +1039,26 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr
+    );
+
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     );
 
 //
@@ -852,11 +1099,49 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx2;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvxVnni;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Core;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAvx512Vnni;
+#ifdef MLAS_AMX_SUPPORTED
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymDispatchAmx;
+extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchAmx;
+#endif
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchNeon;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymU8DispatchDot;
 extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot;
 
+//
+// Half precision matrix/matrix dispatch structure.
+//
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchDefault;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+#ifdef MLAS_AVX512FP16_SUPPORTED
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
+#endif
+
+//
+// Int4 block quantized matrix/matrix dispatch structure.
+//
+
+struct MLAS_FPQ4GEMM_DISPATCH;
+
+extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchDefault;
+extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx2;
+extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx512;
+
+//
+// BFloat16 matrix/matrix dispatch structure.
+//
+
+struct MLAS_BF16GEMM_DISPATCH;
+
+extern const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchDefault;
+#ifdef MLAS_AMX_SUPPORTED
+extern const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16;
+extern const MLAS_BF16GEMM_DISPATCH MlasBf16GemmDispatchAmx;
+#endif
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -908,6 +1193,35 @@ struct MLAS_CONV_SYM_POST_PROCESS_PARAMS {
     int32_t OutputZeroPoint;
 };
 
+//
+// The conv sym depthwise kernels that pack four kernel elements of a channel
+// into each 32-bit lane split the channels into blocks of 64 channels followed
+// by at most one block of 32 channels and one block of 16 channels. Within a
+// block, the 16 byte chunks of its groups of 16 channels are interleaved so
+// that chunk j of each group (channels 4j to 4j+3) is adjacent. This returns
+// the width of the block that contains the channel.
+//
+
+MLAS_FORCEINLINE
+size_t
+MlasConvSymDepthwiseDotBlockWidth(
+    size_t Channels,
+    size_t Channel
+    )
+{
+    const size_t BlockStart = Channel & ~size_t(63);
+
+    if (BlockStart + 64 <= Channels) {
+        return 64;
+    }
+
+    if (BlockStart + 32 <= Channels && Channel < BlockStart + 32) {
+        return 32;
+    }
+
+    return 16;
+}
+
 //
 // Environment information class.
 //
@@ -934,6 +1248,12 @@ struct MLAS_PLATFORM {
     const MLAS_CONV_SYM_DISPATCH* ConvSymU8S8Dispatch{nullptr};
     const MLAS_CONV_SYM_DISPATCH* ConvSymS8S8Dispatch{nullptr};
 
+#if defined(MLAS_TARGET_AMD64)
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch;
+    const MLAS_FPQ4GEMM_DISPATCH* FpQ4GemmDispatch;
+    const MLAS_BF16GEMM_DISPATCH* Bf16GemmDispatch;
+#endif
+
     MLAS_QUANT_KERNEL<uint8_t, int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
     MLAS_QUANT_KERNEL<uint8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
     MLAS_QUANT_KERNEL<int8_t, int8_t>::DepthwiseKernel* ConvDepthwiseS8S8Kernel;
@@ -948,6 +1268,8 @@ struct MLAS_PLATFORM {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1Routine;
     MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1TransposeBRoutine;
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE* KernelSmallMRoutine{nullptr};
+    MLAS_SGEMM_KERNEL_SMALLM_ROUTINE* KernelSmallMTransposeBRoutine{nullptr};
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE* TransposePackB16x4Routine;
     MLAS_GEMM_DOUBLE_KERNEL* GemmDoubleKernel;
     MLAS_GEMM_U8S8_KERNEL* GemmU8S8Kernel;
@@ -969,6 +1291,19 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_REDUCE_VECTOR_FLOAT_KERNEL* ReduceVectorF32Kernel;
+    MLAS_REDUCE_ACCUMULATE_FLOAT_KERNEL* ReduceAccumulateF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_ELTWISE_BINARY_FLOAT_KERNEL* EltwiseBinaryF32Kernel;
+    MLAS_UNARY_FUNCTION_FLOAT_KERNEL* UnaryFunctionF32Kernel;
+    MLAS_SPARSE_SGEMM_KERNEL* SparseGemmKernel;
+    MLAS_CAST_HALF_TO_F32_KERNEL* CastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_HALF_KERNEL* CastF32ToF16Kernel;
+    MLAS_CAST_HALF_TO_F32_KERNEL* CastBf16ToF32Kernel;
+    MLAS_CAST_F32_TO_HALF_KERNEL* CastF32ToBf16Kernel;
+    MLAS_CAST_F32_TO_S32_KERNEL* CastF32ToS32Kernel;
+    MLAS_CAST_F32_TO_S8_KERNEL* CastF32ToS8Kernel;
+    MLAS_CAST_F32_TO_U8_KERNEL* CastF32ToU8Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -980,6 +1315,7 @@ struct MLAS_PLATFORM {
     static constexpr int32_t MaximumThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
 #endif
 
+    size_t L2CacheSize;
 };
 
 inline
@@ -1064,6 +1400,70 @@ MlasPartitionWork(
     }
 }
 
+//
+// Describes how a GEMM shaped operation is tiled across threads. The M and N
+// dimensions are cut into StrideM x StrideN tiles of matrix C. When M x N has
+// too few tiles to occupy the threads, K may be cut into StrideK slices whose
+// partial results are reduced by the caller. Thread indices are ordered with N
+// varying fastest, then M, then K.
+//
+
+struct MLAS_GEMM_THREAD_PARTITION {
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+    ptrdiff_t ThreadCountK;
+    size_t StrideM;
+    size_t StrideN;
+    size_t StrideK;
+
+    ptrdiff_t ThreadCount() const
+    {
+        return ThreadCountM * ThreadCountN * ThreadCountK;
+    }
+};
+
+void
+MlasGemmPartitionThreads(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t AlignM,
+    size_t AlignN,
+    size_t ElementSizeA,
+    size_t ElementSizeB,
+    ptrdiff_t TargetThreadCount,
+    size_t MinimumStrideK,
+    MLAS_GEMM_THREAD_PARTITION* Partition
+    );
+
+inline
+void
+MlasGemmPartitionRange(
+    const MLAS_GEMM_THREAD_PARTITION& Partition,
+    ptrdiff_t ThreadId,
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t* RangeStartM,
+    size_t* RangeCountM,
+    size_t* RangeStartN,
+    size_t* RangeCountN,
+    size_t* RangeStartK,
+    size_t* RangeCountK
+    )
+{
+    const ptrdiff_t ThreadIdN = ThreadId % Partition.ThreadCountN;
+    const ptrdiff_t ThreadIdM = (ThreadId / Partition.ThreadCountN) % Partition.ThreadCountM;
+    const ptrdiff_t ThreadIdK = ThreadId / (Partition.ThreadCountN * Partition.ThreadCountM);
+
+    *RangeStartM = size_t(ThreadIdM) * Partition.StrideM;
+    *RangeCountM = std::min(M - *RangeStartM, Partition.StrideM);
+    *RangeStartN = size_t(ThreadIdN) * Partition.StrideN;
+    *RangeCountN = std::min(N - *RangeStartN, Partition.StrideN);
+    *RangeStartK = size_t(ThreadIdK) * Partition.StrideK;
+    *RangeCountK = std::min(K - *RangeStartK, Partition.StrideK);
+}
+
 //
 // Define the minimum floating point value (and its bit value equivalent) that
 // has no fractional bits. This number can be used for fast rounding of floating
@@ -1109,10 +1509,51 @@ MlasFp32FromBits(
     u.IntegerValue = IntegerValue;
     return u.FloatValue;
 }
+
+//
+// Rounds a single precision value to bfloat16, nearest even. A NaN stays a
+// quiet NaN instead of being rounded to infinity.
+//
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFp32ToBf16(
+    float Value
+    )
+{
+    uint32_t Bits = MlasBitsOfFp32(Value);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t((Bits >> 16) | 0x0040);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+}
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFp32(
+    uint16_t Value
+    )
+{
+    return MlasFp32FromBits(uint32_t(Value) << 16);
+}
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
 #endif
 
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 #if defined(MLAS_TARGET_WASM_SCALAR)
 
 void
@@ -1811,6 +2252,32 @@ MlasDivideFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasSqrtFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vsqrtq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 0)), Vector, 0);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 1)), Vector, 1);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 2)), Vector, 2);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 3)), Vector, 3);
+    return Vector;
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sqrt_ps(Vector);
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+    return wasm_f32x4_sqrt(Vector);
+#elif defined(MLAS_VSX_INTRINSICS)
+    return vec_sqrt(Vector);
+#else
+    for (size_t i = 0; i < 4; i++) {
+        Vector[i] = std::sqrt(Vector[i]);
+    }
+    return Vector;
+#endif
+}
+
 MLAS_FORCEINLINE
 MLAS_FLOAT32X4
 MlasGreaterThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
@@ -1828,6 +2295,23 @@ MlasGreaterThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasIsNanFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(Vector, Vector)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpunord_ps(Vector, Vector);
+#elif defined(MLAS_WASM_SIMD_INTRINSICS)
+    return wasm_f32x4_ne(Vector, Vector);
+#elif defined(MLAS_VSX_INTRINSICS)
+    return MLAS_FLOAT32X4(vec_nor(vec_cmpeq(Vector, Vector), vec_cmpeq(Vector, Vector)));
+#else
+    return Vector != Vector;
+#endif
+}
+
 MLAS_FORCEINLINE
 MLAS_FLOAT32X4
 MlasAndFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
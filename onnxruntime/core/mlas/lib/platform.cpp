@@ -72,7 +72,26 @@ MLASCPUIDInfo::MLASCPUIDInfo() {}
 #else // not MLAS_TARGET_ARM64
 
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
-MLASCPUIDInfo::MLASCPUIDInfo() {}
+MLASCPUIDInfo::MLASCPUIDInfo()
+{
+#if defined(MLAS_TARGET_AMD64_IX86)
+    unsigned CpuidExtended[4];
+#if defined(_WIN32)
+    __cpuid((int*)CpuidExtended, 0x80000000);
+#else
+    __cpuid(0x80000000, CpuidExtended[0], CpuidExtended[1], CpuidExtended[2], CpuidExtended[3]);
+#endif
+
+    if (CpuidExtended[0] >= 0x80000006) {
+#if defined(_WIN32)
+        __cpuid((int*)CpuidExtended, 0x80000006);
+#else
+        __cpuid(0x80000006, CpuidExtended[0], CpuidExtended[1], CpuidExtended[2], CpuidExtended[3]);
+#endif
+        l2_cache_size_ = (CpuidExtended[2] >> 16) * 1024;
+    }
+#endif
+}
 #endif
 
 #endif // MLAS_TARGET_ARM64
@@ -191,6 +210,12 @@ Return Value:
 --*/
 {
 
+    this->L2CacheSize = MLAS_CPUIDINFO::GetCPUIDInfo().GetL2CacheSize();
+
+    if (this->L2CacheSize == 0) {
+        this->L2CacheSize = MLAS_DEFAULT_L2_CACHE_SIZE;
+    }
+
     this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<uint8_t, int8_t>;
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
     this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernel<int8_t, int8_t>;
@@ -226,10 +251,26 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ReduceVectorF32Kernel = MlasReduceVectorF32Kernel;
+    this->ReduceAccumulateF32Kernel = MlasReduceAccumulateF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
+    this->EltwiseBinaryF32Kernel = MlasEltwiseBinaryF32Kernel;
+    this->UnaryFunctionF32Kernel = MlasUnaryFunctionF32Kernel;
+    this->SparseGemmKernel = MlasSparseGemmKernel;
+    this->CastF16ToF32Kernel = MlasCastF16ToF32Kernel;
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
+    this->CastBf16ToF32Kernel = MlasCastBf16ToF32Kernel;
+    this->CastF32ToBf16Kernel = MlasCastF32ToBf16Kernel;
+    this->CastF32ToS32Kernel = MlasCastF32ToS32Kernel;
+    this->CastF32ToS8Kernel = MlasCastF32ToS8Kernel;
+    this->CastF32ToU8Kernel = MlasCastF32ToU8Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8Kernel;
+    this->HalfGemmDispatch = &MlasHalfGemmDispatchDefault;
+    this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchDefault;
+    this->Bf16GemmDispatch = &MlasBf16GemmDispatchDefault;
 
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
@@ -313,6 +354,8 @@ Return Value:
                 this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx2;
 
                 this->GemmFloatKernel = MlasGemmFloatKernelFma3;
+                this->KernelSmallMRoutine = MlasSgemmSmallMKernelAvx2;
+                this->KernelSmallMTransposeBRoutine = MlasSgemmSmallMKernelTransposeBAvx2;
                 this->GemmDoubleKernel = MlasGemmDoubleKernelFma3;
                 this->ConvNchwFloatKernel = MlasConvNchwFloatKernelFma3;
                 this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelFma3;
@@ -324,11 +367,35 @@ Return Value:
                 this->ErfKernelRoutine = MlasErfKernelFma3;
                 this->QLinearAddS8Kernel = MlasQLinearAddS8KernelAvx2;
                 this->QLinearAddU8Kernel = MlasQLinearAddU8KernelAvx2;
+                this->ReduceVectorF32Kernel = MlasReduceVectorF32KernelAvx2;
+                this->ReduceAccumulateF32Kernel = MlasReduceAccumulateF32KernelAvx2;
+                this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx2;
+                this->EltwiseBinaryF32Kernel = MlasEltwiseBinaryF32KernelAvx2;
+                this->UnaryFunctionF32Kernel = MlasUnaryFunctionF32KernelAvx2;
+                this->SparseGemmKernel = MlasSparseGemmKernelAvx2;
+                this->CastBf16ToF32Kernel = MlasCastBf16ToF32KernelAvx2;
+                this->CastF32ToBf16Kernel = MlasCastF32ToBf16KernelAvx2;
+                this->CastF32ToS32Kernel = MlasCastF32ToS32KernelAvx2;
+                this->CastF32ToS8Kernel = MlasCastF32ToS8KernelAvx2;
+                this->CastF32ToU8Kernel = MlasCastF32ToU8KernelAvx2;
                 this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t, int8_t>;
                 this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernelAvx2<uint8_t, uint8_t>;
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx2;
+
+                //
+                // Check if the processor supports F16C to convert half
+                // precision elements for the fp32 accumulating fp16 GEMM and
+                // the element type conversions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx2;
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -367,6 +434,8 @@ Return Value:
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
+                    this->KernelSmallMRoutine = MlasSgemmSmallMKernelAvx512F;
+                    this->KernelSmallMTransposeBRoutine = MlasSgemmSmallMKernelTransposeBAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
                     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelAvx512F;
@@ -377,8 +446,13 @@ Return Value:
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
+                    this->ReduceVectorF32Kernel = MlasReduceVectorF32KernelAvx512F;
+                    this->ReduceAccumulateF32Kernel = MlasReduceAccumulateF32KernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
+                    this->UnaryFunctionF32Kernel = MlasUnaryFunctionF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx512;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -405,18 +479,57 @@ Return Value:
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                         }
+
+#ifdef MLAS_AVX512FP16_SUPPORTED
+                        //
+                        // Check if the processor supports AVX512-FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                        }
+#endif // MLAS_AVX512FP16_SUPPORTED
+
+#ifdef MLAS_AMX_SUPPORTED
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->Bf16GemmDispatch = &MlasBf16GemmDispatchAvx512Bf16;
+                        }
+#endif // MLAS_AMX_SUPPORTED
                     }
                 }
 
 #ifdef MLAS_AMX_SUPPORTED
                 //
                 // Check if the processor supports AMX-TILE and AMX-INT8
-                // features.
+                // features. The symmetric convolution uses the AVX512VNNI
+                // depthwise kernels.
                 //
                 if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 25) != 0) {
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        if (this->ConvSymU8S8Dispatch == &MlasConvSymDispatchAvx512Vnni) {
+                            this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAmx;
+                            this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchAmx;
+                        }
+                    }
+                }
+
+                //
+                // Check if the processor supports AMX-TILE and AMX-BF16
+                // features. The AMX kernel processes small matrices with the
+                // AVX512_BF16 kernel.
+                //
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 22) != 0 &&
+                    this->Bf16GemmDispatch == &MlasBf16GemmDispatchAvx512Bf16) {
+                    if (MlasInitAMX()) {
+                        this->Bf16GemmDispatch = &MlasBf16GemmDispatchAmx;
                     }
                 }
 #endif // MLAS_AMX_SUPPORTED
@@ -523,6 +636,109 @@ Return Value:
 #endif
 }
 
+uint64_t
+MLASCALL
+MlasGetPlatformId(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns an identifier of the processor features that select
+    the kernels of this library, and therefore the layout of packed buffers.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the platform identifier.
+
+--*/
+{
+    //
+    // Combine the feature registers with an FNV-1a hash.
+    //
+
+    uint64_t PlatformId = 0xCBF29CE484222325ull;
+
+    auto CombineValue = [&PlatformId](uint64_t Value) {
+        for (size_t i = 0; i < sizeof(Value); i++) {
+            PlatformId ^= (Value >> (i * 8)) & 0xFF;
+            PlatformId *= 0x100000001B3ull;
+        }
+    };
+
+    CombineValue(sizeof(void*));
+
+#if defined(MLAS_AMX_SUPPORTED)
+    CombineValue(1);
+#endif
+#if defined(MLAS_AVX512FP16_SUPPORTED)
+    CombineValue(2);
+#endif
+#if defined(ORT_MINIMAL_BUILD)
+    CombineValue(3);
+#endif
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+
+    unsigned Cpuid0[4];
+    unsigned Cpuid1[4];
+#if defined(_WIN32)
+    __cpuid((int*)Cpuid0, 0);
+    __cpuid((int*)Cpuid1, 1);
+#else
+    __cpuid(0, Cpuid0[0], Cpuid0[1], Cpuid0[2], Cpuid0[3]);
+    __cpuid(1, Cpuid1[0], Cpuid1[1], Cpuid1[2], Cpuid1[3]);
+#endif
+
+    CombineValue(Cpuid1[2]);
+    CombineValue(Cpuid1[3]);
+
+    //
+    // The enabled register state of the operating system decides between
+    // kernels as well as the processor features.
+    //
+
+    if ((Cpuid1[2] & 0x8000000) != 0) {
+        CombineValue(MlasReadExtendedControlRegister(_XCR_XFEATURE_ENABLED_MASK));
+    }
+
+    if (Cpuid0[0] >= 7) {
+
+        unsigned Cpuid7[4];
+        unsigned Cpuid7_1[4];
+#if defined(_WIN32)
+        __cpuidex((int*)Cpuid7, 7, 0);
+        __cpuidex((int*)Cpuid7_1, 7, 1);
+#else
+        __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
+        __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
+#endif
+
+        CombineValue(Cpuid7[1]);
+        CombineValue(Cpuid7[2]);
+        CombineValue(Cpuid7[3]);
+        CombineValue(Cpuid7_1[0]);
+    }
+
+#elif defined(MLAS_TARGET_ARM64) && defined(_WIN32)
+
+    CombineValue(IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE) != 0);
+
+#elif (defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_POWER)) && defined(__linux__)
+
+    CombineValue(getauxval(AT_HWCAP));
+    CombineValue(getauxval(AT_HWCAP2));
+
+#endif
+
+    return PlatformId;
+}
+
 #ifdef MLAS_TARGET_AMD64_IX86
 
 bool
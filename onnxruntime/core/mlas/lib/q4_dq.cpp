@@ -0,0 +1,242 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4_dq.cpp
+
+Abstract:
+
+    This module contains the data structures and implementations
+    for blocked int4 quantization and dequantization.
+
+    Int4 block quantization is used to compress the weight tensors of large
+    language models.
+
+--*/
+
+#include "q4common.h"
+
+/**
+ * @brief Computes the scale and zero point of a block.
+ *
+ * @param[in]  Src        Address of the first value of the block
+ * @param[in]  ld         Distance between consecutive values of the block
+ * @param[in]  Count      Number of values in the block, the remaining values
+ *                        of the block are treated as zero
+ * @param[out] Scale      Scale of the block
+ * @param[out] ZeroPoint  Zero point of the block
+ */
+template<typename Q4Type>
+MLAS_FORCEINLINE
+void
+MlasQ4ComputeBlockParams(
+    const float* Src,
+    size_t ld,
+    size_t Count,
+    float& Scale,
+    uint8_t& ZeroPoint
+    )
+{
+    if (Q4Type::HasZeroPoint) {
+
+        float min = 0.0f;
+        float max = 0.0f;
+        for (size_t i = 0; i < Count; i++) {
+            const float v = Src[i * ld];
+            min = std::min(min, v);
+            max = std::max(max, v);
+        }
+
+        Scale = (max - min) / 15.0f;
+
+        float zp = 0.0f;
+        if (Scale != 0.0f) {
+            zp = std::min(15.0f, std::max(0.0f, roundf(-min / Scale)));
+        }
+        ZeroPoint = uint8_t(zp);
+
+    } else {
+
+        //
+        // Map the value of the largest magnitude to -8, so that the full
+        // range [-8, 7] of the int4 type is used.
+        //
+
+        float amax = 0.0f;
+        float max = 0.0f;
+        for (size_t i = 0; i < Count; i++) {
+            const float v = Src[i * ld];
+            if (amax < fabsf(v)) {
+                amax = fabsf(v);
+                max = v;
+            }
+        }
+
+        Scale = max / -8.0f;
+        ZeroPoint = 8;
+    }
+}
+
+template<typename Q4Type>
+void
+MlasQ4GemmPackBImpl(
+    void* PackedBuf,
+    const float* FpData,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    auto* dst_ptr = reinterpret_cast<uint8_t*>(PackedBuf);
+
+    for (size_t n = 0; n < N; n++) {
+        const float* src = FpData + n;
+
+        for (size_t k = 0; k < K; k += Q4Type::BlkLen) {
+            const size_t klen = std::min(Q4Type::BlkLen, K - k);
+
+            float scale;
+            uint8_t zp;
+            MlasQ4ComputeBlockParams<Q4Type>(src, ldb, klen, scale, zp);
+            const float reciprocal_scale = (scale != 0.0f) ? 1.0f / scale : 0.0f;
+
+            MlasQ4BlkSetScale<Q4Type>(dst_ptr, scale);
+            if (Q4Type::HasZeroPoint) {
+                dst_ptr[sizeof(float)] = zp;
+            }
+            uint8_t* data = MlasQ4BlkData<Q4Type>(dst_ptr);
+
+            for (size_t kk = 0; kk < Q4Type::BlkLen; kk += MLAS_Q4_GROUP_LEN) {
+                for (size_t l = 0; l < MLAS_Q4_GROUP_LEN / 2; l++) {
+                    uint8_t vi[2];
+                    for (size_t h = 0; h < 2; h++) {
+                        const size_t idx = kk + l + h * (MLAS_Q4_GROUP_LEN / 2);
+                        if (idx < klen) {
+                            const float v = src[idx * ldb] * reciprocal_scale + float(zp);
+                            vi[h] = uint8_t(std::min(15.0f, std::max(0.0f, roundf(v))));
+                        } else {
+                            vi[h] = zp;
+                        }
+                    }
+                    data[l] = vi[0] | (vi[1] << 4);
+                }
+                data += MLAS_Q4_GROUP_LEN / 2;
+            }
+
+            src += ldb * klen;
+            dst_ptr += Q4Type::BlobSize;
+        }
+    }
+}
+
+template<typename Q4Type>
+void
+MlasQ4GemmUnPackBImpl(
+    float* FpData,
+    const void* PackedBuf,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    const auto* src = reinterpret_cast<const uint8_t*>(PackedBuf);
+
+    for (size_t n = 0; n < N; n++) {
+        float* dest = FpData + n;
+
+        for (size_t k = 0; k < K; k += Q4Type::BlkLen) {
+            const size_t klen = std::min(Q4Type::BlkLen, K - k);
+
+            const float scale = MlasQ4BlkScale<Q4Type>(src);
+            const float zp = float(MlasQ4BlkZeroPoint<Q4Type>(src));
+            const uint8_t* data = MlasQ4BlkData<Q4Type>(src);
+
+            for (size_t kk = 0; kk < klen; kk++) {
+                const size_t group = kk / MLAS_Q4_GROUP_LEN;
+                const size_t l = kk % MLAS_Q4_GROUP_LEN;
+                const uint8_t b = data[group * (MLAS_Q4_GROUP_LEN / 2) + (l % (MLAS_Q4_GROUP_LEN / 2))];
+                const uint8_t vi = (l < MLAS_Q4_GROUP_LEN / 2) ? (b & 0x0F) : (b >> 4);
+                dest[kk * ldb] = (float(vi) - zp) * scale;
+            }
+
+            dest += ldb * klen;
+            src += Q4Type::BlobSize;
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    MLAS_BLK_QUANT_TYPE QType,
+    size_t N,
+    size_t K
+    )
+{
+    switch (QType) {
+        case BlkQ4Sym:
+            return N * MlasQ4GemmPackedBLeadingDim<MLAS_Q4TYPE_BLK0>(K);
+        case BlkQ4Zp8:
+            return N * MlasQ4GemmPackedBLeadingDim<MLAS_Q4TYPE_BLK1>(K);
+        case BlkQ4Sym64:
+            return N * MlasQ4GemmPackedBLeadingDim<MLAS_Q4TYPE_BLK2>(K);
+        case BlkQ4Sym128:
+            return N * MlasQ4GemmPackedBLeadingDim<MLAS_Q4TYPE_BLK4>(K);
+        default:
+            return 0;
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmPackB(
+    MLAS_BLK_QUANT_TYPE QType,
+    void* PackedBuf,
+    const float* FpData,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    switch (QType) {
+        case BlkQ4Sym:
+            return MlasQ4GemmPackBImpl<MLAS_Q4TYPE_BLK0>(PackedBuf, FpData, N, K, ldb);
+        case BlkQ4Zp8:
+            return MlasQ4GemmPackBImpl<MLAS_Q4TYPE_BLK1>(PackedBuf, FpData, N, K, ldb);
+        case BlkQ4Sym64:
+            return MlasQ4GemmPackBImpl<MLAS_Q4TYPE_BLK2>(PackedBuf, FpData, N, K, ldb);
+        case BlkQ4Sym128:
+            return MlasQ4GemmPackBImpl<MLAS_Q4TYPE_BLK4>(PackedBuf, FpData, N, K, ldb);
+        default:
+            MLAS_THROW_EX(std::invalid_argument, "Unknown block quantization type!");
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmUnPackB(
+    MLAS_BLK_QUANT_TYPE QType,
+    float* FpData,
+    const void* PackedBuf,
+    size_t N,
+    size_t K,
+    size_t ldb
+    )
+{
+    switch (QType) {
+        case BlkQ4Sym:
+            return MlasQ4GemmUnPackBImpl<MLAS_Q4TYPE_BLK0>(FpData, PackedBuf, N, K, ldb);
+        case BlkQ4Zp8:
+            return MlasQ4GemmUnPackBImpl<MLAS_Q4TYPE_BLK1>(FpData, PackedBuf, N, K, ldb);
+        case BlkQ4Sym64:
+            return MlasQ4GemmUnPackBImpl<MLAS_Q4TYPE_BLK2>(FpData, PackedBuf, N, K, ldb);
+        case BlkQ4Sym128:
+            return MlasQ4GemmUnPackBImpl<MLAS_Q4TYPE_BLK4>(FpData, PackedBuf, N, K, ldb);
+        default:
+            MLAS_THROW_EX(std::invalid_argument, "Unknown block quantization type!");
+    }
+}
@@ -0,0 +1,144 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4common.h
+
+Abstract:
+
+    Define int4 block quantization types.
+
+    Int4 block quantization is used to compress the weight tensors of large
+    language models. A block holds BlkLen consecutive values of a column of
+    the weight matrix, stored as a fp32 scale, an optional uint8 zero point
+    and the 4-bit quantized values.
+
+    The 4-bit values are stored in groups of 32: byte j of a group holds the
+    j-th value in the low nibble and the (j+16)-th value in the high nibble,
+    so that a group unpacks into two vectors of 16 consecutive values.
+
+--*/
+
+#pragma once
+
+#include "mlas_q4.h"
+#include "mlasi.h"
+
+#include <math.h>
+#include <algorithm>
+#include <cstring>
+
+//
+// Number of values sharing one byte layout group. All block lengths are
+// multiples of this value.
+//
+
+constexpr size_t MLAS_Q4_GROUP_LEN = 32;
+
+/**
+ * @brief Symmetric int4 block quantization, where the zero point is fixed
+ *        at 8 and not stored.
+ *
+ * @tparam BLen  Number of values in a block
+ */
+template<size_t BLen>
+struct MLAS_Q4TYPE_BLK_SYM {
+    static constexpr size_t BlkLen = BLen;
+    static constexpr bool HasZeroPoint = false;
+    static constexpr size_t DataOffset = sizeof(float);
+    static constexpr size_t BlobSize = DataOffset + BlkLen / 2;
+
+    static_assert(BlkLen % MLAS_Q4_GROUP_LEN == 0, "Block length must be a multiple of 32!");
+};
+
+/**
+ * @brief Asymmetric int4 block quantization with a uint8 zero point stored
+ *        after the scale.
+ */
+struct MLAS_Q4TYPE_BLK_ZP8 {
+    static constexpr size_t BlkLen = 32;
+    static constexpr bool HasZeroPoint = true;
+    static constexpr size_t DataOffset = sizeof(float) + sizeof(uint8_t);
+    static constexpr size_t BlobSize = DataOffset + BlkLen / 2;
+};
+
+using MLAS_Q4TYPE_BLK0 = MLAS_Q4TYPE_BLK_SYM<32>;
+using MLAS_Q4TYPE_BLK1 = MLAS_Q4TYPE_BLK_ZP8;
+using MLAS_Q4TYPE_BLK2 = MLAS_Q4TYPE_BLK_SYM<64>;
+using MLAS_Q4TYPE_BLK4 = MLAS_Q4TYPE_BLK_SYM<128>;
+
+//
+// Blocks are not necessarily aligned on a 4 byte boundary, so the scale is
+// accessed through memcpy.
+//
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+float
+MlasQ4BlkScale(
+    const uint8_t* BlkPtr
+    )
+{
+    float Scale;
+    std::memcpy(&Scale, BlkPtr, sizeof(float));
+    return Scale;
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+void
+MlasQ4BlkSetScale(
+    uint8_t* BlkPtr,
+    float Scale
+    )
+{
+    std::memcpy(BlkPtr, &Scale, sizeof(float));
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+uint8_t
+MlasQ4BlkZeroPoint(
+    const uint8_t* BlkPtr
+    )
+{
+    return Q4Type::HasZeroPoint ? BlkPtr[sizeof(float)] : uint8_t(8);
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+const uint8_t*
+MlasQ4BlkData(
+    const uint8_t* BlkPtr
+    )
+{
+    return BlkPtr + Q4Type::DataOffset;
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+uint8_t*
+MlasQ4BlkData(
+    uint8_t* BlkPtr
+    )
+{
+    return BlkPtr + Q4Type::DataOffset;
+}
+
+/**
+ * @brief Returns the number of bytes used by one column of the packed
+ *        matrix B, i.e. the leading dimension of the packed buffer.
+ */
+template<typename Q4Type>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmPackedBLeadingDim(
+    size_t K
+    )
+{
+    return MlasDivRoundup(K, Q4Type::BlkLen) * Q4Type::BlobSize;
+}
@@ -0,0 +1,246 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with compressed
+    weight tensor (right hand side). The assumption is the right hand side
+    tensor can be pre-packed and compressed using int-4 quantization to save
+    memory.
+
+--*/
+
+#include "q4gemm.h"
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    MLAS_BLK_QUANT_TYPE QType,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_Q4_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_Q4GEMM_OPERATION* operation = MlasFpQ4GemmGetDispatch()->Operations[QType];
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            auto Data = &DataParams[gemm_i];
+            operation(K, Data, 0, M, 0, N);
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the SGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = MLAS_Q4GEMM_STRIDEM;
+
+    size_t nc = N;
+    if (ThreadsPerGemm > 1) {
+        // more than one thread per GEMM
+
+        const size_t BlockedM = MlasDivRoundup(M, StrideM);
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
+                                  MLAS_QGEMM_STRIDEN_THREAD_ALIGN);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+        auto Data = &DataParams[gemm_i];
+
+        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
+        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, (size_t)StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
+
+        operation(K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
+
+//
+// Portable kernel, used on platforms without a vectorized kernel.
+//
+
+struct MLAS_FP_Q4_GEMM_KERNEL_DEFAULT {
+    static constexpr size_t KernelMaxM = 1;
+    static constexpr size_t StrideN = 16;
+};
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernelDefault(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t ldb,
+    const float* Bias
+    )
+{
+    for (size_t n = 0; n < CountN; n++) {
+        const uint8_t* b = PackedB + n * ldb;
+        float sum = (Bias == nullptr) ? 0.0f : Bias[n];
+
+        for (size_t k = 0; k < CountK; k += Q4Type::BlkLen) {
+            const size_t klen = std::min(Q4Type::BlkLen, CountK - k);
+
+            const float scale = MlasQ4BlkScale<Q4Type>(b);
+            const float zp = float(MlasQ4BlkZeroPoint<Q4Type>(b));
+            const uint8_t* data = MlasQ4BlkData<Q4Type>(b);
+
+            for (size_t kk = 0; kk < klen; kk++) {
+                const size_t l = kk % MLAS_Q4_GROUP_LEN;
+                const uint8_t v = data[(kk / MLAS_Q4_GROUP_LEN) * (MLAS_Q4_GROUP_LEN / 2) +
+                                       (l % (MLAS_Q4_GROUP_LEN / 2))];
+                const uint8_t vi = (l < MLAS_Q4_GROUP_LEN / 2) ? (v & 0x0F) : (v >> 4);
+                sum += A[k + kk] * ((float(vi) - zp) * scale);
+            }
+
+            b += Q4Type::BlobSize;
+        }
+
+        C[n] = sum;
+    }
+
+    return 1;
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+    return MlasQ4GemmKernelDefault<MLAS_Q4TYPE_BLK0>(A, PackedB, C, CountN, CountK, ldb, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+    return MlasQ4GemmKernelDefault<MLAS_Q4TYPE_BLK1>(A, PackedB, C, CountN, CountK, ldb, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+    return MlasQ4GemmKernelDefault<MLAS_Q4TYPE_BLK2>(A, PackedB, C, CountN, CountK, ldb, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+    return MlasQ4GemmKernelDefault<MLAS_Q4TYPE_BLK4>(A, PackedB, C, CountN, CountK, ldb, Bias);
+}
+
+const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchDefault = {
+    {
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>,
+        MlasQ4GemmOperation<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_DEFAULT>
+    }
+};
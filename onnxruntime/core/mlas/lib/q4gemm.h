@@ -0,0 +1,143 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.h
+
+Abstract:
+
+    This module defines the set of template functions to implement the
+    matrix/matrix multiply operation with a fp32 matrix A and an int4 block
+    quantized matrix B.
+
+    The weights are dequantized on the fly inside the kernel, so that the
+    memory traffic for matrix B is about 1/8 of that of a fp32 matrix.
+
+    To implement a new kernel, the template function MlasQ4GemmKernel needs
+    to be specialized for the kernel type and the four block quantization
+    types. MlasQ4GemmOperation is the shared kernel driver.
+
+    A kernel type should define the following constants:
+        size_t KernelMaxM;       Max # rows the vectorized kernel can process
+        size_t StrideN;          # of columns of B processed for all rows of
+                                 A before moving to the next columns
+
+--*/
+
+#pragma once
+
+#include "q4common.h"
+
+//
+// Number of rows of matrix A handled by a thread.
+//
+
+constexpr size_t MLAS_Q4GEMM_STRIDEM = 32;
+
+/**
+ * @brief Compute a tile of matrix C: C = A * B + Bias
+ *
+ * @tparam Q4Type      Block quantization type of B
+ * @tparam KernelType  Kernel type
+ * @param[in]  A       Address of matrix A
+ * @param[in]  PackedB Address of the first packed column of B
+ * @param[out] C       Address of matrix C
+ * @param[in]  CountM  # of rows of A to process
+ * @param[in]  CountN  # of columns of B and C to process
+ * @param[in]  CountK  # of columns of A and rows of B
+ * @param[in]  lda     Leading dimension of A
+ * @param[in]  ldb     Leading dimension of the packed B, in bytes
+ * @param[in]  ldc     Leading dimension of C
+ * @param[in]  Bias    Address of Bias, may be nullptr
+ * @return     # of rows processed, at most KernelType::KernelMaxM
+ */
+template<typename Q4Type, typename KernelType>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    );
+
+template<typename Q4Type, typename KernelType>
+void
+MlasQ4GemmOperation(
+    const size_t K,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t lda = Data->lda;
+    const size_t ldb = MlasQ4GemmPackedBLeadingDim<Q4Type>(K);
+    const size_t ldc = Data->ldc;
+
+    //
+    // Step through matrix B in panels along the N dimension, so that a panel
+    // stays in cache while all rows of matrix A are multiplied with it.
+    //
+
+    size_t CountN;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+        CountN = std::min(RangeCountN - n, KernelType::StrideN);
+
+        const uint8_t* b = reinterpret_cast<const uint8_t*>(Data->B) + (RangeStartN + n) * ldb;
+        const float* a = Data->A + RangeStartM * lda;
+        float* c = Data->C + RangeStartM * ldc + RangeStartN + n;
+        const float* Bias = (Data->Bias == nullptr) ? nullptr : Data->Bias + RangeStartN + n;
+
+        size_t RowsRemaining = RangeCountM;
+        while (RowsRemaining > 0) {
+            const size_t RowsHandled = MlasQ4GemmKernel<Q4Type, KernelType>(
+                a, b, c, RowsRemaining, CountN, K, lda, ldb, ldc, Bias);
+
+            c += ldc * RowsHandled;
+            a += lda * RowsHandled;
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
+typedef
+void
+(MLAS_Q4GEMM_OPERATION)(
+    const size_t K,
+    const MLAS_Q4_GEMM_DATA_PARAMS* DataParams,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    );
+
+/**
+ * @brief Kernel driver for each block quantization type, indexed by
+ *        MLAS_BLK_QUANT_TYPE
+ */
+struct MLAS_FPQ4GEMM_DISPATCH {
+    MLAS_Q4GEMM_OPERATION* Operations[4];
+};
+
+MLAS_FORCEINLINE
+const MLAS_FPQ4GEMM_DISPATCH*
+MlasFpQ4GemmGetDispatch()
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().FpQ4GemmDispatch;
+#else
+    return &MlasFpQ4GemmDispatchDefault;
+#endif
+}
@@ -0,0 +1,211 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_kernel_sdot.cpp
+
+Abstract:
+
+    This module implements the symmetric quantized integer depthwise
+    convolution kernels for 3x3 and 5x5 filters.
+
+    This implementation uses ARM v8.2 dot product instructions. SDOT
+    accumulates the products of four adjacent bytes into each 32-bit lane, so
+    the filter is packed with four kernel elements of a channel adjacent to
+    each other (see MlasConvSymPackW) and the kernel transposes four input rows
+    of the indirection buffer to the same layout.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t KernelSize, bool InputIsSigned>
+void
+MlasConvSymDepthwiseKernelDot(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    constexpr size_t KernelPackCount = 4;
+    constexpr size_t PaddedKernelSize = (KernelSize + KernelPackCount - 1) / KernelPackCount * KernelPackCount;
+
+    const uint8_t* const* Input = reinterpret_cast<const uint8_t* const*>(InputIndirection);
+    uint8_t* output = static_cast<uint8_t*>(Output);
+
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+    const uint8x16_t vu128 = vdupq_n_u8(128);
+    const int16x8_t voutput_zero_point = vdupq_n_s16(int16_t(PostProcessParams->OutputZeroPoint));
+    const float32x4_t vbroadcast_scale = vld1q_dup_f32(PostProcessParams->Scale);
+
+    while (OutputCount-- > 0) {
+
+        //
+        // The kernel elements beyond KernelSize have zero filter values, so
+        // these reuse the last input row.
+        //
+
+        const uint8_t* InputRows[PaddedKernelSize];
+
+        for (size_t k = 0; k < PaddedKernelSize; k++) {
+            InputRows[k] = Input[(k < KernelSize) ? k : KernelSize - 1];
+        }
+
+        Input += KernelSize;
+
+        int32_t const* bias = PostProcessParams->Bias;
+        float const* scale = PostProcessParams->Scale;
+
+        for (size_t c = 0; c < Channels; c += 16) {
+
+            //
+            // The packed filter interleaves the 16 byte chunks of the groups
+            // of 16 channels of each block (see MlasConvSymDepthwiseDotBlockWidth).
+            //
+
+            const size_t ChunkStride = MlasConvSymDepthwiseDotBlockWidth(Channels, c);
+            const size_t BlockStart = c & ~(ChunkStride - 1);
+            int8_t const* w = Filter + BlockStart * KernelPackCount + (c - BlockStart);
+
+            int32x4_t vacc_0123 = vld1q_s32(bias); bias += 4;
+            int32x4_t vacc_4567 = vld1q_s32(bias); bias += 4;
+            int32x4_t vacc_89AB = vld1q_s32(bias); bias += 4;
+            int32x4_t vacc_CDEF = vld1q_s32(bias); bias += 4;
+
+            for (size_t k = 0; k < PaddedKernelSize; k += KernelPackCount) {
+
+                int8x16_t vi0, vi1, vi2, vi3;
+
+                if (InputIsSigned) {
+                    vi0 = vld1q_s8(reinterpret_cast<const int8_t*>(InputRows[k + 0] + c));
+                    vi1 = vld1q_s8(reinterpret_cast<const int8_t*>(InputRows[k + 1] + c));
+                    vi2 = vld1q_s8(reinterpret_cast<const int8_t*>(InputRows[k + 2] + c));
+                    vi3 = vld1q_s8(reinterpret_cast<const int8_t*>(InputRows[k + 3] + c));
+                } else {
+                    vi0 = vreinterpretq_s8_u8(veorq_u8(vu128, vld1q_u8(InputRows[k + 0] + c)));
+                    vi1 = vreinterpretq_s8_u8(veorq_u8(vu128, vld1q_u8(InputRows[k + 1] + c)));
+                    vi2 = vreinterpretq_s8_u8(veorq_u8(vu128, vld1q_u8(InputRows[k + 2] + c)));
+                    vi3 = vreinterpretq_s8_u8(veorq_u8(vu128, vld1q_u8(InputRows[k + 3] + c)));
+                }
+
+                const int16x8_t vi01_lo = vreinterpretq_s16_s8(vzip1q_s8(vi0, vi1));
+                const int16x8_t vi01_hi = vreinterpretq_s16_s8(vzip2q_s8(vi0, vi1));
+                const int16x8_t vi23_lo = vreinterpretq_s16_s8(vzip1q_s8(vi2, vi3));
+                const int16x8_t vi23_hi = vreinterpretq_s16_s8(vzip2q_s8(vi2, vi3));
+
+                vacc_0123 = vdotq_s32(vacc_0123, vreinterpretq_s8_s16(vzip1q_s16(vi01_lo, vi23_lo)), vld1q_s8(w));
+                vacc_4567 = vdotq_s32(vacc_4567, vreinterpretq_s8_s16(vzip2q_s16(vi01_lo, vi23_lo)), vld1q_s8(w + ChunkStride));
+                vacc_89AB = vdotq_s32(vacc_89AB, vreinterpretq_s8_s16(vzip1q_s16(vi01_hi, vi23_hi)), vld1q_s8(w + 2 * ChunkStride));
+                vacc_CDEF = vdotq_s32(vacc_CDEF, vreinterpretq_s8_s16(vzip2q_s16(vi01_hi, vi23_hi)), vld1q_s8(w + 3 * ChunkStride));
+
+                w += Channels * KernelPackCount;
+            }
+
+            float32x4_t vscale_0123 = vbroadcast_scale;
+            float32x4_t vscale_4567 = vbroadcast_scale;
+            float32x4_t vscale_89AB = vbroadcast_scale;
+            float32x4_t vscale_CDEF = vbroadcast_scale;
+
+            if (PerChannelScale) {
+                vscale_0123 = vld1q_f32(scale); scale += 4;
+                vscale_4567 = vld1q_f32(scale); scale += 4;
+                vscale_89AB = vld1q_f32(scale); scale += 4;
+                vscale_CDEF = vld1q_f32(scale); scale += 4;
+            }
+
+            // requantize
+            vacc_0123 = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(vacc_0123), vscale_0123));
+            vacc_4567 = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(vacc_4567), vscale_4567));
+            vacc_89AB = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(vacc_89AB), vscale_89AB));
+            vacc_CDEF = vcvtnq_s32_f32(vmulq_f32(vcvtq_f32_s32(vacc_CDEF), vscale_CDEF));
+
+            const int16x8_t vacc_01234567 = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc_0123), vacc_4567), voutput_zero_point);
+            const int16x8_t vacc_89ABCDEF = vqaddq_s16(vqmovn_high_s32(vqmovn_s32(vacc_89AB), vacc_CDEF), voutput_zero_point);
+
+            if (InputIsSigned) {
+                int8x16_t vout = vqmovn_high_s16(vqmovn_s16(vacc_01234567), vacc_89ABCDEF);
+                vst1q_s8(reinterpret_cast<int8_t*>(output), vout);
+            } else {
+                uint8x16_t vout = vqmovun_high_s16(vqmovun_s16(vacc_01234567), vacc_89ABCDEF);
+                vst1q_u8(output, vout);
+            }
+            output += 16;
+        }
+    }
+}
+
+extern "C" {
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize9DotU8S8(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelDot<9, false>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize9DotS8S8(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelDot<9, true>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize25DotU8S8(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelDot<25, false>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+void
+MLASCALL
+MlasConvSymDepthwiseKernelSize25DotS8S8(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+{
+    MlasConvSymDepthwiseKernelDot<25, true>(
+        InputIndirection, Filter, Channels, Output, OutputCount, PostProcessParams, KernelFlags);
+}
+
+}
@@ -0,0 +1,475 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qdwconv_vnni.h
+
+Abstract:
+
+    This module implements the symmetric quantized integer depthwise
+    convolution kernels for fixed kernel sizes using the VPDPBUSD instruction.
+
+    The kernels are shared by the AVX-VNNI and AVX512-VNNI implementations,
+    which differ in the encoding of the dot product instruction and in the
+    widest supported vector.
+
+    VPDPBUSD accumulates the products of four adjacent bytes into each 32-bit
+    lane, so the filter is packed with four kernel elements of a channel
+    adjacent to each other (see MlasConvSymPackW) and the kernel transposes
+    four input rows of the indirection buffer to the same layout. The
+    transpose operates within each 128-bit lane, so the accumulators hold the
+    channels of each group of 16 channels in the order {0-3}, {4-7}, {8-11}
+    and {12-15}, one group per 128-bit lane. The packed filter, bias and scale
+    vectors are arranged to match and the saturating packs restore the channel
+    order of the output.
+
+    The kernels process one block of channels for all of the output elements
+    at a time so that the rearranged bias and scale vectors and the filter are
+    loaded once per block.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Define the number of kernel elements packed into each 32-bit lane.
+//
+
+constexpr size_t MlasConvSymDepthwiseVnniPackCount = 4;
+
+template<size_t KernelSize>
+MLAS_FORCEINLINE
+const uint8_t*
+MlasConvSymDepthwiseVnniInputRow(
+    const uint8_t* const* InputRows,
+    size_t k
+    )
+{
+    //
+    // The kernel elements beyond KernelSize have zero filter values, so these
+    // reuse the last input row.
+    //
+
+    return InputRows[(k < KernelSize) ? k : KernelSize - 1];
+}
+
+template<typename VnniType, size_t KernelSize>
+MLAS_FORCEINLINE
+void
+MlasConvSymDepthwiseVnniBlock16(
+    const uint8_t* const* Input,
+    size_t Channels,
+    size_t ChannelOffset,
+    const int8_t* Filter,
+    uint8_t* Output,
+    size_t OutputCount,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams
+    )
+{
+    constexpr size_t PackCount = MlasConvSymDepthwiseVnniPackCount;
+    constexpr size_t KernelGroupCount = (KernelSize + PackCount - 1) / PackCount;
+
+    const __m128i Bias0 = _mm_loadu_si128((const __m128i*)&Bias[0]);
+    const __m128i Bias1 = _mm_loadu_si128((const __m128i*)&Bias[4]);
+    const __m128i Bias2 = _mm_loadu_si128((const __m128i*)&Bias[8]);
+    const __m128i Bias3 = _mm_loadu_si128((const __m128i*)&Bias[12]);
+
+    const __m128 Scale0 = PerChannelScale ? _mm_loadu_ps(&Scale[0]) : _mm_set1_ps(Scale[0]);
+    const __m128 Scale1 = PerChannelScale ? _mm_loadu_ps(&Scale[4]) : _mm_set1_ps(Scale[0]);
+    const __m128 Scale2 = PerChannelScale ? _mm_loadu_ps(&Scale[8]) : _mm_set1_ps(Scale[0]);
+    const __m128 Scale3 = PerChannelScale ? _mm_loadu_ps(&Scale[12]) : _mm_set1_ps(Scale[0]);
+
+    const __m128 MinimumValue = _mm_set1_ps(PostProcessParams->MinimumValue);
+    const __m128 MaximumValue = _mm_set1_ps(PostProcessParams->MaximumValue);
+    const __m128i OutputZeroPoint = _mm_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        const uint8_t* const* InputRows = &Input[o * KernelSize];
+
+        __m128i Accumulator0 = Bias0;
+        __m128i Accumulator1 = Bias1;
+        __m128i Accumulator2 = Bias2;
+        __m128i Accumulator3 = Bias3;
+
+        const int8_t* filter = Filter;
+
+        for (size_t g = 0; g < KernelGroupCount; g++) {
+
+            const size_t k = g * PackCount;
+
+            __m128i Row0 = _mm_loadu_si128((const __m128i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 0)[ChannelOffset]);
+            __m128i Row1 = _mm_loadu_si128((const __m128i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 1)[ChannelOffset]);
+            __m128i Row2 = _mm_loadu_si128((const __m128i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 2)[ChannelOffset]);
+            __m128i Row3 = _mm_loadu_si128((const __m128i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 3)[ChannelOffset]);
+
+            __m128i Rows01Low = _mm_unpacklo_epi8(Row0, Row1);
+            __m128i Rows01High = _mm_unpackhi_epi8(Row0, Row1);
+            __m128i Rows23Low = _mm_unpacklo_epi8(Row2, Row3);
+            __m128i Rows23High = _mm_unpackhi_epi8(Row2, Row3);
+
+            Accumulator0 = VnniType::DotProduct(Accumulator0, _mm_unpacklo_epi16(Rows01Low, Rows23Low),
+                _mm_loadu_si128((const __m128i*)&filter[0]));
+            Accumulator1 = VnniType::DotProduct(Accumulator1, _mm_unpackhi_epi16(Rows01Low, Rows23Low),
+                _mm_loadu_si128((const __m128i*)&filter[16]));
+            Accumulator2 = VnniType::DotProduct(Accumulator2, _mm_unpacklo_epi16(Rows01High, Rows23High),
+                _mm_loadu_si128((const __m128i*)&filter[32]));
+            Accumulator3 = VnniType::DotProduct(Accumulator3, _mm_unpackhi_epi16(Rows01High, Rows23High),
+                _mm_loadu_si128((const __m128i*)&filter[48]));
+
+            filter += Channels * PackCount;
+        }
+
+        __m128 Value0 = _mm_mul_ps(_mm_cvtepi32_ps(Accumulator0), Scale0);
+        __m128 Value1 = _mm_mul_ps(_mm_cvtepi32_ps(Accumulator1), Scale1);
+        __m128 Value2 = _mm_mul_ps(_mm_cvtepi32_ps(Accumulator2), Scale2);
+        __m128 Value3 = _mm_mul_ps(_mm_cvtepi32_ps(Accumulator3), Scale3);
+
+        Value0 = _mm_min_ps(_mm_max_ps(Value0, MinimumValue), MaximumValue);
+        Value1 = _mm_min_ps(_mm_max_ps(Value1, MinimumValue), MaximumValue);
+        Value2 = _mm_min_ps(_mm_max_ps(Value2, MinimumValue), MaximumValue);
+        Value3 = _mm_min_ps(_mm_max_ps(Value3, MinimumValue), MaximumValue);
+
+        __m128i Output0 = _mm_add_epi32(_mm_cvtps_epi32(Value0), OutputZeroPoint);
+        __m128i Output1 = _mm_add_epi32(_mm_cvtps_epi32(Value1), OutputZeroPoint);
+        __m128i Output2 = _mm_add_epi32(_mm_cvtps_epi32(Value2), OutputZeroPoint);
+        __m128i Output3 = _mm_add_epi32(_mm_cvtps_epi32(Value3), OutputZeroPoint);
+
+        __m128i Packed = _mm_packus_epi16(_mm_packus_epi32(Output0, Output1),
+                                          _mm_packus_epi32(Output2, Output3));
+        _mm_storeu_si128((__m128i*)&Output[o * Channels], Packed);
+    }
+}
+
+template<typename VnniType, size_t KernelSize>
+MLAS_FORCEINLINE
+void
+MlasConvSymDepthwiseVnniBlock32(
+    const uint8_t* const* Input,
+    size_t Channels,
+    size_t ChannelOffset,
+    const int8_t* Filter,
+    size_t FilterChunkStride,
+    uint8_t* Output,
+    size_t OutputCount,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams
+    )
+{
+    constexpr size_t PackCount = MlasConvSymDepthwiseVnniPackCount;
+    constexpr size_t KernelGroupCount = (KernelSize + PackCount - 1) / PackCount;
+
+    //
+    // Rearrange the bias and scale to the order of the accumulators: {0-3,
+    // 16-19}, {4-7, 20-23}, {8-11, 24-27} and {12-15, 28-31}.
+    //
+
+    __m256i BiasLow = _mm256_loadu_si256((const __m256i*)&Bias[0]);
+    __m256i BiasHigh = _mm256_loadu_si256((const __m256i*)&Bias[16]);
+    const __m256i Bias0 = _mm256_permute2x128_si256(BiasLow, BiasHigh, 0x20);
+    const __m256i Bias1 = _mm256_permute2x128_si256(BiasLow, BiasHigh, 0x31);
+    BiasLow = _mm256_loadu_si256((const __m256i*)&Bias[8]);
+    BiasHigh = _mm256_loadu_si256((const __m256i*)&Bias[24]);
+    const __m256i Bias2 = _mm256_permute2x128_si256(BiasLow, BiasHigh, 0x20);
+    const __m256i Bias3 = _mm256_permute2x128_si256(BiasLow, BiasHigh, 0x31);
+
+    __m256 Scale0 = _mm256_set1_ps(Scale[0]);
+    __m256 Scale1 = Scale0;
+    __m256 Scale2 = Scale0;
+    __m256 Scale3 = Scale0;
+
+    if (PerChannelScale) {
+        __m256 ScaleLow = _mm256_loadu_ps(&Scale[0]);
+        __m256 ScaleHigh = _mm256_loadu_ps(&Scale[16]);
+        Scale0 = _mm256_permute2f128_ps(ScaleLow, ScaleHigh, 0x20);
+        Scale1 = _mm256_permute2f128_ps(ScaleLow, ScaleHigh, 0x31);
+        ScaleLow = _mm256_loadu_ps(&Scale[8]);
+        ScaleHigh = _mm256_loadu_ps(&Scale[24]);
+        Scale2 = _mm256_permute2f128_ps(ScaleLow, ScaleHigh, 0x20);
+        Scale3 = _mm256_permute2f128_ps(ScaleLow, ScaleHigh, 0x31);
+    }
+
+    const __m256 MinimumValue = _mm256_set1_ps(PostProcessParams->MinimumValue);
+    const __m256 MaximumValue = _mm256_set1_ps(PostProcessParams->MaximumValue);
+    const __m256i OutputZeroPoint = _mm256_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        const uint8_t* const* InputRows = &Input[o * KernelSize];
+
+        __m256i Accumulator0 = Bias0;
+        __m256i Accumulator1 = Bias1;
+        __m256i Accumulator2 = Bias2;
+        __m256i Accumulator3 = Bias3;
+
+        const int8_t* filter = Filter;
+
+        for (size_t g = 0; g < KernelGroupCount; g++) {
+
+            const size_t k = g * PackCount;
+
+            __m256i Row0 = _mm256_loadu_si256((const __m256i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 0)[ChannelOffset]);
+            __m256i Row1 = _mm256_loadu_si256((const __m256i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 1)[ChannelOffset]);
+            __m256i Row2 = _mm256_loadu_si256((const __m256i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 2)[ChannelOffset]);
+            __m256i Row3 = _mm256_loadu_si256((const __m256i*)&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 3)[ChannelOffset]);
+
+            __m256i Rows01Low = _mm256_unpacklo_epi8(Row0, Row1);
+            __m256i Rows01High = _mm256_unpackhi_epi8(Row0, Row1);
+            __m256i Rows23Low = _mm256_unpacklo_epi8(Row2, Row3);
+            __m256i Rows23High = _mm256_unpackhi_epi8(Row2, Row3);
+
+            Accumulator0 = VnniType::DotProduct(Accumulator0, _mm256_unpacklo_epi16(Rows01Low, Rows23Low),
+                _mm256_loadu_si256((const __m256i*)&filter[0]));
+            Accumulator1 = VnniType::DotProduct(Accumulator1, _mm256_unpackhi_epi16(Rows01Low, Rows23Low),
+                _mm256_loadu_si256((const __m256i*)&filter[FilterChunkStride]));
+            Accumulator2 = VnniType::DotProduct(Accumulator2, _mm256_unpacklo_epi16(Rows01High, Rows23High),
+                _mm256_loadu_si256((const __m256i*)&filter[FilterChunkStride * 2]));
+            Accumulator3 = VnniType::DotProduct(Accumulator3, _mm256_unpackhi_epi16(Rows01High, Rows23High),
+                _mm256_loadu_si256((const __m256i*)&filter[FilterChunkStride * 3]));
+
+            filter += Channels * PackCount;
+        }
+
+        __m256 Value0 = _mm256_mul_ps(_mm256_cvtepi32_ps(Accumulator0), Scale0);
+        __m256 Value1 = _mm256_mul_ps(_mm256_cvtepi32_ps(Accumulator1), Scale1);
+        __m256 Value2 = _mm256_mul_ps(_mm256_cvtepi32_ps(Accumulator2), Scale2);
+        __m256 Value3 = _mm256_mul_ps(_mm256_cvtepi32_ps(Accumulator3), Scale3);
+
+        Value0 = _mm256_min_ps(_mm256_max_ps(Value0, MinimumValue), MaximumValue);
+        Value1 = _mm256_min_ps(_mm256_max_ps(Value1, MinimumValue), MaximumValue);
+        Value2 = _mm256_min_ps(_mm256_max_ps(Value2, MinimumValue), MaximumValue);
+        Value3 = _mm256_min_ps(_mm256_max_ps(Value3, MinimumValue), MaximumValue);
+
+        __m256i Output0 = _mm256_add_epi32(_mm256_cvtps_epi32(Value0), OutputZeroPoint);
+        __m256i Output1 = _mm256_add_epi32(_mm256_cvtps_epi32(Value1), OutputZeroPoint);
+        __m256i Output2 = _mm256_add_epi32(_mm256_cvtps_epi32(Value2), OutputZeroPoint);
+        __m256i Output3 = _mm256_add_epi32(_mm256_cvtps_epi32(Value3), OutputZeroPoint);
+
+        __m256i Packed = _mm256_packus_epi16(_mm256_packus_epi32(Output0, Output1),
+                                             _mm256_packus_epi32(Output2, Output3));
+        _mm256_storeu_si256((__m256i*)&Output[o * Channels], Packed);
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasConvSymDepthwiseVnniTranspose512(
+    __m512i& Vector0,
+    __m512i& Vector1,
+    __m512i& Vector2,
+    __m512i& Vector3
+    )
+{
+    //
+    // Transpose the 4x4 matrix of 128-bit lanes.
+    //
+
+    __m512i t0 = _mm512_shuffle_i32x4(Vector0, Vector1, 0x44);
+    __m512i t1 = _mm512_shuffle_i32x4(Vector2, Vector3, 0x44);
+    __m512i t2 = _mm512_shuffle_i32x4(Vector0, Vector1, 0xEE);
+    __m512i t3 = _mm512_shuffle_i32x4(Vector2, Vector3, 0xEE);
+
+    Vector0 = _mm512_shuffle_i32x4(t0, t1, 0x88);
+    Vector1 = _mm512_shuffle_i32x4(t0, t1, 0xDD);
+    Vector2 = _mm512_shuffle_i32x4(t2, t3, 0x88);
+    Vector3 = _mm512_shuffle_i32x4(t2, t3, 0xDD);
+}
+
+template<typename VnniType, size_t KernelSize>
+MLAS_FORCEINLINE
+void
+MlasConvSymDepthwiseVnniBlock64(
+    const uint8_t* const* Input,
+    size_t Channels,
+    size_t ChannelOffset,
+    const int8_t* Filter,
+    uint8_t* Output,
+    size_t OutputCount,
+    const int32_t* Bias,
+    const float* Scale,
+    bool PerChannelScale,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams
+    )
+{
+    constexpr size_t PackCount = MlasConvSymDepthwiseVnniPackCount;
+    constexpr size_t KernelGroupCount = (KernelSize + PackCount - 1) / PackCount;
+
+    //
+    // Rearrange the bias and scale to the order of the accumulators: the
+    // 128-bit lane L of accumulator j holds channels 16L+4j to 16L+4j+3.
+    //
+
+    __m512i Bias0 = _mm512_loadu_si512(&Bias[0]);
+    __m512i Bias1 = _mm512_loadu_si512(&Bias[16]);
+    __m512i Bias2 = _mm512_loadu_si512(&Bias[32]);
+    __m512i Bias3 = _mm512_loadu_si512(&Bias[48]);
+
+    MlasConvSymDepthwiseVnniTranspose512(Bias0, Bias1, Bias2, Bias3);
+
+    __m512i Scale0 = _mm512_castps_si512(_mm512_set1_ps(Scale[0]));
+    __m512i Scale1 = Scale0;
+    __m512i Scale2 = Scale0;
+    __m512i Scale3 = Scale0;
+
+    if (PerChannelScale) {
+        Scale0 = _mm512_loadu_si512(&Scale[0]);
+        Scale1 = _mm512_loadu_si512(&Scale[16]);
+        Scale2 = _mm512_loadu_si512(&Scale[32]);
+        Scale3 = _mm512_loadu_si512(&Scale[48]);
+        MlasConvSymDepthwiseVnniTranspose512(Scale0, Scale1, Scale2, Scale3);
+    }
+
+    const __m512 MinimumValue = _mm512_set1_ps(PostProcessParams->MinimumValue);
+    const __m512 MaximumValue = _mm512_set1_ps(PostProcessParams->MaximumValue);
+    const __m512i OutputZeroPoint = _mm512_set1_epi32(PostProcessParams->OutputZeroPoint);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+
+        const uint8_t* const* InputRows = &Input[o * KernelSize];
+
+        __m512i Accumulator0 = Bias0;
+        __m512i Accumulator1 = Bias1;
+        __m512i Accumulator2 = Bias2;
+        __m512i Accumulator3 = Bias3;
+
+        const int8_t* filter = Filter;
+
+        for (size_t g = 0; g < KernelGroupCount; g++) {
+
+            const size_t k = g * PackCount;
+
+            __m512i Row0 = _mm512_loadu_si512(&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 0)[ChannelOffset]);
+            __m512i Row1 = _mm512_loadu_si512(&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 1)[ChannelOffset]);
+            __m512i Row2 = _mm512_loadu_si512(&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 2)[ChannelOffset]);
+            __m512i Row3 = _mm512_loadu_si512(&MlasConvSymDepthwiseVnniInputRow<KernelSize>(InputRows, k + 3)[ChannelOffset]);
+
+            __m512i Rows01Low = _mm512_unpacklo_epi8(Row0, Row1);
+            __m512i Rows01High = _mm512_unpackhi_epi8(Row0, Row1);
+            __m512i Rows23Low = _mm512_unpacklo_epi8(Row2, Row3);
+            __m512i Rows23High = _mm512_unpackhi_epi8(Row2, Row3);
+
+            Accumulator0 = VnniType::DotProduct(Accumulator0, _mm512_unpacklo_epi16(Rows01Low, Rows23Low),
+                _mm512_loadu_si512(&filter[0]));
+            Accumulator1 = VnniType::DotProduct(Accumulator1, _mm512_unpackhi_epi16(Rows01Low, Rows23Low),
+                _mm512_loadu_si512(&filter[64]));
+            Accumulator2 = VnniType::DotProduct(Accumulator2, _mm512_unpacklo_epi16(Rows01High, Rows23High),
+                _mm512_loadu_si512(&filter[128]));
+            Accumulator3 = VnniType::DotProduct(Accumulator3, _mm512_unpackhi_epi16(Rows01High, Rows23High),
+                _mm512_loadu_si512(&filter[192]));
+
+            filter += Channels * PackCount;
+        }
+
+        __m512 Value0 = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator0), _mm512_castsi512_ps(Scale0));
+        __m512 Value1 = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator1), _mm512_castsi512_ps(Scale1));
+        __m512 Value2 = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator2), _mm512_castsi512_ps(Scale2));
+        __m512 Value3 = _mm512_mul_ps(_mm512_cvtepi32_ps(Accumulator3), _mm512_castsi512_ps(Scale3));
+
+        Value0 = _mm512_min_ps(_mm512_max_ps(Value0, MinimumValue), MaximumValue);
+        Value1 = _mm512_min_ps(_mm512_max_ps(Value1, MinimumValue), MaximumValue);
+        Value2 = _mm512_min_ps(_mm512_max_ps(Value2, MinimumValue), MaximumValue);
+        Value3 = _mm512_min_ps(_mm512_max_ps(Value3, MinimumValue), MaximumValue);
+
+        __m512i Output0 = _mm512_add_epi32(_mm512_cvtps_epi32(Value0), OutputZeroPoint);
+        __m512i Output1 = _mm512_add_epi32(_mm512_cvtps_epi32(Value1), OutputZeroPoint);
+        __m512i Output2 = _mm512_add_epi32(_mm512_cvtps_epi32(Value2), OutputZeroPoint);
+        __m512i Output3 = _mm512_add_epi32(_mm512_cvtps_epi32(Value3), OutputZeroPoint);
+
+        __m512i Packed = _mm512_packus_epi16(_mm512_packus_epi32(Output0, Output1),
+                                             _mm512_packus_epi32(Output2, Output3));
+        _mm512_storeu_si512(&Output[o * Channels], Packed);
+    }
+}
+
+template<size_t KernelSize, typename VnniType>
+void
+MLASCALL
+MlasConvSymDepthwiseKernelVnni(
+    void const* const* InputIndirection,
+    int8_t const* Filter,
+    size_t Channels,
+    void* Output,
+    size_t OutputCount,
+    MLAS_CONV_SYM_POST_PROCESS_PARAMS const* PostProcessParams,
+    unsigned KernelFlags
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a depthwise convolution with an unsigned input and a
+    signed filter for a fixed kernel size.
+
+Arguments:
+
+    InputIndirection - Supplies the indirection buffer, with KernelSize input
+        row pointers for each output element.
+
+    Filter - Supplies the filter buffer packed by MlasConvSymPackW.
+
+    Channels - Supplies the number of channels, which must be a multiple of 16.
+
+    Output - Supplies the output buffer.
+
+    OutputCount - Supplies the number of output elements.
+
+    PostProcessParams - Supplies the bias, scale and zero point parameters.
+
+    KernelFlags - Supplies additional flags controlling the operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t PackCount = MlasConvSymDepthwiseVnniPackCount;
+
+    const uint8_t* const* Input = reinterpret_cast<const uint8_t* const*>(InputIndirection);
+    uint8_t* output = static_cast<uint8_t*>(Output);
+
+    const bool PerChannelScale = (KernelFlags & MLAS_CONV_SYM_FLAG_PER_CHANNEL_SCALE) != 0;
+    const int32_t* Bias = PostProcessParams->Bias;
+    const float* Scale = PostProcessParams->Scale;
+
+    size_t c = 0;
+
+    if constexpr (VnniType::Supports512Bit) {
+
+        for (; c + 64 <= Channels; c += 64) {
+
+            MlasConvSymDepthwiseVnniBlock64<VnniType, KernelSize>(Input, Channels, c,
+                Filter + c * PackCount, output + c, OutputCount, Bias + c,
+                PerChannelScale ? Scale + c : Scale, PerChannelScale, PostProcessParams);
+        }
+    }
+
+    for (; c + 32 <= Channels; c += 32) {
+
+        const size_t BlockWidth = MlasConvSymDepthwiseDotBlockWidth(Channels, c);
+        const size_t BlockStart = c & ~(BlockWidth - 1);
+
+        MlasConvSymDepthwiseVnniBlock32<VnniType, KernelSize>(Input, Channels, c,
+            Filter + BlockStart * PackCount + (c - BlockStart), BlockWidth, output + c,
+            OutputCount, Bias + c, PerChannelScale ? Scale + c : Scale, PerChannelScale,
+            PostProcessParams);
+    }
+
+    if (c < Channels) {
+
+        MlasConvSymDepthwiseVnniBlock16<VnniType, KernelSize>(Input, Channels, c,
+            Filter + c * PackCount, output + c, OutputCount, Bias + c,
+            PerChannelScale ? Scale + c : Scale, PerChannelScale, PostProcessParams);
+    }
+}
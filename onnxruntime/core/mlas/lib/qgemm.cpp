@@ -24,8 +24,7 @@ Abstract:
 //
 
 struct MLAS_GEMM_QUANT_WORK_BLOCK {
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
+    MLAS_GEMM_THREAD_PARTITION Partition;
 };
 
 void
@@ -58,39 +57,19 @@ Return Value:
 
 --*/
 {
-    const ptrdiff_t ThreadIdM = ThreadId / WorkBlock->ThreadCountN;
-    const ptrdiff_t ThreadIdN = ThreadId % WorkBlock->ThreadCountN;
-
     //
-    // Partition the operation along the M dimension.
+    // Partition the operation along the M and N dimensions.
     //
 
     size_t RangeStartM;
     size_t RangeCountM;
-
-    const size_t M = Shape->M;
-
-    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, M, &RangeStartM, &RangeCountM);
-
-    //
-    // Partition the operation along the N dimension.
-    //
-
     size_t RangeStartN;
     size_t RangeCountN;
+    size_t RangeStartK;
+    size_t RangeCountK;
 
-    const size_t N = Shape->N;
-
-    const size_t BlockedN = (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) /
-        MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
-
-    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, BlockedN,
-        &RangeStartN, &RangeCountN);
-
-    RangeStartN *= MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
-    RangeCountN *= MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
-
-    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+    MlasGemmPartitionRange(WorkBlock->Partition, ThreadId, Shape->M, Shape->N, Shape->K,
+        &RangeStartM, &RangeCountM, &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
 
     //
     // Dispatch the partitioned operation.
@@ -164,35 +143,16 @@ MlasGemmBatch(
     }
 
     //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
+    // Segment each operation into tiles of the output matrix using the cache
+    // aware partitioner.
     //
 
     MLAS_GEMM_QUANT_WORK_BLOCK WorkBlock;
 
-    if (N > M) {
-
-        const size_t BlockedN = (N + MLAS_QGEMM_STRIDEN_THREAD_ALIGN - 1) /
-            MLAS_QGEMM_STRIDEN_THREAD_ALIGN;
+    MlasGemmPartitionThreads(M, N, K, 1, MLAS_QGEMM_STRIDEN_THREAD_ALIGN, sizeof(uint8_t),
+        sizeof(uint8_t), ThreadsPerGemm, 0, &WorkBlock.Partition);
 
-        if (size_t(ThreadsPerGemm) > BlockedN) {
-            ThreadsPerGemm = ptrdiff_t(BlockedN);
-        }
-
-        WorkBlock.ThreadCountM = 1;
-        WorkBlock.ThreadCountN = ThreadsPerGemm;
-
-    } else {
-
-        if (size_t(ThreadsPerGemm) > M) {
-            ThreadsPerGemm = ptrdiff_t(M);
-        }
-
-        WorkBlock.ThreadCountM = ThreadsPerGemm;
-        WorkBlock.ThreadCountN = 1;
-    }
+    ThreadsPerGemm = WorkBlock.Partition.ThreadCount();
     TargetThreadCount = ThreadsPerGemm * BatchN;
 
     MlasTrySimpleParallel(ThreadPool, TargetThreadCount, [&](ptrdiff_t tid) {
@@ -259,24 +219,18 @@ MlasSymmQgemmBatch(
         ThreadsPerGemm = 1;
     }
 
-    const size_t StrideM = dispatch->StrideM;
+    //
+    // Segment each operation into tiles of the output matrix using the cache
+    // aware partitioner, keeping the rows of a tile a multiple of the kernel
+    // stride.
+    //
 
-    size_t nc = N;
-    if ((size_t)MlasGetMaximumThreadCount(ThreadPool) > BatchN) {
-        // more than one thread per GEMM
+    MLAS_GEMM_THREAD_PARTITION Partition;
 
-        const size_t BlockedM = MlasDivRoundup(M, StrideM);
-        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
-        if (max_nc < nc) {
-            nc = std::min(nc, MlasDivRoundup(nc, max_nc * MLAS_QGEMM_STRIDEN_THREAD_ALIGN) *
-                                  MLAS_QGEMM_STRIDEN_THREAD_ALIGN);
-        }
-    }
-    const size_t StrideN = nc;
+    MlasGemmPartitionThreads(M, N, K, dispatch->StrideM, MLAS_QGEMM_STRIDEN_THREAD_ALIGN,
+        sizeof(int8_t), sizeof(int8_t), ThreadsPerGemm, 0, &Partition);
 
-    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
-    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
-    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+    ThreadsPerGemm = Partition.ThreadCount();
 
     MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
         auto uarch = MLAS_CPUIDINFO::GetCPUIDInfo().IsCurrentCoreArmv8NarrowLd();
@@ -287,14 +241,15 @@ MlasSymmQgemmBatch(
         const auto blk_i = tid % ThreadsPerGemm;
         auto Data = &DataParams[gemm_i];
 
-        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
-        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
-
-        const size_t RangeStartM = ThreadIdM * StrideM;
-        const size_t RangeCountM = std::min(Shape.M - RangeStartM, (size_t)StrideM);
+        size_t RangeStartM;
+        size_t RangeCountM;
+        size_t RangeStartN;
+        size_t RangeCountN;
+        size_t RangeStartK;
+        size_t RangeCountK;
 
-        const size_t RangeStartN = ThreadIdN * StrideN;
-        const size_t RangeCountN = std::min(Shape.N - RangeStartN, (size_t)StrideN);
+        MlasGemmPartitionRange(Partition, blk_i, M, N, K, &RangeStartM, &RangeCountM,
+            &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
 
         operation(&Shape, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
     });
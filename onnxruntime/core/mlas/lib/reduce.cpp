@@ -0,0 +1,861 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the sum, mean, maximum, minimum and log-sum-exp
+    reductions over the innermost dimension (KR) and over a strided dimension
+    (RK and KRK) of a tensor.
+
+    Half precision inputs are converted to float one block at a time and all
+    accumulation is done in float.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Number of elements processed per block. The KRK path keeps a row of
+// accumulators and a row of converted inputs of this size in the L1 cache
+// while the reduced rows stream through it.
+//
+
+constexpr size_t MLAS_REDUCE_BLOCK_ELEMENTS = 512;
+
+//
+// Minimum block width used when the KRK columns are split to give every
+// thread some work.
+//
+
+constexpr size_t MLAS_REDUCE_MINIMUM_BLOCK_ELEMENTS = 16;
+
+//
+// Minimum number of input elements to process per thread.
+//
+
+constexpr size_t MLAS_REDUCE_MINIMUM_ELEMENTS_PER_THREAD = 16384;
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoad(
+    const float* Input,
+    float* Buffer,
+    size_t N
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(Buffer);
+    MLAS_UNREFERENCED_PARAMETER(N);
+
+    return Input;
+}
+
+MLAS_FORCEINLINE
+const float*
+MlasReduceLoad(
+    const MLAS_FP16* Input,
+    float* Buffer,
+    size_t N
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+        Buffer[n] = Input[n].ToFloat();
+    }
+
+    return Buffer;
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceStore(
+    float* Output,
+    float Value
+    )
+{
+    *Output = Value;
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceStore(
+    MLAS_FP16* Output,
+    float Value
+    )
+{
+    *Output = MLAS_FP16(Value);
+}
+
+template<typename T, typename Fn>
+void
+MlasReduceForEachBlock(
+    const T* Input,
+    size_t N,
+    Fn Function
+    )
+/*++
+
+Routine Description:
+
+    This routine invokes the supplied function on consecutive blocks of the
+    input after converting each block to float.
+
+--*/
+{
+    float Buffer[MLAS_REDUCE_BLOCK_ELEMENTS];
+
+    while (N > 0) {
+
+        const size_t CountN = std::min(N, MLAS_REDUCE_BLOCK_ELEMENTS);
+
+        Function(MlasReduceLoad(Input, Buffer, CountN), CountN);
+
+        Input += CountN;
+        N -= CountN;
+    }
+}
+
+template<typename Fn>
+void
+MlasReduceForEachBlock(
+    const float* Input,
+    size_t N,
+    Fn Function
+    )
+{
+    Function(Input, N);
+}
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasReduceCombine(
+    MLAS_FLOAT32X4 Vector1,
+    MLAS_FLOAT32X4 Vector2
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return MlasMaximumFloat32x4(Vector1, Vector2);
+    } else if (Kind == MlasReduceMinimum) {
+        return MlasMinimumFloat32x4(Vector1, Vector2);
+    } else {
+        return MlasAddFloat32x4(Vector1, Vector2);
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasReduceCombine(
+    float Value1,
+    float Value2
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return std::max(Value1, Value2);
+    } else if (Kind == MlasReduceMinimum) {
+        return std::min(Value1, Value2);
+    } else {
+        return Value1 + Value2;
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasReduceHorizontal(
+    MLAS_FLOAT32X4 Vector
+    )
+{
+    if (Kind == MlasReduceMaximum) {
+        return MlasReduceMaximumFloat32x4(Vector);
+    } else if (Kind == MlasReduceMinimum) {
+        return MlasReduceMinimumFloat32x4(Vector);
+    } else {
+        return MlasReduceAddFloat32x4(Vector);
+    }
+}
+
+template<MLAS_REDUCE_KIND Kind>
+float
+MlasReduceVector(
+    const float* Input,
+    size_t N
+    )
+{
+    float Value = (Kind == MlasReduceSum) ? 0.0f : Input[0];
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasBroadcastFloat32x4(Value);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 Vector1 = Vector0;
+            MLAS_FLOAT32X4 Vector2 = Vector0;
+            MLAS_FLOAT32X4 Vector3 = Vector0;
+
+            while (N >= 16) {
+
+                Vector0 = MlasReduceCombine<Kind>(Vector0, MlasLoadFloat32x4(Input));
+                Vector1 = MlasReduceCombine<Kind>(Vector1, MlasLoadFloat32x4(Input + 4));
+                Vector2 = MlasReduceCombine<Kind>(Vector2, MlasLoadFloat32x4(Input + 8));
+                Vector3 = MlasReduceCombine<Kind>(Vector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            Vector0 = MlasReduceCombine<Kind>(Vector0, Vector1);
+            Vector2 = MlasReduceCombine<Kind>(Vector2, Vector3);
+            Vector0 = MlasReduceCombine<Kind>(Vector0, Vector2);
+        }
+
+        while (N >= 4) {
+
+            Vector0 = MlasReduceCombine<Kind>(Vector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Value = MlasReduceHorizontal<Kind>(Vector0);
+    }
+
+    while (N > 0) {
+
+        Value = MlasReduceCombine<Kind>(Value, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Value;
+}
+
+template<MLAS_REDUCE_KIND Kind>
+void
+MlasReduceAccumulate(
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    //
+    // Keep a strip of accumulators in registers while the rows are streamed.
+    //
+
+    while (CountN >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(Accumulator);
+        MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(Accumulator + 4);
+        MLAS_FLOAT32X4 Vector2 = MlasLoadFloat32x4(Accumulator + 8);
+        MLAS_FLOAT32X4 Vector3 = MlasLoadFloat32x4(Accumulator + 12);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Vector0 = MlasReduceCombine<Kind>(Vector0, MlasLoadFloat32x4(Row));
+            Vector1 = MlasReduceCombine<Kind>(Vector1, MlasLoadFloat32x4(Row + 4));
+            Vector2 = MlasReduceCombine<Kind>(Vector2, MlasLoadFloat32x4(Row + 8));
+            Vector3 = MlasReduceCombine<Kind>(Vector3, MlasLoadFloat32x4(Row + 12));
+
+            Row += ldInput;
+        }
+
+        MlasStoreFloat32x4(Accumulator, Vector0);
+        MlasStoreFloat32x4(Accumulator + 4, Vector1);
+        MlasStoreFloat32x4(Accumulator + 8, Vector2);
+        MlasStoreFloat32x4(Accumulator + 12, Vector3);
+
+        Accumulator += 16;
+        Input += 16;
+        CountN -= 16;
+    }
+
+    while (CountN >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(Accumulator);
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+            Vector = MlasReduceCombine<Kind>(Vector, MlasLoadFloat32x4(Row));
+            Row += ldInput;
+        }
+
+        MlasStoreFloat32x4(Accumulator, Vector);
+
+        Accumulator += 4;
+        Input += 4;
+        CountN -= 4;
+    }
+
+    while (CountN > 0) {
+
+        float Value = *Accumulator;
+
+        const float* Row = Input;
+
+        for (size_t r = 0; r < CountR; r++) {
+            Value = MlasReduceCombine<Kind>(Value, *Row);
+            Row += ldInput;
+        }
+
+        *Accumulator = Value;
+
+        Accumulator += 1;
+        Input += 1;
+        CountN -= 1;
+    }
+}
+
+float
+MLASCALL
+MlasReduceVectorF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to reduce a non-empty buffer
+    to a single value with the sum, maximum or minimum operation.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply. Kinds other than maximum and
+        minimum compute the sum.
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the reduced value.
+
+--*/
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            return MlasReduceVector<MlasReduceMaximum>(Input, N);
+        case MlasReduceMinimum:
+            return MlasReduceVector<MlasReduceMinimum>(Input, N);
+        default:
+            return MlasReduceVector<MlasReduceSum>(Input, N);
+    }
+}
+
+void
+MLASCALL
+MlasReduceAccumulateF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to combine rows of the input
+    into a row of accumulators with the sum, maximum or minimum operation.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply. Kinds other than maximum and
+        minimum compute the sum.
+
+    Accumulator - Supplies the row of accumulators.
+
+    Input - Supplies the first row of the input.
+
+    ldInput - Supplies the stride between rows of the input.
+
+    CountR - Supplies the number of rows to combine.
+
+    CountN - Supplies the number of columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Kind) {
+        case MlasReduceMaximum:
+            MlasReduceAccumulate<MlasReduceMaximum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        case MlasReduceMinimum:
+            MlasReduceAccumulate<MlasReduceMinimum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+        default:
+            MlasReduceAccumulate<MlasReduceSum>(Accumulator, Input, ldInput, CountR, CountN);
+            break;
+    }
+}
+
+MLAS_FORCEINLINE
+float
+MlasReduceVectorF32(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t N
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().ReduceVectorF32Kernel(Kind, Input, N);
+#else
+    return MlasReduceVectorF32Kernel(Kind, Input, N);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceAccumulateF32(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ReduceAccumulateF32Kernel(Kind, Accumulator, Input, ldInput, CountR, CountN);
+#else
+    MlasReduceAccumulateF32Kernel(Kind, Accumulator, Input, ldInput, CountR, CountN);
+#endif
+}
+
+template<typename T>
+float
+MlasReduceRow(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    size_t CountR
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a single contiguous row of the input.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply.
+
+    Input - Supplies the row to reduce.
+
+    CountR - Supplies the number of elements in the row.
+
+Return Value:
+
+    Returns the reduced value.
+
+--*/
+{
+    if (Kind == MlasReduceSum || Kind == MlasReduceMean) {
+
+        float Sum = 0.0f;
+
+        MlasReduceForEachBlock(Input, CountR, [&](const float* Block, size_t N) {
+            Sum += MlasReduceVectorF32(MlasReduceSum, Block, N);
+        });
+
+        return (Kind == MlasReduceMean) ? Sum / float(CountR) : Sum;
+    }
+
+    if (Kind == MlasReduceMinimum) {
+
+        float Minimum = std::numeric_limits<float>::infinity();
+
+        MlasReduceForEachBlock(Input, CountR, [&](const float* Block, size_t N) {
+            Minimum = std::min(Minimum, MlasReduceVectorF32(MlasReduceMinimum, Block, N));
+        });
+
+        return Minimum;
+    }
+
+    float Maximum = -std::numeric_limits<float>::infinity();
+
+    MlasReduceForEachBlock(Input, CountR, [&](const float* Block, size_t N) {
+        Maximum = std::max(Maximum, MlasReduceVectorF32(MlasReduceMaximum, Block, N));
+    });
+
+    if (Kind == MlasReduceMaximum || std::isinf(Maximum)) {
+        return Maximum;
+    }
+
+    //
+    // Compute log(sum(exp(x - max))) + max.
+    //
+
+    const float NegativeMaximum = -Maximum;
+    float Accumulation = 0.0f;
+
+    MlasReduceForEachBlock(Input, CountR, [&](const float* Block, size_t N) {
+#if defined(MLAS_TARGET_AMD64)
+        Accumulation += GetMlasPlatform().ComputeSumExpF32Kernel(Block, nullptr, N, &NegativeMaximum);
+#else
+        Accumulation += MlasComputeSumExpF32Kernel(Block, nullptr, N, &NegativeMaximum);
+#endif
+    });
+
+    return std::log(Accumulation) + Maximum;
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceAccumulateRows(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const float* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    MlasReduceAccumulateF32(Kind, Accumulator, Input, ldInput, CountR, CountN);
+}
+
+MLAS_FORCEINLINE
+void
+MlasReduceAccumulateRows(
+    MLAS_REDUCE_KIND Kind,
+    float* Accumulator,
+    const MLAS_FP16* Input,
+    size_t ldInput,
+    size_t CountR,
+    size_t CountN
+    )
+{
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_BLOCK_ELEMENTS], 64);
+
+    for (size_t r = 0; r < CountR; r++) {
+        MlasReduceAccumulateF32(Kind, Accumulator, MlasReduceLoad(Input + r * ldInput, Buffer, CountN), 0, 1, CountN);
+    }
+}
+
+template<typename T>
+void
+MlasReduceColumnBlock(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t CountR,
+    size_t CountK1,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a block of columns of a [CountR, CountK1] slice of
+    the input along the rows.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply.
+
+    Input - Supplies the address of the first column of the block.
+
+    Output - Supplies the address of the output for the first column.
+
+    CountR - Supplies the number of rows to reduce.
+
+    CountK1 - Supplies the stride between rows.
+
+    CountN - Supplies the number of columns in the block.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float Accumulator[MLAS_REDUCE_BLOCK_ELEMENTS], 64);
+    MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_REDUCE_BLOCK_ELEMENTS], 64);
+
+    //
+    // Mean accumulates the sum and log-sum-exp first finds the maximum.
+    //
+
+    const MLAS_REDUCE_KIND AccumulateKind = (Kind == MlasReduceMean) ? MlasReduceSum :
+        (Kind == MlasReduceLogSumExp) ? MlasReduceMaximum : Kind;
+
+    const float* Row = MlasReduceLoad(Input, Buffer, CountN);
+    std::copy_n(Row, CountN, Accumulator);
+
+    MlasReduceAccumulateRows(AccumulateKind, Accumulator, Input + CountK1, CountK1, CountR - 1, CountN);
+
+    if (Kind == MlasReduceLogSumExp) {
+
+        //
+        // The accumulator holds the column maximums. Make a second pass to
+        // compute log(sum(exp(x - max))) + max.
+        //
+
+        MLAS_DECLSPEC_ALIGN(float Maximum[MLAS_REDUCE_BLOCK_ELEMENTS], 64);
+        std::copy_n(Accumulator, CountN, Maximum);
+        std::fill_n(Accumulator, CountN, 0.0f);
+
+        for (size_t r = 0; r < CountR; r++) {
+
+            Row = MlasReduceLoad(Input + r * CountK1, Buffer, CountN);
+
+            for (size_t n = 0; n < CountN; n++) {
+                Buffer[n] = Row[n] - Maximum[n];
+            }
+
+            MlasComputeExp(Buffer, Buffer, CountN);
+            MlasReduceAccumulateF32(MlasReduceSum, Accumulator, Buffer, 0, 1, CountN);
+        }
+
+        for (size_t n = 0; n < CountN; n++) {
+            Accumulator[n] = std::isinf(Maximum[n]) ? Maximum[n] : std::log(Accumulator[n]) + Maximum[n];
+        }
+
+    } else if (Kind == MlasReduceMean) {
+
+        const float Scale = 1.0f / float(CountR);
+
+        for (size_t n = 0; n < CountN; n++) {
+            Accumulator[n] *= Scale;
+        }
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+        MlasReduceStore(&Output[n], Accumulator[n]);
+    }
+}
+
+inline
+ptrdiff_t
+MlasReduceGetThreadCount(
+    MLAS_THREADPOOL* ThreadPool,
+    size_t TotalElements,
+    size_t WorkItems
+    )
+{
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (TotalElements / MLAS_REDUCE_MINIMUM_ELEMENTS_PER_THREAD) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    if (size_t(ThreadCount) > WorkItems) {
+        ThreadCount = ptrdiff_t(WorkItems);
+    }
+
+    return ThreadCount;
+}
+
+template<typename T>
+void
+MLASCALL
+MlasReduceKR(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t CountK,
+    size_t CountR,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the innermost dimension of a [CountK, CountR] tensor.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply.
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the CountK outputs.
+
+    CountK - Supplies the number of rows.
+
+    CountR - Supplies the number of elements to reduce per row.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (CountK == 0) {
+        return;
+    }
+
+    const ptrdiff_t ThreadCount = MlasReduceGetThreadCount(ThreadPool, CountK * CountR, CountK);
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t k;
+        size_t CountRows;
+
+        MlasPartitionWork(tid, ThreadCount, CountK, &k, &CountRows);
+
+        for (size_t RowsEnd = k + CountRows; k < RowsEnd; k++) {
+            MlasReduceStore(&Output[k], MlasReduceRow(Kind, Input + k * CountR, CountR));
+        }
+    });
+}
+
+template<typename T>
+void
+MLASCALL
+MlasReduceKRK(
+    MLAS_REDUCE_KIND Kind,
+    const T* Input,
+    T* Output,
+    size_t CountK0,
+    size_t CountR,
+    size_t CountK1,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces the middle dimension of a [CountK0, CountR, CountK1]
+    tensor.
+
+    The columns of each slice are split into blocks that fit in the L1 cache
+    and the blocks are distributed over the threads. When there are fewer
+    blocks than threads, the block width is reduced so that every thread
+    still has a block to work on.
+
+Arguments:
+
+    Kind - Supplies the reduction to apply.
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the [CountK0, CountK1] output.
+
+    CountK0 - Supplies the number of outer slices.
+
+    CountR - Supplies the number of rows to reduce per slice.
+
+    CountK1 - Supplies the number of columns per slice.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (CountK0 == 0 || CountK1 == 0) {
+        return;
+    }
+
+    ptrdiff_t ThreadCount = MlasReduceGetThreadCount(ThreadPool, CountK0 * CountR * CountK1,
+        CountK0 * ((CountK1 + MLAS_REDUCE_MINIMUM_BLOCK_ELEMENTS - 1) / MLAS_REDUCE_MINIMUM_BLOCK_ELEMENTS));
+
+    size_t BlockN = MLAS_REDUCE_BLOCK_ELEMENTS;
+
+    if (CountK0 < size_t(ThreadCount)) {
+
+        const size_t BlocksPerSlice = (size_t(ThreadCount) + CountK0 - 1) / CountK0;
+
+        BlockN = (CountK1 + BlocksPerSlice - 1) / BlocksPerSlice;
+        BlockN = (BlockN + MLAS_REDUCE_MINIMUM_BLOCK_ELEMENTS - 1) & ~(MLAS_REDUCE_MINIMUM_BLOCK_ELEMENTS - 1);
+        BlockN = std::min(BlockN, MLAS_REDUCE_BLOCK_ELEMENTS);
+    }
+
+    const size_t BlocksPerSlice = (CountK1 + BlockN - 1) / BlockN;
+    const size_t WorkItems = CountK0 * BlocksPerSlice;
+
+    if (size_t(ThreadCount) > WorkItems) {
+        ThreadCount = ptrdiff_t(WorkItems);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, WorkItems, &WorkIndex, &WorkRemaining);
+
+        for (size_t WorkEnd = WorkIndex + WorkRemaining; WorkIndex < WorkEnd; WorkIndex++) {
+
+            const size_t k0 = WorkIndex / BlocksPerSlice;
+            const size_t n = (WorkIndex % BlocksPerSlice) * BlockN;
+            const size_t CountN = std::min(CountK1 - n, BlockN);
+
+            MlasReduceColumnBlock(Kind, Input + k0 * CountR * CountK1 + n, Output + k0 * CountK1 + n,
+                CountR, CountK1, CountN);
+        }
+    });
+}
+
+template
+void
+MLASCALL
+MlasReduceKR<float>(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountK,
+    size_t CountR,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasReduceKR<MLAS_FP16>(
+    MLAS_REDUCE_KIND Kind,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t CountK,
+    size_t CountR,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasReduceKRK<float>(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    float* Output,
+    size_t CountK0,
+    size_t CountR,
+    size_t CountK1,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasReduceKRK<MLAS_FP16>(
+    MLAS_REDUCE_KIND Kind,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t CountK0,
+    size_t CountR,
+    size_t CountK1,
+    MLAS_THREADPOOL* ThreadPool
+    );
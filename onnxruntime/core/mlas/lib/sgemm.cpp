@@ -17,6 +17,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <vector>
+
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
 //
@@ -91,6 +93,86 @@ Return Value:
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasSgemmAddRowVector(
+    float* C,
+    const float* Vector,
+    size_t CountN
+    )
+{
+    size_t n = CountN;
+
+    while (n >= 4) {
+        MlasStoreFloat32x4(C, MlasAddFloat32x4(MlasLoadFloat32x4(C), MlasLoadFloat32x4(Vector)));
+        C += 4;
+        Vector += 4;
+        n -= 4;
+    }
+
+    while (n > 0) {
+        *C++ += *Vector++;
+        n -= 1;
+    }
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t ldc,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the bias, activation and residual epilogue to a
+    completed tile of the output matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue parameters.
+
+    C - Supplies the address of the tile of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    StartM - Supplies the row of the tile relative to the epilogue.
+
+    StartN - Supplies the column of the tile relative to the epilogue.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Epilogue->Bias != nullptr) {
+        for (size_t m = 0; m < CountM; m++) {
+            MlasSgemmAddRowVector(C + m * ldc, Epilogue->Bias + StartN, CountN);
+        }
+    }
+
+    if (Epilogue->Activation != nullptr) {
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+    }
+
+    if (Epilogue->Residual != nullptr) {
+        const float* Residual = Epilogue->Residual + StartM * Epilogue->ldr + StartN;
+        for (size_t m = 0; m < CountM; m++) {
+            MlasSgemmAddRowVector(C + m * ldc, Residual + m * Epilogue->ldr, CountN);
+        }
+    }
+}
+
 void
 MlasSgemmTransposeA(
     float* D,
@@ -1015,7 +1097,10 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr,
+    size_t StartM = 0,
+    size_t StartN = 0
     )
 /*++
 
@@ -1051,6 +1136,13 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Epilogue - Optionally supplies the epilogue to apply to the rows of the
+        output matrix as they are completed.
+
+    StartM - Supplies the row of matrix C relative to the epilogue.
+
+    StartN - Supplies the column of matrix C relative to the epilogue.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,6 +1163,11 @@ Return Value:
         }
 #endif
 
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, ldc, StartM, StartN, RowsHandled, CountN);
+            StartM += RowsHandled;
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1190,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1131,6 +1229,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to matrix C.
+
 Return Value:
 
     None.
@@ -1147,6 +1247,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 0, M, N);
+        }
         return;
     }
 
@@ -1170,6 +1273,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 0, M, N);
+            }
             return;
         }
 
@@ -1177,6 +1283,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 0, M, N);
+            }
             return;
         }
 
@@ -1184,6 +1293,34 @@ Return Value:
 
     }
 
+    //
+    // Handle the remaining cases of a small M with kernels that read matrix B
+    // directly and stream it once regardless of the number of rows.
+    //
+
+#if defined(MLAS_TARGET_AMD64)
+
+    if (M <= MLAS_SGEMM_SMALLM_MAXIMUM_ROWS && TransA == CblasNoTrans) {
+
+        MLAS_SGEMM_KERNEL_SMALLM_ROUTINE* SgemmKernelSmallMRoutine;
+
+        if (TransB == CblasNoTrans) {
+            SgemmKernelSmallMRoutine = GetMlasPlatform().KernelSmallMRoutine;
+        } else {
+            SgemmKernelSmallMRoutine = GetMlasPlatform().KernelSmallMTransposeBRoutine;
+        }
+
+        if (SgemmKernelSmallMRoutine != nullptr) {
+            SgemmKernelSmallMRoutine(A, lda, B, ldb, C, ldc, M, N, K, alpha, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 0, M, N);
+            }
+            return;
+        }
+    }
+
+#endif
+
     //
     // Handle the case when both B and C are column-vectors that are contiguous in memory.
     // Because transposition of such vectors doesn't change their layout, and
@@ -1205,6 +1342,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, ldc, 0, 0, M, N);
+            }
             return;
         }
 
@@ -1266,6 +1406,7 @@ Return Value:
         for (size_t k = 0; k < K; k += CountK) {
 
             CountK = std::min(K - k, StrideK);
+            const bool LastK = (k + CountK == K);
 
             //
             // Copy or transpose a panel of matrix B to a local packed buffer.
@@ -1285,7 +1426,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    LastK ? Epilogue : nullptr, 0, n);
 
             } else {
 
@@ -1299,6 +1441,7 @@ Return Value:
                     //
 
                     size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_SGEMM_TRANSA_ROWS));
+                    size_t StartM = M - RowsRemaining;
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
@@ -1309,7 +1452,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        LastK ? Epilogue : nullptr, StartM, n);
                 }
             }
 
@@ -1332,7 +1476,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1372,6 +1517,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the epilogue to apply to matrix C.
+
 Return Value:
 
     None.
@@ -1393,13 +1540,18 @@ Return Value:
         CountN = std::min(RangeCountN - n, size_t(MLAS_SGEMM_PACKED_STRIDEN));
 
         //
-        // Multiply the output matrix by beta as needed.
+        // Multiply the output matrix by beta as needed. If K is zero, then
+        // this is the only update of the output matrix.
         //
 
-        if (beta != 0.0f && beta != 1.0f) {
+        if (K == 0 || (beta != 0.0f && beta != 1.0f)) {
             MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
         }
 
+        if (K == 0 && Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C + n, ldc, 0, n, M, CountN);
+        }
+
         //
         // Step through each slice of matrix B along the K dimension.
         //
@@ -1410,6 +1562,7 @@ Return Value:
         for (size_t k = 0; k < K; k += CountK) {
 
             CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+            const bool LastK = (k + CountK == K);
 
             //
             // Step through each slice of matrix A along the M dimension.
@@ -1420,7 +1573,8 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode,
+                    LastK ? Epilogue : nullptr, 0, n);
 
             } else {
 
@@ -1434,6 +1588,7 @@ Return Value:
                     //
 
                     size_t RowsTransposed = std::min(RowsRemaining, size_t(MLAS_SGEMM_TRANSA_ROWS));
+                    size_t StartM = M - RowsRemaining;
 
                     MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
 
@@ -1444,7 +1599,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode,
+                        LastK ? Epilogue : nullptr, StartM, n);
                 }
             }
 
@@ -1455,15 +1611,14 @@ Return Value:
 
 void
 MlasSgemmThreaded(
-    const ptrdiff_t ThreadCountM,
-    const ptrdiff_t ThreadCountN,
+    const MLAS_GEMM_THREAD_PARTITION* Partition,
     const CBLAS_TRANSPOSE TransA,
     const CBLAS_TRANSPOSE TransB,
     const size_t M,
     const size_t N,
     const size_t K,
-
     const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    float* PartialC,
     ptrdiff_t ThreadId
     )
 /*++
@@ -1475,9 +1630,7 @@ Routine Description:
 
 Arguments:
 
-    ThreadCountM - Supplies the total thread partition on the M dimension.
-
-    ThreadCountN - Supplies the total thread partition on the N dimension.
+    Partition - Supplies the partition of the operation across threads.
 
     TransA - Supplies the transpose operation on A matrix
 
@@ -1487,6 +1640,9 @@ Arguments:
 
     DataParams - Supplies the data position and layout of the matrices
 
+    PartialC - Supplies the buffer that receives the M x N partial results of
+        the second and later K slices, if the K dimension is partitioned.
+
     ThreadId - Supplies the current index of the threaded operation.
 
 Return Value:
@@ -1495,63 +1651,177 @@ Return Value:
 
 --*/
 {
+    size_t RangeStartM;
+    size_t RangeCountM;
+    size_t RangeStartN;
+    size_t RangeCountN;
+    size_t RangeStartK;
+    size_t RangeCountK;
 
-    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
-    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+    MlasGemmPartitionRange(*Partition, ThreadId, M, N, K, &RangeStartM, &RangeCountM,
+        &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
 
-    //
-    // Partition the operation along the M dimension.
-    //
+    const size_t lda = DataParams->lda;
+    const size_t ldb = DataParams->ldb;
 
-    size_t RangeStartM;
-    size_t RangeCountM;
+    const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
 
-    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+    if (Partition->ThreadCountK > 1) {
 
-    //
-    // Partition the operation along the N dimension.
-    //
+        //
+        // Compute the partial product of this K slice. The first slice
+        // accumulates into matrix C and the others into the partial buffer.
+        // The epilogue is applied once the slices have been reduced.
+        //
 
-    size_t RangeStartN;
-    size_t RangeCountN;
+        A += RangeStartK * ((TransA == CblasNoTrans) ? 1 : lda);
 
-    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
-        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+        const float* B = (const float*)DataParams->B +
+            RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb) +
+            RangeStartK * ((TransB == CblasNoTrans) ? ldb : 1);
 
-    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN,
-        &RangeCountN);
+        if (RangeStartK == 0) {
 
-    RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
-    RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+            MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, RangeCountK,
+                DataParams->alpha, A, lda, B, ldb, DataParams->beta,
+                DataParams->C + RangeStartM * DataParams->ldc + RangeStartN, DataParams->ldc,
+                nullptr);
 
-    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+        } else {
 
-    //
-    // Dispatch the partitioned operation.
-    //
+            const size_t SliceK = RangeStartK / Partition->StrideK;
+
+            MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, RangeCountK,
+                DataParams->alpha, A, lda, B, ldb, 0.0f,
+                PartialC + (SliceK - 1) * M * N + RangeStartM * N + RangeStartN, N,
+                nullptr);
+        }
+
+        return;
+    }
 
-    const size_t lda = DataParams->lda;
     const size_t ldc = DataParams->ldc;
 
-    const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    //
+    // Offset the epilogue to the slice of matrix C owned by this thread.
+    //
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    const MLAS_SGEMM_EPILOGUE* SliceEpilogue = nullptr;
+
+    const MLAS_ACTIVATION* Activation = DataParams->Activation;
+
+    if (Activation != nullptr && Activation->ActivationKind == MlasIdentityActivation) {
+        Activation = nullptr;
+    }
+
+    if (DataParams->Bias != nullptr || Activation != nullptr || DataParams->Residual != nullptr) {
+        Epilogue.Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+        Epilogue.Activation = Activation;
+        Epilogue.Residual = (DataParams->Residual != nullptr) ?
+            DataParams->Residual + RangeStartM * DataParams->ldr + RangeStartN : nullptr;
+        Epilogue.ldr = DataParams->ldr;
+        SliceEpilogue = &Epilogue;
+    }
+
     if (DataParams->BIsPacked) {
 
+        const size_t AlignedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) &
+            ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            AlignedN, DataParams->beta, C, ldc, SliceEpilogue);
 
     } else {
 
-        const size_t ldb = DataParams->ldb;
-
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, SliceEpilogue);
     }
 }
+
+void
+MlasSgemmReduceThreaded(
+    const MLAS_GEMM_THREAD_PARTITION* Partition,
+    const size_t M,
+    const size_t N,
+    const MLAS_SGEMM_DATA_PARAMS* DataParams,
+    const float* PartialC,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to reduce the partial results
+    of a SGEMM operation partitioned along the K dimension for one tile of the
+    output matrix, and then to apply the epilogue to the tile.
+
+Arguments:
+
+    Partition - Supplies the partition of the operation across threads.
+
+    M, N - Supplies the shape of the output matrix.
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    PartialC - Supplies the partial results of the second and later K slices.
+
+    ThreadId - Supplies the index of the tile of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t RangeStartM;
+    size_t RangeCountM;
+    size_t RangeStartN;
+    size_t RangeCountN;
+    size_t RangeStartK;
+    size_t RangeCountK;
+
+    MlasGemmPartitionRange(*Partition, ThreadId, M, N, Partition->StrideK, &RangeStartM,
+        &RangeCountM, &RangeStartN, &RangeCountN, &RangeStartK, &RangeCountK);
+
+    const size_t ldc = DataParams->ldc;
+
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    for (ptrdiff_t k = 1; k < Partition->ThreadCountK; k++) {
+
+        const float* Partial = PartialC + (k - 1) * M * N + RangeStartM * N + RangeStartN;
+
+        for (size_t m = 0; m < RangeCountM; m++) {
+            MlasSgemmAddRowVector(C + m * ldc, Partial + m * N, RangeCountN);
+        }
+    }
+
+    const MLAS_ACTIVATION* Activation = DataParams->Activation;
+
+    if (Activation != nullptr && Activation->ActivationKind == MlasIdentityActivation) {
+        Activation = nullptr;
+    }
+
+    if (DataParams->Bias != nullptr || Activation != nullptr || DataParams->Residual != nullptr) {
+
+        MLAS_SGEMM_EPILOGUE Epilogue;
+
+        Epilogue.Bias = DataParams->Bias;
+        Epilogue.Activation = Activation;
+        Epilogue.Residual = DataParams->Residual;
+        Epilogue.ldr = DataParams->ldr;
+
+        MlasSgemmApplyEpilogue(&Epilogue, C, ldc, RangeStartM, RangeStartN, RangeCountM,
+            RangeCountN);
+    }
+}
+
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(push)
 // Chance of arithmetic overflow could be reduced
@@ -1593,47 +1863,62 @@ MlasGemmBatch(
     }
 
     //
-    // Segment the operation across multiple threads.
-    //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
+    // Segment each operation into tiles of the output matrix using the cache
+    // aware partitioner. If the output matrix is too small to occupy the
+    // threads, the K dimension is also split provided that matrix B is not
+    // packed, with the partial results reduced in a second pass.
     //
 
-    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
-    ptrdiff_t ThreadCountM;
-    ptrdiff_t ThreadCountN;
+    const ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+
+    size_t MinimumStrideK = 0;
 
-    if (N > M) {
+    if (ThreadsPerGemm > 1 && M * N * BatchSize <= MLAS_SGEMM_SPLITK_MAXIMUM_ELEMENTS) {
 
-        const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
-            MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+        MinimumStrideK = MLAS_SGEMM_SPLITK_MINIMUM_STRIDEK;
 
-        if (size_t(ThreadsPerGemm) > BlockedN) {
-            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        for (size_t gemm = 0; gemm < BatchSize; gemm++) {
+            if (Data[gemm].BIsPacked) {
+                MinimumStrideK = 0;
+                break;
+            }
         }
+    }
 
-        ThreadCountM = 1;
-        ThreadCountN = ThreadsPerGemm;
+    MLAS_GEMM_THREAD_PARTITION Partition;
 
-    } else {
+    MlasGemmPartitionThreads(M, N, K, 1, MLAS_SGEMM_STRIDEN_THREAD_ALIGN, sizeof(float),
+        sizeof(float), ThreadsPerGemm, MinimumStrideK, &Partition);
 
-        if (size_t(ThreadsPerGemm) > M) {
-            ThreadsPerGemm = ptrdiff_t(M);
-        }
+    const ptrdiff_t ThreadCount = Partition.ThreadCount();
 
-        ThreadCountM = ThreadsPerGemm;
-        ThreadCountN = 1;
-    }
+    const size_t PartialSize = size_t(Partition.ThreadCountK - 1) * M * N;
+    std::vector<float> PartialBuffer(PartialSize * BatchSize);
 
     MlasTrySimpleParallel(ThreadPool,
-        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
-        [=](ptrdiff_t tid)
+        ThreadCount * static_cast<ptrdiff_t>(BatchSize),
+        [&](ptrdiff_t tid)
     {
-        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
-        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
-        MlasSgemmThreaded(ThreadCountM, ThreadCountN,
-            TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
+        ptrdiff_t GemmIdx = tid / ThreadCount;
+        ptrdiff_t ThreadIdx = tid % ThreadCount;
+        MlasSgemmThreaded(&Partition, TransA, TransB, M, N, K, &(Data[GemmIdx]),
+            PartialBuffer.data() + GemmIdx * PartialSize, ThreadIdx);
     });
+
+    if (Partition.ThreadCountK > 1) {
+
+        const ptrdiff_t TileCount = Partition.ThreadCountM * Partition.ThreadCountN;
+
+        MlasTrySimpleParallel(ThreadPool,
+            TileCount * static_cast<ptrdiff_t>(BatchSize),
+            [&](ptrdiff_t tid)
+        {
+            ptrdiff_t GemmIdx = tid / TileCount;
+            ptrdiff_t TileIdx = tid % TileCount;
+            MlasSgemmReduceThreaded(&Partition, M, N, &(Data[GemmIdx]),
+                PartialBuffer.data() + GemmIdx * PartialSize, TileIdx);
+        });
+    }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
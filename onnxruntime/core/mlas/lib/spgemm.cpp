@@ -0,0 +1,555 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    spgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) with a block sparse right hand side matrix.
+
+    Matrix B is split into column panels of MLAS_SPARSE_SGEMM_BLOCK_N columns
+    and each panel into blocks of BlockK rows. The packed buffer stores, for
+    each panel, the block row index and the values of the blocks that hold a
+    nonzero element (block compressed sparse row format).
+
+    The kernel vectorizes over the rows of matrix A: a tile of
+    MLAS_SPARSE_SGEMM_TILE_M rows of A is transposed so that each nonzero
+    element of B is broadcast and multiplied with a contiguous vector of A,
+    independent of the distribution of the nonzero blocks.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the layout of the packed matrix B. The header is followed by the
+// offsets of the first block of each panel, the block row indices and the
+// block values, each block stored as BlockK rows of MLAS_SPARSE_SGEMM_BLOCK_N
+// elements.
+//
+
+struct MLAS_SPARSE_SGEMM_PACKED_HEADER {
+    uint32_t N;
+    uint32_t K;
+    uint32_t BlockK;
+    uint32_t PanelCount;
+    uint32_t NonZeroBlockCount;
+};
+
+constexpr size_t MLAS_SPARSE_SGEMM_PACKED_ALIGNMENT = 64;
+
+struct MLAS_SPARSE_SGEMM_PACKED_LAYOUT {
+    size_t PanelOffsetsOffset;
+    size_t BlockRowsOffset;
+    size_t ValuesOffset;
+    size_t TotalSize;
+};
+
+static
+MLAS_SPARSE_SGEMM_PACKED_LAYOUT
+MlasSparseGemmGetPackedLayout(
+    size_t N,
+    size_t BlockK,
+    size_t NonZeroBlockCount
+    )
+{
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_SGEMM_BLOCK_N);
+
+    MLAS_SPARSE_SGEMM_PACKED_LAYOUT Layout;
+
+    Layout.PanelOffsetsOffset = sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER);
+    Layout.BlockRowsOffset = Layout.PanelOffsetsOffset + (PanelCount + 1) * sizeof(uint32_t);
+    Layout.ValuesOffset = Layout.BlockRowsOffset + NonZeroBlockCount * sizeof(uint32_t);
+    Layout.ValuesOffset = MlasDivRoundup(Layout.ValuesOffset, MLAS_SPARSE_SGEMM_PACKED_ALIGNMENT) *
+        MLAS_SPARSE_SGEMM_PACKED_ALIGNMENT;
+    Layout.TotalSize = Layout.ValuesOffset +
+        NonZeroBlockCount * BlockK * MLAS_SPARSE_SGEMM_BLOCK_N * sizeof(float);
+
+    return Layout;
+}
+
+MLAS_FORCEINLINE
+float
+MlasSparseGemmElementB(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t k,
+    size_t n
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+static
+bool
+MlasSparseGemmIsNonZeroBlock(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t BlockK,
+    size_t k,
+    size_t n
+    )
+{
+    const size_t kEnd = std::min(k + BlockK, K);
+    const size_t nEnd = std::min(n + MLAS_SPARSE_SGEMM_BLOCK_N, N);
+
+    for (size_t kk = k; kk < kEnd; kk++) {
+        for (size_t nn = n; nn < nEnd; nn++) {
+            if (MlasSparseGemmElementB(TransB, B, ldb, kk, nn) != 0.0f) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+size_t
+MLASCALL
+MlasSparseGemmCountNonZeroBlocks(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t BlockK
+    )
+{
+    size_t NonZeroBlockCount = 0;
+
+    for (size_t n = 0; n < N; n += MLAS_SPARSE_SGEMM_BLOCK_N) {
+        for (size_t k = 0; k < K; k += BlockK) {
+            if (MlasSparseGemmIsNonZeroBlock(TransB, N, K, B, ldb, BlockK, k, n)) {
+                NonZeroBlockCount++;
+            }
+        }
+    }
+
+    return NonZeroBlockCount;
+}
+
+size_t
+MLASCALL
+MlasSparseGemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockK,
+    size_t NonZeroBlockCount
+    )
+{
+    //
+    // The packed format uses 32-bit indices.
+    //
+
+    if (BlockK == 0 || N > UINT32_MAX || K > UINT32_MAX || NonZeroBlockCount > UINT32_MAX) {
+        return 0;
+    }
+
+    return MlasSparseGemmGetPackedLayout(N, BlockK, NonZeroBlockCount).TotalSize;
+}
+
+void
+MLASCALL
+MlasSparseGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    size_t BlockK,
+    void* PackedB
+    )
+{
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_SGEMM_BLOCK_N);
+    const size_t NonZeroBlockCount = MlasSparseGemmCountNonZeroBlocks(TransB, N, K, B, ldb, BlockK);
+    const MLAS_SPARSE_SGEMM_PACKED_LAYOUT Layout =
+        MlasSparseGemmGetPackedLayout(N, BlockK, NonZeroBlockCount);
+
+    uint8_t* Buffer = static_cast<uint8_t*>(PackedB);
+    auto* Header = reinterpret_cast<MLAS_SPARSE_SGEMM_PACKED_HEADER*>(Buffer);
+    auto* PanelOffsets = reinterpret_cast<uint32_t*>(Buffer + Layout.PanelOffsetsOffset);
+    auto* BlockRows = reinterpret_cast<uint32_t*>(Buffer + Layout.BlockRowsOffset);
+    auto* Values = reinterpret_cast<float*>(Buffer + Layout.ValuesOffset);
+
+    //
+    // Clear the alignment padding so that the packed buffer is deterministic.
+    //
+
+    std::fill_n(Buffer, Layout.ValuesOffset, uint8_t(0));
+
+    Header->N = uint32_t(N);
+    Header->K = uint32_t(K);
+    Header->BlockK = uint32_t(BlockK);
+    Header->PanelCount = uint32_t(PanelCount);
+    Header->NonZeroBlockCount = uint32_t(NonZeroBlockCount);
+
+    size_t BlockIndex = 0;
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        const size_t n = p * MLAS_SPARSE_SGEMM_BLOCK_N;
+
+        PanelOffsets[p] = uint32_t(BlockIndex);
+
+        for (size_t k = 0; k < K; k += BlockK) {
+
+            if (!MlasSparseGemmIsNonZeroBlock(TransB, N, K, B, ldb, BlockK, k, n)) {
+                continue;
+            }
+
+            BlockRows[BlockIndex] = uint32_t(k / BlockK);
+
+            float* BlockValues = Values + BlockIndex * BlockK * MLAS_SPARSE_SGEMM_BLOCK_N;
+
+            for (size_t kk = 0; kk < BlockK; kk++) {
+                for (size_t nn = 0; nn < MLAS_SPARSE_SGEMM_BLOCK_N; nn++) {
+                    BlockValues[kk * MLAS_SPARSE_SGEMM_BLOCK_N + nn] = (k + kk < K && n + nn < N) ?
+                        MlasSparseGemmElementB(TransB, B, ldb, k + kk, n + nn) : 0.0f;
+                }
+            }
+
+            BlockIndex++;
+        }
+    }
+
+    PanelOffsets[PanelCount] = uint32_t(BlockIndex);
+}
+
+bool
+MLASCALL
+MlasSparseGemmIsValidPackedB(
+    size_t N,
+    size_t K,
+    const void* PackedB,
+    size_t PackedBSize
+    )
+{
+    if (PackedB == nullptr || PackedBSize < sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER)) {
+        return false;
+    }
+
+    const uint8_t* Buffer = static_cast<const uint8_t*>(PackedB);
+    const auto* Header = reinterpret_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(Buffer);
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_SGEMM_BLOCK_N);
+    const size_t BlockK = Header->BlockK;
+    const size_t NonZeroBlockCount = Header->NonZeroBlockCount;
+
+    if (Header->N != N || Header->K != K || BlockK == 0 || Header->PanelCount != PanelCount) {
+        return false;
+    }
+
+    //
+    // Bound the block count by the buffer size first so that computing the
+    // layout does not overflow.
+    //
+
+    if (NonZeroBlockCount > PackedBSize / (BlockK * MLAS_SPARSE_SGEMM_BLOCK_N * sizeof(float)) ||
+        MlasSparseGemmGetPackedLayout(N, BlockK, NonZeroBlockCount).TotalSize != PackedBSize) {
+        return false;
+    }
+
+    const MLAS_SPARSE_SGEMM_PACKED_LAYOUT Layout =
+        MlasSparseGemmGetPackedLayout(N, BlockK, NonZeroBlockCount);
+    const auto* PanelOffsets = reinterpret_cast<const uint32_t*>(Buffer + Layout.PanelOffsetsOffset);
+    const auto* BlockRows = reinterpret_cast<const uint32_t*>(Buffer + Layout.BlockRowsOffset);
+
+    if (PanelOffsets[0] != 0 || PanelOffsets[PanelCount] != NonZeroBlockCount) {
+        return false;
+    }
+
+    //
+    // The blocks of each panel are stored in increasing block row order.
+    //
+
+    const size_t BlockRowCount = MlasDivRoundup(K, BlockK);
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        const size_t BlockStart = PanelOffsets[p];
+        const size_t BlockEnd = PanelOffsets[p + 1];
+
+        if (BlockEnd < BlockStart || BlockEnd > NonZeroBlockCount) {
+            return false;
+        }
+
+        for (size_t j = BlockStart; j < BlockEnd; j++) {
+            if (BlockRows[j] >= BlockRowCount || (j > BlockStart && BlockRows[j] <= BlockRows[j - 1])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+template<size_t BlockKConstant>
+MLAS_FORCEINLINE
+void
+MlasSparseGemmKernelBlockK(
+    const float* A,
+    const uint32_t* BlockRows,
+    const float* BlockValues,
+    size_t BlockCount,
+    size_t BlockK,
+    float* Output
+    )
+{
+    //
+    // A BlockKConstant of zero uses the runtime block size.
+    //
+
+    if (BlockKConstant != 0) {
+        BlockK = BlockKConstant;
+    }
+
+    //
+    // Process the tile in two halves of 8 rows to limit the number of
+    // accumulators.
+    //
+
+    for (size_t m = 0; m < MLAS_SPARSE_SGEMM_TILE_M; m += 8) {
+
+        MLAS_FLOAT32X4 Accumulator00 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator01 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator10 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator11 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator20 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator21 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator30 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Accumulator31 = MlasZeroFloat32x4();
+
+        const float* b = BlockValues;
+
+        for (size_t j = 0; j < BlockCount; j++) {
+
+            const float* a = A + size_t(BlockRows[j]) * BlockK * MLAS_SPARSE_SGEMM_TILE_M + m;
+
+            for (size_t kk = 0; kk < BlockK; kk++) {
+
+                MLAS_FLOAT32X4 A0 = MlasLoadFloat32x4(a);
+                MLAS_FLOAT32X4 A1 = MlasLoadFloat32x4(a + 4);
+
+                MLAS_FLOAT32X4 B0 = MlasBroadcastFloat32x4(b + 0);
+                Accumulator00 = MlasMultiplyAddFloat32x4(A0, B0, Accumulator00);
+                Accumulator01 = MlasMultiplyAddFloat32x4(A1, B0, Accumulator01);
+                MLAS_FLOAT32X4 B1 = MlasBroadcastFloat32x4(b + 1);
+                Accumulator10 = MlasMultiplyAddFloat32x4(A0, B1, Accumulator10);
+                Accumulator11 = MlasMultiplyAddFloat32x4(A1, B1, Accumulator11);
+                MLAS_FLOAT32X4 B2 = MlasBroadcastFloat32x4(b + 2);
+                Accumulator20 = MlasMultiplyAddFloat32x4(A0, B2, Accumulator20);
+                Accumulator21 = MlasMultiplyAddFloat32x4(A1, B2, Accumulator21);
+                MLAS_FLOAT32X4 B3 = MlasBroadcastFloat32x4(b + 3);
+                Accumulator30 = MlasMultiplyAddFloat32x4(A0, B3, Accumulator30);
+                Accumulator31 = MlasMultiplyAddFloat32x4(A1, B3, Accumulator31);
+
+                a += MLAS_SPARSE_SGEMM_TILE_M;
+                b += MLAS_SPARSE_SGEMM_BLOCK_N;
+            }
+        }
+
+        MlasStoreFloat32x4(Output + 0 * MLAS_SPARSE_SGEMM_TILE_M + m, Accumulator00);
+        MlasStoreFloat32x4(Output + 0 * MLAS_SPARSE_SGEMM_TILE_M + m + 4, Accumulator01);
+        MlasStoreFloat32x4(Output + 1 * MLAS_SPARSE_SGEMM_TILE_M + m, Accumulator10);
+        MlasStoreFloat32x4(Output + 1 * MLAS_SPARSE_SGEMM_TILE_M + m + 4, Accumulator11);
+        MlasStoreFloat32x4(Output + 2 * MLAS_SPARSE_SGEMM_TILE_M + m, Accumulator20);
+        MlasStoreFloat32x4(Output + 2 * MLAS_SPARSE_SGEMM_TILE_M + m + 4, Accumulator21);
+        MlasStoreFloat32x4(Output + 3 * MLAS_SPARSE_SGEMM_TILE_M + m, Accumulator30);
+        MlasStoreFloat32x4(Output + 3 * MLAS_SPARSE_SGEMM_TILE_M + m + 4, Accumulator31);
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemmKernel(
+    const float* A,
+    const uint32_t* BlockRows,
+    const float* BlockValues,
+    size_t BlockCount,
+    size_t BlockK,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a tile of the transposed matrix A with the
+    nonzero blocks of a column panel of matrix B.
+
+Arguments:
+
+    A - Supplies the K x MLAS_SPARSE_SGEMM_TILE_M tile of the transposed
+        matrix A.
+
+    BlockRows - Supplies the block row index of each nonzero block.
+
+    BlockValues - Supplies the values of the nonzero blocks.
+
+    BlockCount - Supplies the number of nonzero blocks of the panel.
+
+    BlockK - Supplies the number of rows of a block.
+
+    Output - Supplies the MLAS_SPARSE_SGEMM_BLOCK_N x MLAS_SPARSE_SGEMM_TILE_M
+        buffer that receives the transposed output tile.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (BlockK) {
+        case 1:
+            MlasSparseGemmKernelBlockK<1>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+        case 4:
+            MlasSparseGemmKernelBlockK<4>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+        default:
+            MlasSparseGemmKernelBlockK<0>(A, BlockRows, BlockValues, BlockCount, BlockK, Output);
+            break;
+    }
+}
+
+static
+void
+MlasSparseGemmTransposeA(
+    const float* A,
+    size_t lda,
+    size_t RowCount,
+    size_t K,
+    float* TransposedA
+    )
+{
+    //
+    // Rows beyond RowCount are zero filled.
+    //
+
+    for (size_t m = 0; m < MLAS_SPARSE_SGEMM_TILE_M; m++) {
+
+        if (m < RowCount) {
+            const float* a = A + m * lda;
+            for (size_t k = 0; k < K; k++) {
+                TransposedA[k * MLAS_SPARSE_SGEMM_TILE_M + m] = a[k];
+            }
+        } else {
+            for (size_t k = 0; k < K; k++) {
+                TransposedA[k * MLAS_SPARSE_SGEMM_TILE_M + m] = 0.0f;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparseGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BatchN,
+    const MLAS_SPARSE_SGEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    if (M == 0 || N == 0 || BatchN == 0) {
+        return;
+    }
+
+    const size_t TileCount = MlasDivRoundup(M, MLAS_SPARSE_SGEMM_TILE_M);
+    const size_t PanelCount = MlasDivRoundup(N, MLAS_SPARSE_SGEMM_BLOCK_N);
+
+    //
+    // Each work item transposes one tile of A and multiplies it with a range
+    // of panels. The panels are split when there are fewer tiles than threads.
+    //
+
+    const size_t ThreadCount = size_t(MlasGetMaximumThreadCount(ThreadPool));
+    const size_t TileItems = BatchN * TileCount;
+    const size_t PanelRangeCount =
+        std::min(PanelCount, std::max(size_t(1), MlasDivRoundup(ThreadCount * 2, TileItems)));
+    const size_t PanelsPerRange = MlasDivRoundup(PanelCount, PanelRangeCount);
+    const size_t WorkItems = TileItems * PanelRangeCount;
+
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_SPARSE_SGEMM_KERNEL* Kernel = GetMlasPlatform().SparseGemmKernel;
+#else
+    MLAS_SPARSE_SGEMM_KERNEL* Kernel = MlasSparseGemmKernel;
+#endif
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(WorkItems), [&](ptrdiff_t WorkIndex) {
+
+        const size_t PanelRange = size_t(WorkIndex) % PanelRangeCount;
+        const size_t Tile = (size_t(WorkIndex) / PanelRangeCount) % TileCount;
+        const size_t Batch = size_t(WorkIndex) / PanelRangeCount / TileCount;
+
+        const MLAS_SPARSE_SGEMM_DATA_PARAMS& Data = DataParams[Batch];
+
+        const uint8_t* Buffer = static_cast<const uint8_t*>(Data.PackedB);
+        const auto* Header = reinterpret_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(Buffer);
+        const size_t BlockK = Header->BlockK;
+        const MLAS_SPARSE_SGEMM_PACKED_LAYOUT Layout =
+            MlasSparseGemmGetPackedLayout(N, BlockK, Header->NonZeroBlockCount);
+        const auto* PanelOffsets = reinterpret_cast<const uint32_t*>(Buffer + Layout.PanelOffsetsOffset);
+        const auto* BlockRows = reinterpret_cast<const uint32_t*>(Buffer + Layout.BlockRowsOffset);
+        const auto* Values = reinterpret_cast<const float*>(Buffer + Layout.ValuesOffset);
+
+        //
+        // The transposed tile of A is padded to whole blocks of rows of B.
+        //
+
+        const size_t PaddedK = MlasDivRoundup(K, BlockK) * BlockK;
+        const size_t TransposedASize = UpAlignSize(PaddedK * MLAS_SPARSE_SGEMM_TILE_M * sizeof(float));
+        const size_t OutputSize = MLAS_SPARSE_SGEMM_BLOCK_N * MLAS_SPARSE_SGEMM_TILE_M * sizeof(float);
+
+        MlasThreadedBufAlloc(TransposedASize + OutputSize);
+
+        float* TransposedA = reinterpret_cast<float*>(ThreadedBufHolder.get());
+        float* Output = reinterpret_cast<float*>(ThreadedBufHolder.get() + TransposedASize);
+
+        const size_t m = Tile * MLAS_SPARSE_SGEMM_TILE_M;
+        const size_t RowCount = std::min(M - m, MLAS_SPARSE_SGEMM_TILE_M);
+
+        MlasSparseGemmTransposeA(Data.A + m * Data.lda, Data.lda, RowCount, K, TransposedA);
+        std::fill_n(TransposedA + K * MLAS_SPARSE_SGEMM_TILE_M, (PaddedK - K) * MLAS_SPARSE_SGEMM_TILE_M, 0.0f);
+
+        const size_t PanelStart = PanelRange * PanelsPerRange;
+        const size_t PanelEnd = std::min(PanelStart + PanelsPerRange, PanelCount);
+
+        for (size_t p = PanelStart; p < PanelEnd; p++) {
+
+            const size_t BlockStart = PanelOffsets[p];
+            const size_t BlockCount = PanelOffsets[p + 1] - BlockStart;
+
+            Kernel(TransposedA, BlockRows + BlockStart,
+                Values + BlockStart * BlockK * MLAS_SPARSE_SGEMM_BLOCK_N, BlockCount, BlockK, Output);
+
+            //
+            // Scale the transposed output tile and store it to matrix C.
+            //
+
+            const size_t n = p * MLAS_SPARSE_SGEMM_BLOCK_N;
+            const size_t ColumnCount = std::min(N - n, MLAS_SPARSE_SGEMM_BLOCK_N);
+            float* c = Data.C + m * Data.ldc + n;
+
+            for (size_t mm = 0; mm < RowCount; mm++) {
+                for (size_t nn = 0; nn < ColumnCount; nn++) {
+                    float Value = Data.alpha * Output[nn * MLAS_SPARSE_SGEMM_TILE_M + mm];
+                    if (Data.beta != 0.0f) {
+                        Value += Data.beta * c[nn];
+                    }
+                    c[nn] = Value;
+                }
+                c += Data.ldc;
+            }
+        }
+    });
+}
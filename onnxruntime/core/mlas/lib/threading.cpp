@@ -93,3 +93,222 @@ MlasTrySimpleParallel(
     MLAS_THREADPOOL::TrySimpleParallelFor(ThreadPool, Iterations, Work);
 #endif
 }
+
+//
+// Define the number of K elements the GEMM kernels consume per packing step.
+// One block of the smaller operand tile is expected to stay resident in L2
+// while the other operand streams past it.
+//
+
+#define MLAS_GEMM_PARTITION_STRIDEK                 256
+
+static
+double
+MlasGemmPartitionCost(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    ptrdiff_t ThreadCountK,
+    size_t ElementSizeA,
+    size_t ElementSizeB,
+    double L2CacheSize
+    )
+/*++
+
+Routine Description:
+
+    This routine estimates the time taken by the slowest thread of a
+    partitioned GEMM operation. A multiply-accumulate and a byte transferred
+    from beyond the L2 cache are weighted as roughly the same cost.
+
+Arguments:
+
+    CountM - Supplies the number of rows of matrix C owned by a thread.
+
+    CountN - Supplies the number of columns of matrix C owned by a thread.
+
+    CountK - Supplies the length of the K slice owned by a thread.
+
+    ThreadCountK - Supplies the number of slices along the K dimension.
+
+    ElementSizeA - Supplies the size in bytes of an element of matrix A.
+
+    ElementSizeB - Supplies the size in bytes of an element of matrix B.
+
+    L2CacheSize - Supplies the size in bytes of the L2 cache of a core.
+
+Return Value:
+
+    Returns the estimated cost.
+
+--*/
+{
+    const double Compute = double(CountM) * double(CountN) * double(CountK);
+
+    const double SliceA = double(CountM) * double(CountK) * double(ElementSizeA);
+    const double SliceB = double(CountN) * double(CountK) * double(ElementSizeB);
+
+    //
+    // The operand with the smaller tile is read once if one block of it fits
+    // in half of L2. Otherwise, the larger operand is streamed once for every
+    // block of the smaller operand that does fit.
+    //
+
+    const double ResidentBytes = std::min(double(CountM) * double(ElementSizeA),
+        double(CountN) * double(ElementSizeB)) *
+        double(std::min(CountK, size_t(MLAS_GEMM_PARTITION_STRIDEK)));
+
+    const double Passes = std::max(1.0, std::ceil(ResidentBytes / (L2CacheSize / 2)));
+
+    const double Traffic = std::min(SliceA, SliceB) + std::max(SliceA, SliceB) * Passes;
+
+    //
+    // Each partial result of a K split is written out and later reduced.
+    //
+
+    double Reduction = 0.0;
+
+    if (ThreadCountK > 1) {
+        Reduction = double(CountM) * double(CountN) * double(ThreadCountK) * 2;
+    }
+
+    return Compute + Traffic + Reduction;
+}
+
+void
+MlasGemmPartitionThreads(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t AlignM,
+    size_t AlignN,
+    size_t ElementSizeA,
+    size_t ElementSizeB,
+    ptrdiff_t TargetThreadCount,
+    size_t MinimumStrideK,
+    MLAS_GEMM_THREAD_PARTITION* Partition
+    )
+/*++
+
+Routine Description:
+
+    This routine selects a 2-D tiling of matrix C, and optionally a split of
+    the K dimension, for a GEMM shaped operation running on up to the target
+    number of threads. Every tiling is scored with a model of the compute and
+    the memory traffic of the slowest thread, using the L2 cache size of the
+    processor, and the cheapest one using the fewest threads is selected.
+
+Arguments:
+
+    M, N, K - Supplies the shape of the multiplication.
+
+    AlignM - Supplies the granularity of a thread's rows of matrix C.
+
+    AlignN - Supplies the granularity of a thread's columns of matrix C.
+
+    ElementSizeA - Supplies the size in bytes of an element of matrix A.
+
+    ElementSizeB - Supplies the size in bytes of an element of matrix B.
+
+    TargetThreadCount - Supplies the maximum number of threads to use.
+
+    MinimumStrideK - Supplies the minimum length of a K slice if the caller
+        supports reducing partial results, else zero to disable a K split.
+
+    Partition - Receives the selected partition.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    Partition->ThreadCountM = 1;
+    Partition->ThreadCountN = 1;
+    Partition->ThreadCountK = 1;
+    Partition->StrideM = M;
+    Partition->StrideN = N;
+    Partition->StrideK = K;
+
+    if (TargetThreadCount <= 1 || M == 0 || N == 0 || K == 0) {
+        return;
+    }
+
+    const size_t BlockedM = MlasDivRoundup(M, AlignM);
+    const size_t BlockedN = MlasDivRoundup(N, AlignN);
+
+    const double L2CacheSize = double(GetMlasPlatform().L2CacheSize);
+
+    double BestCost = MlasGemmPartitionCost(M, N, K, 1, ElementSizeA, ElementSizeB, L2CacheSize);
+    ptrdiff_t BestThreadCount = 1;
+
+    for (size_t tm = 1; tm <= BlockedM && ptrdiff_t(tm) <= TargetThreadCount; tm++) {
+
+        //
+        // Skip tile counts that round to the same stride as a smaller count.
+        //
+
+        const size_t StrideM = MlasDivRoundup(BlockedM, tm) * AlignM;
+
+        if (MlasDivRoundup(M, StrideM) != tm) {
+            continue;
+        }
+
+        for (size_t tn = 1; tn <= BlockedN && ptrdiff_t(tm * tn) <= TargetThreadCount; tn++) {
+
+            const size_t StrideN = MlasDivRoundup(BlockedN, tn) * AlignN;
+
+            if (MlasDivRoundup(N, StrideN) != tn) {
+                continue;
+            }
+
+            //
+            // Spread the K dimension over the threads left idle by the tiling
+            // of matrix C.
+            //
+
+            ptrdiff_t MaximumThreadCountK = 1;
+
+            if (MinimumStrideK != 0) {
+                MaximumThreadCountK = std::min(TargetThreadCount / ptrdiff_t(tm * tn),
+                    ptrdiff_t(K / MinimumStrideK));
+                MaximumThreadCountK = std::max(MaximumThreadCountK, ptrdiff_t(1));
+            }
+
+            for (ptrdiff_t tk = 1; tk <= MaximumThreadCountK; tk++) {
+
+                const size_t StrideK = MlasDivRoundup(K, size_t(tk));
+
+                if (ptrdiff_t(MlasDivRoundup(K, StrideK)) != tk) {
+                    continue;
+                }
+
+                const double Cost = MlasGemmPartitionCost(std::min(StrideM, M),
+                    std::min(StrideN, N), StrideK, tk, ElementSizeA, ElementSizeB,
+                    L2CacheSize);
+
+                const ptrdiff_t ThreadCount = ptrdiff_t(tm * tn) * tk;
+
+                //
+                // Prefer fewer threads unless more threads are measurably
+                // cheaper.
+                //
+
+                if (Cost < BestCost * 0.98 ||
+                    (Cost <= BestCost * 1.02 && ThreadCount < BestThreadCount) ||
+                    (Cost < BestCost && ThreadCount == BestThreadCount)) {
+
+                    BestCost = Cost;
+                    BestThreadCount = ThreadCount;
+
+                    Partition->ThreadCountM = ptrdiff_t(tm);
+                    Partition->ThreadCountN = ptrdiff_t(tn);
+                    Partition->ThreadCountK = tk;
+                    Partition->StrideM = StrideM;
+                    Partition->StrideN = StrideN;
+                    Partition->StrideK = StrideK;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,317 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental.cpp
+
+Abstract:
+
+    This module implements the element-wise unary functions: the natural
+    logarithm, the square root, the reciprocal, the sine, the cosine and the
+    power function with a scalar exponent.
+
+    The work is split into ranges of elements. Half precision inputs are
+    converted to float one block at a time and all computation is done in
+    float.
+
+    The implementation below targets the portable 4-element vector while the
+    AVX2 and AVX512F kernels instantiate the same algorithms for the wider
+    vectors.
+
+--*/
+
+#include "transcendental.h"
+
+const MLAS_UNARY_FUNCTION_CONSTANTS MlasUnaryFunctionConstants = {
+    1.0f,
+    0.5f,
+    std::numeric_limits<float>::infinity(),
+    -std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::min(),
+    8388608.0f,                     // 2^23
+    1.1920928955078125e-7f,         // 2^-23
+    126.0f,
+    149.0f,
+    0.707106781186547524f,
+    7.0376836292e-2f,
+    -1.1514610310e-1f,
+    1.1676998740e-1f,
+    -1.2420140846e-1f,
+    1.4249322787e-1f,
+    -1.6668057665e-1f,
+    2.0000714765e-1f,
+    -2.4999993993e-1f,
+    3.3333331174e-1f,
+    -2.12194440e-4f,
+    0.693359375f,
+    8192.0f,
+    0.636619772367581343f,          // 2 / pi
+    1.5703125f,
+    4.837512969970703125e-4f,
+    7.549533620476722717285156e-8f,
+    2.563344068257089602980159e-12f,
+    -1.9515295891e-4f,
+    8.3321608736e-3f,
+    -1.6666654611e-1f,
+    2.443315711809948e-5f,
+    -1.388731625493765e-3f,
+    4.166664568298827e-2f,
+    -103.9720840454f,
+    88.7762626647950f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    0x1.694000p-10f,
+    0x1.125edcp-7f,
+    0x1.555b5ap-5f,
+    0x1.555450p-3f,
+    0x1.fffff6p-2f,
+    0x1.000000p+0f,
+    int32_t(0xC1000000),
+    int32_t(0x3F800000),
+    int32_t(0x7F800000),
+    int32_t(0x007FFFFF),
+    int32_t(0x3F000000),
+    int32_t(0x80000000),
+    1,
+    2,
+};
+
+//
+// Number of half precision elements converted to float per block.
+//
+
+constexpr size_t MLAS_UNARY_BLOCK_ELEMENTS = 256;
+
+//
+// Minimum number of elements to process per thread.
+//
+
+constexpr size_t MLAS_UNARY_MINIMUM_ELEMENTS_PER_THREAD = 8192;
+
+struct MLAS_UNARY_FLOAT32X4 {
+
+    typedef MLAS_FLOAT32X4 FloatType;
+    typedef MLAS_INT32X4 IntType;
+
+    static constexpr size_t VectorLength = 4;
+
+    static MLAS_FORCEINLINE FloatType Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+    static MLAS_FORCEINLINE void Store(float* Buffer, FloatType Vector) { MlasStoreFloat32x4(Buffer, Vector); }
+    static MLAS_FORCEINLINE FloatType Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+    static MLAS_FORCEINLINE IntType BroadcastInt(int32_t Value) { return MlasBroadcastInt32x4(Value); }
+
+    static MLAS_FORCEINLINE FloatType Add(FloatType Vector1, FloatType Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Subtract(FloatType Vector1, FloatType Vector2) { return MlasSubtractFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Multiply(FloatType Vector1, FloatType Vector2) { return MlasMultiplyFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType MultiplyAdd(FloatType Vector1, FloatType Vector2, FloatType Vector3) { return MlasMultiplyAddFloat32x4(Vector1, Vector2, Vector3); }
+    static MLAS_FORCEINLINE FloatType Divide(FloatType Vector1, FloatType Vector2) { return MlasDivideFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Sqrt(FloatType Vector) { return MlasSqrtFloat32x4(Vector); }
+    static MLAS_FORCEINLINE FloatType Maximum(FloatType Vector1, FloatType Vector2) { return MlasMaximumFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Minimum(FloatType Vector1, FloatType Vector2) { return MlasMinimumFloat32x4(Vector1, Vector2); }
+
+    static MLAS_FORCEINLINE FloatType GreaterThan(FloatType Vector1, FloatType Vector2) { return MlasGreaterThanFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType And(FloatType Vector1, FloatType Vector2) { return MlasAndFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType AndNot(FloatType Vector1, FloatType Vector2) { return MlasAndNotFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Or(FloatType Vector1, FloatType Vector2) { return MlasOrFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Xor(FloatType Vector1, FloatType Vector2) { return MlasXorFloat32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE FloatType Blend(FloatType Vector1, FloatType Vector2, FloatType Selection) { return MlasBlendFloat32x4(Vector1, Vector2, Selection); }
+
+    static MLAS_FORCEINLINE bool TestAny(FloatType Mask)
+    {
+#if defined(MLAS_SSE2_INTRINSICS)
+        return _mm_movemask_ps(Mask) != 0;
+#else
+        return MlasReduceMaximumFloat32x4(MlasAndFloat32x4(Mask, MlasBroadcastFloat32x4(1.0f))) != 0.0f;
+#endif
+    }
+
+    static MLAS_FORCEINLINE IntType ReinterpretAsInt(FloatType Vector) { return MlasReinterpretAsInt32x4(Vector); }
+    static MLAS_FORCEINLINE FloatType ReinterpretAsFloat(IntType Vector) { return MlasReinterpretAsFloat32x4(Vector); }
+    static MLAS_FORCEINLINE FloatType ConvertToFloat(IntType Vector) { return MlasCastToFloat32x4(Vector); }
+    static MLAS_FORCEINLINE IntType AddInt(IntType Vector1, IntType Vector2) { return MlasAddInt32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType SubtractInt(IntType Vector1, IntType Vector2) { return MlasSubtractInt32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType AndInt(IntType Vector1, IntType Vector2) { return MlasAndInt32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MaximumInt(IntType Vector1, IntType Vector2) { return MlasMaximumInt32x4(Vector1, Vector2); }
+    static MLAS_FORCEINLINE IntType MinimumInt(IntType Vector1, IntType Vector2) { return MlasMinimumInt32x4(Vector1, Vector2); }
+
+    template<unsigned ShiftCount>
+    static MLAS_FORCEINLINE IntType ShiftLeftInt(IntType Vector) { return MlasShiftLeftInt32x4<ShiftCount>(Vector); }
+};
+
+void
+MLASCALL
+MlasUnaryFunctionF32Kernel(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the unary functions.
+
+Arguments:
+
+    Function - Supplies the unary function.
+
+    Input - Supplies the input elements.
+
+    Output - Supplies the output elements, which may alias the input.
+
+    N - Supplies the number of elements to process.
+
+    Parameter - Supplies the exponent of MlasUnaryPow.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasUnaryFunctionKernel<MLAS_UNARY_FLOAT32X4>(Function, Input, Output, N, Parameter);
+}
+
+MLAS_FORCEINLINE
+void
+MlasComputeUnaryRange(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().UnaryFunctionF32Kernel(Function, Input, Output, N, Parameter);
+#else
+    MlasUnaryFunctionF32Kernel(Function, Input, Output, N, Parameter);
+#endif
+}
+
+void
+MlasComputeUnaryRange(
+    MLAS_UNARY_FUNCTION Function,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    float Parameter
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a unary function over a range of half precision
+    elements by converting blocks of the input to float.
+
+--*/
+{
+    float Buffer[MLAS_UNARY_BLOCK_ELEMENTS];
+
+    for (size_t n = 0; n < N; n += MLAS_UNARY_BLOCK_ELEMENTS) {
+
+        const size_t CountN = std::min(N - n, MLAS_UNARY_BLOCK_ELEMENTS);
+
+        for (size_t i = 0; i < CountN; i++) {
+            Buffer[i] = Input[n + i].ToFloat();
+        }
+
+        MlasComputeUnaryRange(Function, Buffer, Buffer, CountN, Parameter);
+
+        for (size_t i = 0; i < CountN; i++) {
+            Output[n + i] = MLAS_FP16(Buffer[i]);
+        }
+    }
+}
+
+template<typename T>
+void
+MLASCALL
+MlasComputeUnary(
+    MLAS_UNARY_FUNCTION Function,
+    const T* Input,
+    T* Output,
+    size_t N,
+    float Parameter,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a unary function element-wise.
+
+Arguments:
+
+    Function - Supplies the unary function.
+
+    Input - Supplies the input elements.
+
+    Output - Supplies the output elements, which may alias the input.
+
+    N - Supplies the number of elements to process.
+
+    Parameter - Supplies the exponent of MlasUnaryPow.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (N == 0) {
+        return;
+    }
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    const size_t BlockCount = (N / MLAS_UNARY_MINIMUM_ELEMENTS_PER_THREAD) + 1;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t Start;
+        size_t Count;
+
+        MlasPartitionWork(tid, ThreadCount, N, &Start, &Count);
+
+        MlasComputeUnaryRange(Function, Input + Start, Output + Start, Count, Parameter);
+    });
+}
+
+template
+void
+MLASCALL
+MlasComputeUnary<float>(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasComputeUnary<MLAS_FP16>(
+    MLAS_UNARY_FUNCTION Function,
+    const MLAS_FP16* Input,
+    MLAS_FP16* Output,
+    size_t N,
+    float Parameter,
+    MLAS_THREADPOOL* ThreadPool
+    );
@@ -0,0 +1,763 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transcendental.h
+
+Abstract:
+
+    This module implements the element-wise unary functions computed by
+    MlasComputeUnary.
+
+    The algorithms are written once against a vector type that supplies the
+    arithmetic, comparison and integer operations, and are instantiated for
+    the portable 4-element vector and for the AVX2 and AVX512F vectors. A
+    comparison returns a mask with all bits set in the selected elements.
+
+    The logarithm and the sine and cosine follow the reductions and the
+    minimax polynomials of the Cephes library. The exponential used for the
+    power function is the one of MlasComputeExp.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Bundles the constants of the unary functions.
+//
+
+struct MLAS_UNARY_FUNCTION_CONSTANTS {
+    float One;
+    float Half;
+    float PositiveInfinity;
+    float NegativeInfinity;
+    float MinimumNormal;
+    float SubnormalScale;
+    float ExponentScale;
+    float NormalExponentBias;
+    float SubnormalExponentBias;
+    float SqrtHalf;
+    float Log_P0;
+    float Log_P1;
+    float Log_P2;
+    float Log_P3;
+    float Log_P4;
+    float Log_P5;
+    float Log_P6;
+    float Log_P7;
+    float Log_P8;
+    float Log_Q1;
+    float Log_Q2;
+    float SinCosLargeArgument;
+    float TwoOverPi;
+    float PiOverTwo_DP1;
+    float PiOverTwo_DP2;
+    float PiOverTwo_DP3;
+    float PiOverTwo_DP4;
+    float Sin_P0;
+    float Sin_P1;
+    float Sin_P2;
+    float Cos_P0;
+    float Cos_P1;
+    float Cos_P2;
+    float Exp_LowerRange;
+    float Exp_UpperRange;
+    float Exp_Log2Reciprocal;
+    float Exp_Log2High;
+    float Exp_Log2Low;
+    float Exp_P0;
+    float Exp_P1;
+    float Exp_P2;
+    float Exp_P3;
+    float Exp_P4;
+    float Exp_P56;
+    int32_t Exp_MinimumExponent;
+    int32_t Exp_MaximumExponent;
+    int32_t ExponentMask;
+    int32_t MantissaMask;
+    int32_t HalfExponent;
+    int32_t SignMask;
+    int32_t QuadrantOne;
+    int32_t QuadrantTwo;
+};
+
+extern const MLAS_UNARY_FUNCTION_CONSTANTS MlasUnaryFunctionConstants;
+
+template<typename VectorType>
+MLAS_FORCEINLINE
+typename VectorType::FloatType
+MlasUnaryPolynomial(
+    typename VectorType::FloatType Value,
+    float P0,
+    float P1,
+    float P2
+    )
+{
+    typename VectorType::FloatType p = VectorType::Broadcast(P0);
+    p = VectorType::MultiplyAdd(p, Value, VectorType::Broadcast(P1));
+    p = VectorType::MultiplyAdd(p, Value, VectorType::Broadcast(P2));
+    return p;
+}
+
+template<typename VectorType>
+MLAS_FORCEINLINE
+typename VectorType::FloatType
+MlasUnaryLogVector(
+    typename VectorType::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the natural logarithm of the supplied vector.
+
+    The input is decomposed as 2^e * m with m in [sqrt(1/2), sqrt(2)) and the
+    logarithm is computed as e * log(2) + log(m), where log(m) is a minimax
+    polynomial of degree 11 in (m - 1). Subnormal inputs are scaled to the
+    normal range first. The maximum error is 1 ulp.
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the natural logarithm of the input.
+
+--*/
+{
+    using FloatType = typename VectorType::FloatType;
+    using IntType = typename VectorType::IntType;
+
+    const auto& Constants = MlasUnaryFunctionConstants;
+
+    //
+    // Scale the subnormal inputs to the normal range. The negative inputs and
+    // zeros are also selected and produce special values below.
+    //
+
+    FloatType Tiny = VectorType::GreaterThan(VectorType::Broadcast(Constants.MinimumNormal), Value);
+
+    FloatType x = VectorType::Blend(Value,
+        VectorType::Multiply(Value, VectorType::Broadcast(Constants.SubnormalScale)), Tiny);
+
+    //
+    // Extract the exponent as a float and the mantissa in [0.5, 1).
+    //
+
+    IntType Bits = VectorType::ReinterpretAsInt(x);
+
+    FloatType e = VectorType::ConvertToFloat(VectorType::AndInt(Bits, VectorType::BroadcastInt(Constants.ExponentMask)));
+    e = VectorType::Multiply(e, VectorType::Broadcast(Constants.ExponentScale));
+    e = VectorType::Subtract(e, VectorType::Blend(VectorType::Broadcast(Constants.NormalExponentBias),
+        VectorType::Broadcast(Constants.SubnormalExponentBias), Tiny));
+
+    FloatType m = VectorType::ReinterpretAsFloat(VectorType::AddInt(
+        VectorType::AndInt(Bits, VectorType::BroadcastInt(Constants.MantissaMask)),
+        VectorType::BroadcastInt(Constants.HalfExponent)));
+
+    //
+    // Move the mantissa to [sqrt(1/2), sqrt(2)) and subtract one.
+    //
+
+    FloatType One = VectorType::Broadcast(Constants.One);
+    FloatType Small = VectorType::GreaterThan(VectorType::Broadcast(Constants.SqrtHalf), m);
+
+    e = VectorType::Subtract(e, VectorType::And(Small, One));
+    m = VectorType::Subtract(VectorType::Add(m, VectorType::And(Small, m)), One);
+
+    FloatType z = VectorType::Multiply(m, m);
+
+    FloatType p = MlasUnaryPolynomial<VectorType>(m, Constants.Log_P0, Constants.Log_P1, Constants.Log_P2);
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P3));
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P4));
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P5));
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P6));
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P7));
+    p = VectorType::MultiplyAdd(p, m, VectorType::Broadcast(Constants.Log_P8));
+    p = VectorType::Multiply(VectorType::Multiply(p, m), z);
+
+    p = VectorType::MultiplyAdd(e, VectorType::Broadcast(Constants.Log_Q1), p);
+    p = VectorType::MultiplyAdd(z, VectorType::Broadcast(-Constants.Half), p);
+
+    FloatType Result = VectorType::Add(m, p);
+    Result = VectorType::MultiplyAdd(e, VectorType::Broadcast(Constants.Log_Q2), Result);
+
+    //
+    // Select the special values: NaN for negative inputs, negative infinity
+    // for zeros and the input itself for positive infinity and NaN.
+    //
+
+    FloatType Negative = VectorType::GreaterThan(VectorType::Broadcast(0.0f), Value);
+    FloatType InRange = VectorType::And(VectorType::GreaterThan(x, VectorType::Broadcast(0.0f)),
+        VectorType::GreaterThan(VectorType::Broadcast(Constants.PositiveInfinity), x));
+    FloatType Zero = VectorType::AndNot(VectorType::Or(InRange, Negative), Tiny);
+
+    FloatType Special = VectorType::Or(Value, Negative);
+    Special = VectorType::Blend(Special, VectorType::Broadcast(Constants.NegativeInfinity), Zero);
+
+    return VectorType::Blend(Special, Result, InRange);
+}
+
+template<typename VectorType>
+MLAS_FORCEINLINE
+typename VectorType::FloatType
+MlasUnaryExpVector(
+    typename VectorType::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of the supplied vector.
+
+    This is the algorithm of MlasComputeExp: the exponent is reconstructed
+    with two scaling factors to produce results in the subnormal range and to
+    overflow to infinity.
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the exponential function of the input.
+
+--*/
+{
+    using FloatType = typename VectorType::FloatType;
+    using IntType = typename VectorType::IntType;
+
+    const auto& Constants = MlasUnaryFunctionConstants;
+
+    //
+    // N.B. The maximum and minimum propagate the value from the second
+    // vector if the value is a NaN.
+    //
+
+    FloatType x = VectorType::Maximum(VectorType::Broadcast(Constants.Exp_LowerRange), Value);
+    x = VectorType::Minimum(VectorType::Broadcast(Constants.Exp_UpperRange), x);
+
+    const FloatType RoundingBias = VectorType::Broadcast(MLAS_ROUNDING_BIAS_MAGIC);
+
+    FloatType Biased = VectorType::MultiplyAdd(x, VectorType::Broadcast(Constants.Exp_Log2Reciprocal), RoundingBias);
+    FloatType m = VectorType::Subtract(Biased, RoundingBias);
+
+    x = VectorType::MultiplyAdd(m, VectorType::Broadcast(Constants.Exp_Log2High), x);
+    x = VectorType::MultiplyAdd(m, VectorType::Broadcast(Constants.Exp_Log2Low), x);
+
+    const IntType MinimumExponent = VectorType::BroadcastInt(Constants.Exp_MinimumExponent);
+    const IntType MaximumExponent = VectorType::BroadcastInt(Constants.Exp_MaximumExponent);
+
+    IntType Overflow = VectorType::template ShiftLeftInt<23>(VectorType::ReinterpretAsInt(Biased));
+    IntType Normal = VectorType::MinimumInt(Overflow, MaximumExponent);
+    Normal = VectorType::MaximumInt(Normal, MinimumExponent);
+    Overflow = VectorType::AddInt(VectorType::SubtractInt(Overflow, Normal), MaximumExponent);
+    Normal = VectorType::AddInt(Normal, MaximumExponent);
+
+    FloatType p = MlasUnaryPolynomial<VectorType>(x, Constants.Exp_P0, Constants.Exp_P1, Constants.Exp_P2);
+    p = VectorType::MultiplyAdd(p, x, VectorType::Broadcast(Constants.Exp_P3));
+    p = VectorType::MultiplyAdd(p, x, VectorType::Broadcast(Constants.Exp_P4));
+    p = VectorType::MultiplyAdd(p, x, VectorType::Broadcast(Constants.Exp_P56));
+
+    x = VectorType::Multiply(x, VectorType::ReinterpretAsFloat(Overflow));
+    p = VectorType::MultiplyAdd(p, x, VectorType::ReinterpretAsFloat(Overflow));
+    p = VectorType::Multiply(p, VectorType::ReinterpretAsFloat(Normal));
+
+    return p;
+}
+
+template<typename VectorType, bool IsCosine>
+MLAS_FORCEINLINE
+typename VectorType::FloatType
+MlasUnarySinCosVector(
+    typename VectorType::FloatType Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the sine or cosine of the supplied vector.
+
+    The input is reduced to r in [-pi/4, pi/4] by subtracting a multiple q of
+    pi/2 in four steps. The first three parts of pi/2 have 11 significant
+    bits, so their products with q are exact for |x| <= 8192, and the last
+    part extends pi/2 to 57 bits, which keeps the reduction accurate near the
+    zeros of the result. The quadrant q selects the sine or cosine polynomial
+    of r and the sign. The elements with a larger magnitude are computed by
+    the C runtime library. The maximum error is 2.5 ulp.
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+Return Value:
+
+    Returns the sine or cosine of the input.
+
+--*/
+{
+    using FloatType = typename VectorType::FloatType;
+    using IntType = typename VectorType::IntType;
+
+    const auto& Constants = MlasUnaryFunctionConstants;
+
+    const FloatType RoundingBias = VectorType::Broadcast(MLAS_ROUNDING_BIAS_MAGIC);
+
+    FloatType Biased = VectorType::MultiplyAdd(Value, VectorType::Broadcast(Constants.TwoOverPi), RoundingBias);
+    FloatType n = VectorType::Subtract(Biased, RoundingBias);
+    IntType q = VectorType::SubtractInt(VectorType::ReinterpretAsInt(Biased),
+        VectorType::BroadcastInt(MLAS_ROUNDING_BIAS_MAGIC_BITS));
+
+    if (IsCosine) {
+        q = VectorType::AddInt(q, VectorType::BroadcastInt(Constants.QuadrantOne));
+    }
+
+    FloatType r = VectorType::MultiplyAdd(n, VectorType::Broadcast(-Constants.PiOverTwo_DP1), Value);
+    r = VectorType::MultiplyAdd(n, VectorType::Broadcast(-Constants.PiOverTwo_DP2), r);
+    r = VectorType::MultiplyAdd(n, VectorType::Broadcast(-Constants.PiOverTwo_DP3), r);
+    r = VectorType::MultiplyAdd(n, VectorType::Broadcast(-Constants.PiOverTwo_DP4), r);
+
+    FloatType z = VectorType::Multiply(r, r);
+
+    FloatType SinPolynomial = MlasUnaryPolynomial<VectorType>(z, Constants.Sin_P0, Constants.Sin_P1, Constants.Sin_P2);
+    SinPolynomial = VectorType::MultiplyAdd(VectorType::Multiply(SinPolynomial, z), r, r);
+
+    FloatType CosPolynomial = MlasUnaryPolynomial<VectorType>(z, Constants.Cos_P0, Constants.Cos_P1, Constants.Cos_P2);
+    CosPolynomial = VectorType::Multiply(VectorType::Multiply(CosPolynomial, z), z);
+    CosPolynomial = VectorType::MultiplyAdd(z, VectorType::Broadcast(-Constants.Half), CosPolynomial);
+    CosPolynomial = VectorType::Add(CosPolynomial, VectorType::Broadcast(Constants.One));
+
+    //
+    // Odd quadrants use the cosine polynomial for the sine and the upper two
+    // quadrants negate the result.
+    //
+
+    IntType QuadrantOne = VectorType::BroadcastInt(Constants.QuadrantOne);
+    FloatType SelectCosine = VectorType::ReinterpretAsFloat(VectorType::SubtractInt(
+        VectorType::BroadcastInt(0), VectorType::AndInt(q, QuadrantOne)));
+    FloatType Sign = VectorType::ReinterpretAsFloat(VectorType::template ShiftLeftInt<30>(
+        VectorType::AndInt(q, VectorType::BroadcastInt(Constants.QuadrantTwo))));
+
+    FloatType Result = VectorType::Xor(VectorType::Blend(SinPolynomial, CosPolynomial, SelectCosine), Sign);
+
+    //
+    // Compute the elements outside of the range of the reduction, including
+    // infinities, with the C runtime library.
+    //
+
+    FloatType Magnitude = VectorType::AndNot(VectorType::ReinterpretAsFloat(
+        VectorType::BroadcastInt(Constants.SignMask)), Value);
+
+    if (VectorType::TestAny(VectorType::GreaterThan(Magnitude, VectorType::Broadcast(Constants.SinCosLargeArgument)))) {
+
+        MLAS_DECLSPEC_ALIGN(float InputBuffer[VectorType::VectorLength], 64);
+        MLAS_DECLSPEC_ALIGN(float OutputBuffer[VectorType::VectorLength], 64);
+
+        VectorType::Store(InputBuffer, Value);
+        VectorType::Store(OutputBuffer, Result);
+
+        for (size_t i = 0; i < VectorType::VectorLength; i++) {
+            if (std::fabs(InputBuffer[i]) > Constants.SinCosLargeArgument) {
+                OutputBuffer[i] = IsCosine ? std::cos(InputBuffer[i]) : std::sin(InputBuffer[i]);
+            }
+        }
+
+        Result = VectorType::Load(OutputBuffer);
+    }
+
+    return Result;
+}
+
+//
+// Implements the variants of the power function for a scalar exponent.
+//
+
+//
+// Integer exponents up to this magnitude are computed by repeated squaring,
+// which is more accurate than the exponential of the logarithm.
+//
+
+constexpr float MLAS_UNARY_POW_MAXIMUM_INTEGER = 16.0f;
+
+enum MLAS_UNARY_POW_KIND {
+    MlasUnaryPowZero,
+    MlasUnaryPowOne,
+    MlasUnaryPowSquare,
+    MlasUnaryPowCube,
+    MlasUnaryPowReciprocal,
+    MlasUnaryPowSqrt,
+    MlasUnaryPowReciprocalSqrt,
+    MlasUnaryPowInteger,
+    MlasUnaryPowGeneral,
+    MlasUnaryPowNonFinite,
+};
+
+MLAS_FORCEINLINE
+MLAS_UNARY_POW_KIND
+MlasUnaryPowKind(
+    float Exponent
+    )
+{
+    if (Exponent == 0.0f) {
+        return MlasUnaryPowZero;
+    } else if (Exponent == 1.0f) {
+        return MlasUnaryPowOne;
+    } else if (Exponent == 2.0f) {
+        return MlasUnaryPowSquare;
+    } else if (Exponent == 3.0f) {
+        return MlasUnaryPowCube;
+    } else if (Exponent == -1.0f) {
+        return MlasUnaryPowReciprocal;
+    } else if (Exponent == 0.5f) {
+        return MlasUnaryPowSqrt;
+    } else if (Exponent == -0.5f) {
+        return MlasUnaryPowReciprocalSqrt;
+    } else if (std::fabs(Exponent) <= MLAS_UNARY_POW_MAXIMUM_INTEGER && std::nearbyint(Exponent) == Exponent) {
+        return MlasUnaryPowInteger;
+    } else if (std::isfinite(Exponent)) {
+        return MlasUnaryPowGeneral;
+    } else {
+        return MlasUnaryPowNonFinite;
+    }
+}
+
+struct MLAS_UNARY_POW_PARAMETERS {
+    float Exponent;
+    bool ExponentIsInteger;
+    bool ExponentIsOdd;
+    uint32_t IntegerMagnitude;
+};
+
+MLAS_FORCEINLINE
+MLAS_UNARY_POW_PARAMETERS
+MlasUnaryPowParameters(
+    float Exponent
+    )
+{
+    MLAS_UNARY_POW_PARAMETERS Parameters;
+
+    //
+    // Every float with a magnitude of at least 2^24 is an even integer.
+    //
+
+    Parameters.Exponent = Exponent;
+    Parameters.ExponentIsInteger = (std::nearbyint(Exponent) == Exponent);
+    Parameters.ExponentIsOdd = Parameters.ExponentIsInteger && std::fabs(Exponent) < 16777216.0f &&
+        (int32_t(Exponent) & 1) != 0;
+    Parameters.IntegerMagnitude = (std::fabs(Exponent) <= MLAS_UNARY_POW_MAXIMUM_INTEGER) ?
+        uint32_t(std::fabs(Exponent)) : 0;
+
+    return Parameters;
+}
+
+template<typename VectorType, MLAS_UNARY_POW_KIND PowKind>
+MLAS_FORCEINLINE
+typename VectorType::FloatType
+MlasUnaryPowVector(
+    typename VectorType::FloatType Value,
+    typename VectorType::FloatType Exponent,
+    const MLAS_UNARY_POW_PARAMETERS& Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the power function of the supplied vector for a
+    finite exponent.
+
+    The square root variants select the results of pow() for the negative
+    zero and the negative infinity. Small integer exponents are computed by
+    repeated squaring of the input, or of its reciprocal for a negative
+    exponent, with an error of at most |y| ulp, or 1.5 |y| ulp for a negative
+    exponent. The general case is computed as exp(y * log(x)), where the
+    logarithm of the magnitude is used for an integer exponent and the sign
+    of the input is applied for an odd integer exponent. The error of the
+    logarithm is scaled by y, so the error is at most (2 + 3 |y * log(x)|)
+    ulp. A finite negative input with a non-integer exponent produces a NaN
+    from the logarithm, while the negative infinity is replaced by the
+    positive infinity as in pow().
+
+Arguments:
+
+    Value - Supplies the values to operate on.
+
+    Exponent - Supplies the broadcast exponent.
+
+    Parameters - Supplies the properties of the exponent.
+
+Return Value:
+
+    Returns the power function of the input.
+
+--*/
+{
+    using FloatType = typename VectorType::FloatType;
+
+    const auto& Constants = MlasUnaryFunctionConstants;
+
+    switch (PowKind) {
+        case MlasUnaryPowZero:
+            return VectorType::Broadcast(Constants.One);
+
+        case MlasUnaryPowOne:
+            return Value;
+
+        case MlasUnaryPowSquare:
+            return VectorType::Multiply(Value, Value);
+
+        case MlasUnaryPowCube:
+            return VectorType::Multiply(VectorType::Multiply(Value, Value), Value);
+
+        case MlasUnaryPowReciprocal:
+            return VectorType::Divide(VectorType::Broadcast(Constants.One), Value);
+
+        case MlasUnaryPowSqrt:
+        case MlasUnaryPowReciprocalSqrt:
+        {
+            //
+            // Adding zero turns the negative zero from the square root into a
+            // positive zero.
+            //
+
+            FloatType Result = VectorType::Add(VectorType::Sqrt(Value), VectorType::Broadcast(0.0f));
+            FloatType NegativeInfinity = VectorType::GreaterThan(VectorType::Broadcast(-std::numeric_limits<float>::max()), Value);
+
+            Result = VectorType::Blend(Result, VectorType::Broadcast(Constants.PositiveInfinity), NegativeInfinity);
+
+            if (PowKind == MlasUnaryPowReciprocalSqrt) {
+                Result = VectorType::Divide(VectorType::Broadcast(Constants.One), Result);
+            }
+
+            return Result;
+        }
+
+        case MlasUnaryPowInteger:
+        {
+            //
+            // The reciprocal of a negative exponent is taken first so that the
+            // intermediate powers do not overflow before the result does.
+            //
+
+            FloatType Result = VectorType::Broadcast(Constants.One);
+            FloatType Power = Value;
+
+            if (Parameters.Exponent < 0.0f) {
+                Power = VectorType::Divide(Result, Value);
+            }
+
+            for (uint32_t e = Parameters.IntegerMagnitude;;) {
+
+                if ((e & 1) != 0) {
+                    Result = VectorType::Multiply(Result, Power);
+                }
+
+                e >>= 1;
+
+                if (e == 0) {
+                    break;
+                }
+
+                Power = VectorType::Multiply(Power, Power);
+            }
+
+            return Result;
+        }
+
+        default:
+        {
+            FloatType SignMask = VectorType::ReinterpretAsFloat(VectorType::BroadcastInt(Constants.SignMask));
+            FloatType Base;
+
+            if (Parameters.ExponentIsInteger) {
+                Base = VectorType::AndNot(SignMask, Value);
+            } else {
+                FloatType NegativeInfinity = VectorType::GreaterThan(VectorType::Broadcast(-std::numeric_limits<float>::max()), Value);
+                Base = VectorType::Blend(Value, VectorType::Broadcast(Constants.PositiveInfinity), NegativeInfinity);
+            }
+
+            FloatType Result = MlasUnaryExpVector<VectorType>(
+                VectorType::Multiply(Exponent, MlasUnaryLogVector<VectorType>(Base)));
+
+            if (Parameters.ExponentIsOdd) {
+                Result = VectorType::Or(Result, VectorType::And(SignMask, Value));
+            }
+
+            return Result;
+        }
+    }
+}
+
+template<typename VectorType, typename FunctionType>
+MLAS_FORCEINLINE
+void
+MlasUnaryFunctionLoop(
+    const float* Input,
+    float* Output,
+    size_t N,
+    FunctionType Function
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the vector function to the input. The remaining
+    elements are processed through a local buffer.
+
+--*/
+{
+    constexpr size_t VectorLength = VectorType::VectorLength;
+
+    while (N >= VectorLength) {
+
+        VectorType::Store(Output, Function(VectorType::Load(Input)));
+
+        Input += VectorLength;
+        Output += VectorLength;
+        N -= VectorLength;
+    }
+
+    if (N > 0) {
+
+        MLAS_DECLSPEC_ALIGN(float Buffer[VectorLength], 64);
+
+        for (size_t i = 0; i < VectorLength; i++) {
+            Buffer[i] = (i < N) ? Input[i] : Input[0];
+        }
+
+        VectorType::Store(Buffer, Function(VectorType::Load(Buffer)));
+
+        for (size_t i = 0; i < N; i++) {
+            Output[i] = Buffer[i];
+        }
+    }
+}
+
+template<typename VectorType, MLAS_UNARY_POW_KIND PowKind>
+void
+MlasUnaryPowKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Exponent
+    )
+{
+    const typename VectorType::FloatType ExponentVector = VectorType::Broadcast(Exponent);
+    const MLAS_UNARY_POW_PARAMETERS Parameters = MlasUnaryPowParameters(Exponent);
+
+    MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [&](typename VectorType::FloatType Value) {
+        return MlasUnaryPowVector<VectorType, PowKind>(Value, ExponentVector, Parameters);
+    });
+}
+
+template<typename VectorType>
+void
+MlasUnaryFunctionKernel(
+    MLAS_UNARY_FUNCTION Function,
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Parameter
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a unary function over a range of elements.
+
+Arguments:
+
+    Function - Supplies the unary function.
+
+    Input - Supplies the input elements.
+
+    Output - Supplies the output elements, which may alias the input.
+
+    N - Supplies the number of elements to process.
+
+    Parameter - Supplies the exponent of MlasUnaryPow.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using FloatType = typename VectorType::FloatType;
+
+    switch (Function) {
+
+        case MlasUnaryLog:
+            MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [](FloatType Value) {
+                return MlasUnaryLogVector<VectorType>(Value);
+            });
+            break;
+
+        case MlasUnarySqrt:
+            MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [](FloatType Value) {
+                return VectorType::Sqrt(Value);
+            });
+            break;
+
+        case MlasUnaryReciprocal:
+            MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [](FloatType Value) {
+                return VectorType::Divide(VectorType::Broadcast(MlasUnaryFunctionConstants.One), Value);
+            });
+            break;
+
+        case MlasUnarySin:
+            MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [](FloatType Value) {
+                return MlasUnarySinCosVector<VectorType, false>(Value);
+            });
+            break;
+
+        case MlasUnaryCos:
+            MlasUnaryFunctionLoop<VectorType>(Input, Output, N, [](FloatType Value) {
+                return MlasUnarySinCosVector<VectorType, true>(Value);
+            });
+            break;
+
+        case MlasUnaryPow:
+            switch (MlasUnaryPowKind(Parameter)) {
+                case MlasUnaryPowZero:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowZero>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowOne:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowOne>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowSquare:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowSquare>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowCube:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowCube>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowReciprocal:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowReciprocal>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowSqrt:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowSqrt>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowReciprocalSqrt:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowReciprocalSqrt>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowInteger:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowInteger>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowGeneral:
+                    MlasUnaryPowKernel<VectorType, MlasUnaryPowGeneral>(Input, Output, N, Parameter);
+                    break;
+                case MlasUnaryPowNonFinite:
+                    for (size_t n = 0; n < N; n++) {
+                        Output[n] = std::pow(Input[n], Parameter);
+                    }
+                    break;
+            }
+            break;
+    }
+}
@@ -810,3 +810,559 @@ MlasTranspose(
         M,
         N);
 }
+
+//
+// Define the maximum number of axes of a tensor after the unit axes are
+// dropped and the adjacent axes are merged.
+//
+
+constexpr size_t MLAS_TRANSPOSE_ND_MAXIMUM_AXES = 16;
+
+//
+// Define the number of rows and columns of a tile of the innermost transposed
+// axes. The input and output tiles of 8 byte elements fit in a 64KB L1 cache.
+//
+
+constexpr size_t MLAS_TRANSPOSE_ND_TILE = 64;
+
+//
+// Define the minimum number of bytes to transpose per thread.
+//
+
+constexpr size_t MLAS_TRANSPOSE_ND_BYTES_PER_THREAD = 64 * 1024;
+
+struct MLAS_TRANSPOSE_ND_AXIS {
+    size_t Count;
+    size_t InputStride;
+    size_t OutputStride;
+};
+
+struct MLAS_TRANSPOSE_ND_WORK_BLOCK {
+    const uint8_t* Input;
+    uint8_t* Output;
+
+    //
+    // The outer loop axes in output order with strides in bytes. When the
+    // innermost axes are transposed, the last two axes step over the column
+    // and row tiles of the input matrix.
+    //
+
+    size_t LoopAxisCount;
+    MLAS_TRANSPOSE_ND_AXIS LoopAxes[MLAS_TRANSPOSE_ND_MAXIMUM_AXES];
+
+    //
+    // The number of contiguous bytes to copy for each loop iteration, else
+    // zero if the innermost axes are transposed.
+    //
+
+    size_t CopyBytes;
+
+    //
+    // The shape of the transposed input matrix and the strides in elements of
+    // its rows in the input and in the output.
+    //
+
+    size_t M;
+    size_t N;
+    size_t InputStride;
+    size_t OutputStride;
+};
+
+template<typename ElementType, size_t BlockSize>
+MLAS_FORCEINLINE
+void
+MlasTransposeNdBlockScalar(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride
+    )
+{
+    for (size_t n = 0; n < BlockSize; n++) {
+        for (size_t m = 0; m < BlockSize; m++) {
+            Output[OutputStride * n + m] = Input[InputStride * m + n];
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeNdBlock(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride
+    )
+{
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+    MlasTranspose8x8Block(Input, InputStride, Output, OutputStride);
+#else
+    MlasTransposeNdBlockScalar<uint8_t, 8>(Input, InputStride, Output, OutputStride);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeNdBlock(
+    const uint16_t* Input,
+    size_t InputStride,
+    uint16_t* Output,
+    size_t OutputStride
+    )
+{
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+    MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+#else
+    MlasTransposeNdBlockScalar<uint16_t, 4>(Input, InputStride, Output, OutputStride);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeNdBlock(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+{
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS) || defined(MLAS_TARGET_POWER)
+    MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+#else
+    MlasTransposeNdBlockScalar<uint32_t, 4>(Input, InputStride, Output, OutputStride);
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTransposeNdBlock(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    MlasTransposeNdBlockScalar<uint64_t, 4>(Input, InputStride, Output, OutputStride);
+}
+
+template<typename ElementType>
+void
+MlasTransposeNdTile(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a tile of the input matrix (M rows by N columns)
+    to the output matrix (N rows by M columns), where the rows of both
+    matrices are strided.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    InputStride - Supplies the number of elements between input rows.
+
+    Output - Supplies the output buffer.
+
+    OutputStride - Supplies the number of elements between output rows.
+
+    M - Supplies the number of rows for the input matrix.
+
+    N - Supplies the number of columns for the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = (sizeof(ElementType) == 1) ? 8 : 4;
+
+    size_t n = N;
+
+    while (n >= BlockSize) {
+
+        const ElementType* s = Input;
+        ElementType* d = Output;
+        size_t m = M;
+
+        while (m >= BlockSize) {
+
+            MlasTransposeNdBlock(s, InputStride, d, OutputStride);
+
+            s += InputStride * BlockSize;
+            d += BlockSize;
+            m -= BlockSize;
+        }
+
+        while (m > 0) {
+
+            for (size_t i = 0; i < BlockSize; i++) {
+                d[OutputStride * i] = s[i];
+            }
+
+            s += InputStride;
+            d += 1;
+            m -= 1;
+        }
+
+        Input += BlockSize;
+        Output += OutputStride * BlockSize;
+        n -= BlockSize;
+    }
+
+    while (n > 0) {
+
+        const ElementType* s = Input;
+
+        for (size_t m = 0; m < M; m++) {
+            Output[m] = s[0];
+            s += InputStride;
+        }
+
+        Input += 1;
+        Output += OutputStride;
+        n -= 1;
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeNdThreaded(
+    const MLAS_TRANSPOSE_ND_WORK_BLOCK* WorkBlock,
+    size_t WorkIndex,
+    size_t WorkRemaining
+    )
+/*++
+
+Routine Description:
+
+    This routine runs a range of the outer loop iterations of a N-D transpose.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that describes the transpose.
+
+    WorkIndex - Supplies the first loop iteration to run.
+
+    WorkRemaining - Supplies the number of loop iterations to run.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t LoopAxisCount = WorkBlock->LoopAxisCount;
+    const MLAS_TRANSPOSE_ND_AXIS* LoopAxes = WorkBlock->LoopAxes;
+
+    size_t Index[MLAS_TRANSPOSE_ND_MAXIMUM_AXES];
+    const uint8_t* Input = WorkBlock->Input;
+    uint8_t* Output = WorkBlock->Output;
+
+    for (size_t axis = LoopAxisCount; axis > 0; axis--) {
+        const MLAS_TRANSPOSE_ND_AXIS& LoopAxis = LoopAxes[axis - 1];
+        Index[axis - 1] = WorkIndex % LoopAxis.Count;
+        WorkIndex /= LoopAxis.Count;
+        Input += Index[axis - 1] * LoopAxis.InputStride;
+        Output += Index[axis - 1] * LoopAxis.OutputStride;
+    }
+
+    while (WorkRemaining > 0) {
+
+        if (WorkBlock->CopyBytes != 0) {
+
+            std::memcpy(Output, Input, WorkBlock->CopyBytes);
+
+        } else {
+
+            const size_t ColumnTile = Index[LoopAxisCount - 2] * MLAS_TRANSPOSE_ND_TILE;
+            const size_t RowTile = Index[LoopAxisCount - 1] * MLAS_TRANSPOSE_ND_TILE;
+
+            MlasTransposeNdTile(reinterpret_cast<const ElementType*>(Input), WorkBlock->InputStride,
+                reinterpret_cast<ElementType*>(Output), WorkBlock->OutputStride,
+                std::min(WorkBlock->M - RowTile, MLAS_TRANSPOSE_ND_TILE),
+                std::min(WorkBlock->N - ColumnTile, MLAS_TRANSPOSE_ND_TILE));
+        }
+
+        //
+        // Advance to the next loop iteration.
+        //
+
+        for (size_t axis = LoopAxisCount; axis > 0; axis--) {
+            const MLAS_TRANSPOSE_ND_AXIS& LoopAxis = LoopAxes[axis - 1];
+            Input += LoopAxis.InputStride;
+            Output += LoopAxis.OutputStride;
+            if (++Index[axis - 1] < LoopAxis.Count) {
+                break;
+            }
+            Input -= LoopAxis.InputStride * LoopAxis.Count;
+            Output -= LoopAxis.OutputStride * LoopAxis.Count;
+            Index[axis - 1] = 0;
+        }
+
+        WorkRemaining--;
+    }
+}
+
+bool
+MLASCALL
+MlasTransposeNd(
+    const void* Input,
+    void* Output,
+    size_t ElementSize,
+    size_t Rank,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a tensor of any rank by a permutation of its axes.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    ElementSize - Supplies the size of an element in bytes.
+
+    Rank - Supplies the number of axes.
+
+    InputShape - Supplies the input shape.
+
+    Permutation - Supplies the input axis for each output axis.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns false if the tensor has too many axes after merging, in which case
+    the output is not written.
+
+--*/
+{
+    size_t TotalBytes = ElementSize;
+
+    for (size_t i = 0; i < Rank; i++) {
+        TotalBytes *= InputShape[i];
+    }
+
+    if (TotalBytes == 0) {
+        return true;
+    }
+
+    //
+    // Build the output axes with their input strides in elements. The unit
+    // axes are dropped and an axis that follows its neighbor in the input as
+    // well as in the output is merged into it.
+    //
+
+    MLAS_TRANSPOSE_ND_AXIS Axes[MLAS_TRANSPOSE_ND_MAXIMUM_AXES + 1];
+    size_t AxisCount = 0;
+
+    for (size_t i = 0; i < Rank; i++) {
+
+        const size_t InputAxis = Permutation[i];
+        const size_t Count = InputShape[InputAxis];
+
+        if (Count == 1) {
+            continue;
+        }
+
+        size_t InputStride = 1;
+
+        for (size_t j = InputAxis + 1; j < Rank; j++) {
+            InputStride *= InputShape[j];
+        }
+
+        if (AxisCount > 0 && Axes[AxisCount - 1].InputStride == Count * InputStride) {
+            Axes[AxisCount - 1].Count *= Count;
+            Axes[AxisCount - 1].InputStride = InputStride;
+            continue;
+        }
+
+        if (AxisCount == MLAS_TRANSPOSE_ND_MAXIMUM_AXES) {
+            return false;
+        }
+
+        Axes[AxisCount++] = {Count, InputStride, 0};
+    }
+
+    size_t OutputStride = 1;
+
+    for (size_t axis = AxisCount; axis > 0; axis--) {
+        Axes[axis - 1].OutputStride = OutputStride;
+        OutputStride *= Axes[axis - 1].Count;
+    }
+
+    //
+    // Elements without a matching integer type are moved as bytes, with an
+    // extra innermost axis that is copied.
+    //
+
+    if (ElementSize != 1 && ElementSize != 2 && ElementSize != 4 && ElementSize != 8) {
+
+        for (size_t axis = 0; axis < AxisCount; axis++) {
+            Axes[axis].InputStride *= ElementSize;
+            Axes[axis].OutputStride *= ElementSize;
+        }
+
+        if (AxisCount > 0 && Axes[AxisCount - 1].InputStride == ElementSize) {
+            Axes[AxisCount - 1].Count *= ElementSize;
+            Axes[AxisCount - 1].InputStride = 1;
+            Axes[AxisCount - 1].OutputStride = 1;
+        } else {
+            Axes[AxisCount++] = {ElementSize, 1, 1};
+        }
+
+        ElementSize = 1;
+    }
+
+    //
+    // A short contiguous innermost axis is folded into a wider element, so
+    // that the next axes are transposed. For example, a NHWC to NCHW transpose
+    // of 2 channels of fp16 values transposes 4 byte elements.
+    //
+
+    if (AxisCount > 0 && Axes[AxisCount - 1].InputStride == 1) {
+
+        const size_t Count = Axes[AxisCount - 1].Count;
+        const size_t RunBytes = Count * ElementSize;
+
+        if (RunBytes == 2 || RunBytes == 4 || RunBytes == 8) {
+
+            AxisCount--;
+
+            for (size_t axis = 0; axis < AxisCount; axis++) {
+                Axes[axis].InputStride /= Count;
+                Axes[axis].OutputStride /= Count;
+            }
+
+            ElementSize = RunBytes;
+        }
+    }
+
+    MLAS_TRANSPOSE_ND_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = static_cast<const uint8_t*>(Input);
+    WorkBlock.Output = static_cast<uint8_t*>(Output);
+    WorkBlock.LoopAxisCount = 0;
+    WorkBlock.CopyBytes = 0;
+
+    auto AddLoopAxis = [&](size_t Count, size_t AxisInputStride, size_t AxisOutputStride) {
+        WorkBlock.LoopAxes[WorkBlock.LoopAxisCount++] = {Count, AxisInputStride * ElementSize, AxisOutputStride * ElementSize};
+    };
+
+    if (AxisCount == 0 || Axes[AxisCount - 1].InputStride == 1) {
+
+        //
+        // The innermost axis is the same in the input and the output, so
+        // contiguous rows are copied.
+        //
+
+        WorkBlock.CopyBytes = ElementSize;
+
+        if (AxisCount > 0) {
+            AxisCount--;
+            WorkBlock.CopyBytes *= Axes[AxisCount].Count;
+        }
+
+        for (size_t axis = 0; axis < AxisCount; axis++) {
+            AddLoopAxis(Axes[axis].Count, Axes[axis].InputStride, Axes[axis].OutputStride);
+        }
+
+        if (AxisCount == 0) {
+            AddLoopAxis(1, 0, 0);
+        }
+
+    } else {
+
+        //
+        // The input matrix has the rows of the innermost output axis and the
+        // columns of the innermost input axis. The remaining axes are looped
+        // over followed by the column and row tiles of the matrix.
+        //
+
+        size_t InputInnerAxis = 0;
+
+        while (Axes[InputInnerAxis].InputStride != 1) {
+            InputInnerAxis++;
+        }
+
+        const MLAS_TRANSPOSE_ND_AXIS& RowAxis = Axes[AxisCount - 1];
+        const MLAS_TRANSPOSE_ND_AXIS& ColumnAxis = Axes[InputInnerAxis];
+
+        WorkBlock.M = RowAxis.Count;
+        WorkBlock.N = ColumnAxis.Count;
+        WorkBlock.InputStride = RowAxis.InputStride;
+        WorkBlock.OutputStride = ColumnAxis.OutputStride;
+
+        for (size_t axis = 0; axis < AxisCount - 1; axis++) {
+            if (axis != InputInnerAxis) {
+                AddLoopAxis(Axes[axis].Count, Axes[axis].InputStride, Axes[axis].OutputStride);
+            }
+        }
+
+        AddLoopAxis(MlasDivRoundup(WorkBlock.N, MLAS_TRANSPOSE_ND_TILE), MLAS_TRANSPOSE_ND_TILE,
+            MLAS_TRANSPOSE_ND_TILE * WorkBlock.OutputStride);
+        AddLoopAxis(MlasDivRoundup(WorkBlock.M, MLAS_TRANSPOSE_ND_TILE), MLAS_TRANSPOSE_ND_TILE * WorkBlock.InputStride,
+            MLAS_TRANSPOSE_ND_TILE);
+    }
+
+    //
+    // Split the loop iterations over the threads.
+    //
+
+    size_t WorkCount = 1;
+
+    for (size_t axis = 0; axis < WorkBlock.LoopAxisCount; axis++) {
+        WorkCount *= WorkBlock.LoopAxes[axis].Count;
+    }
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    ThreadCount = std::min(ThreadCount, ptrdiff_t(MlasDivRoundup(TotalBytes, MLAS_TRANSPOSE_ND_BYTES_PER_THREAD)));
+    ThreadCount = std::min(ThreadCount, ptrdiff_t(WorkCount));
+
+    auto* Transpose = &MlasTransposeNdThreaded<uint8_t>;
+
+    switch (ElementSize) {
+        case 2:
+            Transpose = &MlasTransposeNdThreaded<uint16_t>;
+            break;
+        case 4:
+            Transpose = &MlasTransposeNdThreaded<uint32_t>;
+            break;
+        case 8:
+            Transpose = &MlasTransposeNdThreaded<uint64_t>;
+            break;
+    }
+
+    if (ThreadCount <= 1) {
+        Transpose(&WorkBlock, 0, WorkCount);
+        return true;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+        size_t WorkIndex;
+        size_t WorkRemaining;
+        MlasPartitionWork(tid, ThreadCount, WorkCount, &WorkIndex, &WorkRemaining);
+        if (WorkRemaining > 0) {
+            Transpose(&WorkBlock, WorkIndex, WorkRemaining);
+        }
+    });
+
+    return true;
+}
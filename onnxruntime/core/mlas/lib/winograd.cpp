@@ -0,0 +1,974 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd F(2x2, 3x3) and F(4x4, 3x3)
+    algorithms for two dimensional convolutions with 3x3 kernels and unit
+    strides and dilations.
+
+    Each output tile of TileSize x TileSize elements is computed from an input
+    tile of Alpha x Alpha elements, where Alpha = TileSize + 2. The input
+    tiles and the filters are transformed to the Winograd domain, where the
+    convolution becomes Alpha x Alpha independent matrix multiplications of
+    the transformed filters with the transformed input tiles. The products are
+    then transformed back to output tiles.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Minimum number of input channels and filters per group for the matrix
+// multiplications in the Winograd domain to be efficient.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS = 8;
+
+//
+// Ratio of the cost of a multiply-add in the Winograd algorithm to that of
+// the existing algorithms, which accounts for the smaller matrix
+// multiplications and the memory traffic of the transforms.
+//
+
+constexpr double MLAS_CONV_WINOGRAD_COST_RATIO = 1.5;
+
+//
+// Number of bytes of the transformed input tiles and products per thread that
+// should stay in the cache.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_TILE_BLOCK_BYTES = 1024 * 1024;
+
+//
+// Output tile size used for packed filters.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_PACKED_TILE_SIZE = 4;
+
+//
+// Number of output tiles transformed at once, one per vector lane.
+//
+
+constexpr size_t MLAS_CONV_WINOGRAD_TILE_LANES = 4;
+
+template<size_t TileSize>
+struct MLAS_WINOGRAD_TRANSFORM;
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<2>
+{
+    static constexpr size_t Alpha = 4;
+
+    static constexpr float G[4][3] = {
+        {1.0f, 0.0f, 0.0f},
+        {0.5f, 0.5f, 0.5f},
+        {0.5f, -0.5f, 0.5f},
+        {0.0f, 0.0f, 1.0f},
+    };
+
+    //
+    // Computes B' x d for a column of the input tiles.
+    //
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+
+        r[0] = MlasSubtractFloat32x4(d0, d2);
+        r[rs] = MlasAddFloat32x4(d1, d2);
+        r[2 * rs] = MlasSubtractFloat32x4(d2, d1);
+        r[3 * rs] = MlasSubtractFloat32x4(d1, d3);
+    }
+
+    //
+    // Computes A' x m for a column of the product tiles.
+    //
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* y,
+        size_t ys
+        )
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+
+        y[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+        y[ys] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+    }
+};
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<4>
+{
+    static constexpr size_t Alpha = 6;
+
+    static constexpr float G[6][3] = {
+        {1.0f / 4.0f, 0.0f, 0.0f},
+        {-1.0f / 6.0f, -1.0f / 6.0f, -1.0f / 6.0f},
+        {-1.0f / 6.0f, 1.0f / 6.0f, -1.0f / 6.0f},
+        {1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f},
+        {1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 6.0f},
+        {0.0f, 0.0f, 1.0f},
+    };
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t ds,
+        MLAS_FLOAT32X4* r,
+        size_t rs
+        )
+    {
+        const MLAS_FLOAT32X4 d0 = d[0];
+        const MLAS_FLOAT32X4 d1 = d[ds];
+        const MLAS_FLOAT32X4 d2 = d[2 * ds];
+        const MLAS_FLOAT32X4 d3 = d[3 * ds];
+        const MLAS_FLOAT32X4 d4 = d[4 * ds];
+        const MLAS_FLOAT32X4 d5 = d[5 * ds];
+
+        const MLAS_FLOAT32X4 Diff42 = MlasSubtractFloat32x4(d4, d2);
+
+        r[0] = MlasMultiplyAddFloat32x4(d0, 4.0f, MlasMultiplyAddFloat32x4(d2, -5.0f, d4));
+        r[rs] = MlasMultiplyAddFloat32x4(MlasAddFloat32x4(d1, d2), -4.0f, MlasAddFloat32x4(d3, d4));
+        r[2 * rs] = MlasMultiplyAddFloat32x4(MlasSubtractFloat32x4(d1, d2), 4.0f, MlasSubtractFloat32x4(d4, d3));
+        r[3 * rs] = MlasMultiplyAddFloat32x4(MlasSubtractFloat32x4(d3, d1), 2.0f, Diff42);
+        r[4 * rs] = MlasMultiplyAddFloat32x4(MlasSubtractFloat32x4(d1, d3), 2.0f, Diff42);
+        r[5 * rs] = MlasMultiplyAddFloat32x4(d1, 4.0f, MlasMultiplyAddFloat32x4(d3, -5.0f, d5));
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t ms,
+        MLAS_FLOAT32X4* y,
+        size_t ys
+        )
+    {
+        const MLAS_FLOAT32X4 m0 = m[0];
+        const MLAS_FLOAT32X4 m1 = m[ms];
+        const MLAS_FLOAT32X4 m2 = m[2 * ms];
+        const MLAS_FLOAT32X4 m3 = m[3 * ms];
+        const MLAS_FLOAT32X4 m4 = m[4 * ms];
+        const MLAS_FLOAT32X4 m5 = m[5 * ms];
+
+        const MLAS_FLOAT32X4 Sum12 = MlasAddFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 Diff12 = MlasSubtractFloat32x4(m1, m2);
+        const MLAS_FLOAT32X4 Sum34 = MlasAddFloat32x4(m3, m4);
+        const MLAS_FLOAT32X4 Diff34 = MlasSubtractFloat32x4(m3, m4);
+
+        y[0] = MlasAddFloat32x4(MlasAddFloat32x4(m0, Sum12), Sum34);
+        y[ys] = MlasMultiplyAddFloat32x4(Diff34, 2.0f, Diff12);
+        y[2 * ys] = MlasMultiplyAddFloat32x4(Sum34, 4.0f, Sum12);
+        y[3 * ys] = MlasMultiplyAddFloat32x4(Diff34, 8.0f, MlasAddFloat32x4(Diff12, m5));
+    }
+};
+
+template<size_t TileSize>
+void
+MlasConvWinogradTransformFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    size_t GroupStart,
+    size_t GroupEnd,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters to the Winograd domain.
+
+    The transformed filters are stored as GroupCount x Alpha x Alpha matrices
+    of FilterCount x InputChannels elements.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    GroupStart - Supplies the first index of GroupCount x FilterCount to
+        transform.
+
+    GroupEnd - Supplies the end index of GroupCount x FilterCount to
+        transform.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filters.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<TileSize>;
+    constexpr size_t Alpha = Transform::Alpha;
+
+    MLAS_UNREFERENCED_PARAMETER(GroupCount);
+
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t gf = GroupStart; gf < GroupEnd; gf++) {
+
+        const size_t group = gf / FilterCount;
+        const size_t f = gf % FilterCount;
+
+        float* transformed = TransformedFilter + group * Alpha * Alpha * MatrixSize + f * InputChannels;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (gf * InputChannels + c) * 9;
+
+            //
+            // Compute G x g x G'.
+            //
+
+            float Gg[Alpha][3];
+
+            for (size_t i = 0; i < Alpha; i++) {
+                for (size_t j = 0; j < 3; j++) {
+                    Gg[i][j] = Transform::G[i][0] * g[j] + Transform::G[i][1] * g[3 + j] +
+                        Transform::G[i][2] * g[6 + j];
+                }
+            }
+
+            for (size_t i = 0; i < Alpha; i++) {
+                for (size_t j = 0; j < Alpha; j++) {
+                    transformed[(i * Alpha + j) * MatrixSize + c] = Gg[i][0] * Transform::G[j][0] +
+                        Gg[i][1] * Transform::G[j][1] + Gg[i][2] * Transform::G[j][2];
+                }
+            }
+        }
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradTileBlock(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* TransformedFilter,
+    const float* Bias,
+    float* Output,
+    float* TransformedInput,
+    float* Products,
+    size_t TileStart,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output tiles of a block of tiles for one batch
+    and group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    TransformedFilter - Supplies the transformed filters of the group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    Output - Supplies the output tensor of the batch and group.
+
+    TransformedInput - Supplies the thread local buffer for the transformed
+        input tiles.
+
+    Products - Supplies the thread local buffer for the products in the
+        Winograd domain.
+
+    TileStart - Supplies the index of the first output tile.
+
+    TileCount - Supplies the number of output tiles.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Transform = MLAS_WINOGRAD_TRANSFORM<TileSize>;
+    constexpr size_t Alpha = Transform::Alpha;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const float Beta = Parameters->Beta;
+
+    const size_t TilesWidth = (OutputWidth + TileSize - 1) / TileSize;
+
+    //
+    // Transform the input tiles, which are stored as Alpha x Alpha matrices
+    // of InputChannels x TileBlockSize elements. The tiles are transformed in
+    // groups of vector lanes, where the lanes past TileCount transform zeros
+    // to the padding columns of the block.
+    //
+
+    const size_t InputMatrixSize = InputChannels * TileBlockSize;
+
+    for (size_t t = 0; t < TileCount; t += MLAS_CONV_WINOGRAD_TILE_LANES) {
+
+        ptrdiff_t ih0[MLAS_CONV_WINOGRAD_TILE_LANES];
+        ptrdiff_t iw0[MLAS_CONV_WINOGRAD_TILE_LANES];
+        bool IsInterior[MLAS_CONV_WINOGRAD_TILE_LANES];
+
+        for (size_t l = 0; l < MLAS_CONV_WINOGRAD_TILE_LANES; l++) {
+
+            const size_t th = (TileStart + t + l) / TilesWidth;
+            const size_t tw = (TileStart + t + l) % TilesWidth;
+
+            //
+            // Compute the input origin of the tile, which is negative for
+            // tiles that overlap the leading padding.
+            //
+
+            ih0[l] = ptrdiff_t(th * TileSize) - ptrdiff_t(PaddingTop);
+            iw0[l] = ptrdiff_t(tw * TileSize) - ptrdiff_t(PaddingLeft);
+
+            IsInterior[l] = t + l < TileCount && ih0[l] >= 0 && iw0[l] >= 0 &&
+                size_t(ih0[l]) + Alpha <= InputHeight && size_t(iw0[l]) + Alpha <= InputWidth;
+        }
+
+        const float* input = Input;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            MLAS_DECLSPEC_ALIGN(float d[Alpha][Alpha][MLAS_CONV_WINOGRAD_TILE_LANES], 16);
+
+            for (size_t l = 0; l < MLAS_CONV_WINOGRAD_TILE_LANES; l++) {
+
+                if (IsInterior[l]) {
+
+                    const float* row = input + size_t(ih0[l]) * InputWidth + size_t(iw0[l]);
+
+                    for (size_t i = 0; i < Alpha; i++) {
+                        for (size_t j = 0; j < Alpha; j++) {
+                            d[i][j][l] = row[j];
+                        }
+                        row += InputWidth;
+                    }
+
+                } else {
+
+                    const bool IsValid = t + l < TileCount;
+
+                    for (size_t i = 0; i < Alpha; i++) {
+
+                        const ptrdiff_t ih = ih0[l] + ptrdiff_t(i);
+
+                        for (size_t j = 0; j < Alpha; j++) {
+
+                            const ptrdiff_t iw = iw0[l] + ptrdiff_t(j);
+
+                            d[i][j][l] = (IsValid && size_t(ih) < InputHeight && size_t(iw) < InputWidth) ?
+                                input[size_t(ih) * InputWidth + size_t(iw)] : 0.0f;
+                        }
+                    }
+                }
+            }
+
+            //
+            // Compute B' x d x B.
+            //
+
+            MLAS_FLOAT32X4 dv[Alpha][Alpha];
+            MLAS_FLOAT32X4 Btd[Alpha][Alpha];
+            MLAS_FLOAT32X4 BtdB[Alpha];
+
+            for (size_t i = 0; i < Alpha; i++) {
+                for (size_t j = 0; j < Alpha; j++) {
+                    dv[i][j] = MlasLoadFloat32x4(d[i][j]);
+                }
+            }
+
+            for (size_t j = 0; j < Alpha; j++) {
+                Transform::Input(&dv[0][j], Alpha, &Btd[0][j], Alpha);
+            }
+
+            float* transformed = TransformedInput + c * TileBlockSize + t;
+
+            for (size_t i = 0; i < Alpha; i++) {
+
+                Transform::Input(&Btd[i][0], 1, BtdB, 1);
+
+                for (size_t j = 0; j < Alpha; j++) {
+                    MlasStoreFloat32x4(transformed + (i * Alpha + j) * InputMatrixSize, BtdB[j]);
+                }
+            }
+
+            input += InputSize;
+        }
+    }
+
+    //
+    // Multiply the transformed filters with the transformed input tiles. The
+    // products are stored as Alpha x Alpha matrices of FilterCount x
+    // TileBlockSize elements.
+    //
+
+    const size_t FilterMatrixSize = FilterCount * InputChannels;
+    const size_t ProductMatrixSize = FilterCount * TileBlockSize;
+    const size_t PaddedTileCount =
+        (TileCount + MLAS_CONV_WINOGRAD_TILE_LANES - 1) & ~(MLAS_CONV_WINOGRAD_TILE_LANES - 1);
+
+    for (size_t p = 0; p < Alpha * Alpha; p++) {
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, PaddedTileCount, InputChannels, 1.0f,
+            TransformedFilter + p * FilterMatrixSize, InputChannels,
+            TransformedInput + p * InputMatrixSize, TileBlockSize, 0.0f,
+            Products + p * ProductMatrixSize, TileBlockSize);
+    }
+
+    //
+    // Transform the products to output tiles.
+    //
+
+    for (size_t t = 0; t < TileCount; t += MLAS_CONV_WINOGRAD_TILE_LANES) {
+
+        const size_t LaneCount = std::min(MLAS_CONV_WINOGRAD_TILE_LANES, TileCount - t);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            const float* product = Products + f * TileBlockSize + t;
+
+            //
+            // Compute A' x m x A.
+            //
+
+            MLAS_FLOAT32X4 mv[Alpha][Alpha];
+            MLAS_FLOAT32X4 Atm[TileSize][Alpha];
+            MLAS_DECLSPEC_ALIGN(float y[TileSize][TileSize][MLAS_CONV_WINOGRAD_TILE_LANES], 16);
+
+            for (size_t i = 0; i < Alpha; i++) {
+                for (size_t j = 0; j < Alpha; j++) {
+                    mv[i][j] = MlasLoadFloat32x4(product + (i * Alpha + j) * ProductMatrixSize);
+                }
+            }
+
+            for (size_t j = 0; j < Alpha; j++) {
+                Transform::Output(&mv[0][j], Alpha, &Atm[0][j], Alpha);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+
+                MLAS_FLOAT32X4 AtmA[TileSize];
+
+                Transform::Output(&Atm[i][0], 1, AtmA, 1);
+
+                for (size_t j = 0; j < TileSize; j++) {
+                    MlasStoreFloat32x4(y[i][j], AtmA[j]);
+                }
+            }
+
+            for (size_t l = 0; l < LaneCount; l++) {
+
+                const size_t th = (TileStart + t + l) / TilesWidth;
+                const size_t tw = (TileStart + t + l) % TilesWidth;
+
+                const size_t oh0 = th * TileSize;
+                const size_t ow0 = tw * TileSize;
+                const size_t RowCount = std::min(TileSize, OutputHeight - oh0);
+                const size_t ColumnCount = std::min(TileSize, OutputWidth - ow0);
+
+                float* output = Output + f * OutputSize + oh0 * OutputWidth + ow0;
+
+                for (size_t i = 0; i < RowCount; i++) {
+                    for (size_t j = 0; j < ColumnCount; j++) {
+                        output[j] = (Beta == 0.0f) ? y[i][j][l] : y[i][j][l] + Beta * output[j];
+                    }
+                    output += OutputWidth;
+                }
+            }
+        }
+    }
+
+    //
+    // Apply the activation with optional bias to each output row covered by
+    // the block of tiles.
+    //
+
+    for (size_t TileIndex = TileStart; TileIndex < TileStart + TileCount;) {
+
+        const size_t th = TileIndex / TilesWidth;
+        const size_t twStart = TileIndex % TilesWidth;
+        const size_t twEnd = std::min(TilesWidth, twStart + (TileStart + TileCount - TileIndex));
+
+        const size_t ow0 = twStart * TileSize;
+        const size_t ColumnCount = std::min(twEnd * TileSize, OutputWidth) - ow0;
+        const size_t ohEnd = std::min((th + 1) * TileSize, OutputHeight);
+
+        for (size_t oh = th * TileSize; oh < ohEnd; oh++) {
+            MlasActivation(Parameters->Activation, Output + oh * OutputWidth + ow0, Bias,
+                FilterCount, ColumnCount, OutputSize);
+        }
+
+        TileIndex += twEnd - twStart;
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<TileSize>::Alpha;
+
+    const size_t BatchCount = Parameters->BatchCount;
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const ptrdiff_t ThreadCount = Parameters->ThreadCount;
+
+    //
+    // Transform the filters to the start of the working buffer unless they
+    // were packed ahead of time.
+    //
+
+    const float* TransformedFilter = Parameters->u.Winograd.PackedFilter;
+
+    if (TransformedFilter == nullptr) {
+
+        const size_t GroupFilterCount = GroupCount * FilterCount;
+
+        MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+            size_t GroupStart;
+            size_t GroupRemaining;
+
+            MlasPartitionWork(tid, ThreadCount, GroupFilterCount, &GroupStart, &GroupRemaining);
+
+            MlasConvWinogradTransformFilter<TileSize>(GroupCount, InputChannels, FilterCount,
+                GroupStart, GroupStart + GroupRemaining, Filter, WorkingBuffer);
+        });
+
+        TransformedFilter = WorkingBuffer;
+    }
+
+    WorkingBuffer += Parameters->u.Winograd.FilterBufferSize;
+
+    //
+    // Partition the blocks of output tiles of each batch and group across the
+    // threads.
+    //
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t TilesPerImage =
+        ((OutputHeight + TileSize - 1) / TileSize) * ((OutputWidth + TileSize - 1) / TileSize);
+    const size_t TileBlocksPerImage = (TilesPerImage + TileBlockSize - 1) / TileBlockSize;
+    const size_t TotalTileBlocks = BatchCount * GroupCount * TileBlocksPerImage;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = Alpha * Alpha * FilterCount * InputChannels;
+    const size_t ThreadBufferSize = Alpha * Alpha * (InputChannels + FilterCount) * TileBlockSize;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t BlockStart;
+        size_t BlockRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, TotalTileBlocks, &BlockStart, &BlockRemaining);
+
+        float* TransformedInput = WorkingBuffer + tid * ThreadBufferSize;
+        float* Products = TransformedInput + Alpha * Alpha * InputChannels * TileBlockSize;
+
+        for (size_t block = BlockStart; block < BlockStart + BlockRemaining; block++) {
+
+            const size_t bg = block / TileBlocksPerImage;
+            const size_t group = bg % GroupCount;
+            const size_t TileStart = (block % TileBlocksPerImage) * TileBlockSize;
+            const size_t TileCount = std::min(TileBlockSize, TilesPerImage - TileStart);
+
+            MlasConvWinogradTileBlock<TileSize>(Parameters, Input + bg * InputGroupSize,
+                TransformedFilter + group * FilterGroupSize,
+                (Bias != nullptr) ? Bias + group * FilterCount : nullptr,
+                Output + bg * OutputGroupSize, TransformedInput, Products, TileStart, TileCount);
+        }
+    });
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the convolution operation with a Winograd
+    algorithm selected by MlasConvWinogradPrepare.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor.
+
+    Filter - Supplies the filter tensor, which is not used if the filter was
+        packed by MlasConvWinogradPackFilter.
+
+    Bias - Optionally supplies the bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvWinogradPrepare.
+
+    Output - Supplies the output tensor.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->u.Winograd.OutputTileSize == 2) {
+        MlasConvWinogradOperation<2>(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+    } else {
+        MlasConvWinogradOperation<4>(Parameters, Input, Filter, Bias, WorkingBuffer, Output, ThreadPool);
+    }
+}
+
+bool
+MlasConvWinogradIsSupported(
+    size_t Dimensions,
+    size_t InputChannels,
+    size_t FilterCount,
+    const size_t* KernelShape,
+    const size_t* DilationShape,
+    const size_t* StrideShape
+    )
+{
+    if (Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    return InputChannels >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS &&
+        FilterCount >= MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the packed filter for a
+    Winograd convolution.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    KernelShape - Supplies the shape of the kernel.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+Return Value:
+
+    Returns the number of elements of the packed filter, else zero if the
+    convolution cannot use a Winograd algorithm.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return 0;
+    }
+
+    size_t Kernel[2];
+    size_t Dilation[2];
+    size_t Stride[2];
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        Kernel[dim] = size_t(KernelShape[dim]);
+        Dilation[dim] = size_t(DilationShape[dim]);
+        Stride[dim] = size_t(StrideShape[dim]);
+    }
+
+    if (!MlasConvWinogradIsSupported(Dimensions, InputChannels, FilterCount, Kernel, Dilation, Stride)) {
+        return 0;
+    }
+
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<MLAS_CONV_WINOGRAD_PACKED_TILE_SIZE>::Alpha;
+
+    return GroupCount * Alpha * Alpha * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the filter for a Winograd convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+    Filter - Supplies the 3x3 filter tensor.
+
+    PackedFilter - Supplies the buffer to receive the packed filter, sized by
+        MlasConvWinogradPackFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasConvWinogradTransformFilter<MLAS_CONV_WINOGRAD_PACKED_TILE_SIZE>(GroupCount, InputChannels,
+        FilterCount, 0, GroupCount * FilterCount, Filter, PackedFilter);
+}
+
+bool
+MLASCALL
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine selects a Winograd algorithm for a convolution prepared by
+    MlasConvPrepare if its estimated cost is lower than that of the existing
+    algorithms.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the parameters computed by
+        MlasConvPrepare. The structure is updated if a Winograd algorithm is
+        selected.
+
+    PackedFilter - Optionally supplies the filter packed by
+        MlasConvWinogradPackFilter.
+
+    WorkingBufferSize - Supplies the number of elements of the working buffer
+        computed by MlasConvPrepare. Receives the number of elements of the
+        working buffer if a Winograd algorithm is selected.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if a Winograd algorithm is selected, else false.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+
+    if (!MlasConvWinogradIsSupported(Parameters->Dimensions, InputChannels, FilterCount,
+            Parameters->KernelShape, Parameters->DilationShape, Parameters->StrideShape)) {
+        return false;
+    }
+
+    //
+    // Estimate the number of multiply-adds of each output tile size, which
+    // includes the input and output transforms and the filter transform if
+    // the filter was not packed for the tile size.
+    //
+
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const double MatrixSize = double(FilterCount) * double(InputChannels);
+
+    size_t TileSize = 0;
+    double Cost = 0.0;
+
+    for (size_t CandidateTileSize : {size_t(2), size_t(4)}) {
+
+        const size_t Alpha = CandidateTileSize + 2;
+        const size_t Tiles = ((OutputHeight + CandidateTileSize - 1) / CandidateTileSize) *
+            ((OutputWidth + CandidateTileSize - 1) / CandidateTileSize);
+
+        //
+        // The matrix multiplications are computed in multiples of the SGEMM
+        // kernel column stride, which penalizes images with few tiles.
+        //
+
+        const size_t GemmTiles =
+            (Tiles + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        double CandidateCost = double(GemmTiles * Alpha * Alpha) * MatrixSize +
+            double(Tiles) * (double(2 * Alpha * Alpha * Alpha) * double(InputChannels) +
+            double(Alpha * CandidateTileSize * (Alpha + CandidateTileSize)) * double(FilterCount));
+
+        if (PackedFilter == nullptr || CandidateTileSize != MLAS_CONV_WINOGRAD_PACKED_TILE_SIZE) {
+            CandidateCost += double(3 * Alpha * (3 + Alpha)) * MatrixSize;
+        }
+
+        if (TileSize == 0 || CandidateCost < Cost) {
+            TileSize = CandidateTileSize;
+            Cost = CandidateCost;
+        }
+    }
+
+    const double DirectCost = double(Parameters->OutputSize) * MatrixSize * 9.0;
+
+    if (Cost * MLAS_CONV_WINOGRAD_COST_RATIO >= DirectCost) {
+        return false;
+    }
+
+    //
+    // Size the blocks of tiles so that the transformed input tiles and the
+    // products of a block stay in the cache, while keeping enough columns for
+    // the matrix multiplications to be efficient.
+    //
+
+    const size_t Alpha = TileSize + 2;
+    const size_t TilesPerImage =
+        ((OutputHeight + TileSize - 1) / TileSize) * ((OutputWidth + TileSize - 1) / TileSize);
+
+    size_t TileBlockSize = MLAS_CONV_WINOGRAD_TILE_BLOCK_BYTES /
+        (Alpha * Alpha * (InputChannels + FilterCount) * sizeof(float));
+
+    TileBlockSize = std::min(std::max(TileBlockSize & ~size_t(15), size_t(16)), size_t(128));
+    TileBlockSize = std::min(TileBlockSize,
+        (TilesPerImage + MLAS_CONV_WINOGRAD_TILE_LANES - 1) & ~(MLAS_CONV_WINOGRAD_TILE_LANES - 1));
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution operation.
+    //
+
+    const size_t TileBlocksPerImage = (TilesPerImage + TileBlockSize - 1) / TileBlockSize;
+    const size_t TotalTileBlocks = Parameters->BatchCount * Parameters->GroupCount * TileBlocksPerImage;
+    const double Complexity = Cost * double(Parameters->BatchCount * Parameters->GroupCount);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) >= TotalTileBlocks) {
+        TargetThreadCount = ptrdiff_t(TotalTileBlocks);
+    }
+
+    const bool UsePackedFilter = PackedFilter != nullptr && TileSize == MLAS_CONV_WINOGRAD_PACKED_TILE_SIZE;
+    const size_t FilterBufferSize =
+        UsePackedFilter ? 0 : Parameters->GroupCount * Alpha * Alpha * FilterCount * InputChannels;
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.OutputTileSize = TileSize;
+    Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+    Parameters->u.Winograd.FilterBufferSize = FilterBufferSize;
+    Parameters->u.Winograd.PackedFilter = UsePackedFilter ? PackedFilter : nullptr;
+
+    *WorkingBufferSize = FilterBufferSize +
+        size_t(TargetThreadCount) * Alpha * Alpha * (InputChannels + FilterCount) * TileBlockSize;
+
+    return true;
+}
@@ -343,13 +343,18 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 
     case TransformerLevel::Level3: {
 #ifndef DISABLE_CONTRIB_OPS
-      // Register the NCHWc layout transformer if supported by the platform.
-      if (MlasNchwcGetBlockSize() > 1) {
+      const bool enable_nhwc_fp32_conv =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
+
+      // Register the NCHWc layout transformer if supported by the platform. The fp32 convolutions are left for
+      // the NHWC transformer when it is enabled for them.
+      if (MlasNchwcGetBlockSize() > 1 && !enable_nhwc_fp32_conv) {
         transformers.emplace_back(std::make_unique<NchwcTransformer>());
       }
       auto cpu_allocator = cpu_execution_provider.GetAllocator(OrtMemTypeDefault);
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+      auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                enable_nhwc_fp32_conv);
       if (nhwc_transformer->IsActive()) {
         transformers.emplace_back(std::move(nhwc_transformer));
       }
@@ -423,9 +428,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformersForMinimalB
       // currently the only level 3 optimizer is the NhwcTransformer which is fully supported at runtime
       if (!saving) {
 #ifndef DISABLE_CONTRIB_OPS
+        const bool enable_nhwc_fp32_conv =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNhwcFp32Conv, "0") == "1";
         auto cpu_allocator = cpu_execution_provider.GetAllocator(OrtMemTypeDefault);
         auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
-        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry));
+        auto nhwc_transformer = std::make_unique<NhwcTransformer>(std::move(cpu_allocator), std::move(cpu_registry),
+                                                                  enable_nhwc_fp32_conv);
         if (nhwc_transformer->IsActive()) {
           transformers.emplace_back(std::move(nhwc_transformer));
         }
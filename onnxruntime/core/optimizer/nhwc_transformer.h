@@ -75,7 +75,12 @@ and inserts nodes to transpose tensors as needed.
 class NhwcTransformer : public GraphTransformer {
  private:
  public:
-  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry) noexcept;
+  /**
+   * @param enable_fp32_conv whether fp32 Conv and FusedConv nodes are converted to NhwcFusedConv, which is off by
+   *        default as the NCHWc transformer is preferred for them on platforms where it is available.
+   */
+  explicit NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<KernelRegistry> cpu_kernel_registry,
+                           bool enable_fp32_conv = false) noexcept;
 
   /**
    * @brief Usually called right after constructor, it shows whether
@@ -74,6 +74,27 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
   float* output_ptr = output + first;
   MlasComputeExp(input + first, output_ptr, static_cast<size_t>(len));
 }
+
+template <>
+void Log<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
+  ptrdiff_t len = last - first;
+  float* output_ptr = output + first;
+  MlasComputeUnary(MlasUnaryLog, input + first, output_ptr, static_cast<size_t>(len), 0.0f, nullptr);
+}
+
+template <>
+void Sqrt<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
+  ptrdiff_t len = last - first;
+  float* output_ptr = output + first;
+  MlasComputeUnary(MlasUnarySqrt, input + first, output_ptr, static_cast<size_t>(len), 0.0f, nullptr);
+}
+
+template <>
+void Reciprocal<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
+  ptrdiff_t len = last - first;
+  float* output_ptr = output + first;
+  MlasComputeUnary(MlasUnaryReciprocal, input + first, output_ptr, static_cast<size_t>(len), 0.0f, nullptr);
+}
 }  // namespace functors
 
 #define REG_ELEMENTWISE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS)         \
@@ -457,8 +478,119 @@ static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
                                      AllocateTensorFunc allocate_tensor,
                                      const ProcessBroadcastSpanFuncs& funcs);
 
+// Describes a two input broadcast as an M x N output where each input is either the full matrix, a scalar,
+// a row vector or a column vector.
+struct MlasBroadcastParams {
+  MLAS_BROADCAST_SHAPE shape0;
+  MLAS_BROADCAST_SHAPE shape1;
+  size_t M;
+  size_t N;
+};
+
+// Computes the output shape of a two input broadcast and coalesces the output dimensions into at most two
+// groups of adjacent dimensions that are broadcast the same way for both inputs. e.g. {8,16,32,64} + {1,1,32,64}
+// is a row broadcast of 2048 elements over 128 rows. Returns false if the broadcast needs more than two groups,
+// the shapes are incompatible or the output is empty, in which case the generic broadcaster is used.
+static bool CoalesceBroadcastForMlas(const TensorShape& shape0, const TensorShape& shape1,
+                                     TensorShapeVector& output_dims, MlasBroadcastParams& params) {
+  const size_t rank = std::max(shape0.NumDimensions(), shape1.NumDimensions());
+  const size_t offset0 = rank - shape0.NumDimensions();
+  const size_t offset1 = rank - shape1.NumDimensions();
+
+  // Each group is a (broadcast0, broadcast1) pair along with the number of output elements it spans.
+  struct Group {
+    bool broadcast0;
+    bool broadcast1;
+    size_t size;
+  };
+  InlinedVector<Group, 3> groups;
+
+  output_dims.resize(rank);
+
+  for (size_t i = 0; i < rank; ++i) {
+    const int64_t dim0 = i < offset0 ? 1 : shape0[i - offset0];
+    const int64_t dim1 = i < offset1 ? 1 : shape1[i - offset1];
+
+    if (dim0 != dim1 && dim0 != 1 && dim1 != 1) {
+      return false;
+    }
+
+    const int64_t output_dim = dim0 == 1 ? dim1 : dim0;
+    output_dims[i] = output_dim;
+
+    if (output_dim == 0) {
+      return false;
+    }
+
+    if (output_dim == 1) {
+      continue;
+    }
+
+    const bool broadcast0 = dim0 == 1;
+    const bool broadcast1 = dim1 == 1;
+
+    if (!groups.empty() && groups.back().broadcast0 == broadcast0 && groups.back().broadcast1 == broadcast1) {
+      groups.back().size *= static_cast<size_t>(output_dim);
+    } else {
+      if (groups.size() == 2) {
+        return false;
+      }
+      groups.push_back({broadcast0, broadcast1, static_cast<size_t>(output_dim)});
+    }
+  }
+
+  if (groups.empty()) {
+    params = {MlasBroadcastNone, MlasBroadcastNone, 1, 1};
+  } else if (groups.size() == 1) {
+    params = {groups[0].broadcast0 ? MlasBroadcastScalar : MlasBroadcastNone,
+              groups[0].broadcast1 ? MlasBroadcastScalar : MlasBroadcastNone,
+              1, groups[0].size};
+  } else {
+    // Adjacent groups differ, so an input broadcast in both groups is not possible.
+    const auto shape_of = [](bool broadcast_outer, bool broadcast_inner) {
+      return broadcast_outer ? MlasBroadcastRow : (broadcast_inner ? MlasBroadcastColumn : MlasBroadcastNone);
+    };
+    params = {shape_of(groups[0].broadcast0, groups[1].broadcast0),
+              shape_of(groups[0].broadcast1, groups[1].broadcast1),
+              groups[0].size, groups[1].size};
+  }
+
+  return true;
+}
+
+// Computes a two input binary operation with the MLAS element-wise kernels if the element type is supported and
+// the broadcast coalesces to a shape MLAS handles. Returns false if the caller needs to use the generic path.
+template <typename T>
+static bool TryMlasEltwiseBinary(OpKernelContext& context, MLAS_ELTWISE_BINARY_OP op) {
+  if constexpr (std::is_same<T, float>::value || std::is_same<T, MLFloat16>::value ||
+                std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value) {
+    const Tensor& input0 = *context.Input<Tensor>(0);
+    const Tensor& input1 = *context.Input<Tensor>(1);
+
+    TensorShapeVector output_dims;
+    MlasBroadcastParams params;
+    if (!CoalesceBroadcastForMlas(input0.Shape(), input1.Shape(), output_dims, params)) {
+      return false;
+    }
+
+    Tensor& output = *context.Output(0, TensorShape(output_dims));
+
+    MlasEltwiseBinary<T>(op, input0.Data<T>(), params.shape0, input1.Data<T>(), params.shape1,
+                         output.MutableData<T>(), params.M, params.N, context.GetOperatorThreadPool());
+    return true;
+  } else {
+    ORT_UNUSED_PARAMETER(context);
+    ORT_UNUSED_PARAMETER(op);
+    return false;
+  }
+}
+
 template <typename T>
 Status Add<T>::Compute(OpKernelContext* context) const {
+  if (TryMlasEltwiseBinary<T>(*context, MlasEltwiseAdd)) {
+    return Status::OK();
+  }
+
   // BroadcastHelper received as argument may differ from 'helper' when parallelizing within a span
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
@@ -477,6 +609,10 @@ Status Add<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Sub<T>::Compute(OpKernelContext* context) const {
+  if (TryMlasEltwiseBinary<T>(*context, MlasEltwiseSub)) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() - per_iter_bh.EigenInput1<T>().array();
@@ -494,6 +630,10 @@ Status Sub<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Mul<T>::Compute(OpKernelContext* context) const {
+  if (TryMlasEltwiseBinary<T>(*context, MlasEltwiseMul)) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() * per_iter_bh.EigenInput1<T>().array();
@@ -511,6 +651,10 @@ Status Mul<T>::Compute(OpKernelContext* context) const {
 
 template <typename T>
 Status Div<T>::Compute(OpKernelContext* context) const {
+  if (TryMlasEltwiseBinary<T>(*context, MlasEltwiseDiv)) {
+    return Status::OK();
+  }
+
   ProcessBroadcastSpanFuncs funcs{
       [](BroadcastHelper& per_iter_bh) {
         per_iter_bh.OutputEigen<T>() = per_iter_bh.ScalarInput0<T>() / per_iter_bh.EigenInput1<T>().array();
@@ -546,6 +690,17 @@ void PowImpl(OpKernelContext& context) {
         const E Y = per_iter_bh.ScalarInput1<E>();
         auto output = per_iter_bh.OutputSpan<T>();
 
+        // use the vectorized MLAS kernel for +-0.5 and the integer exponents up to 16 in magnitude, which it
+        // computes with a square root or by repeated squaring. other exponents would go through exp(y * log(x))
+        // in float, which is less accurate than std::pow.
+        if constexpr (std::is_same<T, float>::value) {
+          const double y = static_cast<double>(Y);
+          if (y == 0.5 || y == -0.5 || (std::fabs(y) <= 16.0 && std::nearbyint(y) == y)) {
+            MlasComputeUnary(MlasUnaryPow, X.data(), output.data(), X.size(), static_cast<float>(Y), nullptr);
+            return;
+          }
+        }
+
         // optimize for X^2 and X^3
         if (Y == 2) {
           std::transform(X.begin(), X.end(), output.begin(),
@@ -704,28 +859,53 @@ Status Min_6<float>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+// Min and Max from opset 8 return NaN if either input is NaN. The MLAS element-wise kernels do the same, so the
+// result does not depend on the broadcast or on the position of the element.
+template <typename T>
+static T MinPropagateNaN(const T& a, const T& b) {
+  return (Eigen::numext::isnan(a) || a < b) ? a : b;
+}
+
+template <typename T>
+static T MaxPropagateNaN(const T& a, const T& b) {
+  return (Eigen::numext::isnan(a) || a > b) ? a : b;
+}
+
 template <typename T>
 struct Min_8::ComputeImpl {
   Status operator()(const Min_8& inst, OpKernelContext* context) const {
+    int input_count = inst.Node().InputArgCount().front();
+    if (input_count == 2 && TryMlasEltwiseBinary<T>(*context, MlasEltwiseMin)) {
+      return Status::OK();
+    }
+
     const auto typed_allocator = [](const TensorAllocator& tensor_allocator, const TensorShape& shape) {
       return tensor_allocator.Allocate<T>(shape);
     };
 
     ProcessBroadcastSpanFuncs funcs{
         [](BroadcastHelper& per_iter_bh) {
+          const T input0 = per_iter_bh.ScalarInput0<T>();
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput1<T>().array().min(per_iter_bh.ScalarInput0<T>());
+              per_iter_bh.EigenInput1<T>().array().unaryExpr([input0](T input1) {
+                return MinPropagateNaN(input0, input1);
+              });
         },
         [](BroadcastHelper& per_iter_bh) {
+          const T input1 = per_iter_bh.ScalarInput1<T>();
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput0<T>().array().min(per_iter_bh.ScalarInput1<T>());
+              per_iter_bh.EigenInput0<T>().array().unaryExpr([input1](T input0) {
+                return MinPropagateNaN(input0, input1);
+              });
         },
         [](BroadcastHelper& per_iter_bh) {
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput0<T>().array().min(per_iter_bh.EigenInput1<T>().array());
+              per_iter_bh.EigenInput0<T>().array().binaryExpr(per_iter_bh.EigenInput1<T>().array(),
+                                                              [](T input0, T input1) {
+                                                                return MinPropagateNaN(input0, input1);
+                                                              });
         }};
 
-    int input_count = inst.Node().InputArgCount().front();
     UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
 
     return Status::OK();
@@ -734,6 +914,11 @@ struct Min_8::ComputeImpl {
 
 template <bool is_min>
 static Status MinMaxMLFloat16(const OpKernel& inst, OpKernelContext* context) {
+  int input_count = inst.Node().InputArgCount().front();
+  if (input_count == 2 && TryMlasEltwiseBinary<MLFloat16>(*context, is_min ? MlasEltwiseMin : MlasEltwiseMax)) {
+    return Status::OK();
+  }
+
   const auto typed_allocator = [](const TensorAllocator& tensor_allocator, const TensorShape& shape) {
     return tensor_allocator.Allocate<MLFloat16>(shape);
   };
@@ -748,11 +933,10 @@ static Status MinMaxMLFloat16(const OpKernel& inst, OpKernelContext* context) {
         auto* output = reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data());
         EigenVectorArrayMap<Eigen::half> output_vec_map(output, num_elements);
 
-        if (is_min) {
-          output_vec_map = input_1_vec_map.min(static_cast<Eigen::half>(per_iter_bh.ScalarInput0<MLFloat16>()));
-        } else {
-          output_vec_map = input_1_vec_map.max(static_cast<Eigen::half>(per_iter_bh.ScalarInput0<MLFloat16>()));
-        }
+        const auto scalar_0 = static_cast<Eigen::half>(per_iter_bh.ScalarInput0<MLFloat16>());
+        output_vec_map = input_1_vec_map.unaryExpr([scalar_0](Eigen::half value_1) {
+          return is_min ? MinPropagateNaN(scalar_0, value_1) : MaxPropagateNaN(scalar_0, value_1);
+        });
       },
       [](BroadcastHelper& per_iter_bh) {
         auto num_elements = per_iter_bh.NumOutputElements();
@@ -763,11 +947,10 @@ static Status MinMaxMLFloat16(const OpKernel& inst, OpKernelContext* context) {
         auto* output = reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data());
         EigenVectorArrayMap<Eigen::half> output_vec_map(output, num_elements);
 
-        if (is_min) {
-          output_vec_map = input_0_vec_map.min(static_cast<Eigen::half>(per_iter_bh.ScalarInput1<MLFloat16>()));
-        } else {
-          output_vec_map = input_0_vec_map.max(static_cast<Eigen::half>(per_iter_bh.ScalarInput1<MLFloat16>()));
-        }
+        const auto scalar_1 = static_cast<Eigen::half>(per_iter_bh.ScalarInput1<MLFloat16>());
+        output_vec_map = input_0_vec_map.unaryExpr([scalar_1](Eigen::half value_0) {
+          return is_min ? MinPropagateNaN(value_0, scalar_1) : MaxPropagateNaN(value_0, scalar_1);
+        });
       },
       [](BroadcastHelper& per_iter_bh) {
         auto num_elements = per_iter_bh.NumOutputElements();
@@ -781,14 +964,11 @@ static Status MinMaxMLFloat16(const OpKernel& inst, OpKernelContext* context) {
         auto* output = reinterpret_cast<Eigen::half*>(per_iter_bh.OutputEigen<MLFloat16>().data());
         EigenVectorArrayMap<Eigen::half> output_vec_map(output, num_elements);
 
-        if (is_min) {
-          output_vec_map = input_0_vec_map.min(input_1_vec_map);
-        } else {
-          output_vec_map = input_0_vec_map.max(input_1_vec_map);
-        }
+        output_vec_map = input_0_vec_map.binaryExpr(input_1_vec_map, [](Eigen::half value_0, Eigen::half value_1) {
+          return is_min ? MinPropagateNaN(value_0, value_1) : MaxPropagateNaN(value_0, value_1);
+        });
       }};
 
-  int input_count = inst.Node().InputArgCount().front();
   UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
 
   return Status::OK();
@@ -829,25 +1009,38 @@ Status Max_6<float>::Compute(OpKernelContext* ctx) const {
 template <typename T>
 struct Max_8::ComputeImpl {
   Status operator()(const Max_8& inst, OpKernelContext* context) const {
+    int input_count = inst.Node().InputArgCount().front();
+    if (input_count == 2 && TryMlasEltwiseBinary<T>(*context, MlasEltwiseMax)) {
+      return Status::OK();
+    }
+
     const auto typed_allocator = [](const TensorAllocator& tensor_allocator, const TensorShape& shape) {
       return tensor_allocator.Allocate<T>(shape);
     };
 
     ProcessBroadcastSpanFuncs funcs{
         [](BroadcastHelper& per_iter_bh) {
+          const T input0 = per_iter_bh.ScalarInput0<T>();
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput1<T>().array().max(per_iter_bh.ScalarInput0<T>());
+              per_iter_bh.EigenInput1<T>().array().unaryExpr([input0](T input1) {
+                return MaxPropagateNaN(input0, input1);
+              });
         },
         [](BroadcastHelper& per_iter_bh) {
+          const T input1 = per_iter_bh.ScalarInput1<T>();
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput0<T>().array().max(per_iter_bh.ScalarInput1<T>());
+              per_iter_bh.EigenInput0<T>().array().unaryExpr([input1](T input0) {
+                return MaxPropagateNaN(input0, input1);
+              });
         },
         [](BroadcastHelper& per_iter_bh) {
           per_iter_bh.OutputEigen<T>() =
-              per_iter_bh.EigenInput0<T>().array().max(per_iter_bh.EigenInput1<T>().array());
+              per_iter_bh.EigenInput0<T>().array().binaryExpr(per_iter_bh.EigenInput1<T>().array(),
+                                                              [](T input0, T input1) {
+                                                                return MaxPropagateNaN(input0, input1);
+                                                              });
         }};
 
-    int input_count = inst.Node().InputArgCount().front();
     UntypedBroadcastVariadic(input_count, *context, typed_allocator, funcs);
 
     return Status::OK();
@@ -1314,7 +1507,12 @@ class Sin final : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     auto& X = *context->Input<Tensor>(0);
     auto& Y = *context->Output(0, X.Shape());
-    MakeEigenArrayMap<T>(Y) = MakeEigenArrayMap<T>(X).sin();
+    if constexpr (std::is_same<T, float>::value) {
+      MlasComputeUnary(MlasUnarySin, X.Data<float>(), Y.MutableData<float>(), static_cast<size_t>(X.Shape().Size()),
+                       0.0f, context->GetOperatorThreadPool());
+    } else {
+      MakeEigenArrayMap<T>(Y) = MakeEigenArrayMap<T>(X).sin();
+    }
     return Status::OK();
   }
 };
@@ -1342,7 +1540,8 @@ class Cos final : public OpKernel {
   Status Compute(OpKernelContext* context) const override {
     auto& X = *context->Input<Tensor>(0);
     auto& Y = *context->Output(0, X.Shape());
-    MakeEigenArrayMap<float>(Y) = MakeEigenArrayMap<float>(X).cos();
+    MlasComputeUnary(MlasUnaryCos, X.Data<float>(), Y.MutableData<float>(), static_cast<size_t>(X.Shape().Size()),
+                     0.0f, context->GetOperatorThreadPool());
     return Status::OK();
   }
 };
@@ -3,11 +3,13 @@
 
 #include "core/providers/cpu/math/gemm.h"
 #include "core/common/narrow.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -110,6 +112,125 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+size_t GemmPackedBSize(const TensorShape& b_shape, bool trans_b, bool bf16) {
+  if (b_shape.NumDimensions() != 2) {
+    return 0;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  return bf16 ? MlasBf16GemmPackBSize(N, K) : MlasGemmPackBSize(N, K);
+}
+
+bool GemmFastMathBf16Enabled(const OpKernelInfo& info) {
+  return info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasGemmFastMathBf16, "0") == "1" &&
+         MlasBf16AccelerationSupported();
+}
+
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasBf16GemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  // Zero the alignment padding at the end of the buffer for the same reason as GemmPackBFp32.
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasBf16GemmConvertPackB(trans_b ? CblasTrans : CblasNoTrans,
+                           N,
+                           K,
+                           tensor_b.Data<float>(),
+                           trans_b ? K : N,
+                           packed_b_data);
+  return true;
+}
+
+float GemmSparseThreshold(const OpKernelInfo& info) {
+  const std::string threshold_str =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsMlasSparseGemmThreshold, "0.7");
+  float threshold;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(threshold_str, threshold) && threshold >= 0.0f,
+              "Invalid value for ", kOrtSessionOptionsMlasSparseGemmThreshold, ": ", threshold_str);
+  return threshold;
+}
+
+bool GemmPackBSparse(AllocatorPtr& alloc,
+                     const Tensor& tensor_b,
+                     bool trans_b,
+                     float threshold,
+                     BufferUniquePtr& packed_b,
+                     size_t& packed_b_size,
+                     TensorShape& b_shape,
+                     std::string& kernel_path) {
+  if (threshold > 1.0f || tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (K == 0 || N == 0) {
+    return false;
+  }
+
+  const float* b_data = tensor_b.Data<float>();
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+  const size_t ldb = trans_b ? K : N;
+
+  // Weights are commonly pruned to 1x4 or 4x4 blocks. Taller blocks amortize the loads of A over more
+  // multiplies, but only pay off when the zeros line up, so pick the block height that leaves the least work.
+  size_t block_k = 0;
+  size_t block_count = 0;
+  size_t block_work = std::numeric_limits<size_t>::max();
+  for (size_t candidate_k : {size_t{4}, size_t{1}}) {
+    const size_t count = MlasSparseGemmCountNonZeroBlocks(trans, N, K, b_data, ldb, candidate_k);
+    const size_t work = count * candidate_k * MLAS_SPARSE_SGEMM_BLOCK_N;
+    if (work < block_work) {
+      block_k = candidate_k;
+      block_count = count;
+      block_work = work;
+    }
+  }
+
+  const double sparsity = 1.0 - static_cast<double>(block_work) / (static_cast<double>(K) * static_cast<double>(N));
+  if (sparsity < threshold) {
+    return false;
+  }
+
+  packed_b_size = MlasSparseGemmPackBSize(N, K, block_k, block_count);
+  if (packed_b_size == 0) {
+    return false;
+  }
+  b_shape = shape;
+
+  // Zero the padding of the packed buffer for the same reason as GemmPackBFp32.
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  memset(packed_b_data, 0, packed_b_size);
+
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasSparseGemmPackB(trans, N, K, b_data, ldb, block_k, packed_b_data);
+
+  kernel_path = MakeString("mlas_sparse_bsr_", block_k, "x", MLAS_SPARSE_SGEMM_BLOCK_N,
+                           "(sparsity=", static_cast<int>(sparsity * 100.0), "%)");
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -164,7 +285,11 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    if (fastmath_bf16_) {
+      is_packed = GemmPackBBf16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    } else {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -195,6 +320,34 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::RestorePrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                        std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                        gsl::span<const size_t> /*prepacked_buffer_sizes*/,
+                                        const std::string& /*kernel_path*/,
+                                        /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::RestorePrePackedBuffers(const Tensor& tensor, int input_idx,
+                                            std::vector<BufferUniquePtr>& prepacked_buffers,
+                                            gsl::span<const size_t> prepacked_buffer_sizes,
+                                            const std::string& /*kernel_path*/,
+                                            /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+
+  // PrePack() selects the format of B by the fastmath mode alone
+  if (input_idx == 1 && prepacked_buffers.size() == 1 &&
+      GemmPackedBSize(tensor.Shape(), trans_B_ != CblasNoTrans, fastmath_bf16_) == prepacked_buffer_sizes[0]) {
+    used_prepacked_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+    b_shape_ = tensor.Shape();
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -278,27 +431,64 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
+  if (fastmath_bf16_ && !B) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    MLAS_BF16_GEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(K);
+    data.B = packed_b_.get();
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+    data.AIsfp32 = true;
+    MlasBf16GemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data, thread_pool);
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+    return Status::OK();
+  }
+
+  MLAS_SGEMM_DATA_PARAMS data;
+  data.A = A->Data<float>();
+  data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
   if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
+    data.B = B->Data<float>();
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+  } else {
+    data.B = static_cast<const float*>(packed_b_.get());
+    data.BIsPacked = true;
+  }
+  data.C = y_data;
+  data.ldc = static_cast<size_t>(N);
+  data.alpha = alpha_;
+
+  // A (N,) or (1, N) bias with beta 1 is added by the SGEMM epilogue while the output tile is still
+  // in cache, instead of being broadcast into Y ahead of the GEMM.
+  if (c_data != nullptr && beta_ == 1.0f && c_shape->Size() == N &&
+      (c_shape->NumDimensions() == 1 || (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1))) {
+    data.Bias = c_data;
+    data.beta = 0.0f;
+  } else if (c_data != nullptr && beta_ == 1.0f && activation_ == nullptr && c_shape->NumDimensions() == 2 &&
+             (*c_shape)[0] == M && (*c_shape)[1] == N) {
+    // A full (M, N) C, such as the residual of a MatMul + Add fused into Gemm, is added by the epilogue
+    // rather than copied into Y first. The residual follows the activation, so only without one.
+    data.Residual = c_data;
+    data.ldr = static_cast<size_t>(N);
+    data.beta = 0.0f;
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
   }
 
-  ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  if (mlas_activation_.has_value()) {
+    data.Activation = &*mlas_activation_;
+  }
+
+  MlasGemmBatch(trans_A_, B ? trans_B_ : CblasNoTrans, static_cast<size_t>(M), static_cast<size_t>(N),
+                static_cast<size_t>(K), &data, 1, thread_pool);
+
+  if (data.Activation == nullptr) {
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  }
 
   return Status::OK();
 }
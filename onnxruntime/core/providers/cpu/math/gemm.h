@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include <optional>
+
 #include "gemm_base.h"
 
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -16,6 +20,8 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    // The bfloat16 packed B is only used with a row major A.
+    fastmath_bf16_ = std::is_same<T, float>::value && trans_A_ == CblasNoTrans && GemmFastMathBf16Enabled(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,6 +34,12 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status RestorePrePackedBuffers(const Tensor& tensor, int input_idx,
+                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                 gsl::span<const size_t> prepacked_buffer_sizes,
+                                 const std::string& kernel_path,
+                                 /*out*/ bool& used_prepacked_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
                           float alpha,
@@ -41,9 +53,15 @@ class Gemm : protected GemmBase, public OpKernel {
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
 
+  // Whether B is rounded to bfloat16 when pre-packed
+  bool fastmath_bf16_;
+
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
 
+  // The fused activation in the form the MLAS SGEMM epilogue applies, if it has one
+  std::optional<MLAS_ACTIVATION> mlas_activation_;
+
   void ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const;
 };
 
@@ -14,4 +14,36 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Returns the size of the weight matrix B packed by GemmPackBBf16 if bf16 is set or by GemmPackBFp32 otherwise,
+// or 0 if it is not packed. Used to validate pre-packed buffers restored from the pre-packed weights cache file.
+size_t GemmPackedBSize(const TensorShape& b_shape, bool trans_b, bool bf16);
+
+// Returns true if the session enables the bfloat16 fastmath mode of the fp32 Gemm and MatMul kernels
+// (kOrtSessionOptionsMlasGemmFastMathBf16) and the platform accelerates bfloat16 GEMM.
+bool GemmFastMathBf16Enabled(const OpKernelInfo& info);
+
+// Rounds the fp32 weight matrix B to bfloat16 and packs it for MlasBf16GemmBatch.
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+// Returns the fraction of zero work above which the fp32 weight matrix B is packed for MlasSparseGemmBatch
+// (kOrtSessionOptionsMlasSparseGemmThreshold).
+float GemmSparseThreshold(const OpKernelInfo& info);
+
+// Packs the fp32 weight matrix B in the block sparse format of MlasSparseGemmBatch if at least the threshold
+// fraction of its blocks are zero. The block height with the least remaining work is selected and described in
+// kernel_path for the profiler.
+bool GemmPackBSparse(AllocatorPtr& alloc,
+                     const Tensor& tensor_b,
+                     bool trans_b,
+                     float threshold,
+                     BufferUniquePtr& packed_b,
+                     size_t& packed_b_size,
+                     TensorShape& b_shape,
+                     std::string& kernel_path);
+
 };  // namespace onnxruntime
@@ -134,7 +134,21 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    if (fastmath_bf16_) {
+      is_packed = GemmPackBBf16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+      kernel_path_ = "mlas_packed_bf16";
+    } else {
+      sparse_b_ = GemmPackBSparse(alloc, tensor, trans_b_attr_ != 0, sparse_threshold_,
+                                  packed_b_, packed_b_size, b_shape_, kernel_path_);
+      is_packed = sparse_b_;
+      if (!is_packed) {
+        is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+        kernel_path_ = "mlas_packed_fp32";
+      }
+    }
+    if (!is_packed) {
+      kernel_path_.clear();
+    }
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -157,6 +171,82 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::RestorePrePackedBuffers(const Tensor& tensor, int input_idx,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              gsl::span<const size_t> prepacked_buffer_sizes,
+                                              const std::string& kernel_path,
+                                              /*out*/ bool& used_prepacked_buffers) {
+  used_prepacked_buffers = false;
+
+  if (input_idx != 1 || prepacked_buffers.size() != 1) {
+    return Status::OK();
+  }
+
+  // The kernel path records the format PrePack() selected for B. The block sparse format holds the block offsets
+  // and row indices that the kernel reads through, so they are validated against the shape of B.
+  bool sparse_b = false;
+  if (kernel_path.rfind("mlas_sparse_bsr_", 0) == 0) {
+    sparse_b = true;
+    if (fastmath_bf16_ || sparse_threshold_ > 1.0f || tensor.Shape().NumDimensions() != 2) {
+      return Status::OK();
+    }
+    const auto& shape = tensor.Shape();
+    const size_t K = static_cast<size_t>(trans_b_attr_ ? shape[1] : shape[0]);
+    const size_t N = static_cast<size_t>(trans_b_attr_ ? shape[0] : shape[1]);
+    if (!MlasSparseGemmIsValidPackedB(N, K, prepacked_buffers[0].get(), prepacked_buffer_sizes[0])) {
+      return Status::OK();
+    }
+  } else {
+    const bool bf16 = kernel_path == "mlas_packed_bf16";
+    if ((!bf16 && kernel_path != "mlas_packed_fp32") || bf16 != fastmath_bf16_ ||
+        GemmPackedBSize(tensor.Shape(), trans_b_attr_ != 0, bf16) != prepacked_buffer_sizes[0]) {
+      return Status::OK();
+    }
+  }
+
+  used_prepacked_buffers = true;
+  packed_b_ = std::move(prepacked_buffers[0]);
+  b_shape_ = tensor.Shape();
+  sparse_b_ = sparse_b;
+  kernel_path_ = kernel_path;
+  return Status::OK();
+}
+
+Status MatMul<float>::GetActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation) {
+  activation.ActivationKind = MlasIdentityActivation;
+
+  std::string activation_type;
+  if (!info.GetAttr<std::string>("activation", &activation_type).IsOK()) {
+    return Status::OK();
+  }
+
+  if (activation_type == "Relu") {
+    activation.ActivationKind = MlasReluActivation;
+  } else if (activation_type == "LeakyRelu") {
+    activation.ActivationKind = MlasLeakyReluActivation;
+    activation.Parameters.LeakyRelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.01f);
+  } else if (activation_type == "Tanh") {
+    activation.ActivationKind = MlasTanhActivation;
+  } else if (activation_type == "Sigmoid") {
+    activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation_type == "HardSigmoid") {
+    activation.ActivationKind = MlasHardSigmoidActivation;
+    activation.Parameters.HardSigmoid.alpha = info.GetAttrOrDefault<float>("activation_alpha", 0.2f);
+    activation.Parameters.HardSigmoid.beta = info.GetAttrOrDefault<float>("activation_beta", 0.5f);
+  } else if (activation_type == "Gelu") {
+    activation.ActivationKind = MlasGeluErfActivation;
+  } else if (activation_type == "FastGelu") {
+    activation.ActivationKind = MlasGeluTanhActivation;
+  } else if (activation_type == "QuickGelu") {
+    activation.ActivationKind = MlasQuickGeluActivation;
+    activation.Parameters.QuickGelu.alpha = info.GetAttrOrDefault<float>("activation_alpha", 1.702f);
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "unimplemented activation: ", activation_type);
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -187,6 +277,43 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
 
+  if (packed_b_ && fastmath_bf16_) {
+    std::vector<MLAS_BF16_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+      data[i].AIsfp32 = true;
+    }
+    MlasBf16GemmBatch(M, N, K, max_len, data.data(), thread_pool);
+    if (activation_.ActivationKind != MlasIdentityActivation) {
+      const size_t y_size = static_cast<size_t>(y->Shape().Size());
+      MlasActivation(&activation_, y_data, nullptr, 1, y_size, y_size);
+    }
+    return Status::OK();
+  }
+
+  if (packed_b_ && sparse_b_) {
+    std::vector<MLAS_SPARSE_SGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].PackedB = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+    }
+    MlasSparseGemmBatch(M, N, K, max_len, data.data(), thread_pool);
+    if (activation_.ActivationKind != MlasIdentityActivation) {
+      const size_t y_size = static_cast<size_t>(y->Shape().Size());
+      MlasActivation(&activation_, y_data, nullptr, 1, y_size, y_size);
+    }
+    return Status::OK();
+  }
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
@@ -198,6 +325,7 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].ldc = N;
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
+    data[i].Activation = &activation_;
   }
   MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                 M, N, K, data.data(), max_len, thread_pool);
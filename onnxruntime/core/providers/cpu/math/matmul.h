@@ -4,6 +4,8 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -27,6 +29,14 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+
+    // The bfloat16 packed B is only used with a row major A.
+    fastmath_bf16_ = trans_a_attr_ == 0 && GemmFastMathBf16Enabled(info);
+
+    // The block sparse packed B is also only used with a row major A.
+    sparse_threshold_ = trans_a_attr_ == 0 ? GemmSparseThreshold(info) : 2.0f;
+
+    ORT_THROW_IF_ERROR(GetActivationAttr(info, activation_));
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -36,18 +46,43 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status RestorePrePackedBuffers(const Tensor& tensor, int input_idx,
+                                 std::vector<BufferUniquePtr>& prepacked_buffers,
+                                 gsl::span<const size_t> prepacked_buffer_sizes,
+                                 const std::string& kernel_path,
+                                 /*out*/ bool& used_prepacked_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
+  std::string GetKernelPath() const override { return kernel_path_; }
+
  private:
+  // Converts the activation attributes of FusedMatMulActivation into a MLAS_ACTIVATION.
+  static Status GetActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION& activation);
+
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
 
+  // Whether B is rounded to bfloat16 when pre-packed
+  bool fastmath_bf16_;
+
+  // Fraction of zero work above which B is packed in the block sparse format (disabled if greater
+  // than 1), and whether B was packed that way
+  float sparse_threshold_;
+  bool sparse_b_{false};
+
+  // Describes the pre-packed path of B for the profiler
+  std::string kernel_path_;
+
   // For FusedMatMul contrib ops
   float alpha_attr_;
   int64_t trans_a_attr_;
   int64_t trans_b_attr_;
   bool trans_batch_a_;
   bool trans_batch_b_;
+
+  // For FusedMatMulActivation contrib op, applied by MLAS to the output tiles
+  MLAS_ACTIVATION activation_;
 };
 
 }  // namespace onnxruntime
@@ -153,6 +153,52 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  // only transform the 2D filter tensor
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 4) {
+    return Status::OK();
+  }
+
+  TensorShapeVector kernel_shape;
+  if (!conv_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape).IsOK()) {
+    return Status::OK();
+  }
+
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t input_channels = static_cast<size_t>(tensor.Shape()[1]);
+  const size_t filter_count = static_cast<size_t>(tensor.Shape()[0]) / group_count;
+
+  const size_t packed_filter_size = MlasConvWinogradPackFilterSize(kernel_shape.size(), group_count, input_channels,
+                                                                   filter_count, kernel_shape.data(),
+                                                                   dilations.data(), strides.data());
+  if (packed_filter_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_filter_data = alloc->Alloc(SafeInt<size_t>(packed_filter_size) * sizeof(float));
+  winograd_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+  MlasConvWinogradPackFilter(group_count, input_channels, filter_count, tensor.Data<float>(),
+                             static_cast<float*>(packed_filter_data));
+
+  // The original filter is still required for the input shapes that do not use the Winograd algorithm, so the
+  // filter is not reported as packed.
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -233,6 +279,13 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     Beta,
                     thread_pool);
 
+    if (winograd_filter_ != nullptr) {
+      MlasConvWinogradPrepare(&Parameters,
+                              static_cast<const float*>(winograd_filter_.get()),
+                              &WorkingBufferSize,
+                              thread_pool);
+    }
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
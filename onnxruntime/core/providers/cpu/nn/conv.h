@@ -28,12 +28,22 @@ class Conv<float> : public OpKernel {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // Filter transformed for the Winograd algorithm, which is used for 3x3 convolutions with unit strides and
+  // dilations when MLAS estimates it to be cheaper for the input shape. The original filter is kept for the
+  // input shapes where it is not.
+  BufferUniquePtr winograd_filter_;
 };
 
 }  // namespace onnxruntime
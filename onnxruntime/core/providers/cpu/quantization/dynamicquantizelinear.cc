@@ -32,19 +32,14 @@ Status DynamicQuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   auto& y_scale = *ctx->Output(1, shape);
   auto& y_zeropoint = *ctx->Output(2, shape);
 
-  float scale;
-  T zero_point;
-  GetQuantizationParameter(x_data, num_of_elements, scale, zero_point, ctx->GetOperatorThreadPool());
-
   auto* output_scale = y_scale.MutableData<float>();
-  *output_scale = scale;
-
   auto* output_zp = y_zeropoint.MutableData<T>();
-  *output_zp = zero_point;
 
-  // quantize the data
+  // find the quantization parameters and quantize the data in one call, so the
+  // input is read back from the cache instead of memory
   auto* output = y.MutableData<T>();
-  ParQuantizeLinear(x_data, output, onnxruntime::narrow<size_t>(num_of_elements), scale, zero_point, ctx->GetOperatorThreadPool());
+  MlasDynamicQuantizeLinear(x_data, output, onnxruntime::narrow<size_t>(num_of_elements), output_scale, output_zp,
+                            ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -12,6 +12,7 @@
 #include "core/util/math.h"
 #endif
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/common/safeint.h"
 #include <cmath>
@@ -68,6 +69,62 @@ FastReduceKind OptimizeShapeForFastReduce(gsl::span<const int64_t> input_shape,
                                           TensorShapeVector& fast_axes,
                                           bool keep_dims, bool noop_with_empty_axes = false);
 
+/*
+  The fast reductions of float tensors are computed by MLAS. These helpers return
+  false for the other types, which keep their Eigen based implementation.
+*/
+template <typename T>
+inline bool MlasFastReduceKR(MLAS_REDUCE_KIND, const Tensor&, const gsl::span<const int64_t>&,
+                             Tensor&, concurrency::ThreadPool*) {
+  return false;
+}
+
+template <>
+inline bool MlasFastReduceKR<float>(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                    Tensor& output, concurrency::ThreadPool* tp) {
+  if (fast_shape[1] == 0) {
+    return false;
+  }
+  MlasReduceKR(kind, input.Data<float>(), output.MutableData<float>(),
+               onnxruntime::narrow<size_t>(fast_shape[0]), onnxruntime::narrow<size_t>(fast_shape[1]), tp);
+  return true;
+}
+
+template <typename T>
+inline bool MlasFastReduceRK(MLAS_REDUCE_KIND, const Tensor&, const gsl::span<const int64_t>&,
+                             Tensor&, concurrency::ThreadPool*) {
+  return false;
+}
+
+template <>
+inline bool MlasFastReduceRK<float>(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                    Tensor& output, concurrency::ThreadPool* tp) {
+  if (fast_shape[0] == 0) {
+    return false;
+  }
+  MlasReduceKRK(kind, input.Data<float>(), output.MutableData<float>(),
+                1, onnxruntime::narrow<size_t>(fast_shape[0]), onnxruntime::narrow<size_t>(fast_shape[1]), tp);
+  return true;
+}
+
+template <typename T>
+inline bool MlasFastReduceKRK(MLAS_REDUCE_KIND, const Tensor&, const gsl::span<const int64_t>&,
+                              Tensor&, concurrency::ThreadPool*) {
+  return false;
+}
+
+template <>
+inline bool MlasFastReduceKRK<float>(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                     Tensor& output, concurrency::ThreadPool* tp) {
+  if (fast_shape[1] == 0) {
+    return false;
+  }
+  MlasReduceKRK(kind, input.Data<float>(), output.MutableData<float>(),
+                onnxruntime::narrow<size_t>(fast_shape[0]), onnxruntime::narrow<size_t>(fast_shape[1]),
+                onnxruntime::narrow<size_t>(fast_shape[2]), tp);
+  return true;
+}
+
 class ResultsNoTransposePrepareForReduce {
  public:
   TensorShapeVector input_shape;
@@ -224,6 +281,9 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKR<T>(MlasReduceSum, input, fast_shape, output, tp)) {
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -238,6 +298,9 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceRK<T>(MlasReduceSum, input, fast_shape, output, tp)) {
+      return;
+    }
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
@@ -256,6 +319,9 @@ class ReduceAggregatorSum : public ReduceAggregator<T, T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKRK<T>(MlasReduceSum, input, fast_shape, output, tp)) {
+      return;
+    }
     int64_t N = fast_shape[2];
     const T* data = input.Data<T>();
     int64_t stridei = fast_shape[1] * fast_shape[2];
@@ -309,6 +375,9 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKR<T>(MlasReduceMean, input, fast_shape, output, tp)) {
+      return;
+    }
     ReduceAggregatorSum<T>::FastReduceKR(input, fast_shape, output, tp);
     // TODO: use MLAS or BLAS
     T* out = output.MutableData<T>();
@@ -320,6 +389,9 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceRK<T>(MlasReduceMean, input, fast_shape, output, tp)) {
+      return;
+    }
     ReduceAggregatorSum<T>::FastReduceRK(input, fast_shape, output, tp);
     // TODO: use MLAS or BLAS
     T* out = output.MutableData<T>();
@@ -331,6 +403,9 @@ class ReduceAggregatorMean : public ReduceAggregatorSum<T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKRK<T>(MlasReduceMean, input, fast_shape, output, tp)) {
+      return;
+    }
     ReduceAggregatorSum<T>::FastReduceKRK(input, fast_shape, output, tp);
     int64_t strideo = fast_shape[2];
     T* out = output.MutableData<T>();
@@ -377,6 +452,9 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKR<T>(MlasReduceMaximum, input, fast_shape, output, tp)) {
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -392,6 +470,9 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceRK<T>(MlasReduceMaximum, input, fast_shape, output, tp)) {
+      return;
+    }
     int64_t n_rows = fast_shape[0];
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
@@ -414,6 +495,9 @@ class ReduceAggregatorMax : public ReduceAggregator<T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKRK<T>(MlasReduceMaximum, input, fast_shape, output, tp)) {
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1] * fast_shape[2];
@@ -552,6 +636,9 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKR<T>(MlasReduceMinimum, input, fast_shape, output, tp)) {
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1];
@@ -567,6 +654,9 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                            Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceRK<T>(MlasReduceMinimum, input, fast_shape, output, tp)) {
+      return;
+    }
     int64_t n_rows = fast_shape[0];
     int64_t N = fast_shape[1];
     const T* data = input.Data<T>();
@@ -589,6 +679,9 @@ class ReduceAggregatorMin : public ReduceAggregator<T, T> {
 
   static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
                             Tensor& output, concurrency::ThreadPool* tp) {
+    if (MlasFastReduceKRK<T>(MlasReduceMinimum, input, fast_shape, output, tp)) {
+      return;
+    }
     const T* data = input.Data<T>();
     T* out = output.MutableData<T>();
     int64_t stridei = fast_shape[1] * fast_shape[2];
@@ -682,6 +775,34 @@ class ReduceAggregatorLogSumExp : public ReduceAggregator<T, T> {
   }
   inline void update(const T& v) { this->accumulator_ += reduce_exp(v - max_); }
   inline T get_value() { return reduce_log<T>(this->accumulator_) + max_; }
+
+  // Fast reduction, only available for float through MLAS.
+  static inline FastReduceKind WhichFastReduce() {
+    return std::is_same<T, float>::value ? (FastReduceKind::kKR | FastReduceKind::kRK | FastReduceKind::kKRK)
+                                         : FastReduceKind::kNone;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ORT_ENFORCE(MlasFastReduceKR<T>(MlasReduceLogSumExp, input, fast_shape, output, tp),
+                "ReduceLogSumExp: unexpected fast reduction KR.");
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    ORT_ENFORCE(MlasFastReduceRK<T>(MlasReduceLogSumExp, input, fast_shape, output, tp),
+                "ReduceLogSumExp: unexpected fast reduction RK.");
+  }
+
+  static void FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                            Tensor& output, concurrency::ThreadPool* tp) {
+    ORT_ENFORCE(MlasFastReduceKRK<T>(MlasReduceLogSumExp, input, fast_shape, output, tp),
+                "ReduceLogSumExp: unexpected fast reduction KRK.");
+  }
+
+  static void FastReduceRKR(const Tensor&, const gsl::span<const int64_t>&, Tensor&, concurrency::ThreadPool*) {
+    ORT_THROW("ReduceLogSumExp: unexpected fast reduction RKR.");
+  }
 };
 
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
@@ -23,9 +23,7 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 namespace onnxruntime {
 
@@ -209,21 +207,46 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
-
-// tensor MLFloat16 -> float
-template <>
-struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
+// tensor X -> Y with the MLAS conversion routines, which use SIMD instructions and the operator thread pool.
+// Conversions to integers saturate to the range of the integer type.
+template <typename SrcType, typename DstType>
+struct MlasTensorCaster {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+    MlasCast(in.Data<SrcType>(), out.MutableData<DstType>(), shape_size, context.GetOperatorThreadPool());
   }
 };
 
+template <>
+struct TensorCaster<MLFloat16, float> : MlasTensorCaster<MLFloat16, float> {};
+
+template <>
+struct TensorCaster<float, MLFloat16> : MlasTensorCaster<float, MLFloat16> {};
+
+template <>
+struct TensorCaster<BFloat16, float> : MlasTensorCaster<BFloat16, float> {};
+
+template <>
+struct TensorCaster<float, BFloat16> : MlasTensorCaster<float, BFloat16> {};
+
+template <>
+struct TensorCaster<float, int32_t> : MlasTensorCaster<float, int32_t> {};
+
+template <>
+struct TensorCaster<float, int8_t> : MlasTensorCaster<float, int8_t> {};
+
+template <>
+struct TensorCaster<float, uint8_t> : MlasTensorCaster<float, uint8_t> {};
+
+template <>
+struct TensorCaster<int32_t, float> : MlasTensorCaster<int32_t, float> {};
+
+template <>
+struct TensorCaster<int8_t, float> : MlasTensorCaster<int8_t, float> {};
+
+template <>
+struct TensorCaster<uint8_t, float> : MlasTensorCaster<uint8_t, float> {};
+
 Tensor GetIntermediateMLFloat16ToFloatTensor(
     const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
   AllocatorPtr allocator;
@@ -256,7 +279,6 @@ struct TensorCaster<MLFloat16, std::string> {
     CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
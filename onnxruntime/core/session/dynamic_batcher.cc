@@ -0,0 +1,420 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+struct DynamicBatcher::Request {
+  const RunOptions& run_options;
+  gsl::span<const OrtValue> feeds;
+  std::vector<OrtValue>& fetches;
+  int64_t batch_size;
+  TimePoint enqueue_time;
+  Status status;
+};
+
+struct DynamicBatcher::Batch {
+  std::string key;
+  std::string inputs_key;
+
+  // the names of the leader, which outlives the batch run
+  gsl::span<const std::string> feed_names;
+  gsl::span<const std::string> output_names;
+
+  std::vector<Request*> requests;  // GUARDED_BY(mutex_) until closed
+  int64_t batch_size = 0;          // GUARDED_BY(mutex_)
+  bool closed = false;             // GUARDED_BY(mutex_), no requests are added once set
+  bool done = false;               // GUARDED_BY(mutex_), the status and outputs of the requests are set
+
+  OrtCondVar full;       // the leader waits for the batch to be closed
+  OrtCondVar completed;  // the other requests wait for the batch to be done
+};
+
+namespace {
+
+bool IsBatchableTensor(const OrtValue& value, size_t batch_dim) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  const Tensor& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU &&
+         !tensor.IsDataTypeString() &&
+         tensor.Shape().NumDimensions() > batch_dim;
+}
+
+// Identifies the run options that affect how a batch run is logged and profiled. The run tag comes last so that
+// the key can not be ambiguous.
+std::string GetRunOptionsKey(const RunOptions& run_options) {
+  std::ostringstream key;
+  key << '|' << run_options.run_log_severity_level << '|' << run_options.run_log_verbosity_level;
+#ifdef ENABLE_TRAINING
+  key << '|' << run_options.training_mode;
+#endif
+  key << '|' << run_options.run_tag;
+  return key.str();
+}
+
+// Size in bytes of the slice of a tensor below one index of the batch dimension.
+size_t BytesPerRow(const Tensor& tensor, size_t batch_dim) {
+  return narrow<size_t>(tensor.Shape().SizeFromDimension(batch_dim + 1)) * tensor.DataType()->Size();
+}
+
+// Copies the sources into consecutive ranges of the batch dimension of the destination.
+void Concatenate(gsl::span<const Tensor* const> sources, Tensor& destination, size_t batch_dim) {
+  const auto& shape = destination.Shape();
+  const size_t outer = narrow<size_t>(shape.SizeToDimension(batch_dim));
+  const size_t row_bytes = BytesPerRow(destination, batch_dim);
+  const size_t destination_block = narrow<size_t>(shape[batch_dim]) * row_bytes;
+
+  auto* destination_data = static_cast<uint8_t*>(destination.MutableDataRaw());
+  size_t offset = 0;
+
+  for (const Tensor* source : sources) {
+    const size_t source_block = narrow<size_t>(source->Shape()[batch_dim]) * row_bytes;
+    const auto* source_data = static_cast<const uint8_t*>(source->DataRaw());
+
+    for (size_t i = 0; i < outer; ++i) {
+      std::memcpy(destination_data + i * destination_block + offset, source_data + i * source_block, source_block);
+    }
+
+    offset += source_block;
+  }
+}
+
+// Copies consecutive ranges of the batch dimension of the source into the destinations.
+void Split(const Tensor& source, gsl::span<Tensor* const> destinations, size_t batch_dim) {
+  const auto& shape = source.Shape();
+  const size_t outer = narrow<size_t>(shape.SizeToDimension(batch_dim));
+  const size_t row_bytes = BytesPerRow(source, batch_dim);
+  const size_t source_block = narrow<size_t>(shape[batch_dim]) * row_bytes;
+
+  const auto* source_data = static_cast<const uint8_t*>(source.DataRaw());
+  size_t offset = 0;
+
+  for (Tensor* destination : destinations) {
+    const size_t destination_block = narrow<size_t>(destination->Shape()[batch_dim]) * row_bytes;
+    auto* destination_data = static_cast<uint8_t*>(destination->MutableDataRaw());
+
+    for (size_t i = 0; i < outer; ++i) {
+      std::memcpy(destination_data + i * destination_block, source_data + i * source_block + offset,
+                  destination_block);
+    }
+
+    offset += destination_block;
+  }
+}
+
+}  // namespace
+
+DynamicBatcher::DynamicBatcher(const DynamicBatchingOptions& options, AllocatorPtr cpu_allocator, RunFn run_fn,
+                               profiling::Profiler& profiler, const logging::Logger& logger)
+    : options_(options),
+      cpu_allocator_(std::move(cpu_allocator)),
+      run_fn_(std::move(run_fn)),
+      profiler_(profiler),
+      logger_(logger) {
+  ORT_ENFORCE(options_.max_batch_size > 1, "The maximum batch size of dynamic batching must be greater than 1.");
+  ORT_ENFORCE(cpu_allocator_ != nullptr, "Dynamic batching requires a CPU allocator.");
+}
+
+int64_t DynamicBatcher::GetBatchSize(gsl::span<const OrtValue> feeds, const std::vector<OrtValue>& fetches) const {
+  if (feeds.empty()) {
+    return 0;
+  }
+
+  // pre-allocated outputs would have to be filled by a copy, leave them to a regular run
+  if (std::any_of(fetches.cbegin(), fetches.cend(), [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+    return 0;
+  }
+
+  int64_t batch_size = 0;
+  for (const auto& feed : feeds) {
+    if (!IsBatchableTensor(feed, options_.batch_dim)) {
+      return 0;
+    }
+
+    const int64_t feed_batch_size = feed.Get<Tensor>().Shape()[options_.batch_dim];
+    if (feed_batch_size <= 0 || (batch_size != 0 && feed_batch_size != batch_size)) {
+      return 0;
+    }
+
+    batch_size = feed_batch_size;
+  }
+
+  return batch_size;
+}
+
+std::string DynamicBatcher::GetInputsKey(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                         gsl::span<const std::string> output_names) const {
+  std::ostringstream key;
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    const Tensor& tensor = feeds[i].Get<Tensor>();
+    const auto& shape = tensor.Shape();
+
+    key << feed_names[i] << ':' << tensor.GetElementType() << '[';
+    for (size_t dim = 0; dim < shape.NumDimensions(); ++dim) {
+      if (dim == options_.batch_dim) {
+        key << '*';
+      } else {
+        key << shape[dim];
+      }
+      key << ',';
+    }
+    key << ']';
+  }
+
+  key << "->";
+  for (const auto& output_name : output_names) {
+    key << output_name << ',';
+  }
+
+  return key.str();
+}
+
+Status DynamicBatcher::Run(const RunOptions& run_options,
+                           gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches,
+                           bool& handled) {
+  handled = false;
+
+  // a batch is run with the options of one of its requests, so only requests with the default behavior are mixed,
+  // and only with requests of the same run tag and log levels
+  if (run_options.terminate || run_options.only_execute_path_to_fetches ||
+      !run_options.config_options.configurations.empty()) {
+    return Status::OK();
+  }
+
+  const int64_t batch_size = GetBatchSize(feeds, fetches);
+  if (batch_size == 0 || batch_size >= options_.max_batch_size) {
+    return Status::OK();
+  }
+
+  std::string inputs_key = GetInputsKey(feed_names, feeds, output_names);
+  std::string key = inputs_key + GetRunOptionsKey(run_options);
+  Request request{run_options, feeds, fetches, batch_size, std::chrono::high_resolution_clock::now(), Status::OK()};
+
+  std::shared_ptr<Batch> batch;
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+
+    // the model could not be run on a batch of these inputs before, leave the request to a regular run
+    if (unbatchable_inputs_.count(inputs_key) != 0) {
+      ++stats_.num_bypassed_requests;
+      return Status::OK();
+    }
+
+    handled = true;
+
+    auto it = open_batches_.find(key);
+    if (it != open_batches_.end() && it->second->batch_size + batch_size > options_.max_batch_size) {
+      // the request does not fit, start the open batch now and begin a new one
+      it->second->closed = true;
+      it->second->full.notify_one();
+      open_batches_.erase(it);
+      it = open_batches_.end();
+    }
+
+    if (it == open_batches_.end()) {
+      batch = std::make_shared<Batch>();
+      batch->key = key;
+      batch->inputs_key = std::move(inputs_key);
+      batch->feed_names = feed_names;
+      batch->output_names = output_names;
+      open_batches_.emplace(std::move(key), batch);
+    } else {
+      batch = it->second;
+    }
+
+    batch->requests.push_back(&request);
+    batch->batch_size += batch_size;
+
+    if (batch->requests.front() != &request) {
+      if (batch->batch_size >= options_.max_batch_size) {
+        batch->closed = true;
+        batch->full.notify_one();
+        open_batches_.erase(batch->key);
+      }
+
+      batch->completed.wait(lock, [&batch]() { return batch->done; });
+      return request.status;
+    }
+
+    // this request leads the batch, wait for it to fill up
+    const auto deadline = request.enqueue_time + options_.max_wait;
+    while (!batch->closed) {
+      const auto now = std::chrono::high_resolution_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      batch->full.wait_for(lock, deadline - now);
+    }
+
+    if (!batch->closed) {
+      batch->closed = true;
+      open_batches_.erase(batch->key);
+    }
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    for (const Request* batched_request : batch->requests) {
+      const auto queue_delay_us = static_cast<uint64_t>(
+          TimeDiffMicroSeconds(batched_request->enqueue_time, start_time));
+      stats_.total_queue_delay_us += queue_delay_us;
+      stats_.max_queue_delay_us = std::max(stats_.max_queue_delay_us, queue_delay_us);
+    }
+    stats_.num_requests += batch->requests.size();
+    stats_.num_batched_rows += static_cast<uint64_t>(batch->batch_size);
+    ++stats_.num_batches;
+  }
+
+  ExecuteBatch(*batch);
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    batch->done = true;
+  }
+  batch->completed.notify_all();
+
+  return request.status;
+}
+
+void DynamicBatcher::ExecuteBatch(const Batch& batch) {
+  TimePoint tp;
+  if (profiler_.IsEnabled()) {
+    tp = profiler_.Start();
+  }
+
+  // requests that were canceled while they were queued are not run
+  std::vector<Request*> requests;
+  requests.reserve(batch.requests.size());
+  for (Request* request : batch.requests) {
+    if (request->run_options.terminate) {
+      request->status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    } else {
+      requests.push_back(request);
+    }
+  }
+
+  Status status = Status::OK();
+  if (requests.size() > 1) {
+    ORT_TRY {
+      status = RunBatched(batch, requests);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (status.IsOK()) {
+      for (Request* request : requests) {
+        request->status = Status::OK();
+      }
+    } else {
+      LOGS(logger_, VERBOSE) << "Running the " << requests.size()
+                             << " requests of the batch on their own after the batched run failed: "
+                             << status.ErrorMessage();
+      std::lock_guard<OrtMutex> lock(mutex_);
+      stats_.num_unbatched_runs += requests.size();
+    }
+  }
+
+  if (requests.size() == 1 || !status.IsOK()) {
+    for (Request* request : requests) {
+      request->fetches.clear();
+      request->status = run_fn_(request->run_options, batch.feed_names, request->feeds, batch.output_names,
+                                &request->fetches);
+    }
+  }
+
+  // the requests run fine on their own, so it is the batching that fails and it would fail for every batch of
+  // these inputs. A failure of one of the requests says nothing about the others and does not disable batching.
+  if (!status.IsOK() &&
+      std::all_of(requests.cbegin(), requests.cend(), [](const Request* request) { return request->status.IsOK(); })) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (unbatchable_inputs_.insert(batch.inputs_key).second) {
+      LOGS(logger_, WARNING) << "Dynamic batching is disabled for the inputs " << batch.inputs_key
+                             << " as the model can not be run on a batch of them: " << status.ErrorMessage();
+    }
+  }
+
+  if (profiler_.IsEnabled()) {
+    profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "dynamic_batch", tp,
+                                    {{"num_requests", std::to_string(batch.requests.size())},
+                                     {"batch_size", std::to_string(batch.batch_size)}});
+  }
+}
+
+Status DynamicBatcher::RunBatched(const Batch& batch, gsl::span<Request* const> requests) {
+  const size_t batch_dim = options_.batch_dim;
+
+  int64_t batch_size = 0;
+  for (const Request* request : requests) {
+    batch_size += request->batch_size;
+  }
+
+  const size_t num_feeds = batch.feed_names.size();
+  std::vector<OrtValue> batch_feeds(num_feeds);
+  std::vector<const Tensor*> feed_tensors(requests.size());
+
+  for (size_t i = 0; i < num_feeds; ++i) {
+    for (size_t r = 0; r < requests.size(); ++r) {
+      feed_tensors[r] = &requests[r]->feeds[i].Get<Tensor>();
+    }
+
+    TensorShape shape = feed_tensors[0]->Shape();
+    shape[batch_dim] = batch_size;
+    Tensor::InitOrtValue(feed_tensors[0]->DataType(), shape, cpu_allocator_, batch_feeds[i]);
+    Concatenate(feed_tensors, *batch_feeds[i].GetMutable<Tensor>(), batch_dim);
+  }
+
+  // the requests of a batch share their run tag and log levels and their callers are blocked, so the options of any
+  // of them can be used for the run
+  std::vector<OrtValue> batch_fetches;
+  ORT_RETURN_IF_ERROR(run_fn_(requests[0]->run_options, batch.feed_names, batch_feeds, batch.output_names,
+                              &batch_fetches));
+
+  const size_t num_fetches = batch.output_names.size();
+  for (size_t j = 0; j < num_fetches; ++j) {
+    ORT_RETURN_IF_NOT(IsBatchableTensor(batch_fetches[j], batch_dim) &&
+                          batch_fetches[j].Get<Tensor>().Shape()[batch_dim] == batch_size,
+                      "Output ", batch.output_names[j], " can not be split along the batch dimension.");
+  }
+
+  std::vector<std::vector<OrtValue>> request_fetches(requests.size(), std::vector<OrtValue>(num_fetches));
+  std::vector<Tensor*> fetch_tensors(requests.size());
+
+  for (size_t j = 0; j < num_fetches; ++j) {
+    const Tensor& batch_fetch = batch_fetches[j].Get<Tensor>();
+
+    for (size_t r = 0; r < requests.size(); ++r) {
+      TensorShape shape = batch_fetch.Shape();
+      shape[batch_dim] = requests[r]->batch_size;
+      Tensor::InitOrtValue(batch_fetch.DataType(), shape, cpu_allocator_, request_fetches[r][j]);
+      fetch_tensors[r] = request_fetches[r][j].GetMutable<Tensor>();
+    }
+
+    Split(batch_fetch, fetch_tensors, batch_dim);
+  }
+
+  for (size_t r = 0; r < requests.size(); ++r) {
+    requests[r]->fetches = std::move(request_fetches[r]);
+  }
+
+  return Status::OK();
+}
+
+DynamicBatchingStats DynamicBatcher::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+struct DynamicBatchingOptions {
+  // the largest batch, in rows of the batch dimension, that concurrent requests are coalesced into
+  int64_t max_batch_size = 0;
+
+  // the longest time the first request of a batch waits for more requests
+  std::chrono::microseconds max_wait{1000};
+
+  // the dimension along which the inputs are concatenated and the outputs are split
+  size_t batch_dim = 0;
+};
+
+struct DynamicBatchingStats {
+  uint64_t num_requests = 0;           // the number of requests that went through the batcher
+  uint64_t num_batches = 0;            // the number of runs of the model the requests were coalesced into
+  uint64_t num_batched_rows = 0;       // the total size of the batch dimension over all runs
+  uint64_t num_unbatched_runs = 0;     // the number of requests run on their own after a batched run failed
+  uint64_t num_bypassed_requests = 0;  // the number of requests not queued as their inputs failed to batch before
+  uint64_t total_queue_delay_us = 0;   // the sum of the times the requests waited for their batch to start
+  uint64_t max_queue_delay_us = 0;
+
+  double AverageBatchSize() const {
+    return num_batches == 0 ? 0.0 : static_cast<double>(num_requests) / static_cast<double>(num_batches);
+  }
+
+  double AverageQueueDelayUs() const {
+    return num_requests == 0 ? 0.0 : static_cast<double>(total_queue_delay_us) / static_cast<double>(num_requests);
+  }
+};
+
+/**
+ * Coalesces concurrent Run calls whose inputs match except along the batch dimension into a single run of the model.
+ *
+ * The first request of a batch becomes its leader. It waits until the batch is full or the wait time elapses, then
+ * concatenates the inputs, runs the model on the calling thread and splits the outputs back to the other requests,
+ * which block until their outputs are ready. No threads are created.
+ *
+ * A request is only batched when all of its inputs are CPU tensors of fixed size elements with the same size along
+ * the batch dimension and its outputs are not pre-allocated. Only requests with the same run tag and log levels are
+ * batched together, as the batch is run with the options of one of them. Run reports any other request as not
+ * handled and the caller runs it as usual.
+ *
+ * When a batched run fails or an output can not be split along the batch dimension, each request of the batch is
+ * run on its own so that every caller receives the status of its own inputs. If all of them succeed, the model can
+ * not be batched for those inputs, e.g. because of a fixed batch dimension, and later requests with the same input
+ * names, types and shapes are reported as not handled without being queued.
+ */
+class DynamicBatcher {
+ public:
+  using RunFn = std::function<Status(const RunOptions& run_options,
+                                     gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                     gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches)>;
+
+  DynamicBatcher(const DynamicBatchingOptions& options, AllocatorPtr cpu_allocator, RunFn run_fn,
+                 profiling::Profiler& profiler, const logging::Logger& logger);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DynamicBatcher);
+
+  /**
+   * Runs the request as part of a batch.
+   * @param handled Set to false if the request is not eligible for batching, in which case nothing was run.
+   * @return The status of the run of this request when handled is true.
+   */
+  Status Run(const RunOptions& run_options,
+             gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches, bool& handled);
+
+  DynamicBatchingStats GetStats() const;
+
+ private:
+  struct Request;
+  struct Batch;
+
+  // Returns the size of the batch dimension of the request, or 0 if it is not eligible for batching.
+  int64_t GetBatchSize(gsl::span<const OrtValue> feeds, const std::vector<OrtValue>& fetches) const;
+
+  // Returns a key identifying the input names, types and shapes except the batch dimension, and the output names.
+  std::string GetInputsKey(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                           gsl::span<const std::string> output_names) const;
+
+  void ExecuteBatch(const Batch& batch);
+
+  Status RunBatched(const Batch& batch, gsl::span<Request* const> requests);
+
+  const DynamicBatchingOptions options_;
+  const AllocatorPtr cpu_allocator_;
+  const RunFn run_fn_;
+  profiling::Profiler& profiler_;
+  const logging::Logger& logger_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> open_batches_;  // GUARDED_BY(mutex_)
+  std::unordered_set<std::string> unbatchable_inputs_;                    // GUARDED_BY(mutex_), by inputs key
+  DynamicBatchingStats stats_;                                            // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
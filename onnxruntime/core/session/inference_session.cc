@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -28,6 +29,7 @@
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -37,6 +39,7 @@
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
@@ -60,6 +63,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
+#include "core/session/run_async_executor.h"
 #include "core/util/protobuf_parsing_utils.h"
 #include "core/util/thread_utils.h"
 
@@ -169,6 +173,68 @@ Status GetMinimalBuildOptimizationHandling(
 
 }  // namespace
 
+// The fingerprint of everything besides the model that determines the contents of the files persisted across sessions,
+// i.e. the pre-packed weights and the session snapshot: the ONNX Runtime version and the build flags that change the
+// graph, the kernels or the execution plan, the CPU features MLAS selects its kernels and packing formats by, and the
+// session options, which include the kernel settings such as the fastmath and sparse GEMM modes.
+static uint64_t GetSessionOptionsFingerprint(const SessionOptions& session_options) {
+  static constexpr const char* kBuildFlags = ""
+#ifdef ENABLE_TRAINING
+                                             "training,"
+#endif
+#ifdef ENABLE_TRAINING_OPS
+                                             "training_ops,"
+#endif
+#ifdef ORT_ENABLE_STREAM
+                                             "stream,"
+#endif
+#ifdef ENABLE_STRIDED_TENSORS
+                                             "strided_tensors,"
+#endif
+#ifdef DISABLE_CONTRIB_OPS
+                                             "no_contrib_ops,"
+#endif
+#ifdef DISABLE_ML_OPS
+                                             "no_ml_ops,"
+#endif
+#ifdef DISABLE_SPARSE_TENSORS
+                                             "no_sparse_tensors,"
+#endif
+#ifdef DISABLE_OPTIONAL_TYPE
+                                             "no_optional_type,"
+#endif
+#ifdef DISABLE_FLOAT8_TYPES
+                                             "no_float8_types,"
+#endif
+                                             "";
+
+  std::ostringstream ss;
+  ss << ORT_VERSION << '|' << kBuildFlags << '|' << MlasGetPlatformId() << '|'
+     << static_cast<int>(session_options.graph_optimization_level) << '|'
+     << static_cast<int>(session_options.execution_mode) << '|' << static_cast<int>(session_options.execution_order)
+     << '|' << session_options.enable_mem_reuse;
+
+  for (const auto& free_dimension_override : session_options.free_dimension_overrides) {
+    ss << '|' << free_dimension_override.dim_identifier << ':'
+       << static_cast<int>(free_dimension_override.dim_identifer_type) << '=' << free_dimension_override.dim_value;
+  }
+
+  std::vector<std::pair<std::string, std::string>> configurations(
+      session_options.config_options.configurations.begin(), session_options.config_options.configurations.end());
+  std::sort(configurations.begin(), configurations.end());
+  for (const auto& [key, value] : configurations) {
+    // the files themselves do not affect their contents
+    if (key != kOrtSessionOptionsConfigPrepackedWeightsCacheFile && key != kOrtSessionOptionsConfigSessionSnapshotFile) {
+      ss << '|' << key << '=' << value;
+    }
+  }
+
+  const std::string fingerprint_source = ss.str();
+  uint64_t hash[2] = {0, 0};
+  MurmurHash3::x86_128(fingerprint_source.data(), gsl::narrow_cast<int>(fingerprint_source.size()), 0, hash);
+  return hash[0];
+}
+
 std::atomic<uint32_t> InferenceSession::global_session_id_{1};
 
 static Status FinalizeSessionOptions(const SessionOptions& user_provided_session_options,
@@ -442,6 +508,18 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // complete the queued RunAsync calls while the session state they use is alive
+  run_async_executor_.reset();
+
+  if (dynamic_batcher_) {
+    const auto stats = dynamic_batcher_->GetStats();
+    LOGS(*session_logger_, INFO) << "Dynamic batching coalesced " << stats.num_requests << " requests into "
+                                 << stats.num_batches << " runs, average batch size "
+                                 << stats.AverageBatchSize() << " requests, average queue delay "
+                                 << stats.AverageQueueDelayUs() << "us, maximum queue delay "
+                                 << stats.max_queue_delay_us << "us";
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -601,7 +679,9 @@ common::Status InferenceSession::RegisterGraphTransformer(
                           "Graph transformers must be registered before the session is initialized.");
   }
 
-  return graph_transformer_mgr_.Register(std::move(p_graph_transformer), level);
+  ORT_RETURN_IF_ERROR(graph_transformer_mgr_.Register(std::move(p_graph_transformer), level));
+  has_registered_graph_transformers_ = true;
+  return Status::OK();
 }
 
 common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) const {
@@ -614,6 +694,21 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   size_t fbs_buffer_size = std::max(m_bytes, model_->ToProto().ByteSizeLong());
   fbs_buffer_size = ((fbs_buffer_size + m_bytes - 1) / m_bytes) * m_bytes;
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
+  ORT_RETURN_IF_ERROR(SaveToOrtFormat(builder));
+
+  {
+    std::ofstream file(filepath, std::ios::binary);
+    uint8_t* buf = builder.GetBufferPointer();
+    int size = builder.GetSize();
+    file.write(reinterpret_cast<const char*>(buf), size);
+    ORT_RETURN_IF_NOT(file, "Failed to save ORT format model to file: ", ToUTF8String(filepath));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder) const {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ort format only supports little-endian machines");
 
   auto ort_model_version = builder.CreateString(std::to_string(kOrtModelVersion));
   flatbuffers::Offset<fbs::Model> fbs_model;
@@ -639,14 +734,6 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
-  {
-    std::ofstream file(filepath, std::ios::binary);
-    uint8_t* buf = builder.GetBufferPointer();
-    int size = builder.GetSize();
-    file.write(reinterpret_cast<const char*>(buf), size);
-    ORT_RETURN_IF_NOT(file, "Failed to save ORT format model to file: ", ToUTF8String(filepath));
-  }
-
   return Status::OK();
 }
 
@@ -722,6 +809,46 @@ common::Status InferenceSession::LoadOnnxModel(const PathString& model_uri) {
   return Status::OK();
 }
 
+common::Status InferenceSession::LoadWithSessionSnapshot(const PathString& model_uri,
+                                                         const PathString& snapshot_file) {
+  uint64_t model_hash = 0;
+  const Status hash_status = SessionSnapshot::HashModelFile(model_uri, model_hash);
+  if (!hash_status.IsOK()) {
+    // let the regular load report the problem with the file
+    LOGS(*session_logger_, WARNING) << "Not using a session snapshot: " << hash_status.ErrorMessage();
+    return LoadOnnxModel(model_uri);
+  }
+
+  session_snapshot_model_hash_ = model_hash;
+  session_snapshot_ = SessionSnapshot::Load(snapshot_file, GetSessionOptionsFingerprint(session_options_), model_hash,
+                                            *session_logger_);
+  if (session_snapshot_ != nullptr) {
+    const Status status = LoadOrtModelWithLoader([&]() {
+      model_location_ = model_uri;
+      ort_format_model_bytes_ = session_snapshot_->GetOrtFormatModel();
+      return Status::OK();
+    });
+    if (status.IsOK()) {
+      return Status::OK();
+    }
+
+    LOGS(*session_logger_, WARNING) << "Failed to load the model from the session snapshot "
+                                    << ToUTF8String(snapshot_file) << ": " << status.ErrorMessage();
+    DiscardSessionSnapshot();
+  }
+
+  return LoadOnnxModel(model_uri);
+}
+
+void InferenceSession::DiscardSessionSnapshot() {
+  model_.reset();
+  is_model_loaded_ = false;
+  ort_format_model_bytes_ = gsl::span<const uint8_t>();
+  using_ort_model_bytes_for_initializers_ = false;
+  kernel_registry_manager_.ResetKernelTypeStrResolver();
+  session_snapshot_.reset();
+}
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -747,6 +874,12 @@ common::Status InferenceSession::Load(const PathString& model_uri) {
                            "Invoke Load().");
   }
 
+  const std::string session_snapshot_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSessionSnapshotFile, "");
+  if (!session_snapshot_file.empty()) {
+    return LoadWithSessionSnapshot(model_uri, ToPathString(session_snapshot_file));
+  }
+
   return LoadOnnxModel(model_uri);
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
@@ -1262,6 +1395,32 @@ common::Status InferenceSession::AddPrePackedWeightsContainer(PrepackedWeightsCo
 }
 
 namespace {
+#if !defined(ORT_MINIMAL_BUILD)
+// Whether the graph can be restored from the ORT format, i.e. it has no compiled nodes and the initializers are in the
+// model, so the session snapshot does not depend on the state of the execution providers or other files.
+bool CanCreateSessionSnapshot(const Graph& graph) {
+  for (const auto& [name, initializer] : graph.GetAllInitializedTensors()) {
+    if (utils::HasExternalData(*initializer)) {
+      return false;
+    }
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.NodeType() == Node::Type::Fused) {
+      return false;
+    }
+
+    for (const gsl::not_null<const Graph*>& subgraph : node.GetSubgraphs()) {
+      if (!CanCreateSessionSnapshot(*subgraph)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
                                const ExecutionProviders& providers,
                                KernelRegistryManager& kernel_registry_manager,
@@ -1351,6 +1510,33 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // The model was loaded from the session snapshot before the execution providers were registered and the optimizers
+    // were configured. Load the model file instead if the snapshot does not apply to this session.
+    if (session_snapshot_ != nullptr) {
+      std::vector<std::string> provider_types = execution_providers_.GetIds();
+      if (!have_cpu_ep) {
+        provider_types.push_back(onnxruntime::kCpuExecutionProvider);
+      }
+
+      if (!session_snapshot_->MatchesExecutionProviders(provider_types) || !optimizers_to_disable_.empty() ||
+          has_registered_graph_transformers_) {
+        LOGS(*session_logger_, INFO) << "The session snapshot was created with different execution providers or graph "
+                                        "transformers. Loading the model from "
+                                     << ToUTF8String(model_location_);
+        const PathString model_uri = model_location_;
+        {
+          std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+          DiscardSessionSnapshot();
+        }
+        ORT_RETURN_IF_ERROR_SESSIONID_(LoadOnnxModel(model_uri));
+      }
+    }
+
+    const bool loading_session_snapshot = session_snapshot_ != nullptr;
+    initialized_from_session_snapshot_ = loading_session_snapshot;
+#endif
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
@@ -1431,6 +1617,10 @@ common::Status InferenceSession::Initialize() {
         session_options_,
         prepacked_weights_container_);
 
+#if !defined(ORT_MINIMAL_BUILD)
+    session_state_->SetSessionSnapshot(session_snapshot_.get());
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     // Don't want to pollute SessionState constructor since memory profile is enabled optionally.
     session_state_->SetMemoryProfiler(&memory_profiler_);
@@ -1563,19 +1753,83 @@ common::Status InferenceSession::Initialize() {
                                                              *session_state_));
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
-      const auto& cpu_ep = *execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
-      ORT_RETURN_IF_ERROR_SESSIONID_(
-          ApplyOrtFormatModelRuntimeOptimizations(graph, *session_logger_, session_options_, optimizers_to_disable_,
-                                                  cpu_ep));
+#if !defined(ORT_MINIMAL_BUILD)
+      // the graph of a session snapshot has been optimized with the same options already
+      if (!loading_session_snapshot)
+#endif
+      {
+        const auto& cpu_ep = *execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
+        ORT_RETURN_IF_ERROR_SESSIONID_(
+            ApplyOrtFormatModelRuntimeOptimizations(graph, *session_logger_, session_options_, optimizers_to_disable_,
+                                                    cpu_ep));
+      }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // Serialize the graph for a new session snapshot before FinalizeSessionState() removes the initializers.
+    const std::string session_snapshot_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSessionSnapshotFile, "");
+    std::optional<flatbuffers::FlatBufferBuilder> session_snapshot_builder;
+    if (!session_snapshot_file.empty() && !loading_session_snapshot && session_snapshot_model_hash_.has_value() &&
+        !saving_ort_format && optimizers_to_disable_.empty() && !has_registered_graph_transformers_ &&
+        !kernel_registry_manager_.HasCustomKernelRegistries() && CanCreateSessionSnapshot(graph)) {
+      session_snapshot_builder.emplace();
+      const Status snapshot_status = SaveToOrtFormat(*session_snapshot_builder);
+      if (!snapshot_status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Not creating a session snapshot: " << snapshot_status.ErrorMessage();
+        session_snapshot_builder.reset();
+      }
+    }
+#endif
+
+    const std::string prepacked_weights_cache_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheFile, "");
+    if (!prepacked_weights_cache_file.empty()) {
+      prepacked_weights_file_cache_ = std::make_unique<PrepackedWeightsFileCache>(
+          ToPathString(prepacked_weights_cache_file), GetSessionOptionsFingerprint(session_options_),
+          *session_logger_);
+      session_state_->SetPrepackedWeightsFileCache(prepacked_weights_file_cache_.get());
+    }
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
                                              !saving_model,
                                              saving_ort_format));
 
+    if (prepacked_weights_file_cache_ != nullptr) {
+      LOGS(*session_logger_, INFO) << "Restored " << session_state_->GetRestoredPrePackedWeightCounter()
+                                   << " pre-packed weights from " << prepacked_weights_cache_file << ", packed "
+                                   << prepacked_weights_file_cache_->GetNumberOfAddedWeights();
+
+      // failing to persist the weights only costs the next session the time to pack them
+      const Status status = prepacked_weights_file_cache_->Save();
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to save the pre-packed weights: " << status.ErrorMessage();
+      }
+    }
+
+#if !defined(ORT_MINIMAL_BUILD)
+    if (loading_session_snapshot) {
+      LOGS(*session_logger_, INFO) << "Restored " << session_state_->GetRestoredKernelCreateInfoCounter()
+                                   << " kernels " << (session_state_->IsExecutionPlanRestored() ? "and" : "but not")
+                                   << " the execution plan from the session snapshot " << session_snapshot_file;
+    }
+
+    if (session_snapshot_builder.has_value()) {
+      // failing to persist the snapshot only costs the next session the time to initialize from the model file
+      const Status status = SessionSnapshot::Save(
+          ToPathString(session_snapshot_file), GetSessionOptionsFingerprint(session_options_),
+          *session_snapshot_model_hash_,
+          gsl::make_span(session_snapshot_builder->GetBufferPointer(), session_snapshot_builder->GetSize()),
+          execution_providers_.GetIds(), kernel_registry_manager_, *session_state_);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to save the session snapshot: " << status.ErrorMessage();
+      }
+    }
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
@@ -1613,11 +1867,17 @@ common::Status InferenceSession::Initialize() {
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreateDynamicBatcher());
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+#if !defined(ORT_MINIMAL_BUILD)
+      session_state_->SetSessionSnapshot(nullptr);
+      session_snapshot_.reset();
+#endif
     }
 
     // once the model is saved, we may remove unnecessary attributes for inference
@@ -1984,6 +2244,21 @@ Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  if (dynamic_batcher_ && p_fetches != nullptr && p_fetches_device_info == nullptr) {
+    bool handled = false;
+    auto status = dynamic_batcher_->Run(run_options, feed_names, feeds, output_names, *p_fetches, handled);
+    if (handled) {
+      return status;
+    }
+  }
+
+  return RunUnbatched(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+}
+
+Status InferenceSession::RunUnbatched(const RunOptions& run_options,
+                                      gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                      gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                      const std::vector<OrtDevice>* p_fetches_device_info) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2154,7 +2429,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
     LOGS(*session_logger_, INFO) << "Start the second Run() to capture the graph. "
                                     "The first one is for necessary memory allocation;"
                                     "The second one is for capturing the graph.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunUnbatched(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
   }
   return retval;
 }
@@ -2181,6 +2456,113 @@ common::Status InferenceSession::Run(const RunOptions& run_options, const NameML
   return Run(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options, gsl::span<const char* const> feed_names,
+                                          gsl::span<const OrtValue* const> feeds,
+                                          gsl::span<const char* const> fetch_names, gsl::span<OrtValue*> fetches,
+                                          RunAsyncCallbackFn callback, void* user_data) {
+  ORT_RETURN_IF(callback == nullptr, "RunAsync requires a callback.");
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "The number of feed names ", feed_names.size(),
+                    " does not match the number of feeds ", feeds.size());
+  ORT_RETURN_IF_NOT(fetch_names.size() == fetches.size(), "The number of fetch names ", fetch_names.size(),
+                    " does not match the number of fetches ", fetches.size());
+
+  // The names and the values are copied so that the caller may release them, the values share their buffers.
+  std::vector<std::string> feed_name_strings;
+  std::vector<OrtValue> feed_values;
+  feed_name_strings.reserve(feeds.size());
+  feed_values.reserve(feeds.size());
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF(feed_names[i] == nullptr || feed_names[i][0] == '\0', "input name cannot be empty");
+    ORT_RETURN_IF(feeds[i] == nullptr, "NULL input supplied for input ", feed_names[i]);
+    feed_name_strings.emplace_back(feed_names[i]);
+    feed_values.emplace_back(*feeds[i]);
+  }
+
+  std::vector<std::string> fetch_name_strings;
+  std::vector<OrtValue> fetch_values;
+  fetch_name_strings.reserve(fetches.size());
+  fetch_values.reserve(fetches.size());
+  for (size_t i = 0; i < fetches.size(); ++i) {
+    ORT_RETURN_IF(fetch_names[i] == nullptr || fetch_names[i][0] == '\0', "output name cannot be empty");
+    fetch_name_strings.emplace_back(fetch_names[i]);
+    fetch_values.emplace_back(fetches[i] != nullptr ? *fetches[i] : OrtValue());
+  }
+
+  RunAsyncExecutor* executor;
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+
+    if (!run_async_executor_) {
+      const std::string num_threads_str = session_options_.config_options.GetConfigOrDefault(
+          kOrtSessionOptionsConfigRunAsyncNumThreads, "0");
+      int num_threads = 0;
+      if (!TryParseStringWithClassicLocale(num_threads_str, num_threads) || num_threads < 0) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ",
+                               kOrtSessionOptionsConfigRunAsyncNumThreads, ": '", num_threads_str,
+                               "'. It must be a non-negative integer.");
+      }
+      if (num_threads == 0) {
+        num_threads = Env::Default().GetNumPhysicalCpuCores();
+      }
+
+      std::basic_stringstream<ORTCHAR_T> ss;
+      ss << ORT_TSTR("session-") << session_id_ << ORT_TSTR("-run-async");
+      run_async_executor_name_ = ss.str();
+
+      ThreadOptions thread_options;
+      thread_options.set_denormal_as_zero =
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSetDenormalAsZero, "0") == "1";
+      thread_options.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+      thread_options.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+      thread_options.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+
+      LOGS(*session_logger_, INFO) << "Creating the RunAsync executor with " << num_threads << " threads";
+      run_async_executor_ = std::make_unique<RunAsyncExecutor>(Env::Default(), run_async_executor_name_.c_str(),
+                                                               num_threads, thread_options);
+    }
+
+    executor = run_async_executor_.get();
+  }
+
+  executor->Schedule([this, run_options, fetches, callback, user_data,
+                      feed_name_strings = std::move(feed_name_strings), feed_values = std::move(feed_values),
+                      fetch_name_strings = std::move(fetch_name_strings),
+                      fetch_values = std::move(fetch_values)]() mutable {
+    Status status;
+    ORT_TRY {
+      if (run_options == nullptr) {
+        status = Run(RunOptions(), feed_name_strings, feed_values, fetch_name_strings, &fetch_values, nullptr);
+      } else if (run_options->terminate) {
+        // the run was canceled while it was queued
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      } else {
+        status = Run(*run_options, feed_name_strings, feed_values, fetch_name_strings, &fetch_values, nullptr);
+      }
+
+      if (status.IsOK()) {
+        for (size_t i = 0; i < fetches.size(); ++i) {
+          if (fetches[i] == nullptr) {
+            fetches[i] = new OrtValue(std::move(fetch_values[i]));
+          }
+        }
+      }
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    callback(user_data, fetches.data(), fetches.size(), ToOrtStatus(status));
+  });
+
+  return Status::OK();
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   {
     std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -2351,6 +2733,52 @@ AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const
   return session_state_->GetAllocator(mem_info);
 }
 
+common::Status InferenceSession::CreateDynamicBatcher() {
+  const auto& config_options = session_options_.config_options;
+
+  DynamicBatchingOptions options;
+  int64_t max_wait_us = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(
+                        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "0"),
+                        options.max_batch_size) &&
+                        TryParseStringWithClassicLocale(
+                            config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs, "1000"),
+                            max_wait_us) &&
+                        TryParseStringWithClassicLocale(
+                            config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingBatchDim, "0"),
+                            options.batch_dim),
+                    "Invalid dynamic batching session options.");
+  ORT_RETURN_IF(max_wait_us < 0, "The maximum wait time of dynamic batching cannot be negative: ", max_wait_us);
+  options.max_wait = std::chrono::microseconds(max_wait_us);
+
+  if (options.max_batch_size <= 1) {
+    return Status::OK();
+  }
+
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    LOGS(*session_logger_, WARNING) << "Dynamic batching is disabled because the captured graph requires the input "
+                                       "shapes of every run to be the same.";
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Dynamic batching of up to " << options.max_batch_size << " rows along dimension "
+                               << options.batch_dim << " with a maximum wait of " << max_wait_us << "us";
+
+  auto run_fn = [this](const RunOptions& run_options,
+                       gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                       gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches) {
+    return RunUnbatched(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
+  };
+
+  dynamic_batcher_ = std::make_unique<DynamicBatcher>(options, session_state_->GetAllocator(OrtDevice()),
+                                                      std::move(run_fn), session_profiler_, *session_logger_);
+  return Status::OK();
+}
+
+DynamicBatchingStats InferenceSession::GetDynamicBatchingStats() const {
+  return dynamic_batcher_ ? dynamic_batcher_->GetStats() : DynamicBatchingStats{};
+}
+
 common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::string& ort_device_list,
                                                                    /*out*/ InlinedVector<AllocatorPtr>& arenas_to_shrink) const {
   arenas_to_shrink.reserve(5);  // Allocate some memory for the container (we are unlikely to see more than 5 memory arena shrink requests)
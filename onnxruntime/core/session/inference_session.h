@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -25,6 +26,7 @@
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
 #include "core/framework/session_options.h"
+#include "core/session/dynamic_batcher.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -44,6 +46,7 @@ class GraphTransformer;
 class IExecutionProvider;
 class IOBinding;
 struct Notification;
+class RunAsyncExecutor;
 
 #ifdef ENABLE_TRAINING
 struct PartialGraphExecutionState;
@@ -327,6 +330,27 @@ class InferenceSession {
                                    gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches);
 
+  /**
+   * Queue a run of a pre-loaded and pre-initialized model and return without waiting for it.
+   * The run executes on threads owned by the session, separate from the intra-op thread pool. The number of
+   * threads is set by the kOrtSessionOptionsConfigRunAsyncNumThreads session config entry.
+   * @param run_options optional run options. They must stay valid until the callback is invoked, setting their
+   *        terminate flag cancels the run, including a run that has not started yet.
+   * @param feed_names names of the inputs, copied before returning.
+   * @param feeds input values, which are referenced by the run so the caller may release them after returning.
+   * @param fetch_names names of the outputs, copied before returning.
+   * @param fetches output values. A nullptr entry is replaced by a value allocated by the run, which the caller
+   *        owns. The span must stay valid until the callback is invoked.
+   * @param callback invoked on an executor thread once the run completes, with the fetches and an OrtStatus that
+   *        the callback owns and that is nullptr on success.
+   * @param user_data passed to the callback.
+   * @return OK if the run was queued. The callback is not invoked otherwise.
+   */
+  [[nodiscard]] common::Status RunAsync(const RunOptions* run_options, gsl::span<const char* const> feed_names,
+                                        gsl::span<const OrtValue* const> feeds,
+                                        gsl::span<const char* const> fetch_names, gsl::span<OrtValue*> fetches,
+                                        RunAsyncCallbackFn callback, void* user_data);
+
   /**
    * Creates a new binding object for binding inputs and outputs.
    * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -481,11 +505,23 @@ class InferenceSession {
    */
   const logging::Logger* GetLogger() const { return session_logger_; };
 
+  /**
+   * Get the metrics of the dynamic batching of concurrent Run calls.
+   * @return The metrics, which are all zero if dynamic batching is not enabled in the session options.
+   */
+  DynamicBatchingStats GetDynamicBatchingStats() const;
+
   const SessionState& GetSessionState() const {
     ORT_ENFORCE(session_state_ != nullptr, "Session must be initialized to create session state.");
     return *session_state_;
   }
 
+  /**
+   * Whether the graph of the session was loaded from the session snapshot (kOrtSessionOptionsConfigSessionSnapshotFile)
+   * rather than optimized and partitioned from the model file.
+   */
+  bool IsInitializedFromSessionSnapshot() const { return initialized_from_session_snapshot_; }
+
   /**
    * Add a PrepackedWeightsContainer instance to the session so as to store the pre-packed weights
    *  of shared initializers to be shared across sessions.
@@ -582,6 +618,15 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const PathString& filepath) const;
+
+  // Serializes the session in ORT format into the builder and finishes the buffer.
+  common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder) const;
+
+  // Loads the model from the session snapshot of the model file if there is a valid one, or else from the file.
+  [[nodiscard]] common::Status LoadWithSessionSnapshot(const PathString& model_uri, const PathString& snapshot_file);
+
+  // Drops the model loaded from the session snapshot, so the model file can be loaded instead.
+  void DiscardSessionSnapshot();
 #endif
 
   /**
@@ -613,6 +658,15 @@ class InferenceSession {
 
   void InitLogger(logging::LoggingManager* logging_manager);
 
+  // Runs the model for the request of a single caller, which Run hands to the dynamic batcher first if enabled.
+  [[nodiscard]] common::Status RunUnbatched(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                            gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                            std::vector<OrtValue>* p_fetches,
+                                            const std::vector<OrtDevice>* p_fetches_device_info);
+
+  // Creates the dynamic batcher if it is enabled in the session options.
+  [[nodiscard]] common::Status CreateDynamicBatcher();
+
   [[nodiscard]] common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                                            const TensorShape& expected_shape) const;
 
@@ -657,6 +711,10 @@ class InferenceSession {
 
   onnxruntime::GraphTransformerManager graph_transformer_mgr_;
 
+  // Whether graph transformers were registered with RegisterGraphTransformer(), which session snapshots can not
+  // account for.
+  bool has_registered_graph_transformers_{false};
+
   InlinedHashSet<gsl::not_null<const ONNX_NAMESPACE::OpSchema*>> saved_runtime_optimization_produced_node_op_schemas_;
 #endif
   // Any GraphTransformer/RewriteRule name in this set will not be enabled.
@@ -680,6 +738,23 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
+  // File of pre-packed weights persisted across sessions (kOrtSessionOptionsConfigPrepackedWeightsCacheFile).
+  // It must be declared *before* session_state_ as the kernels use the pre-packed weights it holds.
+  std::unique_ptr<PrepackedWeightsFileCache> prepacked_weights_file_cache_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Snapshot the model was loaded from (kOrtSessionOptionsConfigSessionSnapshotFile). Released at the end of
+  // Initialize() unless the initializers use the ORT format bytes in the mapped file, in which case it must be
+  // declared *before* session_state_ to outlive the initializers.
+  std::unique_ptr<SessionSnapshot> session_snapshot_;
+
+  // Content hash of the model file. Set if the model was loaded from a file with a session snapshot file configured.
+  std::optional<uint64_t> session_snapshot_model_hash_;
+#endif
+
+  // Whether Initialize() used the graph from the session snapshot
+  bool initialized_from_session_snapshot_ = false;
+
   // Immutable state for each op in the model. Shared by all executors.
   // It has a dependency on execution_providers_.
   std::unique_ptr<SessionState> session_state_;
@@ -698,6 +773,13 @@ class InferenceSession {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
+  // Executes the RunAsync calls. Created by the first RunAsync call.
+  std::basic_string<ORTCHAR_T> run_async_executor_name_;
+  std::unique_ptr<RunAsyncExecutor> run_async_executor_;  // GUARDED_BY(session_mutex_)
+
+  // Coalesces concurrent Run calls. Created by Initialize if dynamic batching is enabled.
+  std::unique_ptr<DynamicBatcher> dynamic_batcher_;
+
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
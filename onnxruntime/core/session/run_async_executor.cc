@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/run_async_executor.h"
+
+#include "core/common/denormal.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The executor and the index of the current thread when it is one of the executor threads.
+struct RunAsyncWorkerIdentity {
+  const RunAsyncExecutor* executor = nullptr;
+  int id = -1;
+};
+
+thread_local RunAsyncWorkerIdentity run_async_worker_identity;
+
+}  // namespace
+
+RunAsyncExecutor::RunAsyncExecutor(Env& env, const ORTCHAR_T* name, int num_threads,
+                                   const ThreadOptions& thread_options)
+    : set_denormal_as_zero_(thread_options.set_denormal_as_zero) {
+  ORT_ENFORCE(num_threads > 0, "The RunAsync executor requires at least one thread.");
+
+  threads_.reserve(num_threads);
+  ORT_TRY {
+    for (int i = 0; i < num_threads; ++i) {
+      threads_.emplace_back(env.CreateThread(name, i, WorkerLoop, this, thread_options));
+    }
+  }
+  ORT_CATCH(...) {
+    // the destructor does not run for a partially constructed executor
+    Shutdown();
+    ORT_RETHROW;
+  }
+}
+
+RunAsyncExecutor::~RunAsyncExecutor() {
+  Shutdown();
+}
+
+void RunAsyncExecutor::Shutdown() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    done_ = true;
+  }
+  work_available_.notify_all();
+
+  // The EnvThread destructors join the threads, which exit once the queue is empty.
+  threads_.clear();
+}
+
+void RunAsyncExecutor::Schedule(std::function<void()> fn) {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    queue_.push_back(std::move(fn));
+  }
+  work_available_.notify_one();
+}
+
+int RunAsyncExecutor::NumThreads() const {
+  return static_cast<int>(threads_.size());
+}
+
+int RunAsyncExecutor::CurrentThreadId() const {
+  return run_async_worker_identity.executor == this ? run_async_worker_identity.id : -1;
+}
+
+unsigned RunAsyncExecutor::WorkerLoop(int id, Eigen::ThreadPoolInterface* param) {
+  auto* executor = static_cast<RunAsyncExecutor*>(param);
+
+  run_async_worker_identity.executor = executor;
+  run_async_worker_identity.id = id;
+
+  SetDenormalAsZero(executor->set_denormal_as_zero_);
+
+  for (;;) {
+    std::function<void()> fn;
+    {
+      std::unique_lock<OrtMutex> lock(executor->mutex_);
+      executor->work_available_.wait(lock, [executor]() { return executor->done_ || !executor->queue_.empty(); });
+      if (executor->queue_.empty()) {
+        break;
+      }
+      fn = std::move(executor->queue_.front());
+      executor->queue_.pop_front();
+    }
+    fn();
+  }
+
+  run_async_worker_identity = RunAsyncWorkerIdentity{};
+  return 0;
+}
+
+}  // namespace onnxruntime
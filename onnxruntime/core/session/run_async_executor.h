@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+#include "unsupported/Eigen/CXX11/ThreadPool"
+
+namespace onnxruntime {
+
+/**
+ * Executes the runs queued by InferenceSession::RunAsync on threads owned by the session. The threads are separate
+ * from the intra-op and inter-op thread pools, which the runs use as a synchronous Run would.
+ *
+ * Unlike the work queues of the thread pools the queue is unbounded, so Schedule never blocks the caller or
+ * executes the work inline. The destructor completes the queued work before joining the threads.
+ */
+class RunAsyncExecutor final : public Eigen::ThreadPoolInterface {
+ public:
+  RunAsyncExecutor(Env& env, const ORTCHAR_T* name, int num_threads, const ThreadOptions& thread_options);
+  ~RunAsyncExecutor() override;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunAsyncExecutor);
+
+  void Schedule(std::function<void()> fn) override;
+
+  int NumThreads() const override;
+
+  int CurrentThreadId() const override;
+
+ private:
+  void Shutdown();
+
+  static unsigned WorkerLoop(int id, Eigen::ThreadPoolInterface* param);
+
+  const bool set_denormal_as_zero_;
+
+  OrtMutex mutex_;
+  OrtCondVar work_available_;
+  std::deque<std::function<void()>> queue_;  // GUARDED_BY(mutex_)
+  bool done_ = false;                        // GUARDED_BY(mutex_)
+
+  std::vector<std::unique_ptr<EnvThread>> threads_;
+};
+
+}  // namespace onnxruntime
@@ -1676,6 +1676,100 @@ TEST(AttentionTest, AttentionUnidirectionalAttentionMask) {
                    AttentionMaskType::MASK_2D_KEY_PADDING);
 }
 
+// The sequence spans several query blocks and key tiles of the CPU kernel, so this covers the online softmax
+// across tiles and the tiles skipped by the unidirectional mask.
+TEST(AttentionTest, AttentionUnidirectionalLongSequence) {
+  int batch_size = 2;
+  int sequence_length = 600;
+  int hidden_size = 64;
+  int number_of_heads = 2;
+  int head_size = hidden_size / number_of_heads;
+
+  std::vector<float> input_data(static_cast<size_t>(batch_size) * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(static_cast<int>((i * 37) % 101) - 50) * 0.02f;
+  }
+
+  std::vector<float> weight_data(static_cast<size_t>(hidden_size) * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(static_cast<int>((i * 53) % 67) - 33) * 0.01f;
+  }
+
+  std::vector<float> bias_data(3 * static_cast<size_t>(hidden_size));
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(static_cast<int>((i * 29) % 11) - 5) * 0.1f;
+  }
+
+  // The second batch has right side padding.
+  std::vector<int32_t> mask_index_data(static_cast<size_t>(batch_size) * sequence_length, 1);
+  std::fill(mask_index_data.begin() + sequence_length + 450, mask_index_data.end(), 0);
+
+  // Reference: softmax(Q x K' / sqrt(H) + mask) x V with a single pass over each row.
+  std::vector<double> qkv(static_cast<size_t>(batch_size) * sequence_length * 3 * hidden_size);
+  for (int i = 0; i < batch_size * sequence_length; i++) {
+    for (int j = 0; j < 3 * hidden_size; j++) {
+      double sum = bias_data[j];
+      for (int k = 0; k < hidden_size; k++) {
+        sum += static_cast<double>(input_data[static_cast<size_t>(i) * hidden_size + k]) *
+               weight_data[static_cast<size_t>(k) * 3 * hidden_size + j];
+      }
+      qkv[static_cast<size_t>(i) * 3 * hidden_size + j] = sum;
+    }
+  }
+
+  std::vector<float> output_data(input_data.size());
+  std::vector<double> scores(sequence_length);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      for (int s = 0; s < sequence_length; s++) {
+        const double* q = &qkv[(static_cast<size_t>(b) * sequence_length + s) * 3 * hidden_size + n * head_size];
+        double max_score = -std::numeric_limits<double>::infinity();
+        for (int t = 0; t <= s; t++) {
+          const double* k = &qkv[(static_cast<size_t>(b) * sequence_length + t) * 3 * hidden_size +
+                                 hidden_size + n * head_size];
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += q[h] * k[h];
+          }
+          score /= std::sqrt(static_cast<double>(head_size));
+          if (mask_index_data[static_cast<size_t>(b) * sequence_length + t] == 0) {
+            score += -10000.0;
+          }
+          scores[t] = score;
+          max_score = std::max(max_score, score);
+        }
+
+        double sum = 0.0;
+        for (int t = 0; t <= s; t++) {
+          scores[t] = std::exp(scores[t] - max_score);
+          sum += scores[t];
+        }
+
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int t = 0; t <= s; t++) {
+            value += scores[t] * qkv[(static_cast<size_t>(b) * sequence_length + t) * 3 * hidden_size +
+                                     2 * hidden_size + n * head_size + h];
+          }
+          output_data[(static_cast<size_t>(b) * sequence_length + s) * hidden_size + n * head_size + h] =
+              static_cast<float>(value / sum);
+        }
+      }
+    }
+  }
+
+  bool use_float16 = false;
+  bool is_unidirectional = true;
+  bool use_past_state = false;
+  int past_sequence_length = 0;
+  const std::vector<float>* past_data = nullptr;
+  const std::vector<float>* present_data = nullptr;
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads,
+                   use_float16, is_unidirectional, use_past_state, past_sequence_length, past_data, present_data,
+                   AttentionMaskType::MASK_2D_KEY_PADDING);
+}
+
 TEST(AttentionTest, AttentionWithNormFactor) {
   int batch_size = 2;
   int sequence_length = 2;
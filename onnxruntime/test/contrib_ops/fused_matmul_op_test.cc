@@ -271,6 +271,61 @@ TEST(FusedMatMulOpTest, FloatTypeTransposeBatch) {
   RunFusedMatMulTest<float>("FusedMatMul", 1, true, true, true, true);
 }
 
+static void RunFusedMatMulActivationTest(const std::string& activation, std::function<float(float)> reference,
+                                         bool is_b_constant, float activation_alpha = 0.0f) {
+  const std::vector<int64_t> a_dims{2, 3, 4};
+  const std::vector<int64_t> b_dims{4, 5};
+  std::vector<float> a_vals(2 * 3 * 4);
+  std::vector<float> b_vals(4 * 5);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+  }
+  for (size_t i = 0; i < b_vals.size(); i++) {
+    b_vals[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  }
+
+  std::vector<float> expected_vals(2 * 3 * 5);
+  for (size_t m = 0; m < 6; m++) {
+    for (size_t n = 0; n < 5; n++) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < 4; k++) {
+        sum += a_vals[m * 4 + k] * b_vals[k * 5 + n];
+      }
+      expected_vals[m * 5 + n] = reference(sum);
+    }
+  }
+
+  OpTester test("FusedMatMulActivation", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", a_dims, a_vals);
+  test.AddInput<float>("B", b_dims, b_vals, is_b_constant);
+  test.AddAttribute("activation", activation);
+  if (activation_alpha != 0.0f) {
+    test.AddAttribute("activation_alpha", activation_alpha);
+  }
+  test.AddOutput<float>("Y", {2, 3, 5}, expected_vals);
+  test.SetOutputAbsErr("Y", 1e-5f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(FusedMatMulOpTest, FloatTypeActivation) {
+  for (bool is_b_constant : {false, true}) {
+    RunFusedMatMulActivationTest(
+        "Relu", [](float x) { return std::max(x, 0.0f); }, is_b_constant);
+    RunFusedMatMulActivationTest(
+        "Gelu", [](float x) { return 0.5f * x * (1.0f + std::erf(x * static_cast<float>(M_SQRT1_2))); },
+        is_b_constant);
+    RunFusedMatMulActivationTest(
+        "FastGelu",
+        [](float x) { return 0.5f * x * (1.0f + std::tanh(0.7978845608028654f * (x + 0.044715f * x * x * x))); },
+        is_b_constant);
+    RunFusedMatMulActivationTest(
+        "QuickGelu", [](float x) { return x / (1.0f + std::exp(-1.5f * x)); }, is_b_constant, 1.5f);
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DML)
 TEST(FusedMatMulOpTest, Float16_NoTranspose) {
 #ifdef USE_CUDA
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas_q4.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void RunMatMulFpQ4Test(MLAS_BLK_QUANT_TYPE qtype,
+                              const std::vector<int64_t>& A_dims,
+                              int64_t K, int64_t N,
+                              bool has_bias) {
+  const size_t packed_b_size = MlasQ4GemmPackBSize(qtype, static_cast<size_t>(N), static_cast<size_t>(K));
+  if (packed_b_size == 0) {
+    return;
+  }
+
+  RandomValueGenerator random{};
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+  std::vector<float> B_data = random.Uniform<float>(std::vector<int64_t>{K, N}, -1.0f, 1.0f);
+  std::vector<float> Bias = random.Uniform<float>(std::vector<int64_t>{N}, -1.0f, 1.0f);
+
+  std::vector<uint8_t> B_packed(packed_b_size);
+  MlasQ4GemmPackB(qtype, B_packed.data(), B_data.data(), static_cast<size_t>(N), static_cast<size_t>(K),
+                  static_cast<size_t>(N));
+
+  // The expected output is computed with the dequantized weights.
+  std::vector<float> B_dequant(static_cast<size_t>(K * N));
+  MlasQ4GemmUnPackB(qtype, B_dequant.data(), B_packed.data(), static_cast<size_t>(N), static_cast<size_t>(K),
+                    static_cast<size_t>(N));
+
+  const int64_t M = static_cast<int64_t>(A_data.size()) / K;
+  std::vector<float> expected(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = has_bias ? Bias[n] : 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += A_data[m * K + k] * B_dequant[k * N + n];
+      }
+      expected[m * N + n] = sum;
+    }
+  }
+
+  std::vector<int64_t> Y_dims(A_dims.begin(), A_dims.end() - 1);
+  Y_dims.push_back(N);
+
+  OpTester test("MatMulFpQ4", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("blk_quant_type", static_cast<int64_t>(qtype));
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<uint8_t>("B", {static_cast<int64_t>(packed_b_size)}, B_packed, true);
+  test.AddInput<int64_t>("B_shape", {2}, {K, N}, true);
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, Bias, true);
+  }
+  test.AddOutput<float>("Y", Y_dims, expected);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run();
+}
+
+TEST(MatMulFpQ4, Sym) {
+  RunMatMulFpQ4Test(BlkQ4Sym, {1, 64}, 64, 32, false);
+  RunMatMulFpQ4Test(BlkQ4Sym, {4, 127}, 127, 77, true);
+}
+
+TEST(MatMulFpQ4, Zp8) {
+  RunMatMulFpQ4Test(BlkQ4Zp8, {1, 64}, 64, 32, false);
+  RunMatMulFpQ4Test(BlkQ4Zp8, {4, 127}, 127, 77, true);
+}
+
+TEST(MatMulFpQ4, Sym64) {
+  RunMatMulFpQ4Test(BlkQ4Sym64, {3, 200}, 200, 16, true);
+}
+
+TEST(MatMulFpQ4, Sym128) {
+  RunMatMulFpQ4Test(BlkQ4Sym128, {3, 300}, 300, 16, false);
+}
+
+TEST(MatMulFpQ4, Batched) {
+  RunMatMulFpQ4Test(BlkQ4Zp8, {2, 3, 5, 96}, 96, 40, true);
+}
+
+TEST(MatMulFpQ4, Vector) {
+  RunMatMulFpQ4Test(BlkQ4Sym, {33}, 33, 10, false);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
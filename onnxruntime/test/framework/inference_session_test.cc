@@ -9,6 +9,7 @@
 #include <functional>
 #include <iterator>
 #include <thread>
+#include <filesystem>
 #include <fstream>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
@@ -2955,5 +2956,514 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
   VerifyThreadPoolWithDenormalAsZero(session2.GetInterOpThreadPoolToUse(), false);
 }
 
+// Creates a model with an input of shape [batch, 2] whose output is either batched along the same dimension or
+// reduced over it. With fixed_batch the batch dimension of the input is 1.
+static void CreateDynamicBatchingModel(std::unique_ptr<onnxruntime::Model>& p_model, bool reduce_over_batch,
+                                       bool fixed_batch = false) {
+  p_model = std::make_unique<Model>("dynamic_batching", false, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                    std::unordered_map<std::string, int>{{kOnnxDomain, 12}},
+                                    std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                    DefaultLoggingManager().DefaultLogger());
+  auto& graph = p_model->MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  if (fixed_batch) {
+    input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  } else {
+    input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  }
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+
+  if (reduce_over_batch) {
+    auto& node = graph.AddNode("reduce", "ReduceSum", "reduce over the batch", {&input_arg}, {&output_arg});
+    node.AddAttribute("axes", std::vector<int64_t>{0});
+  } else {
+    graph.AddNode("add", "Add", "add rows", {&input_arg, &input_arg}, {&output_arg});
+  }
+
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+static void RunDynamicBatchingModel(bool reduce_over_batch) {
+  std::unique_ptr<Model> p_model;
+  CreateDynamicBatchingModel(p_model, reduce_over_batch);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DynamicBatching";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "8"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs, "20000"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  std::string model_data;
+  p_model->ToProto().SerializeToString(&model_data);
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  constexpr int num_threads = 4;
+  constexpr int num_runs = 16;
+  const std::vector<std::string> output_names{"Y"};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int run = 0; run < num_runs; ++run) {
+        // mix requests of one and two rows in a batch
+        const int64_t rows = 1 + (t + run) % 2;
+        std::vector<float> values(static_cast<size_t>(rows * 2));
+        for (size_t i = 0; i < values.size(); ++i) {
+          values[i] = static_cast<float>(t * 100 + run * 4 + i);
+        }
+
+        OrtValue input;
+        CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), {rows, 2}, values, &input);
+        NameMLValMap feeds{{"X", input}};
+
+        std::vector<OrtValue> fetches;
+        auto status = session_object.Run(RunOptions(), feeds, output_names, &fetches);
+        EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+        if (!status.IsOK()) {
+          continue;
+        }
+
+        std::vector<int64_t> expected_dims{rows, 2};
+        std::vector<float> expected_values(values.size());
+        if (reduce_over_batch) {
+          expected_dims[0] = 1;
+          expected_values = {0.0f, 0.0f};
+          for (size_t i = 0; i < values.size(); ++i) {
+            expected_values[i % 2] += values[i];
+          }
+        } else {
+          std::transform(values.cbegin(), values.cend(), expected_values.begin(), [](float v) { return v + v; });
+        }
+
+        ASSERT_EQ(fetches.size(), 1u);
+        const auto& output = fetches[0].Get<Tensor>();
+        EXPECT_EQ(output.Shape(), TensorShape(expected_dims));
+        EXPECT_EQ(std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size()),
+                  expected_values);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = session_object.GetDynamicBatchingStats();
+  EXPECT_EQ(stats.num_requests + stats.num_bypassed_requests, static_cast<uint64_t>(num_threads * num_runs));
+  EXPECT_GE(stats.num_batches, 1u);
+  EXPECT_LE(stats.num_batches, stats.num_requests);
+  EXPECT_GE(stats.AverageBatchSize(), 1.0);
+  EXPECT_LE(stats.AverageQueueDelayUs(), static_cast<double>(stats.max_queue_delay_us));
+
+  if (reduce_over_batch) {
+    // every request of a batch of more than one request had to be run on its own
+    EXPECT_EQ(stats.num_unbatched_runs == 0, stats.num_batches == stats.num_requests);
+    EXPECT_LE(stats.num_unbatched_runs, stats.num_requests);
+    // once a batched run has failed, the later requests are not queued
+    EXPECT_EQ(stats.num_unbatched_runs == 0, stats.num_bypassed_requests == 0);
+  } else {
+    EXPECT_EQ(stats.num_unbatched_runs, 0u);
+    EXPECT_EQ(stats.num_bypassed_requests, 0u);
+  }
+}
+
+// Runs one request of a single row on each of two threads at the same time and checks their outputs.
+static void RunDynamicBatchingPair(InferenceSession& session_object, const RunOptions& run_options_0,
+                                   const RunOptions& run_options_1) {
+  const std::vector<std::string> output_names{"Y"};
+  const RunOptions* run_options[] = {&run_options_0, &run_options_1};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back([&, t]() {
+      const std::vector<float> values{static_cast<float>(t), static_cast<float>(t + 10)};
+      OrtValue input;
+      CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), {1, 2}, values, &input);
+      NameMLValMap feeds{{"X", input}};
+
+      std::vector<OrtValue> fetches;
+      auto status = session_object.Run(*run_options[t], feeds, output_names, &fetches);
+      ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+      ASSERT_EQ(fetches.size(), 1u);
+      const auto& output = fetches[0].Get<Tensor>();
+      EXPECT_EQ(output.Shape(), TensorShape({1, 2}));
+      EXPECT_EQ(std::vector<float>(output.Data<float>(), output.Data<float>() + 2),
+                (std::vector<float>{values[0] * 2, values[1] * 2}));
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Creates a session that batches up to two requests of a single row, waiting up to max_wait_us for the second.
+static void CreateDynamicBatchingPairSession(std::unique_ptr<InferenceSession>& session_object, bool fixed_batch,
+                                             const char* max_wait_us) {
+  std::unique_ptr<Model> p_model;
+  CreateDynamicBatchingModel(p_model, false, fixed_batch);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DynamicBatchingPair";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs, max_wait_us));
+
+  session_object = std::make_unique<InferenceSession>(so, GetEnvironment());
+  std::string model_data;
+  p_model->ToProto().SerializeToString(&model_data);
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object->Load(sstr));
+  ASSERT_STATUS_OK(session_object->Initialize());
+}
+
+TEST(InferenceSessionTests, DynamicBatchingStopsBatchingModelsWithFixedBatch) {
+  std::unique_ptr<InferenceSession> session_object;
+  // the first request waits for the second, which closes the batch as soon as it arrives
+  CreateDynamicBatchingPairSession(session_object, true, "10000000");
+
+  // the batch of two rows fails on the fixed batch dimension, the requests then succeed on their own
+  RunDynamicBatchingPair(*session_object, RunOptions(), RunOptions());
+  auto stats = session_object->GetDynamicBatchingStats();
+  EXPECT_EQ(stats.num_requests, 2u);
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_unbatched_runs, 2u);
+  EXPECT_EQ(stats.num_bypassed_requests, 0u);
+
+  // no batched run is attempted for the same inputs again
+  RunDynamicBatchingPair(*session_object, RunOptions(), RunOptions());
+  stats = session_object->GetDynamicBatchingStats();
+  EXPECT_EQ(stats.num_requests, 2u);
+  EXPECT_EQ(stats.num_batches, 1u);
+  EXPECT_EQ(stats.num_unbatched_runs, 2u);
+  EXPECT_EQ(stats.num_bypassed_requests, 2u);
+}
+
+TEST(InferenceSessionTests, DynamicBatchingSeparatesRunTags) {
+  std::unique_ptr<InferenceSession> session_object;
+  CreateDynamicBatchingPairSession(session_object, false, "200000");
+
+  RunOptions run_options_0;
+  run_options_0.run_tag = "request_0";
+  RunOptions run_options_1;
+  run_options_1.run_tag = "request_1";
+
+  // each request waits for a partner with the same tag and then runs on its own
+  RunDynamicBatchingPair(*session_object, run_options_0, run_options_1);
+  auto stats = session_object->GetDynamicBatchingStats();
+  EXPECT_EQ(stats.num_requests, 2u);
+  EXPECT_EQ(stats.num_batches, 2u);
+
+  // requests with different log levels are not batched together either
+  run_options_1.run_tag = run_options_0.run_tag;
+  run_options_1.run_log_severity_level = static_cast<int>(logging::Severity::kERROR);
+  RunDynamicBatchingPair(*session_object, run_options_0, run_options_1);
+  stats = session_object->GetDynamicBatchingStats();
+  EXPECT_EQ(stats.num_requests, 4u);
+  EXPECT_EQ(stats.num_batches, 4u);
+  EXPECT_EQ(stats.num_unbatched_runs, 0u);
+}
+
+TEST(InferenceSessionTests, DynamicBatching) {
+  RunDynamicBatchingModel(false);
+}
+
+TEST(InferenceSessionTests, DynamicBatchingFallsBackWhenOutputsCanNotBeSplit) {
+  RunDynamicBatchingModel(true);
+}
+
+TEST(InferenceSessionTests, DynamicBatchingIsDisabledByDefault) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.DynamicBatchingIsDisabledByDefault";
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  EXPECT_EQ(session_object.GetDynamicBatchingStats().num_requests, 0u);
+}
+
+// Creates a model that multiplies an input of shape [2, 3] by a constant weight of shape [3, 4].
+static void CreatePrepackedWeightsCacheModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  p_model = std::make_unique<Model>("prepacked_weights_cache", false, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                    std::unordered_map<std::string, int>{{kOnnxDomain, 13}},
+                                    std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                    DefaultLoggingManager().DefaultLogger());
+  auto& graph = p_model->MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  ONNX_NAMESPACE::TensorProto weight{};
+  weight.set_name("W");
+  weight.add_dims(3);
+  weight.add_dims(4);
+  weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (int i = 0; i < 12; ++i) {
+    weight.add_float_data(static_cast<float>(i + 1));
+  }
+  graph.AddInitializedTensor(weight);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& weight_arg = graph.GetOrCreateNodeArg("W", nullptr);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  graph.AddNode("matmul", "MatMul", "multiply by the weight", {&input_arg, &weight_arg}, {&output_arg});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+// Creates a model that multiplies an input of shape [2, 3] by a constant square weight with Gemm, so that the shape
+// of the weight does not change with transB.
+static void CreatePrepackedWeightsCacheGemmModel(std::unique_ptr<onnxruntime::Model>& p_model, int64_t trans_b) {
+  p_model = std::make_unique<Model>("prepacked_weights_cache_gemm", false, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                    std::unordered_map<std::string, int>{{kOnnxDomain, 13}},
+                                    std::vector<ONNX_NAMESPACE::FunctionProto>{},
+                                    DefaultLoggingManager().DefaultLogger());
+  auto& graph = p_model->MainGraph();
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  ONNX_NAMESPACE::TensorProto weight{};
+  weight.set_name("W");
+  weight.add_dims(3);
+  weight.add_dims(3);
+  weight.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (int i = 0; i < 9; ++i) {
+    weight.add_float_data(static_cast<float>(i + 1));
+  }
+  graph.AddInitializedTensor(weight);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& weight_arg = graph.GetOrCreateNodeArg("W", nullptr);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", nullptr);
+  auto& node = graph.AddNode("gemm", "Gemm", "multiply by the weight", {&input_arg, &weight_arg}, {&output_arg});
+  node.AddAttribute("transB", trans_b);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+static const std::vector<float> kPrepackedWeightsCacheModelOutput{38.0f, 44.0f, 50.0f, 56.0f,
+                                                                  83.0f, 98.0f, 113.0f, 128.0f};
+
+static void RunPrepackedWeightsCacheModel(
+    const Model& model, const SessionOptions& so, size_t expected_restored_weights,
+    const std::vector<float>& expected_output = kPrepackedWeightsCacheModelOutput) {
+  InferenceSession session_object{so, GetEnvironment()};
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  std::stringstream sstr(model_data);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  EXPECT_EQ(session_object.GetSessionState().GetNumberOfPrepacksCounter(), 1u);
+  EXPECT_EQ(session_object.GetSessionState().GetRestoredPrePackedWeightCounter(), expected_restored_weights);
+
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), {2, 3},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &input);
+  NameMLValMap feeds{{"X", input}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches));
+
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Shape(), TensorShape({2, static_cast<int64_t>(expected_output.size() / 2)}));
+  EXPECT_EQ(std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size()), expected_output);
+}
+
+TEST(InferenceSessionTests, PrepackedWeightsCacheFile) {
+  const std::string cache_file = "prepacked_weights_cache_file_test.bin";
+  std::filesystem::remove(cache_file);
+
+  std::unique_ptr<Model> p_model;
+  CreatePrepackedWeightsCacheModel(p_model);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PrepackedWeightsCacheFile";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigPrepackedWeightsCacheFile,
+                                                    cache_file.c_str()));
+
+  // the first session packs the weight and creates the file, the second one restores the weight from it
+  RunPrepackedWeightsCacheModel(*p_model, so, 0);
+  ASSERT_TRUE(std::filesystem::exists(cache_file));
+  RunPrepackedWeightsCacheModel(*p_model, so, 1);
+
+  // a file written with different session options is not used, and is replaced
+  SessionOptions so_with_other_config = so;
+  ASSERT_STATUS_OK(so_with_other_config.config_options.AddConfigEntry(kOrtSessionOptionsConfigDynamicBlockBase, "4"));
+  RunPrepackedWeightsCacheModel(*p_model, so_with_other_config, 0);
+  RunPrepackedWeightsCacheModel(*p_model, so_with_other_config, 1);
+
+  // a corrupt file is ignored and replaced
+  {
+    std::ofstream file(cache_file, std::ios::binary | std::ios::trunc);
+    file << "ORTPACK";
+  }
+  RunPrepackedWeightsCacheModel(*p_model, so, 0);
+  RunPrepackedWeightsCacheModel(*p_model, so, 1);
+
+  // a weight whose content was modified in the file does not match its checksum, so it is packed again. the buffer
+  // of the only weight starts at the first aligned offset after the header.
+  {
+    std::fstream file(cache_file, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(64);
+    file.put('\x7f');
+  }
+  RunPrepackedWeightsCacheModel(*p_model, so, 0);
+  RunPrepackedWeightsCacheModel(*p_model, so, 1);
+
+  std::filesystem::remove(cache_file);
+}
+
+TEST(InferenceSessionTests, PrepackedWeightsCacheFileNodeAttributes) {
+  const std::string cache_file = "prepacked_weights_cache_file_node_attributes_test.bin";
+  std::filesystem::remove(cache_file);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.PrepackedWeightsCacheFileNodeAttributes";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigPrepackedWeightsCacheFile,
+                                                    cache_file.c_str()));
+
+  std::unique_ptr<Model> p_model;
+  CreatePrepackedWeightsCacheGemmModel(p_model, 0);
+  const std::vector<float> expected_output{30.0f, 36.0f, 42.0f, 66.0f, 81.0f, 96.0f};
+  RunPrepackedWeightsCacheModel(*p_model, so, 0, expected_output);
+  RunPrepackedWeightsCacheModel(*p_model, so, 1, expected_output);
+
+  // the same node and weight with another transB must not restore the weight packed for the other layout
+  std::unique_ptr<Model> p_model_trans_b;
+  CreatePrepackedWeightsCacheGemmModel(p_model_trans_b, 1);
+  const std::vector<float> expected_output_trans_b{14.0f, 32.0f, 50.0f, 32.0f, 77.0f, 122.0f};
+  RunPrepackedWeightsCacheModel(*p_model_trans_b, so, 0, expected_output_trans_b);
+  RunPrepackedWeightsCacheModel(*p_model_trans_b, so, 1, expected_output_trans_b);
+
+  std::filesystem::remove(cache_file);
+}
+
+// Initializes a session of the model file and checks whether its graph, kernels and execution plan were restored
+// from the session snapshot. prepare, if set, configures the session before the model is loaded.
+static void RunSessionSnapshotModel(const std::string& model_file, const SessionOptions& so, bool expect_restored,
+                                    const std::vector<float>& expected_output,
+                                    const std::function<void(InferenceSession&)>& prepare = nullptr) {
+  InferenceSession session_object{so, GetEnvironment()};
+  if (prepare) {
+    prepare(session_object);
+  }
+  ASSERT_STATUS_OK(session_object.Load(model_file));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto& session_state = session_object.GetSessionState();
+  EXPECT_EQ(session_object.IsInitializedFromSessionSnapshot(), expect_restored);
+  EXPECT_EQ(session_state.GetRestoredKernelCreateInfoCounter(),
+            expect_restored ? session_state.GetKernelCreateInfoMap().size() : 0u);
+  EXPECT_EQ(session_state.IsExecutionPlanRestored(), expect_restored);
+
+  OrtValue input;
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(OrtMemTypeDefault), {2, 3},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &input);
+  NameMLValMap feeds{{"X", input}};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions(), feeds, {"Y"}, &fetches));
+
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Shape(), TensorShape({2, 4}));
+  EXPECT_EQ(std::vector<float>(output.Data<float>(), output.Data<float>() + output.Shape().Size()), expected_output);
+}
+
+TEST(InferenceSessionTests, SessionSnapshotFile) {
+  const std::string model_file = "session_snapshot_file_test.onnx";
+  const std::string snapshot_file = "session_snapshot_file_test.snapshot";
+  std::filesystem::remove(snapshot_file);
+
+  std::unique_ptr<Model> p_model;
+  CreatePrepackedWeightsCacheModel(p_model);
+  ASSERT_STATUS_OK(Model::Save(*p_model, model_file));
+  std::vector<float> expected_output = kPrepackedWeightsCacheModelOutput;
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SessionSnapshotFile";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSessionSnapshotFile,
+                                                    snapshot_file.c_str()));
+
+  // the first session initializes from the model and creates the snapshot, the second one initializes from it
+  RunSessionSnapshotModel(model_file, so, false, expected_output);
+  ASSERT_TRUE(std::filesystem::exists(snapshot_file));
+  RunSessionSnapshotModel(model_file, so, true, expected_output);
+
+  // a snapshot of a different version of the model file is not used, and is replaced
+  ONNX_NAMESPACE::TensorProto weight = *p_model->MainGraph().GetAllInitializedTensors().at("W");
+  weight.set_float_data(0, 2.0f);
+  p_model->MainGraph().RemoveInitializedTensor("W");
+  p_model->MainGraph().AddInitializedTensor(weight);
+  ASSERT_STATUS_OK(Model::Save(*p_model, model_file));
+  expected_output = {39.0f, 44.0f, 50.0f, 56.0f, 87.0f, 98.0f, 113.0f, 128.0f};
+  RunSessionSnapshotModel(model_file, so, false, expected_output);
+  RunSessionSnapshotModel(model_file, so, true, expected_output);
+
+  // a snapshot created with different session options is not used, and is replaced
+  SessionOptions so_with_other_config = so;
+  so_with_other_config.graph_optimization_level = TransformerLevel::Level1;
+  RunSessionSnapshotModel(model_file, so_with_other_config, false, expected_output);
+  RunSessionSnapshotModel(model_file, so_with_other_config, true, expected_output);
+
+  // a corrupt snapshot is ignored and replaced
+  {
+    std::ofstream file(snapshot_file, std::ios::binary | std::ios::trunc);
+    file << "ORTSNAP";
+  }
+  RunSessionSnapshotModel(model_file, so, false, expected_output);
+  RunSessionSnapshotModel(model_file, so, true, expected_output);
+
+  // a snapshot created with different execution providers is not used, and is replaced
+  const auto register_dummy_provider = [](InferenceSession& session_object) {
+    ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(std::make_unique<DummyExecutionProvider>()));
+  };
+  RunSessionSnapshotModel(model_file, so, false, expected_output, register_dummy_provider);
+  RunSessionSnapshotModel(model_file, so, true, expected_output, register_dummy_provider);
+  RunSessionSnapshotModel(model_file, so, false, expected_output);
+  RunSessionSnapshotModel(model_file, so, true, expected_output);
+
+  // sessions with other graph transformers neither use the snapshot nor replace it
+  const auto read_snapshot = [&snapshot_file]() {
+    std::ifstream file(snapshot_file, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  };
+  const std::string snapshot = read_snapshot();
+
+  const DummyGraphTransformer* dummy_transformer = nullptr;
+  RunSessionSnapshotModel(model_file, so, false, expected_output, [&dummy_transformer](InferenceSession& session) {
+    auto transformer = std::make_unique<DummyGraphTransformer>("DummyTransformer");
+    dummy_transformer = transformer.get();
+    ASSERT_STATUS_OK(session.RegisterGraphTransformer(std::move(transformer)));
+  });
+  EXPECT_TRUE(dummy_transformer->IsTransformerInvoked());
+
+  RunSessionSnapshotModel(model_file, so, false, expected_output, [](InferenceSession& session) {
+    ASSERT_STATUS_OK(session.FilterEnabledOptimizers({"ConstantFolding"}));
+  });
+
+  EXPECT_EQ(read_snapshot(), snapshot);
+  RunSessionSnapshotModel(model_file, so, true, expected_output);
+
+  std::filesystem::remove(snapshot_file);
+  std::filesystem::remove(model_file);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -10,6 +10,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
+#include "core/framework/session_state_utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -84,7 +85,7 @@ TEST_P(SessionStateAddGetKernelTest, AddGetKernelTest) {
   auto kernel_def = KernelDefBuilder().SetName("Variable").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
 
   OpKernelInfo p_info(node, *kernel_def, *cpu_execution_provider, s.GetConstantInitializedTensors(),
-                      s.GetOrtValueNameIdxMap(), s.GetDataTransferMgr());
+                      s.GetOrtValueNameIdxMap(), s.GetDataTransferMgr(), sess_options.config_options);
   unique_ptr<TestOpKernel> p_kernel;
   p_kernel.reset(new TestOpKernel(p_info));
   size_t orig_num_outputs = p_kernel->Node().OutputDefs().size();
@@ -808,6 +809,249 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+// Graph with many nodes that pre-pack a weight of their own and a weight shared with all the other nodes.
+static void CreateGraphWithManyPrePackingNodes(Graph& graph, int num_nodes) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto add_initializer = [&graph](const std::string& name, float value) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.add_dims(1);
+    tensor.add_float_data(value);
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name(name);
+    graph.AddInitializedTensor(tensor);
+  };
+
+  auto& shared_weight = graph.GetOrCreateNodeArg("shared_weight", &type);
+  add_initializer("shared_weight", 1.0f);
+
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto& weight = graph.GetOrCreateNodeArg("weight_" + suffix, &type);
+    auto& output = graph.GetOrCreateNodeArg("output_" + suffix, &type);
+    std::vector<NodeArg*> inputs = {&weight, &shared_weight};
+    std::vector<NodeArg*> outputs = {&output};
+    graph.AddNode("node_" + suffix, "PrePackingTest", "node " + suffix, inputs, outputs);
+    add_initializer("weight_" + suffix, static_cast<float>(i));
+  }
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK());
+}
+
+// The kernels and the pre-packed weights must not depend on whether the session state is initialized in parallel.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, ParallelInitialization) {
+  constexpr int num_nodes = 64;
+
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto parallel_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  for (const char* disable_parallel_initialization : {"0", "1"}) {
+    SessionOptions sess_options;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisableParallelInitialization] =
+        disable_parallel_initialization;
+
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    CreateGraphWithManyPrePackingNodes(model.MainGraph(), num_nodes);
+    PlaceAllNodesToCPUEP(model.MainGraph());
+
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               parallel_tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    // Every input of every node was pre-packed once, so no constant initializer is kept
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(2 * num_nodes));
+    ASSERT_TRUE(session_state.GetConstantInitializedTensors().empty());
+    ASSERT_TRUE(session_state.GetInitializedTensors().empty());
+
+    for (const auto& node : model.MainGraph().Nodes()) {
+      const auto* kernel = static_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(node.Index()));
+      ASSERT_NE(kernel, nullptr);
+      ASSERT_EQ(kernel->prepack_calls_count, 2);
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 0);
+    }
+  }
+}
+
+// Graph with many MatMul nodes with a constant weight of their own, each followed by an Add of a constant bias.
+// The CPU MatMul kernel pre-packs the weight, so only the biases are kept as initializers.
+static void CreateGraphWithManyCpuNodes(Graph& graph, int num_nodes, int64_t dim) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+
+  auto add_initializer = [&graph](const std::string& name, std::vector<int64_t> dims, float value) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    int64_t size = 1;
+    for (int64_t d : dims) {
+      tensor.add_dims(d);
+      size *= d;
+    }
+    for (int64_t i = 0; i < size; ++i) {
+      tensor.add_float_data(value + static_cast<float>(i));
+    }
+    tensor.set_data_type(TensorProto_DataType_FLOAT);
+    tensor.set_name(name);
+    graph.AddInitializedTensor(tensor);
+  };
+
+  auto& input = graph.GetOrCreateNodeArg("X", &type);
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto& weight = graph.GetOrCreateNodeArg("weight_" + suffix, nullptr);
+    auto& bias = graph.GetOrCreateNodeArg("bias_" + suffix, nullptr);
+    auto& product = graph.GetOrCreateNodeArg("product_" + suffix, nullptr);
+    auto& output = graph.GetOrCreateNodeArg("output_" + suffix, nullptr);
+    add_initializer("weight_" + suffix, {dim, dim}, static_cast<float>(i));
+    add_initializer("bias_" + suffix, {dim}, static_cast<float>(i * 1000));
+    std::vector<NodeArg*> matmul_inputs = {&input, &weight};
+    std::vector<NodeArg*> matmul_outputs = {&product};
+    graph.AddNode("matmul_" + suffix, "MatMul", "matmul " + suffix, matmul_inputs, matmul_outputs);
+    std::vector<NodeArg*> add_inputs = {&product, &bias};
+    std::vector<NodeArg*> add_outputs = {&output};
+    graph.AddNode("add_" + suffix, "Add", "add " + suffix, add_inputs, add_outputs);
+  }
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status;
+}
+
+// The kernels of the CPU EP are created and pre-pack in parallel when there is no custom kernel registry. The
+// initializers span many deserialization batches.
+TEST(SessionStateTest, ParallelInitializationWithCpuKernels) {
+  constexpr int num_nodes = 48;
+  constexpr int64_t dim = 8;
+
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (const char* disable_parallel_initialization : {"0", "1"}) {
+    ExecutionProviders execution_providers;
+    ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                             std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+    KernelRegistryManager krm;
+    ASSERT_STATUS_OK(krm.RegisterKernels(execution_providers));
+    ASSERT_FALSE(krm.HasCustomKernelRegistries());
+
+    DataTransferManager dtm;
+    profiling::Profiler profiler;
+
+    SessionOptions sess_options;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisableParallelInitialization] =
+        disable_parallel_initialization;
+    // a weight and a bias are about 300 bytes, so the initializers are deserialized in many batches
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigInitializerDeserializationBatchSize] = "1000";
+
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 13}}, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+    CreateGraphWithManyCpuNodes(model.MainGraph(), num_nodes, dim);
+    PlaceAllNodesToCPUEP(model.MainGraph());
+
+    SessionState session_state(model.MainGraph(), execution_providers, tp.get(), nullptr, dtm,
+                               DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(), krm));
+
+    for (const auto& node : model.MainGraph().Nodes()) {
+      const OpKernel* kernel = session_state.GetKernel(node.Index());
+      ASSERT_NE(kernel, nullptr);
+      ASSERT_EQ(kernel->KernelDef().OpName(), node.OpType());
+    }
+
+    // the weights were pre-packed and released, the biases are kept with their values
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(num_nodes));
+    ASSERT_EQ(session_state.GetConstantInitializedTensors().size(), static_cast<size_t>(num_nodes));
+    for (int i = 0; i < num_nodes; ++i) {
+      int ort_value_idx = -1;
+      ASSERT_STATUS_OK(session_state.GetOrtValueNameIdxMap().GetIdx("bias_" + std::to_string(i), ort_value_idx));
+      const auto& bias = session_state.GetConstantInitializedTensors().at(ort_value_idx).Get<Tensor>();
+      ASSERT_EQ(bias.Shape(), TensorShape({dim}));
+      for (int64_t j = 0; j < dim; ++j) {
+        ASSERT_EQ(bias.Data<float>()[j], static_cast<float>(i * 1000 + j));
+      }
+    }
+  }
+}
+
+TEST(SessionStateTest, ParallelForWithStatus) {
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
+
+  for (concurrency::ThreadPool* thread_pool : {static_cast<concurrency::ThreadPool*>(nullptr), tp.get()}) {
+    constexpr size_t total = 1000;
+
+    // every index runs when no call fails
+    std::vector<std::atomic<int>> calls(total);
+    ASSERT_STATUS_OK(session_state_utils::ParallelForWithStatus(thread_pool, total, [&calls](size_t i) -> Status {
+      ++calls[i];
+      return Status::OK();
+    }));
+    for (const auto& count : calls) {
+      ASSERT_EQ(count.load(), 1);
+    }
+
+    // the error of the lowest failing index is returned, whatever the order the calls complete in
+    Status status = session_state_utils::ParallelForWithStatus(thread_pool, total, [](size_t i) -> Status {
+      if (i == 137 || i == 500 || i == 999) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "failed at ", i);
+      }
+      return Status::OK();
+    });
+    ASSERT_EQ(status.Code(), common::INVALID_ARGUMENT);
+    ASSERT_EQ(status.ErrorMessage(), "failed at 137");
+
+#ifndef ORT_NO_EXCEPTIONS
+    // an exception of the lowest failing index is rethrown on the calling thread
+    try {
+      status = session_state_utils::ParallelForWithStatus(thread_pool, total, [](size_t i) -> Status {
+        if (i == 600) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed at ", i);
+        }
+        if (i == 200 || i == 800) {
+          ORT_THROW("thrown at ", i);
+        }
+        return Status::OK();
+      });
+      FAIL() << "ParallelForWithStatus did not rethrow the exception";
+    } catch (const OnnxRuntimeException& e) {
+      ASSERT_NE(std::string(e.what()).find("thrown at 200"), std::string::npos);
+    }
+
+    // an error of an index lower than the one of an exception is returned instead of the exception
+    status = session_state_utils::ParallelForWithStatus(thread_pool, total, [](size_t i) -> Status {
+      if (i == 100) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed at ", i);
+      }
+      if (i == 300) {
+        ORT_THROW("thrown at ", i);
+      }
+      return Status::OK();
+    });
+    ASSERT_EQ(status.ErrorMessage(), "failed at 100");
+#endif
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "mlas_float16.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+#include <numeric>
+#include <algorithm>
+
+static const std::vector<std::string> halfgemm_bench_arg_names = {"M", "N", "K", "Batch", "Threads"};
+
+void HALFGEMM(benchmark::State& state, bool pack_b, bool a_is_fp32, bool b_is_fp32) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Batch must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  const size_t batch = static_cast<size_t>(state.range(3));
+  const size_t threads = static_cast<size_t>(state.range(4));
+
+  if (!MlasFp16AccelerationSupported()) {
+    state.SkipWithError("Half precision GEMM is not accelerated on this platform!");
+    return;
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto A_float = RandomVectorUniform(static_cast<size_t>(M * K * batch), -1.0f, 1.0f);
+  auto B_float = RandomVectorUniform(static_cast<size_t>(N * K * batch), -1.0f, 1.0f);
+  std::vector<_mlas_fp16_> A_half(A_float.size());
+  std::vector<_mlas_fp16_> B_half(B_float.size());
+  std::transform(A_float.begin(), A_float.end(), A_half.begin(), MLAS_Float2Half);
+  std::transform(B_float.begin(), B_float.end(), B_half.begin(), MLAS_Float2Half);
+  std::vector<_mlas_fp16_> C_holder(static_cast<size_t>(M * N * batch));
+  std::vector<uint8_t> pack_b_holder;
+
+  size_t packed_b_size = 0;
+  if (pack_b) {
+    packed_b_size = MlasHalfGemmPackBSize(N, K, b_is_fp32);
+    if (packed_b_size == 0) {
+      state.SkipWithError("Packing of B is not supported on this platform!");
+      return;
+    }
+    pack_b_holder.resize(packed_b_size * batch);
+  }
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> gemm_data_vec(batch);
+  for (size_t i = 0; i < batch; i++) {
+    auto& gemm_params = gemm_data_vec[i];
+    gemm_params.A = a_is_fp32 ? static_cast<const void*>(A_float.data() + M * K * i)
+                              : static_cast<const void*>(A_half.data() + M * K * i);
+    gemm_params.lda = K;
+    gemm_params.AIsfp32 = a_is_fp32;
+    gemm_params.B = b_is_fp32 ? static_cast<const void*>(B_float.data() + N * K * i)
+                              : static_cast<const void*>(B_half.data() + N * K * i);
+    gemm_params.ldb = N;
+    gemm_params.BIsfp32 = b_is_fp32;
+    gemm_params.C = reinterpret_cast<MLAS_FP16*>(C_holder.data() + M * N * i);
+    gemm_params.ldc = N;
+    if (pack_b) {
+      void* packed_b = pack_b_holder.data() + packed_b_size * i;
+      if (b_is_fp32) {
+        MlasHalfGemmConvertPackB(N, K, B_float.data() + N * K * i, N, packed_b);
+      } else {
+        MlasHalfGemmPackB(N, K, reinterpret_cast<const MLAS_FP16*>(B_half.data() + N * K * i), N, packed_b);
+      }
+      gemm_params.B = packed_b;
+      gemm_params.ldb = 0;
+    }
+  }
+
+  // warm up run
+  MlasHalfGemmBatch(M, N, K, batch, gemm_data_vec.data(), tp.get());
+
+  for (auto _ : state) {
+    MlasHalfGemmBatch(M, N, K, batch, gemm_data_vec.data(), tp.get());
+  }
+}
+
+static void HalfGemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(halfgemm_bench_arg_names);
+  // Args for "M", "N", "K", "Batch", "Threads"
+  ArgsProduct(b, {{1, 63, 255, 1023}, {63, 255, 1023}, {63, 255, 1023}, {1}, {1, 4, 8}});
+}
+
+BENCHMARK_CAPTURE(HALFGEMM, FP16xFP16, false, false, false)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, FP32xFP16, false, true, false)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, FP16xFP32, false, false, true)->Apply(HalfGemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(HALFGEMM, PACKB_FP16xFP32, true, false, true)->Apply(HalfGemmSize)->UseRealTime();
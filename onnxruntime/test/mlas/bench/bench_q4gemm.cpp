@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas_q4.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <stdexcept>
+#include <memory>
+#include <numeric>
+
+static const std::vector<std::string> q4gemm_bench_arg_names = {"M", "N", "K", "Threads"};
+
+void Q4GEMM(benchmark::State& state, MLAS_BLK_QUANT_TYPE qtype) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t threads = static_cast<size_t>(state.range(3));
+
+  const size_t pack_b_size = MlasQ4GemmPackBSize(qtype, N, K);
+  if (pack_b_size == 0) {
+    state.SkipWithError("Int4 block quantization is not supported on this platform!");
+    return;
+  }
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto A = RandomVectorUniform(static_cast<size_t>(M * K), -1.0f, 1.0f);
+  auto B = RandomVectorUniform(static_cast<size_t>(N * K), -1.0f, 1.0f);
+  std::vector<float> C(static_cast<size_t>(M * N));
+
+  std::vector<uint8_t> B_packed(pack_b_size);
+  MlasQ4GemmPackB(qtype, B_packed.data(), B.data(), N, K, N);
+
+  MLAS_Q4_GEMM_DATA_PARAMS params;
+  params.A = A.data();
+  params.lda = K;
+  params.B = B_packed.data();
+  params.Bias = nullptr;
+  params.C = C.data();
+  params.ldc = N;
+
+  // warm up run
+  MlasQ4GemmBatch(qtype, M, N, K, 1, &params, tp.get());
+
+  for (auto _ : state) {
+    MlasQ4GemmBatch(qtype, M, N, K, 1, &params, tp.get());
+  }
+}
+
+static void Q4GemmSize(benchmark::internal::Benchmark* b) {
+  b->ArgNames(q4gemm_bench_arg_names);
+  // Args for "M", "N", "K", "Threads"
+  ArgsProduct(b, {{1, 4, 64}, {4096}, {4096, 11008}, {1, 4, 8}});
+}
+
+BENCHMARK_CAPTURE(Q4GEMM, Q4Sym, BlkQ4Sym)->Apply(Q4GemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(Q4GEMM, Q4Zp8, BlkQ4Zp8)->Apply(Q4GemmSize)->UseRealTime();
+BENCHMARK_CAPTURE(Q4GEMM, Q4Sym128, BlkQ4Sym128)->Apply(Q4GemmSize)->UseRealTime();
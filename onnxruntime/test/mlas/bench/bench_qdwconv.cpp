@@ -0,0 +1,115 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+#include <numeric>
+
+static const std::vector<std::string> qdwconv_arg_names = {"C", "H", "W", "KH", "KW"};
+
+//
+// Benchmark the symmetric quantized depthwise convolution of an NHWC image
+// with "same" padding and unit strides, as used by QLinearConv.
+//
+
+void QDWCONV_SYM(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("C must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("H must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("W must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("KH must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("KW must greater than 0!");
+
+  const size_t channels = static_cast<size_t>(state.range(0));
+  const size_t height = static_cast<size_t>(state.range(1));
+  const size_t width = static_cast<size_t>(state.range(2));
+  const size_t kernel_h = static_cast<size_t>(state.range(3));
+  const size_t kernel_w = static_cast<size_t>(state.range(4));
+  const size_t kernel_size = kernel_h * kernel_w;
+  const size_t output_count = height * width;
+  const uint8_t input_zero_point = 128;
+
+  const size_t packed_size = MlasConvSymPackWSize(channels, 1, 1, kernel_size, false);
+  if (packed_size == 0) {
+    state.SkipWithError("Symmetric depthwise convolution is not supported for this platform or shape");
+    return;
+  }
+
+  auto input = RandomVectorUniform<uint8_t>(height * width * channels, uint8_t(0), uint8_t(255));
+  auto filter = RandomVectorUniform<int8_t>(channels * kernel_size, int8_t(-127), int8_t(127));
+  std::vector<uint8_t> padding(channels, input_zero_point);
+  std::vector<uint8_t> output(output_count * channels);
+
+  std::vector<int8_t> packed_filter(packed_size);
+  MlasConvSymPackW(channels, 1, 1, kernel_size, filter.data(), packed_filter.data(), packed_size, false);
+
+  std::vector<const void*> indirection(output_count * kernel_size);
+  const ptrdiff_t pad_h = static_cast<ptrdiff_t>(kernel_h / 2);
+  const ptrdiff_t pad_w = static_cast<ptrdiff_t>(kernel_w / 2);
+  size_t n = 0;
+  for (ptrdiff_t oh = 0; oh < static_cast<ptrdiff_t>(height); oh++) {
+    for (ptrdiff_t ow = 0; ow < static_cast<ptrdiff_t>(width); ow++) {
+      for (ptrdiff_t kh = 0; kh < static_cast<ptrdiff_t>(kernel_h); kh++) {
+        for (ptrdiff_t kw = 0; kw < static_cast<ptrdiff_t>(kernel_w); kw++) {
+          const ptrdiff_t ih = oh + kh - pad_h;
+          const ptrdiff_t iw = ow + kw - pad_w;
+          if (ih >= 0 && ih < static_cast<ptrdiff_t>(height) && iw >= 0 && iw < static_cast<ptrdiff_t>(width)) {
+            indirection[n++] = input.data() + (ih * width + iw) * channels;
+          } else {
+            indirection[n++] = padding.data();
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<int32_t> bias(channels);
+  std::vector<float> scale(channels, 0.002f);
+  for (size_t c = 0; c < channels; c++) {
+    int32_t sum = std::accumulate(filter.begin() + c * kernel_size, filter.begin() + (c + 1) * kernel_size, int32_t(0));
+    bias[c] = -sum * MlasConvSymFixupInputZeroPoint(input_zero_point, false);
+  }
+
+  MLAS_CONV_SYM_PARAMS params = {};
+  params.InputIndirection = indirection.data();
+  params.Filter = packed_filter.data();
+  params.Output = output.data();
+  params.InputChannels = channels;
+  params.OutputChannels = channels;
+  params.OutputCount = output_count;
+  params.KernelSize = kernel_size;
+  params.Bias = bias.data();
+  params.Scale = scale.data();
+  params.PerChannelScale = true;
+  params.OutputZeroPoint = 128;
+  params.InputIsSigned = false;
+
+  MlasConvSymDepthwise(params);
+
+  for (auto _ : state) {
+    MlasConvSymDepthwise(params);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * output_count * channels * kernel_size));
+}
+
+static void MobileNetDepthwise(benchmark::internal::Benchmark* b) {
+  b->ArgNames(qdwconv_arg_names);
+  // Depthwise layers of MobileNetV2 and EfficientNet-B0.
+  b->Args({32, 112, 112, 3, 3});
+  b->Args({144, 56, 56, 3, 3});
+  b->Args({192, 28, 28, 3, 3});
+  b->Args({384, 14, 14, 3, 3});
+  b->Args({576, 14, 14, 3, 3});
+  b->Args({960, 7, 7, 3, 3});
+  b->Args({144, 28, 28, 5, 5});
+  b->Args({240, 28, 28, 5, 5});
+  b->Args({672, 14, 14, 5, 5});
+  b->Args({1152, 7, 7, 5, 5});
+  // Kernel sizes without a specialized kernel.
+  b->Args({144, 56, 56, 3, 1});
+  b->Args({144, 28, 28, 7, 7});
+}
+
+BENCHMARK(QDWCONV_SYM)->Apply(MobileNetDepthwise)->UseRealTime();
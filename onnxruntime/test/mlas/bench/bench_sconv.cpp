@@ -4,6 +4,7 @@
 #include "mlas.h"
 #include "bench_util.h"
 
+#include <memory>
 #include <stdexcept>
 #include <numeric>
 
@@ -38,8 +39,7 @@ static const std::vector<std::string>& ArgNamesForConv(size_t rank) {
   return rank_to_args_name[rank];
 }
 
-// dummy for some strange build error when using Bench capture
-void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+static void Sconv(benchmark::State& state, bool use_winograd, bool channels_last) {
   const int64_t rank = state.range(0);                       // Rank
   const int64_t batch_size = state.range(1);                 // N
   const int64_t groups = state.range(2);                     // G
@@ -95,6 +95,58 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   activation.ActivationKind = MlasIdentityActivation;
   MLAS_CONV_PARAMETERS Parameters;
   size_t WorkingBufferSize = 0;
+
+  // The channels last layout has the same number of elements, so only the filter needs to be packed.
+  if (channels_last) {
+    MlasConvNhwcPrepare(&Parameters,
+                        static_cast<size_t>(rank),
+                        static_cast<size_t>(batch_size),
+                        static_cast<size_t>(groups),
+                        static_cast<size_t>(input_channels_per_group),
+                        input_shape.data(),
+                        kernel_shape.data(),
+                        dilations.data(),
+                        paddings.data(),
+                        strides.data(),
+                        output_shape.data(),
+                        static_cast<size_t>(output_channels_per_group),
+                        &activation,
+                        &WorkingBufferSize,
+                        0.0f,
+                        nullptr);
+
+    auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
+    auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
+    const size_t kernel_size = static_cast<size_t>(
+        std::accumulate(kernel_shape.begin(), kernel_shape.end(), 1LL, std::multiplies<int64_t>()));
+    const size_t alignment = MlasGetPreferredBufferAlignment();
+    std::vector<uint8_t> packed_filter_buffer(MlasConvNhwcPackFilterSize(static_cast<size_t>(groups),
+                                                                         static_cast<size_t>(input_channels_per_group),
+                                                                         static_cast<size_t>(output_channels_per_group),
+                                                                         kernel_size) +
+                                              alignment);
+    void* packed_filter = packed_filter_buffer.data();
+    size_t packed_filter_space = packed_filter_buffer.size();
+    std::align(alignment, packed_filter_space - alignment, packed_filter, packed_filter_space);
+    MlasConvNhwcPackFilter(static_cast<size_t>(groups),
+                           static_cast<size_t>(input_channels_per_group),
+                           static_cast<size_t>(output_channels_per_group),
+                           kernel_size,
+                           F.data(),
+                           packed_filter);
+
+    int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
+    std::vector<float> Y(static_cast<size_t>(y_size));
+    std::vector<float> working_buffer(WorkingBufferSize);
+
+    MlasConvNhwc(&Parameters, X.data(), packed_filter, nullptr, working_buffer.data(), Y.data(), nullptr);
+
+    for (auto _ : state) {
+      MlasConvNhwc(&Parameters, X.data(), packed_filter, nullptr, working_buffer.data(), Y.data(), nullptr);
+    }
+    return;
+  }
+
   MlasConvPrepare(&Parameters,
                   static_cast<size_t>(rank),
                   static_cast<size_t>(batch_size),
@@ -114,6 +166,32 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
 
   auto X = RandomVectorUniform(x_shape, -2.0, 2.0);
   auto F = RandomVectorUniform(f_shape, -1.0, 1.0);
+
+  // Transform the filter ahead of time as done by the Conv kernel and report which algorithm was selected, as
+  // shapes where the Winograd algorithm is not estimated to be cheaper run the existing algorithms.
+  std::vector<float> packed_filter;
+  if (use_winograd) {
+    size_t packed_filter_size = MlasConvWinogradPackFilterSize(static_cast<size_t>(rank),
+                                                               static_cast<size_t>(groups),
+                                                               static_cast<size_t>(input_channels_per_group),
+                                                               static_cast<size_t>(output_channels_per_group),
+                                                               kernel_shape.data(),
+                                                               dilations.data(),
+                                                               strides.data());
+    if (packed_filter_size > 0) {
+      packed_filter.resize(packed_filter_size);
+      MlasConvWinogradPackFilter(static_cast<size_t>(groups),
+                                 static_cast<size_t>(input_channels_per_group),
+                                 static_cast<size_t>(output_channels_per_group),
+                                 F.data(),
+                                 packed_filter.data());
+    }
+    bool is_winograd = MlasConvWinogradPrepare(&Parameters,
+                                               packed_filter.empty() ? nullptr : packed_filter.data(),
+                                               &WorkingBufferSize,
+                                               nullptr);
+    state.SetLabel(is_winograd ? "Winograd" : "Default");
+  }
   int64_t y_size = std::accumulate(y_shape.begin(), y_shape.end(), 1LL, std::multiplies<int64_t>());
   std::vector<float> Y(static_cast<size_t>(y_size));
   std::vector<float> working_buffer(WorkingBufferSize);
@@ -138,6 +216,19 @@ void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
   }
 }
 
+// dummy for some strange build error when using Bench capture
+void SCONV_NCHW(benchmark::State& state, const char* /*dummy*/) {
+  Sconv(state, false, false);
+}
+
+void SCONV_NCHW_WINOGRAD(benchmark::State& state, const char* /*dummy*/) {
+  Sconv(state, true, false);
+}
+
+void SCONV_NHWC(benchmark::State& state, const char* /*dummy*/) {
+  Sconv(state, false, true);
+}
+
 static void ResNet50(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
 
@@ -199,6 +290,7 @@ static void ResNet50(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, ResNet50, "")->Apply(ResNet50)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NHWC, ResNet50, "")->Apply(ResNet50)->UseRealTime();
 
 static void TeamsModel(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
@@ -221,6 +313,23 @@ static void TeamsModel(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SCONV_NCHW, TeamsModel, "")->Apply(TeamsModel)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NHWC, TeamsModel, "")->Apply(TeamsModel)->UseRealTime();
+
+static void Winograd3x3(benchmark::internal::Benchmark* b) {
+  b->ArgNames(ArgNamesForConv(2));
+  //    Rank, N, G, Cpg, Fpg,  I,   , K, , P, , , , S, , D, ,
+  b->Args({2, 1, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});     // ResNet50 Conv 2.X
+  b->Args({2, 1, 1, 128, 128, 28, 28, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});   // ResNet50 Conv 3.X
+  b->Args({2, 1, 1, 256, 256, 14, 14, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});   // ResNet50 Conv 4.X
+  b->Args({2, 1, 1, 512, 512, 7, 7, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});     // ResNet50 Conv 5.X
+  b->Args({2, 4, 1, 64, 64, 56, 56, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});     // ResNet50 Conv 2.X, batch 4
+  b->Args({2, 1, 1, 40, 24, 24, 40, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});     // TeamsModel fused conv_349
+  b->Args({2, 1, 1, 12, 8, 48, 80, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1});      // TeamsModel fused Conv_395
+}
+
+// Compare the existing algorithms with the Winograd algorithm for 3x3 convolutions with unit strides.
+BENCHMARK_CAPTURE(SCONV_NCHW, Winograd3x3, "")->Apply(Winograd3x3)->UseRealTime();
+BENCHMARK_CAPTURE(SCONV_NCHW_WINOGRAD, Winograd3x3, "")->Apply(Winograd3x3)->UseRealTime();
 
 static void General_Conv2d(benchmark::internal::Benchmark* b) {
   b->ArgNames(ArgNamesForConv(2));
@@ -105,6 +105,11 @@ static void GemmSizeProducts(benchmark::internal::Benchmark* b) {
   ArgsProduct(b, {{63, 255, 1023}, {63, 255, 1023}, {63, 255, 1023}});
 }
 
+static void GemmSizeSkinny(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_bench_arg_names);
+  ArgsProduct(b, {{1, 2, 4}, {1024, 4096}, {1024, 4096}});
+}
+
 BENCHMARK_CAPTURE(SGEMM, NORMAL_NoTrans, false, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, NORMAL_TransA, false, true, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, NORMAL_TransB, false, false, true)->Apply(GemmSizeProducts)->UseRealTime();
@@ -117,3 +122,7 @@ BENCHMARK_CAPTURE(SGEMM, GEMV_ABTrans, false, true, true)->Apply(GemmSizeWithOne
 
 BENCHMARK_CAPTURE(SGEMM, PACKB_NoTransA, true, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, PACKB_TransA, true, true, false)->Apply(GemmSizeProducts)->UseRealTime();
+
+BENCHMARK_CAPTURE(SGEMM, SKINNY_NoTrans, false, false, false)->Apply(GemmSizeSkinny)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM, SKINNY_TransB, false, false, true)->Apply(GemmSizeSkinny)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM, SKINNY_PACKB, true, false, false)->Apply(GemmSizeSkinny)->UseRealTime();
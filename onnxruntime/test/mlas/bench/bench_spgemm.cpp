@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <random>
+#include <stdexcept>
+
+static const std::vector<std::string> spgemm_bench_arg_names = {"M", "N", "K", "BlockK", "Sparsity"};
+
+//
+// Benchmark the block sparse SGEMM with a weight matrix B pruned to blocks of
+// BlockK x 4 elements, the Sparsity percentage of which are zero. The dense
+// baseline multiplies the same matrices with the dense SGEMM.
+//
+
+void SPARSE_SGEMM(benchmark::State& state, bool dense_baseline) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(3) <= 0) throw std::invalid_argument("BlockK must greater than 0!");
+  if (state.range(4) < 0 || state.range(4) > 100) throw std::invalid_argument("Sparsity must be a percentage!");
+
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  const size_t BlockK = static_cast<size_t>(state.range(3));
+  const double sparsity = static_cast<double>(state.range(4)) / 100.0;
+
+  auto A = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  auto B = RandomVectorUniform(N * K, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  std::mt19937 generator(42);
+  std::bernoulli_distribution prune_distribution(sparsity);
+  for (size_t k = 0; k < K; k += BlockK) {
+    for (size_t n = 0; n < N; n += MLAS_SPARSE_SGEMM_BLOCK_N) {
+      if (prune_distribution(generator)) {
+        for (size_t kk = k; kk < std::min(k + BlockK, K); kk++) {
+          for (size_t nn = n; nn < std::min(n + MLAS_SPARSE_SGEMM_BLOCK_N, N); nn++) {
+            B[kk * N + nn] = 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+  const size_t non_zero_blocks = MlasSparseGemmCountNonZeroBlocks(CblasNoTrans, N, K, B.data(), N, BlockK);
+  std::vector<uint8_t> packed_b(MlasSparseGemmPackBSize(N, K, BlockK, non_zero_blocks));
+  MlasSparseGemmPackB(CblasNoTrans, N, K, B.data(), N, BlockK, packed_b.data());
+
+  MLAS_SPARSE_SGEMM_DATA_PARAMS params;
+  params.A = A.data();
+  params.lda = K;
+  params.PackedB = packed_b.data();
+  params.C = C.data();
+  params.ldc = N;
+
+  if (dense_baseline) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N, nullptr);
+
+    for (auto _ : state) {
+      MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N, nullptr);
+    }
+    return;
+  }
+
+  MlasSparseGemmBatch(M, N, K, 1, &params, nullptr);
+
+  for (auto _ : state) {
+    MlasSparseGemmBatch(M, N, K, 1, &params, nullptr);
+  }
+}
+
+static void SparseGemmSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(spgemm_bench_arg_names);
+  // Transformer feed forward layers of BERT-base with 1x4 and 4x4 block pruning.
+  ArgsProduct(b, {{1, 128}, {3072}, {768}, {1, 4}, {0, 50, 70, 80, 90, 95}});
+  ArgsProduct(b, {{1, 128}, {768}, {3072}, {1, 4}, {0, 50, 70, 80, 90, 95}});
+}
+
+BENCHMARK_CAPTURE(SPARSE_SGEMM, SPARSE, false)->Apply(SparseGemmSizes)->UseRealTime();
+BENCHMARK_CAPTURE(SPARSE_SGEMM, DENSE_BASELINE, true)->Apply(SparseGemmSizes)->UseRealTime();
@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+//
+// Thread scaling sweeps for the threaded MLAS operations. Each run reports the
+// speedup over a single threaded run of the same shape and the parallel
+// efficiency (speedup / threads), which shows how well the work partitioner
+// keeps the extra cores busy.
+//
+
+static const std::vector<std::string> gemm_scaling_arg_names = {"M", "N", "K", "Threads"};
+static const std::vector<std::string> conv_scaling_arg_names = {"C", "H", "W", "F", "Kernel", "Threads"};
+
+template <typename WorkFn>
+static void RunScaling(benchmark::State& state, int64_t threads, double flops_per_run, WorkFn&& work) {
+  if (threads <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = int(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  using clock = std::chrono::steady_clock;
+
+  // Take the best of a few single threaded runs as the baseline.
+  work(nullptr);
+  double single_seconds = 0.0;
+  for (int i = 0; i < 3; i++) {
+    auto start = clock::now();
+    work(nullptr);
+    double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    if (i == 0 || seconds < single_seconds) {
+      single_seconds = seconds;
+    }
+  }
+
+  work(tp.get());
+
+  double total_seconds = 0.0;
+  for (auto _ : state) {
+    auto start = clock::now();
+    work(tp.get());
+    total_seconds += std::chrono::duration<double>(clock::now() - start).count();
+  }
+
+  const double seconds = total_seconds / static_cast<double>(state.iterations());
+  const double speedup = single_seconds / seconds;
+
+  state.counters["Speedup"] = speedup;
+  state.counters["Efficiency"] = speedup / static_cast<double>(threads);
+  state.counters["FLOPS"] = benchmark::Counter(flops_per_run * static_cast<double>(state.iterations()),
+                                               benchmark::Counter::kIsRate);
+}
+
+static void SGEMM_SCALING(benchmark::State& state, bool trans_b) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  auto A = RandomVectorUniform(M * K, -1.0f, 1.0f);
+  auto B = RandomVectorUniform(N * K, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  RunScaling(state, state.range(3), 2.0 * double(M) * double(N) * double(K), [&](MLAS_THREADPOOL* tp) {
+    MlasGemm(CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(),
+             trans_b ? K : N, 0.0f, C.data(), N, tp);
+  });
+}
+
+static void QGEMM_SCALING(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("K must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+
+  constexpr uint8_t b_zero_point = 179;
+
+  auto A = RandomVectorUniform<uint8_t>(M * K, uint8_t(0), uint8_t(255));
+  auto B = RandomVectorUniform<uint8_t>(N * K, uint8_t(0), uint8_t(255));
+  std::vector<int32_t> C(M * N);
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+  gemm_shape.M = M;
+  gemm_shape.N = N;
+  gemm_shape.K = K;
+  gemm_shape.AIsSigned = false;
+  gemm_shape.BIsSigned = true;
+
+  MLAS_GEMM_QUANT_DATA_PARAMS gemm_data;
+  gemm_data.A = A.data();
+  gemm_data.lda = K;
+  gemm_data.ZeroPointA = 29;
+  gemm_data.B = B.data();
+  gemm_data.ldb = N;
+  gemm_data.ZeroPointB = &b_zero_point;
+  gemm_data.C = C.data();
+  gemm_data.ldc = N;
+
+  RunScaling(state, state.range(3), 2.0 * double(M) * double(N) * double(K), [&](MLAS_THREADPOOL* tp) {
+    MlasGemmBatch(gemm_shape, &gemm_data, 1, tp);
+  });
+}
+
+static void SCONV_SCALING(benchmark::State& state) {
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const int64_t filters = state.range(3);
+  const int64_t kernel = state.range(4);
+
+  if (channels <= 0 || height <= 0 || width <= 0 || filters <= 0 || kernel <= 0) {
+    throw std::invalid_argument("all convolution arguments must greater than 0!");
+  }
+
+  const int64_t input_shape[] = {height, width};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t paddings[] = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+  const int64_t strides[] = {1, 1};
+  const int64_t dilations[] = {1, 1};
+  const int64_t output_shape[] = {height + 2 * (kernel / 2) - kernel + 1, width + 2 * (kernel / 2) - kernel + 1};
+
+  auto input = RandomVectorUniform(static_cast<size_t>(channels * height * width), -1.0f, 1.0f);
+  auto filter = RandomVectorUniform(static_cast<size_t>(filters * channels * kernel * kernel), -1.0f, 1.0f);
+  auto bias = RandomVectorUniform(static_cast<size_t>(filters), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(filters * output_shape[0] * output_shape[1]));
+  std::vector<float> working_buffer;
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  const double flops = 2.0 * double(filters) * double(output_shape[0] * output_shape[1]) *
+                       double(channels * kernel * kernel);
+
+  RunScaling(state, state.range(5), flops, [&](MLAS_THREADPOOL* tp) {
+    MLAS_CONV_PARAMETERS parameters;
+    size_t working_buffer_size = 0;
+    MlasConvPrepare(&parameters, 2, 1, 1, static_cast<size_t>(channels), input_shape, kernel_shape,
+                    dilations, paddings, strides, output_shape, static_cast<size_t>(filters), &activation,
+                    &working_buffer_size, 0.0f, tp);
+    if (working_buffer.size() < working_buffer_size) {
+      working_buffer.resize(working_buffer_size);
+    }
+    MlasConv(&parameters, input.data(), filter.data(), bias.data(), working_buffer.data(), output.data(), tp);
+  });
+}
+
+static void GemmScalingSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(gemm_scaling_arg_names);
+  // Args for "M", "N", "K", "Threads": square, tall, wide and small
+  // output / long K shapes.
+  ArgsProduct(b, {{1024}, {1024}, {1024}, {1, 2, 4, 8, 16, 32, 64}});
+  ArgsProduct(b, {{4096}, {64}, {1024}, {1, 2, 4, 8, 16, 32, 64}});
+  ArgsProduct(b, {{16}, {4096}, {1024}, {1, 2, 4, 8, 16, 32, 64}});
+  ArgsProduct(b, {{4}, {64}, {16384}, {1, 2, 4, 8, 16, 32, 64}});
+}
+
+static void ConvScalingSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(conv_scaling_arg_names);
+  // Args for "C", "H", "W", "F", "Kernel", "Threads": an early layer with a
+  // large image and a late layer with few output pixels.
+  ArgsProduct(b, {{64}, {56}, {56}, {64}, {3}, {1, 2, 4, 8, 16, 32, 64}});
+  ArgsProduct(b, {{512}, {7}, {7}, {512}, {3}, {1, 2, 4, 8, 16, 32, 64}});
+}
+
+BENCHMARK_CAPTURE(SGEMM_SCALING, NoTrans, false)->Apply(GemmScalingSizes)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM_SCALING, TransB, true)->Apply(GemmScalingSizes)->UseRealTime();
+BENCHMARK(QGEMM_SCALING)->Apply(GemmScalingSizes)->UseRealTime();
+BENCHMARK(SCONV_SCALING)->Apply(ConvScalingSizes)->UseRealTime();
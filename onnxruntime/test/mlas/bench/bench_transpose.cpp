@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+//
+// Benchmark the N-D transpose of fp32 tensors. The baseline walks the output
+// element by element with a multi-index, like the generic Transpose kernel.
+//
+
+static void TransposeNdBaseline(const float* input, float* output, const std::vector<size_t>& shape,
+                                const std::vector<size_t>& perm) {
+  const size_t rank = shape.size();
+  std::vector<size_t> strides(rank, 1);
+  for (size_t i = rank; i > 1; i--) {
+    strides[i - 2] = strides[i - 1] * shape[i - 1];
+  }
+
+  size_t count = 1;
+  for (size_t dim : shape) {
+    count *= dim;
+  }
+
+  std::vector<size_t> index(rank, 0);
+  size_t offset = 0;
+  for (size_t o = 0; o < count; o++) {
+    output[o] = input[offset];
+    for (size_t i = rank; i > 0; i--) {
+      offset += strides[perm[i - 1]];
+      if (++index[i - 1] < shape[perm[i - 1]]) {
+        break;
+      }
+      offset -= strides[perm[i - 1]] * index[i - 1];
+      index[i - 1] = 0;
+    }
+  }
+}
+
+void TRANSPOSE_ND(benchmark::State& state, std::vector<size_t> shape, std::vector<size_t> perm, bool baseline) {
+  size_t count = 1;
+  for (size_t dim : shape) {
+    count *= dim;
+  }
+
+  auto input = RandomVectorUniform(count, -1.0f, 1.0f);
+  std::vector<float> output(count);
+
+  if (baseline) {
+    for (auto _ : state) {
+      TransposeNdBaseline(input.data(), output.data(), shape, perm);
+    }
+  } else {
+    if (!MlasTransposeNd(input.data(), output.data(), sizeof(float), shape.size(), shape.data(), perm.data(),
+                         nullptr)) {
+      throw std::invalid_argument("Transpose is not supported for this shape!");
+    }
+    for (auto _ : state) {
+      MlasTransposeNd(input.data(), output.data(), sizeof(float), shape.size(), shape.data(), perm.data(), nullptr);
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(float) * 2));
+}
+
+// BERT-base attention heads: [B, S, H, D] <-> [B, H, S, D] and K^T as [B, H, D, S].
+BENCHMARK_CAPTURE(TRANSPOSE_ND, BertHeads, {8, 128, 12, 64}, {0, 2, 1, 3}, false)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, BertHeads_Baseline, {8, 128, 12, 64}, {0, 2, 1, 3}, true)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, BertKeys, {8, 128, 12, 64}, {0, 2, 3, 1}, false)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, BertKeys_Baseline, {8, 128, 12, 64}, {0, 2, 3, 1}, true)->UseRealTime();
+
+// NCDHW <-> NDHWC of 3D convolution activations.
+BENCHMARK_CAPTURE(TRANSPOSE_ND, NCDHW_NDHWC, {2, 32, 16, 56, 56}, {0, 2, 3, 4, 1}, false)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, NCDHW_NDHWC_Baseline, {2, 32, 16, 56, 56}, {0, 2, 3, 4, 1}, true)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, NDHWC_NCDHW, {2, 16, 56, 56, 32}, {0, 4, 1, 2, 3}, false)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, NDHWC_NCDHW_Baseline, {2, 16, 56, 56, 32}, {0, 4, 1, 2, 3}, true)->UseRealTime();
+
+// A large matrix transpose.
+BENCHMARK_CAPTURE(TRANSPOSE_ND, Matrix, {2048, 2048}, {1, 0}, false)->UseRealTime();
+BENCHMARK_CAPTURE(TRANSPOSE_ND, Matrix_Baseline, {2048, 2048}, {1, 0}, true)->UseRealTime();
@@ -204,7 +204,8 @@ class MlasActivationTest : public MlasTestBase {
     MLAS_ACTIVATION Activation;
     AliasedValue Buffer[_countof(TestData)];
 
-    for (unsigned kind = 0; kind < unsigned(MlasActivationKindCount); kind++) {
+    // The GELU activations are covered against a reference by test_gelu.cpp.
+    for (unsigned kind = 0; kind < unsigned(_countof(TestData[0])); kind++) {
       Activation.ActivationKind = MLAS_ACTIVATION_KIND(kind);
 
       if (Activation.ActivationKind == MlasLeakyReluActivation) {
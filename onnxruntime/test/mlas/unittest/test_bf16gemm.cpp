@@ -0,0 +1,193 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_bf16gemm.cpp
+
+Abstract:
+
+    Tests for MLAS bfloat16 GEMM.
+
+--*/
+
+#include "test_util.h"
+
+#include <cstring>
+
+static uint16_t
+RoundToBf16(float Value) {
+  uint32_t Bits;
+  std::memcpy(&Bits, &Value, sizeof(Bits));
+  Bits += 0x7FFF + ((Bits >> 16) & 1);
+  return uint16_t(Bits >> 16);
+}
+
+static float
+Bf16ToFloat(uint16_t Value) {
+  const uint32_t Bits = uint32_t(Value) << 16;
+  float f;
+  std::memcpy(&f, &Bits, sizeof(f));
+  return f;
+}
+
+template <bool Packed, bool Threaded>
+class MlasBf16GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint16_t> BufferABf16;
+  MatrixGuardBuffer<uint16_t> BufferBBf16;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MatrixGuardBuffer<float> BufferCMagnitude;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // The test data is not an integer, so that rounding to bfloat16 is
+  // exercised.
+  //
+  static void FillFraction(float* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int(i % 47) - 23) * 0.3717f;
+    }
+  }
+
+ public:
+  MlasBf16GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool ABf16, bool BBf16, bool TransB, float alpha, float beta) {
+    const float* A = BufferA.GetFilledBuffer(M * K, FillFraction);
+    const float* B = BufferB.GetFilledBuffer(N * K, FillFraction);
+    uint16_t* ABf16Data = BufferABf16.GetBuffer(M * K, true);
+    uint16_t* BBf16Data = BufferBBf16.GetBuffer(N * K, true);
+    for (size_t i = 0; i < M * K; i++) {
+      ABf16Data[i] = RoundToBf16(A[i]);
+    }
+    for (size_t i = 0; i < N * K; i++) {
+      BBf16Data[i] = RoundToBf16(B[i]);
+    }
+
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M, true);
+    float* CMagnitude = BufferCMagnitude.GetBuffer(N * M, true);
+
+    //
+    // Matrix B is K x N, or N x K when transposed.
+    //
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        double magnitude = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          const size_t b = TransB ? (n * K + k) : (k * N + n);
+          const double product = double(Bf16ToFloat(ABf16Data[m * K + k])) * Bf16ToFloat(BBf16Data[b]);
+          sum += product;
+          magnitude += std::fabs(product);
+        }
+        CReference[m * N + n] = float(alpha * sum + beta * C[m * N + n]);
+        CMagnitude[m * N + n] = float(std::fabs(alpha) * magnitude + std::fabs(beta * C[m * N + n]));
+      }
+    }
+
+    MLAS_BF16_GEMM_DATA_PARAMS params;
+    params.A = ABf16 ? static_cast<const void*>(ABf16Data) : static_cast<const void*>(A);
+    params.AIsfp32 = !ABf16;
+    params.lda = K;
+    params.C = C;
+    params.ldc = N;
+    params.alpha = alpha;
+    params.beta = beta;
+
+    if (Packed) {
+      void* PackedB = BufferPackedB.GetBuffer(MlasBf16GemmPackBSize(N, K), true);
+      const CBLAS_TRANSPOSE Trans = TransB ? CblasTrans : CblasNoTrans;
+      const size_t ldb = TransB ? K : N;
+      if (BBf16) {
+        MlasBf16GemmPackB(Trans, N, K, reinterpret_cast<const MLAS_BF16*>(BBf16Data), ldb, PackedB);
+      } else {
+        MlasBf16GemmConvertPackB(Trans, N, K, B, ldb, PackedB);
+      }
+      params.B = PackedB;
+      params.ldb = 0;
+    } else {
+      params.B = BBf16 ? static_cast<const void*>(BBf16Data) : static_cast<const void*>(B);
+      params.BIsfp32 = !BBf16;
+      params.ldb = N;
+    }
+
+    MlasBf16GemmBatch(M, N, K, 1, &params, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float ref = CReference[m * N + n];
+        ASSERT_LE(std::fabs(C[m * N + n] - ref), CMagnitude[m * N + n] * 1e-5f + 1e-5f)
+            << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", "
+            << "ABf16=" << ABf16 << ", BBf16=" << BBf16 << ", TransB=" << TransB << ", "
+            << "alpha=" << alpha << ", beta=" << beta << ", "
+            << C[m * N + n] << " vs " << ref;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Bf16Gemm") +
+                                          (Packed ? "_Packed" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 3, 4, 5, 7, 16, 17, 33}) {
+      for (size_t N : {1, 15, 16, 32, 77, 160}) {
+        for (size_t K : {1, 2, 16, 31, 32, 33, 64, 127, 300}) {
+          Test(M, N, K, false, false, false, 1.0f, 0.0f);
+          Test(M, N, K, true, true, Packed, 1.0f, 0.0f);
+        }
+      }
+    }
+    for (bool ABf16 : {false, true}) {
+      for (bool BBf16 : {false, true}) {
+        for (bool TransB : {false, true}) {
+          if (TransB && !Packed) {
+            continue;
+          }
+          Test(64, 96, 80, ABf16, BBf16, TransB, 1.0f, 1.0f);
+          Test(37, 50, 45, ABf16, BBf16, TransB, 0.5f, 0.0f);
+          Test(48, 64, 65, ABf16, BBf16, TransB, -1.5f, 2.0f);
+        }
+      }
+    }
+    Test(43, 500, 401, false, false, false, 1.0f, 1.0f);
+    Test(160, 1000, 600, true, false, false, 1.0f, 0.0f);
+  }
+};
+
+template <>
+MlasBf16GemmTest<false, false>* MlasTestFixture<MlasBf16GemmTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<false, true>* MlasTestFixture<MlasBf16GemmTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<true, false>* MlasTestFixture<MlasBf16GemmTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<true, true>* MlasTestFixture<MlasBf16GemmTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasBf16GemmTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasBf16GemmTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
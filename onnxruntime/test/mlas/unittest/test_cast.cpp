@@ -0,0 +1,221 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_cast.cpp
+
+Abstract:
+
+    Tests for the MLAS element type conversions.
+
+--*/
+
+#include "test_fp16.h"
+
+#include <cstring>
+#include <limits>
+
+template <bool Threaded>
+class MlasCastTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferFloat;
+  MatrixGuardBuffer<float> BufferFloatOutput;
+  MatrixGuardBuffer<uint16_t> BufferHalf;
+  MatrixGuardBuffer<uint16_t> BufferHalfOutput;
+  MatrixGuardBuffer<int32_t> BufferInt32;
+  MatrixGuardBuffer<int8_t> BufferInt8;
+  MatrixGuardBuffer<uint8_t> BufferUInt8;
+  MLAS_THREADPOOL* threadpool_;
+
+  static uint32_t BitsOf(float Value) {
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+    return Bits;
+  }
+
+  static float FloatOf(uint32_t Bits) {
+    float Value;
+    std::memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+  }
+
+  //
+  // Fills the buffer with values spread over many binades followed by the
+  // values at the edges of the conversions.
+  //
+
+  static void FillFloat(float* start, size_t size) {
+    static const float Special[] = {
+        std::numeric_limits<float>::quiet_NaN(),
+        -std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(),
+        -std::numeric_limits<float>::infinity(),
+        0.0f, -0.0f, 0.5f, -0.5f, 1.5f, -2.5f,
+        127.4f, 127.5f, 128.0f, -128.9f, -129.0f, 255.9f, 256.0f, -1.0f,
+        2147483520.0f, 2147483648.0f, -2147483648.0f, -2147483904.0f, 1e10f, -1e10f,
+        65504.0f, 65519.0f, 65520.0f, 1e-6f, -6e-8f, 1e-40f,
+        FloatOf(0x3F808000), FloatOf(0x3F818000), FloatOf(0x3F80C000), FloatOf(0x7F7FFFFF),
+    };
+    for (size_t i = 0; i < size; i++) {
+      const float Scale = float(1 << (i % 24)) / 4096.0f;
+      start[i] = float(int((i * 37) % 201) - 100) * 0.37f * Scale;
+    }
+    for (size_t i = 0; i < size && i < _countof(Special); i++) {
+      start[size - 1 - i] = Special[i];
+    }
+  }
+
+  static bool IsHalfNaN(uint16_t Value) { return (Value & 0x7C00) == 0x7C00 && (Value & 0x03FF) != 0; }
+
+  static bool IsBf16NaN(uint16_t Value) { return (Value & 0x7F80) == 0x7F80 && (Value & 0x007F) != 0; }
+
+  static uint16_t ReferenceBf16(float Value) {
+    if (std::isnan(Value)) {
+      return 0x7FC0;
+    }
+    const uint32_t Bits = BitsOf(Value);
+    const uint32_t Truncated = Bits & 0xFFFF0000;
+    const uint32_t Remainder = Bits & 0xFFFF;
+    uint32_t Result = Truncated >> 16;
+    if (Remainder > 0x8000 || (Remainder == 0x8000 && (Result & 1) != 0)) {
+      Result++;
+    }
+    return uint16_t(Result);
+  }
+
+  template <typename T>
+  static T ReferenceInt(float Value) {
+    if (std::isnan(Value)) {
+      return 0;
+    }
+    const double Truncated = std::trunc(double(Value));
+    if (Truncated <= double(std::numeric_limits<T>::lowest())) {
+      return std::numeric_limits<T>::lowest();
+    }
+    if (Truncated >= double(std::numeric_limits<T>::max())) {
+      return std::numeric_limits<T>::max();
+    }
+    return T(Truncated);
+  }
+
+  template <typename T>
+  void TestFloatToInt(size_t N, MatrixGuardBuffer<T>& BufferOutput) {
+    const float* Input = BufferFloat.GetFilledBuffer(N, FillFloat);
+    T* Output = BufferOutput.GetBuffer(N, true);
+
+    MlasCast(Input, Output, N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_EQ(Output[i], ReferenceInt<T>(Input[i])) << "Input=" << Input[i] << ", N=" << N << " @" << i;
+    }
+  }
+
+  template <typename T>
+  void TestIntToFloat(size_t N, MatrixGuardBuffer<T>& BufferInput) {
+    T* Input = BufferInput.GetBuffer(N);
+    for (size_t i = 0; i < N; i++) {
+      Input[i] = T((i * 2654435761u) >> (32 - 8 * sizeof(T)));
+    }
+    float* Output = BufferFloatOutput.GetBuffer(N, true);
+
+    MlasCast(const_cast<const T*>(Input), Output, N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_EQ(Output[i], float(Input[i])) << "N=" << N << " @" << i;
+    }
+  }
+
+ public:
+  MlasCastTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void TestHalf(size_t N) {
+    const float* Input = BufferFloat.GetFilledBuffer(N, FillFloat);
+    uint16_t* Half = BufferHalf.GetBuffer(N, true);
+
+    MlasCast(Input, reinterpret_cast<MLAS_FP16*>(Half), N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      const uint16_t Expected = MLAS_Float2Half(Input[i]);
+      if (IsHalfNaN(Expected)) {
+        ASSERT_TRUE(IsHalfNaN(Half[i])) << "N=" << N << " @" << i;
+      } else {
+        ASSERT_EQ(Half[i], Expected) << "Input=" << Input[i] << ", N=" << N << " @" << i;
+      }
+    }
+
+    float* Output = BufferFloatOutput.GetBuffer(N, true);
+
+    MlasCast(reinterpret_cast<const MLAS_FP16*>(Half), Output, N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      const float Expected = MLAS_Half2Float(Half[i]);
+      if (std::isnan(Expected)) {
+        ASSERT_TRUE(std::isnan(Output[i])) << "N=" << N << " @" << i;
+      } else {
+        ASSERT_EQ(BitsOf(Output[i]), BitsOf(Expected)) << "Half=" << Half[i] << ", N=" << N << " @" << i;
+      }
+    }
+  }
+
+  void TestBf16(size_t N) {
+    const float* Input = BufferFloat.GetFilledBuffer(N, FillFloat);
+    uint16_t* Bf16 = BufferHalf.GetBuffer(N, true);
+
+    MlasCast(Input, reinterpret_cast<MLAS_BF16*>(Bf16), N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      const uint16_t Expected = ReferenceBf16(Input[i]);
+      if (IsBf16NaN(Expected)) {
+        ASSERT_TRUE(IsBf16NaN(Bf16[i])) << "N=" << N << " @" << i;
+      } else {
+        ASSERT_EQ(Bf16[i], Expected) << "Input=" << Input[i] << ", N=" << N << " @" << i;
+      }
+    }
+
+    float* Output = BufferFloatOutput.GetBuffer(N, true);
+
+    MlasCast(reinterpret_cast<const MLAS_BF16*>(Bf16), Output, N, threadpool_);
+
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_EQ(BitsOf(Output[i]), uint32_t(Bf16[i]) << 16) << "N=" << N << " @" << i;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Cast") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 3, 8, 15, 16, 17, 31, 32, 33, 63, 64, 100, 1000, 4099, 70001}) {
+      TestHalf(N);
+      TestBf16(N);
+      TestFloatToInt(N, BufferInt32);
+      TestFloatToInt(N, BufferInt8);
+      TestFloatToInt(N, BufferUInt8);
+      TestIntToFloat(N, BufferInt32);
+      TestIntToFloat(N, BufferInt8);
+      TestIntToFloat(N, BufferUInt8);
+    }
+  }
+};
+
+template <>
+MlasCastTest<false>* MlasTestFixture<MlasCastTest<false>>::mlas_tester(nullptr);
+template <>
+MlasCastTest<true>* MlasTestFixture<MlasCastTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasCastTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasCastTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,210 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv2d_winograd.cpp
+
+Abstract:
+
+    Tests for the MLAS Winograd convolution of 3x3 kernels.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferWorking;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void FillBuffer(float* start, size_t size, size_t seed) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 29 + seed) % 37) - 18) / 16.0f;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConv2DWinogradTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t Padding,
+            bool UsePackedFilter,
+            bool HasBias,
+            float Beta,
+            MLAS_ACTIVATION_KIND ActivationKind) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t PaddingShape[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputSize;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    float* Input = BufferInput.GetBuffer(InputElements);
+    float* Filter = BufferFilter.GetBuffer(FilterElements);
+    float* Bias = HasBias ? BufferBias.GetBuffer(GroupCount * FilterCount) : nullptr;
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+
+    FillBuffer(Input, InputElements, 3);
+    FillBuffer(Filter, FilterElements, 11);
+    if (HasBias) {
+      FillBuffer(Bias, GroupCount * FilterCount, 5);
+    }
+    FillBuffer(Output, OutputElements, 7);
+    std::vector<float> OutputInitial(Output, Output + OutputElements);
+
+    const float* PackedFilter = nullptr;
+    if (UsePackedFilter) {
+      size_t PackedFilterSize = MlasConvWinogradPackFilterSize(2, GroupCount, InputChannels, FilterCount,
+                                                               KernelShape, DilationShape, StrideShape);
+      ASSERT_NE(PackedFilterSize, size_t(0));
+      float* PackedFilterBuffer = BufferPackedFilter.GetBuffer(PackedFilterSize);
+      MlasConvWinogradPackFilter(GroupCount, InputChannels, FilterCount, Filter, PackedFilterBuffer);
+      PackedFilter = PackedFilterBuffer;
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, PaddingShape, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, Beta, threadpool_);
+
+    //
+    // Small images do not amortize the transforms, in which case the
+    // parameters from MlasConvPrepare must be left unchanged.
+    //
+
+    const bool IsWinograd = MlasConvWinogradPrepare(&Parameters, PackedFilter, &WorkingBufferSize, threadpool_);
+    ASSERT_EQ(IsWinograd, Parameters.Algorithm == MlasConvAlgorithmWinograd);
+    ASSERT_TRUE(IsWinograd || OutputSize < 256);
+
+    MlasConv(&Parameters, Input, Filter, Bias, BufferWorking.GetBuffer(WorkingBufferSize), Output, threadpool_);
+
+    //
+    // Compare against a direct convolution accumulated in double precision.
+    // The tolerance is relative to the sum of the magnitudes of the products
+    // as the transforms amplify the rounding errors of the inputs.
+    //
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        for (size_t f = 0; f < FilterCount; f++) {
+          const size_t gf = g * FilterCount + f;
+          const float* filter = Filter + gf * InputChannels * 9;
+          const size_t OutputOffset = (b * GroupCount * FilterCount + gf) * OutputSize;
+
+          for (size_t oh = 0; oh < OutputHeight; oh++) {
+            for (size_t ow = 0; ow < OutputWidth; ow++) {
+              double Sum = 0.0;
+              double Magnitude = 0.0;
+
+              for (size_t c = 0; c < InputChannels; c++) {
+                const float* input = Input + ((b * GroupCount + g) * InputChannels + c) * InputSize;
+
+                for (size_t kh = 0; kh < 3; kh++) {
+                  const size_t ih = oh + kh - Padding;
+                  for (size_t kw = 0; kw < 3; kw++) {
+                    const size_t iw = ow + kw - Padding;
+                    if (ih < InputHeight && iw < InputWidth) {
+                      double Product = double(input[ih * InputWidth + iw]) * double(filter[(c * 3 + kh) * 3 + kw]);
+                      Sum += Product;
+                      Magnitude += std::fabs(Product);
+                    }
+                  }
+                }
+              }
+
+              const size_t o = OutputOffset + oh * OutputWidth + ow;
+
+              Sum += double(Beta) * double(OutputInitial[o]);
+              if (HasBias) {
+                Sum += double(Bias[gf]);
+              }
+              if (ActivationKind == MlasReluActivation) {
+                Sum = std::max(Sum, 0.0);
+              }
+
+              ASSERT_NEAR(double(Output[o]), Sum, Magnitude * 1e-5 + 1e-5)
+                  << "B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels << "/Fpg" << FilterCount
+                  << "/H" << InputHeight << "/W" << InputWidth << "/Pad" << Padding
+                  << "/Packed" << UsePackedFilter << "/Bias" << HasBias << "/Beta" << Beta
+                  << "/TileSize" << (IsWinograd ? Parameters.u.Winograd.OutputTileSize : 0)
+                  << " @" << b << "," << gf << "," << oh << "," << ow;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Size : {5, 8, 13, 28, 56}) {
+      for (size_t Padding : {0, 1}) {
+        for (bool UsePackedFilter : {false, true}) {
+          Test(1, 1, 16, Size, Size, 32, Padding, UsePackedFilter, true, 0.0f, MlasIdentityActivation);
+        }
+      }
+    }
+
+    Test(2, 1, 16, 20, 23, 16, 1, true, false, 0.0f, MlasIdentityActivation);
+    Test(2, 2, 24, 17, 11, 40, 1, true, true, 0.0f, MlasReluActivation);
+    Test(1, 3, 32, 24, 24, 16, 1, false, true, 1.0f, MlasIdentityActivation);
+    Test(3, 1, 64, 30, 30, 64, 1, true, true, 0.5f, MlasReluActivation);
+    Test(1, 1, 128, 7, 7, 128, 1, true, true, 0.0f, MlasIdentityActivation);
+
+    //
+    // Short images select the F(2x2, 3x3) algorithm.
+    //
+
+    Test(1, 1, 64, 10, 10, 64, 1, true, true, 0.0f, MlasReluActivation);
+    Test(2, 1, 64, 4, 130, 64, 0, false, true, 0.0f, MlasIdentityActivation);
+  }
+};
+
+template <>
+MlasConv2DWinogradTest<false>* MlasTestFixture<MlasConv2DWinogradTest<false>>::mlas_tester(nullptr);
+template <>
+MlasConv2DWinogradTest<true>* MlasTestFixture<MlasConv2DWinogradTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
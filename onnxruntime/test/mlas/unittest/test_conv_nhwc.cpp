@@ -0,0 +1,241 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv_nhwc.cpp
+
+Abstract:
+
+    Tests for the MLAS single precision convolution of channels last tensors.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasConvNhwcTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<uint8_t> BufferPackedFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferWorking;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void FillBuffer(float* start, size_t size, size_t seed) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 29 + seed) % 37) - 18) / 16.0f;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "ConvNhwc_Threaded" : "ConvNhwc_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasConvNhwcTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  //
+  // The spatial shapes are supplied as three dimensions, where the leading
+  // dimensions of lower rank convolutions are one.
+  //
+
+  void Test(size_t Dimensions,
+            size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t FilterCount,
+            std::array<size_t, 3> Input3,
+            std::array<size_t, 3> Kernel3,
+            std::array<size_t, 3> Padding3,
+            std::array<size_t, 3> Stride3,
+            std::array<size_t, 3> Dilation3,
+            bool HasBias,
+            float Beta,
+            MLAS_ACTIVATION_KIND ActivationKind,
+            MLAS_CONV_ALGORITHM ExpectedAlgorithm) {
+    std::array<size_t, 3> Output3;
+    for (size_t dim = 0; dim < 3; dim++) {
+      Output3[dim] = (Input3[dim] + 2 * Padding3[dim] - Dilation3[dim] * (Kernel3[dim] - 1) - 1) / Stride3[dim] + 1;
+    }
+
+    int64_t InputShape[3], KernelShape[3], DilationShape[3], PaddingShape[6], StrideShape[3], OutputShape[3];
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+      const size_t d = dim + 3 - Dimensions;
+      InputShape[dim] = int64_t(Input3[d]);
+      KernelShape[dim] = int64_t(Kernel3[d]);
+      DilationShape[dim] = int64_t(Dilation3[d]);
+      PaddingShape[dim] = int64_t(Padding3[d]);
+      PaddingShape[dim + Dimensions] = int64_t(Padding3[d]);
+      StrideShape[dim] = int64_t(Stride3[d]);
+      OutputShape[dim] = int64_t(Output3[d]);
+    }
+
+    const size_t InputSize = Input3[0] * Input3[1] * Input3[2];
+    const size_t OutputSize = Output3[0] * Output3[1] * Output3[2];
+    const size_t KernelSize = Kernel3[0] * Kernel3[1] * Kernel3[2];
+    const size_t InputStride = GroupCount * InputChannels;
+    const size_t OutputStride = GroupCount * FilterCount;
+    const size_t InputElements = BatchCount * InputSize * InputStride;
+    const size_t FilterElements = OutputStride * InputChannels * KernelSize;
+    const size_t OutputElements = BatchCount * OutputSize * OutputStride;
+
+    float* Input = BufferInput.GetBuffer(InputElements);
+    float* Filter = BufferFilter.GetBuffer(FilterElements);
+    float* Bias = HasBias ? BufferBias.GetBuffer(OutputStride) : nullptr;
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+
+    FillBuffer(Input, InputElements, 3);
+    FillBuffer(Filter, FilterElements, 11);
+    if (HasBias) {
+      FillBuffer(Bias, OutputStride, 5);
+    }
+    FillBuffer(Output, OutputElements, 7);
+    std::vector<float> OutputInitial(Output, Output + OutputElements);
+
+    size_t PackedFilterSize = MlasConvNhwcPackFilterSize(GroupCount, InputChannels, FilterCount, KernelSize);
+    uint8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+    MlasConvNhwcPackFilter(GroupCount, InputChannels, FilterCount, KernelSize, Filter, PackedFilter);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvNhwcPrepare(&Parameters, Dimensions, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                        DilationShape, PaddingShape, StrideShape, OutputShape, FilterCount, &Activation,
+                        &WorkingBufferSize, Beta, threadpool_);
+    ASSERT_EQ(Parameters.Algorithm, ExpectedAlgorithm);
+
+    MlasConvNhwc(&Parameters, Input, PackedFilter, Bias, BufferWorking.GetBuffer(WorkingBufferSize), Output,
+                 threadpool_);
+
+    for (size_t b = 0; b < BatchCount; b++) {
+      for (size_t op = 0; op < OutputSize; op++) {
+        const size_t o3[3] = {op / (Output3[1] * Output3[2]), (op / Output3[2]) % Output3[1], op % Output3[2]};
+
+        for (size_t gf = 0; gf < OutputStride; gf++) {
+          const size_t g = gf / FilterCount;
+          double Sum = 0.0;
+          double Magnitude = 0.0;
+
+          for (size_t c = 0; c < InputChannels; c++) {
+            for (size_t k = 0; k < KernelSize; k++) {
+              const size_t k3[3] = {k / (Kernel3[1] * Kernel3[2]), (k / Kernel3[2]) % Kernel3[1], k % Kernel3[2]};
+              size_t i3[3];
+              bool Inside = true;
+              for (size_t dim = 0; dim < 3; dim++) {
+                i3[dim] = o3[dim] * Stride3[dim] + k3[dim] * Dilation3[dim] - Padding3[dim];
+                Inside &= (i3[dim] < Input3[dim]);
+              }
+              if (Inside) {
+                const size_t ip = (i3[0] * Input3[1] + i3[1]) * Input3[2] + i3[2];
+                double Product = double(Input[(b * InputSize + ip) * InputStride + g * InputChannels + c]) *
+                                 double(Filter[(gf * InputChannels + c) * KernelSize + k]);
+                Sum += Product;
+                Magnitude += std::fabs(Product);
+              }
+            }
+          }
+
+          const size_t o = (b * OutputSize + op) * OutputStride + gf;
+
+          Sum += double(Beta) * double(OutputInitial[o]);
+          if (HasBias) {
+            Sum += double(Bias[gf]);
+          }
+          if (ActivationKind == MlasReluActivation) {
+            Sum = std::max(Sum, 0.0);
+          }
+
+          ASSERT_NEAR(double(Output[o]), Sum, Magnitude * 1e-6 + 1e-5)
+              << "Rank" << Dimensions << "/B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels
+              << "/Fpg" << FilterCount << "/I" << Input3[0] << "x" << Input3[1] << "x" << Input3[2]
+              << "/K" << Kernel3[0] << "x" << Kernel3[1] << "x" << Kernel3[2] << "/Bias" << HasBias
+              << "/Beta" << Beta << " @" << b << "," << op << "," << gf;
+        }
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    const MLAS_CONV_ALGORITHM Direct = MlasConvAlgorithmNhwcGemmDirect;
+    const MLAS_CONV_ALGORITHM Expand = MlasConvAlgorithmNhwcExpandThenGemm;
+    const MLAS_CONV_ALGORITHM Depthwise = MlasConvAlgorithmNhwcDepthwise;
+
+    //
+    // Pointwise convolutions.
+    //
+
+    Test(2, 1, 1, 64, 32, {1, 14, 14}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasReluActivation, Direct);
+    Test(2, 2, 1, 24, 40, {1, 9, 7}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, {1, 1, 1}, false, 1.0f,
+         MlasIdentityActivation, Direct);
+    Test(2, 1, 2, 16, 8, {1, 33, 33}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, {1, 1, 1}, true, 0.5f,
+         MlasReluActivation, Direct);
+    Test(2, 1, 1, 32, 64, {1, 15, 15}, {1, 1, 1}, {0, 0, 0}, {1, 2, 2}, {1, 1, 1}, true, 0.0f,
+         MlasIdentityActivation, Expand);
+
+    //
+    // General convolutions.
+    //
+
+    Test(2, 1, 1, 3, 16, {1, 32, 32}, {1, 3, 3}, {0, 1, 1}, {1, 2, 2}, {1, 1, 1}, true, 0.0f,
+         MlasReluActivation, Expand);
+    Test(2, 2, 1, 17, 23, {1, 11, 13}, {1, 3, 3}, {0, 1, 1}, {1, 1, 1}, {1, 1, 1}, true, 1.0f,
+         MlasIdentityActivation, Expand);
+    Test(2, 1, 4, 8, 12, {1, 12, 10}, {1, 3, 5}, {0, 2, 2}, {1, 1, 2}, {1, 2, 1}, false, 0.0f,
+         MlasReluActivation, Expand);
+    Test(2, 1, 1, 64, 64, {1, 28, 28}, {1, 3, 3}, {0, 1, 1}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasIdentityActivation, Expand);
+    Test(1, 3, 1, 16, 20, {1, 1, 50}, {1, 1, 5}, {0, 0, 2}, {1, 1, 1}, {1, 1, 2}, true, 0.0f,
+         MlasReluActivation, Expand);
+    Test(3, 1, 1, 8, 16, {6, 7, 8}, {3, 3, 3}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasIdentityActivation, Expand);
+    Test(3, 2, 2, 4, 6, {5, 9, 6}, {1, 1, 1}, {0, 0, 0}, {1, 1, 1}, {1, 1, 1}, false, 0.5f,
+         MlasIdentityActivation, Direct);
+
+    //
+    // Depthwise convolutions.
+    //
+
+    for (size_t Channels : {1, 7, 8, 32, 45}) {
+      Test(2, 1, Channels, 1, 1, {1, 17, 19}, {1, 3, 3}, {0, 1, 1}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+           MlasReluActivation, Depthwise);
+      Test(2, 2, Channels, 1, 1, {1, 16, 16}, {1, 3, 3}, {0, 1, 1}, {1, 2, 2}, {1, 1, 1}, false, 1.0f,
+           MlasIdentityActivation, Depthwise);
+    }
+
+    Test(2, 1, 96, 1, 1, {1, 14, 14}, {1, 5, 5}, {0, 2, 2}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasIdentityActivation, Depthwise);
+    Test(2, 1, 24, 1, 1, {1, 12, 12}, {1, 3, 3}, {0, 2, 2}, {1, 1, 1}, {1, 2, 2}, true, 0.5f,
+         MlasReluActivation, Depthwise);
+    Test(1, 1, 40, 1, 1, {1, 1, 30}, {1, 1, 7}, {0, 0, 3}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasIdentityActivation, Depthwise);
+    Test(3, 1, 16, 1, 1, {4, 6, 5}, {3, 3, 3}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, true, 0.0f,
+         MlasReluActivation, Depthwise);
+  }
+};
+
+template <>
+MlasConvNhwcTest<false>* MlasTestFixture<MlasConvNhwcTest<false>>::mlas_tester(nullptr);
+template <>
+MlasConvNhwcTest<true>* MlasTestFixture<MlasConvNhwcTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvNhwcTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConvNhwcTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,180 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv_sym.cpp
+
+Abstract:
+
+    Tests for the MLAS symmetric quantized convolution with an indirection
+    buffer or direct input rows.
+
+--*/
+
+#include "test_util.h"
+
+template <typename T8Bits>
+class MlasConvSymTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T8Bits> BufferInput;
+  MatrixGuardBuffer<int8_t> BufferFilter;
+  MatrixGuardBuffer<int8_t> BufferPackedFilter;
+  MatrixGuardBuffer<T8Bits> BufferOutput;
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_signed<T8Bits>::value ? "ConvSym_S8S8" : "ConvSym_U8S8");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t InputChannels,
+            size_t OutputChannels,
+            size_t KernelSize,
+            size_t OutputCount,
+            bool InputDirect,
+            bool PerChannelScale) {
+    constexpr bool InputIsSigned = std::is_signed<T8Bits>::value;
+
+    const size_t PackedFilterSize = MlasConvSymPackWSize(1, InputChannels, OutputChannels, KernelSize, InputIsSigned);
+    if (PackedFilterSize == 0) {
+      // The symmetric convolution is not supported for this platform or shape.
+      return;
+    }
+
+    const int32_t InputZeroPoint = InputIsSigned ? -3 : 131;
+    const int32_t OutputZeroPoint = InputIsSigned ? 5 : 120;
+
+    //
+    // The input rows are shared by the output elements through a random
+    // indirection buffer, else each output element reads its own row.
+    //
+
+    const size_t InputRowCount = InputDirect ? OutputCount : 37;
+    T8Bits* Input = BufferInput.GetBuffer(InputRowCount * InputChannels);
+    int8_t* Filter = BufferFilter.GetBuffer(OutputChannels * InputChannels * KernelSize);
+    int8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+    T8Bits* Output = BufferOutput.GetBuffer(OutputCount * OutputChannels);
+
+    std::default_random_engine generator(static_cast<unsigned>(InputChannels * 131 + OutputChannels * 17 +
+                                                               KernelSize * 7 + OutputCount));
+    std::uniform_int_distribution<int> input_distribution(std::numeric_limits<T8Bits>::lowest(),
+                                                          std::numeric_limits<T8Bits>::max());
+    std::uniform_int_distribution<int> filter_distribution(-127, 127);
+    std::uniform_int_distribution<size_t> row_distribution(0, InputRowCount - 1);
+    const float ScaleRange = 1.0f / std::sqrt(float(InputChannels * KernelSize));
+    std::uniform_real_distribution<float> scale_distribution(0.005f * ScaleRange, 0.015f * ScaleRange);
+    std::uniform_int_distribution<int32_t> bias_distribution(-4000, 4000);
+
+    for (size_t i = 0; i < InputRowCount * InputChannels; i++) {
+      Input[i] = static_cast<T8Bits>(input_distribution(generator));
+    }
+    for (size_t i = 0; i < OutputChannels * InputChannels * KernelSize; i++) {
+      Filter[i] = static_cast<int8_t>(filter_distribution(generator));
+    }
+
+    std::vector<const void*> Indirection(OutputCount * KernelSize);
+    for (size_t i = 0; i < Indirection.size(); i++) {
+      Indirection[i] = Input + (InputDirect ? i : row_distribution(generator)) * InputChannels;
+    }
+
+    std::vector<int32_t> Bias(OutputChannels);
+    std::vector<float> Scale(PerChannelScale ? OutputChannels : 1);
+    for (auto& b : Bias) {
+      b = bias_distribution(generator);
+    }
+    for (auto& s : Scale) {
+      s = scale_distribution(generator);
+    }
+
+    //
+    // Fold the input zero point into the bias as done by QLinearConv.
+    //
+
+    const size_t KernelDim = InputChannels * KernelSize;
+    const int32_t InputZeroPointFixup = MlasConvSymFixupInputZeroPoint(InputZeroPoint, InputIsSigned);
+    std::vector<int32_t> ColumnSums(OutputChannels);
+    for (size_t oc = 0; oc < OutputChannels; oc++) {
+      int32_t sum = 0;
+      for (size_t k = 0; k < KernelDim; k++) {
+        sum += Filter[oc * KernelDim + k];
+      }
+      ColumnSums[oc] = Bias[oc] - sum * InputZeroPointFixup;
+    }
+
+    MlasConvSymPackW(1, InputChannels, OutputChannels, KernelSize, Filter, PackedFilter, PackedFilterSize, InputIsSigned);
+
+    MLAS_CONV_SYM_PARAMS Params = {};
+    if (InputDirect) {
+      Params.InputDirect = Input;
+    } else {
+      Params.InputIndirection = Indirection.data();
+    }
+    Params.Filter = PackedFilter;
+    Params.Output = Output;
+    Params.InputChannels = InputChannels;
+    Params.OutputChannels = OutputChannels;
+    Params.OutputCount = OutputCount;
+    Params.KernelSize = KernelSize;
+    Params.Bias = ColumnSums.data();
+    Params.Scale = Scale.data();
+    Params.PerChannelScale = PerChannelScale;
+    Params.OutputZeroPoint = OutputZeroPoint;
+    Params.InputIsSigned = InputIsSigned;
+
+    MlasConvSym(Params);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t oc = 0; oc < OutputChannels; oc++) {
+        int32_t Accumulator = Bias[oc];
+        for (size_t k = 0; k < KernelSize; k++) {
+          const T8Bits* row = static_cast<const T8Bits*>(Indirection[o * KernelSize + k]);
+          for (size_t ic = 0; ic < InputChannels; ic++) {
+            Accumulator += (int32_t(row[ic]) - InputZeroPoint) * int32_t(Filter[oc * KernelDim + ic * KernelSize + k]);
+          }
+        }
+
+        float Value = float(Accumulator) * Scale[PerChannelScale ? oc : 0];
+        int32_t Expected = int32_t(std::nearbyintf(Value)) + OutputZeroPoint;
+        Expected = std::min(std::max(Expected, int32_t(std::numeric_limits<T8Bits>::lowest())),
+                            int32_t(std::numeric_limits<T8Bits>::max()));
+
+        ASSERT_EQ(int32_t(Output[o * OutputChannels + oc]), Expected)
+            << "IC" << InputChannels << "/OC" << OutputChannels << "/K" << KernelSize << "/N" << OutputCount
+            << "/Direct" << InputDirect << "/PerChannel" << PerChannelScale << " @" << o << "," << oc;
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t InputChannels : {4, 12, 64, 96, 260}) {
+      for (size_t OutputChannels : {16, 24, 40, 64, 100}) {
+        for (size_t OutputCount : {1, 7, 16, 32, 45}) {
+          Test(InputChannels, OutputChannels, 9, OutputCount, false, (OutputCount & 1) != 0);
+          Test(InputChannels, OutputChannels, 1, OutputCount, true, (OutputCount & 1) == 0);
+        }
+      }
+    }
+
+    Test(32, 48, 25, 300, false, true);
+    Test(128, 64, 1, 300, true, false);
+    Test(256, 32, 4, 253, false, true);
+  }
+};
+
+template <>
+MlasConvSymTest<uint8_t>* MlasTestFixture<MlasConvSymTest<uint8_t>>::mlas_tester(nullptr);
+template <>
+MlasConvSymTest<int8_t>* MlasTestFixture<MlasConvSymTest<int8_t>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvSymTest<uint8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasConvSymTest<int8_t>>::RegisterShortExecute();
+  }
+  return count;
+});
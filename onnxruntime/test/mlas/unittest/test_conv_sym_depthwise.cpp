@@ -0,0 +1,173 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv_sym_depthwise.cpp
+
+Abstract:
+
+    Tests for the MLAS symmetric quantized depthwise convolution, including
+    the kernels specialized for 3x3 and 5x5 filters.
+
+--*/
+
+#include "test_util.h"
+
+template <typename T8Bits>
+class MlasConvSymDepthwiseTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T8Bits> BufferInput;
+  MatrixGuardBuffer<int8_t> BufferFilter;
+  MatrixGuardBuffer<int8_t> BufferPackedFilter;
+  MatrixGuardBuffer<T8Bits> BufferOutput;
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_signed<T8Bits>::value ? "ConvSymDepthwise_S8S8" : "ConvSymDepthwise_U8S8");
+    return suite_name.c_str();
+  }
+
+  void Test(size_t Channels,
+            size_t KernelSize,
+            size_t OutputCount,
+            int32_t InputZeroPoint,
+            int32_t OutputZeroPoint,
+            bool PerChannelScale) {
+    constexpr bool InputIsSigned = std::is_signed<T8Bits>::value;
+
+    const size_t PackedFilterSize = MlasConvSymPackWSize(Channels, 1, 1, KernelSize, InputIsSigned);
+    if (PackedFilterSize == 0) {
+      // The symmetric convolution is not supported for this platform or shape.
+      return;
+    }
+
+    //
+    // The input rows are shared by the output elements through a random
+    // indirection buffer, with the last row holding the padding values.
+    //
+
+    const size_t InputRowCount = 37;
+    T8Bits* Input = BufferInput.GetBuffer(InputRowCount * Channels);
+    int8_t* Filter = BufferFilter.GetBuffer(Channels * KernelSize);
+    int8_t* PackedFilter = BufferPackedFilter.GetBuffer(PackedFilterSize);
+    T8Bits* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+
+    std::default_random_engine generator(static_cast<unsigned>(Channels * 131 + KernelSize * 7 + OutputCount));
+    std::uniform_int_distribution<int> input_distribution(std::numeric_limits<T8Bits>::lowest(),
+                                                          std::numeric_limits<T8Bits>::max());
+    std::uniform_int_distribution<int> filter_distribution(-127, 127);
+    std::uniform_int_distribution<size_t> row_distribution(0, InputRowCount - 1);
+    std::uniform_real_distribution<float> scale_distribution(0.0005f, 0.004f);
+    std::uniform_int_distribution<int32_t> bias_distribution(-4000, 4000);
+
+    for (size_t i = 0; i < (InputRowCount - 1) * Channels; i++) {
+      Input[i] = static_cast<T8Bits>(input_distribution(generator));
+    }
+    for (size_t i = (InputRowCount - 1) * Channels; i < InputRowCount * Channels; i++) {
+      Input[i] = static_cast<T8Bits>(InputZeroPoint);
+    }
+    for (size_t i = 0; i < Channels * KernelSize; i++) {
+      Filter[i] = static_cast<int8_t>(filter_distribution(generator));
+    }
+
+    std::vector<const void*> Indirection(OutputCount * KernelSize);
+    for (auto& row : Indirection) {
+      row = Input + row_distribution(generator) * Channels;
+    }
+
+    std::vector<int32_t> Bias(Channels);
+    std::vector<float> Scale(PerChannelScale ? Channels : 1);
+    for (auto& b : Bias) {
+      b = bias_distribution(generator);
+    }
+    for (auto& s : Scale) {
+      s = scale_distribution(generator);
+    }
+
+    //
+    // Fold the input zero point into the bias as done by QLinearConv.
+    //
+
+    const int32_t InputZeroPointFixup = MlasConvSymFixupInputZeroPoint(InputZeroPoint, InputIsSigned);
+    std::vector<int32_t> ColumnSums(Channels);
+    for (size_t c = 0; c < Channels; c++) {
+      int32_t sum = 0;
+      for (size_t k = 0; k < KernelSize; k++) {
+        sum += Filter[c * KernelSize + k];
+      }
+      ColumnSums[c] = Bias[c] - sum * InputZeroPointFixup;
+    }
+
+    MlasConvSymPackW(Channels, 1, 1, KernelSize, Filter, PackedFilter, PackedFilterSize, InputIsSigned);
+
+    MLAS_CONV_SYM_PARAMS Params = {};
+    Params.InputIndirection = Indirection.data();
+    Params.Filter = PackedFilter;
+    Params.Output = Output;
+    Params.InputChannels = Channels;
+    Params.OutputChannels = Channels;
+    Params.OutputCount = OutputCount;
+    Params.KernelSize = KernelSize;
+    Params.Bias = ColumnSums.data();
+    Params.Scale = Scale.data();
+    Params.PerChannelScale = PerChannelScale;
+    Params.OutputZeroPoint = OutputZeroPoint;
+    Params.InputIsSigned = InputIsSigned;
+
+    MlasConvSymDepthwise(Params);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      for (size_t c = 0; c < Channels; c++) {
+        int32_t Accumulator = Bias[c];
+        for (size_t k = 0; k < KernelSize; k++) {
+          const T8Bits* row = static_cast<const T8Bits*>(Indirection[o * KernelSize + k]);
+          Accumulator += (int32_t(row[c]) - InputZeroPoint) * int32_t(Filter[c * KernelSize + k]);
+        }
+
+        float Value = float(Accumulator) * Scale[PerChannelScale ? c : 0];
+        int32_t Expected = int32_t(std::nearbyintf(Value)) + OutputZeroPoint;
+        Expected = std::min(std::max(Expected, int32_t(std::numeric_limits<T8Bits>::lowest())),
+                            int32_t(std::numeric_limits<T8Bits>::max()));
+
+        ASSERT_EQ(int32_t(Output[o * Channels + c]), Expected)
+            << "C" << Channels << "/K" << KernelSize << "/N" << OutputCount
+            << "/PerChannel" << PerChannelScale << " @" << o << "," << c;
+      }
+    }
+  }
+
+  void ExecuteShort(void) override {
+    const int32_t InputZeroPoint = std::is_signed<T8Bits>::value ? -3 : 131;
+    const int32_t OutputZeroPoint = std::is_signed<T8Bits>::value ? 5 : 120;
+
+    for (size_t Channels : {16, 32, 48, 64, 96, 112, 144}) {
+      for (size_t KernelSize : {4, 9, 25}) {
+        for (bool PerChannelScale : {false, true}) {
+          Test(Channels, KernelSize, 7, InputZeroPoint, OutputZeroPoint, PerChannelScale);
+        }
+      }
+    }
+
+    Test(8, 9, 5, InputZeroPoint, OutputZeroPoint, false);
+    Test(24, 25, 5, InputZeroPoint, OutputZeroPoint, true);
+    Test(512, 9, 3, InputZeroPoint, OutputZeroPoint, true);
+  }
+};
+
+template <>
+MlasConvSymDepthwiseTest<uint8_t>* MlasTestFixture<MlasConvSymDepthwiseTest<uint8_t>>::mlas_tester(nullptr);
+template <>
+MlasConvSymDepthwiseTest<int8_t>* MlasTestFixture<MlasConvSymDepthwiseTest<int8_t>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConvSymDepthwiseTest<uint8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasConvSymDepthwiseTest<int8_t>>::RegisterShortExecute();
+  }
+  return count;
+});
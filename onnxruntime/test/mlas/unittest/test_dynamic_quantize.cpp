@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <typename xint8_t, bool Threaded>
+class MlasDynamicQuantizeLinearTest : public MlasTestBase {
+ private:
+  MLAS_THREADPOOL* threadpool_;
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<xint8_t> BufferOutput;
+  MatrixGuardBuffer<xint8_t> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferScales;
+  MatrixGuardBuffer<xint8_t> BufferZeroPoints;
+
+  static void ReferenceParameters(const float* Input, size_t N, float* Scale, xint8_t* ZeroPoint) {
+    constexpr float qmin = float(std::numeric_limits<xint8_t>::lowest());
+    constexpr float qmax = float(std::numeric_limits<xint8_t>::max());
+
+    float Minimum = 0.0f;
+    float Maximum = 0.0f;
+    for (size_t n = 0; n < N; n++) {
+      Minimum = std::min(Minimum, Input[n]);
+      Maximum = std::max(Maximum, Input[n]);
+    }
+
+    *Scale = (Maximum == Minimum) ? 1.0f : (Maximum - Minimum) / (qmax - qmin);
+
+    const float InitialZeroPoint = std::max(qmin, std::min(qmax, qmin - Minimum / *Scale));
+    *ZeroPoint = static_cast<xint8_t>(InitialZeroPoint - std::remainderf(InitialZeroPoint, 1.0f));
+  }
+
+  static void ReferenceQuantize(const float* Input, xint8_t* Output, size_t N, float Scale, xint8_t ZeroPoint) {
+    for (size_t n = 0; n < N; n++) {
+      float FloatValue = std::nearbyintf(Input[n] / Scale) + float(ZeroPoint);
+      FloatValue = std::max(FloatValue, float(std::numeric_limits<xint8_t>::min()));
+      FloatValue = std::min(FloatValue, float(std::numeric_limits<xint8_t>::max()));
+      Output[n] = static_cast<xint8_t>(FloatValue);
+    }
+  }
+
+  void FillInput(float* Input, size_t N, unsigned Seed, float MinimumValue, float MaximumValue) {
+    std::default_random_engine generator(Seed);
+    std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = distribution(generator);
+    }
+  }
+
+  void Test(size_t N, float MinimumValue, float MaximumValue) {
+    float* Input = BufferInput.GetBuffer(N);
+    xint8_t* Output = BufferOutput.GetBuffer(N);
+    xint8_t* OutputReference = BufferOutputReference.GetBuffer(N);
+
+    FillInput(Input, N, static_cast<unsigned>(N), MinimumValue, MaximumValue);
+
+    float ScaleReference;
+    xint8_t ZeroPointReference;
+    ReferenceParameters(Input, N, &ScaleReference, &ZeroPointReference);
+    ReferenceQuantize(Input, OutputReference, N, ScaleReference, ZeroPointReference);
+
+    float Scale;
+    xint8_t ZeroPoint;
+    MlasDynamicQuantizeLinear(Input, Output, N, &Scale, &ZeroPoint, threadpool_);
+
+    ASSERT_EQ(Scale, ScaleReference) << ", size=" << N;
+    ASSERT_EQ(ZeroPoint, ZeroPointReference) << ", size=" << N;
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(Output[n], OutputReference[n]) << ", size=" << N << ", index=" << n;
+    }
+  }
+
+  void TestPerRow(size_t Rows, size_t Columns) {
+    const size_t ld = Columns + 3;
+    float* Input = BufferInput.GetBuffer(Rows * ld);
+    xint8_t* Output = BufferOutput.GetBuffer(Rows * ld, true);
+    xint8_t* OutputReference = BufferOutputReference.GetBuffer(Rows * ld, true);
+    float* Scales = BufferScales.GetBuffer(Rows);
+    xint8_t* ZeroPoints = BufferZeroPoints.GetBuffer(Rows);
+
+    FillInput(Input, Rows * ld, static_cast<unsigned>(Rows * 131 + Columns), -3.0f, 7.0f);
+
+    MlasDynamicQuantizeLinearPerRow(Input, ld, Output, ld, Rows, Columns, Scales, ZeroPoints, threadpool_);
+
+    for (size_t row = 0; row < Rows; row++) {
+      float ScaleReference;
+      xint8_t ZeroPointReference;
+      ReferenceParameters(Input + row * ld, Columns, &ScaleReference, &ZeroPointReference);
+      ReferenceQuantize(Input + row * ld, OutputReference + row * ld, Columns, ScaleReference, ZeroPointReference);
+
+      ASSERT_EQ(Scales[row], ScaleReference) << ", row=" << row;
+      ASSERT_EQ(ZeroPoints[row], ZeroPointReference) << ", row=" << row;
+      for (size_t n = 0; n < ld; n++) {
+        ASSERT_EQ(Output[row * ld + n], OutputReference[row * ld + n])
+            << ", rows=" << Rows << ", columns=" << Columns << ", row=" << row << ", index=" << n;
+      }
+    }
+  }
+
+ public:
+  MlasDynamicQuantizeLinearTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string(std::is_signed<xint8_t>::value ? "DynamicQuantizeLinearS8" : "DynamicQuantizeLinearU8") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t n = 1; n <= 128; n++) {
+      Test(n, -10.0f, 10.0f);
+    }
+
+    // All positive, all negative and constant inputs widen the range to zero.
+    Test(77, 0.5f, 4.0f);
+    Test(77, -4.0f, -0.5f);
+    Test(77, 0.0f, 0.0f);
+
+    // Large enough to be split across threads.
+    Test(100000, -2.0f, 5.0f);
+    Test(1000003, -7.0f, 1.0f);
+
+    TestPerRow(1, 1);
+    TestPerRow(7, 33);
+    TestPerRow(64, 768);
+    TestPerRow(300, 1024);
+  }
+};
+
+template <>
+MlasDynamicQuantizeLinearTest<int8_t, false>* MlasTestFixture<MlasDynamicQuantizeLinearTest<int8_t, false>>::mlas_tester(nullptr);
+template <>
+MlasDynamicQuantizeLinearTest<uint8_t, false>* MlasTestFixture<MlasDynamicQuantizeLinearTest<uint8_t, false>>::mlas_tester(nullptr);
+template <>
+MlasDynamicQuantizeLinearTest<int8_t, true>* MlasTestFixture<MlasDynamicQuantizeLinearTest<int8_t, true>>::mlas_tester(nullptr);
+template <>
+MlasDynamicQuantizeLinearTest<uint8_t, true>* MlasTestFixture<MlasDynamicQuantizeLinearTest<uint8_t, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasDynamicQuantizeLinearTest<int8_t, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasDynamicQuantizeLinearTest<uint8_t, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasDynamicQuantizeLinearTest<int8_t, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasDynamicQuantizeLinearTest<uint8_t, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
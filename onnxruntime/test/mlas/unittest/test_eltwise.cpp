@@ -0,0 +1,261 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_eltwise.cpp
+
+Abstract:
+
+    Tests for the MLAS element-wise binary operations with broadcasting.
+
+--*/
+
+#include "test_fp16.h"
+
+template <typename T, bool Threaded>
+class MlasEltwiseTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInputA;
+  MatrixGuardBuffer<T> BufferInputB;
+  MatrixGuardBuffer<T> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  using MlasType = typename std::conditional<std::is_same<T, MLFp16>::value, MLAS_FP16, T>::type;
+
+  static constexpr bool IsInteger = std::is_integral<T>::value;
+
+  using ValueType = typename std::conditional<IsInteger, T, float>::type;
+
+  static void FillInputA(T* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      const int Value = int((i * 7) % 23) - 11;
+      start[i] = IsInteger ? T(Value * 1001) : T(float(Value) * 0.125f);
+    }
+  }
+
+  //
+  // The second input is never zero so that the division is defined for the
+  // integer types.
+  //
+
+  static void FillInputB(T* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      const int Value = (int((i * 5) % 13) + 1) * (((i / 3) % 2 == 0) ? 1 : -1);
+      start[i] = IsInteger ? T(Value) : T(float(Value) * 0.25f);
+    }
+  }
+
+  static size_t ShapeLength(MLAS_BROADCAST_SHAPE Shape, size_t M, size_t N) {
+    switch (Shape) {
+      case MlasBroadcastScalar:
+        return 1;
+      case MlasBroadcastRow:
+        return N;
+      case MlasBroadcastColumn:
+        return M;
+      default:
+        return M * N;
+    }
+  }
+
+  static size_t ShapeIndex(MLAS_BROADCAST_SHAPE Shape, size_t m, size_t n, size_t N) {
+    switch (Shape) {
+      case MlasBroadcastScalar:
+        return 0;
+      case MlasBroadcastRow:
+        return n;
+      case MlasBroadcastColumn:
+        return m;
+      default:
+        return m * N + n;
+    }
+  }
+
+  static ValueType Reference(MLAS_ELTWISE_BINARY_OP Op, ValueType a, ValueType b) {
+    switch (Op) {
+      case MlasEltwiseAdd:
+        return a + b;
+      case MlasEltwiseSub:
+        return a - b;
+      case MlasEltwiseMul:
+        return a * b;
+      case MlasEltwiseDiv:
+        return a / b;
+      case MlasEltwiseMax:
+        return std::max(a, b);
+      default:
+        return std::min(a, b);
+    }
+  }
+
+ public:
+  MlasEltwiseTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(MLAS_ELTWISE_BINARY_OP Op, MLAS_BROADCAST_SHAPE ShapeA, MLAS_BROADCAST_SHAPE ShapeB,
+            size_t M, size_t N, bool InPlace) {
+    T* InputA = BufferInputA.GetFilledBuffer(ShapeLength(ShapeA, M, N), FillInputA);
+    const T* InputB = BufferInputB.GetFilledBuffer(ShapeLength(ShapeB, M, N), FillInputB);
+
+    std::vector<T> Expected(M * N);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const ValueType a = ValueType(InputA[ShapeIndex(ShapeA, m, n, N)]);
+        const ValueType b = ValueType(InputB[ShapeIndex(ShapeB, m, n, N)]);
+        Expected[m * N + n] = T(Reference(Op, a, b));
+      }
+    }
+
+    T* Output = InPlace ? InputA : BufferOutput.GetBuffer(M * N, true);
+
+    MlasEltwiseBinary(Op, reinterpret_cast<const MlasType*>(InputA), ShapeA,
+                      reinterpret_cast<const MlasType*>(InputB), ShapeB,
+                      reinterpret_cast<MlasType*>(Output), M, N, threadpool_);
+
+    for (size_t i = 0; i < M * N; i++) {
+      if (IsInteger) {
+        ASSERT_EQ(Output[i], Expected[i])
+            << "Op=" << int(Op) << ", ShapeA=" << int(ShapeA) << ", ShapeB=" << int(ShapeB)
+            << ", M=" << M << ", N=" << N << " @" << i;
+      } else {
+        const float Value = float(Expected[i]);
+        ASSERT_NEAR(float(Output[i]), Value, std::fabs(Value) * 1e-6f)
+            << "Op=" << int(Op) << ", ShapeA=" << int(ShapeA) << ", ShapeB=" << int(ShapeB)
+            << ", M=" << M << ", N=" << N << " @" << i;
+      }
+    }
+  }
+
+  //
+  // The maximum and minimum return NaN if either input is NaN, regardless of
+  // whether the element is handled by the vector loops or the scalar tail.
+  //
+
+  void TestNaN(MLAS_ELTWISE_BINARY_OP Op, MLAS_BROADCAST_SHAPE ShapeA, MLAS_BROADCAST_SHAPE ShapeB,
+               size_t M, size_t N) {
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+
+    T* InputA = BufferInputA.GetFilledBuffer(ShapeLength(ShapeA, M, N), FillInputA);
+    T* InputB = BufferInputB.GetFilledBuffer(ShapeLength(ShapeB, M, N), FillInputB);
+
+    for (size_t i = 0; i < ShapeLength(ShapeA, M, N); i += 5) {
+      InputA[i] = T(NaN);
+    }
+    for (size_t i = 1; i < ShapeLength(ShapeB, M, N); i += 3) {
+      InputB[i] = T(NaN);
+    }
+
+    T* Output = BufferOutput.GetBuffer(M * N, true);
+
+    MlasEltwiseBinary(Op, reinterpret_cast<const MlasType*>(InputA), ShapeA,
+                      reinterpret_cast<const MlasType*>(InputB), ShapeB,
+                      reinterpret_cast<MlasType*>(Output), M, N, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float a = float(InputA[ShapeIndex(ShapeA, m, n, N)]);
+        const float b = float(InputB[ShapeIndex(ShapeB, m, n, N)]);
+        const float Value = float(Output[m * N + n]);
+        if (std::isnan(a) || std::isnan(b)) {
+          ASSERT_TRUE(std::isnan(Value))
+              << "Op=" << int(Op) << ", ShapeA=" << int(ShapeA) << ", ShapeB=" << int(ShapeB)
+              << ", M=" << M << ", N=" << N << " @" << m << "x" << n;
+        } else {
+          ASSERT_EQ(Value, Reference(Op, a, b))
+              << "Op=" << int(Op) << ", ShapeA=" << int(ShapeA) << ", ShapeB=" << int(ShapeB)
+              << ", M=" << M << ", N=" << N << " @" << m << "x" << n;
+        }
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Eltwise") +
+                                          (std::is_same<T, float>::value     ? "_Fp32"
+                                           : std::is_same<T, MLFp16>::value  ? "_Fp16"
+                                           : std::is_same<T, int32_t>::value ? "_Int32"
+                                                                             : "_Int64") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const std::pair<MLAS_BROADCAST_SHAPE, MLAS_BROADCAST_SHAPE> Shapes[] = {
+        {MlasBroadcastNone, MlasBroadcastNone},
+        {MlasBroadcastScalar, MlasBroadcastNone},
+        {MlasBroadcastNone, MlasBroadcastScalar},
+        {MlasBroadcastRow, MlasBroadcastNone},
+        {MlasBroadcastNone, MlasBroadcastRow},
+        {MlasBroadcastColumn, MlasBroadcastNone},
+        {MlasBroadcastNone, MlasBroadcastColumn},
+        {MlasBroadcastColumn, MlasBroadcastRow},
+        {MlasBroadcastRow, MlasBroadcastColumn},
+        {MlasBroadcastScalar, MlasBroadcastRow},
+        {MlasBroadcastColumn, MlasBroadcastScalar},
+    };
+
+    for (MLAS_ELTWISE_BINARY_OP Op : {MlasEltwiseAdd, MlasEltwiseSub, MlasEltwiseMul,
+                                      MlasEltwiseDiv, MlasEltwiseMax, MlasEltwiseMin}) {
+      for (const auto& Shape : Shapes) {
+        Test(Op, Shape.first, Shape.second, 1, 1, false);
+        Test(Op, Shape.first, Shape.second, 1, 37, false);
+        Test(Op, Shape.first, Shape.second, 3, 7, false);
+        Test(Op, Shape.first, Shape.second, 5, 64, false);
+        Test(Op, Shape.first, Shape.second, 67, 3, false);
+        Test(Op, Shape.first, Shape.second, 9, 301, false);
+        Test(Op, Shape.first, Shape.second, 131, 259, false);
+      }
+      Test(Op, MlasBroadcastNone, MlasBroadcastNone, 33, 1027, true);
+      Test(Op, MlasBroadcastNone, MlasBroadcastRow, 33, 1027, true);
+      Test(Op, MlasBroadcastNone, MlasBroadcastColumn, 33, 1027, true);
+    }
+
+    if constexpr (!IsInteger) {
+      for (MLAS_ELTWISE_BINARY_OP Op : {MlasEltwiseMax, MlasEltwiseMin}) {
+        for (const auto& Shape : Shapes) {
+          TestNaN(Op, Shape.first, Shape.second, 1, 1);
+          TestNaN(Op, Shape.first, Shape.second, 1, 37);
+          TestNaN(Op, Shape.first, Shape.second, 3, 7);
+          TestNaN(Op, Shape.first, Shape.second, 9, 301);
+        }
+      }
+    }
+  }
+};
+
+template <>
+MlasEltwiseTest<float, false>* MlasTestFixture<MlasEltwiseTest<float, false>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<float, true>* MlasTestFixture<MlasEltwiseTest<float, true>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<MLFp16, false>* MlasTestFixture<MlasEltwiseTest<MLFp16, false>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<MLFp16, true>* MlasTestFixture<MlasEltwiseTest<MLFp16, true>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<int32_t, false>* MlasTestFixture<MlasEltwiseTest<int32_t, false>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<int32_t, true>* MlasTestFixture<MlasEltwiseTest<int32_t, true>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<int64_t, false>* MlasTestFixture<MlasEltwiseTest<int64_t, false>>::mlas_tester(nullptr);
+template <>
+MlasEltwiseTest<int64_t, true>* MlasTestFixture<MlasEltwiseTest<int64_t, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasEltwiseTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEltwiseTest<MLFp16, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEltwiseTest<int32_t, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasEltwiseTest<int64_t, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasEltwiseTest<float, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasEltwiseTest<MLFp16, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasEltwiseTest<int32_t, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasEltwiseTest<int64_t, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
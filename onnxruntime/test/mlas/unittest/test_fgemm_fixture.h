@@ -66,10 +66,19 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     for (size_t b = 256; b < 320; b += 32) {
       test_registered += RegisterTestTransposeABProduct(b, b, b, 1, 1.0f, 0.0f);
     }
+    for (size_t M = 1; M <= 4; M++) {
+      test_registered += RegisterTestTransposeABProduct(M, 300, 33, 1, 0.5f, 1.0f);
+      test_registered += RegisterTestTransposeABProduct(M, 777, 258, 1, -1.0f, 0.25f);
+      test_registered += RegisterTestTransposeABProduct(M, 2048, 17, 1, 1.0f, 0.0f);
+    }
 
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+
+    // Small output matrices with a long K dimension may be split along K.
+    test_registered += RegisterTestTransposeABProduct(3, 40, 4096, 1, 1.0f, 0.5f);
+    test_registered += RegisterTestTransposeABProduct(16, 17, 2304, 2, -1.0f, 1.0f);
     return test_registered;
   }
 
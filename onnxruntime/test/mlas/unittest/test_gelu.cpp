@@ -0,0 +1,143 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_gelu.cpp
+
+Abstract:
+
+    Tests for the MLAS GELU activation with an optional bias.
+
+--*/
+
+#include "test_util.h"
+
+class MlasGeluTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+
+  static double Reference(MLAS_GELU_KIND Kind, double Value, double Alpha) {
+    switch (Kind) {
+      case MlasGeluErf:
+        return 0.5 * Value * (1.0 + std::erf(Value * 0.7071067811865476));
+      case MlasGeluTanh:
+        return 0.5 * Value * (1.0 + std::tanh(0.7978845608028654 * (Value + 0.044715 * Value * Value * Value)));
+      default:
+        return Value / (1.0 + std::exp(-Alpha * Value));
+    }
+  }
+
+ public:
+  void Test(MLAS_GELU_KIND Kind, size_t N, size_t BiasLength, bool InPlace) {
+    const float Alpha = 1.702f;
+
+    float* Input = BufferInput.GetBuffer(N);
+    for (size_t i = 0; i < N; i++) {
+      Input[i] = float(int((i * 13) % 97) - 48) * 0.125f;
+    }
+
+    const float* Bias = nullptr;
+    if (BiasLength != 0) {
+      float* BiasBuffer = BufferBias.GetBuffer(BiasLength);
+      for (size_t i = 0; i < BiasLength; i++) {
+        BiasBuffer[i] = float(int((i * 7) % 11) - 5) * 0.0625f;
+      }
+      Bias = BiasBuffer;
+    }
+
+    std::vector<float> Expected(N);
+    for (size_t i = 0; i < N; i++) {
+      const float Value = Input[i] + ((Bias != nullptr) ? Bias[i % BiasLength] : 0.0f);
+      Expected[i] = float(Reference(Kind, Value, Alpha));
+    }
+
+    float* Output = InPlace ? Input : BufferOutput.GetBuffer(N, true);
+
+    MlasComputeGelu(Kind, Input, Bias, BiasLength, Output, N, Alpha);
+
+    for (size_t i = 0; i < N; i++) {
+      ASSERT_NEAR(Output[i], Expected[i], std::fabs(Expected[i]) * 2e-5f + 2e-6f)
+          << "Kind=" << int(Kind) << ", N=" << N << ", BiasLength=" << BiasLength
+          << ", InPlace=" << InPlace << " @" << i;
+    }
+  }
+
+  void TestActivation(MLAS_ACTIVATION_KIND ActivationKind, size_t M, size_t N, size_t ldc, bool HasBias) {
+    const float Alpha = 1.5f;
+    const MLAS_GELU_KIND Kind = (ActivationKind == MlasGeluErfActivation)    ? MlasGeluErf
+                                : (ActivationKind == MlasGeluTanhActivation) ? MlasGeluTanh
+                                                                             : MlasGeluQuick;
+
+    float* Buffer = BufferOutput.GetBuffer(M * ldc);
+    for (size_t i = 0; i < M * ldc; i++) {
+      Buffer[i] = float(int((i * 13) % 97) - 48) * 0.125f;
+    }
+
+    float* Bias = nullptr;
+    if (HasBias) {
+      Bias = BufferBias.GetBuffer(M);
+      for (size_t m = 0; m < M; m++) {
+        Bias[m] = float(int(m % 5) - 2) * 0.25f;
+      }
+    }
+
+    std::vector<float> Expected(Buffer, Buffer + M * ldc);
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float Value = Buffer[m * ldc + n] + (HasBias ? Bias[m] : 0.0f);
+        Expected[m * ldc + n] = float(Reference(Kind, Value, Alpha));
+      }
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.QuickGelu.alpha = Alpha;
+
+    MlasActivation(&Activation, Buffer, Bias, M, N, ldc);
+
+    for (size_t i = 0; i < M * ldc; i++) {
+      ASSERT_NEAR(Buffer[i], Expected[i], std::fabs(Expected[i]) * 2e-5f + 2e-6f)
+          << "ActivationKind=" << int(ActivationKind) << ", M=" << M << ", N=" << N << ", ldc=" << ldc
+          << ", Bias=" << HasBias << " @" << i;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Gelu");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (MLAS_GELU_KIND Kind : {MlasGeluErf, MlasGeluTanh, MlasGeluQuick}) {
+      for (size_t N : {1, 3, 4, 7, 16, 33, 255, 256, 257, 1000, 1027}) {
+        Test(Kind, N, 0, false);
+        Test(Kind, N, 0, true);
+        Test(Kind, N, N, false);
+      }
+      for (size_t BiasLength : {1, 5, 64, 300, 768}) {
+        Test(Kind, BiasLength * 3, BiasLength, false);
+        Test(Kind, BiasLength * 3, BiasLength, true);
+      }
+    }
+    for (MLAS_ACTIVATION_KIND ActivationKind : {MlasGeluErfActivation, MlasGeluTanhActivation, MlasQuickGeluActivation}) {
+      for (bool HasBias : {false, true}) {
+        TestActivation(ActivationKind, 1, 17, 17, HasBias);
+        TestActivation(ActivationKind, 9, 33, 33, HasBias);
+        TestActivation(ActivationKind, 9, 33, 40, HasBias);
+      }
+    }
+  }
+};
+
+template <>
+MlasGeluTest* MlasTestFixture<MlasGeluTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasGeluTest>::RegisterShortExecute() : 0;
+});
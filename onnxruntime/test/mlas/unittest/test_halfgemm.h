@@ -118,7 +118,8 @@ class MlasHalfGemmTest : public MlasTestBase {
                       const AType* A,
                       const BType* B,
                       const MLFp16* Bias,
-                      float* C) {
+                      float* C,
+                      bool FloatAccumulation) {
     // TODO!! deal with half precision accumulation error
     // Most CPUs does not support mixed precision accumulation,
     // only mul & add fuse. As a result, different striding
@@ -147,13 +148,19 @@ class MlasHalfGemmTest : public MlasTestBase {
               sum = float(Bias[n]);
             }
             for (size_t kk = 0; kk < std::min(KStride, K - k); kk++) {
-              MLFp16 down(float(*b) * float(*a) + sum);
-              sum = float(down);
+              if (FloatAccumulation) {
+                // Kernels without native fp16 arithmetic (x64 F16C) convert
+                // the inputs and accumulate in single precision.
+                sum += float(MLFp16(float(*b))) * float(MLFp16(float(*a)));
+              } else {
+                MLFp16 down(float(*b) * float(*a) + sum);
+                sum = float(down);
+              }
               b += N;
               a += 1;
             }
             if (k == 0) {
-              *c = sum;
+              *c = float(MLFp16(sum));
             } else {
               MLFp16 d(sum + *c);
               *c = float(d);
@@ -195,7 +202,7 @@ class MlasHalfGemmTest : public MlasTestBase {
         });
 
     this->CallGemm(M, N, K, BatchSize, A, K, B, N, Bias, C, N, Cfloat);
-    ReferenceQgemm(M, N, K, BatchSize, A, B, Bias, CReference);
+    ReferenceQgemm(M, N, K, BatchSize, A, B, Bias, CReference, MlasHalfGemmFloatAccumulation());
 
     for (size_t batch = 0, f = 0; batch < BatchSize; batch++) {
       for (size_t m = 0; m < M; m++) {
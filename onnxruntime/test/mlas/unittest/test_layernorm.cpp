@@ -0,0 +1,186 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_layernorm.cpp
+
+Abstract:
+
+    Tests for the MLAS layer normalization and skip layer normalization.
+
+--*/
+
+#include "test_fp16.h"
+
+template <typename T, bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInput;
+  MatrixGuardBuffer<T> BufferSkip;
+  MatrixGuardBuffer<T> BufferBias;
+  MatrixGuardBuffer<T> BufferGamma;
+  MatrixGuardBuffer<T> BufferBeta;
+  MatrixGuardBuffer<T> BufferOutput;
+  MatrixGuardBuffer<T> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+  MLAS_THREADPOOL* threadpool_;
+
+  using MlasType = typename std::conditional<std::is_same<T, float>::value, float, MLAS_FP16>::type;
+
+  static void FillBuffer(T* start, size_t size, float offset, float scale) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = T(float(int((i * 13) % 31) - 15) * scale + offset);
+    }
+  }
+
+  void Check(const T* Output, const float* Reference, size_t Count, const char* Name,
+             size_t RowCount, size_t RowSize, bool HasSkip, bool HasBias, bool HasBeta, bool Simplified) {
+    const float Tolerance = std::is_same<T, float>::value ? 1e-5f : 4e-3f;
+    for (size_t i = 0; i < Count; i++) {
+      ASSERT_NEAR(float(Output[i]), Reference[i], std::fabs(Reference[i]) * Tolerance + Tolerance)
+          << Name << " @" << i << ", RowCount=" << RowCount << ", RowSize=" << RowSize << ", Skip=" << HasSkip
+          << ", Bias=" << HasBias << ", Beta=" << HasBeta << ", Simplified=" << Simplified;
+    }
+  }
+
+ public:
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t RowCount, size_t RowSize, bool HasSkip, bool HasBias, bool HasBeta, bool Simplified, bool HasSkipOutput) {
+    const size_t Count = RowCount * RowSize;
+
+    const T* Input = BufferInput.GetBuffer(Count);
+    FillBuffer(const_cast<T*>(Input), Count, 0.5f, 0.125f);
+    const T* Skip = nullptr;
+    if (HasSkip) {
+      Skip = BufferSkip.GetBuffer(Count);
+      FillBuffer(const_cast<T*>(Skip), Count, -0.25f, 0.0625f);
+    }
+    const T* Bias = nullptr;
+    if (HasBias) {
+      Bias = BufferBias.GetBuffer(RowSize);
+      FillBuffer(const_cast<T*>(Bias), RowSize, 0.125f, 0.03125f);
+    }
+    const T* Gamma = BufferGamma.GetBuffer(RowSize);
+    FillBuffer(const_cast<T*>(Gamma), RowSize, 1.0f, 0.03125f);
+    const T* Beta = nullptr;
+    if (HasBeta) {
+      Beta = BufferBeta.GetBuffer(RowSize);
+      FillBuffer(const_cast<T*>(Beta), RowSize, 0.0f, 0.0625f);
+    }
+
+    T* Output = BufferOutput.GetBuffer(Count, true);
+    T* SkipOutput = HasSkipOutput ? BufferSkipOutput.GetBuffer(Count, true) : nullptr;
+    float* Mean = BufferMean.GetBuffer(RowCount, true);
+    float* InvStdDev = BufferInvStdDev.GetBuffer(RowCount, true);
+
+    const float Epsilon = 1e-5f;
+
+    std::vector<float> ReferenceOutput(Count);
+    std::vector<float> ReferenceSkipOutput(Count);
+    std::vector<float> ReferenceMean(RowCount);
+    std::vector<float> ReferenceInvStdDev(RowCount);
+
+    for (size_t r = 0; r < RowCount; r++) {
+      std::vector<double> Row(RowSize);
+      double Sum = 0.0;
+      for (size_t n = 0; n < RowSize; n++) {
+        // Round the sum to the element type like the kernel does for the skip output.
+        float Value = float(Input[r * RowSize + n]);
+        if (HasSkip) Value += float(Skip[r * RowSize + n]);
+        if (HasBias) Value += float(Bias[n]);
+        Row[n] = Value;
+        ReferenceSkipOutput[r * RowSize + n] = Value;
+        Sum += Value;
+      }
+      const double MeanValue = Sum / double(RowSize);
+      double Variance = 0.0;
+      for (size_t n = 0; n < RowSize; n++) {
+        const double Value = Simplified ? Row[n] : Row[n] - MeanValue;
+        Variance += Value * Value;
+      }
+      const double InvStdDevValue = 1.0 / std::sqrt(Variance / double(RowSize) + Epsilon);
+      for (size_t n = 0; n < RowSize; n++) {
+        double Value = (Simplified ? Row[n] : Row[n] - MeanValue) * InvStdDevValue * float(Gamma[n]);
+        if (HasBeta) Value += float(Beta[n]);
+        ReferenceOutput[r * RowSize + n] = float(Value);
+      }
+      ReferenceMean[r] = float(MeanValue);
+      ReferenceInvStdDev[r] = float(InvStdDevValue);
+    }
+
+    MLAS_LAYER_NORM_PARAMS<MlasType> Params;
+    Params.Input = reinterpret_cast<const MlasType*>(Input);
+    Params.Skip = reinterpret_cast<const MlasType*>(Skip);
+    Params.Bias = reinterpret_cast<const MlasType*>(Bias);
+    Params.Gamma = reinterpret_cast<const MlasType*>(Gamma);
+    Params.Beta = reinterpret_cast<const MlasType*>(Beta);
+    Params.Output = reinterpret_cast<MlasType*>(Output);
+    Params.SkipOutput = reinterpret_cast<MlasType*>(SkipOutput);
+    Params.Mean = Mean;
+    Params.InvStdDev = InvStdDev;
+    Params.Epsilon = Epsilon;
+    Params.Simplified = Simplified;
+
+    MlasLayerNorm(Params, RowCount, RowSize, threadpool_);
+
+    Check(Output, ReferenceOutput.data(), Count, "Output", RowCount, RowSize, HasSkip, HasBias, HasBeta, Simplified);
+    if (HasSkipOutput) {
+      Check(SkipOutput, ReferenceSkipOutput.data(), Count, "SkipOutput", RowCount, RowSize, HasSkip, HasBias, HasBeta, Simplified);
+    }
+    for (size_t r = 0; r < RowCount; r++) {
+      ASSERT_NEAR(Mean[r], ReferenceMean[r], std::fabs(ReferenceMean[r]) * 1e-5f + 1e-5f) << "Mean @" << r;
+      ASSERT_NEAR(InvStdDev[r], ReferenceInvStdDev[r], ReferenceInvStdDev[r] * 1e-4f) << "InvStdDev @" << r;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("LayerNorm") +
+                                          (std::is_same<T, float>::value ? "_Fp32" : "_Fp16") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t RowSize : {1, 3, 8, 15, 16, 17, 31, 32, 33, 64, 100, 768, 1031}) {
+      for (size_t RowCount : {1, 7}) {
+        Test(RowCount, RowSize, false, false, true, false, false);
+        Test(RowCount, RowSize, false, false, false, false, false);
+        Test(RowCount, RowSize, false, false, false, true, false);
+        Test(RowCount, RowSize, true, false, true, false, false);
+        Test(RowCount, RowSize, true, true, true, false, true);
+        Test(RowCount, RowSize, true, true, false, false, false);
+        Test(RowCount, RowSize, true, true, false, true, true);
+        Test(RowCount, RowSize, false, true, true, false, true);
+      }
+    }
+    Test(64, 4096, true, true, true, false, true);
+  }
+};
+
+template <>
+MlasLayerNormTest<float, false>* MlasTestFixture<MlasLayerNormTest<float, false>>::mlas_tester(nullptr);
+template <>
+MlasLayerNormTest<float, true>* MlasTestFixture<MlasLayerNormTest<float, true>>::mlas_tester(nullptr);
+template <>
+MlasLayerNormTest<MLFp16, false>* MlasTestFixture<MlasLayerNormTest<MLFp16, false>>::mlas_tester(nullptr);
+template <>
+MlasLayerNormTest<MLFp16, true>* MlasTestFixture<MlasLayerNormTest<MLFp16, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLFp16, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<float, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLFp16, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,171 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_q4gemm.cpp
+
+Abstract:
+
+    Tests for MLAS int4 block quantized GEMM.
+
+--*/
+
+#include "test_util.h"
+#include "mlas_q4.h"
+
+template <MLAS_BLK_QUANT_TYPE QType, bool Threaded>
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferUnpack;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MatrixGuardBuffer<float> BufferCMagnitude;
+  MLAS_THREADPOOL* threadpool_;
+
+  //
+  // Computes the reference result and the sum of the magnitudes of the
+  // products, which bounds the rounding error of the result.
+  //
+  void ReferenceGemm(size_t M, size_t N, size_t K,
+                     const float* A, const float* B, const float* Bias, float* C, float* CMagnitude) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = (Bias == nullptr) ? 0.0 : Bias[n];
+        double magnitude = std::fabs(sum);
+        for (size_t k = 0; k < K; k++) {
+          sum += double(A[m * K + k]) * B[k * N + n];
+          magnitude += std::fabs(double(A[m * K + k]) * B[k * N + n]);
+        }
+        C[m * N + n] = float(sum);
+        CMagnitude[m * N + n] = float(magnitude);
+      }
+    }
+  }
+
+ public:
+  MlasQ4GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool withBias) {
+    const float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+
+    const float* Bias = nullptr;
+    if (withBias) {
+      Bias = BufferBias.GetBuffer(N);
+    }
+
+    float* C = BufferC.GetBuffer(N * M, true);
+    float* CReference = BufferCReference.GetFilledBuffer(
+        N * M,
+        [](float* start, size_t size) {
+          std::fill_n(start, size, -1.0f);
+        });
+    float* CMagnitude = BufferCMagnitude.GetBuffer(N * M, true);
+
+    const size_t PackedBSize = MlasQ4GemmPackBSize(QType, N, K);
+    ASSERT_GT(PackedBSize, size_t(0));
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasQ4GemmPackB(QType, PackedB, B, N, K, N);
+
+    //
+    // The reference uses the dequantized weights, so the only difference
+    // with the kernel is the order of the floating point operations.
+    //
+
+    float* Unpacked = BufferUnpack.GetBuffer(N * K, true);
+    MlasQ4GemmUnPackB(QType, Unpacked, PackedB, N, K, N);
+
+    //
+    // The test data is in the range [-23, 23], so 15 quantization steps are
+    // at most 47/15 apart.
+    //
+
+    for (size_t i = 0; i < N * K; i++) {
+      ASSERT_LE(std::fabs(Unpacked[i] - B[i]), 47.0f / 15.0f)
+          << "Dequantize mismatch @" << i << " (" << Unpacked[i] << "," << B[i] << ")";
+    }
+
+    ReferenceGemm(M, N, K, A, Unpacked, Bias, CReference, CMagnitude);
+
+    MLAS_Q4_GEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = K;
+    params.B = PackedB;
+    params.Bias = Bias;
+    params.C = C;
+    params.ldc = N;
+    MlasQ4GemmBatch(QType, M, N, K, 1, &params, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float ref = CReference[m * N + n];
+        ASSERT_LE(std::fabs(C[m * N + n] - ref), CMagnitude[m * N + n] * 1e-5f + 1e-5f)
+            << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", "
+            << C[m * N + n] << " vs " << ref;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Q4GemmFP") +
+                                          (QType == BlkQ4Sym ? "Sym" : (QType == BlkQ4Zp8 ? "Zp8" : (QType == BlkQ4Sym64 ? "Sym64" : "Sym128"))) +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 2, 3, 4, 5, 7, 16}) {
+      for (size_t N : {1, 15, 32, 77, 160}) {
+        for (size_t K : {1, 16, 31, 32, 33, 64, 127, 128, 129, 300}) {
+          Test(M, N, K, false);
+          Test(M, N, K, true);
+        }
+      }
+    }
+    Test(43, 500, 401, true);
+  }
+};
+
+template <>
+MlasQ4GemmTest<BlkQ4Sym, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Zp8, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Zp8, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Zp8, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Zp8, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym64, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym64, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym64, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym64, true>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym128, false>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym128, false>>::mlas_tester(nullptr);
+template <>
+MlasQ4GemmTest<BlkQ4Sym128, true>* MlasTestFixture<MlasQ4GemmTest<BlkQ4Sym128, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Zp8, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym64, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym128, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Zp8, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym64, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasQ4GemmTest<BlkQ4Sym128, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
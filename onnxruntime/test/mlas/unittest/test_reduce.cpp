@@ -0,0 +1,159 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_reduce.cpp
+
+Abstract:
+
+    Tests for the MLAS KR and KRK reductions.
+
+--*/
+
+#include "test_fp16.h"
+
+template <typename T, bool Threaded>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInput;
+  MatrixGuardBuffer<T> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  using MlasType = typename std::conditional<std::is_same<T, float>::value, float, MLAS_FP16>::type;
+
+  static void FillInput(T* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = T(float(int((i * 7) % 23) - 11) * 0.0625f);
+    }
+  }
+
+  static float Reduce(MLAS_REDUCE_KIND Kind, const T* Input, size_t CountR, size_t Stride) {
+    double Value = float(Input[0]);
+    if (Kind == MlasReduceLogSumExp) {
+      double Maximum = Value;
+      for (size_t r = 1; r < CountR; r++) {
+        Maximum = std::max(Maximum, double(float(Input[r * Stride])));
+      }
+      double Sum = 0.0;
+      for (size_t r = 0; r < CountR; r++) {
+        Sum += std::exp(double(float(Input[r * Stride])) - Maximum);
+      }
+      return float(std::log(Sum) + Maximum);
+    }
+    for (size_t r = 1; r < CountR; r++) {
+      double v = float(Input[r * Stride]);
+      switch (Kind) {
+        case MlasReduceMaximum:
+          Value = std::max(Value, v);
+          break;
+        case MlasReduceMinimum:
+          Value = std::min(Value, v);
+          break;
+        default:
+          Value += v;
+          break;
+      }
+    }
+    if (Kind == MlasReduceMean) {
+      Value /= double(CountR);
+    }
+    return float(Value);
+  }
+
+  void Check(const T* Output, const float* Reference, size_t Count, MLAS_REDUCE_KIND Kind,
+             size_t CountK0, size_t CountR, size_t CountK1) {
+    const float Tolerance = std::is_same<T, float>::value ? 1e-5f : 2e-3f;
+    for (size_t i = 0; i < Count; i++) {
+      ASSERT_NEAR(float(Output[i]), Reference[i], std::fabs(Reference[i]) * Tolerance + Tolerance)
+          << "@" << i << ", Kind=" << int(Kind) << ", K0=" << CountK0 << ", R=" << CountR << ", K1=" << CountK1;
+    }
+  }
+
+ public:
+  MlasReduceTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void TestKR(MLAS_REDUCE_KIND Kind, size_t CountK, size_t CountR) {
+    const T* Input = BufferInput.GetFilledBuffer(CountK * CountR, FillInput);
+    T* Output = BufferOutput.GetBuffer(CountK, true);
+
+    std::vector<float> Reference(CountK);
+    for (size_t k = 0; k < CountK; k++) {
+      Reference[k] = Reduce(Kind, Input + k * CountR, CountR, 1);
+    }
+
+    MlasReduceKR(Kind, reinterpret_cast<const MlasType*>(Input), reinterpret_cast<MlasType*>(Output),
+                 CountK, CountR, threadpool_);
+
+    Check(Output, Reference.data(), CountK, Kind, 1, CountR, CountK);
+  }
+
+  void TestKRK(MLAS_REDUCE_KIND Kind, size_t CountK0, size_t CountR, size_t CountK1) {
+    const T* Input = BufferInput.GetFilledBuffer(CountK0 * CountR * CountK1, FillInput);
+    T* Output = BufferOutput.GetBuffer(CountK0 * CountK1, true);
+
+    std::vector<float> Reference(CountK0 * CountK1);
+    for (size_t k0 = 0; k0 < CountK0; k0++) {
+      for (size_t k1 = 0; k1 < CountK1; k1++) {
+        Reference[k0 * CountK1 + k1] = Reduce(Kind, Input + k0 * CountR * CountK1 + k1, CountR, CountK1);
+      }
+    }
+
+    MlasReduceKRK(Kind, reinterpret_cast<const MlasType*>(Input), reinterpret_cast<MlasType*>(Output),
+                  CountK0, CountR, CountK1, threadpool_);
+
+    Check(Output, Reference.data(), CountK0 * CountK1, Kind, CountK0, CountR, CountK1);
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Reduce") +
+                                          (std::is_same<T, float>::value ? "_Fp32" : "_Fp16") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    static const MLAS_REDUCE_KIND Kinds[] = {
+        MlasReduceSum, MlasReduceMean, MlasReduceMaximum, MlasReduceMinimum, MlasReduceLogSumExp};
+
+    for (MLAS_REDUCE_KIND Kind : Kinds) {
+      for (size_t CountR : {1, 3, 16, 37, 768, 1100}) {
+        for (size_t CountK : {1, 5, 64}) {
+          TestKR(Kind, CountK, CountR);
+        }
+      }
+      for (size_t CountR : {1, 2, 17, 128}) {
+        for (size_t CountK1 : {1, 3, 16, 45, 768, 1030}) {
+          TestKRK(Kind, 1, CountR, CountK1);
+          TestKRK(Kind, 3, CountR, CountK1);
+        }
+      }
+      TestKRK(Kind, 2, 4096, 24);
+    }
+  }
+};
+
+template <>
+MlasReduceTest<float, false>* MlasTestFixture<MlasReduceTest<float, false>>::mlas_tester(nullptr);
+template <>
+MlasReduceTest<float, true>* MlasTestFixture<MlasReduceTest<float, true>>::mlas_tester(nullptr);
+template <>
+MlasReduceTest<MLFp16, false>* MlasTestFixture<MlasReduceTest<MLFp16, false>>::mlas_tester(nullptr);
+template <>
+MlasReduceTest<MLFp16, true>* MlasTestFixture<MlasReduceTest<MLFp16, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MLFp16, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasReduceTest<float, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasReduceTest<MLFp16, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,176 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sgemm_epilogue.cpp
+
+Abstract:
+
+    Tests for the bias, activation and residual epilogue of MLAS SGEMM.
+
+--*/
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferResidual;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  static void FillSmall(float* start, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int(i % 23) - 11) * 0.0625f;
+    }
+  }
+
+  static float ApplyActivation(const MLAS_ACTIVATION& Activation, float Value) {
+    switch (Activation.ActivationKind) {
+      case MlasReluActivation:
+        return std::max(Value, 0.0f);
+      case MlasLeakyReluActivation:
+        return Value >= 0.0f ? Value : Value * Activation.Parameters.LeakyRelu.alpha;
+      case MlasTanhActivation:
+        return std::tanh(Value);
+      case MlasLogisticActivation:
+        return 1.0f / (1.0f + std::exp(-Value));
+      case MlasClipActivation:
+        return std::min(std::max(Value, Activation.Parameters.Clip.minimum), Activation.Parameters.Clip.maximum);
+      case MlasHardSigmoidActivation:
+        return std::min(std::max(Value * Activation.Parameters.HardSigmoid.alpha + Activation.Parameters.HardSigmoid.beta, 0.0f), 1.0f);
+      default:
+        return Value;
+    }
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool TransB, float beta,
+            bool HasBias, const MLAS_ACTIVATION* Activation, bool HasResidual) {
+    const float* A = BufferA.GetFilledBuffer(M * K, FillSmall);
+    const float* B = BufferB.GetFilledBuffer(N * K, FillSmall);
+    const float* Bias = HasBias ? BufferBias.GetFilledBuffer(N, FillSmall) : nullptr;
+    const float* Residual = HasResidual ? BufferResidual.GetFilledBuffer(M * N, FillSmall) : nullptr;
+    float* C = BufferC.GetFilledBuffer(M * N, FillSmall);
+    float* CReference = BufferCReference.GetBuffer(M * N, true);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * (TransB ? B[n * K + k] : B[k * N + n]);
+        }
+        float Value = sum + beta * C[m * N + n];
+        if (Bias != nullptr) {
+          Value += Bias[n];
+        }
+        if (Activation != nullptr) {
+          Value = ApplyActivation(*Activation, Value);
+        }
+        if (Residual != nullptr) {
+          Value += Residual[m * N + n];
+        }
+        CReference[m * N + n] = Value;
+      }
+    }
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.C = C;
+    Data.ldc = N;
+    Data.beta = beta;
+    Data.Bias = Bias;
+    Data.Activation = Activation;
+    Data.Residual = Residual;
+    Data.ldr = N;
+
+    if (Packed) {
+      void* PackedB = BufferPackedB.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, TransB ? K : N, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = TransB ? K : N;
+    }
+
+    MlasGemmBatch(CblasNoTrans, TransB ? CblasTrans : CblasNoTrans, M, N, K, &Data, 1, threadpool_);
+
+    for (size_t f = 0; f < M * N; f++) {
+      ASSERT_NEAR(C[f], CReference[f], std::fabs(CReference[f]) * 1e-5f + 1e-5f)
+          << "@[" << f / N << "x" << f % N << "], "
+          << "M=" << M << ", N=" << N << ", K=" << K << ", TransB=" << TransB << ", beta=" << beta << ", "
+          << "Bias=" << HasBias << ", Activation=" << (Activation != nullptr ? int(Activation->ActivationKind) : -1)
+          << ", Residual=" << HasResidual;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SgemmEpilogue") +
+                                          (Packed ? "_Packed" : "_NoPack") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    MLAS_ACTIVATION Activations[6];
+    Activations[0].ActivationKind = MlasReluActivation;
+    Activations[1].ActivationKind = MlasLeakyReluActivation;
+    Activations[1].Parameters.LeakyRelu.alpha = 0.125f;
+    Activations[2].ActivationKind = MlasTanhActivation;
+    Activations[3].ActivationKind = MlasLogisticActivation;
+    Activations[4].ActivationKind = MlasClipActivation;
+    Activations[4].Parameters.Clip.minimum = -0.5f;
+    Activations[4].Parameters.Clip.maximum = 0.75f;
+    Activations[5].ActivationKind = MlasIdentityActivation;
+
+    static const size_t Shapes[][3] = {
+        {1, 1, 1}, {1, 67, 33}, {3, 300, 17}, {1, 1, 160}, {16, 16, 16}, {37, 50, 45}, {64, 257, 300}, {2, 40, 3000}, {5, 18, 0}};
+
+    for (const auto& Shape : Shapes) {
+      for (bool TransB : {false, true}) {
+        for (const auto& Activation : Activations) {
+          Test(Shape[0], Shape[1], Shape[2], TransB, 0.0f, true, &Activation, false);
+          Test(Shape[0], Shape[1], Shape[2], TransB, 1.0f, false, &Activation, true);
+        }
+        Test(Shape[0], Shape[1], Shape[2], TransB, 0.5f, true, nullptr, true);
+        Test(Shape[0], Shape[1], Shape[2], TransB, 0.0f, false, nullptr, true);
+      }
+    }
+  }
+};
+
+template <>
+MlasSgemmEpilogueTest<false, false>* MlasTestFixture<MlasSgemmEpilogueTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<false, true>* MlasTestFixture<MlasSgemmEpilogueTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, false>* MlasTestFixture<MlasSgemmEpilogueTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, true>* MlasTestFixture<MlasSgemmEpilogueTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasSgemmEpilogueTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
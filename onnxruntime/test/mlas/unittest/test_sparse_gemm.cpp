@@ -0,0 +1,206 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sparse_gemm.cpp
+
+Abstract:
+
+    Tests for MLAS block sparse SGEMM.
+
+--*/
+
+#include "test_util.h"
+
+#include <cstring>
+
+template <bool Threaded>
+class MlasSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+ public:
+  MlasSparseGemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  //
+  // Matrix B is zero except for the blocks of PruneK x PruneN elements that
+  // are selected with the probability Density.
+  //
+  void Test(size_t M, size_t N, size_t K, size_t BlockK, size_t PruneK, size_t PruneN,
+            float Density, bool TransB, float alpha, float beta) {
+    std::default_random_engine generator(static_cast<unsigned>(M * 7919 + N * 131 + K * 17 + BlockK));
+    std::uniform_real_distribution<float> value_distribution(-1.0f, 1.0f);
+    std::bernoulli_distribution keep_distribution(Density);
+
+    float* A = BufferA.GetBuffer(M * K);
+    float* B = BufferB.GetBuffer(N * K, true);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    for (size_t i = 0; i < M * K; i++) {
+      A[i] = value_distribution(generator);
+    }
+    for (size_t i = 0; i < M * N; i++) {
+      C[i] = value_distribution(generator);
+    }
+
+    //
+    // Matrix B is K x N, or N x K when transposed.
+    //
+
+    const size_t ldb = TransB ? K : N;
+    auto ElementB = [&](size_t k, size_t n) -> float& {
+      return TransB ? B[n * ldb + k] : B[k * ldb + n];
+    };
+
+    for (size_t k = 0; k < K; k += PruneK) {
+      for (size_t n = 0; n < N; n += PruneN) {
+        if (!keep_distribution(generator)) {
+          continue;
+        }
+        for (size_t kk = k; kk < std::min(k + PruneK, K); kk++) {
+          for (size_t nn = n; nn < std::min(n + PruneN, N); nn++) {
+            ElementB(kk, nn) = value_distribution(generator);
+          }
+        }
+      }
+    }
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double sum = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          sum += double(A[m * K + k]) * ElementB(k, n);
+        }
+        CReference[m * N + n] = float(alpha * sum + beta * C[m * N + n]);
+      }
+    }
+
+    const CBLAS_TRANSPOSE Trans = TransB ? CblasTrans : CblasNoTrans;
+    const size_t NonZeroBlockCount = MlasSparseGemmCountNonZeroBlocks(Trans, N, K, B, ldb, BlockK);
+    const size_t BlockCount = ((K + BlockK - 1) / BlockK) * ((N + MLAS_SPARSE_SGEMM_BLOCK_N - 1) / MLAS_SPARSE_SGEMM_BLOCK_N);
+    ASSERT_LE(NonZeroBlockCount, BlockCount);
+
+    const size_t PackedBSize = MlasSparseGemmPackBSize(N, K, BlockK, NonZeroBlockCount);
+    ASSERT_GT(PackedBSize, size_t(0));
+    void* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(Trans, N, K, B, ldb, BlockK, PackedB);
+
+    ASSERT_TRUE(MlasSparseGemmIsValidPackedB(N, K, PackedB, PackedBSize));
+    ASSERT_FALSE(MlasSparseGemmIsValidPackedB(N + 1, K, PackedB, PackedBSize));
+    ASSERT_FALSE(MlasSparseGemmIsValidPackedB(N, K + 1, PackedB, PackedBSize));
+    ASSERT_FALSE(MlasSparseGemmIsValidPackedB(N, K, PackedB, PackedBSize - 1));
+
+    MLAS_SPARSE_SGEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = K;
+    params.PackedB = PackedB;
+    params.C = C;
+    params.ldc = N;
+    params.alpha = alpha;
+    params.beta = beta;
+
+    MlasSparseGemmBatch(M, N, K, 1, &params, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        const float ref = CReference[m * N + n];
+        ASSERT_LE(std::fabs(C[m * N + n] - ref), std::fabs(ref) * 1e-5f + 1e-4f)
+            << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", BlockK=" << BlockK << ", "
+            << "Prune=" << PruneK << "x" << PruneN << ", Density=" << Density << ", TransB=" << TransB << ", "
+            << "alpha=" << alpha << ", beta=" << beta << ", "
+            << C[m * N + n] << " vs " << ref;
+      }
+    }
+  }
+
+  //
+  // The packed buffer starts with a header of five 32-bit values, followed by
+  // the PanelCount + 1 panel offsets and the block row indices. Replacing any
+  // of these with an out of range value must make the buffer invalid.
+  //
+  void TestCorruptPackedB(size_t N, size_t K, size_t BlockK) {
+    float* B = BufferB.GetBuffer(N * K, true);
+    for (size_t i = 0; i < N * K; i++) {
+      B[i] = float(i % 7) + 1.0f;
+    }
+
+    const size_t NonZeroBlockCount = MlasSparseGemmCountNonZeroBlocks(CblasNoTrans, N, K, B, N, BlockK);
+    const size_t PackedBSize = MlasSparseGemmPackBSize(N, K, BlockK, NonZeroBlockCount);
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasSparseGemmPackB(CblasNoTrans, N, K, B, N, BlockK, PackedB);
+    ASSERT_TRUE(MlasSparseGemmIsValidPackedB(N, K, PackedB, PackedBSize));
+
+    const size_t PanelCount = (N + MLAS_SPARSE_SGEMM_BLOCK_N - 1) / MLAS_SPARSE_SGEMM_BLOCK_N;
+    const size_t IndexCount = 5 + PanelCount + 1 + NonZeroBlockCount;
+
+    for (size_t i = 0; i < IndexCount; i++) {
+      uint32_t Saved;
+      std::memcpy(&Saved, PackedB + i * sizeof(uint32_t), sizeof(Saved));
+      const uint32_t Corrupt = 0xFFFFFFFF;
+      std::memcpy(PackedB + i * sizeof(uint32_t), &Corrupt, sizeof(Corrupt));
+      ASSERT_FALSE(MlasSparseGemmIsValidPackedB(N, K, PackedB, PackedBSize))
+          << "N=" << N << ", K=" << K << ", BlockK=" << BlockK << " @" << i;
+      std::memcpy(PackedB + i * sizeof(uint32_t), &Saved, sizeof(Saved));
+    }
+
+    ASSERT_TRUE(MlasSparseGemmIsValidPackedB(N, K, PackedB, PackedBSize));
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("SparseGemm") +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t M : {1, 3, 16, 17, 40}) {
+      for (size_t N : {1, 4, 7, 64}) {
+        for (size_t K : {1, 4, 13, 64}) {
+          Test(M, N, K, 1, 1, 4, 0.3f, false, 1.0f, 0.0f);
+          Test(M, N, K, 4, 4, 4, 0.3f, false, 1.0f, 0.0f);
+        }
+      }
+    }
+    for (size_t BlockK : {1, 2, 4, 8}) {
+      for (bool TransB : {false, true}) {
+        Test(33, 96, 128, BlockK, 4, 4, 0.2f, TransB, 1.0f, 0.0f);
+        Test(48, 70, 90, BlockK, 1, 4, 0.1f, TransB, 0.5f, 1.0f);
+        Test(20, 64, 100, BlockK, 4, 1, 0.25f, TransB, -1.5f, 2.0f);
+      }
+    }
+    Test(64, 128, 64, 4, 4, 4, 0.0f, false, 1.0f, 0.0f);
+    Test(64, 128, 64, 4, 4, 4, 1.0f, false, 1.0f, 0.0f);
+    Test(100, 768, 768, 4, 4, 4, 0.1f, false, 1.0f, 0.0f);
+
+    TestCorruptPackedB(7, 13, 4);
+    TestCorruptPackedB(64, 64, 1);
+  }
+};
+
+template <>
+MlasSparseGemmTest<false>* MlasTestFixture<MlasSparseGemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasSparseGemmTest<true>* MlasTestFixture<MlasSparseGemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSparseGemmTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSparseGemmTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
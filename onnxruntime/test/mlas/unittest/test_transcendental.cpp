@@ -0,0 +1,239 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_transcendental.cpp
+
+Abstract:
+
+    Tests for the MLAS element-wise unary functions. The results are checked
+    against the double precision C runtime functions in units in the last
+    place of the output type.
+
+--*/
+
+#include "test_fp16.h"
+
+#include <cmath>
+
+template <typename T, bool Threaded>
+class MlasUnaryTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInput;
+  MatrixGuardBuffer<T> BufferOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  using MlasType = typename std::conditional<std::is_same<T, MLFp16>::value, MLAS_FP16, T>::type;
+
+  static constexpr bool IsHalf = std::is_same<T, MLFp16>::value;
+
+  //
+  // The significand bits of the output type including the implicit bit and
+  // the exponent of the smallest normal value as returned by frexp.
+  //
+
+  static constexpr int SignificandBits = IsHalf ? 11 : 24;
+  static constexpr int MinimumExponent = IsHalf ? -13 : -125;
+
+  static double Reference(MLAS_UNARY_FUNCTION Function, double x, double Parameter) {
+    switch (Function) {
+      case MlasUnaryLog:
+        return std::log(x);
+      case MlasUnarySqrt:
+        return std::sqrt(x);
+      case MlasUnaryReciprocal:
+        return 1.0 / x;
+      case MlasUnarySin:
+        return std::sin(x);
+      case MlasUnaryCos:
+        return std::cos(x);
+      case MlasUnaryPow:
+      default:
+        return std::pow(x, Parameter);
+    }
+  }
+
+  static double UlpError(double Value, double Expected) {
+    if (std::isnan(Expected) || std::isnan(Value)) {
+      return (std::isnan(Expected) && std::isnan(Value)) ? 0.0 : INFINITY;
+    }
+
+    //
+    // The reference is rounded to the output type so that results beyond the
+    // largest finite value compare as infinities.
+    //
+
+    const double Rounded = IsHalf ? double(float(T(float(Expected)))) : double(float(Expected));
+
+    if (std::isinf(Rounded) || std::isinf(Value)) {
+      return (Rounded == Value) ? 0.0 : INFINITY;
+    }
+
+    int Exponent;
+    std::frexp(Expected, &Exponent);
+    Exponent = std::max(Exponent, MinimumExponent);
+
+    return std::fabs(Value - Expected) / std::ldexp(1.0, Exponent - SignificandBits);
+  }
+
+  //
+  // The error of the power function may grow with the argument of the
+  // exponential, which is weighted by PowArgumentUlp.
+  //
+
+  void Test(MLAS_UNARY_FUNCTION Function, float Parameter, const std::vector<float>& Values, double MaximumUlp,
+            double PowArgumentUlp = 0.0) {
+    const size_t N = Values.size();
+
+    T* Input = BufferInput.GetBuffer(N);
+    T* Output = BufferOutput.GetBuffer(N);
+
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = T(Values[n]);
+    }
+
+    MlasComputeUnary(Function, reinterpret_cast<const MlasType*>(Input), reinterpret_cast<MlasType*>(Output), N,
+                     Parameter, threadpool_);
+
+    for (size_t n = 0; n < N; n++) {
+      const float x = float(Input[n]);
+      const double Expected = Reference(Function, double(x), double(Parameter));
+      const double Error = UlpError(double(float(Output[n])), Expected);
+
+      double Bound = MaximumUlp;
+      const double Argument = std::fabs(double(Parameter) * std::log(std::fabs(double(x))));
+      if (PowArgumentUlp != 0.0 && std::isfinite(Argument)) {
+        Bound += PowArgumentUlp * Argument;
+      }
+
+      ASSERT_LE(Error, Bound) << "function " << int(Function) << ", parameter " << Parameter
+                                   << ", x=" << x << ", output=" << float(Output[n]) << ", expected=" << Expected;
+    }
+
+    //
+    // The output may alias the input.
+    //
+
+    MlasComputeUnary(Function, reinterpret_cast<const MlasType*>(Input), reinterpret_cast<MlasType*>(Input), N,
+                     Parameter, threadpool_);
+
+    for (size_t n = 0; n < N; n++) {
+      ASSERT_EQ(std::memcmp(&Input[n], &Output[n], sizeof(T)), 0) << "in place, function " << int(Function)
+                                                                  << ", index " << n;
+    }
+  }
+
+  static std::vector<float> Uniform(size_t N, float Minimum, float Maximum, unsigned Seed) {
+    std::default_random_engine generator(Seed);
+    std::uniform_real_distribution<float> distribution(Minimum, Maximum);
+    std::vector<float> Values(N);
+    for (auto& v : Values) {
+      v = distribution(generator);
+    }
+    return Values;
+  }
+
+  static std::vector<float> LogUniform(size_t N, float MinimumExponent, float MaximumExponent, unsigned Seed) {
+    std::vector<float> Values = Uniform(N, MinimumExponent, MaximumExponent, Seed);
+    for (auto& v : Values) {
+      v = std::exp2(v);
+    }
+    return Values;
+  }
+
+  static std::vector<float> SpecialValues() {
+    return {0.0f, -0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 0.5f, -0.5f,
+            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest(), std::numeric_limits<float>::min(),
+            std::numeric_limits<float>::denorm_min(), 1.0e-40f, -1.0e-40f, 3.14159265f, 1.57079633f};
+  }
+
+ public:
+  MlasUnaryTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string(IsHalf ? "Unary_FP16" : "Unary_FP32") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    //
+    // Half precision results are rounded once from float.
+    //
+
+    const double ExtraUlp = IsHalf ? 0.5 : 0.0;
+
+    const float MaximumExponent = IsHalf ? 15.0f : 127.0f;
+    const float MinimumExponent = IsHalf ? -24.0f : -149.0f;
+    const float SinCosRange = IsHalf ? 2000.0f : 8192.0f;
+
+    for (size_t N : {1, 3, 15, 16, 17, 100}) {
+      Test(MlasUnaryLog, 0.0f, LogUniform(N, MinimumExponent, MaximumExponent, unsigned(N)), 1.0 + ExtraUlp);
+    }
+
+    Test(MlasUnaryLog, 0.0f, LogUniform(50000, MinimumExponent, MaximumExponent, 1), 1.0 + ExtraUlp);
+    Test(MlasUnaryLog, 0.0f, Uniform(50000, 0.5f, 2.0f, 2), 1.0 + ExtraUlp);
+    Test(MlasUnaryLog, 0.0f, SpecialValues(), 1.0 + ExtraUlp);
+
+    Test(MlasUnarySqrt, 0.0f, LogUniform(50000, MinimumExponent, MaximumExponent, 3), 0.5 + ExtraUlp);
+    Test(MlasUnarySqrt, 0.0f, SpecialValues(), 0.5 + ExtraUlp);
+
+    Test(MlasUnaryReciprocal, 0.0f, Uniform(50000, -100.0f, 100.0f, 4), 0.5 + ExtraUlp);
+    Test(MlasUnaryReciprocal, 0.0f, SpecialValues(), 0.5 + ExtraUlp);
+
+    for (MLAS_UNARY_FUNCTION Function : {MlasUnarySin, MlasUnaryCos}) {
+      Test(Function, 0.0f, Uniform(50000, -4.0f, 4.0f, 5), 2.5 + ExtraUlp);
+      Test(Function, 0.0f, Uniform(50000, -SinCosRange, SinCosRange, 6), 2.5 + ExtraUlp);
+      Test(Function, 0.0f, Uniform(1000, 1.0e4f, 1.0e7f, 7), 2.5 + ExtraUlp);
+      Test(Function, 0.0f, SpecialValues(), 2.5 + ExtraUlp);
+    }
+
+    for (float Exponent : {0.0f, 1.0f, 2.0f, 3.0f, -1.0f, 0.5f, -0.5f, 4.0f, 7.0f, -2.0f, -5.0f, 16.0f, -16.0f}) {
+      const double MaximumUlp =
+          ((Exponent == -0.5f) ? 1.5 : std::max(std::fabs(Exponent) * (Exponent < 0.0f ? 1.5 : 1.0), 0.5)) + ExtraUlp;
+      Test(MlasUnaryPow, Exponent, Uniform(10000, -4.0f, 4.0f, 8), MaximumUlp);
+      Test(MlasUnaryPow, Exponent, SpecialValues(), MaximumUlp);
+    }
+
+    for (float Exponent : {1.5f, -2.5f, 0.25f, 2.2f, -0.75f, 17.0f, 100.0f, -33.0f}) {
+      std::vector<float> Values = LogUniform(10000, -10.0f, 10.0f, 9);
+      for (size_t n = 0; n < Values.size(); n += 3) {
+        Values[n] = -Values[n];
+      }
+
+      Test(MlasUnaryPow, Exponent, Values, 2.0 + ExtraUlp, 3.0);
+      Test(MlasUnaryPow, Exponent, SpecialValues(), 2.0 + ExtraUlp, 3.0);
+    }
+
+    Test(MlasUnaryPow, std::numeric_limits<float>::infinity(), SpecialValues(), 0.0);
+    Test(MlasUnaryPow, std::numeric_limits<float>::quiet_NaN(), SpecialValues(), 0.0);
+  }
+};
+
+template <>
+MlasUnaryTest<float, false>* MlasTestFixture<MlasUnaryTest<float, false>>::mlas_tester(nullptr);
+template <>
+MlasUnaryTest<float, true>* MlasTestFixture<MlasUnaryTest<float, true>>::mlas_tester(nullptr);
+template <>
+MlasUnaryTest<MLFp16, false>* MlasTestFixture<MlasUnaryTest<MLFp16, false>>::mlas_tester(nullptr);
+template <>
+MlasUnaryTest<MLFp16, true>* MlasTestFixture<MlasUnaryTest<MLFp16, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasUnaryTest<float, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasUnaryTest<MLFp16, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasUnaryTest<float, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasUnaryTest<MLFp16, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -45,12 +45,124 @@ class MlasTransposeTest : public MlasTestBase {
   }
 };
 
+template <size_t ElementSize, bool Threaded>
+class MlasTransposeNdTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferInput;
+  MatrixGuardBuffer<uint8_t> BufferOutput;
+  MatrixGuardBuffer<uint8_t> BufferOutputReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(const std::vector<size_t>& InputShape, const std::vector<size_t>& Permutation) {
+    const size_t Rank = InputShape.size();
+    size_t ElementCount = 1;
+    for (size_t dim : InputShape) {
+      ElementCount *= dim;
+    }
+
+    uint8_t* Input = BufferInput.GetBuffer(ElementCount * ElementSize);
+    uint8_t* Output = BufferOutput.GetBuffer(ElementCount * ElementSize);
+    uint8_t* OutputReference = BufferOutputReference.GetBuffer(ElementCount * ElementSize);
+
+    for (size_t i = 0; i < ElementCount * ElementSize; i++) {
+      Input[i] = static_cast<uint8_t>(i * 7 + i / 251);
+    }
+
+    ASSERT_TRUE(MlasTransposeNd(Input, Output, ElementSize, Rank, InputShape.data(), Permutation.data(), threadpool_));
+
+    //
+    // Walk the output in order with a multi-index of the output axes.
+    //
+
+    std::vector<size_t> InputStrides(Rank, 1);
+    for (size_t i = Rank; i > 1; i--) {
+      InputStrides[i - 2] = InputStrides[i - 1] * InputShape[i - 1];
+    }
+
+    std::vector<size_t> Index(Rank, 0);
+    for (size_t o = 0; o < ElementCount; o++) {
+      size_t InputOffset = 0;
+      for (size_t i = 0; i < Rank; i++) {
+        InputOffset += Index[i] * InputStrides[Permutation[i]];
+      }
+      memcpy(OutputReference + o * ElementSize, Input + InputOffset * ElementSize, ElementSize);
+      for (size_t i = Rank; i > 0; i--) {
+        if (++Index[i - 1] < InputShape[Permutation[i - 1]]) {
+          break;
+        }
+        Index[i - 1] = 0;
+      }
+    }
+
+    std::ostringstream shape;
+    for (size_t i = 0; i < Rank; i++) {
+      shape << InputShape[i] << "/" << Permutation[i] << " ";
+    }
+    ASSERT_EQ(memcmp(Output, OutputReference, ElementCount * ElementSize), 0) << " [" << shape.str() << "]";
+  }
+
+ public:
+  MlasTransposeNdTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("TransposeNd_Size") + std::to_string(ElementSize) +
+                                          (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    Test({1}, {0});
+    Test({37, 53}, {1, 0});
+    Test({130, 100}, {1, 0});
+    Test({67, 1, 3}, {2, 1, 0});
+    Test({4, 6, 1, 5}, {3, 0, 2, 1});
+    Test({2, 3, 4}, {0, 1, 2});
+
+    // Attention head shuffles.
+    Test({2, 17, 12, 64}, {0, 2, 1, 3});
+    Test({2, 17, 12, 64}, {0, 2, 3, 1});
+    Test({3, 70, 4, 2}, {0, 2, 3, 1});
+
+    // NCHW <-> NHWC and NCDHW <-> NDHWC.
+    Test({2, 3, 19, 21}, {0, 2, 3, 1});
+    Test({2, 19, 21, 3}, {0, 3, 1, 2});
+    Test({2, 5, 3, 7, 9}, {0, 2, 3, 4, 1});
+    Test({2, 3, 7, 9, 5}, {0, 4, 1, 2, 3});
+    Test({2, 2, 33, 65}, {0, 2, 3, 1});
+
+    // Every permutation of small shapes.
+    for (size_t Rank = 2; Rank <= 4; Rank++) {
+      std::vector<size_t> InputShape(Rank);
+      std::vector<size_t> Permutation(Rank);
+      for (size_t i = 0; i < Rank; i++) {
+        InputShape[i] = 2 + (i * 3) % 5;
+        Permutation[i] = i;
+      }
+      do {
+        Test(InputShape, Permutation);
+      } while (std::next_permutation(Permutation.begin(), Permutation.end()));
+    }
+  }
+};
+
 template <>
 MlasTransposeTest<uint32_t>* MlasTestFixture<MlasTransposeTest<uint32_t>>::mlas_tester(nullptr);
 template <>
 MlasTransposeTest<uint16_t>* MlasTestFixture<MlasTransposeTest<uint16_t>>::mlas_tester(nullptr);
 template <>
 MlasTransposeTest<uint8_t>* MlasTestFixture<MlasTransposeTest<uint8_t>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<1, false>* MlasTestFixture<MlasTransposeNdTest<1, false>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<2, false>* MlasTestFixture<MlasTransposeNdTest<2, false>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<3, false>* MlasTestFixture<MlasTransposeNdTest<3, false>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<4, false>* MlasTestFixture<MlasTransposeNdTest<4, false>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<8, false>* MlasTestFixture<MlasTransposeNdTest<8, false>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNdTest<4, true>* MlasTestFixture<MlasTransposeNdTest<4, true>>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
@@ -58,6 +170,14 @@ static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_exe
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNdTest<1, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNdTest<2, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNdTest<3, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNdTest<4, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNdTest<8, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasTransposeNdTest<4, true>>::RegisterShortExecute();
+    }
   }
   return count;
 });
@@ -0,0 +1,180 @@
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include "core/framework/float16.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+
+// Shapes are {K, R} for KR, {R, K} for RK and {K0, R, K1} for KRK.
+static void ReduceKRArgs(benchmark::internal::Benchmark* b) {
+  b->Args({128, 768});
+  b->Args({512, 128});
+  b->Args({4096, 64});
+  b->Args({16, 30522});
+}
+
+static void ReduceRKArgs(benchmark::internal::Benchmark* b) {
+  b->Args({128, 768});
+  b->Args({512, 1024});
+  b->Args({4096, 64});
+  b->Args({30522, 16});
+}
+
+static void ReduceKRKArgs(benchmark::internal::Benchmark* b) {
+  b->Args({8, 128, 768});
+  b->Args({64, 49, 256});
+  b->Args({256, 16, 64});
+}
+
+static void BM_ReduceSumKREigen(benchmark::State& state) {
+  const int64_t K = state.range(0);
+  const int64_t R = state.range(1);
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    onnxruntime::EigenVectorMap<float>(out, K) = onnxruntime::ConstEigenMatrixMap<float>(data, R, K).colwise().sum();
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceSumKREigen)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRArgs);
+
+static void BM_ReduceSumKRMlas(benchmark::State& state) {
+  const size_t K = static_cast<size_t>(state.range(0));
+  const size_t R = static_cast<size_t>(state.range(1));
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    MlasReduceKR(MlasReduceSum, data, out, K, R, nullptr);
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceSumKRMlas)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRArgs);
+
+static void BM_ReduceMaxKREigen(benchmark::State& state) {
+  const int64_t K = state.range(0);
+  const int64_t R = state.range(1);
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    onnxruntime::EigenVectorMap<float>(out, K) = onnxruntime::ConstEigenMatrixMap<float>(data, R, K).colwise().maxCoeff();
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceMaxKREigen)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRArgs);
+
+static void BM_ReduceMaxKRMlas(benchmark::State& state) {
+  const size_t K = static_cast<size_t>(state.range(0));
+  const size_t R = static_cast<size_t>(state.range(1));
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    MlasReduceKR(MlasReduceMaximum, data, out, K, R, nullptr);
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceMaxKRMlas)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRArgs);
+
+static void BM_ReduceLogSumExpKRMlas(benchmark::State& state) {
+  const size_t K = static_cast<size_t>(state.range(0));
+  const size_t R = static_cast<size_t>(state.range(1));
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    MlasReduceKR(MlasReduceLogSumExp, data, out, K, R, nullptr);
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceLogSumExpKRMlas)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRArgs);
+
+// Same loop as ReduceAggregatorSum<float>::FastReduceRK.
+static void BM_ReduceSumRKEigen(benchmark::State& state) {
+  const int64_t R = state.range(0);
+  const int64_t K = state.range(1);
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    memcpy(out, data, K * sizeof(float));
+    for (int64_t row = 1; row < R; ++row) {
+      onnxruntime::EigenVectorArrayMap<float>(out, K) += onnxruntime::ConstEigenVectorArrayMap<float>(data + row * K, K);
+    }
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceSumRKEigen)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceRKArgs);
+
+static void BM_ReduceSumRKMlas(benchmark::State& state) {
+  const size_t R = static_cast<size_t>(state.range(0));
+  const size_t K = static_cast<size_t>(state.range(1));
+  float* data = GenerateArrayWithRandomValue<float>(K * R, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K, 64);
+  for (auto _ : state) {
+    MlasReduceKRK(MlasReduceSum, data, out, 1, R, K, nullptr);
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceSumRKMlas)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceRKArgs);
+
+static void BM_ReduceMaxKRKEigen(benchmark::State& state) {
+  const int64_t K0 = state.range(0);
+  const int64_t R = state.range(1);
+  const int64_t K1 = state.range(2);
+  float* data = GenerateArrayWithRandomValue<float>(K0 * R * K1, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K0 * K1, 64);
+  for (auto _ : state) {
+    for (int64_t j = 0; j < K0; ++j) {
+      onnxruntime::EigenVectorMap<float>(out + j * K1, K1) =
+          onnxruntime::ConstEigenMatrixMap<float>(data + j * R * K1, K1, R).rowwise().maxCoeff();
+    }
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceMaxKRKEigen)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRKArgs);
+
+static void BM_ReduceMaxKRKMlas(benchmark::State& state) {
+  const size_t K0 = static_cast<size_t>(state.range(0));
+  const size_t R = static_cast<size_t>(state.range(1));
+  const size_t K1 = static_cast<size_t>(state.range(2));
+  float* data = GenerateArrayWithRandomValue<float>(K0 * R * K1, -1, 1);
+  float* out = (float*)aligned_alloc(sizeof(float) * K0 * K1, 64);
+  for (auto _ : state) {
+    MlasReduceKRK(MlasReduceMaximum, data, out, K0, R, K1, nullptr);
+  }
+  aligned_free(out);
+  aligned_free(data);
+}
+
+BENCHMARK(BM_ReduceMaxKRKMlas)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRKArgs);
+
+static void BM_ReduceMeanKRKMlasFp16(benchmark::State& state) {
+  const size_t K0 = static_cast<size_t>(state.range(0));
+  const size_t R = static_cast<size_t>(state.range(1));
+  const size_t K1 = static_cast<size_t>(state.range(2));
+  float* values = GenerateArrayWithRandomValue<float>(K0 * R * K1, -1, 1);
+  std::vector<MLAS_FP16> data(K0 * R * K1);
+  std::vector<MLAS_FP16> out(K0 * K1);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = MLAS_FP16(values[i]);
+  }
+  for (auto _ : state) {
+    MlasReduceKRK(MlasReduceMean, data.data(), out.data(), K0, R, K1, nullptr);
+  }
+  aligned_free(values);
+}
+
+BENCHMARK(BM_ReduceMeanKRKMlasFp16)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond)->Apply(ReduceKRKArgs);
@@ -8,6 +8,8 @@
 #include "graph_transform_test_builder.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -516,6 +518,75 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+static void EnableNhwcFp32Conv(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableNhwcFp32Conv, "1"));
+}
+
+TEST(NhwcTransformerTests, ConvFp32) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.5f, 1.5f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>(weights_shape, -1.5f, 1.5f);
+
+      builder.AddConvNode(input_arg, weight_arg, output_arg);
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-5, 1e-5, nullptr, EnableNhwcFp32Conv);
+  };
+
+  // Test the basic case of a single 1D/2D/3D convolution.
+  test_case({1, 12, 37}, {32, 12, 5});
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3});
+  test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3});
+}
+
+TEST(NhwcTransformerTests, ConvBlockActivationFp32) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 16, 14, 14}, -1.5f, 1.5f);
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* relu_output_arg = builder.MakeIntermediate();
+    auto* conv2_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    // Pointwise convolution followed by an activation that is fused to FusedConv.
+    auto* conv1_weight_arg = builder.MakeInitializer<float>({32, 16, 1, 1}, -1.5f, 1.5f);
+    builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    builder.AddNode("Relu", {conv1_output_arg}, {relu_output_arg});
+
+    // Depthwise convolution.
+    auto* conv2_weight_arg = builder.MakeInitializer<float>({32, 1, 3, 3}, -1.5f, 1.5f);
+    Node& conv2_node = builder.AddConvNode(relu_output_arg, conv2_weight_arg, conv2_output_arg);
+    conv2_node.AddAttribute("group", static_cast<int64_t>(32));
+    conv2_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+
+    builder.AddNode("Sigmoid", {conv2_output_arg}, {output_arg});
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  // Verify that the layout transposes between the convolutions are removed.
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-5, 1e-5, nullptr, EnableNhwcFp32Conv);
+}
+
 #ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 std::vector<MLFloat16> randomfp16(const std::vector<int64_t>& shape, MLFloat16 min, MLFloat16 max) {
@@ -7,6 +7,7 @@
 #include "test/common/dnnl_op_test_utils.h"
 #include "core/util/math.h"
 #include <algorithm>
+#include <limits>
 #include <math.h>
 
 namespace onnxruntime {
@@ -537,6 +538,57 @@ TEST(MathOpTest, Sub_Broadcast_Scalar) {
   run(true);
 }
 
+// Broadcasts that coalesce to a row, a column or an outer product of the input vectors.
+TEST(MathOpTest, Sub_Broadcast_Coalesced) {
+  auto run = [](const std::vector<int64_t>& dims_a, const std::vector<int64_t>& dims_b) {
+    const std::vector<int64_t> dims_c{2, 3, 4, 5};
+
+    auto broadcast_index = [&dims_c](const std::vector<int64_t>& dims, int64_t index) {
+      int64_t offset = 0;
+      int64_t stride = 1;
+      for (size_t i = dims_c.size(); i-- > 0;) {
+        const int64_t coord = index % dims_c[i];
+        index /= dims_c[i];
+        if (dims[i] != 1) {
+          offset += coord * stride;
+        }
+        stride *= dims[i];
+      }
+      return offset;
+    };
+
+    std::vector<float> a(static_cast<size_t>(TensorShape(dims_a).Size()));
+    std::vector<float> b(static_cast<size_t>(TensorShape(dims_b).Size()));
+    for (size_t i = 0; i < a.size(); ++i) {
+      a[i] = static_cast<float>(i) * 0.5f - 7.0f;
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+      b[i] = static_cast<float>(i % 7) * 1.25f;
+    }
+
+    std::vector<float> c(static_cast<size_t>(TensorShape(dims_c).Size()));
+    for (size_t i = 0; i < c.size(); ++i) {
+      const int64_t index = static_cast<int64_t>(i);
+      c[i] = a[static_cast<size_t>(broadcast_index(dims_a, index))] -
+             b[static_cast<size_t>(broadcast_index(dims_b, index))];
+    }
+
+    OpTester test("Sub");
+    test.AddInput<float>("A", dims_a, a);
+    test.AddInput<float>("B", dims_b, b);
+    test.AddOutput<float>("C", dims_c, c);
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  };
+
+  run({2, 3, 4, 5}, {1, 1, 4, 5});
+  run({1, 1, 4, 5}, {2, 3, 4, 5});
+  run({2, 3, 4, 5}, {2, 3, 1, 1});
+  run({2, 3, 1, 1}, {2, 3, 4, 5});
+  run({2, 3, 1, 1}, {1, 1, 4, 5});
+  run({1, 1, 4, 5}, {2, 3, 1, 1});
+  run({2, 3, 4, 5}, {1, 1, 1, 1});
+}
+
 TEST(MathOpTest, Mul_int32) {
   OpTester test("Mul");
   test.AddInput<int32_t>("A", {3}, {1, 2, 3});
@@ -871,6 +923,25 @@ TEST(MathOpTest, Pow_Broadcast_Scalar1) {
   test.Run();
 }
 
+// a non-integer scalar exponent with results close to the float overflow threshold, where the error of
+// exp(y * log(x)) computed in float grows with y * log(x)
+TEST(MathOpTest, Pow_Broadcast_Scalar1_GeneralExponent) {
+  OpTester test("Pow");
+
+  const float y = 9.6f;
+  const std::vector<float> x{3.0f, 12.5f, 731.0f, 4096.0f, 9999.0f};
+  std::vector<float> z;
+  for (float value : x) {
+    z.push_back(std::pow(value, y));
+  }
+
+  std::vector<int64_t> dims{static_cast<int64_t>(x.size())};
+  test.AddInput<float>("X", dims, x);
+  test.AddInput<float>("Y", {}, {y});
+  test.AddOutput<float>("Z", dims, z);
+  test.Run();
+}
+
 TEST(MathOpTest, Pow_Float_12) {
   OpTester test("Pow", 12);
   std::vector<int64_t> dims{2, 2};
@@ -1830,6 +1901,59 @@ TEST(MathOpTest, Max_12_MLFLoat16_Scalar1) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  // TensorRT: Input batch size is inconsistent
 }
 
+// Max and Min return NaN if any input is NaN, whether the element is computed by a vector loop or a scalar tail
+// and whether the inputs are handled by the MLAS kernels or by the generic broadcaster.
+TEST(MathOpTest, MinMax_12_Float_NaN) {
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+  auto run = [](const char* op, const std::vector<std::vector<float>>& inputs,
+                const std::vector<std::vector<int64_t>>& input_dims, const std::vector<int64_t>& output_dims,
+                const std::vector<float>& output) {
+    OpTester test(op, 12);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      test.AddInput<float>(("data_" + std::to_string(i)).c_str(), input_dims[i], inputs[i]);
+    }
+    test.AddOutput<float>("output", output_dims, output);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  const std::vector<float> a{nan, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, nan, 10.0f};
+  const std::vector<float> b{0.0f, 0.0f, nan, 0.0f, 20.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, nan};
+  const std::vector<float> max{nan, 1.0f, nan, 3.0f, 20.0f, 5.0f, 6.0f, 7.0f, 8.0f, nan, nan};
+  const std::vector<float> min{nan, 0.0f, nan, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 0.0f, nan, nan};
+
+  run("Max", {a, b}, {{11}, {11}}, {11}, max);
+  run("Min", {a, b}, {{11}, {11}}, {11}, min);
+
+  // scalar NaN broadcast to every element
+  run("Max", {{nan}, b}, {{}, {11}}, {11}, std::vector<float>(11, nan));
+  run("Min", {a, {nan}}, {{11}, {}}, {11}, std::vector<float>(11, nan));
+
+  // three inputs use the generic broadcaster
+  const std::vector<float> zeros(11, 0.0f);
+  run("Max", {a, b, zeros}, {{11}, {11}, {11}}, {11}, max);
+  run("Min", {zeros, a, b}, {{11}, {11}, {11}}, {11}, min);
+}
+
+TEST(MathOpTest, MinMax_12_MLFloat16_NaN) {
+  constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+  for (const char* op : {"Max", "Min"}) {
+    OpTester test(op, 12);
+    test.AddInput<MLFloat16>("data_0", {5}, MakeMLFloat16({nan, 1.0f, 2.0f, 3.0f, nan}));
+    test.AddInput<MLFloat16>("data_1", {5}, MakeMLFloat16({0.0f, nan, 2.0f, 5.0f, 0.0f}));
+    test.AddOutput<MLFloat16>("output", {5},
+                              MakeMLFloat16({nan, nan, 2.0f, std::string(op) == "Max" ? 5.0f : 3.0f, nan}));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 TEST(MathOpTest, Not) {
   OpTester test("Not");
   std::vector<int64_t> dims{2};
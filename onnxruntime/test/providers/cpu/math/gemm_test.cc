@@ -7,6 +7,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
@@ -470,6 +471,84 @@ TEST(GemmOpTest, GemmScalarBroadcast) {
   TestGemmScalarBroadcast<double>();
 }
 
+// A 0-D C with N == 1 has the same number of elements as a (N,) bias, but must not be treated as one.
+template <typename T>
+void TestGemmScalarBiasSingleColumn() {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<T>("A", {2, 4},
+                   {1.0f, 2.0f, 3.0f, 4.0f,
+                    -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<T>("B", {4, 1}, std::vector<T>(4, 1.0f));
+  test.AddInput<T>("C", {}, std::vector<T>{1.0f});
+  test.AddOutput<T>("Y", {2, 1},
+                    {11.0f,
+                     -9.0f});
+  test.Config(run_with_tunable_op)
+      .RunWithConfig();
+}
+
+TEST(GemmOpTest, GemmScalarBiasSingleColumn) {
+  TestGemmScalarBiasSingleColumn<float>();
+  TestGemmScalarBiasSingleColumn<double>();
+}
+
+// A (N,), (1, N) or (M, N) C with beta 1 is added by the SGEMM epilogue. The shape spans several output
+// tiles and leaves a partial one in both dimensions.
+TEST(GemmOpTest, GemmBiasEpilogue) {
+  constexpr int64_t M = 19, K = 13, N = 37;
+
+  auto run_test = [&](const std::vector<int64_t>& c_dims, bool trans_b) {
+    const bool c_is_full = c_dims.size() == 2 && c_dims[0] == M;
+    std::vector<float> a_values(M * K);
+    std::vector<float> b_values(K * N);
+    std::vector<float> c_values(c_is_full ? M * N : N);
+    for (size_t i = 0; i < a_values.size(); i++) {
+      a_values[i] = static_cast<float>(static_cast<int>(i % 11) - 5) * 0.5f;
+    }
+    for (size_t i = 0; i < b_values.size(); i++) {
+      b_values[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.25f;
+    }
+    for (size_t i = 0; i < c_values.size(); i++) {
+      c_values[i] = static_cast<float>(static_cast<int>(i % 29)) - 10.0f;
+    }
+
+    std::vector<float> expected(M * N);
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a_values[m * K + k] * b_values[trans_b ? n * K + k : k * N + n];
+        }
+        expected[m * N + n] = sum + c_values[c_is_full ? m * N + n : n];
+      }
+    }
+
+    OpTester test("Gemm", 13);
+    test.AddAttribute("transA", static_cast<int64_t>(0));
+    test.AddAttribute("transB", static_cast<int64_t>(trans_b ? 1 : 0));
+    test.AddAttribute("alpha", 1.0f);
+    test.AddAttribute("beta", 1.0f);
+    test.AddInput<float>("A", {M, K}, a_values);
+    test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b_values, true);
+    test.AddInput<float>("C", c_dims, c_values);
+    test.AddOutput<float>("Y", {M, N}, expected);
+    test.Config(run_with_tunable_op)
+        .RunWithConfig();
+  };
+
+  run_test({1, N}, false);
+  run_test({1, N}, true);
+  run_test({N}, false);
+  run_test({M, N}, false);
+  run_test({M, N}, true);
+}
+
 #if defined(USE_DNNL)
 TEST(GemmOpTest, GemmScalarBroadcast_bfloat16) {
 #ifdef USE_DNNL
@@ -838,6 +917,59 @@ TEST(GemmOpTest, SharedPrepackedWeights) {
               static_cast<size_t>(number_of_shared_pre_packed_weights_counter));
   }
 }
+
+// The input values are exact in bfloat16 and the products are exact in fp32, so the result does not depend
+// on whether the platform supports the bfloat16 fastmath mode.
+TEST(GemmOpTest, GemmFastMathBf16) {
+  auto run_test = [](bool trans_b) {
+    constexpr int64_t M = 5, K = 40, N = 20;
+    std::vector<float> a_values(M * K);
+    std::vector<float> b_values(K * N);
+    std::vector<float> c_values(N);
+    for (size_t i = 0; i < a_values.size(); i++) {
+      a_values[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * 0.25f;
+    }
+    for (size_t i = 0; i < b_values.size(); i++) {
+      b_values[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.5f;
+    }
+    for (size_t i = 0; i < c_values.size(); i++) {
+      c_values[i] = static_cast<float>(i);
+    }
+
+    std::vector<float> expected(M * N);
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a_values[m * K + k] * b_values[trans_b ? n * K + k : k * N + n];
+        }
+        expected[m * N + n] = 0.5f * sum + 2.0f * c_values[n];
+      }
+    }
+
+    OpTester test("Gemm", 13);
+    test.AddAttribute("transA", static_cast<int64_t>(0));
+    test.AddAttribute("transB", static_cast<int64_t>(trans_b ? 1 : 0));
+    test.AddAttribute("alpha", 0.5f);
+    test.AddAttribute("beta", 2.0f);
+    test.AddInput<float>("A", {M, K}, a_values);
+    test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b_values, true);
+    test.AddInput<float>("C", {N}, c_values, true);
+    test.AddOutput<float>("Y", {M, N}, expected);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasGemmFastMathBf16, "1"));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  };
+
+  run_test(false);
+  run_test(true);
+}
 #endif
 
 }  // namespace test
@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/run_options_config_keys.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -372,5 +373,120 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
 
 #endif
 
+#ifndef ENABLE_TRAINING
+// The bfloat16 fastmath mode is applied to the pre-packed weights, so B is an initializer. The input values
+// are exact in bfloat16 and the products are exact in fp32, so the result does not depend on whether the
+// platform supports the mode.
+TEST(MathOpTest, MatMulFastMathBf16) {
+  auto run_test = [](const char* op_type, const char* domain, bool trans_b) {
+    constexpr int64_t M = 6, K = 40, N = 20;
+    std::vector<float> a_values(2 * M * K);
+    std::vector<float> b_values(K * N);
+    for (size_t i = 0; i < a_values.size(); i++) {
+      a_values[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * 0.25f;
+    }
+    for (size_t i = 0; i < b_values.size(); i++) {
+      b_values[i] = static_cast<float>(static_cast<int>(i % 13) - 6) * 0.5f;
+    }
+
+    std::vector<float> expected(2 * M * N);
+    for (int64_t m = 0; m < 2 * M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a_values[m * K + k] * b_values[trans_b ? n * K + k : k * N + n];
+        }
+        expected[m * N + n] = sum;
+      }
+    }
+
+    OpTester test(op_type, 1, domain);
+    if (trans_b) {
+      test.AddAttribute("transB", static_cast<int64_t>(1));
+    }
+    test.AddInput<float>("A", {2, M, K}, a_values);
+    test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b_values, true);
+    test.AddOutput<float>("Y", {2, M, N}, expected);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasGemmFastMathBf16, "1"));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  };
+
+  run_test("MatMul", kOnnxDomain, false);
+#if !defined(DISABLE_CONTRIB_OPS)
+  run_test("FusedMatMul", kMSDomain, false);
+  run_test("FusedMatMul", kMSDomain, true);
+#endif
+}
+
+// A weight initializer with most of its 4x4 blocks pruned is pre-packed in the block sparse format. The
+// threshold of "0" forces the sparse path for the less sparse weights as well.
+TEST(MathOpTest, MatMulBlockSparseWeights) {
+  auto run_test = [](const char* op_type, const char* domain, bool trans_b, float alpha, int pruned_per_8,
+                     const char* threshold) {
+    constexpr int64_t M = 5, K = 36, N = 22;
+    std::vector<float> a_values(2 * M * K);
+    std::vector<float> b_values(K * N);
+    for (size_t i = 0; i < a_values.size(); i++) {
+      a_values[i] = static_cast<float>(static_cast<int>(i % 17) - 8) * 0.25f;
+    }
+    for (int64_t k = 0; k < K; k++) {
+      for (int64_t n = 0; n < N; n++) {
+        const bool pruned = ((k / 4) * 7 + (n / 4) * 3) % 8 < pruned_per_8;
+        const float value = pruned ? 0.0f : static_cast<float>(static_cast<int>((k * N + n) % 13) - 6) * 0.5f;
+        b_values[trans_b ? n * K + k : k * N + n] = value;
+      }
+    }
+
+    std::vector<float> expected(2 * M * N);
+    for (int64_t m = 0; m < 2 * M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += a_values[m * K + k] * b_values[trans_b ? n * K + k : k * N + n];
+        }
+        expected[m * N + n] = alpha * sum;
+      }
+    }
+
+    OpTester test(op_type, 1, domain);
+    if (trans_b) {
+      test.AddAttribute("transB", static_cast<int64_t>(1));
+    }
+    if (alpha != 1.0f) {
+      test.AddAttribute("alpha", alpha);
+    }
+    test.AddInput<float>("A", {2, M, K}, a_values);
+    test.AddInput<float>("B", trans_b ? std::vector<int64_t>{N, K} : std::vector<int64_t>{K, N}, b_values, true);
+    test.AddOutput<float>("Y", {2, M, N}, expected);
+
+    SessionOptions so;
+    if (threshold != nullptr) {
+      ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMlasSparseGemmThreshold, threshold));
+    }
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Config(so)
+        .ConfigEps(std::move(execution_providers))
+        .RunWithConfig();
+  };
+
+  run_test("MatMul", kOnnxDomain, false, 1.0f, 7, nullptr);
+  run_test("MatMul", kOnnxDomain, false, 1.0f, 3, "0");
+  run_test("MatMul", kOnnxDomain, false, 1.0f, 7, "2");
+#if !defined(DISABLE_CONTRIB_OPS)
+  run_test("FusedMatMul", kMSDomain, false, 0.5f, 7, nullptr);
+  run_test("FusedMatMul", kMSDomain, true, 2.0f, 7, nullptr);
+#endif
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+#include <limits>
 #include <type_traits>
 
 #include "boost/mp11.hpp"
@@ -135,6 +137,81 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// The CPU conversions to integers truncate toward zero and saturate to the range of the integer type,
+// with NaN converted to zero. Other providers may leave out of range values undefined, as the spec does.
+template <typename DstType>
+void TestCastFloatToIntSaturate(const std::vector<float>& input, const std::vector<DstType>& output) {
+  OpTester test("Cast", 13);
+  test.AddAttribute<int64_t>("to", utils::ToTensorProtoElementType<DstType>());
+  test.AddInput<float>("input", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<DstType>("output", {static_cast<int64_t>(output.size())}, output);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(CastOpTest, FloatToIntSaturate) {
+  // more than a vector of values so that both the vector loop and the remainder are used
+  std::vector<float> input{NAN, -NAN, INFINITY, -INFINITY, 0.0f, -0.0f, 1.9f, -1.9f,
+                           127.5f, 128.0f, -128.5f, -129.0f, 255.9f, 256.0f, 1e10f, -1e10f,
+                           2147483520.0f, 2147483648.0f, -2147483648.0f, -2147483904.0f, 3.5f, -3.5f, 100.25f, -100.25f,
+                           0.5f, 7.0f, -7.0f, 42.75f, -42.75f, 200.0f, -200.0f, 65.0f,
+                           -0.99f};
+
+  std::vector<int8_t> int8_output{0, 0, 127, -128, 0, 0, 1, -1,
+                                  127, 127, -128, -128, 127, 127, 127, -128,
+                                  127, 127, -128, -128, 3, -3, 100, -100,
+                                  0, 7, -7, 42, -42, 127, -128, 65,
+                                  0};
+  TestCastFloatToIntSaturate(input, int8_output);
+
+  std::vector<uint8_t> uint8_output{0, 0, 255, 0, 0, 0, 1, 0,
+                                    127, 128, 0, 0, 255, 255, 255, 0,
+                                    255, 255, 0, 0, 3, 0, 100, 0,
+                                    0, 7, 0, 42, 0, 200, 0, 65,
+                                    0};
+  TestCastFloatToIntSaturate(input, uint8_output);
+
+  constexpr int32_t int32_max = std::numeric_limits<int32_t>::max();
+  constexpr int32_t int32_min = std::numeric_limits<int32_t>::lowest();
+  std::vector<int32_t> int32_output{0, 0, int32_max, int32_min, 0, 0, 1, -1,
+                                    127, 128, -128, -129, 255, 256, int32_max, int32_min,
+                                    2147483520, int32_max, int32_min, int32_min, 3, -3, 100, -100,
+                                    0, 7, -7, 42, -42, 200, -200, 65,
+                                    0};
+  TestCastFloatToIntSaturate(input, int32_output);
+}
+
+TEST(CastOpTest, FloatToBFloat16RoundNearestEven) {
+  // 1 + 2^-8 and 1 + 3 * 2^-8 are halfway between two bfloat16 values and round to the even one, while
+  // 1 + 2^-8 + 2^-9 rounds up.
+  const std::vector<float> input{1.00390625f, 1.01171875f, 1.005859375f, -1.00390625f,
+                                 0.0f, 3.0f, -65536.0f, 1.0f,
+                                 1.00390625f, 1.01171875f, 1.005859375f, -1.00390625f,
+                                 0.0f, 3.0f, -65536.0f, 1.0f,
+                                 1.01171875f};
+  const std::vector<float> expected{1.0f, 1.015625f, 1.0078125f, -1.0f,
+                                    0.0f, 3.0f, -65536.0f, 1.0f,
+                                    1.0f, 1.015625f, 1.0078125f, -1.0f,
+                                    0.0f, 3.0f, -65536.0f, 1.0f,
+                                    1.015625f};
+
+  std::vector<BFloat16> output;
+  for (float value : expected) {
+    output.push_back(BFloat16(value));
+  }
+
+  OpTester test("Cast", 13);
+  test.AddAttribute<int64_t>("to", utils::ToTensorProtoElementType<BFloat16>());
+  test.AddInput<float>("input", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<BFloat16>("output", {static_cast<int64_t>(output.size())}, output);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <sstream>
 #include <atomic>
+#include <future>
 #include <mutex>
 #include <algorithm>
 #include <thread>
@@ -1565,6 +1566,117 @@ TEST(CApiTest, get_allocator_cuda) {
 }
 #endif
 
+TEST(CApiTest, RunAsync) {
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigRunAsyncNumThreads, "2");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+
+  // queue many more runs than there are executor threads, each with its own input
+  constexpr size_t num_runs = 256;
+  std::vector<std::array<float, 3 * 2>> x_values(num_runs);
+  std::vector<std::future<std::vector<Ort::Value>>> futures;
+  for (size_t i = 0; i < num_runs; ++i) {
+    for (size_t j = 0; j < x_values[i].size(); ++j) {
+      x_values[i][j] = static_cast<float>(i + j);
+    }
+    Ort::Value x = Ort::Value::CreateTensor<float>(info_cpu, x_values[i].data(), x_values[i].size(),
+                                                   x_shape.data(), x_shape.size());
+    futures.push_back(session.RunAsync(run_options, input_names, &x, 1, output_names, 1));
+  }
+
+  for (size_t i = 0; i < num_runs; ++i) {
+    std::vector<Ort::Value> outputs = futures[i].get();
+    ASSERT_EQ(outputs.size(), 1U);
+    const float* y = outputs[0].GetTensorData<float>();
+    for (size_t j = 0; j < x_values[i].size(); ++j) {
+      ASSERT_EQ(y[j], x_values[i][j] * x_values[i][j]);
+    }
+  }
+
+  // a run canceled while queued completes with an error
+  Ort::RunOptions terminated_run_options;
+  terminated_run_options.SetTerminate();
+  Ort::Value x = Ort::Value::CreateTensor<float>(info_cpu, x_values[0].data(), x_values[0].size(),
+                                                 x_shape.data(), x_shape.size());
+  auto terminated = session.RunAsync(terminated_run_options, input_names, &x, 1, output_names, 1);
+  EXPECT_THROW(terminated.get(), Ort::Exception);
+}
+
+TEST(CApiTest, RunAsyncCallback) {
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value x = Ort::Value::CreateTensor<float>(info_cpu, x_values.data(), x_values.size(),
+                                                 x_shape.data(), x_shape.size());
+
+  // the output is provided by the caller
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  std::array<float, 3 * 2> y_values{};
+  Ort::Value y = Ort::Value::CreateTensor<float>(info_cpu, y_values.data(), y_values.size(),
+                                                 x_shape.data(), x_shape.size());
+
+  struct CallbackData {
+    std::promise<void> done;
+    OrtErrorCode code = ORT_FAIL;
+    OrtValue* output = nullptr;
+    size_t num_outputs = 0;
+  } data;
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+  session.RunAsync(
+      run_options, input_names, &x, 1, output_names, &y, 1,
+      [](void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+        auto* callback_data = static_cast<CallbackData*>(user_data);
+        Ort::Status run_status(status);
+        callback_data->code = run_status.IsOK() ? ORT_OK : run_status.GetErrorCode();
+        callback_data->output = outputs[0];
+        callback_data->num_outputs = num_outputs;
+        callback_data->done.set_value();
+      },
+      &data);
+
+  data.done.get_future().wait();
+  ASSERT_EQ(data.code, ORT_OK);
+  ASSERT_EQ(data.num_outputs, 1U);
+  ASSERT_EQ(data.output, static_cast<OrtValue*>(y));
+  ASSERT_TRUE(std::equal(std::begin(y_values), std::end(y_values), std::begin(expected_y)));
+}
+
+TEST(CApiTest, RunAsyncInvalidNumThreads) {
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+
+  for (const char* num_threads : {"two", "-1", ""}) {
+    Ort::SessionOptions session_options;
+    session_options.AddConfigEntry(kOrtSessionOptionsConfigRunAsyncNumThreads, num_threads);
+    Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+    Ort::Value x = Ort::Value::CreateTensor<float>(info_cpu, x_values.data(), x_values.size(),
+                                                   x_shape.data(), x_shape.size());
+    try {
+      session.RunAsync(run_options, input_names, &x, 1, output_names, 1);
+      FAIL() << "RunAsync accepted " << kOrtSessionOptionsConfigRunAsyncNumThreads << "='" << num_threads << "'";
+    } catch (const Ort::Exception& e) {
+      ASSERT_EQ(e.GetOrtErrorCode(), ORT_INVALID_ARGUMENT);
+    }
+  }
+}
+
 TEST(CApiTest, io_binding) {
   Ort::SessionOptions session_options;
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CPU(session_options, 1));